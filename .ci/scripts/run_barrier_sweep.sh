@@ -0,0 +1,76 @@
+#!/bin/bash -eE
+set -o pipefail
+#
+# Measures tl/ucp barrier algorithms over a range of team sizes, the
+# output is used to set the size based default barrier selection.
+#
+# usage: run_barrier_sweep.sh <launcher command with its args>
+#   e.g. run_barrier_sweep.sh mpirun --hostfile hosts
+#   the number of processes is appended to the launcher as "${NP_FLAG} <n>"
+#
+# Environment:
+#   PERFTEST - path to ucc_perftest (default: ucc_perftest from PATH)
+#   NP_FLAG  - launcher option setting the number of processes
+#              (default: -np)
+#   SIZES    - team sizes, power of two and not
+#              (default: 2 3 4 6 8 12 16 24 32 48 64 96 128)
+#   ALGS     - barrier algorithms (default: knomial dissemination tournament)
+#   N_ITER   - number of iterations (default: 10000)
+#   N_WARMUP - number of warmup iterations (default: 100)
+
+if [ $# -eq 0 ]; then
+    echo "usage: $0 <launcher command with its args>"
+    exit 1
+fi
+
+PERFTEST=${PERFTEST:-ucc_perftest}
+NP_FLAG=${NP_FLAG:--np}
+SIZES=${SIZES:-"2 3 4 6 8 12 16 24 32 48 64 96 128"}
+ALGS=${ALGS:-"knomial dissemination tournament"}
+N_ITER=${N_ITER:-10000}
+N_WARMUP=${N_WARMUP:-100}
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+LAUNCHER=("$@")
+
+# barrier has no message size, perftest prints "N/A N/A <avg> <min> <max>"
+function launch {
+    local np=$1
+    local alg=$2
+    "${LAUNCHER[@]}" ${NP_FLAG} "${np}" env UCC_CLS=basic \
+        UCC_TL_UCP_TUNE="barrier:@${alg}:inf" "${PERFTEST}" -c barrier \
+        -n "${N_ITER}" -w "${N_WARMUP}" | awk '$1 == "N/A" {print $3}'
+}
+
+for np in ${SIZES}; do
+    for alg in ${ALGS}; do
+        echo "INFO: barrier ${alg}, team size ${np} ..."
+        echo "${np} ${alg} $(launch "${np}" "${alg}")" >> "${WORK_DIR}/res"
+    done
+done
+
+printf "%-10s %-6s" "Team size" "Pof2"
+for alg in ${ALGS}; do
+    printf " %-18s" "${alg}, us"
+done
+printf " %s\n" "Best"
+for np in ${SIZES}; do
+    pof2="no"
+    if [ $((np & (np - 1))) -eq 0 ]; then
+        pof2="yes"
+    fi
+    printf "%-10s %-6s" "${np}" "${pof2}"
+    awk -v np="${np}" -v algs="${ALGS}" \
+        'BEGIN {n = split(algs, a, " ")}
+         $1 == np {t[$2] = $3}
+         END {for (i = 1; i <= n; i++) {
+                  printf " %-18s", (t[a[i]] != "") ? t[a[i]] : "N/A"
+                  if (t[a[i]] != "" &&
+                      (best == "" || t[a[i]] + 0 < t[best] + 0)) {
+                      best = a[i]
+                  }
+              }
+              printf " %s\n", best}' "${WORK_DIR}/res"
+done
@@ -0,0 +1,94 @@
+#!/bin/bash -eE
+set -o pipefail
+#
+# Compares pipeline params selected by the pipeline model ("auto" params
+# with UCC_PIPELINE_MODEL=y) with the best of a sweep of static params.
+#
+# usage: run_pipeline_sweep.sh <launcher command with its args>
+#   e.g. run_pipeline_sweep.sh mpirun -np 16 --hostfile hosts
+#
+# Environment:
+#   PERFTEST     - path to ucc_perftest (default: ucc_perftest from PATH)
+#   COLL         - perftest collective (default: bcast)
+#   PIPELINE_VAR - pipeline params variable of the algorithm
+#                  (default: UCC_TL_UCP_BCAST_CHAIN_PIPELINE)
+#   TUNE         - variable selecting the algorithm
+#                  (default: UCC_TL_UCP_TUNE=bcast:@chain:inf)
+#   MIN_COUNT    - min number of elements (default: 65536)
+#   MAX_COUNT    - max number of elements (default: 67108864)
+#   FRAG_SIZES   - static fragment sizes (default: 64K 256K 1M 4M)
+#   PDEPTHS      - static pipeline depths (default: 2 4 8 16)
+#   CALIB_FRAG_SIZES - fragment sizes the model is calibrated with
+#                  (default: 16K 64K 256K 1M 4M)
+#   CALIB_PDEPTH - pipeline depth of the calibration runs, deep enough to
+#                  measure the steady state period (default: 16)
+#
+# The model fits the fragment latency and period linearly in the fragment
+# size, so it is calibrated by static params over several fragment sizes:
+# "auto" params alone use a single fragment size for all the multi-fragment
+# messages and never calibrate it.
+
+if [ $# -eq 0 ]; then
+    echo "usage: $0 <launcher command with its args>"
+    exit 1
+fi
+
+PERFTEST=${PERFTEST:-ucc_perftest}
+COLL=${COLL:-bcast}
+PIPELINE_VAR=${PIPELINE_VAR:-UCC_TL_UCP_BCAST_CHAIN_PIPELINE}
+TUNE=${TUNE:-UCC_TL_UCP_TUNE=bcast:@chain:inf}
+MIN_COUNT=${MIN_COUNT:-65536}
+MAX_COUNT=${MAX_COUNT:-67108864}
+FRAG_SIZES=${FRAG_SIZES:-"64K 256K 1M 4M"}
+PDEPTHS=${PDEPTHS:-"2 4 8 16"}
+CALIB_FRAG_SIZES=${CALIB_FRAG_SIZES:-"16K 64K 256K 1M 4M"}
+CALIB_PDEPTH=${CALIB_PDEPTH:-16}
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "${WORK_DIR}"' EXIT
+MODEL_FILE="${WORK_DIR}/pipeline_model"
+
+# runs perftest with extra env, prints "<size> <avg time, us>" lines
+function run_perftest {
+    "$@" | awk '$1 ~ /^[0-9]+$/ {print $2, $3}'
+}
+
+function launch {
+    local env_args=("$@")
+    run_perftest "${LAUNCHER[@]}" env UCC_CLS=basic "${TUNE}" \
+        "${env_args[@]}" "${PERFTEST}" -c "${COLL}" -b "${MIN_COUNT}" \
+        -e "${MAX_COUNT}" -d uint8
+}
+
+LAUNCHER=("$@")
+
+echo "INFO: static pipeline params sweep ..."
+for fs in ${FRAG_SIZES}; do
+    for pd in ${PDEPTHS}; do
+        pp="thresh=0:fragsize=${fs}:nfrags=1:pdepth=${pd}:parallel"
+        launch "${PIPELINE_VAR}=${pp}" | sed "s/\$/ ${pp}/" \
+            >> "${WORK_DIR}/static"
+    done
+done
+
+echo "INFO: pipeline model calibration ..."
+for fs in ${CALIB_FRAG_SIZES}; do
+    pp="thresh=0:fragsize=${fs}:nfrags=1:pdepth=${CALIB_PDEPTH}:parallel"
+    launch UCC_PIPELINE_MODEL=y UCC_PIPELINE_MODEL_FILE="${MODEL_FILE}" \
+        "${PIPELINE_VAR}=${pp}" > /dev/null
+done
+
+echo "INFO: pipeline model run ..."
+launch UCC_PIPELINE_MODEL=y UCC_PIPELINE_MODEL_FILE="${MODEL_FILE}" \
+    "${PIPELINE_VAR}=auto" > "${WORK_DIR}/auto"
+
+# best static time per size
+sort -k1,1n -k2,2g "${WORK_DIR}/static" | awk '!seen[$1]++' \
+    > "${WORK_DIR}/best"
+
+printf "%-12s %-14s %-14s %-8s %s\n" "Size" "Auto, us" "Best, us" \
+    "Ratio" "Best static params"
+awk 'NR == FNR {best[$1] = $2; params[$1] = $3; next}
+     ($1 in best) {printf "%-12s %-14s %-14s %-8.2f %s\n", $1, $2, best[$1],
+                   $2 / best[$1], params[$1]}' \
+    "${WORK_DIR}/best" "${WORK_DIR}/auto"
@@ -350,6 +350,24 @@ CHECK_SPECIFIC_ATTRIBUTE([optimize], [NOOPTIMIZE],
                          [int foo (int arg) __attribute__ ((optimize("O0")));])
 
 
+#
+# Check for compiler support of per-function ISA selection, used to build
+# SIMD kernels which are dispatched at runtime based on CPU capabilities.
+#
+CHECK_SPECIFIC_ATTRIBUTE([target_avx2], [TARGET_AVX2],
+                         [#include <immintrin.h>
+                          __attribute__((target("avx2")))
+                          __m256i foo(__m256i a, __m256i b) {
+                              return _mm256_add_epi32(a, b);
+                          }])
+CHECK_SPECIFIC_ATTRIBUTE([target_avx512f], [TARGET_AVX512F],
+                         [#include <immintrin.h>
+                          __attribute__((target("avx512f")))
+                          __m512i foo(__m512i a, __m512i b) {
+                              return _mm512_add_epi64(a, b);
+                          }])
+
+
 #
 # Compile code with frame pointer. Optimizations usually omit the frame pointer,
 # but if we are profiling the code with callgraph we need it.
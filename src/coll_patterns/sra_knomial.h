@@ -371,6 +371,21 @@ static inline void ucc_kn_rs_pattern_init(ucc_rank_t size, ucc_rank_t rank,
     p->block_offset      = 0;
 }
 
+static inline void ucc_kn_rsv_pattern_init(ucc_rank_t size, ucc_rank_t rank,
+                                           ucc_kn_radix_t radix,
+                                           ucc_count_t *counts, int is64,
+                                           ucc_knomial_pattern_t *p)
+{
+    ucc_knomial_pattern_init_backward(size, rank, radix, p);
+    p->type              = KN_PATTERN_REDUCE_SCATTERV;
+    p->counts            = counts;
+    p->is64              = is64;
+    p->count             = ucc_buffer_vector_block_offset(counts, is64, size);
+    p->block_size_counts = p->count;
+    p->block_size        = size - p->n_extra;
+    p->block_offset      = 0;
+}
+
 static inline void ucc_kn_rsx_pattern_init(ucc_rank_t size, ucc_rank_t rank,
                                            ucc_kn_radix_t radix, size_t count,
                                            ucc_knomial_pattern_t *p)
@@ -421,8 +436,17 @@ ucc_kn_rs_pattern_peer_seg(ucc_rank_t peer, ucc_knomial_pattern_t *p,
         *peer_seg_offset = peer_seg_offset_base - block_offset_counts;
         return;
     case KN_PATTERN_REDUCE_SCATTERV:
-        /* not implemented */
-        ucc_assert(0);
+        ucc_kn_seg_desc_compute(p, &s, peer);
+        block_offset_inv = ucc_knomial_pattern_loop_rank_inv(p, p->block_offset);
+        peer_seg_offset_base = ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                              s.seg_start);
+        *peer_seg_count      = ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                              s.seg_end) -
+                               peer_seg_offset_base;
+        block_offset_counts = ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                             block_offset_inv);
+        *peer_seg_offset = peer_seg_offset_base - block_offset_counts;
+        return;
     default:
         ucc_assert(0);
     }
@@ -443,14 +467,12 @@ static inline void ucc_kn_rs_pattern_next_iter(ucc_knomial_pattern_t *p)
         ucc_knomial_pattern_next_iteration(p);
         return;
     case KN_PATTERN_REDUCE_SCATTER:
+    case KN_PATTERN_REDUCE_SCATTERV:
         ucc_kn_seg_desc_compute(p, &s, p->rank);
         p->block_size    = s.seg_size;
         p->block_offset += s.seg_offset;
         ucc_knomial_pattern_next_iteration_backward(p);
         return;
-    case KN_PATTERN_REDUCE_SCATTERV:
-        /* not implemented */
-        ucc_assert(0);
     default:
         ucc_assert(0);
     }
@@ -466,6 +488,17 @@ static inline void ucc_kn_rs_pattern_extra_seg(ucc_knomial_pattern_t *p,
         *seg_count  = ucc_buffer_block_count(
             p->count, p->size, ucc_knomial_pattern_get_extra(p, p->rank));
         return;
+    case KN_PATTERN_REDUCE_SCATTERV:
+        /* extra rank always follows its proxy */
+        *seg_offset = ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                     p->rank + 1) -
+                      ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                     p->rank);
+        *seg_count  = ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                     p->rank + 2) -
+                      ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                     p->rank + 1);
+        return;
     default:
         ucc_assert(0);
     }
@@ -11,21 +11,120 @@
 
 #include <dlfcn.h>
 
+/* Flat copy of a score range, fallbacks of the range are stored
+   contiguously in the fallbacks array of the map */
+typedef struct ucc_score_map_entry {
+    size_t                   start;
+    size_t                   end;
+    ucc_base_coll_init_fn_t  init;
+    ucc_base_team_t         *team;
+    uint32_t                 fb_start;
+    uint32_t                 n_fb;
+} ucc_score_map_entry_t;
+
+typedef struct ucc_score_map_fb {
+    ucc_base_coll_init_fn_t  init;
+    ucc_base_team_t         *team;
+} ucc_score_map_fb_t;
+
+/* Ranges of a (coll_type, mem_type) pair sorted by msgsize */
+typedef struct ucc_score_map_table {
+    ucc_score_map_entry_t *entries;
+    uint32_t               n_entries;
+    /* single range covering all msgsizes, msgsize is not computed */
+    uint32_t               full_range;
+} ucc_score_map_table_t;
+
 typedef struct ucc_score_map {
-    ucc_coll_score_t *score;
+    ucc_coll_score_t      *score;
     /* Size, rank of the process in the base_team associated with that
        score_map. It can be CL or TL team, which can be a subset of a
        core UCC team */
-    ucc_rank_t        team_size;
-    ucc_rank_t        team_rank;
+    ucc_rank_t             team_size;
+    ucc_rank_t             team_rank;
+    ucc_score_map_table_t  tables[UCC_COLL_TYPE_NUM][UCC_MEMORY_TYPE_LAST];
+    /* single cache aligned allocation holding entries of all the tables
+       followed by all the fallbacks */
+    void                  *storage;
+    ucc_score_map_fb_t    *fallbacks;
 } ucc_score_map_t;
 
+static ucc_status_t ucc_coll_score_map_compile(ucc_score_map_t *map)
+{
+    size_t                 n_entries = 0;
+    size_t                 n_fb      = 0;
+    ucc_score_map_entry_t *e;
+    ucc_score_map_fb_t    *fb;
+    ucc_score_map_table_t *t;
+    ucc_msg_range_t       *range;
+    ucc_coll_entry_t      *fb_entry;
+    ucc_list_link_t       *lst;
+    size_t                 size;
+    int                    i, j;
+
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            ucc_list_for_each(range, &map->score->scores[i][j],
+                              super.list_elem) {
+                n_entries++;
+                n_fb += ucc_list_length(&range->fallback);
+            }
+        }
+    }
+    map->storage   = NULL;
+    map->fallbacks = NULL;
+    if (n_entries == 0) {
+        return UCC_OK;
+    }
+
+    size = n_entries * sizeof(*e) + n_fb * sizeof(*fb);
+    if (0 != ucc_posix_memalign(&map->storage, UCC_CACHE_LINE_SIZE, size,
+                                "ucc_score_map_storage")) {
+        ucc_error("failed to allocate %zd bytes for score map", size);
+        map->storage = NULL;
+        return UCC_ERR_NO_MEMORY;
+    }
+    e              = map->storage;
+    map->fallbacks = PTR_OFFSET(map->storage, n_entries * sizeof(*e));
+    fb             = map->fallbacks;
+
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            lst          = &map->score->scores[i][j];
+            t            = &map->tables[i][j];
+            t->entries   = e;
+            t->n_entries = 0;
+            ucc_list_for_each(range, lst, super.list_elem) {
+                e->start    = range->start;
+                e->end      = range->end;
+                e->init     = range->super.init;
+                e->team     = range->super.team;
+                e->fb_start = fb - map->fallbacks;
+                e->n_fb     = 0;
+                ucc_list_for_each(fb_entry, &range->fallback, list_elem) {
+                    fb->init = fb_entry->init;
+                    fb->team = fb_entry->team;
+                    fb++;
+                    e->n_fb++;
+                }
+                e++;
+                t->n_entries++;
+            }
+            t->full_range = (t->n_entries == 1) &&
+                            (t->entries[0].start == 0) &&
+                            (t->entries[0].end == UCC_MSG_MAX);
+        }
+    }
+    return UCC_OK;
+}
+
 ucc_status_t ucc_coll_score_build_map(ucc_coll_score_t *score,
                                       ucc_score_map_t **map_p)
 {
     ucc_score_map_t *map;
     ucc_msg_range_t *range, *temp, *next;
     ucc_list_link_t *lst;
+    ucc_status_t     status;
     int              i, j;
 
     map = ucc_calloc(1, sizeof(*map), "ucc_score_map");
@@ -66,6 +165,11 @@ ucc_status_t ucc_coll_score_build_map(ucc_coll_score_t *score,
     }
 
     map->score = score;
+    status     = ucc_coll_score_map_compile(map);
+    if (UCC_OK != status) {
+        ucc_free(map);
+        return status;
+    }
     *map_p     = map;
     return UCC_OK;
 }
@@ -73,21 +177,20 @@ ucc_status_t ucc_coll_score_build_map(ucc_coll_score_t *score,
 void ucc_coll_score_free_map(ucc_score_map_t *map)
 {
     ucc_coll_score_free(map->score);
+    ucc_free(map->storage);
     ucc_free(map);
 }
 
 static ucc_status_t ucc_coll_score_map_lookup(ucc_score_map_t *map,
                                               ucc_base_coll_args_t *bargs,
-                                              ucc_msg_range_t **range)
+                                              ucc_score_map_entry_t **entry)
 {
-    ucc_memory_type_t mt      = ucc_coll_args_mem_type(&bargs->args,
+    ucc_memory_type_t      mt = ucc_coll_args_mem_type(&bargs->args,
                                                        map->team_rank);
-    unsigned          ct      = ucc_ilog2(bargs->args.coll_type);
-    size_t            msgsize = ucc_coll_args_msgsize(&bargs->args,
-                                                      map->team_rank,
-                                                      map->team_size);
-    ucc_list_link_t *list;
-    ucc_msg_range_t *r;
+    unsigned               ct = ucc_ilog2(bargs->args.coll_type);
+    ucc_score_map_table_t *t;
+    size_t                 msgsize;
+    uint32_t               lo, hi, mid;
 
     if (mt == UCC_MEMORY_TYPE_NOT_APPLY) {
         /* Temporary solution: for Barrier, Fanin, Fanout - use
@@ -95,19 +198,34 @@ static ucc_status_t ucc_coll_score_map_lookup(ucc_score_map_t *map,
         mt = UCC_MEMORY_TYPE_HOST;
     }
     ucc_assert(ucc_coll_args_is_mem_symmetric(&bargs->args, map->team_rank));
+    t = &map->tables[ct][mt];
+    if (t->full_range) {
+        *entry = &t->entries[0];
+        return UCC_OK;
+    }
+    msgsize = ucc_coll_args_msgsize(&bargs->args, map->team_rank,
+                                    map->team_size);
     if (msgsize == UCC_MSG_SIZE_INVALID || msgsize == UCC_MSG_SIZE_ASYMMETRIC) {
         /* These algorithms require global communication to get the same msgsize estimation.
            Can't use msg ranges. Use msize 0 (assuming the range list should only contain 1
            range [0:inf]) */
         msgsize = 0;
     }
-    list = &map->score->scores[ct][mt];
-    ucc_list_for_each(r, list, super.list_elem) {
-        if (msgsize >= r->start && msgsize <= r->end) {
-            *range = r;
-            return UCC_OK;
+    /* first range with end >= msgsize */
+    lo = 0;
+    hi = t->n_entries;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (t->entries[mid].end < msgsize) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
+    if (lo < t->n_entries && msgsize >= t->entries[lo].start) {
+        *entry = &t->entries[lo];
+        return UCC_OK;
+    }
     return UCC_ERR_NOT_SUPPORTED;
 }
 
@@ -115,35 +233,35 @@ ucc_status_t ucc_coll_init(ucc_score_map_t      *map,
                            ucc_base_coll_args_t *bargs,
                            ucc_coll_task_t     **task)
 {
-    ucc_msg_range_t  *r;
-    ucc_coll_entry_t *fb;
-    ucc_base_team_t  *team;
-    ucc_status_t      status;
+    ucc_score_map_entry_t *e;
+    ucc_score_map_fb_t    *fb;
+    ucc_base_team_t       *team;
+    ucc_status_t           status;
+    uint32_t               i;
 
-    status = ucc_coll_score_map_lookup(map, bargs, &r);
+    status = ucc_coll_score_map_lookup(map, bargs, &e);
     if (ucc_unlikely(UCC_OK != status)) {
         ucc_debug("coll_score_map lookup failed %d (%s)",
                    status, ucc_status_string(status));
         return status;
     }
 
-    team   = r->super.team;
-    status = r->super.init(bargs, team, task);
+    team   = e->team;
+    status = e->init(bargs, team, task);
     if (UCC_OK == status) {
         return UCC_OK;
     }
 
-    fb = ucc_list_head(&r->fallback, ucc_coll_entry_t, list_elem);
-    while (&fb->list_elem != &r->fallback &&
-           (status == UCC_ERR_NOT_SUPPORTED ||
-            status == UCC_ERR_NOT_IMPLEMENTED)) {
+    fb = &map->fallbacks[e->fb_start];
+    for (i = 0; i < e->n_fb && (status == UCC_ERR_NOT_SUPPORTED ||
+                                status == UCC_ERR_NOT_IMPLEMENTED); i++) {
         ucc_debug("coll %s is not supported for %s, fallback %s",
                   ucc_coll_type_str(bargs->args.coll_type),
                   team->context->lib->log_component.name,
-                  fb->team->context->lib->log_component.name);
-        team   = fb->team;
-        status = fb->init(bargs, team, task);
-        fb     = ucc_list_next(&fb->list_elem, ucc_coll_entry_t, list_elem);
+                  fb[i].team->context->lib->log_component.name);
+        team         = fb[i].team;
+        bargs->mask |= UCC_BASE_CARGS_FALLBACK;
+        status       = fb[i].init(bargs, team, task);
     }
 
     return status;
@@ -163,7 +163,9 @@ typedef struct ucc_base_team_iface {
 } ucc_base_team_iface_t;
 
 enum {
-    UCC_BASE_CARGS_MAX_FRAG_COUNT = UCC_BIT(0)
+    UCC_BASE_CARGS_MAX_FRAG_COUNT = UCC_BIT(0),
+    /* set by ucc_coll_init if the task was created by a fallback init */
+    UCC_BASE_CARGS_FALLBACK       = UCC_BIT(1)
 };
 
 typedef struct ucc_buffer_info_asymmetric_memtype {
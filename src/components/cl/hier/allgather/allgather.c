@@ -0,0 +1,398 @@
+/**
+ * Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "allgather.h"
+#include "../cl_hier_coll.h"
+#include "core/ucc_team.h"
+
+/* Gather + allgatherv + bcast: the rank ordered dst buffer is split into
+   fragments. For every fragment the node leader gathers the parts of the
+   fragment owned by the ranks of its node, node leaders exchange their parts
+   with inplace allgatherv and then broadcast the whole fragment within the
+   node. Fragments are launched by the pipelined schedule for large messages.
+   Requires the data of every node to be a contiguous block of dst, i.e.
+   block and host ordered team. */
+
+enum {
+    UCC_CL_HIER_ALLGATHER_GAB_GATHER,
+    UCC_CL_HIER_ALLGATHER_GAB_ALLGATHERV,
+    UCC_CL_HIER_ALLGATHER_GAB_BCAST
+};
+
+ucc_base_coll_alg_info_t
+    ucc_cl_hier_allgather_algs[UCC_CL_HIER_ALLGATHER_ALG_LAST + 1] = {
+        [UCC_CL_HIER_ALLGATHER_ALG_GAB] =
+            {.id   = UCC_CL_HIER_ALLGATHER_ALG_GAB,
+             .name = "gab",
+             .desc = "gatherv + allgatherv + bcast"},
+        [UCC_CL_HIER_ALLGATHER_ALG_LAST] = {
+            .id = 0, .name = NULL, .desc = NULL}};
+
+static ucc_status_t ucc_cl_hier_allgather_gab_start(ucc_coll_task_t *task)
+{
+    UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_allgather_gab_start", 0);
+    return ucc_schedule_start(task);
+}
+
+static ucc_status_t ucc_cl_hier_allgather_gab_finalize(ucc_coll_task_t *task)
+{
+    ucc_cl_hier_schedule_t *schedule =
+        ucc_derived_of(task, ucc_cl_hier_schedule_t);
+    ucc_status_t            status;
+
+    UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_allgather_gab_finalize",
+                                      0);
+    ucc_mc_free(schedule->scratch);
+    status = ucc_schedule_finalize(task);
+    ucc_cl_hier_put_schedule(&schedule->super.super);
+    return status;
+}
+
+/* Sets buffers and counts of the step for the fragment
+   [offset, offset + count) of dst */
+static void ucc_cl_hier_allgather_gab_step_args(ucc_cl_hier_team_t *cl_team,
+                                                ucc_coll_args_t    *args,
+                                                int step, size_t offset,
+                                                size_t           count,
+                                                ucc_coll_args_t *sargs)
+{
+    ucc_rank_t rank    = UCC_CL_TEAM_RANK(cl_team);
+    size_t     dt_size = ucc_dt_size(args->dst.info.datatype);
+    size_t     block   = args->dst.info.count / UCC_CL_TEAM_SIZE(cl_team);
+    size_t     pos, part;
+
+    switch (step) {
+    case UCC_CL_HIER_ALLGATHER_GAB_GATHER:
+        pos  = ucc_cl_hier_frag_part(block, 0, rank, offset, count);
+        part = ucc_cl_hier_frag_part(block, rank, rank + 1, offset, count);
+        if (UCC_IS_INPLACE(*args)) {
+            sargs->src.info.buffer =
+                PTR_OFFSET(args->dst.info.buffer, (offset + pos) * dt_size);
+        } else {
+            sargs->src.info.buffer =
+                PTR_OFFSET(args->src.info.buffer,
+                           part ? (offset + pos - rank * block) * dt_size : 0);
+        }
+        sargs->src.info.count = part;
+        /* node part of the fragment goes to its place in dst */
+        pos = ucc_cl_hier_frag_part(
+            block, 0, ucc_ep_map_eval(SBGP_MAP(cl_team, NODE), 0), offset,
+            count);
+        sargs->dst.info_v.buffer =
+            PTR_OFFSET(args->dst.info.buffer, (offset + pos) * dt_size);
+        ucc_cl_hier_frag_counts(cl_team, UCC_HIER_SBGP_NODE, block, offset,
+                                count, 0, sargs->dst.info_v.counts,
+                                sargs->dst.info_v.displacements);
+        break;
+    case UCC_CL_HIER_ALLGATHER_GAB_ALLGATHERV:
+        ucc_cl_hier_frag_counts(cl_team, UCC_HIER_SBGP_NODE_LEADERS, block,
+                                offset, count, offset,
+                                sargs->dst.info_v.counts,
+                                sargs->dst.info_v.displacements);
+        break;
+    case UCC_CL_HIER_ALLGATHER_GAB_BCAST:
+        sargs->src.info.buffer =
+            PTR_OFFSET(args->dst.info.buffer, offset * dt_size);
+        sargs->src.info.count = count;
+        break;
+    }
+}
+
+static ucc_status_t
+ucc_cl_hier_allgather_gab_frag_setup(ucc_schedule_pipelined_t *schedule_p,
+                                     ucc_schedule_t *frag, int frag_num)
+{
+    ucc_coll_args_t        *args    = &schedule_p->super.super.bargs.args;
+    ucc_cl_hier_team_t     *cl_team = ucc_derived_of(
+        schedule_p->super.super.team, ucc_cl_hier_team_t);
+    ucc_cl_hier_schedule_t *cl_frag = ucc_derived_of(frag,
+                                                     ucc_cl_hier_schedule_t);
+    int                     n_frags = schedule_p->super.n_tasks;
+    size_t                  frag_count, frag_offset;
+    int                     s;
+
+    frag_count =
+        ucc_buffer_block_count(args->dst.info.count, n_frags, frag_num);
+    frag_offset =
+        ucc_buffer_block_offset(args->dst.info.count, n_frags, frag_num);
+
+    for (s = 0; s < UCC_CL_HIER_MAX_STEPS; s++) {
+        if (cl_frag->frag.tasks[s]) {
+            ucc_cl_hier_allgather_gab_step_args(
+                cl_team, args, s, frag_offset, frag_count,
+                &cl_frag->frag.tasks[s]->bargs.args);
+        }
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_cl_hier_allgather_gab_init_schedule(ucc_base_coll_args_t *coll_args,
+                                        ucc_base_team_t      *team,
+                                        ucc_schedule_t **sched_p, int n_frags)
+{
+    ucc_cl_hier_team_t     *cl_team   = ucc_derived_of(team,
+                                                       ucc_cl_hier_team_t);
+    ucc_coll_args_t        *uargs     = &coll_args->args;
+    ucc_rank_t              node_size = SBGP_SIZE(cl_team, NODE);
+    ucc_coll_task_t        *tasks[UCC_CL_HIER_MAX_STEPS] = {NULL};
+    ucc_rank_t              n_leaders = 0;
+    ucc_cl_hier_schedule_t *cl_schedule;
+    ucc_schedule_t         *schedule;
+    ucc_base_coll_args_t    base, args;
+    ucc_status_t            status;
+    uint64_t               *arrays;
+    size_t                  frag_count;
+    int                     n_tasks, i;
+
+    cl_schedule = ucc_cl_hier_get_schedule(cl_team);
+    if (ucc_unlikely(!cl_schedule)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    schedule = &cl_schedule->super.super;
+    memset(&cl_schedule->frag, 0, sizeof(cl_schedule->frag));
+    n_tasks = 0;
+    UCC_CHECK_GOTO(ucc_schedule_init(schedule, coll_args, team), out, status);
+
+    if (SBGP_ENABLED(cl_team, NODE_LEADERS)) {
+        n_leaders = SBGP_SIZE(cl_team, NODE_LEADERS);
+    }
+    /* counts and displacements of node and node leaders steps */
+    UCC_CHECK_GOTO(ucc_mc_alloc(&cl_schedule->scratch,
+                                2 * (node_size + n_leaders) * sizeof(uint64_t),
+                                UCC_MEMORY_TYPE_HOST),
+                   out, status);
+    arrays     = cl_schedule->scratch->addr;
+    frag_count = ucc_buffer_block_count(uargs->dst.info.count, n_frags, 0);
+
+    base = *coll_args;
+    if (n_frags > 1) {
+        base.max_frag_count = frag_count;
+        base.mask          |= UCC_BASE_CARGS_MAX_FRAG_COUNT;
+    }
+    if (!(base.args.mask & UCC_COLL_ARGS_FIELD_FLAGS)) {
+        base.args.flags = 0;
+    }
+    base.args.mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+    base.args.flags &= ~UCC_COLL_ARGS_FLAG_IN_PLACE;
+    base.args.flags |= UCC_COLL_ARGS_FLAG_COUNT_64BIT |
+                       UCC_COLL_ARGS_FLAG_DISPLACEMENTS_64BIT;
+
+    args                              = base;
+    args.args.coll_type               = UCC_COLL_TYPE_GATHERV;
+    args.args.root                    = 0;
+    args.args.src.info.datatype       = uargs->dst.info.datatype;
+    args.args.src.info.mem_type       = uargs->dst.info.mem_type;
+    args.args.dst.info_v.counts       = arrays;
+    args.args.dst.info_v.displacements = arrays + node_size;
+    args.args.dst.info_v.datatype     = uargs->dst.info.datatype;
+    args.args.dst.info_v.mem_type     = uargs->dst.info.mem_type;
+    if (UCC_IS_INPLACE(*uargs) && SBGP_RANK(cl_team, NODE) == 0) {
+        /* own data of node leader is already in place */
+        args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+    }
+    ucc_cl_hier_allgather_gab_step_args(cl_team, uargs,
+                                        UCC_CL_HIER_ALLGATHER_GAB_GATHER, 0,
+                                        frag_count, &args.args);
+    UCC_CHECK_GOTO(
+        ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
+        out, status);
+    cl_schedule->frag.tasks[UCC_CL_HIER_ALLGATHER_GAB_GATHER] = tasks[n_tasks];
+    n_tasks++;
+
+    if (SBGP_ENABLED(cl_team, NODE_LEADERS)) {
+        args                               = base;
+        args.args.coll_type                = UCC_COLL_TYPE_ALLGATHERV;
+        args.args.flags                   |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+        args.args.dst.info_v.buffer        = uargs->dst.info.buffer;
+        args.args.dst.info_v.counts        = arrays + 2 * node_size;
+        args.args.dst.info_v.displacements = arrays + 2 * node_size +
+                                             n_leaders;
+        args.args.dst.info_v.datatype      = uargs->dst.info.datatype;
+        args.args.dst.info_v.mem_type      = uargs->dst.info.mem_type;
+        ucc_cl_hier_allgather_gab_step_args(
+            cl_team, uargs, UCC_CL_HIER_ALLGATHER_GAB_ALLGATHERV, 0,
+            frag_count, &args.args);
+        UCC_CHECK_GOTO(ucc_coll_init(SCORE_MAP(cl_team, NODE_LEADERS), &args,
+                                     &tasks[n_tasks]),
+                       out, status);
+        cl_schedule->frag.tasks[UCC_CL_HIER_ALLGATHER_GAB_ALLGATHERV] =
+            tasks[n_tasks];
+        n_tasks++;
+    }
+
+    args                        = base;
+    args.args.coll_type         = UCC_COLL_TYPE_BCAST;
+    args.args.root              = 0;
+    args.args.src.info.datatype = uargs->dst.info.datatype;
+    args.args.src.info.mem_type = uargs->dst.info.mem_type;
+    ucc_cl_hier_allgather_gab_step_args(cl_team, uargs,
+                                        UCC_CL_HIER_ALLGATHER_GAB_BCAST, 0,
+                                        frag_count, &args.args);
+    UCC_CHECK_GOTO(
+        ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
+        out, status);
+    cl_schedule->frag.tasks[UCC_CL_HIER_ALLGATHER_GAB_BCAST] = tasks[n_tasks];
+    n_tasks++;
+
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[0]), out, status);
+    if (n_frags > 1) {
+        UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super, tasks[0],
+                                              UCC_EVENT_SCHEDULE_STARTED),
+                       out, status);
+        for (i = 1; i < n_tasks; i++) {
+            UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[i]), out,
+                           status);
+            UCC_CHECK_GOTO(ucc_task_subscribe_dep(tasks[i - 1], tasks[i],
+                                                  UCC_EVENT_COMPLETED),
+                           out, status);
+        }
+    } else {
+        UCC_CHECK_GOTO(ucc_event_manager_subscribe(
+                           &schedule->super, UCC_EVENT_SCHEDULE_STARTED,
+                           tasks[0], ucc_task_start_handler),
+                       out, status);
+        for (i = 1; i < n_tasks; i++) {
+            UCC_CHECK_GOTO(
+                ucc_event_manager_subscribe(tasks[i - 1], UCC_EVENT_COMPLETED,
+                                            tasks[i], ucc_task_start_handler),
+                out, status);
+            UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[i]), out,
+                           status);
+        }
+    }
+
+    schedule->super.post     = ucc_cl_hier_allgather_gab_start;
+    schedule->super.progress = NULL;
+    schedule->super.finalize = ucc_cl_hier_allgather_gab_finalize;
+    *sched_p                 = schedule;
+    return UCC_OK;
+
+out:
+    for (i = 0; i < n_tasks; i++) {
+        tasks[i]->finalize(tasks[i]);
+    }
+    if (cl_schedule->scratch) {
+        ucc_mc_free(cl_schedule->scratch);
+    }
+    ucc_cl_hier_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_cl_hier_allgather_gab_frag_init(
+    ucc_base_coll_args_t *coll_args, ucc_schedule_pipelined_t *sp,
+    ucc_base_team_t *team, ucc_schedule_t **frag_p)
+{
+    return ucc_cl_hier_allgather_gab_init_schedule(coll_args, team, frag_p,
+                                                   sp->super.n_tasks);
+}
+
+static ucc_status_t
+ucc_cl_hier_allgather_gab_pipelined_start(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+
+    cl_debug(task->team->context->lib,
+             "posting gab allgather, sbuf %p, rbuf %p, count %zd, dt %s, "
+             "inplace %d, pdepth %d, frags_total %d",
+             task->bargs.args.src.info.buffer, task->bargs.args.dst.info.buffer,
+             task->bargs.args.dst.info.count,
+             ucc_datatype_str(task->bargs.args.dst.info.datatype),
+             UCC_IS_INPLACE(task->bargs.args), schedule->n_frags,
+             schedule->super.n_tasks);
+
+    return ucc_schedule_pipelined_post(task);
+}
+
+static ucc_status_t
+ucc_cl_hier_allgather_gab_pipelined_finalize(ucc_coll_task_t *task)
+{
+    ucc_cl_hier_schedule_t *schedule =
+        ucc_derived_of(task, ucc_cl_hier_schedule_t);
+    ucc_status_t status;
+
+    status = ucc_schedule_pipelined_finalize(&schedule->super.super.super);
+    ucc_cl_hier_put_schedule(&schedule->super.super);
+    return status;
+}
+
+UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_allgather_gab_init,
+                         (coll_args, team, task),
+                         ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
+                         ucc_coll_task_t **task)
+{
+    ucc_cl_hier_team_t     *cl_team = ucc_derived_of(team, ucc_cl_hier_team_t);
+    ucc_cl_hier_lib_config_t *cfg   = &UCC_CL_HIER_TEAM_LIB(cl_team)->cfg;
+    ucc_pipeline_params_t     pp    = cfg->allgather_gab_pipeline;
+    ucc_coll_args_t          *args  = &coll_args->args;
+    ucc_cl_hier_schedule_t   *schedule;
+    int                       n_frags, pipeline_depth;
+    int                       model_slot, is_auto;
+    size_t                    msgsize;
+    int                       block_ordered, host_ordered;
+    ucc_status_t              status;
+
+    if (args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST ||
+        (!UCC_IS_INPLACE(*args) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    UCC_CHECK_GOTO(ucc_cl_hier_is_block_ordered(cl_team, &block_ordered),
+                   out, status);
+    UCC_CHECK_GOTO(ucc_cl_hier_is_host_ordered(cl_team, &host_ordered),
+                   out, status);
+    if (!block_ordered || !host_ordered ||
+        ucc_topo_min_ppn(team->params.team->topo) < 2) {
+        cl_debug(team->context->lib, "gab allgather requires node ordered "
+                 "ranks and at least 2 ranks per node");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    msgsize = args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+    is_auto = ucc_pipeline_params_is_auto(&pp);
+    if (is_auto) {
+        pp.threshold = 1024 * 1024;
+        pp.n_frags   = 2;
+        pp.frag_size = 1024 * 1024;
+        pp.pdepth    = 2;
+        pp.order     = UCC_PIPELINE_PARALLEL;
+    }
+    model_slot = ucc_pipeline_params_model(team, "hier_allgather_gab",
+                                           UCC_MEMORY_TYPE_HOST, msgsize,
+                                           is_auto, &pp);
+    ucc_pipeline_nfrags_pdepth(&pp, msgsize, &n_frags, &pipeline_depth);
+
+    if (n_frags == 1) {
+        return ucc_cl_hier_allgather_gab_init_schedule(
+            coll_args, team, (ucc_schedule_t **)task, n_frags);
+    }
+
+    schedule = ucc_cl_hier_get_schedule(cl_team);
+    if (ucc_unlikely(!schedule)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+
+    status = ucc_schedule_pipelined_init(
+        coll_args, team, ucc_cl_hier_allgather_gab_frag_init,
+        ucc_cl_hier_allgather_gab_frag_setup, pipeline_depth, n_frags,
+        pp.order, &schedule->super);
+    if (ucc_unlikely(status != UCC_OK)) {
+        cl_error(team->context->lib,
+                 "failed to init pipelined gab allgather schedule");
+        ucc_cl_hier_put_schedule(&schedule->super.super);
+        return status;
+    }
+
+    ucc_schedule_pipelined_set_model(&schedule->super, model_slot, msgsize);
+    schedule->super.super.super.post = ucc_cl_hier_allgather_gab_pipelined_start;
+    schedule->super.super.super.finalize =
+        ucc_cl_hier_allgather_gab_pipelined_finalize;
+    *task = &schedule->super.super.super;
+    return UCC_OK;
+out:
+    return status;
+}
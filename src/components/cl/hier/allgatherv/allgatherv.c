@@ -64,62 +64,6 @@ static inline ucc_status_t find_leader_rank(ucc_base_team_t *team,
     return UCC_OK;
 }
 
-/* Check if the ranks are block ordered. If they aren't, we'll need to 
-   unpack the data after the allgatherv into the right position, even if the
-   dst buffer is contiguous */
-static inline ucc_status_t is_block_ordered(ucc_cl_hier_team_t *cl_team, int *ordered)
-{
-    ucc_topo_t *topo = cl_team->super.super.params.team->topo;
-    ucc_sbgp_t *sbgp;
-    int         is_block_ordered;
-
-    if (cl_team->is_block_ordered != -1) {
-        is_block_ordered = cl_team->is_block_ordered;
-    } else {
-        sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_FULL_HOST_ORDERED);
-        is_block_ordered = ucc_ep_map_is_identity(&sbgp->map) ? 1 : 0;
-        cl_team->is_block_ordered = is_block_ordered;
-    }
-
-    *ordered = is_block_ordered;
-
-    return UCC_OK;
-}
-
-/* Node leader subgroup is always ordered by ascending host_id. If the team's ranks are
-   not in the same order, then node leader subgroup allgatherv won't be enough, we'll
-   have to use a staging buffer and unpack to reorder each leader's contribution.
-   So, this func will check that the team ranks in the ldr sbgp are ascending */
-static inline ucc_status_t is_host_ordered(ucc_cl_hier_team_t *cl_team, int *ordered)
-{
-    int         is_host_ordered;
-    ucc_rank_t  max_rank, i, team_rank;
-
-    if (cl_team->is_host_ordered != -1) {
-        is_host_ordered = cl_team->is_host_ordered;
-    } else {
-        if (SBGP_EXISTS(cl_team, NODE_LEADERS)) {
-            is_host_ordered = 1;
-            max_rank = ucc_ep_map_eval(SBGP_MAP(cl_team, NODE_LEADERS), 0);
-            for (i = 1; i < SBGP_SIZE(cl_team, NODE_LEADERS); i++) {
-                team_rank = ucc_ep_map_eval(SBGP_MAP(cl_team, NODE_LEADERS), i);
-                if (team_rank < max_rank) {
-                    is_host_ordered = 0;
-                    break;
-                }
-                max_rank = team_rank;
-            }
-        } else {
-            is_host_ordered = 1;
-        }
-        cl_team->is_host_ordered = is_host_ordered;
-    }
-
-    *ordered = is_host_ordered;
-
-    return UCC_OK;
-}
-
 UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_allgatherv_init,
                          (coll_args, team, task),
                          ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
@@ -182,8 +126,10 @@ UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_allgatherv_init,
     cl_schedule = ucc_derived_of(schedule, ucc_cl_hier_schedule_t);
 
     n_tasks   = 0;
-    UCC_CHECK_GOTO(is_block_ordered(cl_team, &block_ordered), free_sched, status);
-    UCC_CHECK_GOTO(is_host_ordered(cl_team, &host_ordered), free_sched, status);
+    UCC_CHECK_GOTO(ucc_cl_hier_is_block_ordered(cl_team, &block_ordered),
+                   free_sched, status);
+    UCC_CHECK_GOTO(ucc_cl_hier_is_host_ordered(cl_team, &host_ordered),
+                   free_sched, status);
     is_contig = UCC_COLL_IS_DST_CONTIG(&args.args) && block_ordered && host_ordered;
     /* handle the case where this rank may be the only one on this node */
     ldr_sbgp_only = !SBGP_ENABLED(cl_team, NODE) && SBGP_ENABLED(cl_team, NODE_LEADERS);
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -7,7 +7,7 @@
 #include "allreduce.h"
 #include "../cl_hier_coll.h"
 
-#define MAX_AR_RAB_TASKS 3
+#define MAX_AR_RAB_TASKS (2 * UCC_CL_HIER_MAX_LEVELS - 1)
 
 static ucc_status_t ucc_cl_hier_allreduce_rab_start(ucc_coll_task_t *task)
 {
@@ -42,12 +42,9 @@ static ucc_status_t
 ucc_cl_hier_allreduce_rab_frag_setup(ucc_schedule_pipelined_t *schedule_p,
                                      ucc_schedule_t *frag, int frag_num)
 {
-    ucc_cl_hier_team_t *cl_team =
-        ucc_derived_of(schedule_p->super.super.team, ucc_cl_hier_team_t);
     ucc_coll_args_t *args    = &schedule_p->super.super.bargs.args;
     size_t           dt_size = ucc_dt_size(args->dst.info.datatype);
     int              n_frags = schedule_p->super.n_tasks;
-    int              inplace = UCC_IS_INPLACE(*args);
     size_t           frag_count, frag_offset;
     ucc_coll_task_t *task;
     int              i;
@@ -63,9 +60,10 @@ ucc_cl_hier_allreduce_rab_frag_setup(ucc_schedule_pipelined_t *schedule_p,
         task->bargs.args.dst.info.count  = frag_count;
         task->bargs.args.dst.info.buffer =
             PTR_OFFSET(args->dst.info.buffer, frag_offset * dt_size);
+        /* every task but the first one of the schedule works on dst,
+           the first one also does for inplace allreduce */
         if ((task->bargs.args.coll_type == UCC_COLL_TYPE_BCAST) ||
-            (task->bargs.args.coll_type == UCC_COLL_TYPE_REDUCE && inplace &&
-             (SBGP_RANK(cl_team, NODE) != args->root))) {
+            UCC_IS_INPLACE(task->bargs.args)) {
             task->bargs.args.src.info.buffer =
                 PTR_OFFSET(args->dst.info.buffer, frag_offset * dt_size);
         } else {
@@ -86,7 +84,8 @@ ucc_cl_hier_allreduce_rab_init_schedule(ucc_base_coll_args_t *coll_args,
     ucc_schedule_t      *schedule;
     ucc_status_t         status;
     ucc_base_coll_args_t args;
-    int                  n_tasks, i;
+    ucc_hier_sbgp_type_t levels[UCC_CL_HIER_MAX_LEVELS];
+    int                  n_tasks, n_levels, i, l;
 
     schedule = &ucc_cl_hier_get_schedule(cl_team)->super.super;
     if (ucc_unlikely(!schedule)) {
@@ -103,49 +102,43 @@ ucc_cl_hier_allreduce_rab_init_schedule(ucc_base_coll_args_t *coll_args,
                                                      n_frags, 0);
         args.mask           |= UCC_BASE_CARGS_MAX_FRAG_COUNT;
     }
-    ucc_assert(SBGP_ENABLED(cl_team, NODE) ||
-               SBGP_ENABLED(cl_team, NODE_LEADERS));
-
-    if (SBGP_ENABLED(cl_team, NODE)) {
-        ucc_assert(n_tasks == 0);
-        if (cl_team->top_sbgp == UCC_HIER_SBGP_NODE) {
+    /* reduce to the leaders up to the top level, allreduce there, then bcast
+       back down the hierarchy */
+    n_levels = ucc_cl_hier_get_levels(cl_team, levels);
+    ucc_assert(n_levels > 0);
+    for (l = 0; l < n_levels; l++) {
+        if (ucc_cl_hier_is_top_level(cl_team, levels[l])) {
             args.args.coll_type = UCC_COLL_TYPE_ALLREDUCE;
         } else {
             args.args.coll_type = UCC_COLL_TYPE_REDUCE;
             if (UCC_IS_INPLACE(args.args) &&
-                (SBGP_RANK(cl_team, NODE) != args.args.root)) {
+                (cl_team->sbgps[levels[l]].sbgp->group_rank !=
+                 args.args.root)) {
                 args.args.src.info = args.args.dst.info;
             }
         }
-        UCC_CHECK_GOTO(
-            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
-            out, status);
+        UCC_CHECK_GOTO(ucc_coll_init(cl_team->sbgps[levels[l]].score_map,
+                                     &args, &tasks[n_tasks]),
+                       out, status);
         n_tasks++;
+        /* upper levels work on the result of the lower ones */
         args.args.mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
         args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
     }
 
-    if (SBGP_ENABLED(cl_team, NODE_LEADERS)) {
-        ucc_assert(cl_team->top_sbgp == UCC_HIER_SBGP_NODE_LEADERS);
-        args.args.coll_type = UCC_COLL_TYPE_ALLREDUCE;
-        UCC_CHECK_GOTO(ucc_coll_init(SCORE_MAP(cl_team, NODE_LEADERS), &args,
-                                     &tasks[n_tasks]),
+    /* For bcast src should point to origin dst of allreduce */
+    args.args.src.info  = args.args.dst.info;
+    args.args.coll_type = UCC_COLL_TYPE_BCAST;
+    for (l = n_levels - 1; l >= 0; l--) {
+        if (ucc_cl_hier_is_top_level(cl_team, levels[l])) {
+            continue;
+        }
+        UCC_CHECK_GOTO(ucc_coll_init(cl_team->sbgps[levels[l]].score_map,
+                                     &args, &tasks[n_tasks]),
                        out, status);
         n_tasks++;
     }
 
-
-    if (SBGP_ENABLED(cl_team, NODE) &&
-        cl_team->top_sbgp != UCC_HIER_SBGP_NODE) {
-        /* For bcast src should point to origin dst of allreduce */
-        args.args.src.info  = args.args.dst.info;
-        args.args.coll_type = UCC_COLL_TYPE_BCAST;
-        UCC_CHECK_GOTO(
-            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
-            out, status);
-        n_tasks++;
-    }
-
     /* subscription logic is different depending on top level schedule type
      * being used
      */
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -14,13 +14,20 @@ ucc_base_coll_alg_info_t
              .name = "node_split",
              .desc = "splitting alltoall into two concurrent a2av calls"
                      " within the node and outside of it"},
+        [UCC_CL_HIER_ALLTOALL_ALG_NODE_AGGR] =
+            {.id   = UCC_CL_HIER_ALLTOALL_ALG_NODE_AGGR,
+             .name = "node_aggr",
+             .desc = "aggregation of inter node data at node leaders,"
+                     " one message per pair of nodes"},
         [UCC_CL_HIER_ALLTOALL_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
-UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_alltoall_init,
-                         (coll_args, team, task),
-                         ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
-                         ucc_coll_task_t **task)
+/* alltoall is executed as alltoallv with equal counts */
+static ucc_status_t
+ucc_cl_hier_alltoall_as_alltoallv(ucc_base_coll_args_t   *coll_args,
+                                  ucc_base_team_t        *team,
+                                  ucc_coll_task_t       **task,
+                                  ucc_base_coll_init_fn_t a2av_init)
 {
     ucc_cl_hier_team_t     *cl_team = ucc_derived_of(team, ucc_cl_hier_team_t);
     ucc_rank_t              tsize   = UCC_CL_TEAM_SIZE(cl_team);
@@ -84,11 +91,29 @@ UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_alltoall_init,
         displs[i] = displs[i - 1] + count;
     }
 
-    status = ucc_cl_hier_alltoallv_init(&args, team, task);
+    status = a2av_init(&args, team, task);
     if (UCC_OK != status) {
-        cl_error(team->context->lib, "failed to init split node a2av task");
+        cl_error(team->context->lib, "failed to init a2av task");
     }
 
     ucc_mc_free(h);
     return status;
 }
+
+UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_alltoall_init,
+                         (coll_args, team, task),
+                         ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
+                         ucc_coll_task_t **task)
+{
+    return ucc_cl_hier_alltoall_as_alltoallv(coll_args, team, task,
+                                             ucc_cl_hier_alltoallv_init);
+}
+
+UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_alltoall_node_aggr_init,
+                         (coll_args, team, task),
+                         ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
+                         ucc_coll_task_t **task)
+{
+    /* equal counts: node_aggr computes the layout without headers */
+    return ucc_cl_hier_alltoallv_node_aggr_init(coll_args, team, task);
+}
@@ -16,6 +16,11 @@ ucc_base_coll_alg_info_t
              .name = "node_split",
              .desc = "splitting alltoallv into two concurrent a2av calls"
                      " withing the node and outside of it"},
+        [UCC_CL_HIER_ALLTOALLV_ALG_NODE_AGGR] =
+            {.id   = UCC_CL_HIER_ALLTOALLV_ALG_NODE_AGGR,
+             .name = "node_aggr",
+             .desc = "aggregation of inter node data at node leaders,"
+                     " one message per pair of nodes"},
         [UCC_CL_HIER_ALLTOALLV_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
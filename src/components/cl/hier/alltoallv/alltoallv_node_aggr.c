@@ -0,0 +1,1000 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "alltoallv.h"
+#include "../cl_hier_coll.h"
+#include "core/ucc_team.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Node aggregated alltoallv: data for the ranks of the same node is exchanged
+   with alltoallv over NODE sbgp, data for other nodes travels through node
+   leaders so there is a single message per pair of nodes on the network:
+   1. every rank packs its data for other nodes ordered by destination node
+      and gathers per destination sizes (hdr) at node leader
+   2. node leaders exchange the sizes of the data they are going to send
+      to each other (NODE_LEADERS alltoallv) and gather packed data (NODE
+      gatherv)
+   3. node leaders rearrange gathered data per destination node and exchange
+      it with NODE_LEADERS alltoallv
+   4. node leaders rearrange received data per destination rank and scatter
+      it (NODE scatterv), every rank unpacks it into dst
+   The sub collectives are initialized once, their count arrays live in
+   the scratch and the ones known only at runtime are filled before the
+   post. Leader staging buffers are grown on demand and kept across posts.
+   Alltoall sends the same number of bytes to every rank, the layout is
+   computed locally and steps 1 and 2 do not exchange headers.
+
+   Ranks are ordered by node (NODE_LEADERS sbgp order) and by team rank
+   within the node, all the packed buffers and headers follow that order. */
+
+enum {
+    UCC_CL_HIER_A2AV_AGGR_PHASE_HDR,
+    UCC_CL_HIER_A2AV_AGGR_PHASE_DATA,
+    UCC_CL_HIER_A2AV_AGGR_PHASE_XCHG,
+    UCC_CL_HIER_A2AV_AGGR_PHASE_SCATTER
+};
+
+/* sub collectives, initialized once and reposted by every post */
+enum {
+    UCC_CL_HIER_A2AV_AGGR_TASK_HDR,     /* NODE gather of hdr */
+    UCC_CL_HIER_A2AV_AGGR_TASK_LHDR,    /* NODE_LEADERS alltoallv of hdr_send */
+    UCC_CL_HIER_A2AV_AGGR_TASK_DATA,    /* NODE gatherv of packed data */
+    UCC_CL_HIER_A2AV_AGGR_TASK_XCHG,    /* NODE_LEADERS alltoallv of data */
+    UCC_CL_HIER_A2AV_AGGR_TASK_INTRA,   /* NODE alltoallv of own node data */
+    UCC_CL_HIER_A2AV_AGGR_TASK_SCATTER, /* NODE scatterv of received data */
+    UCC_CL_HIER_A2AV_AGGR_TASK_LAST
+};
+
+typedef struct ucc_cl_hier_a2av_aggr_meta {
+    ucc_rank_t  n_nodes;
+    ucc_rank_t  my_node;
+    ucc_rank_t  node_size;
+    int         is_leader;
+    int         uniform;     /* alltoall: "block" bytes for every pair */
+    size_t      block;
+    size_t      send_remote; /* bytes sent to the ranks of other nodes */
+    size_t      recv_remote; /* bytes received from the ranks of other nodes */
+    size_t      gtotal;      /* leader: bytes gathered from the node */
+    size_t      rtotal;      /* leader: bytes received from other leaders */
+    ucc_rank_t *order;       /* team ranks sorted by node and team rank */
+    ucc_rank_t *nstart;      /* position of the first rank of node in order */
+    ucc_rank_t *lidx;        /* NODE sbgp rank of the i-th rank of own node */
+    uint64_t   *sc, *sd;     /* send counts/displacements in bytes */
+    uint64_t   *rc, *rd;     /* recv counts/displacements in bytes */
+    uint64_t   *hdr;         /* bytes sent to order[i], 0 for own node */
+    uint64_t   *node_hdr;    /* leader: hdr of every NODE sbgp rank */
+    uint64_t   *hdr_send;    /* leader: node_hdr blocks per peer node */
+    uint64_t   *hdr_recv;    /* leader: hdr_send blocks of peer leaders,
+                                reuses node_hdr storage */
+    uint64_t   *lcounts;     /* leader: NODE_LEADERS alltoallv counts */
+    uint64_t   *ncounts;     /* NODE gatherv/scatterv/alltoallv counts */
+    uint64_t   *cursor;      /* leader: write positions used by rearranging */
+    void       *pack;
+    void       *recv;
+    void       *src;
+    void       *dst;
+} ucc_cl_hier_a2av_aggr_meta_t;
+
+#define A2AV_AGGR_META(_schedule)                                              \
+    ((ucc_cl_hier_a2av_aggr_meta_t *)(_schedule)->scratch->addr)
+
+#define A2AV_AGGR(_schedule) ((_schedule)->alltoallv_node_aggr)
+
+static inline ucc_rank_t
+ucc_cl_hier_a2av_aggr_nq(ucc_cl_hier_a2av_aggr_meta_t *m, ucc_rank_t q)
+{
+    return m->nstart[q + 1] - m->nstart[q];
+}
+
+/* bytes the j-th rank of own node sends to the t-th rank of peer node q */
+static inline uint64_t
+ucc_cl_hier_a2av_aggr_slen(ucc_cl_hier_a2av_aggr_meta_t *m, ucc_rank_t q,
+                           ucc_rank_t j, ucc_rank_t t)
+{
+    if (m->uniform) {
+        return m->block;
+    }
+    return m->hdr_send[m->lcounts[m->n_nodes + q] +
+                       (size_t)j * ucc_cl_hier_a2av_aggr_nq(m, q) + t];
+}
+
+/* bytes the j-th rank of own node receives from the t-th rank of peer
+   node q */
+static inline uint64_t
+ucc_cl_hier_a2av_aggr_rlen(ucc_cl_hier_a2av_aggr_meta_t *m, ucc_rank_t q,
+                           ucc_rank_t t, ucc_rank_t j)
+{
+    if (m->uniform) {
+        return m->block;
+    }
+    return m->hdr_recv[m->lcounts[m->n_nodes + q] + (size_t)t * m->node_size +
+                       j];
+}
+
+static inline void ucc_cl_hier_a2av_aggr_args(ucc_coll_task_t      *task,
+                                              ucc_coll_type_t       coll_type,
+                                              ucc_base_coll_args_t *bargs)
+{
+    memset(bargs, 0, sizeof(*bargs));
+    bargs->team           = task->bargs.team;
+    bargs->args.coll_type = coll_type;
+    bargs->args.mask      = UCC_COLL_ARGS_FIELD_FLAGS;
+    bargs->args.flags     = UCC_COLL_ARGS_FLAG_COUNT_64BIT |
+                            UCC_COLL_ARGS_FLAG_DISPLACEMENTS_64BIT;
+}
+
+static inline void ucc_cl_hier_a2av_aggr_set_v(ucc_coll_buffer_info_v_t *info,
+                                               void *buffer, uint64_t *counts,
+                                               uint64_t      *displs,
+                                               ucc_datatype_t dt)
+{
+    info->buffer        = buffer;
+    info->counts        = (ucc_count_t *)counts;
+    info->displacements = (ucc_aint_t *)displs;
+    info->datatype      = dt;
+    info->mem_type      = UCC_MEMORY_TYPE_HOST;
+}
+
+static inline void ucc_cl_hier_a2av_aggr_set(ucc_coll_buffer_info_t *info,
+                                             void *buffer, size_t count)
+{
+    info->buffer   = buffer;
+    info->count    = count;
+    info->datatype = UCC_DT_UINT8;
+    info->mem_type = UCC_MEMORY_TYPE_HOST;
+}
+
+static inline ucc_status_t
+ucc_cl_hier_a2av_aggr_post(ucc_cl_hier_schedule_t *schedule, int id)
+{
+    return ucc_task_start_handler(&schedule->super.super.super,
+                                  A2AV_AGGR(schedule).tasks[id]);
+}
+
+/* returns UCC_OK once sub collectives [first, last] are completed,
+   the tasks are kept for the next post */
+static ucc_status_t ucc_cl_hier_a2av_aggr_test(ucc_cl_hier_schedule_t *schedule,
+                                               int first, int last)
+{
+    ucc_coll_task_t *task;
+    int              i;
+
+    for (i = first; i <= last; i++) {
+        task = A2AV_AGGR(schedule).tasks[i];
+        if (!task) {
+            continue;
+        }
+        if (task->status > 0) {
+            return UCC_INPROGRESS;
+        }
+        if (ucc_unlikely(task->status < 0)) {
+            return task->status;
+        }
+    }
+    return UCC_OK;
+}
+
+/* grows a leader staging buffer, the buffer is kept across posts */
+static ucc_status_t ucc_cl_hier_a2av_aggr_reserve(ucc_mc_buffer_header_t **buf,
+                                                  size_t *buf_size, size_t size)
+{
+    ucc_status_t status;
+
+    size = ucc_max(size, 1);
+    if (*buf && *buf_size >= size) {
+        return UCC_OK;
+    }
+    if (*buf) {
+        ucc_mc_free(*buf);
+    }
+    status = ucc_mc_alloc(buf, size, UCC_MEMORY_TYPE_HOST);
+    if (ucc_unlikely(UCC_OK != status)) {
+        *buf      = NULL;
+        *buf_size = 0;
+        return status;
+    }
+    *buf_size = size;
+    return UCC_OK;
+}
+
+static void ucc_cl_hier_a2av_aggr_free_bufs(ucc_cl_hier_schedule_t *schedule)
+{
+    if (A2AV_AGGR(schedule).gbuf) {
+        ucc_mc_free(A2AV_AGGR(schedule).gbuf);
+        A2AV_AGGR(schedule).gbuf = NULL;
+    }
+    if (A2AV_AGGR(schedule).rbuf) {
+        ucc_mc_free(A2AV_AGGR(schedule).rbuf);
+        A2AV_AGGR(schedule).rbuf = NULL;
+    }
+}
+
+static void ucc_cl_hier_a2av_aggr_free(ucc_cl_hier_schedule_t *schedule)
+{
+    ucc_coll_task_t *t;
+    int              i;
+
+    for (i = 0; i < UCC_CL_HIER_A2AV_AGGR_TASK_LAST; i++) {
+        t = A2AV_AGGR(schedule).tasks[i];
+        if (t) {
+            t->finalize(t);
+            A2AV_AGGR(schedule).tasks[i] = NULL;
+        }
+    }
+    ucc_cl_hier_a2av_aggr_free_bufs(schedule);
+}
+
+/* Leader: send headers to peer leaders, gather packed data of the node */
+static ucc_status_t ucc_cl_hier_a2av_aggr_gather(ucc_cl_hier_schedule_t *schedule)
+{
+    ucc_coll_task_t              *task    = &schedule->super.super.super;
+    ucc_cl_hier_team_t           *cl_team = ucc_derived_of(task->team,
+                                                           ucc_cl_hier_team_t);
+    ucc_cl_hier_a2av_aggr_meta_t *m       = A2AV_AGGR_META(schedule);
+    ucc_rank_t                    tsize   = UCC_CL_TEAM_SIZE(cl_team);
+    ucc_rank_t                    nsize   = m->node_size;
+    uint64_t                     *hc      = m->lcounts;
+    uint64_t                     *hd      = m->lcounts + m->n_nodes;
+    uint64_t                     *gc      = m->ncounts;
+    uint64_t                     *gd      = m->ncounts + nsize;
+    ucc_rank_t                    q, nq, i, j, k;
+    ucc_status_t                  status;
+    size_t                        off;
+
+    if (m->is_leader) {
+        if (!m->uniform) {
+            /* block for peer node q: rows - ranks of own node,
+               columns - ranks of node q */
+            off = 0;
+            for (q = 0; q < m->n_nodes; q++) {
+                nq    = ucc_cl_hier_a2av_aggr_nq(m, q);
+                hd[q] = off;
+                hc[q] = (q == m->my_node) ? 0 : (uint64_t)nsize * nq;
+                for (j = 0; j < nsize && hc[q] > 0; j++) {
+                    memcpy(m->hdr_send + off + j * nq,
+                           m->node_hdr + (size_t)m->lidx[j] * tsize +
+                               m->nstart[q],
+                           nq * sizeof(uint64_t));
+                }
+                off += hc[q];
+            }
+        }
+
+        m->gtotal = 0;
+        for (i = 0; i < nsize; i++) {
+            gd[i] = m->gtotal;
+            if (m->uniform) {
+                gc[i] = (uint64_t)m->block * (tsize - nsize);
+            } else {
+                gc[i] = 0;
+                for (k = 0; k < tsize; k++) {
+                    gc[i] += m->node_hdr[(size_t)i * tsize + k];
+                }
+            }
+            m->gtotal += gc[i];
+        }
+
+        if (!m->uniform) {
+            /* node_hdr is not used past this point, hdr_recv reuses it */
+            status = ucc_cl_hier_a2av_aggr_post(
+                schedule, UCC_CL_HIER_A2AV_AGGR_TASK_LHDR);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+
+        /* gathered data followed by the data rearranged per peer node */
+        status = ucc_cl_hier_a2av_aggr_reserve(&A2AV_AGGR(schedule).gbuf,
+                                               &A2AV_AGGR(schedule).gbuf_size,
+                                               2 * m->gtotal);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+
+    if (!SBGP_ENABLED(cl_team, NODE)) {
+        memcpy(A2AV_AGGR(schedule).gbuf->addr, m->pack, m->send_remote);
+        return UCC_OK;
+    }
+    if (m->is_leader) {
+        A2AV_AGGR(schedule).tasks[UCC_CL_HIER_A2AV_AGGR_TASK_DATA]
+            ->bargs.args.dst.info_v.buffer = A2AV_AGGR(schedule).gbuf->addr;
+    }
+    return ucc_cl_hier_a2av_aggr_post(schedule,
+                                      UCC_CL_HIER_A2AV_AGGR_TASK_DATA);
+}
+
+/* Leader: rearrange gathered data per peer node and exchange it */
+static ucc_status_t
+ucc_cl_hier_a2av_aggr_exchange(ucc_cl_hier_schedule_t *schedule)
+{
+    ucc_cl_hier_a2av_aggr_meta_t *m       = A2AV_AGGR_META(schedule);
+    ucc_rank_t                    nsize   = m->node_size;
+    ucc_rank_t                    nnodes  = m->n_nodes;
+    uint64_t                     *hd      = m->lcounts + nnodes;
+    uint64_t                     *dsc     = m->lcounts + 2 * nnodes;
+    uint64_t                     *dsd     = m->lcounts + 3 * nnodes;
+    uint64_t                     *drc     = m->lcounts + 4 * nnodes;
+    uint64_t                     *drd     = m->lcounts + 5 * nnodes;
+    uint64_t                     *gd      = m->ncounts + nsize;
+    void                         *gathered, *sbuf;
+    ucc_coll_args_t              *xargs;
+    ucc_rank_t                    q, j, t, nq;
+    size_t                        soff, roff, off, len;
+    uint64_t                      i;
+    ucc_status_t                  status;
+
+    soff = roff = 0;
+    for (q = 0; q < nnodes; q++) {
+        nq     = (q == m->my_node) ? 0 : ucc_cl_hier_a2av_aggr_nq(m, q);
+        dsc[q] = drc[q] = 0;
+        if (m->uniform) {
+            dsc[q] = drc[q] = (uint64_t)nsize * nq * m->block;
+        } else {
+            for (i = 0; i < (uint64_t)nsize * nq; i++) {
+                dsc[q] += m->hdr_send[hd[q] + i];
+                drc[q] += m->hdr_recv[hd[q] + i];
+            }
+        }
+        dsd[q]       = soff;
+        drd[q]       = roff;
+        m->cursor[q] = soff;
+        soff        += dsc[q];
+        roff        += drc[q];
+    }
+    ucc_assert(soff == m->gtotal);
+    m->rtotal = roff;
+
+    /* [source][node][destination] -> [node][source][destination] */
+    gathered = A2AV_AGGR(schedule).gbuf->addr;
+    sbuf     = PTR_OFFSET(gathered, m->gtotal);
+    for (j = 0; j < nsize; j++) {
+        off = gd[m->lidx[j]];
+        for (q = 0; q < nnodes; q++) {
+            if (q == m->my_node) {
+                continue;
+            }
+            nq  = ucc_cl_hier_a2av_aggr_nq(m, q);
+            len = 0;
+            for (t = 0; t < nq; t++) {
+                len += ucc_cl_hier_a2av_aggr_slen(m, q, j, t);
+            }
+            memcpy(PTR_OFFSET(sbuf, m->cursor[q]), PTR_OFFSET(gathered, off),
+                   len);
+            m->cursor[q] += len;
+            off          += len;
+        }
+    }
+
+    /* received data followed by the data rearranged per destination */
+    status = ucc_cl_hier_a2av_aggr_reserve(&A2AV_AGGR(schedule).rbuf,
+                                           &A2AV_AGGR(schedule).rbuf_size,
+                                           2 * m->rtotal);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    xargs = &A2AV_AGGR(schedule).tasks[UCC_CL_HIER_A2AV_AGGR_TASK_XCHG]
+                 ->bargs.args;
+    xargs->src.info_v.buffer = sbuf;
+    xargs->dst.info_v.buffer = A2AV_AGGR(schedule).rbuf->addr;
+    return ucc_cl_hier_a2av_aggr_post(schedule,
+                                      UCC_CL_HIER_A2AV_AGGR_TASK_XCHG);
+}
+
+/* Leader: rearrange received data per destination rank, scatter it */
+static ucc_status_t
+ucc_cl_hier_a2av_aggr_scatter(ucc_cl_hier_schedule_t *schedule)
+{
+    ucc_coll_task_t              *task    = &schedule->super.super.super;
+    ucc_cl_hier_team_t           *cl_team = ucc_derived_of(task->team,
+                                                           ucc_cl_hier_team_t);
+    ucc_cl_hier_a2av_aggr_meta_t *m       = A2AV_AGGR_META(schedule);
+    ucc_rank_t                    nsize   = m->node_size;
+    uint64_t                     *sc      = m->ncounts + 2 * nsize;
+    uint64_t                     *sd      = m->ncounts + 3 * nsize;
+    void                         *sbuf    = NULL;
+    void                         *rbuf;
+    ucc_rank_t                    q, t, j, nq;
+    size_t                        off, len;
+
+    if (m->is_leader) {
+        rbuf = A2AV_AGGR(schedule).rbuf->addr;
+        sbuf = PTR_OFFSET(rbuf, m->rtotal);
+        memset(m->cursor, 0, nsize * sizeof(uint64_t));
+        for (q = 0; q < m->n_nodes; q++) {
+            nq = (q == m->my_node) ? 0 : ucc_cl_hier_a2av_aggr_nq(m, q);
+            for (t = 0; t < nq; t++) {
+                for (j = 0; j < nsize; j++) {
+                    m->cursor[j] += ucc_cl_hier_a2av_aggr_rlen(m, q, t, j);
+                }
+            }
+        }
+        off = 0;
+        for (j = 0; j < nsize; j++) {
+            sc[m->lidx[j]] = m->cursor[j];
+            sd[m->lidx[j]] = off;
+            m->cursor[j]   = off;
+            off           += sc[m->lidx[j]];
+        }
+        /* [node][source][destination] -> [destination][node][source] */
+        off = 0;
+        for (q = 0; q < m->n_nodes; q++) {
+            nq = (q == m->my_node) ? 0 : ucc_cl_hier_a2av_aggr_nq(m, q);
+            for (t = 0; t < nq; t++) {
+                for (j = 0; j < nsize; j++) {
+                    len = ucc_cl_hier_a2av_aggr_rlen(m, q, t, j);
+                    memcpy(PTR_OFFSET(sbuf, m->cursor[j]),
+                           PTR_OFFSET(rbuf, off), len);
+                    m->cursor[j] += len;
+                    off          += len;
+                }
+            }
+        }
+    }
+
+    if (!SBGP_ENABLED(cl_team, NODE)) {
+        memcpy(m->recv, sbuf, m->recv_remote);
+        return UCC_OK;
+    }
+    if (m->is_leader) {
+        A2AV_AGGR(schedule).tasks[UCC_CL_HIER_A2AV_AGGR_TASK_SCATTER]
+            ->bargs.args.src.info_v.buffer = sbuf;
+    }
+    return ucc_cl_hier_a2av_aggr_post(schedule,
+                                      UCC_CL_HIER_A2AV_AGGR_TASK_SCATTER);
+}
+
+static inline int ucc_cl_hier_a2av_aggr_is_local(ucc_cl_hier_a2av_aggr_meta_t *m,
+                                                 ucc_rank_t                    k)
+{
+    return (k >= m->nstart[m->my_node]) && (k < m->nstart[m->my_node + 1]);
+}
+
+static void ucc_cl_hier_alltoallv_node_aggr_progress(ucc_coll_task_t *task)
+{
+    ucc_cl_hier_schedule_t       *schedule =
+        ucc_derived_of(task, ucc_cl_hier_schedule_t);
+    ucc_cl_hier_a2av_aggr_meta_t *m        = A2AV_AGGR_META(schedule);
+    ucc_rank_t                    tsize    = (ucc_rank_t)task->team->params.size;
+    ucc_status_t                  status;
+    ucc_rank_t                    k, r;
+    size_t                        off;
+
+    if (A2AV_AGGR(schedule).phase == UCC_CL_HIER_A2AV_AGGR_PHASE_HDR) {
+        status = ucc_cl_hier_a2av_aggr_test(schedule,
+                                            UCC_CL_HIER_A2AV_AGGR_TASK_HDR,
+                                            UCC_CL_HIER_A2AV_AGGR_TASK_HDR);
+        if (status != UCC_OK) {
+            goto out;
+        }
+        status = ucc_cl_hier_a2av_aggr_gather(schedule);
+        if (ucc_unlikely(status != UCC_OK)) {
+            goto out;
+        }
+        A2AV_AGGR(schedule).phase = UCC_CL_HIER_A2AV_AGGR_PHASE_DATA;
+    }
+
+    if (A2AV_AGGR(schedule).phase == UCC_CL_HIER_A2AV_AGGR_PHASE_DATA) {
+        status = ucc_cl_hier_a2av_aggr_test(schedule,
+                                            UCC_CL_HIER_A2AV_AGGR_TASK_LHDR,
+                                            UCC_CL_HIER_A2AV_AGGR_TASK_DATA);
+        if (status != UCC_OK) {
+            goto out;
+        }
+        if (m->is_leader) {
+            status = ucc_cl_hier_a2av_aggr_exchange(schedule);
+            A2AV_AGGR(schedule).phase = UCC_CL_HIER_A2AV_AGGR_PHASE_XCHG;
+        } else {
+            status = ucc_cl_hier_a2av_aggr_scatter(schedule);
+            A2AV_AGGR(schedule).phase = UCC_CL_HIER_A2AV_AGGR_PHASE_SCATTER;
+        }
+        if (ucc_unlikely(status != UCC_OK)) {
+            goto out;
+        }
+    }
+
+    if (A2AV_AGGR(schedule).phase == UCC_CL_HIER_A2AV_AGGR_PHASE_XCHG) {
+        status = ucc_cl_hier_a2av_aggr_test(schedule,
+                                            UCC_CL_HIER_A2AV_AGGR_TASK_XCHG,
+                                            UCC_CL_HIER_A2AV_AGGR_TASK_XCHG);
+        if (status != UCC_OK) {
+            goto out;
+        }
+        status = ucc_cl_hier_a2av_aggr_scatter(schedule);
+        if (ucc_unlikely(status != UCC_OK)) {
+            goto out;
+        }
+        A2AV_AGGR(schedule).phase = UCC_CL_HIER_A2AV_AGGR_PHASE_SCATTER;
+    }
+
+    status = ucc_cl_hier_a2av_aggr_test(schedule,
+                                        UCC_CL_HIER_A2AV_AGGR_TASK_INTRA,
+                                        UCC_CL_HIER_A2AV_AGGR_TASK_SCATTER);
+    if (status != UCC_OK) {
+        goto out;
+    }
+    off = 0;
+    for (k = 0; k < tsize; k++) {
+        if (ucc_cl_hier_a2av_aggr_is_local(m, k)) {
+            continue;
+        }
+        r = m->order[k];
+        memcpy(PTR_OFFSET(m->dst, m->rd[r]), PTR_OFFSET(m->recv, off),
+               m->rc[r]);
+        off += m->rc[r];
+    }
+    UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_alltoallv_node_aggr_done",
+                                      0);
+out:
+    task->status = status;
+}
+
+static ucc_status_t ucc_cl_hier_alltoallv_node_aggr_start(ucc_coll_task_t *task)
+{
+    ucc_cl_hier_schedule_t       *schedule =
+        ucc_derived_of(task, ucc_cl_hier_schedule_t);
+    ucc_cl_hier_team_t           *cl_team  = ucc_derived_of(task->team,
+                                                            ucc_cl_hier_team_t);
+    ucc_cl_hier_a2av_aggr_meta_t *m        = A2AV_AGGR_META(schedule);
+    ucc_rank_t                    tsize    = UCC_CL_TEAM_SIZE(cl_team);
+    ucc_rank_t                    rank     = UCC_CL_TEAM_RANK(cl_team);
+    ucc_status_t                  status;
+    ucc_rank_t                    k, r;
+    size_t                        off;
+
+    UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_alltoallv_node_aggr_start",
+                                      0);
+    A2AV_AGGR(schedule).phase = UCC_CL_HIER_A2AV_AGGR_PHASE_HDR;
+
+    off = 0;
+    for (k = 0; k < tsize; k++) {
+        r = m->order[k];
+        if (ucc_cl_hier_a2av_aggr_is_local(m, k)) {
+            m->hdr[k] = 0;
+            continue;
+        }
+        m->hdr[k] = m->sc[r];
+        memcpy(PTR_OFFSET(m->pack, off), PTR_OFFSET(m->src, m->sd[r]),
+               m->sc[r]);
+        off += m->sc[r];
+    }
+
+    if (SBGP_ENABLED(cl_team, NODE)) {
+        status = ucc_cl_hier_a2av_aggr_post(schedule,
+                                            UCC_CL_HIER_A2AV_AGGR_TASK_INTRA);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+
+        /* alltoall leaders compute the layout locally */
+        if (!m->uniform) {
+            status = ucc_cl_hier_a2av_aggr_post(schedule,
+                                                UCC_CL_HIER_A2AV_AGGR_TASK_HDR);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+    } else {
+        /* the only rank of the node */
+        memcpy(PTR_OFFSET(m->dst, m->rd[rank]), PTR_OFFSET(m->src, m->sd[rank]),
+               m->sc[rank]);
+        if (!m->uniform) {
+            memcpy(m->node_hdr, m->hdr, tsize * sizeof(uint64_t));
+        }
+    }
+
+    task->status = UCC_INPROGRESS;
+    return ucc_progress_queue_enqueue(
+        cl_team->super.super.context->ucc_context->pq, task);
+}
+
+static ucc_status_t
+ucc_cl_hier_alltoallv_node_aggr_finalize(ucc_coll_task_t *task)
+{
+    ucc_cl_hier_schedule_t *schedule =
+        ucc_derived_of(task, ucc_cl_hier_schedule_t);
+
+    UCC_CL_HIER_PROFILE_REQUEST_EVENT(task,
+                                      "cl_hier_alltoallv_node_aggr_finalize", 0);
+    ucc_cl_hier_a2av_aggr_free(schedule);
+    ucc_mc_free(schedule->scratch);
+    ucc_cl_hier_put_schedule(&schedule->super.super);
+    return UCC_OK;
+}
+
+static inline ucc_status_t
+ucc_cl_hier_a2av_aggr_init_task(ucc_cl_hier_schedule_t *schedule,
+                                ucc_score_map_t *map, ucc_base_coll_args_t *bargs,
+                                int id)
+{
+    return ucc_coll_init(map, bargs, &A2AV_AGGR(schedule).tasks[id]);
+}
+
+/* Initializes the sub collectives of all the steps the process takes part
+   in. Counts point to the scratch arrays filled before every post, leader
+   staging buffers are set right before the post since they may grow */
+static ucc_status_t
+ucc_cl_hier_a2av_aggr_init_tasks(ucc_cl_hier_schedule_t *schedule)
+{
+    ucc_coll_task_t              *task    = &schedule->super.super.super;
+    ucc_cl_hier_team_t           *cl_team = ucc_derived_of(task->team,
+                                                           ucc_cl_hier_team_t);
+    ucc_cl_hier_a2av_aggr_meta_t *m       = A2AV_AGGR_META(schedule);
+    ucc_rank_t                    tsize   = UCC_CL_TEAM_SIZE(cl_team);
+    ucc_rank_t                    nsize   = m->node_size;
+    ucc_rank_t                    nnodes  = m->n_nodes;
+    uint64_t                     *ic      = m->ncounts + 4 * nsize;
+    uint64_t                     *l       = m->lcounts;
+    ucc_base_coll_args_t          bargs;
+    ucc_status_t                  status;
+
+    if (m->is_leader) {
+        if (m->uniform) {
+            /* alltoall layout does not change between posts */
+            status = ucc_cl_hier_a2av_aggr_reserve(
+                &A2AV_AGGR(schedule).gbuf, &A2AV_AGGR(schedule).gbuf_size,
+                2 * nsize * m->send_remote);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+            status = ucc_cl_hier_a2av_aggr_reserve(
+                &A2AV_AGGR(schedule).rbuf, &A2AV_AGGR(schedule).rbuf_size,
+                2 * nsize * m->recv_remote);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        } else {
+            ucc_cl_hier_a2av_aggr_args(task, UCC_COLL_TYPE_ALLTOALLV, &bargs);
+            ucc_cl_hier_a2av_aggr_set_v(&bargs.args.src.info_v, m->hdr_send,
+                                        l, l + nnodes, UCC_DT_UINT64);
+            ucc_cl_hier_a2av_aggr_set_v(&bargs.args.dst.info_v, m->hdr_recv,
+                                        l, l + nnodes, UCC_DT_UINT64);
+            status = ucc_cl_hier_a2av_aggr_init_task(
+                schedule, SCORE_MAP(cl_team, NODE_LEADERS), &bargs,
+                UCC_CL_HIER_A2AV_AGGR_TASK_LHDR);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+        ucc_cl_hier_a2av_aggr_args(task, UCC_COLL_TYPE_ALLTOALLV, &bargs);
+        bargs.args.flags |= UCC_COLL_ARGS_FLAG_CONTIG_SRC_BUFFER |
+                            UCC_COLL_ARGS_FLAG_CONTIG_DST_BUFFER;
+        ucc_cl_hier_a2av_aggr_set_v(&bargs.args.src.info_v, NULL,
+                                    l + 2 * nnodes, l + 3 * nnodes,
+                                    UCC_DT_UINT8);
+        ucc_cl_hier_a2av_aggr_set_v(&bargs.args.dst.info_v, NULL,
+                                    l + 4 * nnodes, l + 5 * nnodes,
+                                    UCC_DT_UINT8);
+        status = ucc_cl_hier_a2av_aggr_init_task(
+            schedule, SCORE_MAP(cl_team, NODE_LEADERS), &bargs,
+            UCC_CL_HIER_A2AV_AGGR_TASK_XCHG);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+
+    if (!SBGP_ENABLED(cl_team, NODE)) {
+        return UCC_OK;
+    }
+
+    ucc_cl_hier_a2av_aggr_args(task, UCC_COLL_TYPE_ALLTOALLV, &bargs);
+    ucc_cl_hier_a2av_aggr_set_v(&bargs.args.src.info_v, m->src, ic,
+                                ic + nsize, UCC_DT_UINT8);
+    ucc_cl_hier_a2av_aggr_set_v(&bargs.args.dst.info_v, m->dst,
+                                ic + 2 * nsize, ic + 3 * nsize, UCC_DT_UINT8);
+    status = ucc_cl_hier_a2av_aggr_init_task(schedule, SCORE_MAP(cl_team, NODE),
+                                             &bargs,
+                                             UCC_CL_HIER_A2AV_AGGR_TASK_INTRA);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+
+    if (!m->uniform) {
+        /* per destination sizes of the node ranks gathered at node leader */
+        ucc_cl_hier_a2av_aggr_args(task, UCC_COLL_TYPE_GATHER, &bargs);
+        bargs.args.root              = task->team->params.team->topo
+                                           ->node_leader_rank_id;
+        bargs.args.src.info.buffer   = m->hdr;
+        bargs.args.src.info.count    = tsize;
+        bargs.args.src.info.datatype = UCC_DT_UINT64;
+        bargs.args.src.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        if (m->is_leader) {
+            bargs.args.dst.info.buffer   = m->node_hdr;
+            bargs.args.dst.info.count    = (size_t)tsize * nsize;
+            bargs.args.dst.info.datatype = UCC_DT_UINT64;
+            bargs.args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        }
+        status = ucc_cl_hier_a2av_aggr_init_task(
+            schedule, SCORE_MAP(cl_team, NODE), &bargs,
+            UCC_CL_HIER_A2AV_AGGR_TASK_HDR);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+
+    ucc_cl_hier_a2av_aggr_args(task, UCC_COLL_TYPE_GATHERV, &bargs);
+    bargs.args.root = task->team->params.team->topo->node_leader_rank_id;
+    ucc_cl_hier_a2av_aggr_set(&bargs.args.src.info, m->pack, m->send_remote);
+    if (m->is_leader) {
+        ucc_cl_hier_a2av_aggr_set_v(&bargs.args.dst.info_v, NULL, m->ncounts,
+                                    m->ncounts + nsize, UCC_DT_UINT8);
+    }
+    status = ucc_cl_hier_a2av_aggr_init_task(schedule, SCORE_MAP(cl_team, NODE),
+                                             &bargs,
+                                             UCC_CL_HIER_A2AV_AGGR_TASK_DATA);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+
+    ucc_cl_hier_a2av_aggr_args(task, UCC_COLL_TYPE_SCATTERV, &bargs);
+    bargs.args.root = task->team->params.team->topo->node_leader_rank_id;
+    ucc_cl_hier_a2av_aggr_set(&bargs.args.dst.info, m->recv, m->recv_remote);
+    if (m->is_leader) {
+        ucc_cl_hier_a2av_aggr_set_v(&bargs.args.src.info_v, NULL,
+                                    m->ncounts + 2 * nsize,
+                                    m->ncounts + 3 * nsize, UCC_DT_UINT8);
+    }
+    return ucc_cl_hier_a2av_aggr_init_task(schedule, SCORE_MAP(cl_team, NODE),
+                                           &bargs,
+                                           UCC_CL_HIER_A2AV_AGGR_TASK_SCATTER);
+}
+
+/* Fills rank ordering, per rank byte counts and intra node counts */
+static ucc_status_t
+ucc_cl_hier_a2av_aggr_meta_init(ucc_cl_hier_team_t           *cl_team,
+                                ucc_coll_args_t              *args,
+                                ucc_cl_hier_a2av_aggr_meta_t *m)
+{
+    ucc_topo_t *topo  = cl_team->super.super.params.team->topo;
+    ucc_rank_t  tsize = UCC_CL_TEAM_SIZE(cl_team);
+    ucc_rank_t  rank  = UCC_CL_TEAM_RANK(cl_team);
+    uint64_t   *ic    = m->ncounts + 4 * m->node_size;
+    size_t      sdt_size, rdt_size;
+    ucc_rank_t *node_leaders;
+    ucc_rank_t  i, k, r;
+    ucc_status_t status;
+
+    status = ucc_topo_get_node_leaders(topo, &node_leaders, NULL);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+
+    if (m->uniform) {
+        for (r = 0; r < tsize; r++) {
+            m->sc[r] = m->rc[r] = m->block;
+            m->sd[r] = m->rd[r] = (uint64_t)r * m->block;
+        }
+    } else {
+        sdt_size = ucc_dt_size(args->src.info_v.datatype);
+        rdt_size = ucc_dt_size(args->dst.info_v.datatype);
+        for (r = 0; r < tsize; r++) {
+            m->sc[r] = ucc_coll_args_get_count(args, args->src.info_v.counts,
+                                               r) * sdt_size;
+            m->sd[r] = ucc_coll_args_get_displacement(
+                           args, args->src.info_v.displacements, r) * sdt_size;
+            m->rc[r] = ucc_coll_args_get_count(args, args->dst.info_v.counts,
+                                               r) * rdt_size;
+            m->rd[r] = ucc_coll_args_get_displacement(
+                           args, args->dst.info_v.displacements, r) * rdt_size;
+        }
+    }
+
+    /* node of every team rank is the NODE_LEADERS sbgp rank of its leader,
+       hdr is used as a team rank -> node map: leaders first, every other
+       rank then reads the entry of its leader */
+    for (i = 0; i < m->n_nodes; i++) {
+        m->hdr[ucc_ep_map_eval(SBGP_MAP(cl_team, NODE_LEADERS), i)] = i;
+    }
+    /* counting sort of team ranks by node, nstart is used as a cursor */
+    memset(m->nstart, 0, (m->n_nodes + 1) * sizeof(ucc_rank_t));
+    for (r = 0; r < tsize; r++) {
+        m->hdr[r] = m->hdr[node_leaders[r]];
+        m->nstart[m->hdr[r] + 1]++;
+    }
+    m->my_node = (ucc_rank_t)m->hdr[rank];
+    for (i = 0; i < m->n_nodes; i++) {
+        m->nstart[i + 1] += m->nstart[i];
+    }
+    for (r = 0; r < tsize; r++) {
+        m->order[m->nstart[m->hdr[r]]++] = r;
+    }
+    for (i = m->n_nodes; i > 0; i--) {
+        m->nstart[i] = m->nstart[i - 1];
+    }
+    m->nstart[0] = 0;
+    ucc_assert(m->nstart[m->my_node + 1] - m->nstart[m->my_node] ==
+               m->node_size);
+
+    /* NODE sbgp rank of the ranks of own node, hdr is reused as a team
+       rank -> NODE sbgp rank map */
+    for (i = 0; i < m->node_size; i++) {
+        m->hdr[SBGP_ENABLED(cl_team, NODE)
+                   ? ucc_ep_map_eval(SBGP_MAP(cl_team, NODE), i)
+                   : rank] = i;
+    }
+    for (i = 0; i < m->node_size; i++) {
+        r          = m->order[m->nstart[m->my_node] + i];
+        m->lidx[i] = (ucc_rank_t)m->hdr[r];
+        /* intra node alltoallv counts in NODE sbgp order */
+        k                        = m->lidx[i];
+        ic[k]                    = m->sc[r];
+        ic[m->node_size + k]     = m->sd[r];
+        ic[2 * m->node_size + k] = m->rc[r];
+        ic[3 * m->node_size + k] = m->rd[r];
+    }
+    return UCC_OK;
+}
+
+UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_alltoallv_node_aggr_init,
+                         (coll_args, team, task),
+                         ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
+                         ucc_coll_task_t **task)
+{
+    ucc_cl_hier_team_t           *cl_team = ucc_derived_of(team,
+                                                           ucc_cl_hier_team_t);
+    ucc_coll_args_t              *args    = &coll_args->args;
+    ucc_topo_t                   *topo    = team->params.team->topo;
+    ucc_rank_t                    tsize   = UCC_CL_TEAM_SIZE(cl_team);
+    ucc_rank_t                    rank    = UCC_CL_TEAM_RANK(cl_team);
+    int                           uniform = (args->coll_type ==
+                                             UCC_COLL_TYPE_ALLTOALL);
+    size_t                        sdt_size, rdt_size, block;
+    size_t                        send_remote, recv_remote, size, ranks_size;
+    ucc_memory_type_t             smem, dmem;
+    ucc_cl_hier_a2av_aggr_meta_t *m;
+    ucc_cl_hier_schedule_t       *cl_schedule;
+    ucc_schedule_t               *schedule;
+    ucc_rank_t                   *node_leaders;
+    ucc_rank_t                    nnodes, nsize, i;
+    int                           is_leader;
+    ucc_status_t                  status;
+    void                         *p;
+
+    if (UCC_IS_INPLACE(*args)) {
+        cl_debug(team->context->lib, "inplace alltoallv is not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (args->mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER) {
+        cl_debug(team->context->lib, "onesided alltoallv is not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    smem = uniform ? args->src.info.mem_type : args->src.info_v.mem_type;
+    dmem = uniform ? args->dst.info.mem_type : args->dst.info_v.mem_type;
+    if (smem != UCC_MEMORY_TYPE_HOST || dmem != UCC_MEMORY_TYPE_HOST) {
+        cl_debug(team->context->lib,
+                 "node aggregated alltoallv supports host memory only");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (!SBGP_EXISTS(cl_team, NODE_LEADERS)) {
+        cl_debug(team->context->lib,
+                 "node aggregated alltoallv requires NODE_LEADERS sbgp");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_topo_get_node_leaders(topo, &node_leaders, NULL);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    is_leader = (node_leaders[rank] == rank);
+    if (is_leader && !SBGP_ENABLED(cl_team, NODE_LEADERS)) {
+        cl_debug(team->context->lib, "NODE_LEADERS sbgp is not enabled");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    nnodes = SBGP_SIZE(cl_team, NODE_LEADERS);
+    nsize  = SBGP_ENABLED(cl_team, NODE) ? SBGP_SIZE(cl_team, NODE) : 1;
+    block  = 0;
+    if (uniform) {
+        block       = (args->src.info.count / tsize) *
+                      ucc_dt_size(args->src.info.datatype);
+        send_remote = recv_remote = block * (tsize - nsize);
+    } else {
+        sdt_size    = ucc_dt_size(args->src.info_v.datatype);
+        rdt_size    = ucc_dt_size(args->dst.info_v.datatype);
+        send_remote = recv_remote = 0;
+        for (i = 0; i < tsize; i++) {
+            if (ucc_rank_on_local_node(i, topo)) {
+                continue;
+            }
+            send_remote += ucc_coll_args_get_count(
+                               args, args->src.info_v.counts, i) * sdt_size;
+            recv_remote += ucc_coll_args_get_count(
+                               args, args->dst.info_v.counts, i) * rdt_size;
+        }
+    }
+
+    ranks_size = ucc_align_up((2 * tsize + nnodes + 1 + nsize) *
+                              sizeof(ucc_rank_t), sizeof(uint64_t));
+    size       = sizeof(*m) + ranks_size +
+                 (5 * tsize + 8 * nsize) * sizeof(uint64_t) +
+                 send_remote + recv_remote;
+    if (is_leader) {
+        size += (6 * nnodes + ucc_max(nnodes, nsize)) * sizeof(uint64_t);
+        if (!uniform) {
+            /* gathered headers, then the received ones in the same storage,
+               and the headers sent to the peer leaders */
+            size += (size_t)nsize * (2 * tsize - nsize) * sizeof(uint64_t);
+        }
+    }
+
+    cl_schedule = ucc_cl_hier_get_schedule(cl_team);
+    if (ucc_unlikely(!cl_schedule)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    schedule = &cl_schedule->super.super;
+    UCC_CHECK_GOTO(ucc_schedule_init(schedule, coll_args, team), err, status);
+    status = ucc_mc_alloc(&cl_schedule->scratch, size, UCC_MEMORY_TYPE_HOST);
+    if (ucc_unlikely(UCC_OK != status)) {
+        cl_error(team->context->lib, "failed to allocate %zd bytes for scratch",
+                 size);
+        goto err;
+    }
+
+    m              = cl_schedule->scratch->addr;
+    m->n_nodes     = nnodes;
+    m->node_size   = nsize;
+    m->is_leader   = is_leader;
+    m->uniform     = uniform;
+    m->block       = block;
+    m->send_remote = send_remote;
+    m->recv_remote = recv_remote;
+    m->src         = uniform ? args->src.info.buffer
+                             : args->src.info_v.buffer;
+    m->dst         = uniform ? args->dst.info.buffer
+                             : args->dst.info_v.buffer;
+    p              = PTR_OFFSET(m, sizeof(*m));
+    m->order       = p;
+    m->nstart      = m->order + tsize;
+    m->lidx        = m->nstart + nnodes + 1;
+    p              = PTR_OFFSET(p, ranks_size);
+    m->sc          = p;
+    m->sd          = m->sc + tsize;
+    m->rc          = m->sd + tsize;
+    m->rd          = m->rc + tsize;
+    m->hdr         = m->rd + tsize;
+    m->ncounts     = m->hdr + tsize;
+    p              = m->ncounts + 8 * nsize;
+    m->node_hdr    = NULL;
+    m->hdr_send    = NULL;
+    m->hdr_recv    = NULL;
+    m->lcounts     = NULL;
+    m->cursor      = NULL;
+    if (is_leader) {
+        m->lcounts = p;
+        m->cursor  = m->lcounts + 6 * nnodes;
+        p          = m->cursor + ucc_max(nnodes, nsize);
+        if (!uniform) {
+            m->node_hdr = p;
+            m->hdr_recv = m->node_hdr;
+            m->hdr_send = m->node_hdr + (size_t)nsize * tsize;
+            p           = m->hdr_send + (size_t)nsize * (tsize - nsize);
+        }
+    }
+    m->pack = p;
+    m->recv = PTR_OFFSET(p, send_remote);
+
+    status = ucc_cl_hier_a2av_aggr_meta_init(cl_team, args, m);
+    if (ucc_unlikely(UCC_OK != status)) {
+        goto err_free;
+    }
+
+    memset(&A2AV_AGGR(cl_schedule), 0, sizeof(A2AV_AGGR(cl_schedule)));
+    status = ucc_cl_hier_a2av_aggr_init_tasks(cl_schedule);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_cl_hier_a2av_aggr_free(cl_schedule);
+        goto err_free;
+    }
+    schedule->super.post     = ucc_cl_hier_alltoallv_node_aggr_start;
+    schedule->super.progress = ucc_cl_hier_alltoallv_node_aggr_progress;
+    schedule->super.finalize = ucc_cl_hier_alltoallv_node_aggr_finalize;
+    *task                    = &schedule->super;
+    return UCC_OK;
+
+err_free:
+    ucc_mc_free(cl_schedule->scratch);
+err:
+    ucc_cl_hier_put_schedule(schedule);
+    return status;
+}
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -7,7 +7,7 @@
 #include "barrier.h"
 #include "../cl_hier_coll.h"
 
-#define MAX_BARRIER_TASKS 3
+#define MAX_BARRIER_TASKS (2 * UCC_CL_HIER_MAX_LEVELS - 1)
 
 static ucc_status_t ucc_cl_hier_barrier_start(ucc_coll_task_t *task)
 {
@@ -37,7 +37,8 @@ UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_barrier_init,
     ucc_schedule_t      *schedule;
     ucc_status_t         status;
     ucc_base_coll_args_t args;
-    int                  n_tasks, i;
+    ucc_hier_sbgp_type_t levels[UCC_CL_HIER_MAX_LEVELS];
+    int                  n_tasks, n_levels, i, l;
 
     schedule = &ucc_cl_hier_get_schedule(cl_team)->super.super;
     if (ucc_unlikely(!schedule)) {
@@ -49,35 +50,28 @@ UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_barrier_init,
     n_tasks        = 0;
     UCC_CHECK_GOTO(ucc_schedule_init(schedule, &args, team), out, status);
 
-    if (SBGP_ENABLED(cl_team, NODE)) {
-        ucc_assert(n_tasks == 0);
-        if (cl_team->top_sbgp == UCC_HIER_SBGP_NODE) {
+    /* fanin up to the top level, barrier there, fanout back */
+    n_levels = ucc_cl_hier_get_levels(cl_team, levels);
+    for (l = 0; l < n_levels; l++) {
+        if (ucc_cl_hier_is_top_level(cl_team, levels[l])) {
             args.args.coll_type = UCC_COLL_TYPE_BARRIER;
         } else {
             args.args.coll_type = UCC_COLL_TYPE_FANIN;
         }
-        UCC_CHECK_GOTO(
-            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
-            out, status);
-        n_tasks++;
-    }
-
-    if (SBGP_ENABLED(cl_team, NODE_LEADERS)) {
-        ucc_assert(cl_team->top_sbgp == UCC_HIER_SBGP_NODE_LEADERS);
-        args.args.coll_type = UCC_COLL_TYPE_BARRIER;
-        UCC_CHECK_GOTO(ucc_coll_init(SCORE_MAP(cl_team, NODE_LEADERS), &args,
-                                     &tasks[n_tasks]),
+        UCC_CHECK_GOTO(ucc_coll_init(cl_team->sbgps[levels[l]].score_map,
+                                     &args, &tasks[n_tasks]),
                        out, status);
         n_tasks++;
     }
 
-
-    if (SBGP_ENABLED(cl_team, NODE) &&
-        cl_team->top_sbgp != UCC_HIER_SBGP_NODE) {
+    for (l = n_levels - 1; l >= 0; l--) {
+        if (ucc_cl_hier_is_top_level(cl_team, levels[l])) {
+            continue;
+        }
         args.args.coll_type = UCC_COLL_TYPE_FANOUT;
-        UCC_CHECK_GOTO(
-            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
-            out, status);
+        UCC_CHECK_GOTO(ucc_coll_init(cl_team->sbgps[levels[l]].score_map,
+                                     &args, &tasks[n_tasks]),
+                       out, status);
         n_tasks++;
     }
 
@@ -1,11 +1,10 @@
 /**
- * Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
 
 #include "bcast.h"
-#include "core/ucc_team.h"
 #include "../cl_hier_coll.h"
 
 static ucc_status_t ucc_cl_hier_bcast_2step_start(ucc_coll_task_t *task)
@@ -63,54 +62,21 @@ ucc_cl_hier_bcast_2step_frag_setup(ucc_schedule_pipelined_t *schedule_p,
     return UCC_OK;
 }
 
-static inline ucc_rank_t
-find_root_net_rank(ucc_host_id_t root_host_id, ucc_cl_hier_team_t *cl_team)
-{
-    ucc_sbgp_t *sbgp      = cl_team->sbgps[UCC_HIER_SBGP_NODE_LEADERS].sbgp;
-    ucc_team_t *core_team = cl_team->super.super.params.team;
-    ucc_rank_t  i, rank;
-
-    for (i = 0; i < sbgp->group_size; i++) {
-        rank = ucc_ep_map_eval(sbgp->map, i);
-        if (ucc_team_rank_host_id(rank, core_team) == root_host_id) {
-            return i;
-        }
-    }
-    return UCC_RANK_INVALID;
-}
-
-static inline ucc_rank_t
-find_root_node_rank(ucc_rank_t root, ucc_cl_hier_team_t *cl_team)
-{
-    ucc_sbgp_t *sbgp       = cl_team->sbgps[UCC_HIER_SBGP_NODE].sbgp;
-    ucc_rank_t  i;
-
-    for (i = 0; i < sbgp->group_size; i++) {
-        if (ucc_ep_map_eval(sbgp->map, i) == root) {
-            return i;
-        }
-    }
-    return UCC_RANK_INVALID;
-}
-
 static ucc_status_t
 ucc_cl_hier_bcast_2step_init_schedule(ucc_base_coll_args_t *coll_args,
                                       ucc_base_team_t      *team,
                                       ucc_schedule_t **sched_p, int n_frags)
 {
-    ucc_cl_hier_team_t *cl_team   = ucc_derived_of(team, ucc_cl_hier_team_t);
-    ucc_team_t         *core_team = team->params.team;
-    ucc_coll_task_t    *tasks[2]  = {NULL, NULL};
-    ucc_rank_t root               = coll_args->args.root;
-    ucc_rank_t rank               = UCC_TL_TEAM_RANK(cl_team);
-    int root_on_local_node        = ucc_team_ranks_on_same_node(root, rank,
-                                                                core_team);
-    ucc_base_coll_args_t args       = *coll_args;
-    int                  n_tasks    = 0;
-    int                  first_task = 0;
+    ucc_cl_hier_team_t  *cl_team   = ucc_derived_of(team, ucc_cl_hier_team_t);
+    ucc_coll_task_t     *tasks[UCC_CL_HIER_MAX_LEVELS] = {NULL};
+    ucc_rank_t           root      = coll_args->args.root;
+    ucc_base_coll_args_t args      = *coll_args;
+    int                  n_tasks   = 0;
+    int                  recv_task = -1;
+    ucc_hier_sbgp_type_t levels[UCC_CL_HIER_MAX_LEVELS];
     ucc_schedule_t      *schedule;
     ucc_status_t         status;
-    int                  i;
+    int                  n_levels, i;
 
     schedule = &ucc_cl_hier_get_schedule(cl_team)->super.super;
     if (ucc_unlikely(!schedule)) {
@@ -127,54 +93,36 @@ ucc_cl_hier_bcast_2step_init_schedule(ucc_base_coll_args_t *coll_args,
         args.mask |= UCC_BASE_CARGS_MAX_FRAG_COUNT;
     }
 
-    ucc_assert(SBGP_ENABLED(cl_team, NODE_LEADERS) ||
-               SBGP_ENABLED(cl_team, NODE));
-    if (SBGP_ENABLED(cl_team, NODE_LEADERS)) {
-        args.args.root = find_root_net_rank(
-            ucc_team_rank_host_id(root, core_team), cl_team);
-        status = ucc_coll_init(SCORE_MAP(cl_team, NODE_LEADERS), &args,
+    n_levels = ucc_cl_hier_get_levels(cl_team, levels);
+    ucc_assert(n_levels > 0);
+    for (i = n_levels - 1; i >= 0; i--) {
+        args.args.root = ucc_cl_hier_sbgp_root(cl_team, levels[i], root);
+        status = ucc_coll_init(cl_team->sbgps[levels[i]].score_map, &args,
                                &tasks[n_tasks]);
         if (ucc_unlikely(UCC_OK != status)) {
             goto out;
         }
-        n_tasks++;
-        if (root_on_local_node && (root != rank)) {
-            first_task = 1;
-        }
-    }
-
-    if (SBGP_ENABLED(cl_team, NODE)) {
-        args.args.root = root_on_local_node
-            ? find_root_node_rank(root, cl_team)
-            : core_team->topo->node_leader_rank_id;
-        status =
-            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]);
-        if (ucc_unlikely(UCC_OK != status)) {
-            goto out;
+        if (args.args.root != cl_team->sbgps[levels[i]].sbgp->group_rank) {
+            /* the data come to the process over a single level */
+            ucc_assert(recv_task == -1);
+            recv_task = n_tasks;
         }
         n_tasks++;
     }
 
-    UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super, tasks[first_task],
-                                          UCC_EVENT_SCHEDULE_STARTED),
-                   out, status);
-    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[first_task]),
-                   out, status);
-    if (n_tasks > 1) {
-        if (root == rank) {
-            UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super,
-                                                  tasks[(first_task + 1) % 2],
-                                                  UCC_EVENT_SCHEDULE_STARTED),
-                           out, status);
+    /* the levels where the process is root forward the received data */
+    for (i = 0; i < n_tasks; i++) {
+        if (recv_task == -1 || recv_task == i) {
+            status = ucc_task_subscribe_dep(&schedule->super, tasks[i],
+                                            UCC_EVENT_SCHEDULE_STARTED);
         } else {
-            UCC_CHECK_GOTO(ucc_task_subscribe_dep(tasks[first_task],
-                                                  tasks[(first_task + 1) % 2],
-                                                  UCC_EVENT_COMPLETED),
-                            out, status);
+            status = ucc_task_subscribe_dep(tasks[recv_task], tasks[i],
+                                            UCC_EVENT_COMPLETED);
+        }
+        if (ucc_unlikely(UCC_OK != status)) {
+            goto out;
         }
-        UCC_CHECK_GOTO(ucc_schedule_add_task(schedule,
-                                             tasks[(first_task + 1) % 2]),
-                       out, status);
+        UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[i]), out, status);
     }
 
     schedule->super.post           = ucc_cl_hier_bcast_2step_start;
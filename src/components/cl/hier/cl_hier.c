@@ -18,11 +18,19 @@ ucc_status_t ucc_cl_hier_get_lib_properties(ucc_base_lib_properties_t *prop);
 ucc_status_t ucc_cl_hier_get_context_attr(const ucc_base_context_t *context,
                                           ucc_base_ctx_attr_t      *base_attr);
 
+const char *ucc_cl_hier_node_split_names[] = {
+    [UCC_CL_HIER_NODE_SPLIT_AUTO]   = "auto",
+    [UCC_CL_HIER_NODE_SPLIT_SOCKET] = "socket",
+    [UCC_CL_HIER_NODE_SPLIT_NUMA]   = "numa",
+    [UCC_CL_HIER_NODE_SPLIT_NONE]   = "none",
+    [UCC_CL_HIER_NODE_SPLIT_LAST]   = NULL
+};
+
 static ucc_config_field_t ucc_cl_hier_lib_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_cl_hier_lib_config_t, super),
      UCC_CONFIG_TYPE_TABLE(ucc_cl_lib_config_table)},
 
-    {"NODE_SBGP_TLS", "ucp",
+    {"NODE_SBGP_TLS", "ucp,shm",
      "TLS to be used for NODE subgroup.\n"
      "NODE subgroup contains processes of a team located on the same node",
      ucc_offsetof(ucc_cl_hier_lib_config_t, sbgp_tls[UCC_HIER_SBGP_NODE]),
@@ -51,6 +59,68 @@ static ucc_config_field_t ucc_cl_hier_lib_config_table[] = {
      ucc_offsetof(ucc_cl_hier_lib_config_t, sbgp_tls[UCC_HIER_SBGP_FULL]),
      UCC_CONFIG_TYPE_ALLOW_LIST},
 
+    {"SOCKET_SBGP_TLS", "ucp,shm",
+     "TLS to be used for SOCKET subgroup.\n"
+     "SOCKET subgroup contains processes of a team located on the same socket",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, sbgp_tls[UCC_HIER_SBGP_SOCKET]),
+     UCC_CONFIG_TYPE_ALLOW_LIST},
+
+    {"SOCKET_LEADERS_SBGP_TLS", "ucp,shm",
+     "TLS to be used for SOCKET_LEADERS subgroup.\n"
+     "SOCKET_LEADERS subgroup contains processes of a node with local socket "
+     "rank equal 0",
+     ucc_offsetof(ucc_cl_hier_lib_config_t,
+                  sbgp_tls[UCC_HIER_SBGP_SOCKET_LEADERS]),
+     UCC_CONFIG_TYPE_ALLOW_LIST},
+
+    {"NUMA_SBGP_TLS", "ucp,shm",
+     "TLS to be used for NUMA subgroup.\n"
+     "NUMA subgroup contains processes of a team located on the same NUMA "
+     "domain",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, sbgp_tls[UCC_HIER_SBGP_NUMA]),
+     UCC_CONFIG_TYPE_ALLOW_LIST},
+
+    {"NUMA_LEADERS_SBGP_TLS", "ucp,shm",
+     "TLS to be used for NUMA_LEADERS subgroup.\n"
+     "NUMA_LEADERS subgroup contains processes of a node with local NUMA "
+     "rank equal 0",
+     ucc_offsetof(ucc_cl_hier_lib_config_t,
+                  sbgp_tls[UCC_HIER_SBGP_NUMA_LEADERS]),
+     UCC_CONFIG_TYPE_ALLOW_LIST},
+
+    {"RACK_SBGP_TLS", "ucp",
+     "TLS to be used for RACK subgroup.\n"
+     "RACK subgroup contains node leaders of a team located in the same rack "
+     "(see UCC_TOPO_FILE)",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, sbgp_tls[UCC_HIER_SBGP_RACK]),
+     UCC_CONFIG_TYPE_ALLOW_LIST},
+
+    {"RACK_LEADERS_SBGP_TLS", "ucp",
+     "TLS to be used for RACK_LEADERS subgroup.\n"
+     "RACK_LEADERS subgroup contains one node leader of every rack",
+     ucc_offsetof(ucc_cl_hier_lib_config_t,
+                  sbgp_tls[UCC_HIER_SBGP_RACK_LEADERS]),
+     UCC_CONFIG_TYPE_ALLOW_LIST},
+
+    {"RACK_LEVEL", "y",
+     "Replace the node leaders level of hierarchical algorithms with rack "
+     "and rack leaders levels, so that inter-rack traffic is aggregated. "
+     "Used only if racks are defined by UCC_TOPO_FILE and the team spans "
+     "several racks",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, rack_level),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"NODE_SPLIT", "auto",
+     "Split of the node level of hierarchical algorithms.\n"
+     "auto   - socket if processes are bound to sockets, numa if bound to "
+     "NUMA domains, none otherwise\n"
+     "socket - socket level runs below the node level\n"
+     "numa   - NUMA level runs below the node level\n"
+     "none   - node is a single level\n"
+     "The split is not used on the nodes with a single socket (NUMA domain)",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, node_split),
+     UCC_CONFIG_TYPE_ENUM(ucc_cl_hier_node_split_names)},
+
     {"ALLTOALLV_SPLIT_NODE_THRESH", "0",
      "Messages larger than that threshold will be sent via node sbgp tl",
      ucc_offsetof(ucc_cl_hier_lib_config_t, a2av_node_thresh),
@@ -76,6 +146,54 @@ static ucc_config_field_t ucc_cl_hier_lib_config_table[] = {
      ucc_offsetof(ucc_cl_hier_lib_config_t, reduce_2step_pipeline),
      UCC_CONFIG_TYPE_PIPELINE_PARAMS},
 
+    {"ALLGATHER_THRESH", "inf",
+     "Messages larger than that threshold use hierarchical allgather "
+     "algorithm, inf disables it. The algorithm can be selected with "
+     "UCC_CL_HIER_TUNE",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, allgather_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLGATHER_GAB_PIPELINE", "auto",
+     "Pipelining settings for GAB allgather algorithm",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, allgather_gab_pipeline),
+     UCC_CONFIG_TYPE_PIPELINE_PARAMS},
+
+    {"REDUCE_SCATTER_THRESH", "inf",
+     "Messages larger than that threshold use hierarchical reduce_scatter "
+     "algorithm, inf disables it. The algorithm can be selected with "
+     "UCC_CL_HIER_TUNE",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, reduce_scatter_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"REDUCE_SCATTER_RRS_PIPELINE", "auto",
+     "Pipelining settings for RRS reduce_scatter algorithm",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, reduce_scatter_rrs_pipeline),
+     UCC_CONFIG_TYPE_PIPELINE_PARAMS},
+
+    {"GATHER_THRESH", "inf",
+     "Messages larger than that threshold use hierarchical gather "
+     "algorithm, inf disables it. The algorithm can be selected with "
+     "UCC_CL_HIER_TUNE",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, gather_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"GATHER_2STEP_PIPELINE", "auto",
+     "Pipelining settings for 2step gather algorithm",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, gather_2step_pipeline),
+     UCC_CONFIG_TYPE_PIPELINE_PARAMS},
+
+    {"SCATTER_THRESH", "inf",
+     "Messages larger than that threshold use hierarchical scatter "
+     "algorithm, inf disables it. The algorithm can be selected with "
+     "UCC_CL_HIER_TUNE",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, scatter_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"SCATTER_2STEP_PIPELINE", "auto",
+     "Pipelining settings for 2step scatter algorithm",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, scatter_2step_pipeline),
+     UCC_CONFIG_TYPE_PIPELINE_PARAMS},
+
     {NULL}};
 
 static ucs_config_field_t ucc_cl_hier_context_config_table[] = {
@@ -119,4 +237,12 @@ __attribute__((constructor)) static void cl_hier_iface_init(void)
         ucc_cl_hier_bcast_algs;
     ucc_cl_hier.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_ALLGATHERV)] =
         ucc_cl_hier_allgatherv_algs;
+    ucc_cl_hier.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_ALLGATHER)] =
+        ucc_cl_hier_allgather_algs;
+    ucc_cl_hier.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_REDUCE_SCATTER)] =
+        ucc_cl_hier_reduce_scatter_algs;
+    ucc_cl_hier.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_GATHER)] =
+        ucc_cl_hier_gather_algs;
+    ucc_cl_hier.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_SCATTER)] =
+        ucc_cl_hier_scatter_algs;
 }
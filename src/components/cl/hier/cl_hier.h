@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * Copyright (c) Meta Platforms, Inc. and affiliates. 2022.
  *
  * See file LICENSE for terms.
@@ -40,20 +40,46 @@ typedef enum {
     UCC_HIER_SBGP_NODE_LEADERS,
     UCC_HIER_SBGP_NET,
     UCC_HIER_SBGP_FULL,
+    UCC_HIER_SBGP_SOCKET,
+    UCC_HIER_SBGP_SOCKET_LEADERS,
+    UCC_HIER_SBGP_NUMA,
+    UCC_HIER_SBGP_NUMA_LEADERS,
+    UCC_HIER_SBGP_RACK,
+    UCC_HIER_SBGP_RACK_LEADERS,
     UCC_HIER_SBGP_LAST,
 } ucc_hier_sbgp_type_t;
 //DO we need it? Potential use case: different hier sbgps over same sbgp
 
+typedef enum {
+    UCC_CL_HIER_NODE_SPLIT_AUTO,
+    UCC_CL_HIER_NODE_SPLIT_SOCKET,
+    UCC_CL_HIER_NODE_SPLIT_NUMA,
+    UCC_CL_HIER_NODE_SPLIT_NONE,
+    UCC_CL_HIER_NODE_SPLIT_LAST
+} ucc_cl_hier_node_split_t;
+
+extern const char *ucc_cl_hier_node_split_names[];
+
 typedef struct ucc_cl_hier_lib_config {
     ucc_cl_lib_config_t super;
     /* List of TLs corresponding to the sbgp team,
        which are selected based on the TL scores */
-    ucc_config_names_list_t sbgp_tls[UCC_HIER_SBGP_LAST];
-    size_t                  a2av_node_thresh;
-    ucc_pipeline_params_t   allreduce_split_rail_pipeline;
-    ucc_pipeline_params_t   allreduce_rab_pipeline;
-    ucc_pipeline_params_t   bcast_2step_pipeline;
-    ucc_pipeline_params_t   reduce_2step_pipeline;
+    ucc_config_names_list_t  sbgp_tls[UCC_HIER_SBGP_LAST];
+    ucc_cl_hier_node_split_t node_split;
+    int                      rack_level;
+    size_t                   a2av_node_thresh;
+    ucc_pipeline_params_t    allreduce_split_rail_pipeline;
+    ucc_pipeline_params_t    allreduce_rab_pipeline;
+    ucc_pipeline_params_t    bcast_2step_pipeline;
+    ucc_pipeline_params_t    reduce_2step_pipeline;
+    size_t                   allgather_thresh;
+    size_t                   reduce_scatter_thresh;
+    size_t                   gather_thresh;
+    size_t                   scatter_thresh;
+    ucc_pipeline_params_t    allgather_gab_pipeline;
+    ucc_pipeline_params_t    reduce_scatter_rrs_pipeline;
+    ucc_pipeline_params_t    gather_2step_pipeline;
+    ucc_pipeline_params_t    scatter_2step_pipeline;
 } ucc_cl_hier_lib_config_t;
 
 typedef struct ucc_cl_hier_context_config {
@@ -106,6 +132,12 @@ typedef struct ucc_cl_hier_team {
     ucc_coll_score_t        *score;
     ucc_hier_sbgp_t          sbgps[UCC_HIER_SBGP_LAST];
     ucc_hier_sbgp_type_t     top_sbgp;
+    /* SOCKET or NUMA sbgp splitting the node and the sbgp of their leaders,
+       UCC_HIER_SBGP_LAST if the node of the calling process is not split */
+    ucc_hier_sbgp_type_t     sn_sbgp;
+    ucc_hier_sbgp_type_t     sn_leaders_sbgp;
+    /* 1 if RACK and RACK_LEADERS levels replace NODE_LEADERS level */
+    int                      is_rack_split;
     int                      is_block_ordered;
     int                      is_host_ordered;
 } ucc_cl_hier_team_t;
@@ -115,11 +147,15 @@ UCC_CLASS_DECLARE(ucc_cl_hier_team_t, ucc_base_context_t *,
 #define UCC_CL_HIER_SUPPORTED_COLLS                                            \
     (UCC_COLL_TYPE_ALLTOALL |                                                  \
      UCC_COLL_TYPE_ALLTOALLV |                                                 \
+     UCC_COLL_TYPE_ALLGATHER |                                                 \
      UCC_COLL_TYPE_ALLGATHERV |                                                 \
      UCC_COLL_TYPE_ALLREDUCE |                                                 \
      UCC_COLL_TYPE_BARRIER |                                                   \
      UCC_COLL_TYPE_BCAST |                                                     \
-     UCC_COLL_TYPE_REDUCE)
+     UCC_COLL_TYPE_GATHER |                                                    \
+     UCC_COLL_TYPE_REDUCE |                                                    \
+     UCC_COLL_TYPE_REDUCE_SCATTER |                                            \
+     UCC_COLL_TYPE_SCATTER)
 
 ucc_status_t ucc_cl_hier_coll_init(ucc_base_coll_args_t *coll_args,
                                    ucc_base_team_t      *team,
@@ -150,4 +186,64 @@ ucc_status_t ucc_cl_hier_coll_init(ucc_base_coll_args_t *coll_args,
 
 #define SCORE_MAP(_team, _sbgp) (_team)->sbgps[UCC_HIER_SBGP_##_sbgp].score_map
 
+#define UCC_CL_HIER_MAX_LEVELS 4
+
+/* Fills the levels of the hierarchy the calling process is part of starting
+   from the lowest one: SOCKET (NUMA) and SOCKET_LEADERS (NUMA_LEADERS) if the
+   node is split, NODE otherwise, then RACK and RACK_LEADERS if the team spans
+   several racks, NODE_LEADERS otherwise. Returns number of levels */
+int ucc_cl_hier_get_levels(ucc_cl_hier_team_t   *team,
+                           ucc_hier_sbgp_type_t *levels);
+
+/* Returns the rank within the hier sbgp of the member whose part of the
+   hierarchy contains team rank "root", the leader (rank 0) if there is
+   no such member */
+ucc_rank_t ucc_cl_hier_sbgp_root(ucc_cl_hier_team_t  *team,
+                                 ucc_hier_sbgp_type_t type, ucc_rank_t root);
+
+/* Checks if the ranks of every node are contiguous in the team and ordered
+   the same way as in FULL_HOST_ORDERED sbgp */
+ucc_status_t ucc_cl_hier_is_block_ordered(ucc_cl_hier_team_t *cl_team,
+                                          int                *ordered);
+
+/* Checks if the team ranks of NODE_LEADERS sbgp are ascending */
+ucc_status_t ucc_cl_hier_is_host_ordered(ucc_cl_hier_team_t *cl_team,
+                                         int                *ordered);
+
+/* Number of elements of the interval [offset, offset + count) of a rank
+   ordered buffer holding "block" elements per rank, that belong to the
+   ranks [start, end) */
+static inline size_t ucc_cl_hier_frag_part(size_t block, ucc_rank_t start,
+                                           ucc_rank_t end, size_t offset,
+                                           size_t count)
+{
+    size_t lo = ucc_max(block * start, offset);
+    size_t hi = ucc_min(block * end, offset + count);
+
+    return (hi > lo) ? hi - lo : 0;
+}
+
+/* Fills the counts of the parts of the interval [offset, offset + count) of
+   a rank ordered buffer holding "block" elements per rank, that belong to
+   the members of NODE or NODE_LEADERS sbgp, and the displacements of the
+   parts starting from "disp" (if displs is not NULL). The team must be block
+   and host ordered. Returns the total count of the parts */
+size_t ucc_cl_hier_frag_counts(ucc_cl_hier_team_t  *team,
+                               ucc_hier_sbgp_type_t type, size_t block,
+                               size_t offset, size_t count, size_t disp,
+                               uint64_t *counts, uint64_t *displs);
+
+/* Returns 1 if the level is the last one of the hierarchy */
+static inline int ucc_cl_hier_is_top_level(ucc_cl_hier_team_t  *team,
+                                           ucc_hier_sbgp_type_t level)
+{
+    if (team->top_sbgp == UCC_HIER_SBGP_NODE_LEADERS) {
+        return level == (team->is_rack_split ? UCC_HIER_SBGP_RACK_LEADERS
+                                             : UCC_HIER_SBGP_NODE_LEADERS);
+    }
+    return level == ((team->sn_leaders_sbgp != UCC_HIER_SBGP_LAST)
+                         ? team->sn_leaders_sbgp
+                         : UCC_HIER_SBGP_NODE);
+}
+
 #endif
@@ -34,6 +34,14 @@ ucc_status_t ucc_cl_hier_coll_init(ucc_base_coll_args_t *coll_args,
         return ucc_cl_hier_bcast_2step_init(coll_args, team, task);
     case UCC_COLL_TYPE_REDUCE:
         return ucc_cl_hier_reduce_2step_init(coll_args, team, task);
+    case UCC_COLL_TYPE_ALLGATHER:
+        return ucc_cl_hier_allgather_gab_init(coll_args, team, task);
+    case UCC_COLL_TYPE_REDUCE_SCATTER:
+        return ucc_cl_hier_reduce_scatter_rrs_init(coll_args, team, task);
+    case UCC_COLL_TYPE_GATHER:
+        return ucc_cl_hier_gather_2step_init(coll_args, team, task);
+    case UCC_COLL_TYPE_SCATTER:
+        return ucc_cl_hier_scatter_2step_init(coll_args, team, task);
     default:
         cl_error(team->context->lib, "coll_type %s is not supported",
                  ucc_coll_type_str(coll_args->args.coll_type));
@@ -57,6 +65,14 @@ static inline int alg_id_from_str(ucc_coll_type_t coll_type, const char *str)
         return ucc_cl_hier_reduce_alg_from_str(str);
     case UCC_COLL_TYPE_ALLGATHERV:
         return ucc_cl_hier_allgatherv_alg_from_str(str);
+    case UCC_COLL_TYPE_ALLGATHER:
+        return ucc_cl_hier_allgather_alg_from_str(str);
+    case UCC_COLL_TYPE_REDUCE_SCATTER:
+        return ucc_cl_hier_reduce_scatter_alg_from_str(str);
+    case UCC_COLL_TYPE_GATHER:
+        return ucc_cl_hier_gather_alg_from_str(str);
+    case UCC_COLL_TYPE_SCATTER:
+        return ucc_cl_hier_scatter_alg_from_str(str);
     default:
         break;
     }
@@ -92,6 +108,9 @@ ucc_status_t ucc_cl_hier_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_CL_HIER_ALLTOALLV_ALG_NODE_SPLIT:
             *init = ucc_cl_hier_alltoallv_init;
             break;
+        case UCC_CL_HIER_ALLTOALLV_ALG_NODE_AGGR:
+            *init = ucc_cl_hier_alltoallv_node_aggr_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -102,6 +121,9 @@ ucc_status_t ucc_cl_hier_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_CL_HIER_ALLTOALL_ALG_NODE_SPLIT:
             *init = ucc_cl_hier_alltoall_init;
             break;
+        case UCC_CL_HIER_ALLTOALL_ALG_NODE_AGGR:
+            *init = ucc_cl_hier_alltoall_node_aggr_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -137,6 +159,46 @@ ucc_status_t ucc_cl_hier_alg_id_to_init(int alg_id, const char *alg_id_str,
             break;
         }
         break;
+    case UCC_COLL_TYPE_ALLGATHER:
+        switch(alg_id) {
+        case UCC_CL_HIER_ALLGATHER_ALG_GAB:
+            *init = ucc_cl_hier_allgather_gab_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        }
+        break;
+    case UCC_COLL_TYPE_REDUCE_SCATTER:
+        switch(alg_id) {
+        case UCC_CL_HIER_REDUCE_SCATTER_ALG_RRS:
+            *init = ucc_cl_hier_reduce_scatter_rrs_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        }
+        break;
+    case UCC_COLL_TYPE_GATHER:
+        switch(alg_id) {
+        case UCC_CL_HIER_GATHER_ALG_2STEP:
+            *init = ucc_cl_hier_gather_2step_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        }
+        break;
+    case UCC_COLL_TYPE_SCATTER:
+        switch(alg_id) {
+        case UCC_CL_HIER_SCATTER_ALG_2STEP:
+            *init = ucc_cl_hier_scatter_2step_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        }
+        break;
     default:
         status = UCC_ERR_NOT_SUPPORTED;
         break;
@@ -16,9 +16,16 @@
 #include "bcast/bcast.h"
 #include "reduce/reduce.h"
 #include "allgatherv/allgatherv.h"
+#include "allgather/allgather.h"
+#include "reduce_scatter/reduce_scatter.h"
+#include "gather/gather.h"
+#include "scatter/scatter.h"
 
 #define UCC_CL_HIER_N_DEFAULT_ALG_SELECT_STR 4
 
+/* max number of steps of a fragment of the two level schedules */
+#define UCC_CL_HIER_MAX_STEPS 3
+
 extern const char
     *ucc_cl_hier_default_alg_select_str[UCC_CL_HIER_N_DEFAULT_ALG_SELECT_STR];
 
@@ -29,6 +36,24 @@ typedef struct ucc_cl_hier_schedule_t {
         struct {
             uint64_t *counts;
         } allreduce_split_rail;
+        struct {
+            int                     phase;
+            /* sub-tasks initialized once, NULL for the steps the calling
+               process does not take part in */
+            ucc_coll_task_t        *tasks[6];
+            /* leader staging buffers, kept and grown across posts */
+            ucc_mc_buffer_header_t *gbuf;
+            ucc_mc_buffer_header_t *rbuf;
+            size_t                  gbuf_size;
+            size_t                  rbuf_size;
+        } alltoallv_node_aggr;
+        struct {
+            /* sub-tasks of the steps, NULL for the steps the calling
+               process does not take part in */
+            ucc_coll_task_t *tasks[UCC_CL_HIER_MAX_STEPS];
+            /* staging buffer of the fragment data */
+            void            *buf;
+        } frag;
     };
 } ucc_cl_hier_schedule_t;
 
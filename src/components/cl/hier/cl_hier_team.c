@@ -15,6 +15,7 @@
     _team->sbgps[UCC_HIER_SBGP_##_sbgp].state     = UCC_HIER_SBGP_##_enable;
 
 #define N_MT 3
+#define N_HIER_RANGES 4
 
 /* The function below must enable/disable those hier sbgps that will be
  * used to construct hierarchical schedules.
@@ -22,12 +23,39 @@
  * Next step is to enable sbgps based on the requested hierarchical algs.
  */
 
-static void ucc_cl_hier_enable_sbgps(ucc_cl_hier_team_t *team)
+static void ucc_cl_hier_enable_sbgps(ucc_cl_hier_team_t *team,
+                                     ucc_cl_hier_lib_t  *lib,
+                                     ucc_topo_t         *topo)
 {
+    ucc_cl_hier_node_split_t split = lib->cfg.node_split;
+
     SBGP_SET(team, NET, ENABLED);
     SBGP_SET(team, NODE, ENABLED);
     SBGP_SET(team, NODE_LEADERS, ENABLED);
     SBGP_SET(team, FULL, ENABLED); /* TODO: parse score if a2av is enabled */
+
+    /* RACK sbgps do not exist if racks are not defined by topology file */
+    if (lib->cfg.rack_level) {
+        SBGP_SET(team, RACK, ENABLED);
+        SBGP_SET(team, RACK_LEADERS, ENABLED);
+    }
+
+    if (split == UCC_CL_HIER_NODE_SPLIT_AUTO) {
+        if (topo->topo->sock_bound) {
+            split = UCC_CL_HIER_NODE_SPLIT_SOCKET;
+        } else if (topo->topo->numa_bound) {
+            split = UCC_CL_HIER_NODE_SPLIT_NUMA;
+        }
+    }
+    /* SOCKET/NUMA sbgps do not exist if processes are not bound, in that
+       case they are disabled below and the node is not split */
+    if (split == UCC_CL_HIER_NODE_SPLIT_SOCKET) {
+        SBGP_SET(team, SOCKET, ENABLED);
+        SBGP_SET(team, SOCKET_LEADERS, ENABLED);
+    } else if (split == UCC_CL_HIER_NODE_SPLIT_NUMA) {
+        SBGP_SET(team, NUMA, ENABLED);
+        SBGP_SET(team, NUMA_LEADERS, ENABLED);
+    }
 }
 
 UCC_CLASS_INIT_FUNC(ucc_cl_hier_team_t, ucc_base_context_t *cl_context,
@@ -60,7 +88,7 @@ UCC_CLASS_INIT_FUNC(ucc_cl_hier_team_t, ucc_base_context_t *cl_context,
 
     UCC_CLASS_CALL_SUPER_INIT(ucc_cl_team_t, &ctx->super, params);
     memset(self->sbgps, 0, sizeof(self->sbgps));
-    ucc_cl_hier_enable_sbgps(self);
+    ucc_cl_hier_enable_sbgps(self, lib, params->team->topo);
     n_sbgp_teams = 0;
     for (i = 0; i < UCC_HIER_SBGP_LAST; i++) {
         hs = &self->sbgps[i];
@@ -336,6 +364,20 @@ ucc_status_t ucc_cl_hier_team_create_test(ucc_base_team_t *cl_team)
     ucc_team_multiple_req_free(team->team_create_req);
     team->team_create_req = NULL;
 
+    /* node is split if there are at least 2 sockets (NUMA domains) on it */
+    team->sn_sbgp         = UCC_HIER_SBGP_LAST;
+    team->sn_leaders_sbgp = UCC_HIER_SBGP_LAST;
+    if (SBGP_EXISTS(team, SOCKET_LEADERS)) {
+        team->sn_sbgp         = UCC_HIER_SBGP_SOCKET;
+        team->sn_leaders_sbgp = UCC_HIER_SBGP_SOCKET_LEADERS;
+    } else if (SBGP_EXISTS(team, NUMA_LEADERS)) {
+        team->sn_sbgp         = UCC_HIER_SBGP_NUMA;
+        team->sn_leaders_sbgp = UCC_HIER_SBGP_NUMA_LEADERS;
+    }
+
+    /* team spans at least 2 racks */
+    team->is_rack_split = SBGP_EXISTS(team, RACK_LEADERS);
+
     if (SBGP_EXISTS(team, NODE_LEADERS)) {
         team->top_sbgp = UCC_HIER_SBGP_NODE_LEADERS;
     } else {
@@ -346,18 +388,238 @@ ucc_status_t ucc_cl_hier_team_create_test(ucc_base_team_t *cl_team)
     return status;
 }
 
+int ucc_cl_hier_get_levels(ucc_cl_hier_team_t   *team,
+                           ucc_hier_sbgp_type_t *levels)
+{
+    int n_levels = 0;
+
+    if (team->sn_sbgp != UCC_HIER_SBGP_LAST) {
+        if (team->sbgps[team->sn_sbgp].state == UCC_HIER_SBGP_ENABLED) {
+            levels[n_levels++] = team->sn_sbgp;
+        }
+        if (team->sbgps[team->sn_leaders_sbgp].state ==
+            UCC_HIER_SBGP_ENABLED) {
+            levels[n_levels++] = team->sn_leaders_sbgp;
+        }
+    } else if (SBGP_ENABLED(team, NODE)) {
+        levels[n_levels++] = UCC_HIER_SBGP_NODE;
+    }
+    if (team->is_rack_split) {
+        if (SBGP_ENABLED(team, RACK)) {
+            levels[n_levels++] = UCC_HIER_SBGP_RACK;
+        }
+        if (SBGP_ENABLED(team, RACK_LEADERS)) {
+            levels[n_levels++] = UCC_HIER_SBGP_RACK_LEADERS;
+        }
+    } else if (SBGP_ENABLED(team, NODE_LEADERS)) {
+        levels[n_levels++] = UCC_HIER_SBGP_NODE_LEADERS;
+    }
+    ucc_assert(n_levels <= UCC_CL_HIER_MAX_LEVELS);
+    return n_levels;
+}
+
+static inline int ucc_cl_hier_ranks_on_same_sn(ucc_topo_t *topo,
+                                               ucc_sbgp_type_t type,
+                                               ucc_rank_t r1, ucc_rank_t r2)
+{
+    ucc_proc_info_t *p1 = &topo->topo->procs[ucc_ep_map_eval(topo->set.map,
+                                                             r1)];
+    ucc_proc_info_t *p2 = &topo->topo->procs[ucc_ep_map_eval(topo->set.map,
+                                                             r2)];
+
+    if (p1->host_hash != p2->host_hash) {
+        return 0;
+    }
+    if (type == UCC_SBGP_SOCKET || type == UCC_SBGP_SOCKET_LEADERS) {
+        return p1->socket_id == p2->socket_id;
+    }
+    return p1->numa_id == p2->numa_id;
+}
+
+ucc_rank_t ucc_cl_hier_sbgp_root(ucc_cl_hier_team_t  *team,
+                                 ucc_hier_sbgp_type_t type, ucc_rank_t root)
+{
+    ucc_team_t *core_team = team->super.super.params.team;
+    ucc_topo_t *topo      = core_team->topo;
+    ucc_sbgp_t *sbgp      = team->sbgps[type].sbgp;
+    ucc_rank_t  rank      = UCC_CL_TEAM_RANK(team);
+    ucc_rank_t  i, r;
+
+    switch (type) {
+    case UCC_HIER_SBGP_NODE_LEADERS:
+        for (i = 0; i < sbgp->group_size; i++) {
+            r = ucc_ep_map_eval(sbgp->map, i);
+            if (ucc_team_rank_host_id(r, core_team) ==
+                ucc_team_rank_host_id(root, core_team)) {
+                return i;
+            }
+        }
+        return UCC_RANK_INVALID;
+    case UCC_HIER_SBGP_SOCKET_LEADERS:
+    case UCC_HIER_SBGP_NUMA_LEADERS:
+        /* leader of the socket (NUMA domain) of root */
+        for (i = 0; i < sbgp->group_size; i++) {
+            r = ucc_ep_map_eval(sbgp->map, i);
+            if (ucc_cl_hier_ranks_on_same_sn(topo, sbgp->type, r, root)) {
+                return i;
+            }
+        }
+        return 0;
+    case UCC_HIER_SBGP_RACK_LEADERS:
+        /* leader of the rack of root */
+        for (i = 0; i < sbgp->group_size; i++) {
+            r = ucc_ep_map_eval(sbgp->map, i);
+            if (ucc_topo_rack_id(topo, r) == ucc_topo_rack_id(topo, root)) {
+                return i;
+            }
+        }
+        return 0;
+    case UCC_HIER_SBGP_RACK:
+        /* node leader of root if root is in the rack */
+        if (ucc_topo_rack_id(topo, rank) != ucc_topo_rack_id(topo, root)) {
+            return 0;
+        }
+        for (i = 0; i < sbgp->group_size; i++) {
+            r = ucc_ep_map_eval(sbgp->map, i);
+            if (ucc_team_ranks_on_same_node(r, root, core_team)) {
+                return i;
+            }
+        }
+        return UCC_RANK_INVALID;
+    case UCC_HIER_SBGP_SOCKET:
+    case UCC_HIER_SBGP_NUMA:
+        if (!ucc_cl_hier_ranks_on_same_sn(topo, sbgp->type, rank, root)) {
+            return 0;
+        }
+        break;
+    default:
+        if (!ucc_team_ranks_on_same_node(rank, root, core_team)) {
+            return 0;
+        }
+        break;
+    }
+    for (i = 0; i < sbgp->group_size; i++) {
+        if (ucc_ep_map_eval(sbgp->map, i) == root) {
+            return i;
+        }
+    }
+    return UCC_RANK_INVALID;
+}
+
+/* Check if the ranks are block ordered. If they aren't, we'll need to 
+   unpack the data after the allgatherv into the right position, even if the
+   dst buffer is contiguous */
+ucc_status_t ucc_cl_hier_is_block_ordered(ucc_cl_hier_team_t *cl_team,
+                                          int                *ordered)
+{
+    ucc_topo_t *topo = cl_team->super.super.params.team->topo;
+    ucc_sbgp_t *sbgp;
+    int         is_block_ordered;
+
+    if (cl_team->is_block_ordered != -1) {
+        is_block_ordered = cl_team->is_block_ordered;
+    } else {
+        sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_FULL_HOST_ORDERED);
+        is_block_ordered = ucc_ep_map_is_identity(&sbgp->map) ? 1 : 0;
+        cl_team->is_block_ordered = is_block_ordered;
+    }
+
+    *ordered = is_block_ordered;
+
+    return UCC_OK;
+}
+
+/* Node leader subgroup is always ordered by ascending host_id. If the team's ranks are
+   not in the same order, then node leader subgroup allgatherv won't be enough, we'll
+   have to use a staging buffer and unpack to reorder each leader's contribution.
+   So, this func will check that the team ranks in the ldr sbgp are ascending */
+ucc_status_t ucc_cl_hier_is_host_ordered(ucc_cl_hier_team_t *cl_team,
+                                         int                *ordered)
+{
+    int         is_host_ordered;
+    ucc_rank_t  max_rank, i, team_rank;
+
+    if (cl_team->is_host_ordered != -1) {
+        is_host_ordered = cl_team->is_host_ordered;
+    } else {
+        if (SBGP_EXISTS(cl_team, NODE_LEADERS)) {
+            is_host_ordered = 1;
+            max_rank = ucc_ep_map_eval(SBGP_MAP(cl_team, NODE_LEADERS), 0);
+            for (i = 1; i < SBGP_SIZE(cl_team, NODE_LEADERS); i++) {
+                team_rank = ucc_ep_map_eval(SBGP_MAP(cl_team, NODE_LEADERS), i);
+                if (team_rank < max_rank) {
+                    is_host_ordered = 0;
+                    break;
+                }
+                max_rank = team_rank;
+            }
+        } else {
+            is_host_ordered = 1;
+        }
+        cl_team->is_host_ordered = is_host_ordered;
+    }
+
+    *ordered = is_host_ordered;
+
+    return UCC_OK;
+}
+
+size_t ucc_cl_hier_frag_counts(ucc_cl_hier_team_t  *team,
+                               ucc_hier_sbgp_type_t type, size_t block,
+                               size_t offset, size_t count, size_t disp,
+                               uint64_t *counts, uint64_t *displs)
+{
+    ucc_sbgp_t *sbgp  = team->sbgps[type].sbgp;
+    size_t      total = 0;
+    ucc_rank_t  i, start, end;
+
+    ucc_assert(type == UCC_HIER_SBGP_NODE ||
+               type == UCC_HIER_SBGP_NODE_LEADERS);
+    for (i = 0; i < sbgp->group_size; i++) {
+        start = ucc_ep_map_eval(sbgp->map, i);
+        if (type == UCC_HIER_SBGP_NODE) {
+            end = start + 1;
+        } else {
+            /* node of the leader ends where the next node starts */
+            end = (i + 1 < sbgp->group_size) ?
+                  ucc_ep_map_eval(sbgp->map, i + 1) : UCC_CL_TEAM_SIZE(team);
+        }
+        counts[i] = ucc_cl_hier_frag_part(block, start, end, offset, count);
+        if (displs) {
+            displs[i] = disp + total;
+        }
+        total += counts[i];
+    }
+    return total;
+}
+
 ucc_status_t ucc_cl_hier_team_get_scores(ucc_base_team_t   *cl_team,
                                          ucc_coll_score_t **score_p)
 {
     ucc_cl_hier_team_t *team     = ucc_derived_of(cl_team, ucc_cl_hier_team_t);
     ucc_base_lib_t     *lib      = UCC_CL_TEAM_LIB(team);
     ucc_base_context_t *ctx      = UCC_CL_TEAM_CTX(team);
+    ucc_cl_hier_lib_config_t *cfg = &UCC_CL_HIER_TEAM_LIB(team)->cfg;
     ucc_memory_type_t   mt[N_MT] = {UCC_MEMORY_TYPE_HOST, UCC_MEMORY_TYPE_CUDA,
                                     UCC_MEMORY_TYPE_CUDA_MANAGED};
     ucc_coll_score_t   *score;
     ucc_status_t        status;
     int                 i;
     ucc_coll_score_team_info_t team_info;
+    /* two level algorithms used for large messages */
+    struct {
+        ucc_coll_type_t         coll_type;
+        size_t                  thresh;
+        ucc_base_coll_init_fn_t init;
+    } hier_ranges[N_HIER_RANGES] = {
+        {UCC_COLL_TYPE_ALLGATHER, cfg->allgather_thresh,
+         ucc_cl_hier_allgather_gab_init},
+        {UCC_COLL_TYPE_REDUCE_SCATTER, cfg->reduce_scatter_thresh,
+         ucc_cl_hier_reduce_scatter_rrs_init},
+        {UCC_COLL_TYPE_GATHER, cfg->gather_thresh,
+         ucc_cl_hier_gather_2step_init},
+        {UCC_COLL_TYPE_SCATTER, cfg->scatter_thresh,
+         ucc_cl_hier_scatter_2step_init}};
 
     team_info.alg_fn              = ucc_cl_hier_alg_id_to_init;
     team_info.default_score       = UCC_CL_HIER_DEFAULT_SCORE;
@@ -403,6 +665,20 @@ ucc_status_t ucc_cl_hier_team_get_scores(ucc_base_team_t   *cl_team,
 
     }
 
+    for (i = 0; i < N_HIER_RANGES; i++) {
+        if (hier_ranges[i].thresh >= UCC_MSG_MAX) {
+            continue;
+        }
+        status = ucc_coll_score_add_range(
+            score, hier_ranges[i].coll_type, UCC_MEMORY_TYPE_HOST,
+            hier_ranges[i].thresh, UCC_MSG_MAX, UCC_CL_HIER_DEFAULT_SCORE,
+            hier_ranges[i].init, cl_team);
+        if (UCC_OK != status) {
+            cl_error(lib, "failed to add range to score_t");
+            goto err;
+        }
+    }
+
     for (i = 0; i < UCC_CL_HIER_N_DEFAULT_ALG_SELECT_STR; i++) {
         status = ucc_coll_score_update_from_str(
             ucc_cl_hier_default_alg_select_str[i], &team_info,
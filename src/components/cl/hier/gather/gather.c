@@ -0,0 +1,481 @@
+/**
+ * Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "gather.h"
+#include "../cl_hier_coll.h"
+#include "core/ucc_team.h"
+
+/* Two step gather: the rank ordered gather vector is split into fragments.
+   For every fragment node leaders gather the parts owned by the ranks of
+   their nodes and then gatherv them to the leader of the root node. If the
+   root is not a node leader the fragment is forwarded to it within its node.
+   Requires the blocks of every node to be contiguous in the gather vector,
+   i.e. block and host ordered team. */
+
+enum {
+    UCC_CL_HIER_GATHER_2STEP_GATHER,
+    UCC_CL_HIER_GATHER_2STEP_EXCHANGE,
+    UCC_CL_HIER_GATHER_2STEP_FORWARD
+};
+
+ucc_base_coll_alg_info_t
+    ucc_cl_hier_gather_algs[UCC_CL_HIER_GATHER_ALG_LAST + 1] = {
+        [UCC_CL_HIER_GATHER_ALG_2STEP] =
+            {.id   = UCC_CL_HIER_GATHER_ALG_2STEP,
+             .name = "2step",
+             .desc = "intra node gatherv + node leaders gatherv"},
+        [UCC_CL_HIER_GATHER_ALG_LAST] = {
+            .id = 0, .name = NULL, .desc = NULL}};
+
+static inline size_t ucc_cl_hier_gather_block(ucc_cl_hier_team_t *team,
+                                              ucc_coll_args_t    *args)
+{
+    if (UCC_IS_ROOT(*args, UCC_CL_TEAM_RANK(team)) && UCC_IS_INPLACE(*args)) {
+        return args->dst.info.count / UCC_CL_TEAM_SIZE(team);
+    }
+    return args->src.info.count;
+}
+
+static inline ucc_datatype_t ucc_cl_hier_gather_dt(ucc_cl_hier_team_t *team,
+                                                   ucc_coll_args_t    *args)
+{
+    return UCC_IS_ROOT(*args, UCC_CL_TEAM_RANK(team))
+               ? args->dst.info.datatype
+               : args->src.info.datatype;
+}
+
+/* Location of the element "rel" of the fragment starting at "offset": user
+   dst at root, staging buffer at other node leaders */
+static inline void *ucc_cl_hier_gather_frag_ptr(ucc_cl_hier_team_t *team,
+                                                ucc_coll_args_t *args,
+                                                void *buf, size_t offset,
+                                                size_t rel, size_t dt_size)
+{
+    if (UCC_IS_ROOT(*args, UCC_CL_TEAM_RANK(team))) {
+        return PTR_OFFSET(args->dst.info.buffer, (offset + rel) * dt_size);
+    }
+    return PTR_OFFSET(buf, rel * dt_size);
+}
+
+static ucc_status_t ucc_cl_hier_gather_2step_start(ucc_coll_task_t *task)
+{
+    UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_gather_2step_start", 0);
+    return ucc_schedule_start(task);
+}
+
+static ucc_status_t ucc_cl_hier_gather_2step_finalize(ucc_coll_task_t *task)
+{
+    ucc_cl_hier_schedule_t *schedule =
+        ucc_derived_of(task, ucc_cl_hier_schedule_t);
+    ucc_status_t            status;
+
+    UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_gather_2step_finalize",
+                                      0);
+    ucc_mc_free(schedule->scratch);
+    status = ucc_schedule_finalize(task);
+    ucc_cl_hier_put_schedule(&schedule->super.super);
+    return status;
+}
+
+/* Sets buffers and counts of the step for the fragment
+   [offset, offset + count) of the gather vector */
+static void ucc_cl_hier_gather_2step_step_args(ucc_cl_hier_team_t *cl_team,
+                                               ucc_coll_args_t    *args,
+                                               void *buf, int step,
+                                               size_t offset, size_t count,
+                                               ucc_coll_args_t *sargs)
+{
+    ucc_rank_t rank    = UCC_CL_TEAM_RANK(cl_team);
+    size_t     dt_size = ucc_dt_size(ucc_cl_hier_gather_dt(cl_team, args));
+    size_t     block   = ucc_cl_hier_gather_block(cl_team, args);
+    size_t     pos, part, node_pos;
+    ucc_rank_t i;
+
+    node_pos = ucc_cl_hier_frag_part(
+        block, 0, ucc_ep_map_eval(SBGP_MAP(cl_team, NODE), 0), offset, count);
+    switch (step) {
+    case UCC_CL_HIER_GATHER_2STEP_GATHER:
+        pos  = ucc_cl_hier_frag_part(block, 0, rank, offset, count);
+        part = ucc_cl_hier_frag_part(block, rank, rank + 1, offset, count);
+        if (UCC_IS_ROOT(*args, rank) && UCC_IS_INPLACE(*args)) {
+            sargs->src.info.buffer =
+                PTR_OFFSET(args->dst.info.buffer, (offset + pos) * dt_size);
+        } else {
+            sargs->src.info.buffer =
+                PTR_OFFSET(args->src.info.buffer,
+                           part ? (offset + pos - rank * block) * dt_size : 0);
+        }
+        sargs->src.info.count    = part;
+        sargs->dst.info_v.buffer = ucc_cl_hier_gather_frag_ptr(
+            cl_team, args, buf, offset, node_pos, dt_size);
+        ucc_cl_hier_frag_counts(cl_team, UCC_HIER_SBGP_NODE, block, offset,
+                                count, 0, sargs->dst.info_v.counts,
+                                sargs->dst.info_v.displacements);
+        break;
+    case UCC_CL_HIER_GATHER_2STEP_EXCHANGE:
+        ucc_cl_hier_frag_counts(cl_team, UCC_HIER_SBGP_NODE_LEADERS, block,
+                                offset, count, 0, sargs->dst.info_v.counts,
+                                sargs->dst.info_v.displacements);
+        sargs->dst.info_v.buffer = ucc_cl_hier_gather_frag_ptr(
+            cl_team, args, buf, offset, 0, dt_size);
+        sargs->src.info.buffer   = ucc_cl_hier_gather_frag_ptr(
+            cl_team, args, buf, offset, node_pos, dt_size);
+        sargs->src.info.count    = ((uint64_t *)sargs->dst.info_v.counts)[
+            SBGP_RANK(cl_team, NODE_LEADERS)];
+        break;
+    case UCC_CL_HIER_GATHER_2STEP_FORWARD:
+        /* only node leader contributes: the whole fragment */
+        for (i = 0; i < SBGP_SIZE(cl_team, NODE); i++) {
+            ((uint64_t *)sargs->dst.info_v.counts)[i]        = 0;
+            ((uint64_t *)sargs->dst.info_v.displacements)[i] = 0;
+        }
+        ((uint64_t *)sargs->dst.info_v.counts)[0] = count;
+        if (UCC_IS_ROOT(*args, rank)) {
+            sargs->dst.info_v.buffer =
+                PTR_OFFSET(args->dst.info.buffer, offset * dt_size);
+            sargs->src.info.count    = 0;
+        } else if (SBGP_RANK(cl_team, NODE) == 0) {
+            sargs->src.info.buffer = buf;
+            sargs->src.info.count  = count;
+        } else {
+            sargs->src.info.count = 0;
+        }
+        break;
+    }
+}
+
+static ucc_status_t ucc_cl_hier_gather_2step_frag_setup(
+    ucc_schedule_pipelined_t *schedule_p, ucc_schedule_t *frag, int frag_num)
+{
+    ucc_coll_args_t        *args    = &schedule_p->super.super.bargs.args;
+    ucc_cl_hier_team_t     *cl_team = ucc_derived_of(
+        schedule_p->super.super.team, ucc_cl_hier_team_t);
+    ucc_cl_hier_schedule_t *cl_frag = ucc_derived_of(frag,
+                                                     ucc_cl_hier_schedule_t);
+    int                     n_frags = schedule_p->super.n_tasks;
+    size_t                  total, frag_count, frag_offset;
+    int                     s;
+
+    total = ucc_cl_hier_gather_block(cl_team, args) *
+            UCC_CL_TEAM_SIZE(cl_team);
+    frag_count  = ucc_buffer_block_count(total, n_frags, frag_num);
+    frag_offset = ucc_buffer_block_offset(total, n_frags, frag_num);
+
+    for (s = 0; s < UCC_CL_HIER_MAX_STEPS; s++) {
+        if (cl_frag->frag.tasks[s]) {
+            ucc_cl_hier_gather_2step_step_args(
+                cl_team, args, cl_frag->frag.buf, s, frag_offset, frag_count,
+                &cl_frag->frag.tasks[s]->bargs.args);
+        }
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_cl_hier_gather_2step_init_schedule(ucc_base_coll_args_t *coll_args,
+                                       ucc_base_team_t      *team,
+                                       ucc_schedule_t **sched_p, int n_frags)
+{
+    ucc_cl_hier_team_t     *cl_team   = ucc_derived_of(team,
+                                                       ucc_cl_hier_team_t);
+    ucc_coll_args_t        *uargs     = &coll_args->args;
+    ucc_rank_t              rank      = UCC_CL_TEAM_RANK(cl_team);
+    ucc_datatype_t          dt        = ucc_cl_hier_gather_dt(cl_team, uargs);
+    ucc_rank_t              node_size = SBGP_SIZE(cl_team, NODE);
+    int                     is_root   = UCC_IS_ROOT(*uargs, rank);
+    int                     is_leader = SBGP_ENABLED(cl_team, NODE_LEADERS);
+    ucc_coll_task_t        *tasks[UCC_CL_HIER_MAX_STEPS] = {NULL};
+    ucc_rank_t              n_leaders = 0;
+    ucc_cl_hier_schedule_t *cl_schedule;
+    ucc_schedule_t         *schedule;
+    ucc_base_coll_args_t    base, args;
+    ucc_status_t            status;
+    uint64_t               *arrays;
+    size_t                  frag_count, arrays_size, buf_size;
+    ucc_rank_t              node_root;
+    int                     n_tasks, i;
+
+    cl_schedule = ucc_cl_hier_get_schedule(cl_team);
+    if (ucc_unlikely(!cl_schedule)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    schedule = &cl_schedule->super.super;
+    memset(&cl_schedule->frag, 0, sizeof(cl_schedule->frag));
+    n_tasks = 0;
+    UCC_CHECK_GOTO(ucc_schedule_init(schedule, coll_args, team), out, status);
+
+    if (is_leader) {
+        n_leaders = SBGP_SIZE(cl_team, NODE_LEADERS);
+    }
+    frag_count = ucc_buffer_block_count(ucc_cl_hier_gather_block(cl_team,
+                                                                 uargs) *
+                                        UCC_CL_TEAM_SIZE(cl_team),
+                                        n_frags, 0);
+    node_root  = ucc_cl_hier_sbgp_root(cl_team, UCC_HIER_SBGP_NODE,
+                                       uargs->root);
+    /* counts and displacements of node, node leaders and forward steps and
+       the staging buffer of the fragment at non root node leaders */
+    arrays_size = (4 * node_size + 2 * n_leaders) * sizeof(uint64_t);
+    buf_size    = (is_leader && !is_root) ? frag_count * ucc_dt_size(dt) : 0;
+    UCC_CHECK_GOTO(ucc_mc_alloc(&cl_schedule->scratch, arrays_size + buf_size,
+                                UCC_MEMORY_TYPE_HOST),
+                   out, status);
+    arrays = cl_schedule->scratch->addr;
+    if (buf_size) {
+        cl_schedule->frag.buf = PTR_OFFSET(arrays, arrays_size);
+    }
+
+    base = *coll_args;
+    if (n_frags > 1) {
+        base.max_frag_count = frag_count;
+        base.mask          |= UCC_BASE_CARGS_MAX_FRAG_COUNT;
+    }
+    if (!(base.args.mask & UCC_COLL_ARGS_FIELD_FLAGS)) {
+        base.args.flags = 0;
+    }
+    base.args.mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+    base.args.flags &= ~UCC_COLL_ARGS_FLAG_IN_PLACE;
+    base.args.flags |= UCC_COLL_ARGS_FLAG_COUNT_64BIT |
+                       UCC_COLL_ARGS_FLAG_DISPLACEMENTS_64BIT;
+    base.args.coll_type = UCC_COLL_TYPE_GATHERV;
+
+    args                               = base;
+    args.args.root                     = 0;
+    args.args.src.info.datatype        = dt;
+    args.args.src.info.mem_type        = UCC_MEMORY_TYPE_HOST;
+    args.args.dst.info_v.counts        = arrays;
+    args.args.dst.info_v.displacements = arrays + node_size;
+    args.args.dst.info_v.datatype      = dt;
+    args.args.dst.info_v.mem_type      = UCC_MEMORY_TYPE_HOST;
+    if (is_root && is_leader && UCC_IS_INPLACE(*uargs)) {
+        args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+    }
+    ucc_cl_hier_gather_2step_step_args(cl_team, uargs, cl_schedule->frag.buf,
+                                       UCC_CL_HIER_GATHER_2STEP_GATHER, 0,
+                                       frag_count, &args.args);
+    UCC_CHECK_GOTO(
+        ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
+        out, status);
+    cl_schedule->frag.tasks[UCC_CL_HIER_GATHER_2STEP_GATHER] = tasks[n_tasks];
+    n_tasks++;
+
+    if (is_leader) {
+        args           = base;
+        args.args.root = ucc_cl_hier_sbgp_root(
+            cl_team, UCC_HIER_SBGP_NODE_LEADERS, uargs->root);
+        args.args.src.info.datatype        = dt;
+        args.args.src.info.mem_type        = UCC_MEMORY_TYPE_HOST;
+        args.args.dst.info_v.counts        = arrays + 2 * node_size;
+        args.args.dst.info_v.displacements = arrays + 2 * node_size +
+                                             n_leaders;
+        args.args.dst.info_v.datatype      = dt;
+        args.args.dst.info_v.mem_type      = UCC_MEMORY_TYPE_HOST;
+        if (args.args.root == SBGP_RANK(cl_team, NODE_LEADERS)) {
+            /* node data is already at its place */
+            args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+        }
+        ucc_cl_hier_gather_2step_step_args(
+            cl_team, uargs, cl_schedule->frag.buf,
+            UCC_CL_HIER_GATHER_2STEP_EXCHANGE, 0, frag_count, &args.args);
+        UCC_CHECK_GOTO(ucc_coll_init(SCORE_MAP(cl_team, NODE_LEADERS), &args,
+                                     &tasks[n_tasks]),
+                       out, status);
+        cl_schedule->frag.tasks[UCC_CL_HIER_GATHER_2STEP_EXCHANGE] =
+            tasks[n_tasks];
+        n_tasks++;
+    }
+
+    if (node_root != 0 &&
+        ucc_team_ranks_on_same_node(rank, uargs->root,
+                                    cl_team->super.super.params.team)) {
+        /* root is not a node leader: forward fragment to it */
+        args                               = base;
+        args.args.root                     = node_root;
+        args.args.src.info.buffer          = uargs->src.info.buffer;
+        args.args.src.info.datatype        = dt;
+        args.args.src.info.mem_type        = UCC_MEMORY_TYPE_HOST;
+        args.args.dst.info_v.counts        = arrays + 2 * node_size +
+                                             2 * n_leaders;
+        args.args.dst.info_v.displacements = arrays + 3 * node_size +
+                                             2 * n_leaders;
+        args.args.dst.info_v.datatype      = dt;
+        args.args.dst.info_v.mem_type      = UCC_MEMORY_TYPE_HOST;
+        if (is_root) {
+            args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+        }
+        ucc_cl_hier_gather_2step_step_args(
+            cl_team, uargs, cl_schedule->frag.buf,
+            UCC_CL_HIER_GATHER_2STEP_FORWARD, 0, frag_count, &args.args);
+        UCC_CHECK_GOTO(
+            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]),
+            out, status);
+        cl_schedule->frag.tasks[UCC_CL_HIER_GATHER_2STEP_FORWARD] =
+            tasks[n_tasks];
+        n_tasks++;
+    }
+
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[0]), out, status);
+    if (n_frags > 1) {
+        UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super, tasks[0],
+                                              UCC_EVENT_SCHEDULE_STARTED),
+                       out, status);
+        for (i = 1; i < n_tasks; i++) {
+            UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[i]), out,
+                           status);
+            UCC_CHECK_GOTO(ucc_task_subscribe_dep(tasks[i - 1], tasks[i],
+                                                  UCC_EVENT_COMPLETED),
+                           out, status);
+        }
+    } else {
+        UCC_CHECK_GOTO(ucc_event_manager_subscribe(
+                           &schedule->super, UCC_EVENT_SCHEDULE_STARTED,
+                           tasks[0], ucc_task_start_handler),
+                       out, status);
+        for (i = 1; i < n_tasks; i++) {
+            UCC_CHECK_GOTO(
+                ucc_event_manager_subscribe(tasks[i - 1], UCC_EVENT_COMPLETED,
+                                            tasks[i], ucc_task_start_handler),
+                out, status);
+            UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[i]), out,
+                           status);
+        }
+    }
+
+    schedule->super.post     = ucc_cl_hier_gather_2step_start;
+    schedule->super.progress = NULL;
+    schedule->super.finalize = ucc_cl_hier_gather_2step_finalize;
+    *sched_p                 = schedule;
+    return UCC_OK;
+
+out:
+    for (i = 0; i < n_tasks; i++) {
+        tasks[i]->finalize(tasks[i]);
+    }
+    if (cl_schedule->scratch) {
+        ucc_mc_free(cl_schedule->scratch);
+    }
+    ucc_cl_hier_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_cl_hier_gather_2step_frag_init(
+    ucc_base_coll_args_t *coll_args, ucc_schedule_pipelined_t *sp,
+    ucc_base_team_t *team, ucc_schedule_t **frag_p)
+{
+    return ucc_cl_hier_gather_2step_init_schedule(coll_args, team, frag_p,
+                                                  sp->super.n_tasks);
+}
+
+static ucc_status_t
+ucc_cl_hier_gather_2step_pipelined_start(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+
+    cl_debug(task->team->context->lib,
+             "posting 2step gather, sbuf %p, rbuf %p, count %zd, root %u, "
+             "inplace %d, pdepth %d, frags_total %d",
+             task->bargs.args.src.info.buffer, task->bargs.args.dst.info.buffer,
+             task->bargs.args.src.info.count, task->bargs.args.root,
+             UCC_IS_INPLACE(task->bargs.args), schedule->n_frags,
+             schedule->super.n_tasks);
+
+    return ucc_schedule_pipelined_post(task);
+}
+
+static ucc_status_t
+ucc_cl_hier_gather_2step_pipelined_finalize(ucc_coll_task_t *task)
+{
+    ucc_cl_hier_schedule_t *schedule =
+        ucc_derived_of(task, ucc_cl_hier_schedule_t);
+    ucc_status_t status;
+
+    status = ucc_schedule_pipelined_finalize(&schedule->super.super.super);
+    ucc_cl_hier_put_schedule(&schedule->super.super);
+    return status;
+}
+
+UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_gather_2step_init,
+                         (coll_args, team, task),
+                         ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
+                         ucc_coll_task_t **task)
+{
+    ucc_cl_hier_team_t     *cl_team = ucc_derived_of(team, ucc_cl_hier_team_t);
+    ucc_cl_hier_lib_config_t *cfg   = &UCC_CL_HIER_TEAM_LIB(cl_team)->cfg;
+    ucc_pipeline_params_t     pp    = cfg->gather_2step_pipeline;
+    ucc_coll_args_t          *args  = &coll_args->args;
+    int                       root  = UCC_IS_ROOT(*args,
+                                                  UCC_CL_TEAM_RANK(cl_team));
+    ucc_cl_hier_schedule_t   *schedule;
+    int                       n_frags, pipeline_depth;
+    int                       model_slot, is_auto;
+    size_t                    msgsize;
+    int                       block_ordered, host_ordered;
+    ucc_status_t              status;
+
+    if ((root && args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST) ||
+        (!(root && UCC_IS_INPLACE(*args)) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    UCC_CHECK_GOTO(ucc_cl_hier_is_block_ordered(cl_team, &block_ordered),
+                   out, status);
+    UCC_CHECK_GOTO(ucc_cl_hier_is_host_ordered(cl_team, &host_ordered),
+                   out, status);
+    if (!block_ordered || !host_ordered ||
+        ucc_topo_min_ppn(team->params.team->topo) < 2) {
+        cl_debug(team->context->lib, "2step gather requires node ordered "
+                 "ranks and at least 2 ranks per node");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    msgsize = ucc_cl_hier_gather_block(cl_team, args) *
+              UCC_CL_TEAM_SIZE(cl_team) *
+              ucc_dt_size(ucc_cl_hier_gather_dt(cl_team, args));
+    is_auto = ucc_pipeline_params_is_auto(&pp);
+    if (is_auto) {
+        pp.threshold = 1024 * 1024;
+        pp.n_frags   = 2;
+        pp.frag_size = 1024 * 1024;
+        pp.pdepth    = 2;
+        pp.order     = UCC_PIPELINE_PARALLEL;
+    }
+    model_slot = ucc_pipeline_params_model(team, "hier_gather_2step",
+                                           UCC_MEMORY_TYPE_HOST, msgsize,
+                                           is_auto, &pp);
+    ucc_pipeline_nfrags_pdepth(&pp, msgsize, &n_frags, &pipeline_depth);
+
+    if (n_frags == 1) {
+        return ucc_cl_hier_gather_2step_init_schedule(
+            coll_args, team, (ucc_schedule_t **)task, n_frags);
+    }
+
+    schedule = ucc_cl_hier_get_schedule(cl_team);
+    if (ucc_unlikely(!schedule)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+
+    status = ucc_schedule_pipelined_init(
+        coll_args, team, ucc_cl_hier_gather_2step_frag_init,
+        ucc_cl_hier_gather_2step_frag_setup, pipeline_depth, n_frags,
+        pp.order, &schedule->super);
+    if (ucc_unlikely(status != UCC_OK)) {
+        cl_error(team->context->lib,
+                 "failed to init pipelined 2step gather schedule");
+        ucc_cl_hier_put_schedule(&schedule->super.super);
+        return status;
+    }
+
+    ucc_schedule_pipelined_set_model(&schedule->super, model_slot, msgsize);
+    schedule->super.super.super.post =
+        ucc_cl_hier_gather_2step_pipelined_start;
+    schedule->super.super.super.finalize =
+        ucc_cl_hier_gather_2step_pipelined_finalize;
+    *task = &schedule->super.super.super;
+    return UCC_OK;
+out:
+    return status;
+}
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -8,8 +8,6 @@
 #include "core/ucc_team.h"
 #include "../cl_hier_coll.h"
 
-#define MAX_AR_2STEP_TASKS 3
-
 static ucc_status_t ucc_cl_hier_reduce_2step_start(ucc_coll_task_t *task)
 {
     UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_reduce_2step_start", 0);
@@ -30,68 +28,33 @@ static ucc_status_t ucc_cl_hier_reduce_2step_finalize(ucc_coll_task_t *task)
     return status;
 }
 
-static inline ucc_rank_t
-find_root_net_rank(ucc_host_id_t root_host_id, ucc_cl_hier_team_t *cl_team)
-{
-    ucc_rank_t  net_rank  = UCC_RANK_INVALID;
-    ucc_sbgp_t *sbgp      = cl_team->sbgps[UCC_HIER_SBGP_NODE_LEADERS].sbgp;
-    ucc_team_t *core_team = cl_team->super.super.params.team;
-    ucc_rank_t  i, rank;
-
-    for (i = 0; i < sbgp->group_size; i++) {
-        rank = ucc_ep_map_eval(sbgp->map, i);
-        if (ucc_team_rank_host_id(rank, core_team) == root_host_id) {
-            net_rank = i;
-            break;
-        }
-    }
-    return net_rank;
-}
-
-static inline ucc_rank_t
-find_root_node_rank(ucc_rank_t root, ucc_cl_hier_team_t *cl_team)
-{
-    ucc_rank_t  node_rank  = UCC_RANK_INVALID;
-    ucc_sbgp_t *sbgp       = cl_team->sbgps[UCC_HIER_SBGP_NODE].sbgp;
-    ucc_rank_t  i;
-
-    for (i = 0; i < sbgp->group_size; i++) {
-        if (ucc_ep_map_eval(sbgp->map, i) == root) {
-            node_rank = i;
-            break;
-        }
-    }
-    return node_rank;
-}
-
 static ucc_status_t
 ucc_cl_hier_reduce_2step_init_schedule(ucc_base_coll_args_t *coll_args,
                                        ucc_base_team_t *team,
                                        ucc_schedule_t **sched_p, int n_frags)
 {
     ucc_cl_hier_team_t   *cl_team   = ucc_derived_of(team, ucc_cl_hier_team_t);
-    ucc_team_t           *core_team = team->params.team;
-    ucc_coll_task_t      *tasks[2]  = {NULL, NULL};
+    ucc_coll_task_t      *tasks[UCC_CL_HIER_MAX_LEVELS] = {NULL};
     ucc_rank_t            root      = coll_args->args.root;
-    ucc_rank_t            rank      = UCC_TL_TEAM_RANK(cl_team);
+    ucc_rank_t            rank      = UCC_CL_TEAM_RANK(cl_team);
     ucc_base_coll_args_t  args      = *coll_args;
     size_t                count     = (rank == root) ?
                                       args.args.dst.info.count :
                                       args.args.src.info.count;
+    ucc_hier_sbgp_type_t    levels[UCC_CL_HIER_MAX_LEVELS];
+    ucc_rank_t              roots[UCC_CL_HIER_MAX_LEVELS];
     ucc_cl_hier_schedule_t *cl_schedule;
     ucc_schedule_t         *schedule;
     ucc_status_t            status;
-    int                     n_tasks, i, first_task, root_on_local_node;
-
-    root_on_local_node = ucc_team_ranks_on_same_node(root, rank, core_team);
-    n_tasks            = 0;
-    first_task         = 0;
+    void                   *acc;
+    int                     n_tasks, n_levels, n_recv, send_level, i;
 
+    n_tasks = 0;
     if (root != rank) {
         args.args.dst.info.count    = args.args.src.info.count;
         args.args.dst.info.mem_type = args.args.src.info.mem_type;
         args.args.dst.info.datatype = args.args.src.info.datatype;
-        args.args.mask &= (~UCC_COLL_ARGS_FLAG_IN_PLACE);
+        args.args.flags &= (~UCC_COLL_ARGS_FLAG_IN_PLACE);
     }
 
     cl_schedule = ucc_cl_hier_get_schedule(cl_team);
@@ -110,46 +73,60 @@ ucc_cl_hier_reduce_2step_init_schedule(ucc_base_coll_args_t *coll_args,
         args.mask |= UCC_BASE_CARGS_MAX_FRAG_COUNT;
     }
 
-    ucc_assert(SBGP_ENABLED(cl_team, NODE_LEADERS) ||
-               SBGP_ENABLED(cl_team, NODE));
-    if (SBGP_ENABLED(cl_team, NODE)) {
-        args.args.root = root_on_local_node
-            ? find_root_node_rank(root, cl_team) : 0;
-
-        if ((root != rank) && SBGP_ENABLED(cl_team, NODE_LEADERS)) {
-            status = ucc_mc_alloc(&cl_schedule->scratch,
-                                  args.max_frag_count *
-                                  ucc_dt_size(args.args.src.info.datatype),
-                                  args.args.src.info.mem_type);
-            if (ucc_unlikely(UCC_OK != status)) {
-                goto out;
-            }
-            args.args.dst.info.buffer = cl_schedule->scratch->addr;
-            if (root_on_local_node) {
-                first_task = 1;
-                args.args.src.info.buffer = cl_schedule->scratch->addr;
-            }
+    /* The process accumulates the data of the levels where it is root and
+       sends the result over the only level where it is not */
+    n_levels   = ucc_cl_hier_get_levels(cl_team, levels);
+    n_recv     = 0;
+    send_level = -1;
+    ucc_assert(n_levels > 0);
+    for (i = 0; i < n_levels; i++) {
+        roots[i] = ucc_cl_hier_sbgp_root(cl_team, levels[i], root);
+        if (roots[i] == cl_team->sbgps[levels[i]].sbgp->group_rank) {
+            n_recv++;
+        } else {
+            ucc_assert(send_level == -1);
+            send_level = i;
         }
-        status = ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]);
+    }
+
+    acc = args.args.dst.info.buffer;
+    if ((root != rank) && (n_recv > 0)) {
+        status = ucc_mc_alloc(&cl_schedule->scratch,
+                              args.max_frag_count *
+                              ucc_dt_size(args.args.src.info.datatype),
+                              args.args.src.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            goto out;
+        }
+        acc = cl_schedule->scratch->addr;
+    }
+
+    for (i = 0; i < n_levels; i++) {
+        if (i == send_level) {
+            continue;
+        }
+        if (n_tasks > 0) {
+            args.args.src.info.buffer = acc;
+            args.args.mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+            args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+        }
+        args.args.root            = roots[i];
+        args.args.dst.info.buffer = acc;
+        status = ucc_coll_init(cl_team->sbgps[levels[i]].score_map, &args,
+                               &tasks[n_tasks]);
         if (ucc_unlikely(UCC_OK != status)) {
             goto out;
         }
         n_tasks++;
     }
 
-    if (SBGP_ENABLED(cl_team, NODE_LEADERS)) {
-        if (n_tasks == 1) {
-            if (root != rank) {
-                args.args.src.info.buffer = root_on_local_node ?
-                    coll_args->args.src.info.buffer : cl_schedule->scratch->addr;
-            } else {
-                args.args.mask |= UCC_COLL_ARGS_FIELD_FLAGS;
-                args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
-            }
+    if (send_level >= 0) {
+        if (n_tasks > 0) {
+            args.args.src.info.buffer = acc;
+            args.args.flags &= (~UCC_COLL_ARGS_FLAG_IN_PLACE);
         }
-        args.args.root = find_root_net_rank(ucc_team_rank_host_id(root, core_team),
-                                            cl_team);
-        status = ucc_coll_init(SCORE_MAP(cl_team, NODE_LEADERS),
+        args.args.root = roots[send_level];
+        status = ucc_coll_init(cl_team->sbgps[levels[send_level]].score_map,
                                &args, &tasks[n_tasks]);
         if (ucc_unlikely(UCC_OK != status)) {
             goto out;
@@ -157,14 +134,16 @@ ucc_cl_hier_reduce_2step_init_schedule(ucc_base_coll_args_t *coll_args,
         n_tasks++;
     }
 
-    ucc_task_subscribe_dep(&schedule->super, tasks[first_task],
-                           UCC_EVENT_SCHEDULE_STARTED);
-    ucc_schedule_add_task(schedule, tasks[first_task]);
-
-    if (n_tasks > 1) {
-        ucc_task_subscribe_dep(tasks[first_task],
-                               tasks[(first_task + 1) % 2], UCC_EVENT_COMPLETED);
-        ucc_schedule_add_task(schedule, tasks[(first_task + 1) % 2]);
+    UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super, tasks[0],
+                                          UCC_EVENT_SCHEDULE_STARTED),
+                   out, status);
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[0]), out, status);
+    for (i = 1; i < n_tasks; i++) {
+        UCC_CHECK_GOTO(ucc_task_subscribe_dep(tasks[i - 1], tasks[i],
+                                              UCC_EVENT_COMPLETED),
+                       out, status);
+        UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, tasks[i]), out,
+                       status);
     }
 
     schedule->super.post           = ucc_cl_hier_reduce_2step_start;
@@ -178,6 +157,9 @@ out:
     for (i = 0; i < n_tasks; i++) {
         tasks[i]->finalize(tasks[i]);
     }
+    if (cl_schedule->scratch) {
+        ucc_mc_free(cl_schedule->scratch);
+    }
     ucc_cl_hier_put_schedule(schedule);
     return status;
 }
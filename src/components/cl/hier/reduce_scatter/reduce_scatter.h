@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef REDUCE_SCATTER_H_
+#define REDUCE_SCATTER_H_
+#include "../cl_hier.h"
+
+enum
+{
+    UCC_CL_HIER_REDUCE_SCATTER_ALG_RRS,
+    UCC_CL_HIER_REDUCE_SCATTER_ALG_LAST,
+};
+
+extern ucc_base_coll_alg_info_t
+    ucc_cl_hier_reduce_scatter_algs[UCC_CL_HIER_REDUCE_SCATTER_ALG_LAST + 1];
+
+ucc_status_t
+ucc_cl_hier_reduce_scatter_rrs_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_base_team_t      *team,
+                                    ucc_coll_task_t     **task);
+
+static inline int ucc_cl_hier_reduce_scatter_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_CL_HIER_REDUCE_SCATTER_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_cl_hier_reduce_scatter_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
+
+#endif
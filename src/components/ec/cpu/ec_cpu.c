@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -7,19 +7,66 @@
 #include "ec_cpu.h"
 #include "utils/arch/cpu.h"
 #include "components/mc/ucc_mc.h"
+#include "core/ucc_dt.h"
 #include <limits.h>
 
+const char *ucc_ec_cpu_isa_names[] = {
+    [UCC_EC_CPU_ISA_AUTO]   = "auto",
+    [UCC_EC_CPU_ISA_SCALAR] = "scalar",
+    [UCC_EC_CPU_ISA_AVX2]   = "avx2",
+    [UCC_EC_CPU_ISA_AVX512] = "avx512",
+    [UCC_EC_CPU_ISA_NEON]   = "neon",
+    [UCC_EC_CPU_ISA_SVE]    = "sve",
+    [UCC_EC_CPU_ISA_LAST]   = NULL
+};
+
 static ucc_config_field_t ucc_ec_cpu_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_ec_cpu_config_t, super),
      UCC_CONFIG_TYPE_TABLE(ucc_ec_config_table)},
 
+    {"EXEC_NUM_WORKERS", "0",
+     "Number of worker threads used by cpu executor to run reduction and "
+     "copy tasks asynchronously. 0 - tasks are executed inline by the "
+     "posting thread",
+     ucc_offsetof(ucc_ec_cpu_config_t, exec_num_workers),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"EXEC_ASYNC_THRESH", "64K",
+     "Minimal task size to be offloaded to worker threads, smaller tasks "
+     "are executed inline",
+     ucc_offsetof(ucc_ec_cpu_config_t, exec_async_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"EXEC_CHUNK_SIZE", "256K",
+     "Amount of data processed by a worker thread at a time, larger tasks "
+     "are split across worker threads",
+     ucc_offsetof(ucc_ec_cpu_config_t, exec_chunk_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"EXEC_BIND_WORKERS", "1",
+     "Bind worker threads to the cores of process affinity mask except the "
+     "one of the initializing thread. If there is no such core, worker "
+     "threads are not started and tasks are executed inline",
+     ucc_offsetof(ucc_ec_cpu_config_t, exec_bind_workers),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"REDUCE_ISA", "auto",
+     "Instruction set used by reduction kernels.\n"
+     "auto   - best instruction set supported by the CPU\n"
+     "scalar - generic code, vectorization is up to compiler\n"
+     "avx2, avx512 - x86_64 SIMD kernels\n"
+     "neon, sve    - aarch64 SIMD kernels",
+     ucc_offsetof(ucc_ec_cpu_config_t, reduce_isa),
+     UCC_CONFIG_TYPE_ENUM(ucc_ec_cpu_isa_names)},
+
     {NULL}
 
 };
 
 static ucc_status_t ucc_ec_cpu_init(const ucc_ec_params_t *ec_params)
 {
-    ucc_status_t status;
+    ucc_ec_cpu_config_t *cfg = EC_CPU_CONFIG;
+    ucc_status_t         status;
 
     ucc_strncpy_safe(ucc_ec_cpu.super.config->log_component.name,
                      ucc_ec_cpu.super.super.name,
@@ -35,7 +82,7 @@ static ucc_status_t ucc_ec_cpu_init(const ucc_ec_params_t *ec_params)
     }
 
     status = ucc_mpool_init(&ucc_ec_cpu.executor_tasks, 0,
-                            sizeof(ucc_ee_executor_task_t),
+                            sizeof(ucc_ec_cpu_executor_task_t),
                             0, UCC_CACHE_LINE_SIZE, 16, UINT_MAX, NULL,
                             ec_params->thread_mode, "ec cpu executor tasks");
     if (status != UCC_OK) {
@@ -45,6 +92,24 @@ static ucc_status_t ucc_ec_cpu_init(const ucc_ec_params_t *ec_params)
         return status;
     }
 
+    ucc_ec_cpu.reduce_isa = ucc_ec_cpu_reduce_kernels_init(cfg->reduce_isa);
+    ucc_ec_cpu.workers.n_threads = 0;
+    if (cfg->exec_num_workers > 0) {
+        if (cfg->exec_chunk_size == 0) {
+            ec_warn(&ucc_ec_cpu.super, "chunk size must be non zero");
+            cfg->exec_chunk_size = 1;
+        }
+        status = ucc_ec_cpu_workers_init(&ucc_ec_cpu.workers,
+                                         cfg->exec_num_workers,
+                                         cfg->exec_bind_workers);
+        if (status != UCC_OK) {
+            ec_error(&ucc_ec_cpu.super, "failed to start ec cpu workers");
+            ucc_mpool_cleanup(&ucc_ec_cpu.executor_tasks, 1);
+            ucc_mpool_cleanup(&ucc_ec_cpu.executors, 1);
+            return status;
+        }
+    }
+
     return UCC_OK;
 }
 
@@ -59,6 +124,9 @@ static ucc_status_t ucc_ec_cpu_get_attr(ucc_ec_attr_t *ec_attr)
 
 static ucc_status_t ucc_ec_cpu_finalize()
 {
+    if (ucc_ec_cpu.workers.n_threads > 0) {
+        ucc_ec_cpu_workers_finalize(&ucc_ec_cpu.workers);
+    }
     ucc_mpool_cleanup(&ucc_ec_cpu.executors, 1);
     ucc_mpool_cleanup(&ucc_ec_cpu.executor_tasks, 1);
 
@@ -98,76 +166,89 @@ ucc_status_t ucc_cpu_executor_stop(ucc_ee_executor_t *executor) //NOLINT
     return UCC_OK;
 }
 
+/* Computes the task size in units used by ucc_ec_cpu_task_exec and the size
+   of one unit in bytes, unit size is 0 if the task can not be split */
+static size_t ucc_ec_cpu_task_units(const ucc_ee_executor_task_args_t *args,
+                                    size_t *unit_size)
+{
+    ucc_datatype_t dt;
+    size_t         i, n_bytes;
+
+    switch (args->task_type) {
+    case UCC_EE_EXECUTOR_TASK_REDUCE:
+    case UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED:
+        dt = (args->task_type == UCC_EE_EXECUTOR_TASK_REDUCE) ?
+             args->reduce.dt : args->reduce_strided.dt;
+        if (UCC_DT_IS_PREDEFINED(dt)) {
+            *unit_size = ucc_dt_size(dt);
+        }
+        return (args->task_type == UCC_EE_EXECUTOR_TASK_REDUCE) ?
+               args->reduce.count : args->reduce_strided.count;
+    case UCC_EE_EXECUTOR_TASK_COPY:
+        *unit_size = 1;
+        return args->copy.len;
+    case UCC_EE_EXECUTOR_TASK_COPY_MULTI:
+        n_bytes = 0;
+        for (i = 0; i < args->copy_multi.num_vectors; i++) {
+            n_bytes += args->copy_multi.counts[i];
+        }
+        /* copy multi is split by vectors, use average vector size as unit */
+        *unit_size = args->copy_multi.num_vectors ?
+                     n_bytes / args->copy_multi.num_vectors : 0;
+        return args->copy_multi.num_vectors;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
 ucc_status_t ucc_cpu_executor_task_post(ucc_ee_executor_t *executor,
                                         const ucc_ee_executor_task_args_t *task_args,
                                         ucc_ee_executor_task_t **task)
 {
-    ucc_status_t            status = UCC_OK;
-    ucc_ee_executor_task_t *eee_task;
+    ucc_ec_cpu_config_t        *cfg       = EC_CPU_CONFIG;
+    size_t                      unit_size = 0;
+    ucc_ec_cpu_executor_task_t *eee_task;
+    ucc_status_t                status;
+    size_t                      n_units;
 
     eee_task = ucc_mpool_get(&ucc_ec_cpu.executor_tasks);
     if (ucc_unlikely(!eee_task)) {
         return UCC_ERR_NO_MEMORY;
     }
 
-    eee_task->eee = executor;
-    switch (task_args->task_type) {
-    case UCC_EE_EXECUTOR_TASK_REDUCE:
-        status = ucc_ec_cpu_reduce((ucc_eee_task_reduce_t *)&task_args->reduce, task_args->reduce.dst,
-                                   (task_args->flags &
-                                        UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT) ?
-                                        task_args->reduce.srcs_ext :
-                                        task_args->reduce.srcs,
-                                    task_args->flags);
+    eee_task->super.eee = executor;
+    n_units = ucc_ec_cpu_task_units(task_args, &unit_size);
+    if ((ucc_ec_cpu.workers.n_threads == 0) || (unit_size == 0) ||
+        (n_units * unit_size < cfg->exec_async_thresh)) {
+        status = ucc_ec_cpu_task_exec(task_args, 0, n_units);
         if (ucc_unlikely(UCC_OK != status)) {
             goto free_task;
         }
-        break;
-    case UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED:
-    {
-        ucc_eee_task_reduce_strided_t *trs =
-            (ucc_eee_task_reduce_strided_t *)&task_args->reduce_strided;
-        size_t                n_srcs = trs->n_src2 + 1;
-        uint16_t              flags  = task_args->flags;
-        void **               srcs;
-        ucc_eee_task_reduce_t tr;
-        int                   i;
-
-        if (n_srcs <= UCC_EE_EXECUTOR_NUM_BUFS) {
-            srcs = &tr.srcs[0];
-        } else {
-            srcs = alloca(n_srcs * sizeof(void *));
-            flags |= UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT;
-            tr.srcs_ext = srcs;
-        }
-        srcs[0] = trs->src1;
-        for (i = 0; i < n_srcs - 1; i++) {
-            srcs[i + 1] = PTR_OFFSET(trs->src2, trs->stride * i);
-        }
-        tr.count  = trs->count;
-        tr.dt     = trs->dt;
-        tr.op     = trs->op;
-        tr.n_srcs = n_srcs;
-        tr.dst    = trs->dst;
-        tr.alpha  = trs->alpha;
-
-        status = ucc_ec_cpu_reduce(&tr, tr.dst, srcs, flags);
-        if (ucc_unlikely(UCC_OK != status)) {
-            goto free_task;
-        }
-    } break;
-    case UCC_EE_EXECUTOR_TASK_COPY:
-        memcpy(task_args->copy.dst, task_args->copy.src, task_args->copy.len);
-        break;
-    case UCC_EE_EXECUTOR_TASK_COPY_MULTI:
-    default:
-        status = UCC_ERR_NOT_SUPPORTED;
-        goto free_task;
+        eee_task->super.status = status;
+        *task = &eee_task->super;
+        return status;
     }
-    eee_task->status = status;
-    *task = eee_task;
 
-    return status;
+    eee_task->super.args   = *task_args;
+    eee_task->super.status = UCC_INPROGRESS;
+    eee_task->total        = n_units;
+    if (task_args->task_type == UCC_EE_EXECUTOR_TASK_COPY_MULTI) {
+        eee_task->chunk = 1;
+    } else {
+        eee_task->chunk = ucc_max(cfg->exec_chunk_size / unit_size, 1);
+    }
+    eee_task->n_chunks     = ucc_div_round_up(n_units, eee_task->chunk);
+    eee_task->next_chunk   = 0;
+    eee_task->n_done       = 0;
+    eee_task->chunk_status = UCC_OK;
+    ec_trace(&ucc_ec_cpu.super, "task %p: offloading %zd units in %u chunks",
+             eee_task, n_units, eee_task->n_chunks);
+    ucc_ec_cpu_workers_enqueue(&ucc_ec_cpu.workers, eee_task);
+    *task = &eee_task->super;
+
+    return UCC_OK;
 
 free_task:
     ucc_mpool_put(eee_task);
@@ -176,7 +257,12 @@ free_task:
 
 ucc_status_t ucc_cpu_executor_task_test(const ucc_ee_executor_task_t *task)
 {
-    return task->status;
+    ucc_status_t status = *(volatile ucc_status_t *)&task->status;
+
+    if (status != UCC_INPROGRESS) {
+        ucc_memory_cpu_load_fence();
+    }
+    return status;
 }
 
 ucc_status_t ucc_cpu_executor_task_finalize(ucc_ee_executor_task_t *task)
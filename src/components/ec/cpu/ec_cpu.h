@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -10,20 +10,93 @@
 #include "components/ec/base/ucc_ec_base.h"
 #include "components/ec/ucc_ec_log.h"
 #include "utils/ucc_mpool.h"
+#include "utils/ucc_list.h"
+#include <pthread.h>
+
+/* Instruction set used by reduction kernels */
+typedef enum ucc_ec_cpu_isa {
+    UCC_EC_CPU_ISA_AUTO,
+    UCC_EC_CPU_ISA_SCALAR,
+    UCC_EC_CPU_ISA_AVX2,
+    UCC_EC_CPU_ISA_AVX512,
+    UCC_EC_CPU_ISA_NEON,
+    UCC_EC_CPU_ISA_SVE,
+    UCC_EC_CPU_ISA_LAST
+} ucc_ec_cpu_isa_t;
+
+extern const char *ucc_ec_cpu_isa_names[];
+
+/* Reduces n_srcs vectors of count elements into dst, the result is
+   multiplied by alpha if with_alpha is set */
+typedef void (*ucc_ec_cpu_reduce_kernel_t)(void *dst, void * const *srcs,
+                                           int n_srcs, size_t count,
+                                           int with_alpha, double alpha);
 
 typedef struct ucc_ec_cpu_config {
-    ucc_ec_config_t super;
+    ucc_ec_config_t  super;
+    unsigned         exec_num_workers;
+    size_t           exec_async_thresh;
+    size_t           exec_chunk_size;
+    int              exec_bind_workers;
+    ucc_ec_cpu_isa_t reduce_isa;
 } ucc_ec_cpu_config_t;
 
+/* Executor task handed to worker threads. The task is split into n_chunks
+   ranges which are claimed by workers one by one, task stays in the workers
+   queue until its last chunk is claimed. */
+typedef struct ucc_ec_cpu_executor_task {
+    ucc_ee_executor_task_t super;
+    ucc_list_link_t        list_elem;
+    size_t                 total;
+    size_t                 chunk;
+    uint32_t               n_chunks;
+    uint32_t               next_chunk;
+    volatile uint32_t      n_done;
+    /* error of a failed chunk, becomes task status when the last chunk is
+       done: task owner may release the task as soon as status is set */
+    volatile ucc_status_t  chunk_status;
+} ucc_ec_cpu_executor_task_t;
+
+typedef struct ucc_ec_cpu_workers {
+    pthread_t       *threads;
+    int              n_threads;
+    int              stop;
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    ucc_list_link_t  queue;
+} ucc_ec_cpu_workers_t;
+
 typedef struct ucc_ec_cpu {
-    ucc_ec_base_t     super;
-    ucc_thread_mode_t thread_mode;
-    ucc_mpool_t       executors;
-    ucc_mpool_t       executor_tasks;
-    ucc_spinlock_t    init_spinlock;
+    ucc_ec_base_t        super;
+    ucc_thread_mode_t    thread_mode;
+    ucc_mpool_t          executors;
+    ucc_mpool_t          executor_tasks;
+    ucc_spinlock_t       init_spinlock;
+    ucc_ec_cpu_workers_t workers;
+    ucc_ec_cpu_isa_t     reduce_isa;
+    /* SIMD kernels indexed by predefined dt id and op, NULL entries are
+       handled by generic scalar code */
+    ucc_ec_cpu_reduce_kernel_t
+                         reduce_kernels[UCC_DT_PREDEFINED_LAST][UCC_OP_LAST];
 } ucc_ec_cpu_t;
 
 extern ucc_ec_cpu_t ucc_ec_cpu;
 
+#define EC_CPU_CONFIG                                                          \
+    (ucc_derived_of(ucc_ec_cpu.super.config, ucc_ec_cpu_config_t))
+
 ucc_status_t ucc_ec_cpu_reduce(ucc_eee_task_reduce_t *task, void * restrict dst, void * const * restrict srcs, uint16_t flags);
+
+ucc_ec_cpu_isa_t ucc_ec_cpu_reduce_kernels_init(ucc_ec_cpu_isa_t isa);
+
+ucc_status_t ucc_ec_cpu_workers_init(ucc_ec_cpu_workers_t *workers,
+                                     int n_threads, int bind);
+
+void ucc_ec_cpu_workers_finalize(ucc_ec_cpu_workers_t *workers);
+
+void ucc_ec_cpu_workers_enqueue(ucc_ec_cpu_workers_t       *workers,
+                                ucc_ec_cpu_executor_task_t *task);
+
+ucc_status_t ucc_ec_cpu_task_exec(const ucc_ee_executor_task_args_t *args,
+                                  size_t offset, size_t count);
 #endif
@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "ec_cpu.h"
+#include "core/ucc_dt.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_atomic.h"
+#include "utils/arch/cpu.h"
+#include <sched.h>
+
+static ucc_status_t
+ucc_ec_cpu_exec_reduce(const ucc_eee_task_reduce_t *task, uint16_t flags,
+                       size_t offset, size_t count)
+{
+    void * const *        srcs = (flags & UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT)
+                                     ? task->srcs_ext : task->srcs;
+    size_t                offset_bytes;
+    ucc_eee_task_reduce_t tr;
+    void **               srcs_offset;
+    int                   i;
+
+    if ((offset == 0) && (count == task->count)) {
+        return ucc_ec_cpu_reduce((ucc_eee_task_reduce_t *)task, task->dst,
+                                 srcs, flags);
+    }
+
+    offset_bytes = offset * ucc_dt_size(task->dt);
+    srcs_offset  = alloca(task->n_srcs * sizeof(void *));
+    for (i = 0; i < task->n_srcs; i++) {
+        srcs_offset[i] = PTR_OFFSET(srcs[i], offset_bytes);
+    }
+    tr        = *task;
+    tr.count  = count;
+    tr.dst    = PTR_OFFSET(task->dst, offset_bytes);
+
+    return ucc_ec_cpu_reduce(&tr, tr.dst, srcs_offset, flags);
+}
+
+static ucc_status_t
+ucc_ec_cpu_exec_reduce_strided(const ucc_eee_task_reduce_strided_t *trs,
+                               uint16_t flags, size_t offset, size_t count)
+{
+    size_t                n_srcs       = trs->n_src2 + 1;
+    size_t                offset_bytes = offset * ucc_dt_size(trs->dt);
+    void **               srcs;
+    ucc_eee_task_reduce_t tr;
+    int                   i;
+
+    srcs    = alloca(n_srcs * sizeof(void *));
+    srcs[0] = PTR_OFFSET(trs->src1, offset_bytes);
+    for (i = 0; i < n_srcs - 1; i++) {
+        srcs[i + 1] = PTR_OFFSET(trs->src2, trs->stride * i + offset_bytes);
+    }
+    tr.count  = count;
+    tr.dt     = trs->dt;
+    tr.op     = trs->op;
+    tr.n_srcs = n_srcs;
+    tr.dst    = PTR_OFFSET(trs->dst, offset_bytes);
+    tr.alpha  = trs->alpha;
+
+    return ucc_ec_cpu_reduce(&tr, tr.dst, srcs, flags);
+}
+
+/* Executes part of the task. Offset and count are given in task units:
+   elements for reductions, bytes for copy and vectors for copy multi */
+ucc_status_t ucc_ec_cpu_task_exec(const ucc_ee_executor_task_args_t *args,
+                                  size_t offset, size_t count)
+{
+    const ucc_eee_task_copy_multi_t *tcm;
+    size_t                           i;
+
+    switch (args->task_type) {
+    case UCC_EE_EXECUTOR_TASK_REDUCE:
+        return ucc_ec_cpu_exec_reduce(&args->reduce, args->flags, offset,
+                                      count);
+    case UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED:
+        return ucc_ec_cpu_exec_reduce_strided(&args->reduce_strided,
+                                              args->flags, offset, count);
+    case UCC_EE_EXECUTOR_TASK_COPY:
+        memcpy(PTR_OFFSET(args->copy.dst, offset),
+               PTR_OFFSET(args->copy.src, offset), count);
+        return UCC_OK;
+    case UCC_EE_EXECUTOR_TASK_COPY_MULTI:
+        tcm = &args->copy_multi;
+        for (i = offset; i < offset + count; i++) {
+            memcpy(tcm->dst[i], tcm->src[i], tcm->counts[i]);
+        }
+        return UCC_OK;
+    default:
+        break;
+    }
+
+    return UCC_ERR_NOT_SUPPORTED;
+}
+
+static inline void
+ucc_ec_cpu_task_chunk_done(ucc_ec_cpu_executor_task_t *task,
+                           ucc_status_t status)
+{
+    if (ucc_unlikely(status != UCC_OK)) {
+        task->chunk_status = status;
+    }
+    if (ucc_atomic_fadd32(&task->n_done, 1) == task->n_chunks - 1) {
+        /* last chunk, publish task results */
+        ucc_memory_cpu_store_fence();
+        task->super.status = task->chunk_status;
+    }
+}
+
+static void *ucc_ec_cpu_worker_progress(void *arg)
+{
+    ucc_ec_cpu_workers_t       *workers = arg;
+    ucc_ec_cpu_executor_task_t *task;
+    ucc_status_t                status;
+    size_t                      offset;
+    uint32_t                    chunk;
+
+    pthread_mutex_lock(&workers->lock);
+    for (;;) {
+        while (!workers->stop && ucc_list_is_empty(&workers->queue)) {
+            pthread_cond_wait(&workers->cond, &workers->lock);
+        }
+        if (workers->stop) {
+            break;
+        }
+        task  = ucc_list_head(&workers->queue, ucc_ec_cpu_executor_task_t,
+                              list_elem);
+        chunk = task->next_chunk++;
+        if (task->next_chunk == task->n_chunks) {
+            ucc_list_del(&task->list_elem);
+        }
+        pthread_mutex_unlock(&workers->lock);
+
+        offset = chunk * task->chunk;
+        status = ucc_ec_cpu_task_exec(&task->super.args, offset,
+                                      ucc_min(task->chunk,
+                                              task->total - offset));
+        ucc_ec_cpu_task_chunk_done(task, status);
+
+        pthread_mutex_lock(&workers->lock);
+    }
+    pthread_mutex_unlock(&workers->lock);
+
+    return NULL;
+}
+
+/* Builds the list of cores workers are bound to: cores from the process
+   affinity mask except the one the calling thread currently runs on, so
+   that reductions do not compete with network progress. Returns 0 if there
+   is no such core and -1 if the affinity mask is not available. */
+static int ucc_ec_cpu_workers_cpus(int *cpus)
+{
+    cpu_set_t cpuset;
+    int       cpu, self, n_cpus;
+
+    if (0 != sched_getaffinity(0, sizeof(cpuset), &cpuset)) {
+        return -1;
+    }
+    self   = sched_getcpu();
+    n_cpus = 0;
+    for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &cpuset) && (cpu != self)) {
+            cpus[n_cpus++] = cpu;
+        }
+    }
+
+    return n_cpus;
+}
+
+ucc_status_t ucc_ec_cpu_workers_init(ucc_ec_cpu_workers_t *workers,
+                                     int n_threads, int bind)
+{
+    int            cpus[CPU_SETSIZE];
+    int            i, n_cpus;
+    pthread_attr_t attr;
+    cpu_set_t      cpuset;
+    ucc_status_t   status;
+
+    workers->stop      = 0;
+    workers->n_threads = 0;
+    n_cpus             = bind ? ucc_ec_cpu_workers_cpus(cpus) : -1;
+    if (n_cpus == 0) {
+        /* e.g. process bound to a single core: workers would time-share
+           the core with the posting thread instead of overlapping it */
+        ec_warn(&ucc_ec_cpu.super, "no spare core in the process affinity "
+                "mask for worker threads, tasks are executed inline");
+        return UCC_OK;
+    }
+    ucc_list_head_init(&workers->queue);
+    pthread_mutex_init(&workers->lock, NULL);
+    pthread_cond_init(&workers->cond, NULL);
+    workers->threads = ucc_malloc(n_threads * sizeof(pthread_t),
+                                  "ec cpu workers");
+    if (!workers->threads) {
+        ec_error(&ucc_ec_cpu.super, "failed to allocate %zd bytes for workers",
+                 n_threads * sizeof(pthread_t));
+        status = UCC_ERR_NO_MEMORY;
+        goto err_destroy;
+    }
+
+    for (i = 0; i < n_threads; i++) {
+        pthread_attr_init(&attr);
+        if (n_cpus > 0) {
+            CPU_ZERO(&cpuset);
+            CPU_SET(cpus[i % n_cpus], &cpuset);
+            pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+        }
+        if (0 != pthread_create(&workers->threads[i], &attr,
+                                ucc_ec_cpu_worker_progress, workers)) {
+            ec_error(&ucc_ec_cpu.super, "failed to create worker thread %d",
+                     i);
+            pthread_attr_destroy(&attr);
+            status = UCC_ERR_NO_RESOURCE;
+            goto err_stop;
+        }
+        pthread_attr_destroy(&attr);
+        workers->n_threads++;
+        ec_debug(&ucc_ec_cpu.super, "started worker %d, cpu %d", i,
+                 (n_cpus > 0) ? cpus[i % n_cpus] : -1);
+    }
+
+    return UCC_OK;
+
+err_stop:
+    ucc_ec_cpu_workers_finalize(workers);
+    return status;
+err_destroy:
+    pthread_cond_destroy(&workers->cond);
+    pthread_mutex_destroy(&workers->lock);
+    return status;
+}
+
+void ucc_ec_cpu_workers_finalize(ucc_ec_cpu_workers_t *workers)
+{
+    int i;
+
+    pthread_mutex_lock(&workers->lock);
+    workers->stop = 1;
+    pthread_cond_broadcast(&workers->cond);
+    pthread_mutex_unlock(&workers->lock);
+    for (i = 0; i < workers->n_threads; i++) {
+        pthread_join(workers->threads[i], NULL);
+    }
+    ucc_free(workers->threads);
+    workers->threads   = NULL;
+    workers->n_threads = 0;
+    pthread_cond_destroy(&workers->cond);
+    pthread_mutex_destroy(&workers->lock);
+}
+
+void ucc_ec_cpu_workers_enqueue(ucc_ec_cpu_workers_t       *workers,
+                                ucc_ec_cpu_executor_task_t *task)
+{
+    pthread_mutex_lock(&workers->lock);
+    ucc_list_add_tail(&workers->queue, &task->list_elem);
+    if (task->n_chunks > 1) {
+        pthread_cond_broadcast(&workers->cond);
+    } else {
+        pthread_cond_signal(&workers->cond);
+    }
+    pthread_mutex_unlock(&workers->lock);
+}
@@ -6,6 +6,7 @@
 
 #include "utils/ucc_math_op.h"
 #include "ec_cpu.h"
+#include "core/ucc_dt.h"
 #include <complex.h>
 
 #define DO_DT_REDUCE_WITH_OP(type, s, d, _count, _n_srcs, OP)                  \
@@ -122,54 +123,97 @@
         }                                                                      \
     } while (0)
 
-#define DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs, _OP,       \
-                                      _alpha)                                  \
+/* 16 bit floating point types are accumulated in fp32 and converted back
+   once, _fmt selects conversion helpers: bfloat16 or float16 */
+#define DO_DT_REDUCE_WITH_OP_16F(_fmt, _srcs, _dst, _count, _n_srcs, _OP,      \
+                                 _alpha)                                       \
     do {                                                                       \
         float     _tmp;                                                        \
         size_t    _i, _j;                                                      \
         int16_t **_s = (int16_t **)_srcs;                                      \
         int16_t * _d = (int16_t *)_dst;                                        \
         for (_i = 0; _i < _count; _i++) {                                      \
-            _tmp = _OP(bfloat16tofloat32(&_s[0][_i]),                          \
-                       bfloat16tofloat32(&_s[1][_i]));                         \
+            _tmp = _OP(_fmt##tofloat32(&_s[0][_i]),                            \
+                       _fmt##tofloat32(&_s[1][_i]));                           \
             for (_j = 2; _j < _n_srcs; _j++) {                                 \
-                _tmp = _OP(_tmp, bfloat16tofloat32(&_s[_j][_i]));              \
+                _tmp = _OP(_tmp, _fmt##tofloat32(&_s[_j][_i]));               \
             }                                                                  \
-            float32tobfloat16(_tmp *_alpha, &_d[_i]);                          \
+            float32to##_fmt(_tmp *_alpha, &_d[_i]);                            \
         }                                                                      \
     } while (0)
 
-#define DO_DT_REDUCE_BFLOAT16(_srcs, _dst, _op, _count, _n_srcs)               \
+#define DO_DT_REDUCE_16F(_fmt, _srcs, _dst, _op, _count, _n_srcs)              \
     do {                                                                       \
         float _a = (flags & UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA) ? task->alpha \
                                                                  : 1.0f;       \
         switch (_op) {                                                         \
         case UCC_OP_AVG:                                                       \
         case UCC_OP_SUM:                                                       \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_SUM, _a);                      \
+            DO_DT_REDUCE_WITH_OP_16F(_fmt, _srcs, _dst, _count, _n_srcs,       \
+                                     DO_OP_SUM, _a);                           \
             break;                                                             \
         case UCC_OP_PROD:                                                      \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_PROD, _a);                     \
+            DO_DT_REDUCE_WITH_OP_16F(_fmt, _srcs, _dst, _count, _n_srcs,       \
+                                     DO_OP_PROD, _a);                          \
             break;                                                             \
         case UCC_OP_MIN:                                                       \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_MIN, _a);                      \
+            DO_DT_REDUCE_WITH_OP_16F(_fmt, _srcs, _dst, _count, _n_srcs,       \
+                                     DO_OP_MIN, _a);                           \
             break;                                                             \
         case UCC_OP_MAX:                                                       \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_MAX, _a);                      \
+            DO_DT_REDUCE_WITH_OP_16F(_fmt, _srcs, _dst, _count, _n_srcs,       \
+                                     DO_OP_MAX, _a);                           \
             break;                                                             \
         default:                                                               \
             ec_error(&ucc_ec_cpu.super,                                        \
-                     "bfloat16 dtype does not support "                        \
+                     #_fmt " dtype does not support "                          \
                      "requested reduce op: %s",                                \
                      ucc_reduction_op_str(_op));                               \
             return UCC_ERR_NOT_SUPPORTED;                                      \
         }                                                                      \
     } while (0)
 
+/* MAXLOC/MINLOC over {value, index} pairs: ties on value are resolved to
+   the lowest index so the result does not depend on reduction order */
+#define DO_DT_REDUCE_LOC(type, _srcs, _dst, _op, _count, _n_srcs)              \
+    do {                                                                       \
+        typedef struct {                                                       \
+            type    val;                                                       \
+            int32_t idx;                                                       \
+        } _pair_t;                                                             \
+        const _pair_t **_s = (const _pair_t **)_srcs;                          \
+        _pair_t        *_d = (_pair_t *)_dst;                                  \
+        _pair_t         _tmp;                                                  \
+        size_t          _i, _j;                                                \
+        int             _max;                                                  \
+        switch (_op) {                                                         \
+        case UCC_OP_MAXLOC:                                                    \
+            _max = 1;                                                          \
+            break;                                                             \
+        case UCC_OP_MINLOC:                                                    \
+            _max = 0;                                                          \
+            break;                                                             \
+        default:                                                               \
+            ec_error(&ucc_ec_cpu.super,                                        \
+                     "value-index pair dtype does not support "                \
+                     "requested reduce op: %s",                                \
+                     ucc_reduction_op_str(_op));                               \
+            return UCC_ERR_NOT_SUPPORTED;                                      \
+        }                                                                      \
+        for (_i = 0; _i < _count; _i++) {                                      \
+            _tmp = _s[0][_i];                                                  \
+            for (_j = 1; _j < _n_srcs; _j++) {                                 \
+                if ((_max ? (_s[_j][_i].val > _tmp.val)                        \
+                          : (_s[_j][_i].val < _tmp.val)) ||                    \
+                    ((_s[_j][_i].val == _tmp.val) &&                           \
+                     (_s[_j][_i].idx < _tmp.idx))) {                           \
+                    _tmp = _s[_j][_i];                                         \
+                }                                                              \
+            }                                                                  \
+            _d[_i] = _tmp;                                                     \
+        }                                                                      \
+    } while (0)
+
 #define DO_DT_REDUCE_FLOAT(type, _srcs, _dst, _op, _count, _n_srcs)            \
     do {                                                                       \
         const type **restrict s = (const type **)_srcs;                        \
@@ -224,9 +268,36 @@
         }                                                                      \
     } while (0)
 
+static inline ucc_ec_cpu_reduce_kernel_t
+ucc_ec_cpu_reduce_kernel(ucc_datatype_t dt, ucc_reduction_op_t op,
+                         uint16_t flags)
+{
+    if (!UCC_DT_IS_PREDEFINED(dt) || (op >= UCC_OP_LAST)) {
+        return NULL;
+    }
+    /* SIMD kernels apply alpha to floating point types only, integer
+       types use truncation semantics of the generic code */
+    if ((flags & UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA) &&
+        (dt != UCC_DT_FLOAT32) && (dt != UCC_DT_FLOAT64) &&
+        (dt != UCC_DT_BFLOAT16) && (dt != UCC_DT_FLOAT16)) {
+        return NULL;
+    }
+
+    return ucc_ec_cpu.reduce_kernels[UCC_DT_PREDEFINED_ID(dt)][op];
+}
+
 ucc_status_t ucc_ec_cpu_reduce(ucc_eee_task_reduce_t *task, void * restrict dst,
                                void * const * restrict srcs, uint16_t flags)
 {
+    ucc_ec_cpu_reduce_kernel_t kernel;
+
+    kernel = ucc_ec_cpu_reduce_kernel(task->dt, task->op, flags);
+    if (kernel) {
+        kernel(dst, srcs, task->n_srcs, task->count,
+               flags & UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA, task->alpha);
+        return UCC_OK;
+    }
+
     switch (task->dt) {
     case UCC_DT_INT8:
         DO_DT_REDUCE_INT(int8_t, srcs, dst, task->op, task->count,
@@ -284,9 +355,13 @@ ucc_status_t ucc_ec_cpu_reduce(ucc_eee_task_reduce_t *task, void * restrict dst,
 #else
         return UCC_ERR_NOT_SUPPORTED;
 #endif
+    case UCC_DT_FLOAT16:
+        DO_DT_REDUCE_16F(float16, srcs, dst, task->op, task->count,
+                         task->n_srcs);
+        break;
     case UCC_DT_BFLOAT16:
-        DO_DT_REDUCE_BFLOAT16(srcs, dst, task->op, task->count,
-                              task->n_srcs);
+        DO_DT_REDUCE_16F(bfloat16, srcs, dst, task->op, task->count,
+                         task->n_srcs);
         break;
     case UCC_DT_FLOAT32_COMPLEX:
 #if SIZEOF_FLOAT__COMPLEX == 8
@@ -312,6 +387,22 @@ ucc_status_t ucc_ec_cpu_reduce(ucc_eee_task_reduce_t *task, void * restrict dst,
 #else
         return UCC_ERR_NOT_SUPPORTED;
 #endif
+    case UCC_DT_FLOAT32_INT32:
+        DO_DT_REDUCE_LOC(float, srcs, dst, task->op, task->count,
+                         task->n_srcs);
+        break;
+    case UCC_DT_FLOAT64_INT32:
+        DO_DT_REDUCE_LOC(double, srcs, dst, task->op, task->count,
+                         task->n_srcs);
+        break;
+    case UCC_DT_INT32_INT32:
+        DO_DT_REDUCE_LOC(int32_t, srcs, dst, task->op, task->count,
+                         task->n_srcs);
+        break;
+    case UCC_DT_INT64_INT32:
+        DO_DT_REDUCE_LOC(int64_t, srcs, dst, task->op, task->count,
+                         task->n_srcs);
+        break;
     default:
         ec_error(&ucc_ec_cpu.super, "unsupported reduction type (%s)",
                  ucc_datatype_str(task->dt));
@@ -0,0 +1,707 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "ec_cpu.h"
+#include "core/ucc_dt.h"
+#include "utils/ucc_math_op.h"
+#include "utils/arch/cpu.h"
+
+#if defined(__x86_64__)
+#  include <immintrin.h>
+#  define UCC_EC_CPU_HAVE_AVX2   HAVE_ATTRIBUTE_TARGET_AVX2
+#  define UCC_EC_CPU_HAVE_AVX512 (HAVE_ATTRIBUTE_TARGET_AVX2 && \
+                                  HAVE_ATTRIBUTE_TARGET_AVX512F)
+#elif defined(__aarch64__)
+#  include <arm_neon.h>
+#  define UCC_EC_CPU_HAVE_NEON   1
+#  if defined(__ARM_FEATURE_SVE)
+#    include <arm_sve.h>
+#    define UCC_EC_CPU_HAVE_SVE  1
+#  endif
+#endif
+
+/* Kernels are built with per-function ISA selection so that the library
+   still runs on CPUs lacking the extension, the kernel set is chosen at
+   runtime by ucc_ec_cpu_reduce_kernels_init */
+#define UCC_EC_CPU_TARGET_avx2      __attribute__((target("avx2")))
+#define UCC_EC_CPU_TARGET_avx2_f16c __attribute__((target("avx2,f16c")))
+#define UCC_EC_CPU_TARGET_avx512    __attribute__((target("avx512f")))
+#define UCC_EC_CPU_TARGET_neon
+#define UCC_EC_CPU_TARGET_sve
+
+#define UCC_EC_CPU_LOAD(_p)           (*(_p))
+#define UCC_EC_CPU_STORE(_p, _v)      (*(_p) = (_v))
+#define UCC_EC_CPU_LOAD_BF16(_p)      bfloat16tofloat32(_p)
+#define UCC_EC_CPU_STORE_BF16(_p, _v) float32tobfloat16(_v, _p)
+#define UCC_EC_CPU_LOAD_FP16(_p)      float16tofloat32(_p)
+#define UCC_EC_CPU_STORE_FP16(_p, _v) float32tofloat16(_v, _p)
+#define UCC_EC_CPU_NO_SCALE(_v, _a)   (_v)
+
+/* Reduction of n_srcs vectors processing two SIMD registers per iteration,
+   remainder which does not fill SIMD registers is reduced by scalar code */
+#define UCC_EC_CPU_SIMD_KERNEL(_isa, _name, _type, _stype, _vtype, _width,    \
+                               _vload, _vstore, _vop, _vscale, _sload,        \
+                               _sstore, _sop)                                 \
+    static UCC_EC_CPU_TARGET_##_isa void ucc_ec_cpu_reduce_##_isa##_##_name(  \
+        void *dst, void * const *srcs, int n_srcs, size_t count,              \
+        int with_alpha, double alpha)                                         \
+    {                                                                         \
+        const _type **s = (const _type **)srcs;                               \
+        _type        *d = (_type *)dst;                                       \
+        size_t        i = 0;                                                  \
+        _vtype        v0, v1;                                                 \
+        _stype        t;                                                      \
+        int           j;                                                      \
+                                                                              \
+        for (; i + 2 * (_width) <= count; i += 2 * (_width)) {                \
+            v0 = _vload(s[0] + i);                                            \
+            v1 = _vload(s[0] + i + (_width));                                 \
+            for (j = 1; j < n_srcs; j++) {                                    \
+                v0 = _vop(v0, _vload(s[j] + i));                              \
+                v1 = _vop(v1, _vload(s[j] + i + (_width)));                   \
+            }                                                                 \
+            if (with_alpha) {                                                 \
+                v0 = _vscale(v0, alpha);                                      \
+                v1 = _vscale(v1, alpha);                                      \
+            }                                                                 \
+            _vstore(d + i, v0);                                               \
+            _vstore(d + i + (_width), v1);                                    \
+        }                                                                     \
+        for (; i < count; i++) {                                              \
+            t = _sload(&s[0][i]);                                             \
+            for (j = 1; j < n_srcs; j++) {                                    \
+                t = _sop(t, _sload(&s[j][i]));                                \
+            }                                                                 \
+            if (with_alpha) {                                                 \
+                t = t * alpha;                                                \
+            }                                                                 \
+            _sstore(&d[i], t);                                                \
+        }                                                                     \
+    }
+
+/* Kernel for plain datatypes where scalar and vector element types match */
+#define UCC_EC_CPU_SIMD_KERNEL_DT(_isa, _name, _type, _vtype, _width, _vload, \
+                                  _vstore, _vop, _vscale, _sop)               \
+    UCC_EC_CPU_SIMD_KERNEL(_isa, _name, _type, _type, _vtype, _width, _vload, \
+                           _vstore, _vop, _vscale, UCC_EC_CPU_LOAD,           \
+                           UCC_EC_CPU_STORE, _sop)
+
+/* 16 bit floating point kernels: elements are widened to fp32 vectors on
+   load and rounded back on store, so accumulation is done in fp32 */
+#define UCC_EC_CPU_SIMD_KERNELS_16F(_isa, _name, _vtype, _width, _vload,      \
+                                    _vstore, _vadd, _vmul, _vmin, _vmax,      \
+                                    _vscale, _sload, _sstore)                 \
+    UCC_EC_CPU_SIMD_KERNEL(_isa, _name##_sum, uint16_t, float, _vtype,        \
+                           _width, _vload, _vstore, _vadd, _vscale, _sload,   \
+                           _sstore, DO_OP_SUM_2)                              \
+    UCC_EC_CPU_SIMD_KERNEL(_isa, _name##_prod, uint16_t, float, _vtype,       \
+                           _width, _vload, _vstore, _vmul, _vscale, _sload,   \
+                           _sstore, DO_OP_PROD_2)                             \
+    UCC_EC_CPU_SIMD_KERNEL(_isa, _name##_min, uint16_t, float, _vtype,        \
+                           _width, _vload, _vstore, _vmin, _vscale, _sload,   \
+                           _sstore, DO_OP_MIN)                                \
+    UCC_EC_CPU_SIMD_KERNEL(_isa, _name##_max, uint16_t, float, _vtype,        \
+                           _width, _vload, _vstore, _vmax, _vscale, _sload,   \
+                           _sstore, DO_OP_MAX)
+
+#define UCC_EC_CPU_KERNEL_SET(_isa, _DT, _OP, _name)                          \
+    ucc_ec_cpu.reduce_kernels[UCC_DT_PREDEFINED_ID(UCC_DT_##_DT)]             \
+                             [UCC_OP_##_OP] = ucc_ec_cpu_reduce_##_isa##_##_name
+
+#define UCC_EC_CPU_KERNEL_SET_ARITH(_isa, _DT, _name)                         \
+    do {                                                                      \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, SUM, _name##_sum);                   \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, AVG, _name##_sum);                   \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, PROD, _name##_prod);                 \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, MIN, _name##_min);                   \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, MAX, _name##_max);                   \
+    } while (0)
+
+#define UCC_EC_CPU_KERNEL_SET_BITWISE(_isa, _DT, _name)                       \
+    do {                                                                      \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, BAND, _name##_band);                 \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, BOR, _name##_bor);                   \
+        UCC_EC_CPU_KERNEL_SET(_isa, _DT, BXOR, _name##_bxor);                 \
+    } while (0)
+
+#if UCC_EC_CPU_HAVE_AVX2
+
+#define UCC_AVX2_LOAD(_p)        _mm256_loadu_si256((const __m256i *)(_p))
+#define UCC_AVX2_STORE(_p, _v)   _mm256_storeu_si256((__m256i *)(_p), _v)
+#define UCC_AVX2_SCALE_PS(_v, _a) _mm256_mul_ps(_v, _mm256_set1_ps((float)(_a)))
+#define UCC_AVX2_SCALE_PD(_v, _a) _mm256_mul_pd(_v, _mm256_set1_pd(_a))
+
+static UCC_EC_CPU_TARGET_avx2 inline __m256
+ucc_ec_cpu_avx2_load_bf16(const uint16_t *p)
+{
+    __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)p));
+
+    return _mm256_castsi256_ps(_mm256_slli_epi32(v, 16));
+}
+
+/* Truncates fp32 to bf16 the same way float32tobfloat16 does */
+static UCC_EC_CPU_TARGET_avx2 inline void
+ucc_ec_cpu_avx2_store_bf16(uint16_t *p, __m256 v)
+{
+    __m256i t = _mm256_srli_epi32(_mm256_castps_si256(v), 16);
+
+    t = _mm256_permute4x64_epi64(_mm256_packus_epi32(t, t), 0x08);
+    _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(t));
+}
+
+static UCC_EC_CPU_TARGET_avx2_f16c inline __m256
+ucc_ec_cpu_avx2_load_fp16(const uint16_t *p)
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)p));
+}
+
+static UCC_EC_CPU_TARGET_avx2_f16c inline void
+ucc_ec_cpu_avx2_store_fp16(uint16_t *p, __m256 v)
+{
+    _mm_storeu_si128((__m128i *)p,
+                     _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+#define UCC_EC_CPU_AVX2_FLOAT_KERNELS(_name, _type, _vtype, _width, _sfx,     \
+                                      _vload, _vstore, _vscale)               \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name##_sum, _type, _vtype, _width,       \
+                              _vload, _vstore, _mm256_add_##_sfx, _vscale,    \
+                              DO_OP_SUM_2)                                    \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name##_prod, _type, _vtype, _width,      \
+                              _vload, _vstore, _mm256_mul_##_sfx, _vscale,    \
+                              DO_OP_PROD_2)                                   \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name##_min, _type, _vtype, _width,       \
+                              _vload, _vstore, _mm256_min_##_sfx, _vscale,    \
+                              DO_OP_MIN)                                      \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name##_max, _type, _vtype, _width,       \
+                              _vload, _vstore, _mm256_max_##_sfx, _vscale,    \
+                              DO_OP_MAX)
+
+#define UCC_EC_CPU_AVX2_BITWISE_KERNELS(_name, _type, _width)                 \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name##_band, _type, __m256i, _width,     \
+                              UCC_AVX2_LOAD, UCC_AVX2_STORE,                  \
+                              _mm256_and_si256, UCC_EC_CPU_NO_SCALE,          \
+                              DO_OP_BAND_2)                                   \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name##_bor, _type, __m256i, _width,      \
+                              UCC_AVX2_LOAD, UCC_AVX2_STORE, _mm256_or_si256, \
+                              UCC_EC_CPU_NO_SCALE, DO_OP_BOR_2)               \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name##_bxor, _type, __m256i, _width,     \
+                              UCC_AVX2_LOAD, UCC_AVX2_STORE,                  \
+                              _mm256_xor_si256, UCC_EC_CPU_NO_SCALE,          \
+                              DO_OP_BXOR_2)
+
+#define UCC_EC_CPU_AVX2_INT_KERNEL(_name, _type, _width, _vop, _sop)          \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx2, _name, _type, __m256i, _width,            \
+                              UCC_AVX2_LOAD, UCC_AVX2_STORE, _vop,            \
+                              UCC_EC_CPU_NO_SCALE, _sop)
+
+UCC_EC_CPU_AVX2_FLOAT_KERNELS(float32, float, __m256, 8, ps, _mm256_loadu_ps,
+                              _mm256_storeu_ps, UCC_AVX2_SCALE_PS)
+UCC_EC_CPU_AVX2_FLOAT_KERNELS(float64, double, __m256d, 4, pd,
+                              _mm256_loadu_pd, _mm256_storeu_pd,
+                              UCC_AVX2_SCALE_PD)
+
+UCC_EC_CPU_SIMD_KERNELS_16F(avx2, bfloat16, __m256, 8,
+                            ucc_ec_cpu_avx2_load_bf16,
+                            ucc_ec_cpu_avx2_store_bf16, _mm256_add_ps,
+                            _mm256_mul_ps, _mm256_min_ps, _mm256_max_ps,
+                            UCC_AVX2_SCALE_PS, UCC_EC_CPU_LOAD_BF16,
+                            UCC_EC_CPU_STORE_BF16)
+UCC_EC_CPU_SIMD_KERNELS_16F(avx2_f16c, float16, __m256, 8,
+                            ucc_ec_cpu_avx2_load_fp16,
+                            ucc_ec_cpu_avx2_store_fp16, _mm256_add_ps,
+                            _mm256_mul_ps, _mm256_min_ps, _mm256_max_ps,
+                            UCC_AVX2_SCALE_PS, UCC_EC_CPU_LOAD_FP16,
+                            UCC_EC_CPU_STORE_FP16)
+
+UCC_EC_CPU_AVX2_INT_KERNEL(int8_sum, int8_t, 32, _mm256_add_epi8, DO_OP_SUM_2)
+UCC_EC_CPU_AVX2_INT_KERNEL(int8_min, int8_t, 32, _mm256_min_epi8, DO_OP_MIN)
+UCC_EC_CPU_AVX2_INT_KERNEL(int8_max, int8_t, 32, _mm256_max_epi8, DO_OP_MAX)
+UCC_EC_CPU_AVX2_INT_KERNEL(uint8_min, uint8_t, 32, _mm256_min_epu8, DO_OP_MIN)
+UCC_EC_CPU_AVX2_INT_KERNEL(uint8_max, uint8_t, 32, _mm256_max_epu8, DO_OP_MAX)
+UCC_EC_CPU_AVX2_BITWISE_KERNELS(int8, int8_t, 32)
+
+UCC_EC_CPU_AVX2_INT_KERNEL(int16_sum, int16_t, 16, _mm256_add_epi16,
+                           DO_OP_SUM_2)
+UCC_EC_CPU_AVX2_INT_KERNEL(int16_prod, int16_t, 16, _mm256_mullo_epi16,
+                           DO_OP_PROD_2)
+UCC_EC_CPU_AVX2_INT_KERNEL(int16_min, int16_t, 16, _mm256_min_epi16,
+                           DO_OP_MIN)
+UCC_EC_CPU_AVX2_INT_KERNEL(int16_max, int16_t, 16, _mm256_max_epi16,
+                           DO_OP_MAX)
+UCC_EC_CPU_AVX2_INT_KERNEL(uint16_min, uint16_t, 16, _mm256_min_epu16,
+                           DO_OP_MIN)
+UCC_EC_CPU_AVX2_INT_KERNEL(uint16_max, uint16_t, 16, _mm256_max_epu16,
+                           DO_OP_MAX)
+UCC_EC_CPU_AVX2_BITWISE_KERNELS(int16, int16_t, 16)
+
+UCC_EC_CPU_AVX2_INT_KERNEL(int32_sum, int32_t, 8, _mm256_add_epi32,
+                           DO_OP_SUM_2)
+UCC_EC_CPU_AVX2_INT_KERNEL(int32_prod, int32_t, 8, _mm256_mullo_epi32,
+                           DO_OP_PROD_2)
+UCC_EC_CPU_AVX2_INT_KERNEL(int32_min, int32_t, 8, _mm256_min_epi32,
+                           DO_OP_MIN)
+UCC_EC_CPU_AVX2_INT_KERNEL(int32_max, int32_t, 8, _mm256_max_epi32,
+                           DO_OP_MAX)
+UCC_EC_CPU_AVX2_INT_KERNEL(uint32_min, uint32_t, 8, _mm256_min_epu32,
+                           DO_OP_MIN)
+UCC_EC_CPU_AVX2_INT_KERNEL(uint32_max, uint32_t, 8, _mm256_max_epu32,
+                           DO_OP_MAX)
+UCC_EC_CPU_AVX2_BITWISE_KERNELS(int32, int32_t, 8)
+
+UCC_EC_CPU_AVX2_INT_KERNEL(int64_sum, int64_t, 4, _mm256_add_epi64,
+                           DO_OP_SUM_2)
+UCC_EC_CPU_AVX2_BITWISE_KERNELS(int64, int64_t, 4)
+
+/* Two's complement add, multiply low and bitwise ops are sign agnostic,
+   so signed kernels are reused for unsigned types */
+#define UCC_EC_CPU_AVX2_INT_SET(_BITS, _PFX)                                  \
+    do {                                                                      \
+        UCC_EC_CPU_KERNEL_SET(avx2, _PFX##_BITS, SUM, int##_BITS##_sum);      \
+        UCC_EC_CPU_KERNEL_SET_BITWISE(avx2, _PFX##_BITS, int##_BITS);         \
+    } while (0)
+
+static void ucc_ec_cpu_reduce_kernels_avx2()
+{
+    UCC_EC_CPU_KERNEL_SET_ARITH(avx2, FLOAT32, float32);
+    UCC_EC_CPU_KERNEL_SET_ARITH(avx2, FLOAT64, float64);
+    UCC_EC_CPU_KERNEL_SET_ARITH(avx2, BFLOAT16, bfloat16);
+    if (ucc_arch_get_cpu_flags() & UCC_CPU_FLAG_F16C) {
+        UCC_EC_CPU_KERNEL_SET_ARITH(avx2_f16c, FLOAT16, float16);
+    }
+
+    UCC_EC_CPU_AVX2_INT_SET(8, INT);
+    UCC_EC_CPU_AVX2_INT_SET(8, UINT);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT8, MIN, int8_min);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT8, MAX, int8_max);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT8, MIN, uint8_min);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT8, MAX, uint8_max);
+
+    UCC_EC_CPU_AVX2_INT_SET(16, INT);
+    UCC_EC_CPU_AVX2_INT_SET(16, UINT);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT16, PROD, int16_prod);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT16, PROD, int16_prod);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT16, MIN, int16_min);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT16, MAX, int16_max);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT16, MIN, uint16_min);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT16, MAX, uint16_max);
+
+    UCC_EC_CPU_AVX2_INT_SET(32, INT);
+    UCC_EC_CPU_AVX2_INT_SET(32, UINT);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT32, PROD, int32_prod);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT32, PROD, int32_prod);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT32, MIN, int32_min);
+    UCC_EC_CPU_KERNEL_SET(avx2, INT32, MAX, int32_max);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT32, MIN, uint32_min);
+    UCC_EC_CPU_KERNEL_SET(avx2, UINT32, MAX, uint32_max);
+
+    UCC_EC_CPU_AVX2_INT_SET(64, INT);
+    UCC_EC_CPU_AVX2_INT_SET(64, UINT);
+}
+#endif
+
+#if UCC_EC_CPU_HAVE_AVX512
+
+#define UCC_AVX512_LOAD(_p)         _mm512_loadu_si512((const void *)(_p))
+#define UCC_AVX512_STORE(_p, _v)    _mm512_storeu_si512((void *)(_p), _v)
+#define UCC_AVX512_SCALE_PS(_v, _a)                                           \
+    _mm512_mul_ps(_v, _mm512_set1_ps((float)(_a)))
+#define UCC_AVX512_SCALE_PD(_v, _a) _mm512_mul_pd(_v, _mm512_set1_pd(_a))
+
+static UCC_EC_CPU_TARGET_avx512 inline __m512
+ucc_ec_cpu_avx512_load_bf16(const uint16_t *p)
+{
+    __m512i v = _mm512_cvtepu16_epi32(
+        _mm256_loadu_si256((const __m256i *)p));
+
+    return _mm512_castsi512_ps(_mm512_slli_epi32(v, 16));
+}
+
+static UCC_EC_CPU_TARGET_avx512 inline void
+ucc_ec_cpu_avx512_store_bf16(uint16_t *p, __m512 v)
+{
+    __m512i t = _mm512_srli_epi32(_mm512_castps_si512(v), 16);
+
+    _mm256_storeu_si256((__m256i *)p, _mm512_cvtepi32_epi16(t));
+}
+
+static UCC_EC_CPU_TARGET_avx512 inline __m512
+ucc_ec_cpu_avx512_load_fp16(const uint16_t *p)
+{
+    return _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)p));
+}
+
+static UCC_EC_CPU_TARGET_avx512 inline void
+ucc_ec_cpu_avx512_store_fp16(uint16_t *p, __m512 v)
+{
+    _mm256_storeu_si256((__m256i *)p,
+                        _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+#define UCC_EC_CPU_AVX512_FLOAT_KERNELS(_name, _type, _vtype, _width, _sfx,   \
+                                        _vload, _vstore, _vscale)             \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx512, _name##_sum, _type, _vtype, _width,     \
+                              _vload, _vstore, _mm512_add_##_sfx, _vscale,    \
+                              DO_OP_SUM_2)                                    \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx512, _name##_prod, _type, _vtype, _width,    \
+                              _vload, _vstore, _mm512_mul_##_sfx, _vscale,    \
+                              DO_OP_PROD_2)                                   \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx512, _name##_min, _type, _vtype, _width,     \
+                              _vload, _vstore, _mm512_min_##_sfx, _vscale,    \
+                              DO_OP_MIN)                                      \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx512, _name##_max, _type, _vtype, _width,     \
+                              _vload, _vstore, _mm512_max_##_sfx, _vscale,    \
+                              DO_OP_MAX)
+
+#define UCC_EC_CPU_AVX512_INT_KERNEL(_name, _type, _width, _vop, _sop)        \
+    UCC_EC_CPU_SIMD_KERNEL_DT(avx512, _name, _type, __m512i, _width,          \
+                              UCC_AVX512_LOAD, UCC_AVX512_STORE, _vop,        \
+                              UCC_EC_CPU_NO_SCALE, _sop)
+
+#define UCC_EC_CPU_AVX512_BITWISE_KERNELS(_name, _type, _width)               \
+    UCC_EC_CPU_AVX512_INT_KERNEL(_name##_band, _type, _width,                 \
+                                 _mm512_and_si512, DO_OP_BAND_2)              \
+    UCC_EC_CPU_AVX512_INT_KERNEL(_name##_bor, _type, _width, _mm512_or_si512, \
+                                 DO_OP_BOR_2)                                 \
+    UCC_EC_CPU_AVX512_INT_KERNEL(_name##_bxor, _type, _width,                 \
+                                 _mm512_xor_si512, DO_OP_BXOR_2)
+
+UCC_EC_CPU_AVX512_FLOAT_KERNELS(float32, float, __m512, 16, ps,
+                                _mm512_loadu_ps, _mm512_storeu_ps,
+                                UCC_AVX512_SCALE_PS)
+UCC_EC_CPU_AVX512_FLOAT_KERNELS(float64, double, __m512d, 8, pd,
+                                _mm512_loadu_pd, _mm512_storeu_pd,
+                                UCC_AVX512_SCALE_PD)
+
+UCC_EC_CPU_SIMD_KERNELS_16F(avx512, bfloat16, __m512, 16,
+                            ucc_ec_cpu_avx512_load_bf16,
+                            ucc_ec_cpu_avx512_store_bf16, _mm512_add_ps,
+                            _mm512_mul_ps, _mm512_min_ps, _mm512_max_ps,
+                            UCC_AVX512_SCALE_PS, UCC_EC_CPU_LOAD_BF16,
+                            UCC_EC_CPU_STORE_BF16)
+UCC_EC_CPU_SIMD_KERNELS_16F(avx512, float16, __m512, 16,
+                            ucc_ec_cpu_avx512_load_fp16,
+                            ucc_ec_cpu_avx512_store_fp16, _mm512_add_ps,
+                            _mm512_mul_ps, _mm512_min_ps, _mm512_max_ps,
+                            UCC_AVX512_SCALE_PS, UCC_EC_CPU_LOAD_FP16,
+                            UCC_EC_CPU_STORE_FP16)
+
+UCC_EC_CPU_AVX512_INT_KERNEL(int32_sum, int32_t, 16, _mm512_add_epi32,
+                             DO_OP_SUM_2)
+UCC_EC_CPU_AVX512_INT_KERNEL(int32_prod, int32_t, 16, _mm512_mullo_epi32,
+                             DO_OP_PROD_2)
+UCC_EC_CPU_AVX512_INT_KERNEL(int32_min, int32_t, 16, _mm512_min_epi32,
+                             DO_OP_MIN)
+UCC_EC_CPU_AVX512_INT_KERNEL(int32_max, int32_t, 16, _mm512_max_epi32,
+                             DO_OP_MAX)
+UCC_EC_CPU_AVX512_INT_KERNEL(uint32_min, uint32_t, 16, _mm512_min_epu32,
+                             DO_OP_MIN)
+UCC_EC_CPU_AVX512_INT_KERNEL(uint32_max, uint32_t, 16, _mm512_max_epu32,
+                             DO_OP_MAX)
+UCC_EC_CPU_AVX512_BITWISE_KERNELS(int32, int32_t, 16)
+
+UCC_EC_CPU_AVX512_INT_KERNEL(int64_sum, int64_t, 8, _mm512_add_epi64,
+                             DO_OP_SUM_2)
+UCC_EC_CPU_AVX512_INT_KERNEL(int64_min, int64_t, 8, _mm512_min_epi64,
+                             DO_OP_MIN)
+UCC_EC_CPU_AVX512_INT_KERNEL(int64_max, int64_t, 8, _mm512_max_epi64,
+                             DO_OP_MAX)
+UCC_EC_CPU_AVX512_INT_KERNEL(uint64_min, uint64_t, 8, _mm512_min_epu64,
+                             DO_OP_MIN)
+UCC_EC_CPU_AVX512_INT_KERNEL(uint64_max, uint64_t, 8, _mm512_max_epu64,
+                             DO_OP_MAX)
+UCC_EC_CPU_AVX512_BITWISE_KERNELS(int64, int64_t, 8)
+
+/* 8 and 16 bit integer types require AVX512BW, AVX2 kernels are kept
+   for them */
+static void ucc_ec_cpu_reduce_kernels_avx512()
+{
+    UCC_EC_CPU_KERNEL_SET_ARITH(avx512, FLOAT32, float32);
+    UCC_EC_CPU_KERNEL_SET_ARITH(avx512, FLOAT64, float64);
+    UCC_EC_CPU_KERNEL_SET_ARITH(avx512, BFLOAT16, bfloat16);
+    UCC_EC_CPU_KERNEL_SET_ARITH(avx512, FLOAT16, float16);
+
+    UCC_EC_CPU_KERNEL_SET(avx512, INT32, SUM, int32_sum);
+    UCC_EC_CPU_KERNEL_SET(avx512, UINT32, SUM, int32_sum);
+    UCC_EC_CPU_KERNEL_SET(avx512, INT32, PROD, int32_prod);
+    UCC_EC_CPU_KERNEL_SET(avx512, UINT32, PROD, int32_prod);
+    UCC_EC_CPU_KERNEL_SET(avx512, INT32, MIN, int32_min);
+    UCC_EC_CPU_KERNEL_SET(avx512, INT32, MAX, int32_max);
+    UCC_EC_CPU_KERNEL_SET(avx512, UINT32, MIN, uint32_min);
+    UCC_EC_CPU_KERNEL_SET(avx512, UINT32, MAX, uint32_max);
+    UCC_EC_CPU_KERNEL_SET_BITWISE(avx512, INT32, int32);
+    UCC_EC_CPU_KERNEL_SET_BITWISE(avx512, UINT32, int32);
+
+    UCC_EC_CPU_KERNEL_SET(avx512, INT64, SUM, int64_sum);
+    UCC_EC_CPU_KERNEL_SET(avx512, UINT64, SUM, int64_sum);
+    UCC_EC_CPU_KERNEL_SET(avx512, INT64, MIN, int64_min);
+    UCC_EC_CPU_KERNEL_SET(avx512, INT64, MAX, int64_max);
+    UCC_EC_CPU_KERNEL_SET(avx512, UINT64, MIN, uint64_min);
+    UCC_EC_CPU_KERNEL_SET(avx512, UINT64, MAX, uint64_max);
+    UCC_EC_CPU_KERNEL_SET_BITWISE(avx512, INT64, int64);
+    UCC_EC_CPU_KERNEL_SET_BITWISE(avx512, UINT64, int64);
+}
+#endif
+
+#if UCC_EC_CPU_HAVE_NEON
+
+#define UCC_NEON_SCALE_F32(_v, _a) vmulq_n_f32(_v, (float)(_a))
+#define UCC_NEON_SCALE_F64(_v, _a) vmulq_n_f64(_v, _a)
+
+static inline float32x4_t ucc_ec_cpu_neon_load_bf16(const uint16_t *p)
+{
+    return vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(p), 16));
+}
+
+static inline void ucc_ec_cpu_neon_store_bf16(uint16_t *p, float32x4_t v)
+{
+    vst1_u16(p, vshrn_n_u32(vreinterpretq_u32_f32(v), 16));
+}
+
+static inline float32x4_t ucc_ec_cpu_neon_load_fp16(const uint16_t *p)
+{
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(p)));
+}
+
+static inline void ucc_ec_cpu_neon_store_fp16(uint16_t *p, float32x4_t v)
+{
+    vst1_u16(p, vreinterpret_u16_f16(vcvt_f16_f32(v)));
+}
+
+#define UCC_EC_CPU_NEON_KERNEL(_name, _type, _vtype, _width, _sfx, _vop,      \
+                               _vscale, _sop)                                 \
+    UCC_EC_CPU_SIMD_KERNEL_DT(neon, _name, _type, _vtype, _width,             \
+                              vld1q_##_sfx, vst1q_##_sfx, _vop##_##_sfx,      \
+                              _vscale, _sop)
+
+#define UCC_EC_CPU_NEON_FLOAT_KERNELS(_name, _type, _vtype, _width, _sfx,     \
+                                      _vscale)                                \
+    UCC_EC_CPU_NEON_KERNEL(_name##_sum, _type, _vtype, _width, _sfx, vaddq,   \
+                           _vscale, DO_OP_SUM_2)                              \
+    UCC_EC_CPU_NEON_KERNEL(_name##_prod, _type, _vtype, _width, _sfx, vmulq,  \
+                           _vscale, DO_OP_PROD_2)                             \
+    UCC_EC_CPU_NEON_KERNEL(_name##_min, _type, _vtype, _width, _sfx, vminq,   \
+                           _vscale, DO_OP_MIN)                                \
+    UCC_EC_CPU_NEON_KERNEL(_name##_max, _type, _vtype, _width, _sfx, vmaxq,   \
+                           _vscale, DO_OP_MAX)
+
+#define UCC_EC_CPU_NEON_INT_KERNELS(_name, _type, _vtype, _width, _sfx)       \
+    UCC_EC_CPU_NEON_KERNEL(_name##_sum, _type, _vtype, _width, _sfx, vaddq,   \
+                           UCC_EC_CPU_NO_SCALE, DO_OP_SUM_2)                  \
+    UCC_EC_CPU_NEON_KERNEL(_name##_band, _type, _vtype, _width, _sfx, vandq,  \
+                           UCC_EC_CPU_NO_SCALE, DO_OP_BAND_2)                 \
+    UCC_EC_CPU_NEON_KERNEL(_name##_bor, _type, _vtype, _width, _sfx, vorrq,   \
+                           UCC_EC_CPU_NO_SCALE, DO_OP_BOR_2)                  \
+    UCC_EC_CPU_NEON_KERNEL(_name##_bxor, _type, _vtype, _width, _sfx, veorq,  \
+                           UCC_EC_CPU_NO_SCALE, DO_OP_BXOR_2)
+
+/* 8, 16 and 32 bit integers also have vector multiply, min and max */
+#define UCC_EC_CPU_NEON_INT_KERNELS_EXT(_name, _type, _vtype, _width, _sfx)   \
+    UCC_EC_CPU_NEON_INT_KERNELS(_name, _type, _vtype, _width, _sfx)           \
+    UCC_EC_CPU_NEON_KERNEL(_name##_prod, _type, _vtype, _width, _sfx, vmulq,  \
+                           UCC_EC_CPU_NO_SCALE, DO_OP_PROD_2)                 \
+    UCC_EC_CPU_NEON_KERNEL(_name##_min, _type, _vtype, _width, _sfx, vminq,   \
+                           UCC_EC_CPU_NO_SCALE, DO_OP_MIN)                    \
+    UCC_EC_CPU_NEON_KERNEL(_name##_max, _type, _vtype, _width, _sfx, vmaxq,   \
+                           UCC_EC_CPU_NO_SCALE, DO_OP_MAX)
+
+UCC_EC_CPU_NEON_FLOAT_KERNELS(float32, float, float32x4_t, 4, f32,
+                              UCC_NEON_SCALE_F32)
+UCC_EC_CPU_NEON_FLOAT_KERNELS(float64, double, float64x2_t, 2, f64,
+                              UCC_NEON_SCALE_F64)
+
+UCC_EC_CPU_SIMD_KERNELS_16F(neon, bfloat16, float32x4_t, 4,
+                            ucc_ec_cpu_neon_load_bf16,
+                            ucc_ec_cpu_neon_store_bf16, vaddq_f32, vmulq_f32,
+                            vminq_f32, vmaxq_f32, UCC_NEON_SCALE_F32,
+                            UCC_EC_CPU_LOAD_BF16, UCC_EC_CPU_STORE_BF16)
+UCC_EC_CPU_SIMD_KERNELS_16F(neon, float16, float32x4_t, 4,
+                            ucc_ec_cpu_neon_load_fp16,
+                            ucc_ec_cpu_neon_store_fp16, vaddq_f32, vmulq_f32,
+                            vminq_f32, vmaxq_f32, UCC_NEON_SCALE_F32,
+                            UCC_EC_CPU_LOAD_FP16, UCC_EC_CPU_STORE_FP16)
+
+UCC_EC_CPU_NEON_INT_KERNELS_EXT(int8, int8_t, int8x16_t, 16, s8)
+UCC_EC_CPU_NEON_INT_KERNELS_EXT(uint8, uint8_t, uint8x16_t, 16, u8)
+UCC_EC_CPU_NEON_INT_KERNELS_EXT(int16, int16_t, int16x8_t, 8, s16)
+UCC_EC_CPU_NEON_INT_KERNELS_EXT(uint16, uint16_t, uint16x8_t, 8, u16)
+UCC_EC_CPU_NEON_INT_KERNELS_EXT(int32, int32_t, int32x4_t, 4, s32)
+UCC_EC_CPU_NEON_INT_KERNELS_EXT(uint32, uint32_t, uint32x4_t, 4, u32)
+UCC_EC_CPU_NEON_INT_KERNELS(int64, int64_t, int64x2_t, 2, s64)
+UCC_EC_CPU_NEON_INT_KERNELS(uint64, uint64_t, uint64x2_t, 2, u64)
+
+#define UCC_EC_CPU_NEON_INT_SET(_DT, _name)                                   \
+    do {                                                                      \
+        UCC_EC_CPU_KERNEL_SET(neon, _DT, SUM, _name##_sum);                   \
+        UCC_EC_CPU_KERNEL_SET_BITWISE(neon, _DT, _name);                      \
+    } while (0)
+
+#define UCC_EC_CPU_NEON_INT_SET_EXT(_DT, _name)                               \
+    do {                                                                      \
+        UCC_EC_CPU_NEON_INT_SET(_DT, _name);                                  \
+        UCC_EC_CPU_KERNEL_SET(neon, _DT, PROD, _name##_prod);                 \
+        UCC_EC_CPU_KERNEL_SET(neon, _DT, MIN, _name##_min);                   \
+        UCC_EC_CPU_KERNEL_SET(neon, _DT, MAX, _name##_max);                   \
+    } while (0)
+
+static void ucc_ec_cpu_reduce_kernels_neon()
+{
+    UCC_EC_CPU_KERNEL_SET_ARITH(neon, FLOAT32, float32);
+    UCC_EC_CPU_KERNEL_SET_ARITH(neon, FLOAT64, float64);
+    UCC_EC_CPU_KERNEL_SET_ARITH(neon, BFLOAT16, bfloat16);
+    UCC_EC_CPU_KERNEL_SET_ARITH(neon, FLOAT16, float16);
+    UCC_EC_CPU_NEON_INT_SET_EXT(INT8, int8);
+    UCC_EC_CPU_NEON_INT_SET_EXT(UINT8, uint8);
+    UCC_EC_CPU_NEON_INT_SET_EXT(INT16, int16);
+    UCC_EC_CPU_NEON_INT_SET_EXT(UINT16, uint16);
+    UCC_EC_CPU_NEON_INT_SET_EXT(INT32, int32);
+    UCC_EC_CPU_NEON_INT_SET_EXT(UINT32, uint32);
+    UCC_EC_CPU_NEON_INT_SET(INT64, int64);
+    UCC_EC_CPU_NEON_INT_SET(UINT64, uint64);
+}
+#endif
+
+#if UCC_EC_CPU_HAVE_SVE
+
+/* Vector length agnostic kernels, tail is handled by predication */
+#define UCC_EC_CPU_SVE_KERNEL(_name, _type, _vtype, _bits, _cnt, _vop,        \
+                              _with_alpha)                                    \
+    static void ucc_ec_cpu_reduce_sve_##_name(void *dst, void * const *srcs,  \
+                                              int n_srcs, size_t count,       \
+                                              int with_alpha, double alpha)   \
+    {                                                                         \
+        const _type **s = (const _type **)srcs;                               \
+        _type        *d = (_type *)dst;                                       \
+        size_t        i;                                                      \
+        svbool_t      pg;                                                     \
+        _vtype        v;                                                      \
+        int           j;                                                      \
+                                                                              \
+        for (i = 0; i < count; i += _cnt()) {                                 \
+            pg = svwhilelt_b##_bits((uint64_t)i, (uint64_t)count);            \
+            v  = svld1(pg, s[0] + i);                                         \
+            for (j = 1; j < n_srcs; j++) {                                    \
+                v = _vop(pg, v, svld1(pg, s[j] + i));                         \
+            }                                                                 \
+            if (_with_alpha && with_alpha) {                                  \
+                v = svmul_x(pg, v, (_type)alpha);                             \
+            }                                                                 \
+            svst1(pg, d + i, v);                                              \
+        }                                                                     \
+    }
+
+#define UCC_EC_CPU_SVE_KERNELS(_name, _type, _vtype, _bits, _cnt, _alpha)     \
+    UCC_EC_CPU_SVE_KERNEL(_name##_sum, _type, _vtype, _bits, _cnt, svadd_x,   \
+                          _alpha)                                             \
+    UCC_EC_CPU_SVE_KERNEL(_name##_prod, _type, _vtype, _bits, _cnt, svmul_x,  \
+                          _alpha)                                             \
+    UCC_EC_CPU_SVE_KERNEL(_name##_min, _type, _vtype, _bits, _cnt, svmin_x,   \
+                          _alpha)                                             \
+    UCC_EC_CPU_SVE_KERNEL(_name##_max, _type, _vtype, _bits, _cnt, svmax_x,   \
+                          _alpha)
+
+UCC_EC_CPU_SVE_KERNELS(float32, float32_t, svfloat32_t, 32, svcntw, 1)
+UCC_EC_CPU_SVE_KERNELS(float64, float64_t, svfloat64_t, 64, svcntd, 1)
+UCC_EC_CPU_SVE_KERNELS(int32, int32_t, svint32_t, 32, svcntw, 0)
+UCC_EC_CPU_SVE_KERNELS(uint32, uint32_t, svuint32_t, 32, svcntw, 0)
+UCC_EC_CPU_SVE_KERNELS(int64, int64_t, svint64_t, 64, svcntd, 0)
+UCC_EC_CPU_SVE_KERNELS(uint64, uint64_t, svuint64_t, 64, svcntd, 0)
+
+#define UCC_EC_CPU_SVE_INT_SET(_DT, _name)                                    \
+    do {                                                                      \
+        UCC_EC_CPU_KERNEL_SET(sve, _DT, SUM, _name##_sum);                    \
+        UCC_EC_CPU_KERNEL_SET(sve, _DT, PROD, _name##_prod);                  \
+        UCC_EC_CPU_KERNEL_SET(sve, _DT, MIN, _name##_min);                    \
+        UCC_EC_CPU_KERNEL_SET(sve, _DT, MAX, _name##_max);                    \
+    } while (0)
+
+/* Other datatypes keep NEON kernels */
+static void ucc_ec_cpu_reduce_kernels_sve()
+{
+    UCC_EC_CPU_KERNEL_SET_ARITH(sve, FLOAT32, float32);
+    UCC_EC_CPU_KERNEL_SET_ARITH(sve, FLOAT64, float64);
+    UCC_EC_CPU_SVE_INT_SET(INT32, int32);
+    UCC_EC_CPU_SVE_INT_SET(UINT32, uint32);
+    UCC_EC_CPU_SVE_INT_SET(INT64, int64);
+    UCC_EC_CPU_SVE_INT_SET(UINT64, uint64);
+}
+#endif
+
+static uint64_t ucc_ec_cpu_reduce_isa_avail()
+{
+    uint64_t cpu_flags = ucc_arch_get_cpu_flags();
+    uint64_t avail     = UCC_BIT(UCC_EC_CPU_ISA_SCALAR);
+
+#if UCC_EC_CPU_HAVE_AVX2
+    if (cpu_flags & UCC_CPU_FLAG_AVX2) {
+        avail |= UCC_BIT(UCC_EC_CPU_ISA_AVX2);
+    }
+#endif
+#if UCC_EC_CPU_HAVE_AVX512
+    if ((cpu_flags & UCC_CPU_FLAG_AVX2) && (cpu_flags & UCC_CPU_FLAG_AVX512F)) {
+        avail |= UCC_BIT(UCC_EC_CPU_ISA_AVX512);
+    }
+#endif
+#if UCC_EC_CPU_HAVE_NEON
+    if (cpu_flags & UCC_CPU_FLAG_NEON) {
+        avail |= UCC_BIT(UCC_EC_CPU_ISA_NEON);
+    }
+#endif
+#if UCC_EC_CPU_HAVE_SVE
+    if ((cpu_flags & UCC_CPU_FLAG_NEON) && (cpu_flags & UCC_CPU_FLAG_SVE)) {
+        avail |= UCC_BIT(UCC_EC_CPU_ISA_SVE);
+    }
+#endif
+    (void)cpu_flags;
+    return avail;
+}
+
+ucc_ec_cpu_isa_t ucc_ec_cpu_reduce_kernels_init(ucc_ec_cpu_isa_t isa)
+{
+    uint64_t         avail = ucc_ec_cpu_reduce_isa_avail();
+    ucc_ec_cpu_isa_t best  = (ucc_ec_cpu_isa_t)ucc_ilog2(avail);
+
+    if (isa == UCC_EC_CPU_ISA_AUTO) {
+        isa = best;
+    } else if (!(avail & UCC_BIT(isa))) {
+        ec_warn(&ucc_ec_cpu.super,
+                "%s reduction kernels are not supported, using %s",
+                ucc_ec_cpu_isa_names[isa], ucc_ec_cpu_isa_names[best]);
+        isa = best;
+    }
+
+    memset(ucc_ec_cpu.reduce_kernels, 0, sizeof(ucc_ec_cpu.reduce_kernels));
+    switch (isa) {
+#if UCC_EC_CPU_HAVE_AVX512
+    case UCC_EC_CPU_ISA_AVX512:
+        ucc_ec_cpu_reduce_kernels_avx2();
+        ucc_ec_cpu_reduce_kernels_avx512();
+        break;
+#endif
+#if UCC_EC_CPU_HAVE_AVX2
+    case UCC_EC_CPU_ISA_AVX2:
+        ucc_ec_cpu_reduce_kernels_avx2();
+        break;
+#endif
+#if UCC_EC_CPU_HAVE_SVE
+    case UCC_EC_CPU_ISA_SVE:
+        ucc_ec_cpu_reduce_kernels_neon();
+        ucc_ec_cpu_reduce_kernels_sve();
+        break;
+#endif
+#if UCC_EC_CPU_HAVE_NEON
+    case UCC_EC_CPU_ISA_NEON:
+        ucc_ec_cpu_reduce_kernels_neon();
+        break;
+#endif
+    default:
+        break;
+    }
+    ec_debug(&ucc_ec_cpu.super, "using %s reduction kernels",
+             ucc_ec_cpu_isa_names[isa]);
+
+    return isa;
+}
@@ -74,16 +74,29 @@ typedef enum ucc_mc_attr_field {
     UCC_MC_ATTR_FIELD_THREAD_MODE      = UCC_BIT(0),
  /* size of memory pool chunk element */
     UCC_MC_ATTR_FIELD_FAST_ALLOC_SIZE  = UCC_BIT(1),
+ /* scratch buffer pool counters */
+    UCC_MC_ATTR_FIELD_POOL_STATS       = UCC_BIT(2),
 }  ucc_mc_attr_field_t;
 
+typedef struct ucc_mc_pool_stats {
+    /* number of allocations served from the memory pool */
+    uint64_t n_hits;
+    /* number of allocations that fell back to the system allocator */
+    uint64_t n_misses;
+    /* amount of memory currently owned by the memory pool, both cached and
+       in use */
+    uint64_t bytes_held;
+} ucc_mc_pool_stats_t;
+
 typedef struct ucc_mc_attr {
     /**
      * Mask of valid fields in this structure, using bits from
      * @ref ucc_mc_attr_field_t.
      */
     uint64_t          field_mask;
-    ucc_thread_mode_t thread_mode;
-    size_t            fast_alloc_size;
+    ucc_thread_mode_t   thread_mode;
+    size_t              fast_alloc_size;
+    ucc_mc_pool_stats_t pool_stats;
 } ucc_mc_attr_t;
 
 /**
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -7,6 +7,7 @@
 #include "mc_cpu.h"
 #include "utils/ucc_malloc.h"
 #include "utils/ucc_math.h"
+#include "utils/ucc_atomic.h"
 #include "utils/arch/cpu.h"
 #include <sys/types.h>
 
@@ -14,25 +15,88 @@ static ucc_config_field_t ucc_mc_cpu_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_mc_cpu_config_t, super),
      UCC_CONFIG_TYPE_TABLE(ucc_mc_config_table)},
 
-    {"MPOOL_ELEM_SIZE", "1Mb", "The size of each element in mc cpu mpool",
+    {"MPOOL_MIN_ELEM_SIZE", "4Kb",
+     "The size of the smallest size class in mc cpu mpool, it is rounded up "
+     "to a power of two",
+     ucc_offsetof(ucc_mc_cpu_config_t, mpool_min_elem_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"MPOOL_ELEM_SIZE", "32Mb",
+     "The size of the largest size class in mc cpu mpool, it is rounded up "
+     "to a power of two. Bigger buffers are allocated with ucc_malloc",
      ucc_offsetof(ucc_mc_cpu_config_t, mpool_elem_size),
      UCC_CONFIG_TYPE_MEMUNITS},
 
-    {"MPOOL_MAX_ELEMS", "8", "The max amount of elements in mc cpu mpool",
+    {"MPOOL_MAX_ELEMS", "8",
+     "The max amount of elements in each size class of mc cpu mpool. "
+     "Allocations beyond that fall back to ucc_malloc and are released on "
+     "free. 0 disables the mpool",
      ucc_offsetof(ucc_mc_cpu_config_t, mpool_max_elems), UCC_CONFIG_TYPE_UINT},
 
+    {"MPOOL_MAX_CACHED", "64Mb",
+     "The max amount of memory kept by each size class of mc cpu mpool, "
+     "limits the number of elements of the large size classes. Size classes "
+     "bigger than this value are not pooled",
+     ucc_offsetof(ucc_mc_cpu_config_t, mpool_max_cached),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"MPOOL_MAX_TOTAL", "128Mb",
+     "The max amount of memory kept by mc cpu mpool in the process, across "
+     "all the size classes and NUMA arenas. Once reached, size classes do "
+     "not grow and allocations without a cached buffer fall back to "
+     "ucc_malloc. The limit may be exceeded by a few buffers when threads "
+     "allocate concurrently",
+     ucc_offsetof(ucc_mc_cpu_config_t, mpool_max_total),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"MPOOL_HUGETLB", "n",
+     "Use huge pages for mc cpu mpool size classes of 2Mb and larger, "
+     "regular memory is used if huge pages are not available",
+     ucc_offsetof(ucc_mc_cpu_config_t, mpool_hugetlb), UCC_CONFIG_TYPE_BOOL},
+
     {NULL}
 
 };
 
+static inline unsigned ucc_mc_cpu_size_shift(size_t size)
+{
+    return (size <= 1) ? 0 : ucc_ilog2(size - 1) + 1;
+}
+
 static ucc_status_t ucc_mc_cpu_init(const ucc_mc_params_t *mc_params)
 {
+    size_t   max_size;
+    unsigned max_shift;
+
     ucc_strncpy_safe(ucc_mc_cpu.super.config->log_component.name,
                      ucc_mc_cpu.super.super.name,
                      sizeof(ucc_mc_cpu.super.config->log_component.name));
     ucc_mc_cpu.thread_mode = mc_params->thread_mode;
-    // lock assures single mpool initiation when multiple threads concurrently execute
-    // different collective operations thus concurrently entering init function.
+
+    /* size classes that can't keep a single element within
+       MPOOL_MAX_CACHED are not created */
+    max_size = ucc_min(MC_CPU_CONFIG->mpool_elem_size,
+                       MC_CPU_CONFIG->mpool_max_cached);
+    ucc_mc_cpu.min_shift =
+        ucc_mc_cpu_size_shift(MC_CPU_CONFIG->mpool_min_elem_size);
+    max_shift            = ucc_mc_cpu_size_shift(max_size);
+    if (max_size < ((size_t)1 << max_shift)) {
+        max_shift--;
+    }
+    if (max_shift < ucc_mc_cpu.min_shift) {
+        ucc_mc_cpu.n_classes = 0;
+    } else {
+        ucc_mc_cpu.n_classes = max_shift - ucc_mc_cpu.min_shift + 1;
+    }
+    if (ucc_mc_cpu.n_classes > UCC_MC_CPU_MAX_SIZE_CLASSES) {
+        mc_error(&ucc_mc_cpu.super, "too many mpool size classes %u, max %d",
+                 ucc_mc_cpu.n_classes, UCC_MC_CPU_MAX_SIZE_CLASSES);
+        return UCC_ERR_INVALID_PARAM;
+    }
+    memset(&ucc_mc_cpu.stats, 0, sizeof(ucc_mc_cpu.stats));
+    // lock assures single arena initiation when multiple threads concurrently
+    // execute different collective operations thus concurrently entering init
+    // function.
     ucc_spinlock_init(&ucc_mc_cpu.mpool_init_spinlock, 0);
     return UCC_OK;
 }
@@ -42,6 +106,9 @@ static ucc_status_t ucc_mc_cpu_get_attr(ucc_mc_attr_t *mc_attr)
     if (mc_attr->field_mask & UCC_MC_ATTR_FIELD_THREAD_MODE) {
         mc_attr->thread_mode = ucc_mc_cpu.thread_mode;
     }
+    if (mc_attr->field_mask & UCC_MC_ATTR_FIELD_POOL_STATS) {
+        mc_attr->pool_stats = ucc_mc_cpu.stats;
+    }
     return UCC_OK;
 }
 
@@ -65,18 +132,47 @@ static ucc_status_t ucc_mc_cpu_mem_alloc(ucc_mc_buffer_header_t **h_ptr,
     return UCC_OK;
 }
 
+static ucc_status_t
+ucc_mc_cpu_mem_pool_alloc_with_init(ucc_mc_buffer_header_t **h_ptr,
+                                    size_t                   size,
+                                    ucc_memory_type_t        mt);
+
+/* Size classes grow by a single element, growth is not allowed once the
+   memory held by all the pools reaches MPOOL_MAX_TOTAL. The check is not
+   done under the mpool lock, so it is approximate in multithreaded mode. */
+static inline int ucc_mc_cpu_class_can_get(ucc_mc_cpu_size_class_t *sc)
+{
+    return (sc->super.super.freelist != NULL) ||
+           (ucc_mc_cpu.stats.bytes_held + sc->size <=
+            MC_CPU_CONFIG->mpool_max_total);
+}
+
 static ucc_status_t ucc_mc_cpu_mem_pool_alloc(ucc_mc_buffer_header_t **h_ptr,
                                               size_t                   size,
                                               ucc_memory_type_t        mt)
 {
-    ucc_mc_buffer_header_t *h = NULL;
-    if (size <= MC_CPU_CONFIG->mpool_elem_size) {
-        h = (ucc_mc_buffer_header_t *)ucc_mpool_get(&ucc_mc_cpu.mpool);
+    ucc_mc_cpu_arena_t     *arena = ucc_mc_cpu.arenas[ucc_local_proc.numa_id];
+    ucc_mc_buffer_header_t *h     = NULL;
+    unsigned                shift;
+
+    if (ucc_unlikely(!arena)) {
+        return ucc_mc_cpu_mem_pool_alloc_with_init(h_ptr, size, mt);
+    }
+    shift = ucc_mc_cpu_size_shift(size);
+    if (shift < ucc_mc_cpu.min_shift + ucc_mc_cpu.n_classes) {
+        shift = (shift > ucc_mc_cpu.min_shift) ?
+                shift - ucc_mc_cpu.min_shift : 0;
+        if (ucc_mc_cpu_class_can_get(&arena->classes[shift])) {
+            h = (ucc_mc_buffer_header_t *)ucc_mpool_get(
+                &arena->classes[shift].super);
+        }
     }
     if (!h) {
         // Slow path
+        ucc_atomic_add64(&ucc_mc_cpu.stats.n_misses, 1);
         return ucc_mc_cpu_mem_alloc(h_ptr, size, mt);
     }
+    ucc_atomic_add64(&ucc_mc_cpu.stats.n_hits, 1);
     mc_trace(&ucc_mc_cpu.super, "allocated %ld bytes from cpu mpool", size);
     *h_ptr = h;
     return UCC_OK;
@@ -97,10 +193,20 @@ static ucc_status_t ucc_mc_cpu_chunk_alloc(ucc_mpool_t *mp, //NOLINT
 static void ucc_mc_cpu_chunk_init(ucc_mpool_t *mp, //NOLINT
                                   void *obj, void *chunk) //NOLINT
 {
-    ucc_mc_buffer_header_t *h = (ucc_mc_buffer_header_t *)obj;
-    h->from_pool              = 1;
-    h->addr                   = PTR_OFFSET(h, sizeof(ucc_mc_buffer_header_t));
-    h->mt                     = UCC_MEMORY_TYPE_HOST;
+    ucc_mc_cpu_size_class_t *sc = ucc_derived_of(mp, ucc_mc_cpu_size_class_t);
+    ucc_mc_buffer_header_t  *h  = (ucc_mc_buffer_header_t *)obj;
+
+    h->from_pool = 1;
+    h->addr      = PTR_OFFSET(h, sizeof(ucc_mc_buffer_header_t));
+    h->mt        = UCC_MEMORY_TYPE_HOST;
+    ucc_atomic_add64(&ucc_mc_cpu.stats.bytes_held, sc->size);
+}
+
+static void ucc_mc_cpu_chunk_cleanup(ucc_mpool_t *mp, void *obj) //NOLINT
+{
+    ucc_mc_cpu_size_class_t *sc = ucc_derived_of(mp, ucc_mc_cpu_size_class_t);
+
+    ucc_atomic_sub64(&ucc_mc_cpu.stats.bytes_held, sc->size);
 }
 
 static void ucc_mc_cpu_chunk_release(ucc_mpool_t *mp, void *chunk) //NOLINT
@@ -111,7 +217,68 @@ static void ucc_mc_cpu_chunk_release(ucc_mpool_t *mp, void *chunk) //NOLINT
 static ucc_mpool_ops_t ucc_mc_ops = {.chunk_alloc   = ucc_mc_cpu_chunk_alloc,
                                      .chunk_release = ucc_mc_cpu_chunk_release,
                                      .obj_init      = ucc_mc_cpu_chunk_init,
-                                     .obj_cleanup   = NULL};
+                                     .obj_cleanup   = ucc_mc_cpu_chunk_cleanup};
+
+static ucc_mpool_ops_t ucc_mc_hugetlb_ops = {
+    .chunk_alloc   = ucc_mpool_hugetlb_malloc,
+    .chunk_release = ucc_mpool_hugetlb_free,
+    .obj_init      = ucc_mc_cpu_chunk_init,
+    .obj_cleanup   = ucc_mc_cpu_chunk_cleanup};
+
+static void ucc_mc_cpu_arena_destroy(ucc_mc_cpu_arena_t *arena,
+                                     unsigned            n_classes)
+{
+    unsigned i;
+
+    for (i = 0; i < n_classes; i++) {
+        ucc_mpool_cleanup(&arena->classes[i].super, 1);
+    }
+    ucc_free(arena);
+}
+
+static ucc_status_t ucc_mc_cpu_arena_create(ucc_numa_id_t        numa_id,
+                                            ucc_mc_cpu_arena_t **arena_p)
+{
+    ucc_mc_cpu_arena_t      *arena;
+    ucc_mc_cpu_size_class_t *sc;
+    ucc_mpool_ops_t         *ops;
+    unsigned                 i, max_elems;
+    ucc_status_t             status;
+
+    arena = ucc_malloc(sizeof(*arena), "mc cpu arena");
+    if (!arena) {
+        mc_error(&ucc_mc_cpu.super, "failed to allocate %zd bytes for arena",
+                 sizeof(*arena));
+        return UCC_ERR_NO_MEMORY;
+    }
+    arena->numa_id = numa_id;
+    for (i = 0; i < ucc_mc_cpu.n_classes; i++) {
+        sc        = &arena->classes[i];
+        sc->size  = (size_t)1 << (ucc_mc_cpu.min_shift + i);
+        max_elems = ucc_min(MC_CPU_CONFIG->mpool_max_elems,
+                            MC_CPU_CONFIG->mpool_max_cached / sc->size);
+        ops       = (MC_CPU_CONFIG->mpool_hugetlb &&
+                     (sc->size >= UCC_MC_CPU_HUGETLB_MIN_SIZE)) ?
+                    &ucc_mc_hugetlb_ops : &ucc_mc_ops;
+        /* align_offset makes the user buffer cache line aligned */
+        status    = ucc_mpool_init(&sc->super, 0,
+                                   sizeof(ucc_mc_buffer_header_t) + sc->size,
+                                   sizeof(ucc_mc_buffer_header_t),
+                                   UCC_CACHE_LINE_SIZE, 1, max_elems, ops,
+                                   ucc_mc_cpu.thread_mode,
+                                   "mc cpu mpool buffers");
+        if (ucc_unlikely(status != UCC_OK)) {
+            ucc_mc_cpu_arena_destroy(arena, i);
+            return status;
+        }
+    }
+    mc_debug(&ucc_mc_cpu.super, "created arena for numa %d, %u size classes "
+             "%zd..%zd bytes", (int)numa_id, ucc_mc_cpu.n_classes,
+             (size_t)1 << ucc_mc_cpu.min_shift,
+             (size_t)1 << (ucc_mc_cpu.min_shift + ucc_mc_cpu.n_classes - 1));
+    *arena_p = arena;
+    return UCC_OK;
+}
 
 static ucc_status_t ucc_mc_cpu_mem_free(ucc_mc_buffer_header_t *h_ptr)
 {
@@ -133,29 +300,31 @@ ucc_mc_cpu_mem_pool_alloc_with_init(ucc_mc_buffer_header_t **h_ptr,
                                     size_t                   size,
                                     ucc_memory_type_t        mt)
 {
-    // lock assures single mpool initiation when multiple threads concurrently
+    ucc_numa_id_t       numa_id = ucc_local_proc.numa_id;
+    ucc_mc_cpu_arena_t *arena;
+    ucc_status_t        status;
+
+    // lock assures single arena initiation when multiple threads concurrently
     // execute different collective operations each entering init function.
     ucc_spin_lock(&ucc_mc_cpu.mpool_init_spinlock);
 
-    if (MC_CPU_CONFIG->mpool_max_elems == 0) {
+    if ((MC_CPU_CONFIG->mpool_max_elems == 0) ||
+        (ucc_mc_cpu.n_classes == 0)) {
         ucc_mc_cpu.super.ops.mem_alloc = ucc_mc_cpu_mem_alloc;
         ucc_mc_cpu.super.ops.mem_free  = ucc_mc_cpu_mem_free;
         ucc_spin_unlock(&ucc_mc_cpu.mpool_init_spinlock);
         return ucc_mc_cpu_mem_alloc(h_ptr, size, mt);
     }
 
-    if (!ucc_mc_cpu.mpool_init_flag) {
-        ucc_status_t status = ucc_mpool_init(
-            &ucc_mc_cpu.mpool, 0,
-            sizeof(ucc_mc_buffer_header_t) + MC_CPU_CONFIG->mpool_elem_size, 0,
-            UCC_CACHE_LINE_SIZE, 1, MC_CPU_CONFIG->mpool_max_elems, &ucc_mc_ops,
-            ucc_mc_cpu.thread_mode, "mc cpu mpool buffers");
+    if (!ucc_mc_cpu.arenas[numa_id]) {
+        status = ucc_mc_cpu_arena_create(numa_id, &arena);
         if (ucc_unlikely(status != UCC_OK)) {
             ucc_spin_unlock(&ucc_mc_cpu.mpool_init_spinlock);
             return status;
         }
+        ucc_memory_cpu_store_fence();
+        ucc_mc_cpu.arenas[numa_id]     = arena;
         ucc_mc_cpu.super.ops.mem_alloc = ucc_mc_cpu_mem_pool_alloc;
-        ucc_mc_cpu.mpool_init_flag     = 1;
     }
     ucc_spin_unlock(&ucc_mc_cpu.mpool_init_spinlock);
     return ucc_mc_cpu_mem_pool_alloc(h_ptr, size, mt);
@@ -188,11 +357,20 @@ static ucc_status_t ucc_mc_cpu_mem_query(const void *ptr, //NOLINT
 
 static ucc_status_t ucc_mc_cpu_finalize()
 {
-    if (ucc_mc_cpu.mpool_init_flag) {
-        ucc_mpool_cleanup(&ucc_mc_cpu.mpool, 1);
-        ucc_mc_cpu.mpool_init_flag     = 0;
-        ucc_mc_cpu.super.ops.mem_alloc = ucc_mc_cpu_mem_pool_alloc_with_init;
+    int i;
+
+    mc_debug(&ucc_mc_cpu.super, "mpool stats: hits %lu misses %lu "
+             "bytes held %lu", ucc_mc_cpu.stats.n_hits,
+             ucc_mc_cpu.stats.n_misses, ucc_mc_cpu.stats.bytes_held);
+    for (i = 0; i <= UCC_NUMA_ID_INVALID; i++) {
+        if (ucc_mc_cpu.arenas[i]) {
+            ucc_mc_cpu_arena_destroy(ucc_mc_cpu.arenas[i],
+                                     ucc_mc_cpu.n_classes);
+            ucc_mc_cpu.arenas[i] = NULL;
+        }
     }
+    ucc_mc_cpu.super.ops.mem_alloc = ucc_mc_cpu_mem_pool_alloc_with_init;
+    ucc_mc_cpu.super.ops.mem_free  = ucc_mc_cpu_mem_pool_free;
     ucc_spinlock_destroy(&ucc_mc_cpu.mpool_init_spinlock);
     return UCC_OK;
 }
@@ -218,7 +396,7 @@ ucc_mc_cpu_t ucc_mc_cpu = {
             .table  = ucc_mc_cpu_config_table,
             .size   = sizeof(ucc_mc_cpu_config_t),
         },
-    .mpool_init_flag               = 0,
+    .arenas                        = {NULL},
 };
 
 UCC_CONFIG_REGISTER_TABLE_ENTRY(&ucc_mc_cpu.super.config_table,
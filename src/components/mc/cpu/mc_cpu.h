@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -9,19 +9,46 @@
 
 #include "components/mc/base/ucc_mc_base.h"
 #include "components/mc/ucc_mc_log.h"
+#include "utils/ucc_proc_info.h"
+
+/* Max number of power-of-two size classes in a single arena */
+#define UCC_MC_CPU_MAX_SIZE_CLASSES 32
+
+/* Huge pages are only used for size classes of at least this size: every
+   pool chunk holds a single element and is rounded up to the huge page size */
+#define UCC_MC_CPU_HUGETLB_MIN_SIZE (2ul * 1024 * 1024)
 
 typedef struct ucc_mc_cpu_config {
     ucc_mc_config_t super;
+    size_t          mpool_min_elem_size;
     size_t          mpool_elem_size;
     int             mpool_max_elems;
+    size_t          mpool_max_cached;
+    size_t          mpool_max_total;
+    int             mpool_hugetlb;
 } ucc_mc_cpu_config_t;
 
+typedef struct ucc_mc_cpu_size_class {
+    ucc_mpool_t super;
+    size_t      size;
+} ucc_mc_cpu_size_class_t;
+
+/* Set of size class pools serving the processes bound to one NUMA node */
+typedef struct ucc_mc_cpu_arena {
+    ucc_numa_id_t           numa_id;
+    ucc_mc_cpu_size_class_t classes[UCC_MC_CPU_MAX_SIZE_CLASSES];
+} ucc_mc_cpu_arena_t;
+
 typedef struct ucc_mc_cpu {
-    ucc_mc_base_t     super;
-    ucc_mpool_t       mpool;
-    int               mpool_init_flag;
-    ucc_spinlock_t    mpool_init_spinlock;
-    ucc_thread_mode_t thread_mode;
+    ucc_mc_base_t       super;
+    /* arenas are indexed by numa id, UCC_NUMA_ID_INVALID is used when the
+       process is not bound to a single NUMA node */
+    ucc_mc_cpu_arena_t *arenas[UCC_NUMA_ID_INVALID + 1];
+    unsigned            min_shift;
+    unsigned            n_classes;
+    ucc_spinlock_t      mpool_init_spinlock;
+    ucc_thread_mode_t   thread_mode;
+    ucc_mc_pool_stats_t stats;
 } ucc_mc_cpu_t;
 
 extern ucc_mc_cpu_t ucc_mc_cpu;
@@ -9,6 +9,8 @@
 #include "ucc_mc.h"
 #include "utils/ucc_malloc.h"
 #include "utils/ucc_log.h"
+#include "utils/ucc_rcache.h"
+#include "utils/ucc_atomic.h"
 
 #ifdef HAVE_PROFILING_MC
 #include "utils/profile/ucc_profile.h"
@@ -19,6 +21,27 @@
 
 static const ucc_mc_ops_t *mc_ops[UCC_MEMORY_TYPE_LAST];
 
+/* Cache of memory attributes keyed by page address range. Populated on the
+   first query of a page, regions are dropped by rcache on VM unmap and
+   memory type free events so that reused addresses are queried again. */
+typedef struct ucc_mc_mem_attr_region {
+    ucc_rcache_region_t super;
+    ucc_memory_type_t   mem_type;
+    /* allocation range reported by the memory component, base_address is
+       NULL if not reported (host memory) */
+    void               *base_address;
+    size_t              alloc_length;
+} ucc_mc_mem_attr_region_t;
+
+typedef struct ucc_mc_mem_attr_cache {
+    ucc_rcache_t *rcache;
+    int           ref_cnt;
+    uint64_t      n_lookups;
+    uint64_t      n_misses;
+} ucc_mc_mem_attr_cache_t;
+
+static ucc_mc_mem_attr_cache_t mem_attr_cache;
+
 #define UCC_CHECK_MC_AVAILABLE(mc)                                             \
     do {                                                                       \
         if (ucc_unlikely(NULL == mc_ops[mc])) {                                \
@@ -28,6 +51,138 @@ static const ucc_mc_ops_t *mc_ops[UCC_MEMORY_TYPE_LAST];
         }                                                                      \
     } while (0)
 
+static ucc_status_t ucc_mc_query_mem_attr(const void *ptr,
+                                          ucc_mem_attr_t *mem_attr)
+{
+    ucc_status_t      status;
+    ucc_memory_type_t mt;
+
+    mt = (ucc_memory_type_t)(UCC_MEMORY_TYPE_HOST + 1);
+    for (; mt < UCC_MEMORY_TYPE_LAST; mt++) {
+        if (NULL != mc_ops[mt]) {
+            status = mc_ops[mt]->mem_query(ptr, mem_attr);
+            if (UCC_OK == status) {
+                return UCC_OK;
+            }
+        }
+    }
+    return UCC_ERR_NOT_FOUND;
+}
+
+static ucs_status_t ucc_mc_mem_attr_region_reg(void *context, //NOLINT
+                                               ucc_rcache_t *rcache, //NOLINT
+                                               void *arg,
+                                               ucc_rcache_region_t *rregion,
+                                               uint16_t flags) //NOLINT
+{
+    ucc_mc_mem_attr_region_t *region =
+        ucc_derived_of(rregion, ucc_mc_mem_attr_region_t);
+    ucc_mem_attr_t            mem_attr;
+
+    mem_attr.field_mask   = UCC_MEM_ATTR_FIELD_MEM_TYPE |
+                            UCC_MEM_ATTR_FIELD_BASE_ADDRESS |
+                            UCC_MEM_ATTR_FIELD_ALLOC_LENGTH;
+    mem_attr.alloc_length = 0;
+    if (UCC_OK == ucc_mc_query_mem_attr(arg, &mem_attr)) {
+        region->mem_type     = mem_attr.mem_type;
+        region->base_address = mem_attr.base_address;
+        region->alloc_length = mem_attr.alloc_length;
+    } else {
+        region->mem_type     = UCC_MEMORY_TYPE_HOST;
+        region->base_address = NULL;
+        region->alloc_length = 0;
+    }
+    ucc_atomic_add64(&mem_attr_cache.n_misses, 1);
+    return UCS_OK;
+}
+
+static void ucc_mc_mem_attr_region_dereg(void *context, //NOLINT
+                                         ucc_rcache_t *rcache, //NOLINT
+                                         ucc_rcache_region_t *rregion) //NOLINT
+{
+    return;
+}
+
+static void ucc_mc_mem_attr_region_dump(void *context, //NOLINT
+                                        ucc_rcache_t *rcache, //NOLINT
+                                        ucc_rcache_region_t *rregion,
+                                        char *buf, size_t max)
+{
+    ucc_mc_mem_attr_region_t *region =
+        ucc_derived_of(rregion, ucc_mc_mem_attr_region_t);
+
+    snprintf(buf, max, "mem_type:%s base:%p len:%zu",
+             ucc_memory_type_names[region->mem_type], region->base_address,
+             region->alloc_length);
+}
+
+static ucc_rcache_ops_t ucc_mc_mem_attr_rcache_ops = {
+    .mem_reg     = ucc_mc_mem_attr_region_reg,
+    .mem_dereg   = ucc_mc_mem_attr_region_dereg,
+    .dump_region = ucc_mc_mem_attr_region_dump,
+#ifdef UCS_HAVE_RCACHE_MERGE_CB
+    .merge       = ucc_rcache_merge_cb_empty
+#endif
+};
+
+static void ucc_mc_mem_attr_cache_init(void)
+{
+    ucc_rcache_params_t rcache_params;
+    ucc_memory_type_t   mt;
+    ucc_status_t        status;
+    int                 enable;
+
+    if (mem_attr_cache.ref_cnt++ > 0) {
+        return;
+    }
+    switch (ucc_global_config.memtype_cache) {
+    case UCC_CONFIG_ON:
+        enable = 1;
+        break;
+    case UCC_CONFIG_OFF:
+        enable = 0;
+        break;
+    default:
+        /* host only setup has nothing to query */
+        enable = 0;
+        for (mt = UCC_MEMORY_TYPE_HOST + 1; mt < UCC_MEMORY_TYPE_LAST; mt++) {
+            enable |= (NULL != mc_ops[mt]);
+        }
+        break;
+    }
+    mem_attr_cache.n_lookups = 0;
+    mem_attr_cache.n_misses  = 0;
+    if (!enable) {
+        return;
+    }
+
+    ucc_rcache_set_default_params(&rcache_params);
+    rcache_params.region_struct_size = sizeof(ucc_mc_mem_attr_region_t);
+    rcache_params.ops                = &ucc_mc_mem_attr_rcache_ops;
+    rcache_params.ucm_events         = UCM_EVENT_VM_UNMAPPED |
+                                       UCM_EVENT_MEM_TYPE_FREE;
+    status = ucc_rcache_create(&rcache_params, "MC_MEMTYPE",
+                               &mem_attr_cache.rcache);
+    if (UCC_OK != status) {
+        ucc_debug("failed to create memory type cache: %s",
+                  ucc_status_string(status));
+        mem_attr_cache.rcache = NULL;
+    }
+}
+
+static void ucc_mc_mem_attr_cache_finalize(void)
+{
+    if (--mem_attr_cache.ref_cnt > 0) {
+        return;
+    }
+    if (mem_attr_cache.rcache) {
+        ucc_debug("memory type cache: lookups %lu misses %lu",
+                  mem_attr_cache.n_lookups, mem_attr_cache.n_misses);
+        ucc_rcache_destroy(mem_attr_cache.rcache);
+        mem_attr_cache.rcache = NULL;
+    }
+}
+
 ucc_status_t ucc_mc_init(const ucc_mc_params_t *mc_params)
 {
     int            i, n_mcs;
@@ -81,6 +236,7 @@ ucc_status_t ucc_mc_init(const ucc_mc_params_t *mc_params)
         mc->ref_cnt++;
         mc_ops[mc->type] = &mc->ops;
     }
+    ucc_mc_mem_attr_cache_init();
 
     return UCC_OK;
 }
@@ -97,10 +253,24 @@ ucc_status_t ucc_mc_available(ucc_memory_type_t mem_type)
     return UCC_OK;
 }
 
+ucc_status_t ucc_mc_get_mem_attr_cache_stats(uint64_t *n_lookups,
+                                             uint64_t *n_misses)
+{
+    if (!mem_attr_cache.rcache) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    *n_lookups = mem_attr_cache.n_lookups;
+    *n_misses  = mem_attr_cache.n_misses;
+    return UCC_OK;
+}
+
 ucc_status_t ucc_mc_get_mem_attr(const void *ptr, ucc_mem_attr_t *mem_attr)
 {
-    ucc_status_t      status;
-    ucc_memory_type_t mt;
+    ucc_mc_mem_attr_region_t *region;
+    ucc_rcache_region_t      *rregion;
+    ucc_status_t              status;
+    size_t                    page_size;
+    void                     *page;
 
     mem_attr->mem_type     = UCC_MEMORY_TYPE_HOST;
     mem_attr->base_address = (void *)ptr;
@@ -109,15 +279,35 @@ ucc_status_t ucc_mc_get_mem_attr(const void *ptr, ucc_mem_attr_t *mem_attr)
         return UCC_OK;
     }
 
-    mt = (ucc_memory_type_t)(UCC_MEMORY_TYPE_HOST + 1);
-    for (; mt < UCC_MEMORY_TYPE_LAST; mt++) {
-        if (NULL != mc_ops[mt]) {
-            status = mc_ops[mt]->mem_query(ptr, mem_attr);
-            if (UCC_OK == status) {
-                return UCC_OK;
-            }
+    if (!mem_attr_cache.rcache) {
+        ucc_mc_query_mem_attr(ptr, mem_attr);
+        return UCC_OK;
+    }
+
+    page_size = ucc_get_page_size();
+    page      = (void *)ucc_align_down((uintptr_t)ptr, page_size);
+    status    = ucc_rcache_get(mem_attr_cache.rcache, page, page_size,
+                               (void *)ptr, &rregion);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_mc_query_mem_attr(ptr, mem_attr);
+        return UCC_OK;
+    }
+    ucc_atomic_add64(&mem_attr_cache.n_lookups, 1);
+    region = ucc_derived_of(rregion, ucc_mc_mem_attr_region_t);
+    mem_attr->mem_type = region->mem_type;
+    if ((mem_attr->field_mask & (UCC_MEM_ATTR_FIELD_BASE_ADDRESS |
+                                 UCC_MEM_ATTR_FIELD_ALLOC_LENGTH)) &&
+        region->base_address) {
+        if (ptr >= region->base_address &&
+            PTR_OFFSET(region->base_address, region->alloc_length) > ptr) {
+            mem_attr->base_address = region->base_address;
+            mem_attr->alloc_length = region->alloc_length;
+        } else {
+            /* other allocation sharing the page */
+            ucc_mc_query_mem_attr(ptr, mem_attr);
         }
     }
+    ucc_rcache_region_put(mem_attr_cache.rcache, rregion);
     return UCC_OK;
 }
 
@@ -204,6 +394,7 @@ ucc_status_t ucc_mc_finalize()
    ucc_memory_type_t  mt;
    ucc_mc_base_t     *mc;
 
+    ucc_mc_mem_attr_cache_finalize();
     for (mt = UCC_MEMORY_TYPE_HOST; mt < UCC_MEMORY_TYPE_LAST; mt++) {
         if (NULL != mc_ops[mt]) {
             mc = ucc_container_of(mc_ops[mt], ucc_mc_base_t, ops);
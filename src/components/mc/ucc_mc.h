@@ -24,6 +24,15 @@ ucc_status_t ucc_mc_available(ucc_memory_type_t mem_type);
  */
 ucc_status_t ucc_mc_get_mem_attr(const void *ptr, ucc_mem_attr_t *mem_attr);
 
+/**
+ * Get memory type cache counters. Returns UCC_ERR_NOT_SUPPORTED if the
+ * cache is disabled.
+ * @param [out]       n_lookups Number of queries served through the cache.
+ * @param [out]       n_misses  Number of queries that populated the cache.
+ */
+ucc_status_t ucc_mc_get_mem_attr_cache_stats(uint64_t *n_lookups,
+                                             uint64_t *n_misses);
+
 ucc_status_t ucc_mc_get_attr(ucc_mc_attr_t *attr, ucc_memory_type_t mem_type);
 
 ucc_status_t ucc_mc_alloc(ucc_mc_buffer_header_t **h_ptr, size_t len,
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "allgather.h"
+#include "tl_shm_cma.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Every rank pulls the blocks of all peers into its dst */
+static ucc_status_t ucc_tl_shm_allgather_cma_xfer(ucc_tl_shm_task_t *task,
+                                                  ucc_rank_t         peer,
+                                                  ucc_tl_shm_ctrl_t *peer_ctrl)
+{
+    ucc_tl_shm_team_t *team = TASK_TEAM(task);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    void              *dst  = PTR_OFFSET(args->dst.info.buffer,
+                                         task->data_size * peer);
+
+    if (peer == UCC_TL_TEAM_RANK(team)) {
+        if (!UCC_IS_INPLACE(*args)) {
+            memcpy(dst, args->src.info.buffer, task->data_size);
+        }
+        return UCC_OK;
+    }
+    return ucc_tl_shm_cma_read(team, peer_ctrl->pid, dst, peer_ctrl->cma.src,
+                               task->data_size);
+}
+
+ucc_status_t ucc_tl_shm_allgather_init(ucc_base_coll_args_t *coll_args,
+                                       ucc_tl_shm_team_t    *team,
+                                       ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args = &coll_args->args;
+    ucc_rank_t         rank = UCC_TL_TEAM_RANK(team);
+    ucc_tl_shm_task_t *task;
+    ucc_status_t       status;
+    size_t             block;
+
+    if (args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST ||
+        (!UCC_IS_INPLACE(*args) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_tl_shm_cma_init(coll_args, team, 0,
+                                 ucc_tl_shm_allgather_cma_xfer, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    block = args->dst.info.count / UCC_TL_TEAM_SIZE(team) *
+            ucc_dt_size(args->dst.info.datatype);
+    task->data_size    = block;
+    task->cma_info.src = UCC_IS_INPLACE(*args)
+        ? (uint64_t)PTR_OFFSET(args->dst.info.buffer, block * rank)
+        : (uint64_t)args->src.info.buffer;
+    *task_h = &task->super;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_shm_allgatherv_cma_xfer(ucc_tl_shm_task_t *task,
+                                                   ucc_rank_t         peer,
+                                                   ucc_tl_shm_ctrl_t *peer_ctrl)
+{
+    ucc_tl_shm_team_t *team   = TASK_TEAM(task);
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    size_t             dt_size = ucc_dt_size(args->dst.info_v.datatype);
+    size_t             len;
+    void              *dst;
+
+    len = ucc_coll_args_get_count(args, args->dst.info_v.counts, peer) *
+          dt_size;
+    dst = PTR_OFFSET(args->dst.info_v.buffer,
+                     ucc_coll_args_get_displacement(
+                         args, args->dst.info_v.displacements, peer) *
+                         dt_size);
+    if (peer == UCC_TL_TEAM_RANK(team)) {
+        if (!UCC_IS_INPLACE(*args)) {
+            memcpy(dst, args->src.info.buffer, len);
+        }
+        return UCC_OK;
+    }
+    return ucc_tl_shm_cma_read(team, peer_ctrl->pid, dst, peer_ctrl->cma.src,
+                               len);
+}
+
+ucc_status_t ucc_tl_shm_allgatherv_init(ucc_base_coll_args_t *coll_args,
+                                        ucc_tl_shm_team_t    *team,
+                                        ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args = &coll_args->args;
+    ucc_rank_t         rank = UCC_TL_TEAM_RANK(team);
+    ucc_tl_shm_task_t *task;
+    ucc_status_t       status;
+    size_t             displ;
+
+    if (args->dst.info_v.mem_type != UCC_MEMORY_TYPE_HOST ||
+        (!UCC_IS_INPLACE(*args) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_tl_shm_cma_init(coll_args, team, 0,
+                                 ucc_tl_shm_allgatherv_cma_xfer, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    displ = ucc_coll_args_get_displacement(args,
+                                           args->dst.info_v.displacements,
+                                           rank) *
+            ucc_dt_size(args->dst.info_v.datatype);
+    task->cma_info.src = UCC_IS_INPLACE(*args)
+        ? (uint64_t)PTR_OFFSET(args->dst.info_v.buffer, displ)
+        : (uint64_t)args->src.info.buffer;
+    *task_h = &task->super;
+    return UCC_OK;
+}
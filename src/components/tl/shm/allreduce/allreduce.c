@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "allreduce.h"
+
+enum {
+    UCC_TL_SHM_ALLREDUCE_PHASE_REDUCE,
+    UCC_TL_SHM_ALLREDUCE_PHASE_BCAST
+};
+
+/* Reduce to rank 0 followed by bcast from rank 0 within the same sequence
+   number: reduce uses up slots and ARRIVE flags, bcast uses down slots and
+   RELEASE flags, so the phases do not interfere */
+static void ucc_tl_shm_allreduce_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    void              *dst  = args->dst.info.buffer;
+    void              *src  = UCC_IS_INPLACE(*args) ? dst
+                                                    : args->src.info.buffer;
+    ucc_status_t       status;
+
+    if (!ucc_tl_shm_task_is_current(task)) {
+        return;
+    }
+    switch (task->phase) {
+    case UCC_TL_SHM_ALLREDUCE_PHASE_REDUCE:
+        status = ucc_tl_shm_reduce_phase(task, src, dst);
+        if (status != UCC_OK) {
+            break;
+        }
+        task->phase = UCC_TL_SHM_ALLREDUCE_PHASE_BCAST;
+        /* fall through */
+    case UCC_TL_SHM_ALLREDUCE_PHASE_BCAST:
+        status = ucc_tl_shm_bcast_phase(task, dst);
+        break;
+    default:
+        status = UCC_ERR_INVALID_PARAM;
+        break;
+    }
+    if (status != UCC_INPROGRESS) {
+        ucc_tl_shm_task_complete(task, status);
+    }
+}
+
+ucc_status_t ucc_tl_shm_allreduce_init(ucc_base_coll_args_t *coll_args,
+                                       ucc_tl_shm_team_t    *team,
+                                       ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args = &coll_args->args;
+    ucc_tl_shm_task_t *task;
+    size_t             data_size;
+
+    if (!ucc_coll_args_is_predefined_dt(args, UCC_TL_TEAM_RANK(team))) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST ||
+        (!UCC_IS_INPLACE(*args) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    data_size = args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+    if (data_size > team->data_size) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    task = ucc_tl_shm_get_task(coll_args, team, 0);
+    if (ucc_unlikely(!task)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->data_size      = data_size;
+    task->dt             = args->dst.info.datatype;
+    task->super.progress = ucc_tl_shm_allreduce_progress;
+    task->super.flags   |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
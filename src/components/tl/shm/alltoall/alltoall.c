@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "alltoall.h"
+#include "tl_shm_cma.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Every rank pulls its block from src of all peers */
+static ucc_status_t ucc_tl_shm_alltoall_cma_xfer(ucc_tl_shm_task_t *task,
+                                                 ucc_rank_t         peer,
+                                                 ucc_tl_shm_ctrl_t *peer_ctrl)
+{
+    ucc_tl_shm_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         rank  = UCC_TL_TEAM_RANK(team);
+    size_t             block = task->data_size;
+    void              *dst   = PTR_OFFSET(args->dst.info.buffer,
+                                          block * peer);
+
+    if (peer == rank) {
+        memcpy(dst, PTR_OFFSET(args->src.info.buffer, block * rank), block);
+        return UCC_OK;
+    }
+    return ucc_tl_shm_cma_read(team, peer_ctrl->pid, dst,
+                               peer_ctrl->cma.src + block * rank, block);
+}
+
+ucc_status_t ucc_tl_shm_alltoall_init(ucc_base_coll_args_t *coll_args,
+                                      ucc_tl_shm_team_t    *team,
+                                      ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args = &coll_args->args;
+    ucc_tl_shm_task_t *task;
+    ucc_status_t       status;
+
+    /* peers would read blocks that are already overwritten */
+    if (UCC_IS_INPLACE(*args) ||
+        args->src.info.mem_type != UCC_MEMORY_TYPE_HOST ||
+        args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_tl_shm_cma_init(coll_args, team, 0,
+                                 ucc_tl_shm_alltoall_cma_xfer, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    task->data_size    = args->src.info.count / UCC_TL_TEAM_SIZE(team) *
+                         ucc_dt_size(args->src.info.datatype);
+    task->cma_info.src = (uint64_t)args->src.info.buffer;
+    *task_h            = &task->super;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_shm_alltoallv_cma_xfer(ucc_tl_shm_task_t *task,
+                                                  ucc_rank_t         peer,
+                                                  ucc_tl_shm_ctrl_t *peer_ctrl)
+{
+    ucc_tl_shm_team_t *team     = TASK_TEAM(task);
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
+    ucc_rank_t         rank     = UCC_TL_TEAM_RANK(team);
+    size_t             src_size = ucc_dt_size(args->src.info_v.datatype);
+    size_t             dst_size = ucc_dt_size(args->dst.info_v.datatype);
+    size_t             len, displ;
+    ucc_status_t       status;
+    void              *dst;
+
+    len = ucc_coll_args_get_count(args, args->dst.info_v.counts, peer) *
+          dst_size;
+    dst = PTR_OFFSET(args->dst.info_v.buffer,
+                     ucc_coll_args_get_displacement(
+                         args, args->dst.info_v.displacements, peer) *
+                         dst_size);
+    if (peer == rank) {
+        displ = ucc_coll_args_get_displacement(
+            args, args->src.info_v.displacements, rank);
+        memcpy(dst, PTR_OFFSET(args->src.info_v.buffer, displ * src_size),
+               len);
+        return UCC_OK;
+    }
+    if (len == 0) {
+        return UCC_OK;
+    }
+    status = ucc_tl_shm_cma_read_displ(team, peer_ctrl->pid,
+                                       peer_ctrl->cma.displs, rank,
+                                       UCC_COLL_ARGS_DISPL64(args), &displ);
+    if (ucc_unlikely(status != UCC_OK)) {
+        return status;
+    }
+    return ucc_tl_shm_cma_read(team, peer_ctrl->pid, dst,
+                               peer_ctrl->cma.src + displ * src_size, len);
+}
+
+ucc_status_t ucc_tl_shm_alltoallv_init(ucc_base_coll_args_t *coll_args,
+                                       ucc_tl_shm_team_t    *team,
+                                       ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args = &coll_args->args;
+    ucc_tl_shm_task_t *task;
+    ucc_status_t       status;
+
+    if (UCC_IS_INPLACE(*args) ||
+        args->src.info_v.mem_type != UCC_MEMORY_TYPE_HOST ||
+        args->dst.info_v.mem_type != UCC_MEMORY_TYPE_HOST) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_tl_shm_cma_init(coll_args, team, 0,
+                                 ucc_tl_shm_alltoallv_cma_xfer, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    task->cma_info.src    = (uint64_t)args->src.info_v.buffer;
+    task->cma_info.displs = (uint64_t)args->src.info_v.displacements;
+    *task_h               = &task->super;
+    return UCC_OK;
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "barrier.h"
+
+enum {
+    UCC_TL_SHM_BARRIER_PHASE_FANIN,
+    UCC_TL_SHM_BARRIER_PHASE_FANOUT
+};
+
+static void ucc_tl_shm_barrier_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_status_t       status;
+
+    if (!ucc_tl_shm_task_is_current(task)) {
+        return;
+    }
+    switch (task->phase) {
+    case UCC_TL_SHM_BARRIER_PHASE_FANIN:
+        status = ucc_tl_shm_fanin_phase(task);
+        if (status != UCC_OK) {
+            break;
+        }
+        task->phase = UCC_TL_SHM_BARRIER_PHASE_FANOUT;
+        /* fall through */
+    case UCC_TL_SHM_BARRIER_PHASE_FANOUT:
+        status = ucc_tl_shm_fanout_phase(task);
+        break;
+    default:
+        status = UCC_ERR_INVALID_PARAM;
+        break;
+    }
+    if (status != UCC_INPROGRESS) {
+        ucc_tl_shm_task_complete(task, status);
+    }
+}
+
+static void ucc_tl_shm_fanin_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_status_t       status;
+
+    if (!ucc_tl_shm_task_is_current(task)) {
+        return;
+    }
+    status = ucc_tl_shm_fanin_phase(task);
+    if (status != UCC_INPROGRESS) {
+        ucc_tl_shm_task_complete(task, status);
+    }
+}
+
+static void ucc_tl_shm_fanout_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_status_t       status;
+
+    if (!ucc_tl_shm_task_is_current(task)) {
+        return;
+    }
+    status = ucc_tl_shm_fanout_phase(task);
+    if (status != UCC_INPROGRESS) {
+        ucc_tl_shm_task_complete(task, status);
+    }
+}
+
+static ucc_status_t ucc_tl_shm_sync_init(ucc_base_coll_args_t *coll_args,
+                                         ucc_tl_shm_team_t    *team,
+                                         ucc_rank_t            root,
+                                         ucc_coll_progress_fn_t progress,
+                                         ucc_coll_task_t     **task_h)
+{
+    ucc_tl_shm_task_t *task = ucc_tl_shm_get_task(coll_args, team, root);
+
+    if (ucc_unlikely(!task)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->super.progress = progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_shm_barrier_init(ucc_base_coll_args_t *coll_args,
+                                     ucc_tl_shm_team_t    *team,
+                                     ucc_coll_task_t     **task_h)
+{
+    return ucc_tl_shm_sync_init(coll_args, team, 0,
+                                ucc_tl_shm_barrier_progress, task_h);
+}
+
+ucc_status_t ucc_tl_shm_fanin_init(ucc_base_coll_args_t *coll_args,
+                                   ucc_tl_shm_team_t    *team,
+                                   ucc_coll_task_t     **task_h)
+{
+    return ucc_tl_shm_sync_init(coll_args, team,
+                                (ucc_rank_t)coll_args->args.root,
+                                ucc_tl_shm_fanin_progress, task_h);
+}
+
+ucc_status_t ucc_tl_shm_fanout_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_tl_shm_team_t    *team,
+                                    ucc_coll_task_t     **task_h)
+{
+    return ucc_tl_shm_sync_init(coll_args, team,
+                                (ucc_rank_t)coll_args->args.root,
+                                ucc_tl_shm_fanout_progress, task_h);
+}
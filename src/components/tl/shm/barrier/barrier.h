@@ -0,0 +1,25 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef BARRIER_H_
+#define BARRIER_H_
+
+#include "tl_shm.h"
+#include "tl_shm_coll.h"
+
+ucc_status_t ucc_tl_shm_barrier_init(ucc_base_coll_args_t *coll_args,
+                                     ucc_tl_shm_team_t    *team,
+                                     ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_shm_fanin_init(ucc_base_coll_args_t *coll_args,
+                                   ucc_tl_shm_team_t    *team,
+                                   ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_shm_fanout_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_tl_shm_team_t    *team,
+                                    ucc_coll_task_t     **task_h);
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "bcast.h"
+#include "tl_shm_cma.h"
+
+static void ucc_tl_shm_bcast_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_status_t       status;
+
+    if (!ucc_tl_shm_task_is_current(task)) {
+        return;
+    }
+    status = ucc_tl_shm_bcast_phase(task, TASK_ARGS(task).src.info.buffer);
+    if (status != UCC_INPROGRESS) {
+        ucc_tl_shm_task_complete(task, status);
+    }
+}
+
+static ucc_status_t ucc_tl_shm_bcast_cma_xfer(ucc_tl_shm_task_t *task,
+                                              ucc_rank_t         peer,
+                                              ucc_tl_shm_ctrl_t *peer_ctrl)
+{
+    ucc_tl_shm_team_t *team = TASK_TEAM(task);
+
+    if (peer == UCC_TL_TEAM_RANK(team)) {
+        return UCC_OK;
+    }
+    return ucc_tl_shm_cma_read(team, peer_ctrl->pid,
+                               TASK_ARGS(task).src.info.buffer,
+                               peer_ctrl->cma.src, task->data_size);
+}
+
+ucc_status_t ucc_tl_shm_bcast_init(ucc_base_coll_args_t *coll_args,
+                                   ucc_tl_shm_team_t    *team,
+                                   ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args = &coll_args->args;
+    ucc_tl_shm_task_t *task;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    data_size = args->src.info.count * ucc_dt_size(args->src.info.datatype);
+    if (args->src.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (team->cma_enabled &&
+        (data_size > team->data_size ||
+         data_size >= UCC_TL_SHM_TEAM_LIB(team)->cfg.cma_thresh)) {
+        status = ucc_tl_shm_cma_init(coll_args, team, 1,
+                                     ucc_tl_shm_bcast_cma_xfer, &task);
+        if (status != UCC_OK) {
+            return status;
+        }
+        task->data_size    = data_size;
+        task->cma_info.src = (uint64_t)args->src.info.buffer;
+        *task_h            = &task->super;
+        return UCC_OK;
+    }
+    if (data_size > team->data_size) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    task = ucc_tl_shm_get_task(coll_args, team, (ucc_rank_t)args->root);
+    if (ucc_unlikely(!task)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->data_size      = data_size;
+    task->super.progress = ucc_tl_shm_bcast_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -0,0 +1,22 @@
+#
+# Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+
+tl_shm_enabled=n
+CHECK_TLS_REQUIRED(["shm"])
+AS_IF([test "$CHECKED_TL_REQUIRED" = "y"],
+[
+    tl_modules="${tl_modules}:shm"
+    tl_shm_enabled=y
+    AC_CHECK_DECLS([process_vm_readv, process_vm_writev], [], [],
+                   [[#include <sys/uio.h>]])
+    CHECK_NEED_TL_PROFILING(["tl_shm"])
+    AS_IF([test "$TL_PROFILING_REQUIRED" = "y"],
+          [
+            AC_DEFINE([HAVE_PROFILING_TL_SHM], [1], [Enable profiling for TL SHM])
+            prof_modules="${prof_modules}:tl_shm"
+          ], [])
+], [])
+
+AM_CONDITIONAL([TL_SHM_ENABLED], [test "$tl_shm_enabled" = "y"])
+AC_CONFIG_FILES([src/components/tl/shm/Makefile])
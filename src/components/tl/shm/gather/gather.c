@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "gather.h"
+#include "tl_shm_cma.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Non-root ranks push their data into dst of the root, so the copies run in
+   parallel rather than being serialized on the root */
+static ucc_status_t ucc_tl_shm_gather_cma_xfer(ucc_tl_shm_task_t *task,
+                                               ucc_rank_t         peer,
+                                               ucc_tl_shm_ctrl_t *peer_ctrl)
+{
+    ucc_tl_shm_team_t *team = TASK_TEAM(task);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_rank_t         rank = UCC_TL_TEAM_RANK(team);
+
+    if (peer == rank) {
+        if (!UCC_IS_INPLACE(*args)) {
+            memcpy(PTR_OFFSET(args->dst.info.buffer, task->data_size * rank),
+                   args->src.info.buffer, task->data_size);
+        }
+        return UCC_OK;
+    }
+    return ucc_tl_shm_cma_write(team, peer_ctrl->pid,
+                                peer_ctrl->cma.dst + task->data_size * rank,
+                                args->src.info.buffer, task->data_size);
+}
+
+ucc_status_t ucc_tl_shm_gather_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_tl_shm_team_t    *team,
+                                    ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args    = &coll_args->args;
+    int                is_root = UCC_IS_ROOT(*args, UCC_TL_TEAM_RANK(team));
+    ucc_tl_shm_task_t *task;
+    ucc_status_t       status;
+
+    if ((is_root && args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST) ||
+        (!(is_root && UCC_IS_INPLACE(*args)) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_tl_shm_cma_init(coll_args, team, 1,
+                                 ucc_tl_shm_gather_cma_xfer, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    if (is_root) {
+        task->data_size    = args->dst.info.count / UCC_TL_TEAM_SIZE(team) *
+                             ucc_dt_size(args->dst.info.datatype);
+        task->cma_info.dst = (uint64_t)args->dst.info.buffer;
+    } else {
+        task->data_size    = args->src.info.count *
+                             ucc_dt_size(args->src.info.datatype);
+    }
+    *task_h = &task->super;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_shm_gatherv_cma_xfer(ucc_tl_shm_task_t *task,
+                                                ucc_rank_t         peer,
+                                                ucc_tl_shm_ctrl_t *peer_ctrl)
+{
+    ucc_tl_shm_team_t *team = TASK_TEAM(task);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_rank_t         rank = UCC_TL_TEAM_RANK(team);
+    size_t             displ, dt_size;
+    ucc_status_t       status;
+
+    if (peer == rank) {
+        if (!UCC_IS_INPLACE(*args)) {
+            dt_size = ucc_dt_size(args->dst.info_v.datatype);
+            displ   = ucc_coll_args_get_displacement(
+                args, args->dst.info_v.displacements, rank);
+            memcpy(PTR_OFFSET(args->dst.info_v.buffer, displ * dt_size),
+                   args->src.info.buffer,
+                   ucc_coll_args_get_count(args, args->dst.info_v.counts,
+                                           rank) * dt_size);
+        }
+        return UCC_OK;
+    }
+    if (task->data_size == 0) {
+        return UCC_OK;
+    }
+    status = ucc_tl_shm_cma_read_displ(team, peer_ctrl->pid,
+                                       peer_ctrl->cma.displs, rank,
+                                       UCC_COLL_ARGS_DISPL64(args), &displ);
+    if (ucc_unlikely(status != UCC_OK)) {
+        return status;
+    }
+    dt_size = ucc_dt_size(args->src.info.datatype);
+    return ucc_tl_shm_cma_write(team, peer_ctrl->pid,
+                                peer_ctrl->cma.dst + displ * dt_size,
+                                args->src.info.buffer, task->data_size);
+}
+
+ucc_status_t ucc_tl_shm_gatherv_init(ucc_base_coll_args_t *coll_args,
+                                     ucc_tl_shm_team_t    *team,
+                                     ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args    = &coll_args->args;
+    int                is_root = UCC_IS_ROOT(*args, UCC_TL_TEAM_RANK(team));
+    ucc_tl_shm_task_t *task;
+    ucc_status_t       status;
+
+    if ((is_root && args->dst.info_v.mem_type != UCC_MEMORY_TYPE_HOST) ||
+        (!(is_root && UCC_IS_INPLACE(*args)) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_tl_shm_cma_init(coll_args, team, 1,
+                                 ucc_tl_shm_gatherv_cma_xfer, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    if (is_root) {
+        task->cma_info.dst    = (uint64_t)args->dst.info_v.buffer;
+        task->cma_info.displs = (uint64_t)args->dst.info_v.displacements;
+    } else {
+        task->data_size       = args->src.info.count *
+                                ucc_dt_size(args->src.info.datatype);
+    }
+    *task_h = &task->super;
+    return UCC_OK;
+}
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "reduce.h"
+
+static void ucc_tl_shm_reduce_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    void              *src  = args->src.info.buffer;
+    ucc_status_t       status;
+
+    if (!ucc_tl_shm_task_is_current(task)) {
+        return;
+    }
+    if (UCC_IS_INPLACE(*args) && ucc_tl_shm_task_is_root(task)) {
+        src = args->dst.info.buffer;
+    }
+    status = ucc_tl_shm_reduce_phase(task, src, args->dst.info.buffer);
+    if (status != UCC_INPROGRESS) {
+        ucc_tl_shm_task_complete(task, status);
+    }
+}
+
+ucc_status_t ucc_tl_shm_reduce_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_tl_shm_team_t    *team,
+                                    ucc_coll_task_t     **task_h)
+{
+    ucc_coll_args_t   *args    = &coll_args->args;
+    int                is_root = (args->root == UCC_TL_TEAM_RANK(team));
+    ucc_tl_shm_task_t *task;
+    ucc_datatype_t     dt;
+    size_t             count;
+
+    if (!ucc_coll_args_is_predefined_dt(args, UCC_TL_TEAM_RANK(team))) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (is_root) {
+        count = args->dst.info.count;
+        dt    = args->dst.info.datatype;
+        if (args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+    } else {
+        count = args->src.info.count;
+        dt    = args->src.info.datatype;
+    }
+    if ((!UCC_IS_INPLACE(*args) || !is_root) &&
+        args->src.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (count * ucc_dt_size(dt) > team->data_size) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    task = ucc_tl_shm_get_task(coll_args, team, (ucc_rank_t)args->root);
+    if (ucc_unlikely(!task)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->data_size      = count * ucc_dt_size(dt);
+    task->dt             = dt;
+    task->super.progress = ucc_tl_shm_reduce_progress;
+    task->super.flags   |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
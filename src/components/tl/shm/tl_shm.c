@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_shm.h"
+#include "tl_shm_coll.h"
+
+const char *ucc_tl_shm_group_names[] = {
+    [UCC_TL_SHM_GROUP_AUTO]   = "auto",
+    [UCC_TL_SHM_GROUP_SOCKET] = "socket",
+    [UCC_TL_SHM_GROUP_NUMA]   = "numa",
+    [UCC_TL_SHM_GROUP_NONE]   = "none",
+    [UCC_TL_SHM_GROUP_LAST]   = NULL
+};
+
+static ucc_config_field_t ucc_tl_shm_lib_config_table[] = {
+    {"", "", NULL, ucc_offsetof(ucc_tl_shm_lib_config_t, super),
+     UCC_CONFIG_TYPE_TABLE(ucc_tl_lib_config_table)},
+
+    {"DATA_SIZE", "8k",
+     "Size of the per-rank shared memory data slot. Bcast, reduce and "
+     "allreduce with larger messages are not supported",
+     ucc_offsetof(ucc_tl_shm_lib_config_t, data_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"RADIX", "4",
+     "Radix of the knomial trees used by all collectives",
+     ucc_offsetof(ucc_tl_shm_lib_config_t, radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"GROUP", "auto",
+     "Grouping of ranks for the two-level trees.\n"
+     "auto   - socket if processes are bound to sockets, numa otherwise\n"
+     "socket - ranks of a socket form a group\n"
+     "numa   - ranks of a NUMA domain form a group\n"
+     "none   - single level trees",
+     ucc_offsetof(ucc_tl_shm_lib_config_t, group),
+     UCC_CONFIG_TYPE_ENUM(ucc_tl_shm_group_names)},
+
+    {"N_POLLS", "100",
+     "Number of polls of a peer flag in a single progress call",
+     ucc_offsetof(ucc_tl_shm_lib_config_t, n_polls),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"CMA", "try",
+     "Use single-copy collectives based on process_vm_readv/writev.\n"
+     "try - enable if processes are allowed to access each other's memory",
+     ucc_offsetof(ucc_tl_shm_lib_config_t, cma),
+     UCC_CONFIG_TYPE_TERNARY},
+
+    {"CMA_THRESH", "32k",
+     "Minimal message size for single-copy collectives",
+     ucc_offsetof(ucc_tl_shm_lib_config_t, cma_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"DEBUG_ATTACH_FAIL_RANK", "-1",
+     "Debug only: team rank that fails to attach to the shared memory "
+     "segment, -1 - none",
+     ucc_offsetof(ucc_tl_shm_lib_config_t, debug_attach_fail_rank),
+     UCC_CONFIG_TYPE_INT},
+
+    {NULL}};
+
+static ucs_config_field_t ucc_tl_shm_context_config_table[] = {
+    {"", "", NULL, ucc_offsetof(ucc_tl_shm_context_config_t, super),
+     UCC_CONFIG_TYPE_TABLE(ucc_tl_context_config_table)},
+
+    {NULL}};
+
+UCC_CLASS_DEFINE_NEW_FUNC(ucc_tl_shm_lib_t, ucc_base_lib_t,
+                          const ucc_base_lib_params_t *,
+                          const ucc_base_config_t *);
+
+UCC_CLASS_DEFINE_DELETE_FUNC(ucc_tl_shm_lib_t, ucc_base_lib_t);
+
+ucc_status_t ucc_tl_shm_get_lib_attr(const ucc_base_lib_t *lib,
+                                     ucc_base_lib_attr_t  *base_attr);
+
+ucc_status_t ucc_tl_shm_get_lib_properties(ucc_base_lib_properties_t *prop);
+
+UCC_CLASS_DEFINE_NEW_FUNC(ucc_tl_shm_context_t, ucc_base_context_t,
+                          const ucc_base_context_params_t *,
+                          const ucc_base_config_t *);
+
+UCC_CLASS_DEFINE_DELETE_FUNC(ucc_tl_shm_context_t, ucc_base_context_t);
+
+ucc_status_t ucc_tl_shm_get_context_attr(const ucc_base_context_t *context,
+                                         ucc_base_ctx_attr_t      *base_attr);
+
+UCC_CLASS_DEFINE_NEW_FUNC(ucc_tl_shm_team_t, ucc_base_team_t,
+                          ucc_base_context_t *, const ucc_base_team_params_t *);
+
+ucc_status_t ucc_tl_shm_team_create_test(ucc_base_team_t *tl_team);
+
+ucc_status_t ucc_tl_shm_team_destroy(ucc_base_team_t *tl_team);
+
+ucc_status_t ucc_tl_shm_team_get_scores(ucc_base_team_t   *tl_team,
+                                        ucc_coll_score_t **score);
+
+UCC_TL_IFACE_DECLARE(shm, SHM);
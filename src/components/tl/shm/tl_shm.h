@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_TL_SHM_H_
+#define UCC_TL_SHM_H_
+#include "components/tl/ucc_tl.h"
+#include "components/tl/ucc_tl_log.h"
+#include "utils/ucc_mpool.h"
+#include "utils/ucc_math.h"
+#include <sys/types.h>
+
+#ifndef UCC_TL_SHM_DEFAULT_SCORE
+#define UCC_TL_SHM_DEFAULT_SCORE 20
+#endif
+
+#ifdef HAVE_PROFILING_TL_SHM
+#include "utils/profile/ucc_profile.h"
+#else
+#include "utils/profile/ucc_profile_off.h"
+#endif
+
+#define UCC_TL_SHM_PROFILE_FUNC          UCC_PROFILE_FUNC
+#define UCC_TL_SHM_PROFILE_FUNC_VOID     UCC_PROFILE_FUNC_VOID
+#define UCC_TL_SHM_PROFILE_REQUEST_NEW   UCC_PROFILE_REQUEST_NEW
+#define UCC_TL_SHM_PROFILE_REQUEST_EVENT UCC_PROFILE_REQUEST_EVENT
+#define UCC_TL_SHM_PROFILE_REQUEST_FREE  UCC_PROFILE_REQUEST_FREE
+
+typedef struct ucc_tl_shm_iface {
+    ucc_tl_iface_t super;
+} ucc_tl_shm_iface_t;
+/* Extern iface should follow the pattern: ucc_tl_<tl_name> */
+extern ucc_tl_shm_iface_t ucc_tl_shm;
+
+typedef enum ucc_tl_shm_group_type {
+    UCC_TL_SHM_GROUP_AUTO,
+    UCC_TL_SHM_GROUP_SOCKET,
+    UCC_TL_SHM_GROUP_NUMA,
+    UCC_TL_SHM_GROUP_NONE,
+    UCC_TL_SHM_GROUP_LAST
+} ucc_tl_shm_group_type_t;
+
+extern const char *ucc_tl_shm_group_names[];
+
+typedef struct ucc_tl_shm_lib_config {
+    ucc_tl_lib_config_t      super;
+    size_t                   data_size;
+    uint32_t                 radix;
+    ucc_tl_shm_group_type_t  group;
+    uint32_t                 n_polls;
+    ucc_ternary_auto_value_t cma;
+    size_t                   cma_thresh;
+    int                      debug_attach_fail_rank;
+} ucc_tl_shm_lib_config_t;
+
+typedef struct ucc_tl_shm_context_config {
+    ucc_tl_context_config_t super;
+} ucc_tl_shm_context_config_t;
+
+typedef struct ucc_tl_shm_lib {
+    ucc_tl_lib_t            super;
+    ucc_tl_shm_lib_config_t cfg;
+} ucc_tl_shm_lib_t;
+UCC_CLASS_DECLARE(ucc_tl_shm_lib_t, const ucc_base_lib_params_t *,
+                  const ucc_base_config_t *);
+
+typedef struct ucc_tl_shm_context {
+    ucc_tl_context_t            super;
+    ucc_tl_shm_context_config_t cfg;
+    ucc_mpool_t                 req_mp;
+} ucc_tl_shm_context_t;
+UCC_CLASS_DECLARE(ucc_tl_shm_context_t, const ucc_base_context_params_t *,
+                  const ucc_base_config_t *);
+
+/* Sync flags of a rank. Every flag is written by its owner only and holds
+   the sequence number of the last collective that reached the corresponding
+   point:
+   ARRIVE  - fanin is done: children data has been consumed and own data
+             (if any) is available in the up slot
+   RELEASE - fanout is done: parent data has been consumed and own data
+             (if any) is available in the down slot
+   POST    - buffer addresses of a CMA collective are published
+   DONE    - CMA transfers of the rank are done */
+typedef enum ucc_tl_shm_flag {
+    UCC_TL_SHM_FLAG_ARRIVE,
+    UCC_TL_SHM_FLAG_RELEASE,
+    UCC_TL_SHM_FLAG_POST,
+    UCC_TL_SHM_FLAG_DONE,
+    UCC_TL_SHM_FLAG_LAST
+} ucc_tl_shm_flag_t;
+
+/* Buffers of the current CMA collective in the address space of the owner */
+typedef struct ucc_tl_shm_cma_info {
+    uint64_t src;
+    uint64_t dst;
+    uint64_t displs; /* displacements array of vector collectives */
+} ucc_tl_shm_cma_info_t;
+
+typedef struct ucc_tl_shm_ctrl {
+    volatile uint32_t     flag[UCC_TL_SHM_FLAG_LAST];
+    pid_t                 pid;
+    volatile int32_t      cma_ok;
+    uint64_t              cma_probe;
+    ucc_tl_shm_cma_info_t cma;
+} ucc_tl_shm_ctrl_t;
+
+#define UCC_TL_SHM_CTRL_SIZE                                                   \
+    ucc_align_up(sizeof(ucc_tl_shm_ctrl_t), UCC_CACHE_LINE_SIZE)
+
+typedef struct ucc_tl_shm_seg_header {
+    volatile uint32_t n_probed;
+} ucc_tl_shm_seg_header_t;
+
+/* Stages of team creation */
+typedef enum ucc_tl_shm_team_state {
+    UCC_TL_SHM_TEAM_STATE_SHM_ID, /* allgather of segment id */
+    UCC_TL_SHM_TEAM_STATE_ATTACH, /* allgather of attach status */
+    UCC_TL_SHM_TEAM_STATE_PROBE,  /* CMA probe in the segment */
+    UCC_TL_SHM_TEAM_STATE_READY
+} ucc_tl_shm_team_state_t;
+
+/* Flattened two-level tree of the calling rank for a given root: knomial
+   tree over group leaders on top of knomial trees inside every group */
+typedef struct ucc_tl_shm_tree {
+    ucc_rank_t  parent;     /* UCC_RANK_INVALID for root */
+    ucc_rank_t  n_children;
+    ucc_rank_t *children;
+    void      **srcs;       /* reduction sources: own data + children slots */
+} ucc_tl_shm_tree_t;
+
+typedef struct ucc_tl_shm_team {
+    ucc_tl_team_t            super;
+    ucc_team_oob_coll_t      oob;
+    void                    *oob_req;
+    ucc_tl_shm_team_state_t  state;
+    int                     *shm_ids;    /* segment id, then attach status */
+    void                    *seg;
+    size_t                   data_size;
+    ucc_rank_t              *group;      /* group id of every rank */
+    ucc_tl_shm_tree_t      **trees;      /* per root, built on first use */
+    uint32_t                 seq_num;    /* last posted collective */
+    uint32_t                 seq_done;   /* last completed collective */
+    /* last readers of own slots, a slot can only be rewritten when its
+       readers are done with the previous contents */
+    ucc_rank_t               up_reader;
+    uint32_t                 up_seq;
+    ucc_tl_shm_tree_t       *down_readers;
+    uint32_t                 down_seq;
+    int                      cma_enabled;
+    uint64_t                 cma_probe;  /* read by peers to check CMA */
+    ucc_rank_t              *peers;      /* all ranks but self */
+} ucc_tl_shm_team_t;
+UCC_CLASS_DECLARE(ucc_tl_shm_team_t, ucc_base_context_t *,
+                  const ucc_base_team_params_t *);
+
+/* Collectives going through the shared memory segment */
+#define UCC_TL_SHM_SLOT_COLLS                                                  \
+    (UCC_COLL_TYPE_BARRIER | UCC_COLL_TYPE_FANIN | UCC_COLL_TYPE_FANOUT |      \
+     UCC_COLL_TYPE_BCAST | UCC_COLL_TYPE_REDUCE | UCC_COLL_TYPE_ALLREDUCE)
+
+/* Collectives limited by the slot size */
+#define UCC_TL_SHM_DATA_COLLS                                                  \
+    (UCC_COLL_TYPE_BCAST | UCC_COLL_TYPE_REDUCE | UCC_COLL_TYPE_ALLREDUCE)
+
+/* Single-copy collectives, available if processes may access each other's
+   memory with process_vm_readv/writev */
+#define UCC_TL_SHM_CMA_COLLS                                                   \
+    (UCC_COLL_TYPE_BCAST | UCC_COLL_TYPE_ALLGATHER |                           \
+     UCC_COLL_TYPE_ALLGATHERV | UCC_COLL_TYPE_GATHER |                         \
+     UCC_COLL_TYPE_GATHERV | UCC_COLL_TYPE_SCATTER | UCC_COLL_TYPE_SCATTERV |  \
+     UCC_COLL_TYPE_ALLTOALL | UCC_COLL_TYPE_ALLTOALLV)
+
+#define UCC_TL_SHM_SUPPORTED_COLLS                                             \
+    (UCC_TL_SHM_SLOT_COLLS | UCC_TL_SHM_CMA_COLLS)
+
+#define UCC_TL_SHM_TEAM_LIB(_team)                                             \
+    (ucc_derived_of((_team)->super.super.context->lib, ucc_tl_shm_lib_t))
+
+#define UCC_TL_SHM_TEAM_CTX(_team)                                             \
+    (ucc_derived_of((_team)->super.super.context, ucc_tl_shm_context_t))
+
+/* Segment layout: header, per-rank ctrl, per-rank up slots, per-rank down
+   slots. Every ctrl and slot starts on its own cache line. */
+#define UCC_TL_SHM_CTRL(_team, _rank)                                          \
+    ((ucc_tl_shm_ctrl_t *)PTR_OFFSET((_team)->seg,                             \
+                                     UCC_CACHE_LINE_SIZE +                     \
+                                     UCC_TL_SHM_CTRL_SIZE * (_rank)))
+
+#define UCC_TL_SHM_UP_SLOT(_team, _rank)                                       \
+    PTR_OFFSET((_team)->seg,                                                   \
+               UCC_CACHE_LINE_SIZE +                                           \
+               UCC_TL_SHM_CTRL_SIZE * UCC_TL_TEAM_SIZE(_team) +                \
+               (_team)->data_size * (_rank))
+
+#define UCC_TL_SHM_DOWN_SLOT(_team, _rank)                                     \
+    UCC_TL_SHM_UP_SLOT(_team, UCC_TL_TEAM_SIZE(_team) + (_rank))
+
+ucc_status_t ucc_tl_shm_team_get_tree(ucc_tl_shm_team_t *team,
+                                      ucc_rank_t root,
+                                      ucc_tl_shm_tree_t **tree);
+
+#endif
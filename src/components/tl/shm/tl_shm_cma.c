@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_shm_cma.h"
+#include <sys/uio.h>
+#include <errno.h>
+
+#if HAVE_DECL_PROCESS_VM_READV && HAVE_DECL_PROCESS_VM_WRITEV
+
+/* The kernel may transfer less than requested, repeat until done */
+static ucc_status_t ucc_tl_shm_cma_xfer(ucc_tl_shm_team_t *team, pid_t pid,
+                                        void *local, uint64_t remote,
+                                        size_t len, int is_write)
+{
+    struct iovec liov, riov;
+    ssize_t      ret;
+
+    while (len > 0) {
+        liov.iov_base = local;
+        liov.iov_len  = len;
+        riov.iov_base = (void *)remote;
+        riov.iov_len  = len;
+        ret = is_write ? process_vm_writev(pid, &liov, 1, &riov, 1, 0)
+                       : process_vm_readv(pid, &liov, 1, &riov, 1, 0);
+        if (ucc_unlikely(ret <= 0)) {
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "process_vm_%s of %zd bytes from pid %d failed: %s",
+                     is_write ? "writev" : "readv", len, (int)pid,
+                     (ret < 0) ? strerror(errno) : "no progress");
+            return UCC_ERR_NO_MESSAGE;
+        }
+        local   = PTR_OFFSET(local, ret);
+        remote += ret;
+        len    -= ret;
+    }
+    return UCC_OK;
+}
+
+int ucc_tl_shm_cma_check(ucc_tl_shm_team_t *team)
+{
+    ucc_rank_t         size = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         rank = UCC_TL_TEAM_RANK(team);
+    ucc_tl_shm_ctrl_t *ctrl;
+    struct iovec       liov, riov;
+    uint64_t           probe;
+    ucc_rank_t         r;
+
+    for (r = 0; r < size; r++) {
+        if (r == rank) {
+            continue;
+        }
+        ctrl          = UCC_TL_SHM_CTRL(team, r);
+        liov.iov_base = &probe;
+        liov.iov_len  = sizeof(probe);
+        riov.iov_base = (void *)ctrl->cma_probe;
+        riov.iov_len  = sizeof(probe);
+        /* probe word holds the pid of its owner */
+        if (process_vm_readv(ctrl->pid, &liov, 1, &riov, 1, 0) !=
+                sizeof(probe) || probe != (uint64_t)ctrl->pid) {
+            tl_debug(UCC_TL_TEAM_LIB(team), "CMA access to pid %d is not "
+                     "permitted: %s", (int)ctrl->pid, strerror(errno));
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#else
+
+static ucc_status_t ucc_tl_shm_cma_xfer(ucc_tl_shm_team_t *team, /* NOLINT */
+                                        pid_t pid, void *local,  /* NOLINT */
+                                        uint64_t remote, size_t len, /* NOLINT */
+                                        int is_write) /* NOLINT */
+{
+    return UCC_ERR_NOT_SUPPORTED;
+}
+
+int ucc_tl_shm_cma_check(ucc_tl_shm_team_t *team)
+{
+    tl_debug(UCC_TL_TEAM_LIB(team), "CMA is not supported by the system");
+    return 0;
+}
+
+#endif
+
+ucc_status_t ucc_tl_shm_cma_read(ucc_tl_shm_team_t *team, pid_t pid,
+                                 void *dst, uint64_t src, size_t len)
+{
+    return ucc_tl_shm_cma_xfer(team, pid, dst, src, len, 0);
+}
+
+ucc_status_t ucc_tl_shm_cma_write(ucc_tl_shm_team_t *team, pid_t pid,
+                                  uint64_t dst, const void *src, size_t len)
+{
+    return ucc_tl_shm_cma_xfer(team, pid, (void *)src, dst, len, 1);
+}
+
+ucc_status_t ucc_tl_shm_cma_read_displ(ucc_tl_shm_team_t *team, pid_t pid,
+                                       uint64_t displs, ucc_rank_t idx,
+                                       int is64, size_t *displ)
+{
+    uint64_t     d64;
+    uint32_t     d32;
+    ucc_status_t status;
+
+    if (is64) {
+        status = ucc_tl_shm_cma_read(team, pid, &d64,
+                                     displs + idx * sizeof(d64), sizeof(d64));
+        *displ = d64;
+    } else {
+        status = ucc_tl_shm_cma_read(team, pid, &d32,
+                                     displs + idx * sizeof(d32), sizeof(d32));
+        *displ = d32;
+    }
+    return status;
+}
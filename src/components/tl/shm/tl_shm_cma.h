@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_TL_SHM_CMA_H_
+#define UCC_TL_SHM_CMA_H_
+
+#include "tl_shm.h"
+
+/* Checks that the calling process can read memory of every other rank of the
+   team, pids and probe addresses of all ranks must be published already */
+int ucc_tl_shm_cma_check(ucc_tl_shm_team_t *team);
+
+/* Copies len bytes from address "src" of process "pid" to local "dst" */
+ucc_status_t ucc_tl_shm_cma_read(ucc_tl_shm_team_t *team, pid_t pid,
+                                 void *dst, uint64_t src, size_t len);
+
+/* Copies len bytes from local "src" to address "dst" of process "pid" */
+ucc_status_t ucc_tl_shm_cma_write(ucc_tl_shm_team_t *team, pid_t pid,
+                                  uint64_t dst, const void *src, size_t len);
+
+/* Reads element "idx" of the displacements array "displs" of process "pid" */
+ucc_status_t ucc_tl_shm_cma_read_displ(ucc_tl_shm_team_t *team, pid_t pid,
+                                       uint64_t displs, ucc_rank_t idx,
+                                       int is64, size_t *displ);
+
+#endif
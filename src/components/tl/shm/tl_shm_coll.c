@@ -0,0 +1,431 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_shm_coll.h"
+#include "barrier/barrier.h"
+#include "bcast/bcast.h"
+#include "reduce/reduce.h"
+#include "allreduce/allreduce.h"
+#include "allgather/allgather.h"
+#include "alltoall/alltoall.h"
+#include "gather/gather.h"
+#include "scatter/scatter.h"
+
+enum {
+    UCC_TL_SHM_STAGE_WAIT_SLOT,
+    UCC_TL_SHM_STAGE_WAIT_PEERS,
+    UCC_TL_SHM_STAGE_EXEC,
+    UCC_TL_SHM_STAGE_EXEC_WAIT
+};
+
+static inline int ucc_tl_shm_seq_reached(uint32_t flag, uint32_t seq)
+{
+    return (int32_t)(flag - seq) >= 0;
+}
+
+/* Polls "flag" of the given ranks until all of them reach "seq", progress is
+   kept in task->n_ready so that ranks already seen are not polled again */
+static inline int ucc_tl_shm_test_flags(ucc_tl_shm_task_t *task,
+                                        const ucc_rank_t  *ranks,
+                                        ucc_rank_t         n_ranks,
+                                        ucc_tl_shm_flag_t  flag,
+                                        uint32_t           seq)
+{
+    ucc_tl_shm_team_t *team    = TASK_TEAM(task);
+    uint32_t           n_polls = UCC_TL_SHM_TEAM_LIB(team)->cfg.n_polls;
+    uint32_t           i;
+
+    while (task->n_ready < n_ranks) {
+        for (i = 0; i < n_polls; i++) {
+            if (ucc_tl_shm_seq_reached(
+                    UCC_TL_SHM_CTRL(team, ranks[task->n_ready])->flag[flag],
+                    seq)) {
+                break;
+            }
+        }
+        if (i == n_polls) {
+            return 0;
+        }
+        task->n_ready++;
+    }
+    task->n_ready = 0;
+    /* peer data must not be read ahead of the flag */
+    ucc_memory_cpu_load_fence();
+    return 1;
+}
+
+static inline void ucc_tl_shm_set_flag(ucc_tl_shm_task_t *task,
+                                       ucc_tl_shm_flag_t  flag)
+{
+    ucc_tl_shm_team_t *team = TASK_TEAM(task);
+
+    ucc_memory_cpu_store_fence();
+    UCC_TL_SHM_CTRL(team, UCC_TL_TEAM_RANK(team))->flag[flag] = task->seq;
+}
+
+ucc_status_t ucc_tl_shm_fanin_phase(ucc_tl_shm_task_t *task)
+{
+    ucc_tl_shm_tree_t *tree = task->tree;
+
+    if (!ucc_tl_shm_test_flags(task, tree->children, tree->n_children,
+                               UCC_TL_SHM_FLAG_ARRIVE, task->seq)) {
+        return UCC_INPROGRESS;
+    }
+    ucc_tl_shm_set_flag(task, UCC_TL_SHM_FLAG_ARRIVE);
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_shm_fanout_phase(ucc_tl_shm_task_t *task)
+{
+    ucc_tl_shm_tree_t *tree = task->tree;
+
+    if (!ucc_tl_shm_task_is_root(task) &&
+        !ucc_tl_shm_test_flags(task, &tree->parent, 1,
+                               UCC_TL_SHM_FLAG_RELEASE, task->seq)) {
+        return UCC_INPROGRESS;
+    }
+    ucc_tl_shm_set_flag(task, UCC_TL_SHM_FLAG_RELEASE);
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_shm_reduce_phase(ucc_tl_shm_task_t *task, void *src,
+                                     void *dst)
+{
+    ucc_tl_shm_team_t          *team    = TASK_TEAM(task);
+    ucc_coll_args_t            *args    = &TASK_ARGS(task);
+    ucc_tl_shm_tree_t          *tree    = task->tree;
+    int                         is_root = ucc_tl_shm_task_is_root(task);
+    ucc_ee_executor_task_args_t eargs   = {0};
+    void                       *rbuf;
+    ucc_status_t                status;
+
+    rbuf = is_root ? dst : UCC_TL_SHM_UP_SLOT(team, UCC_TL_TEAM_RANK(team));
+    switch (task->stage) {
+    case UCC_TL_SHM_STAGE_WAIT_SLOT:
+        if (!is_root && team->up_seq &&
+            !ucc_tl_shm_test_flags(task, &team->up_reader, 1,
+                                   UCC_TL_SHM_FLAG_ARRIVE, team->up_seq)) {
+            return UCC_INPROGRESS;
+        }
+        task->stage = UCC_TL_SHM_STAGE_WAIT_PEERS;
+        /* fall through */
+    case UCC_TL_SHM_STAGE_WAIT_PEERS:
+        if (!ucc_tl_shm_test_flags(task, tree->children, tree->n_children,
+                                   UCC_TL_SHM_FLAG_ARRIVE, task->seq)) {
+            return UCC_INPROGRESS;
+        }
+        task->stage = UCC_TL_SHM_STAGE_EXEC;
+        /* fall through */
+    case UCC_TL_SHM_STAGE_EXEC:
+        if (tree->n_children == 0 || task->data_size == 0) {
+            if (src != rbuf) {
+                memcpy(rbuf, src, task->data_size);
+            }
+            break;
+        }
+        tree->srcs[0]         = src;
+        eargs.task_type       = UCC_EE_EXECUTOR_TASK_REDUCE;
+        eargs.flags           = UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT;
+        eargs.reduce.dst      = rbuf;
+        eargs.reduce.srcs_ext = tree->srcs;
+        eargs.reduce.n_srcs   = tree->n_children + 1;
+        eargs.reduce.count    = task->data_size / ucc_dt_size(task->dt);
+        eargs.reduce.dt       = task->dt;
+        eargs.reduce.op       = args->op;
+        if (is_root && args->op == UCC_OP_AVG) {
+            eargs.flags       |= UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA;
+            eargs.reduce.alpha = 1.0 / (double)UCC_TL_TEAM_SIZE(team);
+        }
+        status = ucc_ee_executor_task_post(task->executor, &eargs,
+                                           &task->etask);
+        if (ucc_unlikely(status != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to post reduction");
+            return status;
+        }
+        task->stage = UCC_TL_SHM_STAGE_EXEC_WAIT;
+        /* fall through */
+    case UCC_TL_SHM_STAGE_EXEC_WAIT:
+        status = ucc_ee_executor_task_test(task->etask);
+        if (status == UCC_INPROGRESS || status == UCC_OPERATION_INITIALIZED) {
+            return UCC_INPROGRESS;
+        }
+        ucc_ee_executor_task_finalize(task->etask);
+        task->etask = NULL;
+        if (ucc_unlikely(status != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "reduction failed");
+            return status;
+        }
+        break;
+    }
+    if (!is_root) {
+        team->up_reader = tree->parent;
+        team->up_seq    = task->seq;
+    }
+    task->stage = UCC_TL_SHM_STAGE_WAIT_SLOT;
+    ucc_tl_shm_set_flag(task, UCC_TL_SHM_FLAG_ARRIVE);
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_shm_bcast_phase(ucc_tl_shm_task_t *task, void *buf)
+{
+    ucc_tl_shm_team_t *team    = TASK_TEAM(task);
+    ucc_tl_shm_tree_t *tree    = task->tree;
+    ucc_tl_shm_tree_t *readers = team->down_readers;
+    int                is_root = ucc_tl_shm_task_is_root(task);
+    void              *slot    = UCC_TL_SHM_DOWN_SLOT(team,
+                                                      UCC_TL_TEAM_RANK(team));
+
+    switch (task->stage) {
+    case UCC_TL_SHM_STAGE_WAIT_SLOT:
+        if (tree->n_children > 0 && readers &&
+            !ucc_tl_shm_test_flags(task, readers->children,
+                                   readers->n_children,
+                                   UCC_TL_SHM_FLAG_RELEASE, team->down_seq)) {
+            return UCC_INPROGRESS;
+        }
+        task->stage = UCC_TL_SHM_STAGE_WAIT_PEERS;
+        /* fall through */
+    case UCC_TL_SHM_STAGE_WAIT_PEERS:
+        if (!is_root &&
+            !ucc_tl_shm_test_flags(task, &tree->parent, 1,
+                                   UCC_TL_SHM_FLAG_RELEASE, task->seq)) {
+            return UCC_INPROGRESS;
+        }
+        break;
+    }
+    if (is_root) {
+        if (tree->n_children > 0) {
+            memcpy(slot, buf, task->data_size);
+        }
+    } else if (tree->n_children > 0) {
+        memcpy(slot, UCC_TL_SHM_DOWN_SLOT(team, tree->parent),
+               task->data_size);
+        memcpy(buf, slot, task->data_size);
+    } else {
+        memcpy(buf, UCC_TL_SHM_DOWN_SLOT(team, tree->parent),
+               task->data_size);
+    }
+    if (tree->n_children > 0) {
+        team->down_readers = tree;
+        team->down_seq     = task->seq;
+    }
+    task->stage = UCC_TL_SHM_STAGE_WAIT_SLOT;
+    ucc_tl_shm_set_flag(task, UCC_TL_SHM_FLAG_RELEASE);
+    return UCC_OK;
+}
+
+enum {
+    UCC_TL_SHM_CMA_STAGE_POST,
+    UCC_TL_SHM_CMA_STAGE_WAIT_POST,
+    UCC_TL_SHM_CMA_STAGE_WAIT_DONE
+};
+
+static void ucc_tl_shm_cma_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task    = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_tl_shm_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         rank    = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         n_peers = UCC_TL_TEAM_SIZE(team) - 1;
+    ucc_rank_t         root    = (ucc_rank_t)TASK_ARGS(task).root;
+    int                is_root = task->cma_rooted && rank == root;
+    ucc_rank_t         peer, i;
+    ucc_status_t       status;
+
+    if (!ucc_tl_shm_task_is_current(task)) {
+        return;
+    }
+    switch (task->stage) {
+    case UCC_TL_SHM_CMA_STAGE_POST:
+        /* own info is not in use: peers which read it for the previous
+           collective have already reported DONE */
+        UCC_TL_SHM_CTRL(team, rank)->cma = task->cma_info;
+        ucc_tl_shm_set_flag(task, UCC_TL_SHM_FLAG_POST);
+        /* local part is copied while peers are catching up */
+        task->cma_status = (is_root || !task->cma_rooted)
+            ? task->cma_xfer(task, rank, UCC_TL_SHM_CTRL(team, rank))
+            : UCC_OK;
+        task->stage      = UCC_TL_SHM_CMA_STAGE_WAIT_POST;
+        /* fall through */
+    case UCC_TL_SHM_CMA_STAGE_WAIT_POST:
+        if (task->cma_rooted) {
+            if (!is_root &&
+                !ucc_tl_shm_test_flags(task, &root, 1, UCC_TL_SHM_FLAG_POST,
+                                       task->seq)) {
+                return;
+            }
+            if (!is_root) {
+                status = task->cma_xfer(task, root,
+                                        UCC_TL_SHM_CTRL(team, root));
+                if (ucc_unlikely(status != UCC_OK)) {
+                    task->cma_status = status;
+                }
+            }
+        } else {
+            if (!ucc_tl_shm_test_flags(task, team->peers, n_peers,
+                                       UCC_TL_SHM_FLAG_POST, task->seq)) {
+                return;
+            }
+            /* start from the next rank so that peers are not accessed by
+               everybody at once */
+            for (i = 0; i < n_peers; i++) {
+                peer   = team->peers[(rank + i) % n_peers];
+                status = task->cma_xfer(task, peer,
+                                        UCC_TL_SHM_CTRL(team, peer));
+                if (ucc_unlikely(status != UCC_OK)) {
+                    task->cma_status = status;
+                    break;
+                }
+            }
+        }
+        /* DONE is reported on error too, otherwise peers would hang */
+        ucc_tl_shm_set_flag(task, UCC_TL_SHM_FLAG_DONE);
+        task->stage = UCC_TL_SHM_CMA_STAGE_WAIT_DONE;
+        /* fall through */
+    case UCC_TL_SHM_CMA_STAGE_WAIT_DONE:
+        if ((is_root || !task->cma_rooted) &&
+            !ucc_tl_shm_test_flags(task, team->peers, n_peers,
+                                   UCC_TL_SHM_FLAG_DONE, task->seq)) {
+            return;
+        }
+        break;
+    }
+    ucc_tl_shm_task_complete(task, task->cma_status);
+}
+
+ucc_status_t ucc_tl_shm_cma_init(ucc_base_coll_args_t    *coll_args,
+                                 ucc_tl_shm_team_t       *team,
+                                 int                      rooted,
+                                 ucc_tl_shm_cma_xfer_fn_t xfer,
+                                 ucc_tl_shm_task_t      **task_p)
+{
+    ucc_tl_shm_task_t *task;
+
+    if (!team->cma_enabled || UCC_COLL_ARGS_ACTIVE_SET(&coll_args->args)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    task = ucc_tl_shm_get_task(coll_args, team,
+                               rooted ? (ucc_rank_t)coll_args->args.root : 0);
+    if (ucc_unlikely(!task)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    memset(&task->cma_info, 0, sizeof(task->cma_info));
+    task->cma_rooted     = rooted;
+    task->cma_xfer       = xfer;
+    task->super.progress = ucc_tl_shm_cma_progress;
+    *task_p              = task;
+    return UCC_OK;
+}
+
+ucc_tl_shm_task_t *ucc_tl_shm_get_task(ucc_base_coll_args_t *coll_args,
+                                       ucc_tl_shm_team_t    *team,
+                                       ucc_rank_t            root)
+{
+    ucc_tl_shm_context_t *ctx  = UCC_TL_SHM_TEAM_CTX(team);
+    ucc_tl_shm_task_t    *task = ucc_mpool_get(&ctx->req_mp);
+    ucc_status_t          status;
+
+    if (ucc_unlikely(!task)) {
+        return NULL;
+    }
+    status = ucc_tl_shm_team_get_tree(team, root, &task->tree);
+    if (ucc_unlikely(status != UCC_OK)) {
+        ucc_mpool_put(task);
+        return NULL;
+    }
+    ucc_coll_task_init(&task->super, coll_args, &team->super.super);
+    UCC_TL_SHM_PROFILE_REQUEST_NEW(task, "tl_shm_task", 0);
+    task->super.finalize = ucc_tl_shm_coll_finalize;
+    task->super.post     = ucc_tl_shm_coll_start;
+    task->data_size      = 0;
+    task->dt             = UCC_DT_INT8;
+    task->executor       = NULL;
+    task->etask          = NULL;
+    return task;
+}
+
+void ucc_tl_shm_put_task(ucc_tl_shm_task_t *task)
+{
+    UCC_TL_SHM_PROFILE_REQUEST_FREE(task);
+    ucc_mpool_put(task);
+}
+
+ucc_status_t ucc_tl_shm_coll_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+
+    tl_trace(UCC_TASK_LIB(task), "finalizing task %p", task);
+    ucc_tl_shm_put_task(task);
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_shm_coll_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_shm_task_t *task = ucc_derived_of(coll_task, ucc_tl_shm_task_t);
+    ucc_tl_shm_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    UCC_TL_SHM_PROFILE_REQUEST_EVENT(coll_task, "shm_coll_start", 0);
+    if (task->super.flags & UCC_COLL_TASK_FLAG_EXECUTOR) {
+        status = ucc_coll_task_get_executor(&task->super, &task->executor);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+    }
+    task->seq          = ++team->seq_num;
+    task->phase        = 0;
+    task->stage        = 0;
+    task->n_ready      = 0;
+    task->super.status = UCC_INPROGRESS;
+
+    /* small collectives often complete right away */
+    coll_task->progress(coll_task);
+    if (task->super.status != UCC_INPROGRESS) {
+        return ucc_task_complete(coll_task);
+    }
+    return ucc_progress_queue_enqueue(UCC_TASK_CORE_CTX(coll_task)->pq,
+                                      coll_task);
+}
+
+ucc_status_t ucc_tl_shm_coll_init(ucc_base_coll_args_t *coll_args,
+                                  ucc_base_team_t      *team,
+                                  ucc_coll_task_t     **task_h)
+{
+    ucc_tl_shm_team_t *tl_team = ucc_derived_of(team, ucc_tl_shm_team_t);
+
+    switch (coll_args->args.coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+        return ucc_tl_shm_barrier_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_FANIN:
+        return ucc_tl_shm_fanin_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_FANOUT:
+        return ucc_tl_shm_fanout_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_BCAST:
+        return ucc_tl_shm_bcast_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_REDUCE:
+        return ucc_tl_shm_reduce_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_ALLREDUCE:
+        return ucc_tl_shm_allreduce_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_ALLGATHER:
+        return ucc_tl_shm_allgather_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_ALLGATHERV:
+        return ucc_tl_shm_allgatherv_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_ALLTOALL:
+        return ucc_tl_shm_alltoall_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_ALLTOALLV:
+        return ucc_tl_shm_alltoallv_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_GATHER:
+        return ucc_tl_shm_gather_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_GATHERV:
+        return ucc_tl_shm_gatherv_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_SCATTER:
+        return ucc_tl_shm_scatter_init(coll_args, tl_team, task_h);
+    case UCC_COLL_TYPE_SCATTERV:
+        return ucc_tl_shm_scatterv_init(coll_args, tl_team, task_h);
+    default:
+        break;
+    }
+    return UCC_ERR_NOT_SUPPORTED;
+}
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_TL_SHM_COLL_H_
+#define UCC_TL_SHM_COLL_H_
+
+#include "tl_shm.h"
+#include "components/ec/ucc_ec.h"
+#include "utils/arch/cpu.h"
+
+typedef struct ucc_tl_shm_task ucc_tl_shm_task_t;
+
+/* Single-copy transfer between the calling rank and "peer" whose buffers are
+   described by peer_ctrl->cma. Also called with own rank for the local part
+   of the collective. */
+typedef ucc_status_t (*ucc_tl_shm_cma_xfer_fn_t)(ucc_tl_shm_task_t *task,
+                                                ucc_rank_t         peer,
+                                                ucc_tl_shm_ctrl_t *peer_ctrl);
+
+struct ucc_tl_shm_task {
+    ucc_coll_task_t          super;
+    ucc_tl_shm_tree_t       *tree;
+    uint32_t                 seq;
+    int                      phase;   /* sub-collective of a composite coll */
+    int                      stage;   /* step within the current phase */
+    ucc_rank_t               n_ready; /* peers already seen at the seq */
+    size_t                   data_size;
+    ucc_datatype_t           dt;      /* reduction datatype */
+    ucc_ee_executor_t       *executor;
+    ucc_ee_executor_task_t  *etask;
+    /* CMA collectives */
+    int                      cma_rooted;
+    ucc_tl_shm_cma_info_t    cma_info; /* own buffers published to peers */
+    ucc_tl_shm_cma_xfer_fn_t cma_xfer;
+    ucc_status_t             cma_status;
+};
+
+#define TASK_TEAM(_task)                                                       \
+    (ucc_derived_of((_task)->super.team, ucc_tl_shm_team_t))
+#define TASK_ARGS(_task) (_task)->super.bargs.args
+
+ucc_status_t ucc_tl_shm_coll_init(ucc_base_coll_args_t *coll_args,
+                                  ucc_base_team_t      *team,
+                                  ucc_coll_task_t     **task_h);
+
+ucc_tl_shm_task_t *ucc_tl_shm_get_task(ucc_base_coll_args_t *coll_args,
+                                       ucc_tl_shm_team_t    *team,
+                                       ucc_rank_t            root);
+
+void ucc_tl_shm_put_task(ucc_tl_shm_task_t *task);
+
+ucc_status_t ucc_tl_shm_coll_start(ucc_coll_task_t *coll_task);
+
+ucc_status_t ucc_tl_shm_coll_finalize(ucc_coll_task_t *coll_task);
+
+/* Phases shared by the collectives. Every phase returns UCC_OK once it is
+   done, UCC_INPROGRESS if it has to be called again or an error. */
+ucc_status_t ucc_tl_shm_fanin_phase(ucc_tl_shm_task_t *task);
+
+ucc_status_t ucc_tl_shm_fanout_phase(ucc_tl_shm_task_t *task);
+
+/* Reduces src of all ranks into dst of the tree root */
+ucc_status_t ucc_tl_shm_reduce_phase(ucc_tl_shm_task_t *task, void *src,
+                                     void *dst);
+
+/* Copies buf of the tree root into buf of all ranks */
+ucc_status_t ucc_tl_shm_bcast_phase(ucc_tl_shm_task_t *task, void *buf);
+
+/* Single-copy collective: every rank publishes its buffers, then calls
+   cma_xfer for the root (rooted collectives, non-root ranks only) or for all
+   other ranks. A rank completes once the peers accessing its buffers are
+   done. */
+ucc_status_t ucc_tl_shm_cma_init(ucc_base_coll_args_t    *coll_args,
+                                 ucc_tl_shm_team_t       *team,
+                                 int                      rooted,
+                                 ucc_tl_shm_cma_xfer_fn_t xfer,
+                                 ucc_tl_shm_task_t      **task_p);
+
+/* Collectives of a team run one at a time in posting order: a task does not
+   touch the segment before the previous one has completed locally */
+static inline int ucc_tl_shm_task_is_current(ucc_tl_shm_task_t *task)
+{
+    return TASK_TEAM(task)->seq_done + 1 == task->seq;
+}
+
+static inline void ucc_tl_shm_task_complete(ucc_tl_shm_task_t *task,
+                                            ucc_status_t       status)
+{
+    TASK_TEAM(task)->seq_done = task->seq;
+    task->super.status        = status;
+}
+
+static inline int ucc_tl_shm_task_is_root(ucc_tl_shm_task_t *task)
+{
+    return task->tree->parent == UCC_RANK_INVALID;
+}
+
+#endif
@@ -0,0 +1,565 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_shm.h"
+#include "tl_shm_coll.h"
+#include "tl_shm_cma.h"
+#include "core/ucc_team.h"
+#include "coll_score/ucc_coll_score.h"
+#include "components/topo/ucc_topo.h"
+#include "utils/ucc_atomic.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_sys.h"
+#include "utils/ucc_coll_utils.h"
+#include <sys/shm.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* Assigns group id to every rank of the team using socket or numa subgroups
+   of the core team. Ranks that do not belong to any subgroup form groups of
+   their own. If there is a single group or every rank is a group on its own,
+   all ranks are put into group 0, i.e. trees are single level. */
+static void ucc_tl_shm_team_init_groups(ucc_tl_shm_team_t            *team,
+                                        const ucc_base_team_params_t *params)
+{
+    ucc_tl_shm_lib_t       *lib      = UCC_TL_SHM_TEAM_LIB(team);
+    ucc_rank_t              size     = UCC_TL_TEAM_SIZE(team);
+    ucc_topo_t             *topo     = params->team->topo;
+    ucc_tl_shm_group_type_t type     = lib->cfg.group;
+    ucc_rank_t              n_groups = 0;
+    ucc_sbgp_t             *sbgps;
+    ucc_status_t            status;
+    ucc_rank_t              r, q, j, core_rank;
+    int                     n_sbgps, i;
+
+    for (r = 0; r < size; r++) {
+        team->group[r] = 0;
+    }
+    if (!topo || type == UCC_TL_SHM_GROUP_NONE) {
+        return;
+    }
+    if (type == UCC_TL_SHM_GROUP_AUTO) {
+        type = topo->topo->sock_bound ? UCC_TL_SHM_GROUP_SOCKET
+                                      : UCC_TL_SHM_GROUP_NUMA;
+    }
+    if (type == UCC_TL_SHM_GROUP_SOCKET) {
+        status = ucc_topo_get_all_sockets(topo, &sbgps, &n_sbgps);
+    } else {
+        status = ucc_topo_get_all_numas(topo, &sbgps, &n_sbgps);
+    }
+    if (status != UCC_OK) {
+        tl_debug(UCC_TL_TEAM_LIB(team), "%s subgroups are not available",
+                 ucc_tl_shm_group_names[type]);
+        return;
+    }
+
+    for (r = 0; r < size; r++) {
+        core_rank      = ucc_ep_map_eval(params->map, r);
+        team->group[r] = n_sbgps + r;
+        for (i = 0; i < n_sbgps; i++) {
+            if (!sbgps[i].rank_map) {
+                continue;
+            }
+            for (j = 0; j < sbgps[i].group_size; j++) {
+                if (ucc_ep_map_eval(sbgps[i].map, j) == core_rank) {
+                    team->group[r] = (ucc_rank_t)i;
+                    break;
+                }
+            }
+            if (team->group[r] == (ucc_rank_t)i) {
+                break;
+            }
+        }
+    }
+
+    for (r = 0; r < size; r++) {
+        for (q = 0; q < r; q++) {
+            if (team->group[q] == team->group[r]) {
+                break;
+            }
+        }
+        if (q == r) {
+            n_groups++;
+        }
+    }
+    if (n_groups == 1 || n_groups == size) {
+        for (r = 0; r < size; r++) {
+            team->group[r] = 0;
+        }
+        n_groups = 1;
+    }
+    tl_debug(UCC_TL_TEAM_LIB(team), "team %p: %u %s groups", team, n_groups,
+             ucc_tl_shm_group_names[type]);
+}
+
+UCC_CLASS_INIT_FUNC(ucc_tl_shm_team_t, ucc_base_context_t *tl_context,
+                    const ucc_base_team_params_t *params)
+{
+    ucc_tl_shm_context_t *ctx =
+        ucc_derived_of(tl_context, ucc_tl_shm_context_t);
+    ucc_tl_shm_lib_t     *lib =
+        ucc_derived_of(tl_context->lib, ucc_tl_shm_lib_t);
+    ucc_rank_t            size;
+    size_t                seg_size;
+    ucc_status_t          status;
+    ucc_rank_t            r;
+    int                   shm_id;
+
+    UCC_CLASS_CALL_SUPER_INIT(ucc_tl_team_t, &ctx->super, params);
+
+    size               = UCC_TL_TEAM_SIZE(self);
+    self->oob          = params->params.oob;
+    self->oob_req      = NULL;
+    self->state        = UCC_TL_SHM_TEAM_STATE_SHM_ID;
+    self->seg          = NULL;
+    self->data_size    = lib->cfg.data_size;
+    self->seq_num      = 0;
+    self->seq_done     = 0;
+    self->up_reader    = UCC_RANK_INVALID;
+    self->up_seq       = 0;
+    self->down_readers = NULL;
+    self->down_seq     = 0;
+    self->cma_enabled  = 0;
+    self->cma_probe    = (uint64_t)getpid();
+
+    if (!ucc_team_map_is_single_node(params->team, params->map)) {
+        tl_debug(tl_context->lib, "multinode team is not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    self->shm_ids = ucc_malloc((size + 1) * sizeof(int), "tl_shm_ids");
+    self->group   = ucc_malloc(size * sizeof(ucc_rank_t), "tl_shm_group");
+    self->trees   = ucc_calloc(size, sizeof(ucc_tl_shm_tree_t *),
+                               "tl_shm_trees");
+    self->peers   = ucc_malloc(size * sizeof(ucc_rank_t), "tl_shm_peers");
+    if (!self->shm_ids || !self->group || !self->trees || !self->peers) {
+        tl_error(tl_context->lib, "failed to allocate team arrays");
+        status = UCC_ERR_NO_MEMORY;
+        goto err;
+    }
+    for (r = 0; r < size - 1; r++) {
+        self->peers[r] = (r < UCC_TL_TEAM_RANK(self)) ? r : r + 1;
+    }
+    ucc_tl_shm_team_init_groups(self, params);
+
+    shm_id = -1;
+    if (UCC_TL_TEAM_RANK(self) == 0) {
+        seg_size = UCC_CACHE_LINE_SIZE + UCC_TL_SHM_CTRL_SIZE * size +
+                   2 * self->data_size * size;
+        status   = ucc_sysv_alloc(&seg_size, &self->seg, &shm_id);
+        if (status != UCC_OK) {
+            tl_error(tl_context->lib, "failed to alloc sysv segment of %zd "
+                     "bytes", seg_size);
+            /* proceed and notify other ranks about error */
+            shm_id    = -1;
+            self->seg = NULL;
+        } else {
+            memset(self->seg, 0, seg_size);
+        }
+    }
+    self->shm_ids[size] = shm_id;
+    status = self->oob.allgather(&self->shm_ids[size], self->shm_ids,
+                                 sizeof(int), self->oob.coll_info,
+                                 &self->oob_req);
+    if (UCC_OK != status) {
+        tl_error(tl_context->lib, "failed to start oob allgather");
+        goto err;
+    }
+    tl_debug(tl_context->lib, "posted tl team: %p", self);
+    return UCC_OK;
+
+err:
+    if (self->seg) {
+        ucc_sysv_free(self->seg);
+    }
+    ucc_free(self->peers);
+    ucc_free(self->trees);
+    ucc_free(self->group);
+    ucc_free(self->shm_ids);
+    return status;
+}
+
+UCC_CLASS_CLEANUP_FUNC(ucc_tl_shm_team_t)
+{
+    ucc_rank_t i;
+
+    tl_debug(self->super.super.context->lib, "finalizing tl team: %p", self);
+    for (i = 0; i < UCC_TL_TEAM_SIZE(self); i++) {
+        if (self->trees[i]) {
+            ucc_free(self->trees[i]->srcs);
+            ucc_free(self->trees[i]->children);
+            ucc_free(self->trees[i]);
+        }
+    }
+    if (self->seg) {
+        ucc_sysv_free(self->seg);
+    }
+    ucc_free(self->peers);
+    ucc_free(self->trees);
+    ucc_free(self->group);
+    ucc_free(self->shm_ids);
+}
+
+UCC_CLASS_DEFINE_DELETE_FUNC(ucc_tl_shm_team_t, ucc_base_team_t);
+
+UCC_CLASS_DEFINE(ucc_tl_shm_team_t, ucc_tl_team_t);
+
+ucc_status_t ucc_tl_shm_team_destroy(ucc_base_team_t *tl_team)
+{
+    UCC_CLASS_DELETE_FUNC_NAME(ucc_tl_shm_team_t)(tl_team);
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_shm_team_create_test(ucc_base_team_t *tl_team)
+{
+    ucc_tl_shm_team_t       *team = ucc_derived_of(tl_team, ucc_tl_shm_team_t);
+    ucc_tl_shm_lib_t        *lib  = UCC_TL_SHM_TEAM_LIB(team);
+    ucc_rank_t               size = UCC_TL_TEAM_SIZE(team);
+    ucc_tl_shm_seg_header_t *hdr;
+    ucc_tl_shm_ctrl_t       *ctrl;
+    ucc_status_t             status;
+    ucc_rank_t               r;
+    int                      shm_id;
+
+    switch (team->state) {
+    case UCC_TL_SHM_TEAM_STATE_READY:
+        return UCC_OK;
+    case UCC_TL_SHM_TEAM_STATE_ATTACH:
+        goto attach;
+    case UCC_TL_SHM_TEAM_STATE_PROBE:
+        goto probe;
+    default:
+        break;
+    }
+    status = team->oob.req_test(team->oob_req);
+    if (status == UCC_INPROGRESS) {
+        return UCC_INPROGRESS;
+    } else if (status < 0) {
+        tl_error(tl_team->context->lib, "oob allgather failed");
+        return status;
+    }
+    team->oob.req_free(team->oob_req);
+
+    shm_id = team->shm_ids[0];
+    if (shm_id < 0) {
+        tl_error(tl_team->context->lib, "failed to create shmem region");
+        return UCC_ERR_NO_MEMORY;
+    }
+    /* attach status is exchanged so that a rank failing to attach does not
+       leave the others waiting for it in the segment */
+    team->shm_ids[size] = 0;
+    if (UCC_TL_TEAM_RANK(team) != 0) {
+        if ((int)UCC_TL_TEAM_RANK(team) == lib->cfg.debug_attach_fail_rank) {
+            team->seg = (void *)-1;
+            errno     = EINVAL;
+        } else {
+            team->seg = shmat(shm_id, NULL, 0);
+        }
+        if (team->seg == (void *)-1) {
+            tl_error(tl_team->context->lib, "failed to shmat errno: %d (%s)",
+                     errno, strerror(errno));
+            team->seg           = NULL;
+            team->shm_ids[size] = -1;
+        }
+    }
+    if (team->seg) {
+        ctrl            = UCC_TL_SHM_CTRL(team, UCC_TL_TEAM_RANK(team));
+        ctrl->pid       = getpid();
+        ctrl->cma_probe = (uint64_t)&team->cma_probe;
+    }
+    status = team->oob.allgather(&team->shm_ids[size], team->shm_ids,
+                                 sizeof(int), team->oob.coll_info,
+                                 &team->oob_req);
+    if (UCC_OK != status) {
+        tl_error(tl_team->context->lib, "failed to start oob allgather");
+        return status;
+    }
+    team->state = UCC_TL_SHM_TEAM_STATE_ATTACH;
+
+attach:
+    /* segment creator may not detach before everybody is attached */
+    status = team->oob.req_test(team->oob_req);
+    if (status == UCC_INPROGRESS) {
+        return UCC_INPROGRESS;
+    } else if (status < 0) {
+        tl_error(tl_team->context->lib, "oob allgather failed");
+        return status;
+    }
+    team->oob.req_free(team->oob_req);
+    team->oob_req = NULL;
+    for (r = 0; r < size; r++) {
+        if (team->shm_ids[r] < 0) {
+            tl_error(tl_team->context->lib, "rank %u failed to attach to "
+                     "shmem region", r);
+            return UCC_ERR_NO_MEMORY;
+        }
+    }
+    ctrl         = UCC_TL_SHM_CTRL(team, UCC_TL_TEAM_RANK(team));
+    ctrl->cma_ok = (lib->cfg.cma != UCC_NO) && ucc_tl_shm_cma_check(team);
+    hdr          = team->seg;
+    ucc_memory_cpu_store_fence();
+    ucc_atomic_add32(&hdr->n_probed, 1);
+    team->state = UCC_TL_SHM_TEAM_STATE_PROBE;
+
+probe:
+    /* peers read the probe word until everybody is done */
+    hdr = team->seg;
+    if (hdr->n_probed != size) {
+        return UCC_INPROGRESS;
+    }
+    ucc_memory_cpu_load_fence();
+    team->cma_enabled = 1;
+    for (r = 0; r < size; r++) {
+        if (!UCC_TL_SHM_CTRL(team, r)->cma_ok) {
+            team->cma_enabled = 0;
+        }
+    }
+    if (lib->cfg.cma == UCC_YES && !team->cma_enabled) {
+        tl_error(tl_team->context->lib, "CMA is required but processes are "
+                 "not allowed to access each other's memory");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    team->state = UCC_TL_SHM_TEAM_STATE_READY;
+    tl_debug(tl_team->context->lib, "initialized tl team: %p, cma %s", team,
+             team->cma_enabled ? "enabled" : "disabled");
+    return UCC_OK;
+}
+
+/* Knomial tree over n ranks rooted at 0, children are returned starting from
+   the largest subtree */
+static void ucc_tl_shm_knomial_tree(ucc_rank_t vrank, ucc_rank_t n,
+                                    uint32_t radix, ucc_rank_t *parent,
+                                    ucc_rank_t *children,
+                                    ucc_rank_t *n_children)
+{
+    size_t     dist = 1;
+    ucc_rank_t peer;
+    uint32_t   i;
+
+    *parent     = UCC_RANK_INVALID;
+    *n_children = 0;
+    while (dist < n) {
+        if (vrank % (dist * radix)) {
+            *parent = vrank - vrank % (dist * radix);
+            break;
+        }
+        dist *= radix;
+    }
+    for (dist /= radix; dist > 0; dist /= radix) {
+        for (i = 1; i < radix; i++) {
+            peer = vrank + i * dist;
+            if (peer >= n) {
+                break;
+            }
+            children[(*n_children)++] = peer;
+        }
+    }
+}
+
+static ucc_status_t ucc_tl_shm_tree_build(ucc_tl_shm_team_t  *team,
+                                          ucc_rank_t          root,
+                                          ucc_tl_shm_tree_t **tree_p)
+{
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         rank    = UCC_TL_TEAM_RANK(team);
+    uint32_t           radix   = UCC_TL_SHM_TEAM_LIB(team)->cfg.radix;
+    ucc_rank_t         n_lead  = 0;
+    ucc_rank_t         n_memb  = 0;
+    ucc_status_t       status  = UCC_ERR_NO_MEMORY;
+    ucc_rank_t        *leaders = NULL;
+    ucc_rank_t        *members = NULL;
+    ucc_rank_t        *peers   = NULL;
+    ucc_tl_shm_tree_t *tree;
+    ucc_rank_t         r, q, leader, vrank, parent, n_peers, i;
+
+    tree = ucc_calloc(1, sizeof(*tree), "tl_shm_tree");
+    if (!tree) {
+        goto err;
+    }
+    tree->children = ucc_malloc(size * sizeof(ucc_rank_t), "tl_shm_children");
+    leaders        = ucc_malloc(size * sizeof(ucc_rank_t), "tl_shm_leaders");
+    members        = ucc_malloc(size * sizeof(ucc_rank_t), "tl_shm_members");
+    peers          = ucc_malloc(size * sizeof(ucc_rank_t), "tl_shm_peers");
+    if (!tree->children || !leaders || !members || !peers) {
+        goto err;
+    }
+
+    /* group leader is the root for the root group, first rank otherwise */
+    leaders[n_lead++] = root;
+    for (r = 0; r < size; r++) {
+        if (team->group[r] == team->group[root]) {
+            continue;
+        }
+        for (q = 0; q < r; q++) {
+            if (team->group[q] == team->group[r]) {
+                break;
+            }
+        }
+        if (q == r) {
+            leaders[n_lead++] = r;
+        }
+    }
+    leader = UCC_RANK_INVALID;
+    for (i = 0; i < n_lead; i++) {
+        if (team->group[leaders[i]] == team->group[rank]) {
+            leader = leaders[i];
+            break;
+        }
+    }
+    ucc_assert(leader != UCC_RANK_INVALID);
+
+    members[n_memb++] = leader;
+    vrank             = 0;
+    for (r = 0; r < size; r++) {
+        if (r != leader && team->group[r] == team->group[rank]) {
+            if (r == rank) {
+                vrank = n_memb;
+            }
+            members[n_memb++] = r;
+        }
+    }
+
+    if (rank == leader) {
+        /* top level: ranks of other groups are reached via their leaders */
+        ucc_tl_shm_knomial_tree(i, n_lead, radix, &parent, peers, &n_peers);
+        tree->parent = (parent == UCC_RANK_INVALID) ? UCC_RANK_INVALID
+                                                    : leaders[parent];
+        for (q = 0; q < n_peers; q++) {
+            tree->children[tree->n_children++] = leaders[peers[q]];
+        }
+    }
+    ucc_tl_shm_knomial_tree(vrank, n_memb, radix, &parent, peers, &n_peers);
+    if (rank != leader) {
+        tree->parent = members[parent];
+    }
+    for (q = 0; q < n_peers; q++) {
+        tree->children[tree->n_children++] = members[peers[q]];
+    }
+
+    tree->srcs = ucc_malloc((tree->n_children + 1) * sizeof(void *),
+                            "tl_shm_srcs");
+    if (!tree->srcs) {
+        goto err;
+    }
+    for (q = 0; q < tree->n_children; q++) {
+        tree->srcs[q + 1] = UCC_TL_SHM_UP_SLOT(team, tree->children[q]);
+    }
+    ucc_free(peers);
+    ucc_free(members);
+    ucc_free(leaders);
+    *tree_p = tree;
+    return UCC_OK;
+
+err:
+    tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate tree for root %u",
+             root);
+    if (tree) {
+        ucc_free(tree->children);
+        ucc_free(tree);
+    }
+    ucc_free(peers);
+    ucc_free(members);
+    ucc_free(leaders);
+    return status;
+}
+
+ucc_status_t ucc_tl_shm_team_get_tree(ucc_tl_shm_team_t  *team,
+                                      ucc_rank_t          root,
+                                      ucc_tl_shm_tree_t **tree)
+{
+    ucc_status_t status;
+
+    if (ucc_unlikely(!team->trees[root])) {
+        status = ucc_tl_shm_tree_build(team, root, &team->trees[root]);
+        if (status != UCC_OK) {
+            return status;
+        }
+    }
+    *tree = team->trees[root];
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_shm_team_get_scores(ucc_base_team_t   *tl_team,
+                                        ucc_coll_score_t **score_p)
+{
+    ucc_tl_shm_team_t  *team = ucc_derived_of(tl_team, ucc_tl_shm_team_t);
+    ucc_base_context_t *ctx  = UCC_TL_TEAM_CTX(team);
+    ucc_memory_type_t   mt   = UCC_MEMORY_TYPE_HOST;
+    size_t              cma_thresh;
+    ucc_coll_score_t   *score;
+    ucc_status_t        status;
+    ucc_coll_type_t     coll;
+    size_t              max_size;
+    int                 i, cma;
+    ucc_coll_score_team_info_t team_info;
+
+    cma_thresh = UCC_TL_SHM_TEAM_LIB(team)->cfg.cma_thresh;
+
+    team_info.alg_fn              = NULL;
+    team_info.default_score       = UCC_TL_SHM_DEFAULT_SCORE;
+    team_info.init                = ucc_tl_shm_coll_init;
+    team_info.num_mem_types       = 1;
+    team_info.supported_mem_types = &mt;
+    team_info.supported_colls     = team->cma_enabled
+                                        ? UCC_TL_SHM_SUPPORTED_COLLS
+                                        : UCC_TL_SHM_SLOT_COLLS;
+    team_info.size                = UCC_TL_TEAM_SIZE(team);
+
+    status = ucc_coll_score_alloc(&score);
+    if (UCC_OK != status) {
+        tl_error(tl_team->context->lib, "failed to alloc score_t");
+        return status;
+    }
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        coll = (ucc_coll_type_t)UCC_BIT(i);
+        cma  = team->cma_enabled && (coll & UCC_TL_SHM_CMA_COLLS);
+        if (coll & UCC_TL_SHM_SLOT_COLLS) {
+            /* data goes through a single slot per rank */
+            max_size = (coll & UCC_TL_SHM_DATA_COLLS) ? team->data_size + 1
+                                                      : UCC_MSG_MAX;
+            if (cma) {
+                max_size = ucc_min(max_size, cma_thresh);
+            }
+            if (max_size > 0) {
+                status = ucc_coll_score_add_range(score, coll, mt, 0, max_size,
+                                                  UCC_TL_SHM_DEFAULT_SCORE,
+                                                  ucc_tl_shm_coll_init,
+                                                  tl_team);
+                if (UCC_OK != status) {
+                    tl_error(tl_team->context->lib,
+                             "failed to add range to score_t");
+                    goto err;
+                }
+            }
+        }
+        if (cma) {
+            status = ucc_coll_score_add_range(score, coll, mt, cma_thresh,
+                                              UCC_MSG_MAX,
+                                              UCC_TL_SHM_DEFAULT_SCORE,
+                                              ucc_tl_shm_coll_init, tl_team);
+            if (UCC_OK != status) {
+                tl_error(tl_team->context->lib,
+                         "failed to add range to score_t");
+                goto err;
+            }
+        }
+    }
+
+    if (strlen(ctx->score_str) > 0) {
+        status = ucc_coll_score_update_from_str(ctx->score_str, &team_info,
+                                                &team->super.super, score);
+        if ((status < 0) && (status != UCC_ERR_INVALID_PARAM) &&
+            (status != UCC_ERR_NOT_SUPPORTED)) {
+            goto err;
+        }
+    }
+
+    *score_p = score;
+    return UCC_OK;
+err:
+    ucc_coll_score_free(score);
+    return status;
+}
@@ -56,6 +56,29 @@ void ucc_tl_ucp_allgather_ring_progress(ucc_coll_task_t *task);
 ucc_status_t ucc_tl_ucp_allgather_ring_start(ucc_coll_task_t *task);
 
 /* Neighbor Exchange */
+/* first of 2 blocks received at step i */
+static inline ucc_rank_t
+ucc_tl_ucp_allgather_neighbor_recv_from(ucc_rank_t rank, ucc_rank_t size, int i)
+{
+    const int  i_parity = i % 2;
+    int offset_at_step[2];
+    ucc_rank_t recv_data_from;
+
+    if (rank % 2) {
+        recv_data_from    = (rank - 1 + size) % size;
+        offset_at_step[0] = (-2);
+        offset_at_step[1] = (+2);
+    } else {
+        recv_data_from    = rank;
+        offset_at_step[0] = (+2);
+        offset_at_step[1] = (-2);
+    }
+
+    return (recv_data_from + offset_at_step[i_parity] * ucc_div_round_up(i, 2) +
+            size) %
+           size;
+}
+
 ucc_status_t ucc_tl_ucp_allgather_neighbor_init(ucc_base_coll_args_t *coll_args,
                                                 ucc_base_team_t      *team,
                                                 ucc_coll_task_t     **task_h);
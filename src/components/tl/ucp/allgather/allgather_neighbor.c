@@ -12,27 +12,6 @@
 #include "utils/ucc_coll_utils.h"
 #include "components/mc/ucc_mc.h"
 
-static ucc_rank_t get_recv_from_rank(ucc_rank_t rank, ucc_rank_t size, int i)
-{
-    const int  i_parity = i % 2;
-    int offset_at_step[2];
-    ucc_rank_t recv_data_from;
-
-    if (rank % 2) {
-        recv_data_from    = (rank - 1 + size) % size;
-        offset_at_step[0] = (-2);
-        offset_at_step[1] = (+2);
-    } else {
-        recv_data_from    = rank;
-        offset_at_step[0] = (+2);
-        offset_at_step[1] = (-2);
-    }
-
-    return (recv_data_from + offset_at_step[i_parity] * ucc_div_round_up(i, 2) +
-            size) %
-           size;
-}
-
 ucc_status_t ucc_tl_ucp_allgather_neighbor_init(ucc_base_coll_args_t *coll_args,
                                                 ucc_base_team_t      *team,
                                                 ucc_coll_task_t     **task_h)
@@ -102,10 +81,14 @@ void ucc_tl_ucp_allgather_neighbor_progress(ucc_coll_task_t *coll_task)
         i        = task->tagged.send_posted;
         i_parity = i % 2;
 
-        tmprecv =
-            PTR_OFFSET(rbuf, get_recv_from_rank(trank, tsize, i) * data_size);
-        tmpsend = PTR_OFFSET(rbuf, get_recv_from_rank(trank, tsize, i - 1) *
-                                       data_size);
+        tmprecv  = PTR_OFFSET(
+            rbuf,
+            ucc_tl_ucp_allgather_neighbor_recv_from(trank, tsize, i) *
+                data_size);
+        tmpsend  = PTR_OFFSET(
+            rbuf,
+            ucc_tl_ucp_allgather_neighbor_recv_from(trank, tsize, i - 1) *
+                data_size);
 
         /* Sendreceive */
         UCPCHECK_GOTO(ucc_tl_ucp_send_nb(tmpsend, 2 * data_size, rmem,
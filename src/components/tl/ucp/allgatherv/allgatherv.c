@@ -19,6 +19,22 @@ ucc_base_coll_alg_info_t
             {.id   = UCC_TL_UCP_ALLGATHERV_ALG_KNOMIAL,
              .name = "knomial",
              .desc = "recursive k-ing with arbitrary radix"},
+        [UCC_TL_UCP_ALLGATHERV_ALG_NEIGHBOR] =
+            {.id   = UCC_TL_UCP_ALLGATHERV_ALG_NEIGHBOR,
+             .name = "neighbor",
+             .desc = "O(N) Neighbor Exchange N/2 steps"},
+        [UCC_TL_UCP_ALLGATHERV_ALG_BRUCK] =
+            {.id   = UCC_TL_UCP_ALLGATHERV_ALG_BRUCK,
+             .name = "bruck",
+             .desc = "O(log(N)) Variation of Bruck algorithm"},
+        [UCC_TL_UCP_ALLGATHERV_ALG_SPARBIT] =
+            {.id   = UCC_TL_UCP_ALLGATHERV_ALG_SPARBIT,
+             .name = "sparbit",
+             .desc = "O(log(N)) SPARBIT algorithm"},
+        [UCC_TL_UCP_ALLGATHERV_ALG_AUTO] =
+            {.id   = UCC_TL_UCP_ALLGATHERV_ALG_AUTO,
+             .name = "auto",
+             .desc = "selects bruck, sparbit, neighbor or ring based on counts"},
         [UCC_TL_UCP_ALLGATHERV_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
@@ -31,3 +47,39 @@ ucc_status_t ucc_tl_ucp_allgatherv_init(ucc_tl_ucp_task_t *task)
 
     return ucc_tl_ucp_allgatherv_ring_init_common(task);
 }
+
+/* All ranks have the same dst counts so the choice below is consistent
+   across the team. */
+ucc_status_t ucc_tl_ucp_allgatherv_auto_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t       *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    ucc_coll_args_t         *args    = &coll_args->args;
+    ucc_rank_t               tsize   = UCC_TL_TEAM_SIZE(tl_team);
+    size_t                   total   = 0;
+    size_t                   max     = 0;
+    size_t                   block;
+    ucc_rank_t               i;
+
+    if (!ucc_coll_args_is_predefined_dt(args, UCC_RANK_INVALID)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    for (i = 0; i < tsize; i++) {
+        block  = ucc_tl_ucp_allgatherv_block_size(args, i);
+        total += block;
+        max    = ucc_max(max, block);
+    }
+
+    if (total <= cfg->allgatherv_auto_small_thresh) {
+        return ucc_tl_ucp_allgatherv_bruck_init(coll_args, team, task_h);
+    }
+    if (max * tsize >= (size_t)cfg->allgatherv_auto_imbalance * total) {
+        return ucc_tl_ucp_allgatherv_sparbit_init(coll_args, team, task_h);
+    }
+    if (tsize % 2 == 0) {
+        return ucc_tl_ucp_allgatherv_neighbor_init(coll_args, team, task_h);
+    }
+    return ucc_tl_ucp_allgatherv_ring_init(coll_args, team, task_h);
+}
@@ -13,6 +13,10 @@
 enum {
     UCC_TL_UCP_ALLGATHERV_ALG_RING,
     UCC_TL_UCP_ALLGATHERV_ALG_KNOMIAL,
+    UCC_TL_UCP_ALLGATHERV_ALG_NEIGHBOR,
+    UCC_TL_UCP_ALLGATHERV_ALG_BRUCK,
+    UCC_TL_UCP_ALLGATHERV_ALG_SPARBIT,
+    UCC_TL_UCP_ALLGATHERV_ALG_AUTO,
     UCC_TL_UCP_ALLGATHERV_ALG_LAST
 };
 
@@ -20,7 +24,7 @@ extern ucc_base_coll_alg_info_t
              ucc_tl_ucp_allgatherv_algs[UCC_TL_UCP_ALLGATHERV_ALG_LAST + 1];
 
 #define UCC_TL_UCP_ALLGATHERV_DEFAULT_ALG_SELECT_STR                           \
-    "allgatherv:@0"
+    "allgatherv:@auto"
 
 char *ucc_tl_ucp_allgatherv_score_str_get(ucc_tl_ucp_team_t *team);
 
@@ -35,6 +39,22 @@ static inline int ucc_tl_ucp_allgatherv_alg_from_str(const char *str)
     return i;
 }
 
+static inline size_t ucc_tl_ucp_allgatherv_block_size(ucc_coll_args_t *args,
+                                                      ucc_rank_t       rank)
+{
+    return ucc_coll_args_get_count(args, args->dst.info_v.counts, rank) *
+           ucc_dt_size(args->dst.info_v.datatype);
+}
+
+static inline void *ucc_tl_ucp_allgatherv_block(ucc_coll_args_t *args,
+                                                ucc_rank_t       rank)
+{
+    return PTR_OFFSET(args->dst.info_v.buffer,
+                      ucc_coll_args_get_displacement(
+                          args, args->dst.info_v.displacements, rank) *
+                          ucc_dt_size(args->dst.info_v.datatype));
+}
+
 ucc_status_t ucc_tl_ucp_allgatherv_ring_init_common(ucc_tl_ucp_task_t *task);
 
 ucc_status_t ucc_tl_ucp_allgatherv_ring_init(ucc_base_coll_args_t *coll_args,
@@ -45,5 +65,22 @@ ucc_status_t ucc_tl_ucp_allgatherv_knomial_init(ucc_base_coll_args_t *coll_args,
                                                 ucc_base_team_t *team,
                                                 ucc_coll_task_t **task_h);
 
+ucc_status_t
+ucc_tl_ucp_allgatherv_neighbor_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_base_team_t      *team,
+                                    ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_allgatherv_bruck_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_allgatherv_sparbit_init(ucc_base_coll_args_t *coll_args,
+                                                ucc_base_team_t      *team,
+                                                ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_allgatherv_auto_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h);
+
 ucc_status_t ucc_tl_ucp_allgatherv_init(ucc_tl_ucp_task_t *task);
 #endif
@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "components/mc/ucc_mc.h"
+
+/* Bruck with variable block sizes. Blocks are collected in scratch in the
+   order of ranks starting from own one, so blocks sent on every step are
+   contiguous both in scratch of the sender and of the receiver. After
+   ceil(log2(tsize)) steps blocks are copied from scratch to their places
+   in dst. */
+
+/* offset in scratch of the block that is "pos" ranks away from own one */
+static inline size_t ucc_tl_ucp_allgatherv_bruck_offset(ucc_coll_args_t *args,
+                                                        ucc_rank_t trank,
+                                                        ucc_rank_t tsize,
+                                                        ucc_rank_t pos)
+{
+    size_t     offset = 0;
+    ucc_rank_t i;
+
+    for (i = 0; i < pos; i++) {
+        offset += ucc_tl_ucp_allgatherv_block_size(args, (trank + i) % tsize);
+    }
+    return offset;
+}
+
+static void ucc_tl_ucp_allgatherv_bruck_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task    = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         trank   = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize   = UCC_TL_TEAM_SIZE(team);
+    ucc_memory_type_t  rmem    = args->dst.info_v.mem_type;
+    void              *scratch = task->allgather_bruck.scratch_header->addr;
+    ucc_rank_t         recvfrom, sendto, distance, blockcount, i, idx;
+    size_t             offset, block_offset, len;
+    ucc_status_t       status;
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+
+    distance = 1 << task->tagged.recv_posted;
+    while (distance < tsize) {
+        recvfrom   = (trank + distance) % tsize;
+        sendto     = (trank + tsize - distance) % tsize;
+        blockcount = (distance <= tsize >> 1) ? distance : tsize - distance;
+        len        = ucc_tl_ucp_allgatherv_bruck_offset(args, trank, tsize,
+                                                        blockcount);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(scratch, len, rmem, sendto, team,
+                                         task),
+                      task, out);
+        offset = ucc_tl_ucp_allgatherv_bruck_offset(args, trank, tsize,
+                                                    distance);
+        len    = ucc_tl_ucp_allgatherv_bruck_offset(args, trank, tsize,
+                                                    distance + blockcount) -
+                 offset;
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(PTR_OFFSET(scratch, offset), len,
+                                         rmem, recvfrom, team, task),
+                      task, out);
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        distance = 1 << task->tagged.recv_posted;
+    }
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+
+    /* own block is in place already for inplace case */
+    block_offset = ucc_tl_ucp_allgatherv_block_size(args, trank);
+    for (i = 1; i < tsize; i++) {
+        idx    = (trank + i) % tsize;
+        len    = ucc_tl_ucp_allgatherv_block_size(args, idx);
+        status = ucc_mc_memcpy(ucc_tl_ucp_allgatherv_block(args, idx),
+                               PTR_OFFSET(scratch, block_offset), len, rmem,
+                               rmem);
+        if (ucc_unlikely(status != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task),
+                     "failed to copy data from scratch to dst buffer");
+            task->super.status = status;
+            return;
+        }
+        block_offset += len;
+    }
+
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgatherv_bruck_done",
+                                     0);
+}
+
+static ucc_status_t ucc_tl_ucp_allgatherv_bruck_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_memory_type_t  rmem  = args->dst.info_v.mem_type;
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    size_t             len   = ucc_tl_ucp_allgatherv_block_size(args, trank);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgatherv_bruck_start",
+                                     0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    if (!UCC_IS_INPLACE(*args)) {
+        status = ucc_mc_memcpy(ucc_tl_ucp_allgatherv_block(args, trank),
+                               args->src.info.buffer, len, rmem,
+                               args->src.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    status = ucc_mc_memcpy(task->allgather_bruck.scratch_header->addr,
+                           ucc_tl_ucp_allgatherv_block(args, trank), len, rmem,
+                           rmem);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+static ucc_status_t
+ucc_tl_ucp_allgatherv_bruck_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       global_status, status;
+
+    global_status = ucc_mc_free(task->allgather_bruck.scratch_header);
+    if (ucc_unlikely(global_status != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer memory");
+    }
+    status = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(status != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task),
+                 "failed to finalize allgatherv bruck collective");
+        global_status = status;
+    }
+    return global_status;
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_bruck_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t   *args    = &coll_args->args;
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+    size_t             total;
+
+    if (!ucc_coll_args_is_predefined_dt(args, UCC_RANK_INVALID)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    total = ucc_coll_args_get_total_count(args, args->dst.info_v.counts,
+                                          UCC_TL_TEAM_SIZE(tl_team)) *
+            ucc_dt_size(args->dst.info_v.datatype);
+    task  = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_mc_alloc(&task->allgather_bruck.scratch_header,
+                          ucc_max(total, 1), args->dst.info_v.mem_type);
+    if (ucc_unlikely(status != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    task->allgather_bruck.scratch_size = total;
+    task->super.post                   = ucc_tl_ucp_allgatherv_bruck_start;
+    task->super.progress               = ucc_tl_ucp_allgatherv_bruck_progress;
+    task->super.finalize               = ucc_tl_ucp_allgatherv_bruck_finalize;
+    *task_h                            = &task->super;
+    return UCC_OK;
+}
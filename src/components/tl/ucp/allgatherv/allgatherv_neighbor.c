@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgatherv.h"
+#include "allgather/allgather.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "components/mc/ucc_mc.h"
+
+/* Neighbor exchange with variable block sizes: tsize / 2 steps, first step
+   exchanges own block with a neighbor, every next one forwards the pair of
+   blocks received on previous step. Blocks of a pair are not contiguous in
+   dst in general, so they are sent as 2 messages. */
+static ucc_status_t
+ucc_tl_ucp_allgatherv_neighbor_sendrecv_pair(ucc_tl_ucp_task_t *task,
+                                             ucc_rank_t send_idx,
+                                             ucc_rank_t recv_idx,
+                                             ucc_rank_t peer)
+{
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_memory_type_t  rmem = args->dst.info_v.mem_type;
+    ucc_status_t       status;
+    int                i;
+
+    for (i = 0; i < 2; i++) {
+        status = ucc_tl_ucp_send_nb(
+            ucc_tl_ucp_allgatherv_block(args, send_idx + i),
+            ucc_tl_ucp_allgatherv_block_size(args, send_idx + i), rmem, peer,
+            team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        status = ucc_tl_ucp_recv_nb(
+            ucc_tl_ucp_allgatherv_block(args, recv_idx + i),
+            ucc_tl_ucp_allgatherv_block_size(args, recv_idx + i), rmem, peer,
+            team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
+static void ucc_tl_ucp_allgatherv_neighbor_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         neighbors[2], i;
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+
+    if (trank % 2) {
+        neighbors[0] = (trank - 1 + tsize) % tsize;
+        neighbors[1] = (trank + 1) % tsize;
+    } else {
+        neighbors[0] = (trank + 1) % tsize;
+        neighbors[1] = (trank - 1 + tsize) % tsize;
+    }
+
+    /* 1 send on the first step and 2 sends on every next one */
+    while ((i = (task->tagged.send_posted + 1) / 2) < tsize / 2) {
+        UCPCHECK_GOTO(ucc_tl_ucp_allgatherv_neighbor_sendrecv_pair(
+                          task,
+                          ucc_tl_ucp_allgather_neighbor_recv_from(trank, tsize,
+                                                                  i - 1),
+                          ucc_tl_ucp_allgather_neighbor_recv_from(trank, tsize,
+                                                                  i),
+                          neighbors[i % 2]),
+                      task, out);
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return;
+        }
+    }
+
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgatherv_neighbor_done",
+                                     0);
+}
+
+static ucc_status_t
+ucc_tl_ucp_allgatherv_neighbor_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_memory_type_t  rmem  = args->dst.info_v.mem_type;
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    ucc_status_t       status;
+    ucc_rank_t         neighbor;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task,
+                                     "ucp_allgatherv_neighbor_start", 0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    if (!UCC_IS_INPLACE(*args)) {
+        status = ucc_mc_memcpy(ucc_tl_ucp_allgatherv_block(args, trank),
+                               args->src.info.buffer,
+                               ucc_tl_ucp_allgatherv_block_size(args, trank),
+                               rmem, args->src.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+
+    neighbor = (trank % 2) ? (trank - 1 + tsize) % tsize : (trank + 1) % tsize;
+    UCPCHECK_GOTO(
+        ucc_tl_ucp_send_nb(ucc_tl_ucp_allgatherv_block(args, trank),
+                           ucc_tl_ucp_allgatherv_block_size(args, trank), rmem,
+                           neighbor, team, task),
+        task, out);
+    UCPCHECK_GOTO(
+        ucc_tl_ucp_recv_nb(ucc_tl_ucp_allgatherv_block(args, neighbor),
+                           ucc_tl_ucp_allgatherv_block_size(args, neighbor),
+                           rmem, neighbor, team, task),
+        task, out);
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+out:
+    return task->super.status;
+}
+
+ucc_status_t
+ucc_tl_ucp_allgatherv_neighbor_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_base_team_t      *team,
+                                    ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+
+    if (!ucc_coll_args_is_predefined_dt(&coll_args->args, UCC_RANK_INVALID)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (UCC_TL_TEAM_SIZE(tl_team) % 2) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "odd team size is not supported, switching to ring");
+        return ucc_tl_ucp_allgatherv_ring_init(coll_args, team, task_h);
+    }
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_allgatherv_neighbor_start;
+    task->super.progress = ucc_tl_ucp_allgatherv_neighbor_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "components/mc/ucc_mc.h"
+
+/* Sparbit with variable block sizes: every block is transferred as a
+   separate message directly from/to its place in dst, so skewed counts do
+   not require any packing */
+static void ucc_tl_ucp_allgatherv_sparbit_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task      = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args      = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team      = TASK_TEAM(task);
+    ucc_rank_t         trank     = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize     = UCC_TL_TEAM_SIZE(team);
+    ucc_memory_type_t  rmem      = args->dst.info_v.mem_type;
+    uint32_t           i         = task->allgather_sparbit.i;
+    uint32_t           tsize_log = ucc_ilog2_ceil(tsize);
+    ucc_rank_t         recvfrom, sendto, distance, send_idx, recv_idx;
+    uint32_t           last_ignore, ignore_steps, data_expected, transfer_count;
+    uint32_t           exclusion;
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+
+    last_ignore  = __builtin_ctz(tsize);
+    ignore_steps = (~((uint32_t)tsize >> last_ignore) | 1) << last_ignore;
+
+    while (i < tsize_log) {
+        data_expected = task->allgather_sparbit.data_expected;
+        distance      = (1 << (tsize_log - 1)) >> i;
+        recvfrom      = (trank + tsize - distance) % tsize;
+        sendto        = (trank + distance) % tsize;
+        exclusion     = (distance & ignore_steps) == distance;
+
+        for (transfer_count = 0; transfer_count < data_expected - exclusion;
+             transfer_count++) {
+            send_idx = (trank - 2 * transfer_count * distance + tsize) % tsize;
+            recv_idx =
+                (trank - (2 * transfer_count + 1) * distance + tsize) % tsize;
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_send_nb(ucc_tl_ucp_allgatherv_block(args, send_idx),
+                                   ucc_tl_ucp_allgatherv_block_size(args,
+                                                                    send_idx),
+                                   rmem, sendto, team, task),
+                task, out);
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_recv_nb(ucc_tl_ucp_allgatherv_block(args, recv_idx),
+                                   ucc_tl_ucp_allgatherv_block_size(args,
+                                                                    recv_idx),
+                                   rmem, recvfrom, team, task),
+                task, out);
+        }
+
+        task->allgather_sparbit.data_expected =
+            (data_expected << 1) - exclusion;
+        task->allgather_sparbit.i++;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return;
+        }
+        i = task->allgather_sparbit.i;
+    }
+
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgatherv_sparbit_done",
+                                     0);
+}
+
+static ucc_status_t ucc_tl_ucp_allgatherv_sparbit_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgatherv_sparbit_start",
+                                     0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    task->allgather_sparbit.i             = 0;
+    task->allgather_sparbit.data_expected = 1;
+
+    if (!UCC_IS_INPLACE(*args)) {
+        status = ucc_mc_memcpy(ucc_tl_ucp_allgatherv_block(args, trank),
+                               args->src.info.buffer,
+                               ucc_tl_ucp_allgatherv_block_size(args, trank),
+                               args->dst.info_v.mem_type,
+                               args->src.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_sparbit_init(ucc_base_coll_args_t *coll_args,
+                                                ucc_base_team_t      *team,
+                                                ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+
+    if (!ucc_coll_args_is_predefined_dt(&coll_args->args, UCC_RANK_INVALID)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_allgatherv_sparbit_start;
+    task->super.progress = ucc_tl_ucp_allgatherv_sparbit_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -29,9 +29,32 @@ ucc_base_coll_alg_info_t
             {.id   = UCC_TL_UCP_ALLREDUCE_ALG_SLIDING_WINDOW,
              .name = "sliding_window",
              .desc = "sliding window allreduce (optimized for running on DPU)"},
+        [UCC_TL_UCP_ALLREDUCE_ALG_RING] =
+            {.id   = UCC_TL_UCP_ALLREDUCE_ALG_RING,
+             .name = "ring",
+             .desc = "pipelined ring reduce-scatter followed by ring "
+                     "allgather (optimized for BW)"},
+        [UCC_TL_UCP_ALLREDUCE_ALG_RD] =
+            {.id   = UCC_TL_UCP_ALLREDUCE_ALG_RD,
+             .name = "rd",
+             .desc = "recursive doubling without scratch allocation for "
+                     "small messages (optimized for latency)"},
+        [UCC_TL_UCP_ALLREDUCE_ALG_SWING] =
+            {.id   = UCC_TL_UCP_ALLREDUCE_ALG_SWING,
+             .name = "swing",
+             .desc = "swing allreduce with short distance peers in first "
+                     "steps (optimized for latency on torus networks)"},
         [UCC_TL_UCP_ALLREDUCE_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
+char *ucc_tl_ucp_allreduce_score_str_get(ucc_tl_ucp_team_t *team)
+{
+    if (team->topo && ucc_topo_is_single_ppn(team->topo)) {
+        return strdup(UCC_TL_UCP_ALLREDUCE_DEFAULT_ALG_SELECT_STR_1PPN);
+    }
+    return strdup(UCC_TL_UCP_ALLREDUCE_DEFAULT_ALG_SELECT_STR);
+}
+
 ucc_status_t ucc_tl_ucp_allreduce_init(ucc_tl_ucp_task_t *task)
 {
     ucc_status_t status;
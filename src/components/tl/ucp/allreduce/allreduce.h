@@ -13,6 +13,9 @@ enum {
     UCC_TL_UCP_ALLREDUCE_ALG_SRA_KNOMIAL,
     UCC_TL_UCP_ALLREDUCE_ALG_SLIDING_WINDOW,
     UCC_TL_UCP_ALLREDUCE_ALG_DBT,
+    UCC_TL_UCP_ALLREDUCE_ALG_RING,
+    UCC_TL_UCP_ALLREDUCE_ALG_RD,
+    UCC_TL_UCP_ALLREDUCE_ALG_SWING,
     UCC_TL_UCP_ALLREDUCE_ALG_LAST
 };
 
@@ -23,6 +26,12 @@ ucc_status_t ucc_tl_ucp_allreduce_init(ucc_tl_ucp_task_t *task);
 #define UCC_TL_UCP_ALLREDUCE_DEFAULT_ALG_SELECT_STR                            \
     "allreduce:0-4k:@0#allreduce:4k-inf:@1"
 
+/* with 1 process per node the ring is bandwidth optimal for large messages */
+#define UCC_TL_UCP_ALLREDUCE_DEFAULT_ALG_SELECT_STR_1PPN                       \
+    "allreduce:0-4k:@0#allreduce:4k-1M:@1#allreduce:1M-inf:@ring"
+
+char *ucc_tl_ucp_allreduce_score_str_get(ucc_tl_ucp_team_t *team);
+
 #define CHECK_SAME_MEMTYPE(_args, _team)                                       \
     do {                                                                       \
         if (!UCC_IS_INPLACE(_args) &&                                          \
@@ -77,6 +86,24 @@ ucc_status_t ucc_tl_ucp_allreduce_dbt_start(ucc_coll_task_t *task);
 
 ucc_status_t ucc_tl_ucp_allreduce_dbt_progress(ucc_coll_task_t *task);
 
+ucc_status_t ucc_tl_ucp_allreduce_ring_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_allreduce_rd_init(ucc_base_coll_args_t *coll_args,
+                                          ucc_base_team_t      *team,
+                                          ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_allreduce_swing_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_allreduce_rd_start(ucc_coll_task_t *task);
+
+void ucc_tl_ucp_allreduce_rd_progress(ucc_coll_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allreduce_rd_finalize(ucc_coll_task_t *task);
+
 static inline int ucc_tl_ucp_allreduce_alg_from_str(const char *str)
 {
     int i;
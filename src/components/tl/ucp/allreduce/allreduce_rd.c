@@ -0,0 +1,466 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allreduce.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math_op.h"
+#include "utils/ucc_coll_utils.h"
+#include "utils/ucc_dt_reduce.h"
+
+/* Latency optimal allreduce for small messages: log2(pof2) steps exchanging
+   the whole vector, where pof2 is the largest power of 2 not greater than
+   team size. For non power of 2 teams first 2 * (size - pof2) ranks are
+   paired: even rank (extra) sends its data to odd one (proxy) before the
+   main loop and receives the result after it.
+   - recursive doubling: step s peer is vrank ^ 2^s
+   - swing: step s peer is vrank +/- rho(s), rho(s) = sum_{i=0..s} (-2)^i,
+     "+" for even and "-" for odd vranks. Peers are close to each other in
+     the first steps, which reduces congestion on torus/dragonfly networks.
+   Host buffers of predefined integer and floating point types are reduced
+   in-line, other cases go through executor. */
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allreduce_rd.phase = _phase;                                     \
+    } while (0)
+
+#define UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, _OP)             \
+    do {                                                                       \
+        const _type *_p1 = (const _type *)(_s1);                              \
+        const _type *_p2 = (const _type *)(_s2);                              \
+        _type       *_pd = (_type *)(_d);                                      \
+        size_t       _i;                                                       \
+                                                                               \
+        for (_i = 0; _i < (_count); _i++) {                                    \
+            _pd[_i] = _OP##_2(_p1[_i], _p2[_i]);                               \
+        }                                                                      \
+    } while (0)
+
+#define UCC_TL_UCP_RD_REDUCE_INT(_type, _s1, _s2, _d, _count, _op)            \
+    do {                                                                       \
+        switch (_op) {                                                         \
+        case UCC_OP_SUM:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_SUM);   \
+            break;                                                             \
+        case UCC_OP_PROD:                                                      \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_PROD);  \
+            break;                                                             \
+        case UCC_OP_MAX:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_MAX);   \
+            break;                                                             \
+        case UCC_OP_MIN:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_MIN);   \
+            break;                                                             \
+        case UCC_OP_LAND:                                                      \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_LAND);  \
+            break;                                                             \
+        case UCC_OP_LOR:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_LOR);   \
+            break;                                                             \
+        case UCC_OP_LXOR:                                                      \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_LXOR);  \
+            break;                                                             \
+        case UCC_OP_BAND:                                                      \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_BAND);  \
+            break;                                                             \
+        case UCC_OP_BOR:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_BOR);   \
+            break;                                                             \
+        case UCC_OP_BXOR:                                                      \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_BXOR);  \
+            break;                                                             \
+        default:                                                               \
+            return UCC_ERR_NOT_SUPPORTED;                                      \
+        }                                                                      \
+    } while (0)
+
+#define UCC_TL_UCP_RD_REDUCE_FLOAT(_type, _s1, _s2, _d, _count, _op, _alpha)  \
+    do {                                                                       \
+        size_t _j;                                                             \
+                                                                               \
+        switch (_op) {                                                         \
+        case UCC_OP_SUM:                                                       \
+        case UCC_OP_AVG:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_SUM);   \
+            if ((_alpha) != 1.0) {                                             \
+                for (_j = 0; _j < (_count); _j++) {                            \
+                    ((_type *)(_d))[_j] *= (_type)(_alpha);                    \
+                }                                                              \
+            }                                                                  \
+            break;                                                             \
+        case UCC_OP_PROD:                                                      \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_PROD);  \
+            break;                                                             \
+        case UCC_OP_MAX:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_MAX);   \
+            break;                                                             \
+        case UCC_OP_MIN:                                                       \
+            UCC_TL_UCP_RD_REDUCE_OP(_type, _s1, _s2, _d, _count, DO_OP_MIN);   \
+            break;                                                             \
+        default:                                                               \
+            return UCC_ERR_NOT_SUPPORTED;                                      \
+        }                                                                      \
+    } while (0)
+
+static inline ucc_status_t
+ucc_tl_ucp_allreduce_rd_reduce_inline(const void *s1, const void *s2, void *d,
+                                      size_t count, ucc_datatype_t dt,
+                                      ucc_reduction_op_t op, double alpha)
+{
+    switch (dt) {
+    case UCC_DT_INT8:
+        UCC_TL_UCP_RD_REDUCE_INT(int8_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_INT16:
+        UCC_TL_UCP_RD_REDUCE_INT(int16_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_INT32:
+        UCC_TL_UCP_RD_REDUCE_INT(int32_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_INT64:
+        UCC_TL_UCP_RD_REDUCE_INT(int64_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_UINT8:
+        UCC_TL_UCP_RD_REDUCE_INT(uint8_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_UINT16:
+        UCC_TL_UCP_RD_REDUCE_INT(uint16_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_UINT32:
+        UCC_TL_UCP_RD_REDUCE_INT(uint32_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_UINT64:
+        UCC_TL_UCP_RD_REDUCE_INT(uint64_t, s1, s2, d, count, op);
+        break;
+    case UCC_DT_FLOAT32:
+        UCC_TL_UCP_RD_REDUCE_FLOAT(float, s1, s2, d, count, op, alpha);
+        break;
+    case UCC_DT_FLOAT64:
+        UCC_TL_UCP_RD_REDUCE_FLOAT(double, s1, s2, d, count, op, alpha);
+        break;
+    default:
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    return UCC_OK;
+}
+
+static inline int ucc_tl_ucp_allreduce_rd_inline_supported(ucc_coll_args_t *args)
+{
+    ucc_datatype_t dt = args->dst.info.datatype;
+
+    if (args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST ||
+        !UCC_DT_IS_PREDEFINED(dt)) {
+        return 0;
+    }
+    switch (dt) {
+    case UCC_DT_FLOAT32:
+    case UCC_DT_FLOAT64:
+        return args->op == UCC_OP_SUM || args->op == UCC_OP_AVG ||
+               args->op == UCC_OP_PROD || args->op == UCC_OP_MAX ||
+               args->op == UCC_OP_MIN;
+    case UCC_DT_INT8:
+    case UCC_DT_INT16:
+    case UCC_DT_INT32:
+    case UCC_DT_INT64:
+    case UCC_DT_UINT8:
+    case UCC_DT_UINT16:
+    case UCC_DT_UINT32:
+    case UCC_DT_UINT64:
+        return args->op >= UCC_OP_SUM && args->op <= UCC_OP_BXOR;
+    default:
+        return 0;
+    }
+}
+
+/* maps virtual rank of the power of 2 group to team rank */
+static inline ucc_rank_t ucc_tl_ucp_allreduce_rd_vrank_to_rank(ucc_rank_t vrank,
+                                                               ucc_rank_t n_extra)
+{
+    return vrank < n_extra ? vrank * 2 + 1 : vrank + n_extra;
+}
+
+static inline ucc_rank_t ucc_tl_ucp_allreduce_rd_peer(ucc_rank_t vrank,
+                                                      int step, ucc_rank_t pof2,
+                                                      int swing)
+{
+    int64_t rho;
+
+    if (!swing) {
+        return vrank ^ (1 << step);
+    }
+    /* (1 - (-2)^(step + 1)) / 3 */
+    rho = (1 - ((step & 1) ? 1 : -1) * ((int64_t)2 << step)) / 3;
+    if (vrank % 2) {
+        rho = -rho;
+    }
+    return (ucc_rank_t)(((int64_t)vrank + rho + pof2) % pof2);
+}
+
+static inline ucc_status_t
+ucc_tl_ucp_allreduce_rd_reduce(ucc_tl_ucp_task_t *task, void *src1, void *src2,
+                               int is_avg)
+{
+    ucc_coll_args_t *args  = &TASK_ARGS(task);
+    size_t           count = args->dst.info.count;
+    ucc_datatype_t   dt    = args->dst.info.datatype;
+
+    if (task->allreduce_rd.inline_reduce) {
+        task->allreduce_rd.etask = NULL;
+        return ucc_tl_ucp_allreduce_rd_reduce_inline(
+            src1, src2, args->dst.info.buffer, count, dt, args->op,
+            is_avg ? AVG_ALPHA(task) : 1.0);
+    }
+    return ucc_dt_reduce(src1, src2, args->dst.info.buffer, count, dt, args,
+                         is_avg ? UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA : 0,
+                         AVG_ALPHA(task), task->allreduce_rd.executor,
+                         &task->allreduce_rd.etask);
+}
+
+void ucc_tl_ucp_allreduce_rd_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task      = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args      = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team      = TASK_TEAM(task);
+    ucc_rank_t         size      = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         rank      = task->subset.myrank;
+    ucc_rank_t         pof2      = (ucc_rank_t)1 << ucc_ilog2(size);
+    ucc_rank_t         n_extra   = size - pof2;
+    int                n_steps   = ucc_ilog2(pof2);
+    void              *scratch   = task->allreduce_rd.scratch;
+    void              *rbuf      = args->dst.info.buffer;
+    void              *sbuf      = UCC_IS_INPLACE(*args) ? rbuf
+                                                         : args->src.info.buffer;
+    ucc_memory_type_t  mem_type  = args->dst.info.mem_type;
+    size_t             data_size = args->dst.info.count *
+                                   ucc_dt_size(args->dst.info.datatype);
+    int                is_extra  = rank < 2 * n_extra && !(rank % 2);
+    int                is_proxy  = rank < 2 * n_extra && (rank % 2);
+    ucc_rank_t         vrank, peer;
+    ucc_status_t       status;
+    void              *send_buf;
+
+    UCC_KN_REDUCE_GOTO_PHASE(task->allreduce_rd.phase);
+
+    if (is_extra) {
+        peer = ucc_ep_map_eval(task->subset.map, rank + 1);
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_send_nb(sbuf, data_size, mem_type, peer, team, task),
+            task, out);
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_recv_nb(rbuf, data_size, mem_type, peer, team, task),
+            task, out);
+    } else if (is_proxy) {
+        peer = ucc_ep_map_eval(task->subset.map, rank - 1);
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_recv_nb(scratch, data_size, mem_type, peer, team, task),
+            task, out);
+    }
+UCC_KN_PHASE_EXTRA:
+    if (is_extra || is_proxy) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(UCC_KN_PHASE_EXTRA);
+            return;
+        }
+        if (is_extra) {
+            goto completion;
+        }
+        status = ucc_tl_ucp_allreduce_rd_reduce(task, sbuf, scratch, 0);
+        if (ucc_unlikely(status != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+            task->super.status = status;
+            return;
+        }
+UCC_KN_PHASE_EXTRA_REDUCE:
+        EXEC_TASK_TEST(UCC_KN_PHASE_EXTRA_REDUCE,
+                       "failed to perform dt reduction",
+                       task->allreduce_rd.etask);
+    }
+    vrank = is_proxy ? rank / 2 : rank - n_extra;
+    while (task->allreduce_rd.step < n_steps) {
+        peer = ucc_tl_ucp_allreduce_rd_peer(vrank, task->allreduce_rd.step,
+                                            pof2, task->allreduce_rd.swing);
+        peer = ucc_ep_map_eval(task->subset.map,
+                               ucc_tl_ucp_allreduce_rd_vrank_to_rank(peer,
+                                                                     n_extra));
+        send_buf = (task->allreduce_rd.step == 0 && !is_proxy) ? sbuf : rbuf;
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_send_nb(send_buf, data_size, mem_type, peer, team, task),
+            task, out);
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_recv_nb(scratch, data_size, mem_type, peer, team, task),
+            task, out);
+UCC_KN_PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(UCC_KN_PHASE_LOOP);
+            return;
+        }
+        send_buf = (task->allreduce_rd.step == 0 && !is_proxy) ? sbuf : rbuf;
+        status   = ucc_tl_ucp_allreduce_rd_reduce(
+            task, send_buf, scratch,
+            args->op == UCC_OP_AVG && task->allreduce_rd.step == n_steps - 1);
+        if (ucc_unlikely(status != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+            task->super.status = status;
+            return;
+        }
+UCC_KN_PHASE_REDUCE:
+        EXEC_TASK_TEST(UCC_KN_PHASE_REDUCE, "failed to perform dt reduction",
+                       task->allreduce_rd.etask);
+        task->allreduce_rd.step++;
+    }
+    if (is_proxy) {
+        peer = ucc_ep_map_eval(task->subset.map, rank - 1);
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_send_nb(rbuf, data_size, mem_type, peer, team, task),
+            task, out);
+    }
+UCC_KN_PHASE_PROXY:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(UCC_KN_PHASE_PROXY);
+        return;
+    }
+completion:
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allreduce_rd_done", 0);
+UCC_KN_PHASE_COMPLETE: /* unused label */
+out:
+    return;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_rd_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allreduce_rd_start", 0);
+    task->allreduce_rd.phase = UCC_KN_PHASE_INIT;
+    task->allreduce_rd.step  = 0;
+    task->allreduce_rd.etask = NULL;
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    if (task->subset.map.ep_num == 1) {
+        if (!UCC_IS_INPLACE(*args)) {
+            status = ucc_mc_memcpy(args->dst.info.buffer, args->src.info.buffer,
+                                   args->dst.info.count *
+                                       ucc_dt_size(args->dst.info.datatype),
+                                   args->dst.info.mem_type,
+                                   args->src.info.mem_type);
+            if (ucc_unlikely(status != UCC_OK)) {
+                return status;
+            }
+        }
+        task->super.status = UCC_OK;
+        return ucc_task_complete(coll_task);
+    }
+    if (!task->allreduce_rd.inline_reduce) {
+        status = ucc_coll_task_get_executor(&task->super,
+                                            &task->allreduce_rd.executor);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_rd_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->allreduce_rd.scratch_mc_header) {
+        global_st = ucc_mc_free(task->allreduce_rd.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    } else {
+        ucc_mpool_put(task->allreduce_rd.scratch);
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_rd_init_common(ucc_base_coll_args_t *coll_args,
+                                    ucc_base_team_t *team,
+                                    ucc_coll_task_t **task_h, int swing)
+{
+    ucc_tl_ucp_team_t *tl_team   = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t   *args      = &coll_args->args;
+    size_t             data_size = args->dst.info.count *
+                                   ucc_dt_size(args->dst.info.datatype);
+    ucc_tl_ucp_task_t *task;
+    ucc_sbgp_t        *sbgp;
+    ucc_status_t       status;
+
+    ALLREDUCE_TASK_CHECK(*args, tl_team);
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_allreduce_rd_start;
+    task->super.progress = ucc_tl_ucp_allreduce_rd_progress;
+    task->super.finalize = ucc_tl_ucp_allreduce_rd_finalize;
+    task->allreduce_rd.swing             = swing;
+    task->allreduce_rd.scratch_mc_header = NULL;
+    task->allreduce_rd.inline_reduce     =
+        ucc_tl_ucp_allreduce_rd_inline_supported(args);
+    if (!task->allreduce_rd.inline_reduce) {
+        task->super.flags |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    }
+
+    if (!(task->flags & UCC_TL_UCP_TASK_FLAG_SUBSET) &&
+        tl_team->cfg.use_reordering) {
+        sbgp = ucc_topo_get_sbgp(tl_team->topo, UCC_SBGP_FULL_HOST_ORDERED);
+        task->subset.myrank = sbgp->group_rank;
+        task->subset.map    = sbgp->map;
+    }
+
+    /* small host messages take the scratch from the context mpool */
+    if (args->dst.info.mem_type == UCC_MEMORY_TYPE_HOST &&
+        data_size <= UCC_TL_UCP_SCRATCH_MP_SIZE) {
+        task->allreduce_rd.scratch =
+            ucc_mpool_get(&UCC_TL_UCP_TEAM_CTX(tl_team)->scratch_mp);
+        if (ucc_unlikely(!task->allreduce_rd.scratch)) {
+            tl_error(UCC_TASK_LIB(task), "failed to get scratch buffer");
+            ucc_tl_ucp_put_task(task);
+            return UCC_ERR_NO_MEMORY;
+        }
+    } else {
+        status = ucc_mc_alloc(&task->allreduce_rd.scratch_mc_header, data_size,
+                              args->dst.info.mem_type);
+        if (ucc_unlikely(status != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+            ucc_tl_ucp_put_task(task);
+            return status;
+        }
+        task->allreduce_rd.scratch =
+            task->allreduce_rd.scratch_mc_header->addr;
+    }
+    *task_h = &task->super;
+    return UCC_OK;
+out:
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_rd_init(ucc_base_coll_args_t *coll_args,
+                                          ucc_base_team_t      *team,
+                                          ucc_coll_task_t     **task_h)
+{
+    return ucc_tl_ucp_allreduce_rd_init_common(coll_args, team, task_h, 0);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_swing_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h)
+{
+    return ucc_tl_ucp_allreduce_rd_init_common(coll_args, team, task_h, 1);
+}
@@ -0,0 +1,385 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allreduce.h"
+#include "tl_ucp_sendrecv.h"
+#include "core/ucc_progress_queue.h"
+#include "components/mc/ucc_mc.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "utils/ucc_dt_reduce.h"
+
+/* Ring allreduce: n - 1 reduce-scatter steps followed by n - 1 allgather
+   steps. Every block is split into n_frags fragments and the whole algorithm
+   is a single stream of 2 * (n - 1) * n_frags fragments received from the left
+   neighbour, so that reduction of a fragment overlaps with the receive of the
+   next one and with the send of the previous one:
+   - reduce-scatter fragment is received into one of 2 scratch slots, reduced
+     with local data into dst and forwarded as the next step fragment
+   - allgather fragment is received into dst and forwarded unless the step is
+     the last one
+   Fragments are sent and received in the same order by all ranks. */
+
+static inline void ucc_tl_ucp_allreduce_ring_frag(ucc_tl_ucp_task_t *task,
+                                                  uint32_t frag, size_t *offset,
+                                                  size_t *count)
+{
+    ucc_rank_t size    = task->subset.map.ep_num;
+    ucc_rank_t rank    = task->subset.myrank;
+    size_t     total   = TASK_ARGS(task).dst.info.count;
+    int        n_frags = task->allreduce_ring.n_frags;
+    uint32_t   n_rs    = (size - 1) * n_frags;
+    uint32_t   step;
+    ucc_rank_t block;
+    size_t     block_count;
+
+    if (frag < n_rs) {
+        step  = frag / n_frags;
+        block = (rank - step - 1 + size) % size;
+    } else {
+        step  = (frag - n_rs) / n_frags;
+        block = (rank - step + size) % size;
+    }
+    block_count = ucc_buffer_block_count(total, size, block);
+    *count      = ucc_buffer_block_count(block_count, n_frags, frag % n_frags);
+    *offset     = ucc_buffer_block_offset(total, size, block) +
+                  ucc_buffer_block_offset(block_count, n_frags,
+                                          frag % n_frags);
+}
+
+static inline ucc_status_t
+ucc_tl_ucp_allreduce_ring_post_recv(ucc_tl_ucp_task_t *task, uint32_t frag,
+                                    ucc_rank_t recvfrom)
+{
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    size_t             dt_size = ucc_dt_size(args->dst.info.datatype);
+    uint32_t           n_rs    = (task->subset.map.ep_num - 1) *
+                                 task->allreduce_ring.n_frags;
+    size_t             offset, count;
+    void              *rbuf;
+
+    ucc_tl_ucp_allreduce_ring_frag(task, frag, &offset, &count);
+    if (frag < n_rs) {
+        rbuf = PTR_OFFSET(task->allreduce_ring.scratch,
+                          (frag % 2) * task->allreduce_ring.max_frag_count *
+                              dt_size);
+    } else {
+        rbuf = PTR_OFFSET(args->dst.info.buffer, offset * dt_size);
+    }
+    return ucc_tl_ucp_recv_nb(rbuf, count * dt_size, args->dst.info.mem_type,
+                              recvfrom, team, task);
+}
+
+static inline ucc_status_t
+ucc_tl_ucp_allreduce_ring_send_dst(ucc_tl_ucp_task_t *task, uint32_t frag,
+                                   ucc_rank_t sendto)
+{
+    ucc_coll_args_t *args    = &TASK_ARGS(task);
+    size_t           dt_size = ucc_dt_size(args->dst.info.datatype);
+    size_t           offset, count;
+
+    ucc_tl_ucp_allreduce_ring_frag(task, frag, &offset, &count);
+    return ucc_tl_ucp_send_nb(PTR_OFFSET(args->dst.info.buffer,
+                                         offset * dt_size),
+                              count * dt_size, args->dst.info.mem_type, sendto,
+                              TASK_TEAM(task), task);
+}
+
+static void ucc_tl_ucp_allreduce_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
+    ucc_rank_t         size     = task->subset.map.ep_num;
+    ucc_rank_t         rank     = task->subset.myrank;
+    ucc_datatype_t     dt       = args->dst.info.datatype;
+    size_t             dt_size  = ucc_dt_size(dt);
+    int                n_frags  = task->allreduce_ring.n_frags;
+    uint32_t           n_rs     = (size - 1) * n_frags;
+    uint32_t           n_total  = 2 * n_rs;
+    void              *sbuf     = UCC_IS_INPLACE(*args) ? args->dst.info.buffer
+                                                        : args->src.info.buffer;
+    ucc_rank_t         sendto   = ucc_ep_map_eval(task->subset.map,
+                                                  (rank + 1) % size);
+    ucc_rank_t         recvfrom = ucc_ep_map_eval(task->subset.map,
+                                                  (rank - 1 + size) % size);
+    size_t             offset, count;
+    uint32_t           frag;
+    ucc_status_t       status;
+    void              *scratch;
+    int                is_avg;
+
+    while (1) {
+        if (task->allreduce_ring.reducing) {
+            if (task->allreduce_ring.etask) {
+                status = ucc_ee_executor_task_test(task->allreduce_ring.etask);
+                if (status > 0) {
+                    return;
+                }
+                ucc_ee_executor_task_finalize(task->allreduce_ring.etask);
+                task->allreduce_ring.etask = NULL;
+                if (ucc_unlikely(status < 0)) {
+                    tl_error(UCC_TASK_LIB(task), "failed to perform reduction");
+                    task->super.status = status;
+                    return;
+                }
+            }
+            task->allreduce_ring.reducing = 0;
+            /* reduced fragment is the next step fragment, after the last
+               reduce-scatter step it is the first allgather one */
+            UCPCHECK_GOTO(ucc_tl_ucp_allreduce_ring_send_dst(
+                              task, task->allreduce_ring.frag - 1, sendto),
+                          task, out);
+        }
+        if (task->allreduce_ring.frag == n_total) {
+            break;
+        }
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        frag = task->allreduce_ring.frag++;
+        /* the other scratch slot is free: its fragment is reduced already */
+        if (frag + 1 < n_total) {
+            UCPCHECK_GOTO(ucc_tl_ucp_allreduce_ring_post_recv(task, frag + 1,
+                                                              recvfrom),
+                          task, out);
+        }
+        if (frag < n_rs) {
+            ucc_tl_ucp_allreduce_ring_frag(task, frag, &offset, &count);
+            scratch = PTR_OFFSET(task->allreduce_ring.scratch,
+                                 (frag % 2) *
+                                     task->allreduce_ring.max_frag_count *
+                                     dt_size);
+            is_avg  = (args->op == UCC_OP_AVG) &&
+                      (frag / n_frags == size - 2);
+            task->allreduce_ring.reducing = 1;
+            if (count > 0) {
+                status = ucc_dt_reduce(
+                    scratch, PTR_OFFSET(sbuf, offset * dt_size),
+                    PTR_OFFSET(args->dst.info.buffer, offset * dt_size), count,
+                    dt, args, is_avg ? UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA : 0,
+                    AVG_ALPHA(task), task->allreduce_ring.executor,
+                    &task->allreduce_ring.etask);
+                if (ucc_unlikely(UCC_OK != status)) {
+                    tl_error(UCC_TASK_LIB(task), "failed to post reduction");
+                    task->super.status = status;
+                    return;
+                }
+            }
+        } else if (frag - n_rs < (size - 2) * n_frags) {
+            UCPCHECK_GOTO(ucc_tl_ucp_allreduce_ring_send_dst(task, frag,
+                                                             sendto),
+                          task, out);
+        }
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+    task->super.status = UCC_OK;
+out:
+    return;
+}
+
+static ucc_status_t ucc_tl_ucp_allreduce_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         size     = task->subset.map.ep_num;
+    ucc_rank_t         rank     = task->subset.myrank;
+    size_t             dt_size  = ucc_dt_size(args->dst.info.datatype);
+    void              *sbuf     = UCC_IS_INPLACE(*args) ? args->dst.info.buffer
+                                                        : args->src.info.buffer;
+    ucc_rank_t         sendto   = ucc_ep_map_eval(task->subset.map,
+                                                  (rank + 1) % size);
+    ucc_rank_t         recvfrom = ucc_ep_map_eval(task->subset.map,
+                                                  (rank - 1 + size) % size);
+    size_t             total    = args->dst.info.count;
+    size_t             block_count, block_offset, frag_count, frag_offset;
+    ucc_status_t       status;
+    int                f;
+
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    task->allreduce_ring.frag     = 0;
+    task->allreduce_ring.reducing = 0;
+    task->allreduce_ring.etask    = NULL;
+    status = ucc_coll_task_get_executor(&task->super,
+                                        &task->allreduce_ring.executor);
+    if (ucc_unlikely(status != UCC_OK)) {
+        return status;
+    }
+
+    UCPCHECK_GOTO(ucc_tl_ucp_allreduce_ring_post_recv(task, 0, recvfrom),
+                  task, out);
+    /* first reduce-scatter step sends own block of the local data */
+    block_count  = ucc_buffer_block_count(total, size, rank);
+    block_offset = ucc_buffer_block_offset(total, size, rank);
+    for (f = 0; f < task->allreduce_ring.n_frags; f++) {
+        frag_count  = ucc_buffer_block_count(block_count,
+                                             task->allreduce_ring.n_frags, f);
+        frag_offset = ucc_buffer_block_offset(block_count,
+                                              task->allreduce_ring.n_frags, f);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(
+                          PTR_OFFSET(sbuf,
+                                     (block_offset + frag_offset) * dt_size),
+                          frag_count * dt_size, args->dst.info.mem_type,
+                          sendto, team, task),
+                      task, out);
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+out:
+    return task->super.status;
+}
+
+static ucc_status_t ucc_tl_ucp_allreduce_ring_init_subset(
+    ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
+    ucc_coll_task_t **task_h, ucc_subset_t *subset, int n_frags,
+    size_t max_frag_count, void *scratch)
+{
+    ucc_tl_ucp_task_t *task;
+
+    task = ucc_tl_ucp_init_task(coll_args, team);
+    if (ucc_unlikely(!task)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->super.post                    = ucc_tl_ucp_allreduce_ring_start;
+    task->super.progress                = ucc_tl_ucp_allreduce_ring_progress;
+    task->subset                        = *subset;
+    task->allreduce_ring.n_frags        = n_frags;
+    task->allreduce_ring.max_frag_count = max_frag_count;
+    task->allreduce_ring.scratch        = scratch;
+    *task_h                             = &task->super;
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_ring_sched_post(ucc_coll_task_t *coll_task)
+{
+    return ucc_schedule_start(coll_task);
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_ring_sched_finalize(ucc_coll_task_t *task)
+{
+    ucc_tl_ucp_schedule_t *schedule = ucc_derived_of(task,
+                                                     ucc_tl_ucp_schedule_t);
+    ucc_status_t           status;
+
+    ucc_mc_free(schedule->scratch_mc_header);
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(&schedule->super.super);
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t     *tl_team  = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_rank_t             size     = UCC_TL_TEAM_SIZE(tl_team);
+    ucc_coll_args_t       *args     = &coll_args->args;
+    size_t                 count    = args->dst.info.count;
+    size_t                 dt_size  = ucc_dt_size(args->dst.info.datatype);
+    ucc_memory_type_t      mem_type = args->dst.info.mem_type;
+    int                    bidir    =
+        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.allreduce_ring_bidirectional;
+    size_t                 frag_size =
+        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.allreduce_ring_frag_size;
+    ucc_base_coll_args_t   sub_args[2];
+    size_t                 frag_count[2], max_block, offset, slot_count;
+    int                    n_frags[2];
+    ucc_tl_ucp_schedule_t *tl_schedule;
+    ucc_schedule_t        *schedule;
+    ucc_coll_task_t       *ctask;
+    ucc_status_t           status;
+    ucc_subset_t           s[2];
+    int                    i, n_subsets;
+
+    if ((!UCC_IS_INPLACE(*args) && args->src.info.mem_type != mem_type) ||
+        (UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.reduce_avg_pre_op &&
+         args->op == UCC_OP_AVG)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    /* every ring needs at least 1 element per block */
+    if (size < 2 || count < size) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    n_subsets = (bidir && (count >= 2 * size)) ? 2 : 1;
+
+    status = ucc_tl_ucp_get_schedule(tl_team, coll_args, &tl_schedule);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    schedule = &tl_schedule->super.super;
+
+    s[0].myrank     = UCC_TL_TEAM_RANK(tl_team);
+    s[0].map.type   = UCC_EP_MAP_FULL;
+    s[0].map.ep_num = size;
+    s[1].map        = ucc_ep_map_create_reverse(size);
+    s[1].myrank     = ucc_ep_map_eval(s[1].map, s[0].myrank);
+
+    /* rings run over the 2 halves of the buffer, every ring needs 2 scratch
+       fragments */
+    for (i = 0; i < n_subsets; i++) {
+        sub_args[i]                      = *coll_args;
+        offset                           = ucc_buffer_block_offset(count,
+                                                                   n_subsets, i);
+        sub_args[i].args.dst.info.count  = ucc_buffer_block_count(count,
+                                                                  n_subsets, i);
+        sub_args[i].args.dst.info.buffer =
+            PTR_OFFSET(args->dst.info.buffer, offset * dt_size);
+        if (!UCC_IS_INPLACE(*args)) {
+            sub_args[i].args.src.info.count  = sub_args[i].args.dst.info.count;
+            sub_args[i].args.src.info.buffer =
+                PTR_OFFSET(args->src.info.buffer, offset * dt_size);
+        }
+        max_block     = ucc_buffer_block_count(sub_args[i].args.dst.info.count,
+                                               size, 0);
+        n_frags[i]    = (frag_size && max_block * dt_size > frag_size)
+                            ? ucc_div_round_up(max_block * dt_size, frag_size)
+                            : 1;
+        frag_count[i] = ucc_buffer_block_count(max_block, n_frags[i], 0);
+    }
+    /* the halves may be split into different number of fragments, e.g. the
+       first one is 1 element bigger and crosses frag_size, so every ring
+       gets the scratch of the largest fragment */
+    slot_count = frag_count[0];
+    for (i = 1; i < n_subsets; i++) {
+        slot_count = ucc_max(slot_count, frag_count[i]);
+    }
+    UCC_CHECK_GOTO(ucc_mc_alloc(&tl_schedule->scratch_mc_header,
+                                2 * slot_count * n_subsets * dt_size,
+                                mem_type),
+                   out, status);
+    for (i = 0; i < n_subsets; i++) {
+        UCC_CHECK_GOTO(ucc_tl_ucp_allreduce_ring_init_subset(
+                           &sub_args[i], team, &ctask, &s[i], n_frags[i],
+                           frag_count[i],
+                           PTR_OFFSET(tl_schedule->scratch_mc_header->addr,
+                                      2 * slot_count * i * dt_size)),
+                       out_free, status);
+        ctask->n_deps = 1;
+        UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, ctask), out_free,
+                       status);
+        UCC_CHECK_GOTO(ucc_event_manager_subscribe(
+                           &schedule->super, UCC_EVENT_SCHEDULE_STARTED, ctask,
+                           ucc_task_start_handler),
+                       out_free, status);
+    }
+    schedule->super.flags   |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    schedule->super.post     = ucc_tl_ucp_allreduce_ring_sched_post;
+    schedule->super.finalize = ucc_tl_ucp_allreduce_ring_sched_finalize;
+    *task_h                  = &schedule->super;
+    return UCC_OK;
+
+out_free:
+    ucc_mc_free(tl_schedule->scratch_mc_header);
+out:
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
@@ -160,16 +160,21 @@ ucc_status_t ucc_tl_ucp_allreduce_sra_knomial_start(ucc_coll_task_t *task)
     return ucc_schedule_pipelined_post(task);
 }
 
-static void
+/* returns pipeline model slot for "auto" pipeline params or -1 */
+static int
 ucc_tl_ucp_allreduce_sra_knomial_get_pipeline_params(ucc_tl_ucp_team_t *team,
                                                      ucc_coll_args_t *args,
+                                                     size_t msgsize,
                                                      ucc_pipeline_params_t *pp)
 {
     ucc_tl_ucp_lib_config_t *cfg = &team->cfg;
 
     if (!ucc_pipeline_params_is_auto(&cfg->allreduce_sra_kn_pipeline)) {
         *pp = cfg->allreduce_sra_kn_pipeline;
-        return;
+        return ucc_pipeline_params_model(&team->super.super,
+                                         "ucp_allreduce_sra_kn",
+                                         args->dst.info.mem_type, msgsize, 0,
+                                         pp);
     }
 
     if ((args->src.info.mem_type == UCC_MEMORY_TYPE_CUDA) &&
@@ -188,8 +193,10 @@ ucc_tl_ucp_allreduce_sra_knomial_get_pipeline_params(ucc_tl_ucp_team_t *team,
         pp->frag_size = 0;
         pp->pdepth    = 1;
         pp->order     = UCC_PIPELINE_PARALLEL;
-
     }
+    return ucc_pipeline_params_model(&team->super.super,
+                                     "ucp_allreduce_sra_kn",
+                                     args->dst.info.mem_type, msgsize, 1, pp);
 }
 
 ucc_status_t
@@ -206,6 +213,7 @@ ucc_tl_ucp_allreduce_sra_knomial_init(ucc_base_coll_args_t *coll_args,
     ucc_base_coll_args_t      bargs;
     size_t                    max_frag_count;
     ucc_pipeline_params_t     pipeline_params;
+    int                       model_slot;
 
     st  = ucc_tl_ucp_get_schedule(tl_team, coll_args,
                                   (ucc_tl_ucp_schedule_t **)&schedule_p);
@@ -216,8 +224,8 @@ ucc_tl_ucp_allreduce_sra_knomial_init(ucc_base_coll_args_t *coll_args,
     bargs = *coll_args;
     max_frag_count = (bargs.mask & UCC_BASE_CARGS_MAX_FRAG_COUNT) ?
                      bargs.max_frag_count: args->dst.info.count;
-    ucc_tl_ucp_allreduce_sra_knomial_get_pipeline_params(tl_team, args,
-                                                         &pipeline_params);
+    model_slot = ucc_tl_ucp_allreduce_sra_knomial_get_pipeline_params(
+        tl_team, args, max_frag_count * dt_size, &pipeline_params);
     ucc_pipeline_nfrags_pdepth(&pipeline_params, max_frag_count * dt_size,
                                &n_frags, &pipeline_depth);
     if (n_frags > 1) {
@@ -236,6 +244,8 @@ ucc_tl_ucp_allreduce_sra_knomial_init(ucc_base_coll_args_t *coll_args,
         return st;
     }
 
+    ucc_schedule_pipelined_set_model(schedule_p, model_slot,
+                                     max_frag_count * dt_size);
     schedule_p->super.super.finalize = ucc_tl_ucp_allreduce_sra_knomial_finalize;
     schedule_p->super.super.post     = ucc_tl_ucp_allreduce_sra_knomial_start;
     *task_h = &schedule_p->super.super;
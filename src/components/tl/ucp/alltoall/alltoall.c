@@ -78,6 +78,9 @@ ucc_status_t ucc_tl_ucp_alltoall_onesided_init(ucc_base_coll_args_t *coll_args,
     ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
     ucc_tl_ucp_task_t *task;
     ucc_status_t       status;
+    ucc_memory_type_t  mtypes[2];
+    void              *bufs[2];
+    size_t             lens[2];
 
     ALLTOALL_TASK_CHECK(coll_args->args, tl_team);
 
@@ -87,19 +90,29 @@ ucc_status_t ucc_tl_ucp_alltoall_onesided_init(ucc_base_coll_args_t *coll_args,
         status = UCC_ERR_NOT_SUPPORTED;
         goto out;
     }
-    if (coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) {
-        if (!(coll_args->args.flags & UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
-            tl_error(UCC_TL_TEAM_LIB(tl_team),
-                     "non memory mapped buffers are not supported");
-            status = UCC_ERR_NOT_SUPPORTED;
-            goto out;
-        }
-    }
     task                 = ucc_tl_ucp_init_task(coll_args, team);
-    *task_h              = &task->super;
     task->super.post     = ucc_tl_ucp_alltoall_onesided_start;
     task->super.progress = ucc_tl_ucp_alltoall_onesided_progress;
-    status               = UCC_OK;
+    if ((coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) &&
+        !(coll_args->args.flags & UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
+        /* dst and work buffers are written by peers */
+        bufs[0]   = coll_args->args.dst.info.buffer;
+        lens[0]   = coll_args->args.dst.info.count *
+                    ucc_dt_size(coll_args->args.dst.info.datatype);
+        mtypes[0] = coll_args->args.dst.info.mem_type;
+        bufs[1]   = coll_args->args.global_work_buffer;
+        lens[1]   = sizeof(long);
+        mtypes[1] = UCC_MEMORY_TYPE_HOST;
+        status    = ucc_tl_ucp_dyn_segs_init(task, 2, bufs, lens, mtypes);
+        if (status != UCC_OK) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "failed to register non memory mapped buffers");
+            ucc_tl_ucp_put_task(task);
+            goto out;
+        }
+    }
+    *task_h = &task->super;
+    status  = UCC_OK;
 out:
     return status;
 }
@@ -13,9 +13,8 @@
 
 void ucc_tl_ucp_alltoall_onesided_progress(ucc_coll_task_t *ctask);
 
-ucc_status_t ucc_tl_ucp_alltoall_onesided_start(ucc_coll_task_t *ctask)
+static ucc_status_t ucc_tl_ucp_alltoall_onesided_puts(ucc_tl_ucp_task_t *task)
 {
-    ucc_tl_ucp_task_t *task   = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
     ptrdiff_t          src    = (ptrdiff_t)TASK_ARGS(task).src.info.buffer;
     ptrdiff_t          dest   = (ptrdiff_t)TASK_ARGS(task).dst.info.buffer;
@@ -26,35 +25,63 @@ ucc_status_t ucc_tl_ucp_alltoall_onesided_start(ucc_coll_task_t *ctask)
     long *             pSync  = TASK_ARGS(task).global_work_buffer;
     ucc_rank_t         peer;
 
-    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
     /* TODO: change when support for library-based work buffers is complete */
     nelems = (nelems / gsize) * ucc_dt_size(TASK_ARGS(task).src.info.datatype);
     dest   = dest + grank * nelems;
     UCPCHECK_GOTO(ucc_tl_ucp_put_nb((void *)(src + start * nelems),
                                     (void *)dest, nelems, start, team, task),
                   task, out);
-    UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, start, team), task, out);
+    UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, start, team, task), task, out);
 
     for (peer = (start + 1) % gsize; peer != start; peer = (peer + 1) % gsize) {
         UCPCHECK_GOTO(ucc_tl_ucp_put_nb((void *)(src + peer * nelems),
                                         (void *)dest, nelems, peer, team, task),
                       task, out);
-        UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, peer, team), task,
+        UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, peer, team, task), task,
                       out);
     }
-
-    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+    return UCC_OK;
 out:
     return task->super.status;
 }
 
+ucc_status_t ucc_tl_ucp_alltoall_onesided_start(ucc_coll_task_t *ctask)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    if (task->dyn_segs) {
+        /* puts are posted from progress once peers' rkeys are known */
+        status = ucc_tl_ucp_dyn_segs_exchange_start(task);
+    } else {
+        status = ucc_tl_ucp_alltoall_onesided_puts(task);
+    }
+    if (ucc_unlikely(status != UCC_OK)) {
+        return status;
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
 void ucc_tl_ucp_alltoall_onesided_progress(ucc_coll_task_t *ctask)
 {
     ucc_tl_ucp_task_t *task  = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
     ucc_rank_t         gsize = UCC_TL_TEAM_SIZE(team);
     long *             pSync = TASK_ARGS(task).global_work_buffer;
+    ucc_status_t       status;
 
+    if (!ucc_tl_ucp_dyn_segs_ready(task)) {
+        status = ucc_tl_ucp_dyn_segs_exchange_test(task);
+        if (status == UCC_OK) {
+            status = ucc_tl_ucp_alltoall_onesided_puts(task);
+        }
+        if (status != UCC_OK) {
+            task->super.status = status;
+            return;
+        }
+    }
     if (ucc_tl_ucp_test_onesided(task, gsize) == UCC_INPROGRESS) {
         return;
     }
@@ -11,9 +11,9 @@
 #include "utils/ucc_math.h"
 #include "tl_ucp_sendrecv.h"
 
-ucc_status_t ucc_tl_ucp_alltoallv_onesided_start(ucc_coll_task_t *ctask)
+static ucc_status_t
+ucc_tl_ucp_alltoallv_onesided_puts(ucc_tl_ucp_task_t *task)
 {
-    ucc_tl_ucp_task_t *task     = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
     ptrdiff_t          src      = (ptrdiff_t)TASK_ARGS(task).src.info_v.buffer;
     ptrdiff_t          dest     = (ptrdiff_t)TASK_ARGS(task).dst.info_v.buffer;
@@ -27,8 +27,6 @@ ucc_status_t ucc_tl_ucp_alltoallv_onesided_start(ucc_coll_task_t *ctask)
     ucc_rank_t         peer;
     size_t             sd_disp, dd_disp, data_size;
 
-    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
-
     /* perform a put to each member peer using the peer's index in the
      * destination displacement. */
     for (peer = (grank + 1) % gsize; task->onesided.put_posted < gsize;
@@ -48,20 +46,50 @@ ucc_status_t ucc_tl_ucp_alltoallv_onesided_start(ucc_coll_task_t *ctask)
                                         PTR_OFFSET(dest, dd_disp),
                                         data_size, peer, team, task),
                       task, out);
-        UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, peer, team), task, out);
+        UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, peer, team, task), task,
+                      out);
     }
-    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+    return UCC_OK;
 out:
     return task->super.status;
 }
 
+ucc_status_t ucc_tl_ucp_alltoallv_onesided_start(ucc_coll_task_t *ctask)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    if (task->dyn_segs) {
+        status = ucc_tl_ucp_dyn_segs_exchange_start(task);
+    } else {
+        status = ucc_tl_ucp_alltoallv_onesided_puts(task);
+    }
+    if (ucc_unlikely(status != UCC_OK)) {
+        return status;
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
 void ucc_tl_ucp_alltoallv_onesided_progress(ucc_coll_task_t *ctask)
 {
     ucc_tl_ucp_task_t *task  = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
     ucc_rank_t         gsize = UCC_TL_TEAM_SIZE(team);
     long              *pSync = TASK_ARGS(task).global_work_buffer;
+    ucc_status_t       status;
 
+    if (!ucc_tl_ucp_dyn_segs_ready(task)) {
+        status = ucc_tl_ucp_dyn_segs_exchange_test(task);
+        if (status == UCC_OK) {
+            status = ucc_tl_ucp_alltoallv_onesided_puts(task);
+        }
+        if (status != UCC_OK) {
+            task->super.status = status;
+            return;
+        }
+    }
     if (ucc_tl_ucp_test_onesided(task, gsize) == UCC_INPROGRESS) {
         return;
     }
@@ -70,6 +98,35 @@ void ucc_tl_ucp_alltoallv_onesided_progress(ucc_coll_task_t *ctask)
     task->super.status = UCC_OK;
 }
 
+/* Registers dst and work buffers that peers write to */
+static ucc_status_t
+ucc_tl_ucp_alltoallv_onesided_dyn_segs_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t  *args     = &TASK_ARGS(task);
+    ucc_rank_t        gsize    = UCC_TL_TEAM_SIZE(TASK_TEAM(task));
+    size_t            rdt_size = ucc_dt_size(args->dst.info_v.datatype);
+    ucc_memory_type_t mtypes[2];
+    void             *bufs[2];
+    size_t            lens[2];
+    size_t            end;
+    ucc_rank_t        peer;
+
+    lens[0] = 0;
+    for (peer = 0; peer < gsize; peer++) {
+        end = (ucc_coll_args_get_displacement(
+                   args, args->dst.info_v.displacements, peer) +
+               ucc_coll_args_get_count(args, args->dst.info_v.counts, peer)) *
+              rdt_size;
+        lens[0] = ucc_max(lens[0], end);
+    }
+    bufs[0]   = args->dst.info_v.buffer;
+    mtypes[0] = args->dst.info_v.mem_type;
+    bufs[1]   = args->global_work_buffer;
+    lens[1]   = sizeof(long);
+    mtypes[1] = UCC_MEMORY_TYPE_HOST;
+    return ucc_tl_ucp_dyn_segs_init(task, 2, bufs, lens, mtypes);
+}
+
 ucc_status_t ucc_tl_ucp_alltoallv_onesided_init(ucc_base_coll_args_t *coll_args,
                                                 ucc_base_team_t      *team,
                                                 ucc_coll_task_t     **task_h)
@@ -85,20 +142,22 @@ ucc_status_t ucc_tl_ucp_alltoallv_onesided_init(ucc_base_coll_args_t *coll_args,
         status = UCC_ERR_NOT_SUPPORTED;
         goto out;
     }
-    if (coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) {
-        if (!(coll_args->args.flags & UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
-            tl_error(UCC_TL_TEAM_LIB(tl_team),
-                     "non memory mapped buffers are not supported");
-            status = UCC_ERR_NOT_SUPPORTED;
-            goto out;
-        }
-    }
 
     task                 = ucc_tl_ucp_init_task(coll_args, team);
-    *task_h              = &task->super;
     task->super.post     = ucc_tl_ucp_alltoallv_onesided_start;
     task->super.progress = ucc_tl_ucp_alltoallv_onesided_progress;
-    status               = UCC_OK;
+    if ((coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) &&
+        !(coll_args->args.flags & UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
+        status = ucc_tl_ucp_alltoallv_onesided_dyn_segs_init(task);
+        if (status != UCC_OK) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "failed to register non memory mapped buffers");
+            ucc_tl_ucp_put_task(task);
+            goto out;
+        }
+    }
+    *task_h = &task->super;
+    status  = UCC_OK;
 out:
     return status;
 }
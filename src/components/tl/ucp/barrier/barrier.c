@@ -16,6 +16,16 @@ ucc_base_coll_alg_info_t
             {.id   = UCC_TL_UCP_BARRIER_ALG_KNOMIAL,
              .name = "knomial",
              .desc = "recursive knomial with arbitrary radix"},
+        [UCC_TL_UCP_BARRIER_ALG_DISSEMINATION] =
+            {.id   = UCC_TL_UCP_BARRIER_ALG_DISSEMINATION,
+             .name = "dissemination",
+             .desc = "dissemination with log2(team size) rounds of 1 "
+                     "message (optimized for large teams)"},
+        [UCC_TL_UCP_BARRIER_ALG_TOURNAMENT] =
+            {.id   = UCC_TL_UCP_BARRIER_ALG_TOURNAMENT,
+             .name = "tournament",
+             .desc = "tournament over binary combining tree of host ordered "
+                     "ranks (optimized for hierarchical systems)"},
         [UCC_TL_UCP_BARRIER_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
@@ -23,5 +33,17 @@ ucc_status_t ucc_tl_ucp_barrier_init(ucc_tl_ucp_task_t *task)
 {
     task->super.post     = ucc_tl_ucp_barrier_knomial_start;
     task->super.progress = ucc_tl_ucp_barrier_knomial_progress;
+    task->super.rebind   = ucc_tl_ucp_coll_rebind;
     return UCC_OK;
 }
+
+ucc_status_t ucc_tl_ucp_barrier_knomial_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+
+    task    = ucc_tl_ucp_init_task(coll_args, team);
+    *task_h = &task->super;
+    return ucc_tl_ucp_barrier_init(task);
+}
@@ -10,12 +10,45 @@
 
 enum {
     UCC_TL_UCP_BARRIER_ALG_KNOMIAL,
+    UCC_TL_UCP_BARRIER_ALG_DISSEMINATION,
+    UCC_TL_UCP_BARRIER_ALG_TOURNAMENT,
     UCC_TL_UCP_BARRIER_ALG_LAST
 };
 
+enum {
+    UCC_TL_UCP_BARRIER_PHASE_INIT,
+    UCC_TL_UCP_BARRIER_PHASE_WAIT,     /* recv of current round is posted */
+    UCC_TL_UCP_BARRIER_PHASE_RELEASE,  /* waiting for release */
+    UCC_TL_UCP_BARRIER_PHASE_COMPLETE, /* waiting for sends completion */
+};
+
 extern ucc_base_coll_alg_info_t
              ucc_tl_ucp_barrier_algs[UCC_TL_UCP_BARRIER_ALG_LAST + 1];
 
 ucc_status_t ucc_tl_ucp_barrier_init(ucc_tl_ucp_task_t *task);
 
+ucc_status_t ucc_tl_ucp_barrier_knomial_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h);
+
+ucc_status_t
+ucc_tl_ucp_barrier_dissemination_init(ucc_base_coll_args_t *coll_args,
+                                      ucc_base_team_t      *team,
+                                      ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_barrier_tournament_init(ucc_base_coll_args_t *coll_args,
+                                                ucc_base_team_t      *team,
+                                                ucc_coll_task_t     **task_h);
+
+static inline int ucc_tl_ucp_barrier_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_BARRIER_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_barrier_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
+
 #endif
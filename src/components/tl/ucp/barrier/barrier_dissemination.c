@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "barrier.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* ceil(log2(size)) rounds, in round k every rank notifies rank + 2^k and
+   waits for notification from rank - 2^k. There is no extra/proxy phase for
+   non power of 2 team sizes. Only receive completion is on the critical
+   path, sends are completed at the end. */
+void ucc_tl_ucp_barrier_dissemination_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         size     = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         rank     = task->subset.myrank;
+    int                n_rounds = ucc_ilog2_ceil(size);
+    ucc_memory_type_t  mtype    = UCC_MEMORY_TYPE_UNKNOWN;
+    ucc_rank_t         dist, peer;
+
+    while (task->barrier.round < n_rounds) {
+        if (task->barrier.phase != UCC_TL_UCP_BARRIER_PHASE_WAIT) {
+            dist = (ucc_rank_t)1 << task->barrier.round;
+            peer = ucc_ep_map_eval(task->subset.map, (rank + dist) % size);
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype, peer, team, task),
+                          task, out);
+            peer = ucc_ep_map_eval(task->subset.map,
+                                   (rank - dist + size) % size);
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype, peer, team, task),
+                          task, out);
+            task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_WAIT;
+        }
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_INIT;
+        task->barrier.round++;
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_dis_done", 0);
+out:
+    return;
+}
+
+ucc_status_t ucc_tl_ucp_barrier_dissemination_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_dis_start", 0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_INIT;
+    task->barrier.round = 0;
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+ucc_status_t
+ucc_tl_ucp_barrier_dissemination_init(ucc_base_coll_args_t *coll_args,
+                                      ucc_base_team_t      *team,
+                                      ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_barrier_dissemination_start;
+    task->super.progress = ucc_tl_ucp_barrier_dissemination_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "barrier.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Tournament barrier over binary combining tree. In round k rank with bit k
+   set loses: it notifies the winner rank - 2^k and waits for release, winner
+   waits for the loser and proceeds to the next round. Rank 0 wins the
+   tournament and starts release, every rank releases ranks it has beaten in
+   reverse order. When team topo is available ranks are ordered by host, so
+   the first rounds are played inside a node and only node winners exchange
+   messages over the network. */
+void ucc_tl_ucp_barrier_tournament_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         size     = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         rank     = task->subset.myrank;
+    int                n_rounds = ucc_ilog2_ceil(size);
+    ucc_memory_type_t  mtype    = UCC_MEMORY_TYPE_UNKNOWN;
+    ucc_rank_t         mask, peer;
+    int                r;
+
+    switch (task->barrier.phase) {
+    case UCC_TL_UCP_BARRIER_PHASE_WAIT:
+        goto arrive;
+    case UCC_TL_UCP_BARRIER_PHASE_RELEASE:
+        goto release;
+    case UCC_TL_UCP_BARRIER_PHASE_COMPLETE:
+        goto complete;
+    default:
+        break;
+    }
+
+    while (task->barrier.round < n_rounds) {
+        mask = (ucc_rank_t)1 << task->barrier.round;
+        if (rank & mask) {
+            peer = ucc_ep_map_eval(task->subset.map, rank - mask);
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype, peer, team, task),
+                          task, out);
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype, peer, team, task),
+                          task, out);
+            task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_RELEASE;
+            goto release;
+        }
+        if (rank + mask < size) {
+            peer = ucc_ep_map_eval(task->subset.map, rank + mask);
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype, peer, team, task),
+                          task, out);
+            task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_WAIT;
+arrive:
+            if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+                return;
+            }
+        }
+        task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_INIT;
+        task->barrier.round++;
+    }
+    task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_RELEASE;
+release:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+        return;
+    }
+    for (r = task->barrier.round - 1; r >= 0; r--) {
+        mask = (ucc_rank_t)1 << r;
+        if (rank + mask < size) {
+            peer = ucc_ep_map_eval(task->subset.map, rank + mask);
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype, peer, team, task),
+                          task, out);
+        }
+    }
+    task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_COMPLETE;
+complete:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_tour_done", 0);
+out:
+    return;
+}
+
+ucc_status_t ucc_tl_ucp_barrier_tournament_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_tour_start", 0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    task->barrier.phase = UCC_TL_UCP_BARRIER_PHASE_INIT;
+    task->barrier.round = 0;
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+ucc_status_t ucc_tl_ucp_barrier_tournament_init(ucc_base_coll_args_t *coll_args,
+                                                ucc_base_team_t      *team,
+                                                ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_sbgp_t        *sbgp;
+
+    task = ucc_tl_ucp_init_task(coll_args, team);
+    if (!(task->flags & UCC_TL_UCP_TASK_FLAG_SUBSET) && tl_team->topo) {
+        sbgp = ucc_topo_get_sbgp(tl_team->topo, UCC_SBGP_FULL_HOST_ORDERED);
+        task->subset.myrank = sbgp->group_rank;
+        task->subset.map    = sbgp->map;
+    }
+    task->super.post     = ucc_tl_ucp_barrier_tournament_start;
+    task->super.progress = ucc_tl_ucp_barrier_tournament_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -24,6 +24,16 @@ ucc_base_coll_alg_info_t
              .name = "dbt",
              .desc = "bcast over double binary tree where a leaf in one tree "
                      "will be intermediate in other (optimized for BW)"},
+        [UCC_TL_UCP_BCAST_ALG_CHAIN] =
+            {.id   = UCC_TL_UCP_BCAST_ALG_CHAIN,
+             .name = "chain",
+             .desc = "segmented pipeline over a chain of ranks "
+                     "(optimized for BW of very large messages)"},
+        [UCC_TL_UCP_BCAST_ALG_SAG_RING] =
+            {.id   = UCC_TL_UCP_BCAST_ALG_SAG_RING,
+             .name = "sag_ring",
+             .desc = "binomial scatter followed by ring allgather, "
+                     "pipelined by segments (optimized for BW)"},
         [UCC_TL_UCP_BCAST_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
@@ -37,6 +47,7 @@ ucc_status_t ucc_tl_ucp_bcast_init(ucc_tl_ucp_task_t *task)
 
     task->super.post     = ucc_tl_ucp_bcast_knomial_start;
     task->super.progress = ucc_tl_ucp_bcast_knomial_progress;
+    task->super.rebind   = ucc_tl_ucp_coll_rebind;
     return UCC_OK;
 }
 
@@ -52,3 +63,130 @@ ucc_status_t ucc_tl_ucp_bcast_knomial_init(ucc_base_coll_args_t *coll_args,
     *task_h = &task->super;
     return status;
 }
+
+static ucc_status_t ucc_tl_ucp_bcast_frag_start(ucc_coll_task_t *task)
+{
+    return ucc_schedule_start(task);
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_frag_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_status_t    status;
+
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_frag_setup(ucc_schedule_pipelined_t *schedule_p,
+                            ucc_schedule_t *frag, int frag_num)
+{
+    ucc_coll_args_t *args    = &schedule_p->super.super.bargs.args;
+    size_t           dt_size = ucc_dt_size(args->src.info.datatype);
+    int              n_frags = schedule_p->super.n_tasks;
+    ucc_coll_args_t *targs   = &frag->tasks[0]->bargs.args;
+    size_t           offset;
+
+    offset = ucc_buffer_block_offset(args->src.info.count, n_frags, frag_num);
+    targs->src.info.buffer = PTR_OFFSET(args->src.info.buffer,
+                                        offset * dt_size);
+    targs->src.info.count  = ucc_buffer_block_count(args->src.info.count,
+                                                    n_frags, frag_num);
+    return UCC_OK;
+}
+
+ucc_status_t
+ucc_tl_ucp_bcast_frag_init(ucc_base_coll_args_t *coll_args,
+                           ucc_base_team_t *team, ucc_schedule_t **frag_p,
+                           ucc_base_coll_init_fn_t task_init)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_schedule_t    *schedule;
+    ucc_coll_task_t   *task;
+    ucc_status_t       status;
+
+    status = ucc_tl_ucp_get_schedule(tl_team, coll_args,
+                                     (ucc_tl_ucp_schedule_t **)&schedule);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    UCC_CHECK_GOTO(task_init(coll_args, team, &task), out, status);
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, task), out, status);
+    UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super, task,
+                                          UCC_EVENT_SCHEDULE_STARTED),
+                   out, status);
+    schedule->super.post     = ucc_tl_ucp_bcast_frag_start;
+    schedule->super.finalize = ucc_tl_ucp_bcast_frag_finalize;
+    *frag_p                  = schedule;
+    return UCC_OK;
+out:
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_pipelined_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_status_t    status;
+
+    status = ucc_schedule_pipelined_finalize(task);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+ucc_status_t
+ucc_tl_ucp_bcast_pipelined_init(ucc_base_coll_args_t *coll_args,
+                                ucc_base_team_t *team,
+                                ucc_pipeline_params_t *pp,
+                                const char *model_name, int model_predict,
+                                ucc_schedule_frag_init_fn_t frag_init,
+                                ucc_coll_task_t **task_h)
+{
+    ucc_tl_ucp_team_t        *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t          *args    = &coll_args->args;
+    size_t                    dt_size = ucc_dt_size(args->src.info.datatype);
+    ucc_base_coll_args_t      bargs   = *coll_args;
+    ucc_schedule_pipelined_t *schedule_p;
+    int                       n_frags, pipeline_depth, model_slot;
+    size_t                    max_count;
+    ucc_status_t              status;
+
+    max_count = (coll_args->mask & UCC_BASE_CARGS_MAX_FRAG_COUNT)
+                    ? coll_args->max_frag_count
+                    : args->src.info.count;
+    model_slot = ucc_pipeline_params_model(team, model_name,
+                                           args->src.info.mem_type,
+                                           max_count * dt_size, model_predict,
+                                           pp);
+    ucc_pipeline_nfrags_pdepth(pp, max_count * dt_size, &n_frags,
+                               &pipeline_depth);
+    /* no empty fragments */
+    n_frags        = (int)ucc_max(1, ucc_min((size_t)n_frags, max_count));
+    pipeline_depth = ucc_max(1, ucc_min(pipeline_depth, n_frags));
+    if (n_frags > 1) {
+        bargs.mask          |= UCC_BASE_CARGS_MAX_FRAG_COUNT;
+        bargs.max_frag_count = ucc_buffer_block_count(max_count, n_frags, 0);
+    }
+
+    status = ucc_tl_ucp_get_schedule(tl_team, coll_args,
+                                     (ucc_tl_ucp_schedule_t **)&schedule_p);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    status = ucc_schedule_pipelined_init(&bargs, team, frag_init,
+                                         ucc_tl_ucp_bcast_frag_setup,
+                                         pipeline_depth, n_frags, pp->order,
+                                         schedule_p);
+    if (ucc_unlikely(UCC_OK != status)) {
+        tl_error(team->context->lib, "failed to init pipelined bcast schedule");
+        ucc_tl_ucp_put_schedule(&schedule_p->super);
+        return status;
+    }
+    ucc_schedule_pipelined_set_model(schedule_p, model_slot,
+                                     max_count * dt_size);
+    schedule_p->super.super.finalize = ucc_tl_ucp_bcast_pipelined_finalize;
+    *task_h = &schedule_p->super.super;
+    return UCC_OK;
+}
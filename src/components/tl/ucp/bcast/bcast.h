@@ -12,6 +12,8 @@ enum {
     UCC_TL_UCP_BCAST_ALG_KNOMIAL,
     UCC_TL_UCP_BCAST_ALG_SAG_KNOMIAL,
     UCC_TL_UCP_BCAST_ALG_DBT,
+    UCC_TL_UCP_BCAST_ALG_CHAIN,
+    UCC_TL_UCP_BCAST_ALG_SAG_RING,
     UCC_TL_UCP_BCAST_ALG_LAST
 };
 
@@ -52,4 +54,29 @@ ucc_status_t ucc_tl_ucp_bcast_dbt_init(
     ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
     ucc_coll_task_t **task_h);
 
+/* Pipelined bcast: every fragment is a schedule of a single bcast task
+   created by "task_init", fragment count and depth come from "pp". If
+   "model_name" is set "pp" are "auto" defaults the pipeline model may
+   override. */
+ucc_status_t
+ucc_tl_ucp_bcast_frag_init(ucc_base_coll_args_t *coll_args,
+                           ucc_base_team_t *team, ucc_schedule_t **frag_p,
+                           ucc_base_coll_init_fn_t task_init);
+
+ucc_status_t
+ucc_tl_ucp_bcast_pipelined_init(ucc_base_coll_args_t *coll_args,
+                                ucc_base_team_t *team,
+                                ucc_pipeline_params_t *pp,
+                                const char *model_name, int model_predict,
+                                ucc_schedule_frag_init_fn_t frag_init,
+                                ucc_coll_task_t **task_h);
+
+ucc_status_t ucc_tl_ucp_bcast_chain_init(ucc_base_coll_args_t *coll_args,
+                                         ucc_base_team_t      *team,
+                                         ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_bcast_sag_ring_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
 #endif
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+
+/* Chain bcast: ranks form a chain starting at root (in root relative
+   ordering), every rank receives the data from the previous one and forwards
+   it to the next one. A single chain task moves one segment; segments are
+   launched by the pipelined schedule so that up to pipeline depth segments
+   travel along the chain concurrently and every link is busy once the
+   pipeline is filled. */
+
+static void ucc_tl_ucp_bcast_chain_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task      = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args      = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team      = TASK_TEAM(task);
+    ucc_rank_t         size      = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         vrank     = VRANK(UCC_TL_TEAM_RANK(team), args->root,
+                                         size);
+    size_t             data_size = args->src.info.count *
+                                   ucc_dt_size(args->src.info.datatype);
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+        return;
+    }
+    if ((vrank != size - 1) && (task->tagged.send_posted == 0)) {
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(args->src.info.buffer, data_size,
+                                         args->src.info.mem_type,
+                                         INV_VRANK(vrank + 1, args->root,
+                                                   size),
+                                         team, task),
+                      task, out);
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_bcast_chain_done", 0);
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_chain_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), args->root, size);
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_bcast_chain_start", 0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    if (vrank != 0) {
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(args->src.info.buffer,
+                                         args->src.info.count *
+                                             ucc_dt_size(
+                                                 args->src.info.datatype),
+                                         args->src.info.mem_type,
+                                         INV_VRANK(vrank - 1, args->root,
+                                                   size),
+                                         team, task),
+                      task, out);
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+out:
+    return task->super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_chain_task_init(ucc_base_coll_args_t *coll_args,
+                                 ucc_base_team_t      *team,
+                                 ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_bcast_chain_start;
+    task->super.progress = ucc_tl_ucp_bcast_chain_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_chain_frag_init(ucc_base_coll_args_t     *coll_args,
+                                 ucc_schedule_pipelined_t *sp, //NOLINT
+                                 ucc_base_team_t          *team,
+                                 ucc_schedule_t          **frag_p)
+{
+    return ucc_tl_ucp_bcast_frag_init(coll_args, team, frag_p,
+                                      ucc_tl_ucp_bcast_chain_task_init);
+}
+
+ucc_status_t ucc_tl_ucp_bcast_chain_init(ucc_base_coll_args_t *coll_args,
+                                         ucc_base_team_t      *team,
+                                         ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t    *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_pipeline_params_t pp      =
+        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.bcast_chain_pipeline;
+    int                   is_auto;
+
+    if (UCC_COLL_ARGS_ACTIVE_SET(&coll_args->args)) {
+        /* ActiveSets currently are only supported with KN alg */
+        return ucc_tl_ucp_bcast_knomial_init(coll_args, team, task_h);
+    }
+    is_auto = ucc_pipeline_params_is_auto(&pp);
+    if (is_auto) {
+        pp.threshold = 0;
+        pp.n_frags   = 1;
+        pp.frag_size = 512 * 1024;
+        pp.pdepth    = 4;
+        pp.order     = UCC_PIPELINE_PARALLEL;
+    }
+    return ucc_tl_ucp_bcast_pipelined_init(coll_args, team, &pp,
+                                           "ucp_bcast_chain", is_auto,
+                                           ucc_tl_ucp_bcast_chain_frag_init,
+                                           task_h);
+}
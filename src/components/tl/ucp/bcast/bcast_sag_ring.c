@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Scatter + ring allgather bcast (van de Geijn): the segment is split into
+   team size blocks, block "i" belongs to vrank "i". Blocks are scattered
+   over the binomial tree, so every vrank "w" gets the blocks of its subtree
+   [w, w + lsb(w)). Then ring allgather circulates the blocks: at step "s"
+   vrank "v" sends block "v - s" to "v + 1". Transfers of blocks that the
+   receiver already got during the scatter are skipped. Segments are launched
+   by the pipelined schedule. */
+
+enum {
+    UCC_TL_UCP_BCAST_SAG_RING_PHASE_SCATTER,
+    UCC_TL_UCP_BCAST_SAG_RING_PHASE_RING_POST,
+    UCC_TL_UCP_BCAST_SAG_RING_PHASE_RING_WAIT
+};
+
+/* returns 1 if block belongs to the scatter subtree of vrank */
+static inline int ucc_tl_ucp_bcast_sag_ring_has_block(ucc_rank_t vrank,
+                                                      ucc_rank_t block)
+{
+    ucc_rank_t d = 1;
+
+    if (vrank == 0) {
+        return 1;
+    }
+    while ((vrank / d) % 2 == 0) {
+        d *= 2;
+    }
+    return (block >= vrank) && (block < vrank + d);
+}
+
+static inline size_t ucc_tl_ucp_bcast_sag_ring_offset(size_t count,
+                                                      size_t dt_size,
+                                                      ucc_rank_t size,
+                                                      ucc_rank_t block)
+{
+    return ucc_buffer_block_offset(count, size, block) * dt_size;
+}
+
+static void ucc_tl_ucp_bcast_sag_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task    = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root    = args->root;
+    ucc_rank_t         vrank   = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    void              *buffer  = args->src.info.buffer;
+    ucc_memory_type_t  mtype   = args->src.info.mem_type;
+    size_t             count   = args->src.info.count;
+    size_t             dt_size = ucc_dt_size(args->src.info.datatype);
+    ucc_rank_t         dist    = task->bcast_sag_ring.dist;
+    ucc_rank_t         vpeer, end, sblock, rblock;
+    size_t             offset;
+
+    if (task->bcast_sag_ring.phase == UCC_TL_UCP_BCAST_SAG_RING_PHASE_SCATTER) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        while (dist >= 1) {
+            if (vrank % dist == 0) {
+                if ((vrank / dist) % 2 == 0) {
+                    vpeer = vrank + dist;
+                    if (vpeer < size) {
+                        end    = ucc_min(vpeer + dist, size);
+                        offset = ucc_tl_ucp_bcast_sag_ring_offset(
+                            count, dt_size, size, vpeer);
+                        UCPCHECK_GOTO(
+                            ucc_tl_ucp_send_nz(
+                                PTR_OFFSET(buffer, offset),
+                                ucc_tl_ucp_bcast_sag_ring_offset(
+                                    count, dt_size, size, end) - offset,
+                                mtype, INV_VRANK(vpeer, root, size), team,
+                                task),
+                            task, out);
+                    }
+                } else {
+                    end    = ucc_min(vrank + dist, size);
+                    offset = ucc_tl_ucp_bcast_sag_ring_offset(count, dt_size,
+                                                              size, vrank);
+                    UCPCHECK_GOTO(
+                        ucc_tl_ucp_recv_nz(
+                            PTR_OFFSET(buffer, offset),
+                            ucc_tl_ucp_bcast_sag_ring_offset(count, dt_size,
+                                                             size, end) -
+                                offset,
+                            mtype, INV_VRANK(vrank - dist, root, size), team,
+                            task),
+                        task, out);
+                }
+            }
+            dist /= 2;
+            if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+                task->bcast_sag_ring.dist = dist;
+                return;
+            }
+        }
+        task->bcast_sag_ring.dist  = 0;
+        task->bcast_sag_ring.phase = UCC_TL_UCP_BCAST_SAG_RING_PHASE_RING_POST;
+    }
+
+    while (task->bcast_sag_ring.step < size - 1) {
+        if (task->bcast_sag_ring.phase ==
+            UCC_TL_UCP_BCAST_SAG_RING_PHASE_RING_POST) {
+            sblock = (vrank - task->bcast_sag_ring.step + size) % size;
+            rblock = (sblock - 1 + size) % size;
+            vpeer  = (vrank + 1) % size;
+            if (!ucc_tl_ucp_bcast_sag_ring_has_block(vpeer, sblock)) {
+                offset = ucc_tl_ucp_bcast_sag_ring_offset(count, dt_size, size,
+                                                          sblock);
+                UCPCHECK_GOTO(
+                    ucc_tl_ucp_send_nz(
+                        PTR_OFFSET(buffer, offset),
+                        ucc_buffer_block_count(count, size, sblock) * dt_size,
+                        mtype, INV_VRANK(vpeer, root, size), team, task),
+                    task, out);
+            }
+            if (!ucc_tl_ucp_bcast_sag_ring_has_block(vrank, rblock)) {
+                offset = ucc_tl_ucp_bcast_sag_ring_offset(count, dt_size, size,
+                                                          rblock);
+                UCPCHECK_GOTO(
+                    ucc_tl_ucp_recv_nz(
+                        PTR_OFFSET(buffer, offset),
+                        ucc_buffer_block_count(count, size, rblock) * dt_size,
+                        mtype, INV_VRANK((vrank - 1 + size) % size, root, size),
+                        team, task),
+                    task, out);
+            }
+            task->bcast_sag_ring.phase =
+                UCC_TL_UCP_BCAST_SAG_RING_PHASE_RING_WAIT;
+        }
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return;
+        }
+        task->bcast_sag_ring.step++;
+        task->bcast_sag_ring.phase = UCC_TL_UCP_BCAST_SAG_RING_PHASE_RING_POST;
+    }
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_bcast_sag_ring_done", 0);
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_sag_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_bcast_sag_ring_start", 0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    task->bcast_sag_ring.phase = UCC_TL_UCP_BCAST_SAG_RING_PHASE_SCATTER;
+    task->bcast_sag_ring.step  = 0;
+    CALC_KN_TREE_DIST(UCC_TL_TEAM_SIZE(team), 2, task->bcast_sag_ring.dist);
+
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_sag_ring_task_init(ucc_base_coll_args_t *coll_args,
+                                    ucc_base_team_t      *team,
+                                    ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_bcast_sag_ring_start;
+    task->super.progress = ucc_tl_ucp_bcast_sag_ring_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_sag_ring_frag_init(ucc_base_coll_args_t     *coll_args,
+                                    ucc_schedule_pipelined_t *sp, //NOLINT
+                                    ucc_base_team_t          *team,
+                                    ucc_schedule_t          **frag_p)
+{
+    return ucc_tl_ucp_bcast_frag_init(coll_args, team, frag_p,
+                                      ucc_tl_ucp_bcast_sag_ring_task_init);
+}
+
+ucc_status_t ucc_tl_ucp_bcast_sag_ring_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t    *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_pipeline_params_t pp      =
+        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.bcast_sag_ring_pipeline;
+    int                   is_auto;
+
+    if (UCC_COLL_ARGS_ACTIVE_SET(&coll_args->args)) {
+        /* ActiveSets currently are only supported with KN alg */
+        return ucc_tl_ucp_bcast_knomial_init(coll_args, team, task_h);
+    }
+    is_auto = ucc_pipeline_params_is_auto(&pp);
+    if (is_auto) {
+        pp.threshold = 0;
+        pp.n_frags   = 1;
+        pp.frag_size = 4 * 1024 * 1024;
+        pp.pdepth    = 2;
+        pp.order     = UCC_PIPELINE_PARALLEL;
+    }
+    return ucc_tl_ucp_bcast_pipelined_init(coll_args, team, &pp,
+                                           "ucp_bcast_sag_ring", is_auto,
+                                           ucc_tl_ucp_bcast_sag_ring_frag_init,
+                                           task_h);
+}
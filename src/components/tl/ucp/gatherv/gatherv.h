@@ -9,15 +9,110 @@
 
 #include "../tl_ucp.h"
 #include "../tl_ucp_coll.h"
+#include "utils/ucc_coll_utils.h"
 
 enum {
     UCC_TL_UCP_GATHERV_ALG_LINEAR,
+    UCC_TL_UCP_GATHERV_ALG_KNOMIAL,
     UCC_TL_UCP_GATHERV_ALG_LAST
 };
 
 extern ucc_base_coll_alg_info_t
              ucc_tl_ucp_gatherv_algs[UCC_TL_UCP_GATHERV_ALG_LAST + 1];
 
+#define UCC_TL_UCP_GATHERV_DEFAULT_ALG_SELECT_STR                              \
+    "gatherv:[32-inf]:@knomial"
+
+static inline int ucc_tl_ucp_gatherv_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_GATHERV_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_gatherv_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
+
+/* Knomial tree used by knomial gatherv and scatterv. Vrank 0 is the root,
+   parent of a vrank is obtained by zeroing its lowest non-zero radix digit,
+   so subtree of a vrank is a contiguous range of vranks starting from it. */
+static inline ucc_rank_t ucc_tl_ucp_gatherv_kn_parent(ucc_rank_t     vrank,
+                                                      ucc_kn_radix_t radix)
+{
+    size_t dist = 1;
+
+    ucc_assert(vrank != 0);
+    while ((vrank / dist) % radix == 0) {
+        dist *= radix;
+    }
+    return vrank - ((vrank / dist) % radix) * dist;
+}
+
+static inline ucc_rank_t ucc_tl_ucp_gatherv_kn_subtree_size(ucc_rank_t vrank,
+                                                            ucc_kn_radix_t radix,
+                                                            ucc_rank_t tsize)
+{
+    size_t dist = 1;
+
+    if (vrank == 0) {
+        return tsize;
+    }
+    while (vrank % (dist * radix) == 0) {
+        dist *= radix;
+    }
+    return ucc_min(dist, tsize - vrank);
+}
+
+/* Data of every rank is split into n_frags fragments. Fragment f of the
+   data sent by a subtree is the concatenation of fragments f of all ranks
+   of the subtree in vrank order, so every fragment can be forwarded as soon
+   as it arrives from all children. */
+static inline size_t ucc_tl_ucp_gatherv_kn_frag_size(size_t   count,
+                                                     size_t   dt_size,
+                                                     uint32_t n_frags,
+                                                     uint32_t frag)
+{
+    return ucc_buffer_block_count(count, n_frags, frag) * dt_size;
+}
+
+static inline size_t ucc_tl_ucp_gatherv_kn_frag_offset(size_t   count,
+                                                       size_t   dt_size,
+                                                       uint32_t n_frags,
+                                                       uint32_t frag)
+{
+    return ucc_buffer_block_offset(count, n_frags, frag) * dt_size;
+}
+
+enum {
+    UCC_TL_UCP_GATHERV_KN_PHASE_SIZES, /* subtree sizes exchange */
+    UCC_TL_UCP_GATHERV_KN_PHASE_POST,  /* post fragment */
+    UCC_TL_UCP_GATHERV_KN_PHASE_WAIT   /* wait for fragment */
+};
+
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_init(ucc_tl_ucp_task_t *task,
+                                             ucc_kn_radix_t     radix,
+                                             uint32_t           n_frags);
+
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_start(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_sizes_done(ucc_tl_ucp_task_t *task);
+
+size_t ucc_tl_ucp_gatherv_kn_tree_offset(ucc_tl_ucp_task_t *task,
+                                         uint32_t frag, ucc_rank_t child);
+
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_finalize(ucc_coll_task_t *coll_task);
+
 ucc_status_t ucc_tl_ucp_gatherv_init(ucc_tl_ucp_task_t *task);
 
+ucc_status_t ucc_tl_ucp_gatherv_linear_init_common(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_gatherv_linear_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_gatherv_knomial_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h);
+
 #endif
@@ -0,0 +1,517 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "gatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "components/mc/ucc_mc.h"
+#include "utils/ucc_math.h"
+
+/* Buffer described by counts and displacements is dst for gatherv and src
+   for scatterv, the other one holds data of the rank itself */
+static inline ucc_coll_buffer_info_v_t *
+ucc_tl_ucp_gatherv_kn_root_info(ucc_coll_args_t *args)
+{
+    return (args->coll_type == UCC_COLL_TYPE_GATHERV) ? &args->dst.info_v
+                                                      : &args->src.info_v;
+}
+
+static inline ucc_coll_buffer_info_t *
+ucc_tl_ucp_gatherv_kn_own_info(ucc_coll_args_t *args)
+{
+    return (args->coll_type == UCC_COLL_TYPE_GATHERV) ? &args->src.info
+                                                      : &args->dst.info;
+}
+
+/* Root can receive (send) data of the subtree directly to (from) user buffer
+   if it is not fragmented and blocks of the subtree ranks follow each other
+   in vrank order */
+static int ucc_tl_ucp_gatherv_kn_is_direct(ucc_coll_args_t *args,
+                                           ucc_rank_t vchild, ucc_rank_t n,
+                                           ucc_rank_t tsize)
+{
+    ucc_coll_buffer_info_v_t *info = ucc_tl_ucp_gatherv_kn_root_info(args);
+    ucc_rank_t                root = args->root;
+    size_t                    expected, displ;
+    ucc_rank_t                i, rank;
+
+    rank     = INV_VRANK(vchild, root, tsize);
+    expected = ucc_coll_args_get_displacement(args, info->displacements, rank);
+    for (i = 0; i < n; i++) {
+        rank  = INV_VRANK(vchild + i, root, tsize);
+        displ = ucc_coll_args_get_displacement(args, info->displacements,
+                                               rank);
+        if (displ != expected) {
+            return 0;
+        }
+        expected += ucc_coll_args_get_count(args, info->counts, rank);
+    }
+    return 1;
+}
+
+/* Scratch is kept between posts and grows when counts of the new post need
+   more space than the previous ones */
+static ucc_status_t ucc_tl_ucp_gatherv_kn_scratch_reserve(
+    ucc_tl_ucp_task_t *task, size_t size, ucc_memory_type_t mem_type)
+{
+    ucc_status_t status;
+
+    if (size <= task->gatherv_kn.scratch_size) {
+        return UCC_OK;
+    }
+    if (task->gatherv_kn.scratch_mc_header) {
+        ucc_mc_free(task->gatherv_kn.scratch_mc_header);
+        task->gatherv_kn.scratch_mc_header = NULL;
+        task->gatherv_kn.scratch           = NULL;
+        task->gatherv_kn.scratch_size      = 0;
+    }
+    status = ucc_mc_alloc(&task->gatherv_kn.scratch_mc_header, size, mem_type);
+    if (ucc_unlikely(status != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+        return status;
+    }
+    task->gatherv_kn.scratch      = task->gatherv_kn.scratch_mc_header->addr;
+    task->gatherv_kn.scratch_size = size;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_init(ucc_tl_ucp_task_t *task,
+                                             ucc_kn_radix_t     radix,
+                                             uint32_t           n_frags)
+{
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), args->root,
+                                     tsize);
+    ucc_rank_t         n     = 0;
+    size_t             dist;
+    ucc_rank_t         c, j;
+
+    for (dist = 1; dist < tsize && vrank % (dist * radix) == 0;
+         dist *= radix) {
+        for (j = 1; j < radix && vrank + j * dist < tsize; j++) {
+            n++;
+        }
+    }
+
+    task->gatherv_kn.radix             = radix;
+    task->gatherv_kn.n_frags           = n_frags;
+    task->gatherv_kn.n_children        = n;
+    task->gatherv_kn.scratch           = NULL;
+    task->gatherv_kn.scratch_mc_header = NULL;
+    task->gatherv_kn.scratch_size      = 0;
+    /* sizes of fragments of every child followed by own ones */
+    task->gatherv_kn.sizes = ucc_malloc((n + 1) * n_frags * sizeof(uint64_t) +
+                                        n * sizeof(ucc_rank_t) + n,
+                                        "gatherv_kn_sizes");
+    if (ucc_unlikely(!task->gatherv_kn.sizes)) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for sizes",
+                 (n + 1) * n_frags * sizeof(uint64_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->gatherv_kn.children =
+        PTR_OFFSET(task->gatherv_kn.sizes, (n + 1) * n_frags * sizeof(uint64_t));
+    task->gatherv_kn.direct =
+        PTR_OFFSET(task->gatherv_kn.children, n * sizeof(ucc_rank_t));
+
+    c = 0;
+    for (dist = 1; dist < tsize && vrank % (dist * radix) == 0;
+         dist *= radix) {
+        for (j = 1; j < radix && vrank + j * dist < tsize; j++) {
+            task->gatherv_kn.children[c++] = vrank + j * dist;
+        }
+    }
+    return UCC_OK;
+}
+
+/* Root knows all the counts, sizes of its children data are not sent. They
+   are computed on every post since counts may change between posts of a
+   persistent task. */
+static ucc_status_t ucc_tl_ucp_gatherv_kn_root_sizes(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t        *team    = TASK_TEAM(task);
+    ucc_coll_args_t          *args    = &TASK_ARGS(task);
+    ucc_rank_t                tsize   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t                root    = args->root;
+    ucc_kn_radix_t            radix   = task->gatherv_kn.radix;
+    uint32_t                  n_frags = task->gatherv_kn.n_frags;
+    ucc_rank_t                n       = task->gatherv_kn.n_children;
+    uint64_t                 *row     = task->gatherv_kn.sizes + n * n_frags;
+    ucc_coll_buffer_info_v_t *info    = ucc_tl_ucp_gatherv_kn_root_info(args);
+    size_t                    dt_size = ucc_dt_size(info->datatype);
+    size_t                    total   = 0;
+    size_t                    count;
+    ucc_rank_t                c, i, vchild, rank, subtree;
+    uint32_t                  f;
+
+    memset(row, 0, n_frags * sizeof(uint64_t));
+    for (c = 0; c < n; c++) {
+        vchild  = task->gatherv_kn.children[c];
+        subtree = ucc_tl_ucp_gatherv_kn_subtree_size(vchild, radix, tsize);
+        task->gatherv_kn.direct[c] =
+            (n_frags == 1) &&
+            ucc_tl_ucp_gatherv_kn_is_direct(args, vchild, subtree, tsize);
+        for (f = 0; f < n_frags; f++) {
+            task->gatherv_kn.sizes[c * n_frags + f] = 0;
+            for (i = 0; i < subtree; i++) {
+                rank  = INV_VRANK(vchild + i, root, tsize);
+                count = ucc_coll_args_get_count(args, info->counts, rank);
+                task->gatherv_kn.sizes[c * n_frags + f] +=
+                    ucc_tl_ucp_gatherv_kn_frag_size(count, dt_size, n_frags, f);
+            }
+            if (!task->gatherv_kn.direct[c]) {
+                row[f] += task->gatherv_kn.sizes[c * n_frags + f];
+                total  += task->gatherv_kn.sizes[c * n_frags + f];
+            }
+        }
+    }
+
+    if (total == 0) {
+        return UCC_OK;
+    }
+    return ucc_tl_ucp_gatherv_kn_scratch_reserve(task, total, info->mem_type);
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_start(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_rank_t         tsize   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root    = args->root;
+    ucc_rank_t         vrank   = VRANK(UCC_TL_TEAM_RANK(team), root, tsize);
+    uint32_t           n_frags = task->gatherv_kn.n_frags;
+    ucc_status_t       status;
+    ucc_rank_t         c;
+
+    task->gatherv_kn.phase = UCC_TL_UCP_GATHERV_KN_PHASE_SIZES;
+    task->gatherv_kn.frag  = 0;
+    if (vrank == 0) {
+        return ucc_tl_ucp_gatherv_kn_root_sizes(task);
+    }
+    for (c = 0; c < task->gatherv_kn.n_children; c++) {
+        status = ucc_tl_ucp_recv_nb(
+            task->gatherv_kn.sizes + c * n_frags, n_frags * sizeof(uint64_t),
+            UCC_MEMORY_TYPE_HOST,
+            INV_VRANK(task->gatherv_kn.children[c], root, tsize), team, task);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
+/* Called by non-root ranks once sizes of children fragments are received:
+   computes sizes of own subtree fragments, sends them to the parent unless
+   it is the root and grows scratch for the subtree data if needed */
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_sizes_done(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t      *team    = TASK_TEAM(task);
+    ucc_coll_args_t        *args    = &TASK_ARGS(task);
+    ucc_coll_buffer_info_t *info    = ucc_tl_ucp_gatherv_kn_own_info(args);
+    ucc_rank_t              tsize   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t              root    = args->root;
+    ucc_rank_t              vrank   = VRANK(UCC_TL_TEAM_RANK(team), root,
+                                            tsize);
+    uint32_t                n_frags = task->gatherv_kn.n_frags;
+    ucc_rank_t              n       = task->gatherv_kn.n_children;
+    uint64_t               *row     = task->gatherv_kn.sizes + n * n_frags;
+    size_t                  dt_size = ucc_dt_size(info->datatype);
+    size_t                  total   = 0;
+    ucc_rank_t              parent, c;
+    uint32_t                f;
+    ucc_status_t            status;
+
+    for (f = 0; f < n_frags; f++) {
+        row[f] = ucc_tl_ucp_gatherv_kn_frag_size(info->count, dt_size,
+                                                 n_frags, f);
+        for (c = 0; c < n; c++) {
+            row[f] += task->gatherv_kn.sizes[c * n_frags + f];
+        }
+        total += row[f];
+    }
+
+    parent = ucc_tl_ucp_gatherv_kn_parent(vrank, task->gatherv_kn.radix);
+    if (parent != 0) {
+        status = ucc_tl_ucp_send_nb(row, n_frags * sizeof(uint64_t),
+                                    UCC_MEMORY_TYPE_HOST,
+                                    INV_VRANK(parent, root, tsize), team, task);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+    }
+
+    if (n == 0) {
+        return UCC_OK;
+    }
+    return ucc_tl_ucp_gatherv_kn_scratch_reserve(task, ucc_max(total, 1),
+                                                 info->mem_type);
+}
+
+/* Offset of fragment "frag" of the given child in the subtree data, child
+   equal to n_children stands for the beginning of the fragment. Root does
+   not keep own data and data of direct children in scratch. */
+size_t ucc_tl_ucp_gatherv_kn_tree_offset(ucc_tl_ucp_task_t *task,
+                                         uint32_t frag, ucc_rank_t child)
+{
+    uint32_t        n_frags = task->gatherv_kn.n_frags;
+    ucc_rank_t      n       = task->gatherv_kn.n_children;
+    const uint64_t *sizes   = task->gatherv_kn.sizes;
+    const uint64_t *row     = sizes + n * n_frags;
+    size_t          offset  = 0;
+    size_t          own     = row[frag];
+    ucc_rank_t      c;
+    uint32_t        f;
+
+    for (f = 0; f < frag; f++) {
+        offset += row[f];
+    }
+    if (child == n) {
+        return offset;
+    }
+    for (c = 0; c < n; c++) {
+        if (!task->gatherv_kn.direct[c]) {
+            own -= sizes[c * n_frags + frag];
+        }
+    }
+    offset += own;
+    for (c = 0; c < child; c++) {
+        if (!task->gatherv_kn.direct[c]) {
+            offset += sizes[c * n_frags + frag];
+        }
+    }
+    return offset;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_kn_tree_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->gatherv_kn.scratch_mc_header) {
+        ucc_mc_free(task->gatherv_kn.scratch_mc_header);
+    }
+    ucc_free(task->gatherv_kn.sizes);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+static void ucc_tl_ucp_gatherv_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task    = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         tsize   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root    = args->root;
+    ucc_rank_t         vrank   = VRANK(UCC_TL_TEAM_RANK(team), root, tsize);
+    uint32_t           n_frags = task->gatherv_kn.n_frags;
+    ucc_rank_t         n       = task->gatherv_kn.n_children;
+    uint64_t          *sizes   = task->gatherv_kn.sizes;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size, count, offset, len;
+    ucc_rank_t         c, i, rank, peer, subtree;
+    uint32_t           f, last;
+    ucc_status_t       status;
+    void              *blob, *dst;
+
+    if (vrank == 0) {
+        mtype   = args->dst.info_v.mem_type;
+        dt_size = ucc_dt_size(args->dst.info_v.datatype);
+    } else {
+        mtype   = args->src.info.mem_type;
+        dt_size = ucc_dt_size(args->src.info.datatype);
+    }
+
+    if (task->gatherv_kn.phase == UCC_TL_UCP_GATHERV_KN_PHASE_SIZES) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        if (vrank != 0) {
+            status = ucc_tl_ucp_gatherv_kn_tree_sizes_done(task);
+            if (ucc_unlikely(status != UCC_OK)) {
+                task->super.status = status;
+                return;
+            }
+            count = args->src.info.count;
+            for (f = 0; f < n_frags && n > 0; f++) {
+                status = ucc_mc_memcpy(
+                    PTR_OFFSET(task->gatherv_kn.scratch,
+                               ucc_tl_ucp_gatherv_kn_tree_offset(task, f, n)),
+                    PTR_OFFSET(args->src.info.buffer,
+                               ucc_tl_ucp_gatherv_kn_frag_offset(
+                                   count, dt_size, n_frags, f)),
+                    ucc_tl_ucp_gatherv_kn_frag_size(count, dt_size, n_frags,
+                                                    f),
+                    mtype, mtype);
+                if (ucc_unlikely(status != UCC_OK)) {
+                    task->super.status = status;
+                    return;
+                }
+            }
+        }
+        task->gatherv_kn.phase = UCC_TL_UCP_GATHERV_KN_PHASE_POST;
+    }
+
+    /* leaf sends own data as is */
+    blob = (vrank != 0 && n == 0) ? args->src.info.buffer
+                                  : task->gatherv_kn.scratch;
+    while (task->gatherv_kn.frag < n_frags) {
+        if (task->gatherv_kn.phase == UCC_TL_UCP_GATHERV_KN_PHASE_POST) {
+            /* root has nothing to forward and posts all fragments at once */
+            last = (vrank == 0) ? n_frags : task->gatherv_kn.frag + 1;
+            for (f = task->gatherv_kn.frag; f < last; f++) {
+                for (c = 0; c < n; c++) {
+                    peer = INV_VRANK(task->gatherv_kn.children[c], root, tsize);
+                    if (task->gatherv_kn.direct[c]) {
+                        dst = PTR_OFFSET(args->dst.info_v.buffer,
+                                         ucc_coll_args_get_displacement(
+                                             args,
+                                             args->dst.info_v.displacements,
+                                             peer) * dt_size);
+                    } else {
+                        dst = PTR_OFFSET(blob, ucc_tl_ucp_gatherv_kn_tree_offset(
+                                                   task, f, c));
+                    }
+                    UCPCHECK_GOTO(ucc_tl_ucp_recv_nz(dst,
+                                                     sizes[c * n_frags + f],
+                                                     mtype, peer, team, task),
+                                  task, out);
+                }
+            }
+            task->gatherv_kn.frag  = last - 1;
+            task->gatherv_kn.phase = UCC_TL_UCP_GATHERV_KN_PHASE_WAIT;
+        }
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        if (vrank != 0) {
+            f    = task->gatherv_kn.frag;
+            peer = INV_VRANK(
+                ucc_tl_ucp_gatherv_kn_parent(vrank, task->gatherv_kn.radix),
+                root, tsize);
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_send_nz(
+                    PTR_OFFSET(blob,
+                               ucc_tl_ucp_gatherv_kn_tree_offset(task, f, n)),
+                    sizes[n * n_frags + f], mtype, peer, team, task),
+                task, out);
+        }
+        task->gatherv_kn.frag++;
+        task->gatherv_kn.phase = UCC_TL_UCP_GATHERV_KN_PHASE_POST;
+    }
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+
+    if (vrank == 0) {
+        for (f = 0; f < n_frags; f++) {
+            for (c = 0; c < n; c++) {
+                if (task->gatherv_kn.direct[c]) {
+                    continue;
+                }
+                offset  = ucc_tl_ucp_gatherv_kn_tree_offset(task, f, c);
+                subtree = ucc_tl_ucp_gatherv_kn_subtree_size(
+                    task->gatherv_kn.children[c], task->gatherv_kn.radix,
+                    tsize);
+                for (i = 0; i < subtree; i++) {
+                    rank  = INV_VRANK(task->gatherv_kn.children[c] + i, root,
+                                      tsize);
+                    count = ucc_coll_args_get_count(
+                        args, args->dst.info_v.counts, rank);
+                    len   = ucc_tl_ucp_gatherv_kn_frag_size(count, dt_size,
+                                                            n_frags, f);
+                    dst   = PTR_OFFSET(args->dst.info_v.buffer,
+                                       ucc_coll_args_get_displacement(
+                                           args, args->dst.info_v.displacements,
+                                           rank) * dt_size +
+                                       ucc_tl_ucp_gatherv_kn_frag_offset(
+                                           count, dt_size, n_frags, f));
+                    status = ucc_mc_memcpy(dst,
+                                           PTR_OFFSET(task->gatherv_kn.scratch,
+                                                      offset),
+                                           len, mtype, mtype);
+                    if (ucc_unlikely(status != UCC_OK)) {
+                        task->super.status = status;
+                        return;
+                    }
+                    offset += len;
+                }
+            }
+        }
+    }
+
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_gatherv_kn_done", 0);
+}
+
+static ucc_status_t ucc_tl_ucp_gatherv_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    size_t             dt_size;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_gatherv_kn_start", 0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    if (UCC_IS_ROOT(*args, trank) && !UCC_IS_INPLACE(*args)) {
+        dt_size = ucc_dt_size(args->dst.info_v.datatype);
+        status  = ucc_mc_memcpy(
+            PTR_OFFSET(args->dst.info_v.buffer,
+                       ucc_coll_args_get_displacement(
+                           args, args->dst.info_v.displacements, trank) *
+                           dt_size),
+            args->src.info.buffer,
+            ucc_coll_args_get_count(args, args->dst.info_v.counts, trank) *
+                dt_size,
+            args->dst.info_v.mem_type, args->src.info.mem_type);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+    }
+
+    status = ucc_tl_ucp_gatherv_kn_tree_start(task);
+    if (ucc_unlikely(status != UCC_OK)) {
+        return status;
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_knomial_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t       *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    ucc_rank_t               tsize   = UCC_TL_TEAM_SIZE(tl_team);
+    ucc_tl_ucp_task_t       *task;
+    ucc_kn_radix_t           radix;
+    ucc_status_t             status;
+
+    if (!ucc_coll_args_is_predefined_dt(&coll_args->args,
+                                        UCC_TL_TEAM_RANK(tl_team))) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    radix  = ucc_max(2, ucc_min(cfg->gatherv_kn_radix, tsize));
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_gatherv_kn_tree_init(
+        task, radix, ucc_max(cfg->gatherv_kn_num_frags, 1));
+    if (ucc_unlikely(status != UCC_OK)) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_gatherv_knomial_start;
+    task->super.progress = ucc_tl_ucp_gatherv_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_gatherv_kn_tree_finalize;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -55,6 +55,7 @@ ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task)
     task->super.post      = ucc_tl_ucp_reduce_knomial_start;
     task->super.progress  = ucc_tl_ucp_reduce_knomial_progress;
     task->super.finalize  = ucc_tl_ucp_reduce_knomial_finalize;
+    task->super.rebind    = ucc_tl_ucp_coll_rebind;
     task->reduce_kn.radix =
         ucc_min(UCC_TL_UCP_TEAM_LIB(team)->cfg.reduce_kn_radix, team_size);
     CALC_KN_TREE_DIST(team_size, task->reduce_kn.radix,
@@ -15,7 +15,7 @@
         task->reduce_scatter_kn.phase = _phase;                                \
     } while (0)
 
-#define GET_COUNT(_args)                                                       \
+#define GET_COUNT(_args, _size)                                                \
     ({                                                                         \
         size_t _count = 0;                                                     \
         switch ((_args)->coll_type) {                                          \
@@ -28,6 +28,10 @@
                          ? (_args)->dst.info.count                             \
                          : (_args)->src.info.count;                            \
             break;                                                             \
+        case UCC_COLL_TYPE_REDUCE_SCATTERV:                                    \
+            _count = ucc_coll_args_get_total_count(                            \
+                (_args), (_args)->dst.info_v.counts, (_size));                 \
+            break;                                                             \
         default:                                                               \
             break;                                                             \
         }                                                                      \
@@ -39,6 +43,11 @@
         ? (_args)->dst.info_v.datatype                                         \
         : (_args)->dst.info.datatype
 
+#define GET_MT(_args)                                                          \
+    ((_args)->coll_type == UCC_COLL_TYPE_REDUCE_SCATTERV)                      \
+        ? (_args)->dst.info_v.mem_type                                         \
+        : (_args)->dst.info.mem_type
+
 typedef struct ucc_tl_ucp_rs_work_buf {
     void *src_data;
     void *dst_data;
@@ -105,27 +114,31 @@ static inline void get_sbuf_rbuf_ar(ucc_tl_ucp_task_t *task,
     wb->reduce_proxy = args->dst.info.buffer;
 }
 
-/* get work buffers for reduce scatter */
+/* get work buffers for reduce scatter and reduce scatterv */
 static inline void get_sbuf_rbuf_rs(ucc_tl_ucp_task_t *task,
                                     ucc_tl_ucp_rs_work_buf_t *wb)
 {
     ucc_coll_args_t       *args    = &TASK_ARGS(task);
     ucc_knomial_pattern_t *p       = &task->reduce_scatter_kn.p;
     void                  *scratch = task->reduce_scatter_kn.scratch;
-    size_t                 dt_size = ucc_dt_size(args->dst.info.datatype);
+    size_t                 dt_size = ucc_dt_size(GET_DT(args));
     ucc_rank_t             trank   = task->subset.myrank;
     ucc_rank_t             tsize   = task->subset.map.ep_num;
     ucc_kn_radix_t         radix   = p->radix;
-    size_t max_seg;
+    size_t max_seg, dst_offset;
     void *sbuf, *rbuf, *data_buf;
 
     max_seg = task->reduce_scatter_kn.max_seg;
 
     if (UCC_IS_INPLACE(*args)) {
+        if (p->type == KN_PATTERN_REDUCE_SCATTERV) {
+            dst_offset = ucc_buffer_vector_block_offset(p->counts, p->is64,
+                                                        trank);
+        } else {
+            dst_offset = (args->dst.info.count / tsize) * trank;
+        }
         data_buf     = args->dst.info.buffer;
-        wb->dst_data = PTR_OFFSET(args->dst.info.buffer,
-                                  (args->dst.info.count / tsize) *
-                                  trank * dt_size);
+        wb->dst_data = PTR_OFFSET(args->dst.info.buffer, dst_offset * dt_size);
     } else {
         data_buf     = args->src.info.buffer;
         wb->dst_data = args->dst.info.buffer;
@@ -192,8 +205,8 @@ static inline void get_rs_work_buf(ucc_tl_ucp_task_t *task,
     case UCC_COLL_TYPE_REDUCE:
         return get_sbuf_rbuf_ar(task, block_count, wb);
     case UCC_COLL_TYPE_REDUCE_SCATTER:
-        return get_sbuf_rbuf_rs(task, wb);
     case UCC_COLL_TYPE_REDUCE_SCATTERV:
+        return get_sbuf_rbuf_rs(task, wb);
     default:
         ucc_assert(0);
         return;
@@ -217,13 +230,13 @@ void ucc_tl_ucp_reduce_scatter_knomial_progress(ucc_coll_task_t *coll_task)
     ucc_knomial_pattern_t    *p               = &task->reduce_scatter_kn.p;
     ucc_kn_radix_t            radix           = p->radix;
     uint8_t                   node_type       = p->node_type;
-    ucc_memory_type_t         mem_type        = args->dst.info.mem_type;
-    size_t                    count           = GET_COUNT(args);
+    ucc_memory_type_t         mem_type        = GET_MT(args);
+    ucc_rank_t                rank            = task->subset.myrank;
+    ucc_rank_t                size            = task->subset.map.ep_num;
+    size_t                    count           = GET_COUNT(args, size);
     ucc_datatype_t            dt              = GET_DT(args);
     size_t                    dt_size         = ucc_dt_size(dt);
     size_t                    data_size       = count * dt_size;
-    ucc_rank_t                rank            = task->subset.myrank;
-    ucc_rank_t                size            = task->subset.map.ep_num;
     ucc_rank_t                root            = 0;
     size_t                    local_seg_count = 0;
     ucc_tl_ucp_rs_work_buf_t  wb              = (ucc_tl_ucp_rs_work_buf_t){0};
@@ -231,7 +244,7 @@ void ucc_tl_ucp_reduce_scatter_knomial_progress(ucc_coll_task_t *coll_task)
     ucc_rank_t               peer;
     ucc_status_t             status;
     ucc_kn_radix_t           step_radix, loop_step;
-    size_t                   block_count, peer_seg_count;
+    size_t                   block_count, peer_seg_count, extra_count;
     void                    *local_data;
     int                      is_avg;
 
@@ -250,7 +263,11 @@ void ucc_tl_ucp_reduce_scatter_knomial_progress(ucc_coll_task_t *coll_task)
                                          peer, team, task),
                       task, out);
         if (p->type != KN_PATTERN_REDUCE_SCATTERX) {
-            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(wb.dst_data, (count / size) * dt_size,
+            extra_count = (p->type == KN_PATTERN_REDUCE_SCATTERV)
+                              ? ucc_coll_args_get_count(
+                                    args, args->dst.info_v.counts, rank)
+                              : count / size;
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(wb.dst_data, extra_count * dt_size,
                                              mem_type, peer, team, task),
                           task, out);
         }
@@ -351,7 +368,8 @@ UCC_KN_PHASE_REDUCE:
                            "failed to perform dt reduction",
                            task->reduce_scatter_kn.etask);
         }
-        if ((args->coll_type == UCC_COLL_TYPE_REDUCE_SCATTER) &&
+        if (((args->coll_type == UCC_COLL_TYPE_REDUCE_SCATTER) ||
+             (args->coll_type == UCC_COLL_TYPE_REDUCE_SCATTERV)) &&
             (KN_NODE_PROXY == node_type) &&
             ucc_knomial_pattern_loop_last_iteration(p)) {
             get_rs_work_buf(task, 0, &wb);
@@ -364,7 +382,8 @@ UCC_KN_PHASE_REDUCE:
                                        peer_seg_offset * dt_size),
                             peer_seg_count * dt_size, mem_type, peer, team, task),
                           task, out);
-            ucc_mc_memcpy(wb.dst_data, wb.reduce_loop, peer_seg_count * dt_size,
+            /* own block precedes the extra one, its size is the offset */
+            ucc_mc_memcpy(wb.dst_data, wb.reduce_loop, peer_seg_offset * dt_size,
                           mem_type, mem_type);
         }
         ucc_kn_rs_pattern_next_iter(p);
@@ -382,6 +401,23 @@ out:
     task->super.status = UCC_OK;
 }
 
+/* Segments of reduce_scatterv are uneven: own segment of the 1st iteration
+   is the largest one this rank ever receives. It depends on the counts and
+   is computed on every post since counts may change between posts, e.g.
+   for fragments of a pipelined schedule. */
+static void ucc_tl_ucp_reduce_scatterv_kn_max_seg(ucc_tl_ucp_task_t *task)
+{
+    ptrdiff_t max_seg_offset;
+
+    task->reduce_scatter_kn.max_seg = 0;
+    if (KN_NODE_EXTRA != task->reduce_scatter_kn.p.node_type) {
+        ucc_kn_rs_pattern_peer_seg(task->subset.myrank,
+                                   &task->reduce_scatter_kn.p,
+                                   &task->reduce_scatter_kn.max_seg,
+                                   &max_seg_offset);
+    }
+}
+
 ucc_status_t ucc_tl_ucp_reduce_scatter_knomial_start(ucc_coll_task_t *coll_task)
 {
     ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
@@ -391,7 +427,7 @@ ucc_status_t ucc_tl_ucp_reduce_scatter_knomial_start(ucc_coll_task_t *coll_task)
     ucc_coll_type_t    ct    = args->coll_type;
     ucc_rank_t         root  = (ct == UCC_COLL_TYPE_REDUCE) ? args->root : 0;
     ucc_rank_t         rank  = VRANK(task->subset.myrank, root, size);
-    size_t             count = GET_COUNT(args);
+    size_t             count = GET_COUNT(args, size);
     ucc_status_t       status;
 
     UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_reduce_scatter_kn_start",
@@ -402,6 +438,12 @@ ucc_status_t ucc_tl_ucp_reduce_scatter_knomial_start(ucc_coll_task_t *coll_task)
         (ct == UCC_COLL_TYPE_REDUCE)) {
         ucc_kn_rsx_pattern_init(size, rank, task->reduce_scatter_kn.p.radix,
                                 count, &task->reduce_scatter_kn.p);
+    } else if (ct == UCC_COLL_TYPE_REDUCE_SCATTERV) {
+        ucc_kn_rsv_pattern_init(size, rank, task->reduce_scatter_kn.p.radix,
+                                args->dst.info_v.counts,
+                                UCC_COLL_ARGS_COUNT64(args),
+                                &task->reduce_scatter_kn.p);
+        ucc_tl_ucp_reduce_scatterv_kn_max_seg(task);
     } else {
         ucc_kn_rs_pattern_init(size, rank, task->reduce_scatter_kn.p.radix,
                                count, &task->reduce_scatter_kn.p);
@@ -436,7 +478,8 @@ static size_t compute_scratch_size(ucc_tl_ucp_task_t *task)
 {
     ucc_coll_args_t      *args      = &TASK_ARGS(task);
     ucc_base_coll_args_t *coll_args = &task->super.bargs;
-    size_t                count     = GET_COUNT(args);
+    size_t                count     = GET_COUNT(args,
+                                                task->subset.map.ep_num);
     size_t                dt_size   = ucc_dt_size(GET_DT(args));
     size_t                max_seg   = task->reduce_scatter_kn.max_seg;
     size_t data_size;
@@ -463,6 +506,13 @@ static size_t compute_scratch_size(ucc_tl_ucp_task_t *task)
         }
     } else {
         step_radix = task->reduce_scatter_kn.p.radix;
+        if ((args->coll_type == UCC_COLL_TYPE_REDUCE_SCATTERV) &&
+            (coll_args->mask & UCC_BASE_CARGS_MAX_FRAG_COUNT)) {
+            /* counts of later posts are not known, no segment is larger
+               than the whole vector */
+            count   = coll_args->max_frag_count;
+            max_seg = count;
+        }
         if (KN_NODE_PROXY == task->reduce_scatter_kn.p.node_type) {
             if (UCC_IS_INPLACE(*args)) {
                 return max_seg * step_radix * dt_size;
@@ -483,19 +533,17 @@ ucc_tl_ucp_reduce_scatter_knomial_init_r(ucc_base_coll_args_t *coll_args,
                                          ucc_kn_radix_t radix)
 {
     ucc_tl_ucp_team_t *tl_team   = ucc_derived_of(team, ucc_tl_ucp_team_t);
-    ucc_memory_type_t  mem_type  = coll_args->args.dst.info.mem_type;
-    size_t             count     = GET_COUNT(&coll_args->args);
+    ucc_memory_type_t  mem_type  = GET_MT(&coll_args->args);
     ucc_coll_type_t    ct        = coll_args->args.coll_type;
     ucc_sbgp_t        *sbgp;
     ucc_tl_ucp_task_t *task;
     ucc_status_t       status;
-    size_t             scratch_size;
+    size_t             scratch_size, count;
     ucc_rank_t         rank, size;
     ptrdiff_t          max_seg_offset;
 
     if (ucc_unlikely(!UCC_IS_INPLACE(coll_args->args) &&
-                     (coll_args->args.src.info.mem_type !=
-                      coll_args->args.dst.info.mem_type))) {
+                     (coll_args->args.src.info.mem_type != mem_type))) {
         return UCC_ERR_NOT_SUPPORTED;
     }
 
@@ -511,8 +559,9 @@ ucc_tl_ucp_reduce_scatter_knomial_init_r(ucc_base_coll_args_t *coll_args,
         task->subset.map    = sbgp->map;
     }
 
-    rank = task->subset.myrank;
-    size = task->subset.map.ep_num;
+    rank  = task->subset.myrank;
+    size  = task->subset.map.ep_num;
+    count = GET_COUNT(&coll_args->args, size);
 
     if (ct == UCC_COLL_TYPE_ALLREDUCE) {
         ucc_kn_rsx_pattern_init(size, rank, radix,
@@ -521,14 +570,23 @@ ucc_tl_ucp_reduce_scatter_knomial_init_r(ucc_base_coll_args_t *coll_args,
     } else if (ct == UCC_COLL_TYPE_REDUCE) {
         ucc_kn_rsx_pattern_init(size, VRANK(rank, coll_args->args.root, size),
                                 radix, count, &task->reduce_scatter_kn.p);
+    } else if (ct == UCC_COLL_TYPE_REDUCE_SCATTERV) {
+        ucc_kn_rsv_pattern_init(size, rank, radix,
+                                coll_args->args.dst.info_v.counts,
+                                UCC_COLL_ARGS_COUNT64(&coll_args->args),
+                                &task->reduce_scatter_kn.p);
     } else {
         ucc_kn_rs_pattern_init(size, rank, radix,
                                count, &task->reduce_scatter_kn.p);
     }
 
-    ucc_kn_rs_pattern_peer_seg(0, &task->reduce_scatter_kn.p,
-                               &task->reduce_scatter_kn.max_seg,
-                               &max_seg_offset);
+    if (ct == UCC_COLL_TYPE_REDUCE_SCATTERV) {
+        ucc_tl_ucp_reduce_scatterv_kn_max_seg(task);
+    } else {
+        ucc_kn_rs_pattern_peer_seg(0, &task->reduce_scatter_kn.p,
+                                   &task->reduce_scatter_kn.max_seg,
+                                   &max_seg_offset);
+    }
     task->reduce_scatter_kn.scratch_mc_header = NULL;
 
     scratch_size = compute_scratch_size(task);
@@ -1,11 +1,12 @@
 /**
- * Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
 #include "tl_ucp.h"
 #include "reduce_scatterv.h"
 #include "utils/ucc_coll_utils.h"
+#include "utils/ucc_math.h"
 
 ucc_base_coll_alg_info_t
     ucc_tl_ucp_reduce_scatterv_algs[UCC_TL_UCP_REDUCE_SCATTERV_ALG_LAST + 1] = {
@@ -13,5 +14,61 @@ ucc_base_coll_alg_info_t
             {.id   = UCC_TL_UCP_REDUCE_SCATTERV_ALG_RING,
              .name = "ring",
              .desc = "O(N) ring"},
+        [UCC_TL_UCP_REDUCE_SCATTERV_ALG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_REDUCE_SCATTERV_ALG_KNOMIAL,
+             .name = "knomial",
+             .desc = "recursive k-ing with arbitrary radix, split by counts"},
+        [UCC_TL_UCP_REDUCE_SCATTERV_ALG_SRA_KNOMIAL] =
+            {.id   = UCC_TL_UCP_REDUCE_SCATTERV_ALG_SRA_KNOMIAL,
+             .name = "sra_knomial",
+             .desc = "balanced knomial reduce-scatter followed by "
+                     "redistribution to blocks, targets skewed counts"},
+        [UCC_TL_UCP_REDUCE_SCATTERV_ALG_AUTO] =
+            {.id   = UCC_TL_UCP_REDUCE_SCATTERV_ALG_AUTO,
+             .name = "auto",
+             .desc = "selects knomial, sra_knomial or ring based on team size "
+                     "and counts"},
         [UCC_TL_UCP_REDUCE_SCATTERV_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
+
+/* dst counts are the same on all ranks so the choice below is consistent
+   across the team */
+ucc_status_t
+ucc_tl_ucp_reduce_scatterv_auto_init(ucc_base_coll_args_t *coll_args,
+                                     ucc_base_team_t      *team,
+                                     ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t       *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    ucc_coll_args_t         *args    = &coll_args->args;
+    ucc_rank_t               tsize   = UCC_TL_TEAM_SIZE(tl_team);
+    size_t                   dt_size = ucc_dt_size(args->dst.info_v.datatype);
+    size_t                   total   = 0;
+    size_t                   max     = 0;
+    size_t                   block;
+    ucc_rank_t               i;
+
+    for (i = 0; i < tsize; i++) {
+        block  = ucc_coll_args_get_count(args, args->dst.info_v.counts, i) *
+                 dt_size;
+        total += block;
+        max    = ucc_max(max, block);
+    }
+
+    if (total <= cfg->reduce_scatterv_auto_small_thresh) {
+        return ucc_tl_ucp_reduce_scatterv_knomial_init(coll_args, team,
+                                                       task_h);
+    }
+    /* sra knomial does not support counts changing between fragments */
+    if (!(coll_args->mask & UCC_BASE_CARGS_MAX_FRAG_COUNT) &&
+        (max * tsize >= (size_t)cfg->reduce_scatterv_auto_imbalance * total)) {
+        return ucc_tl_ucp_reduce_scatterv_sra_knomial_init(coll_args, team,
+                                                           task_h);
+    }
+    /* ring does not support AVG with pre-op */
+    if ((tsize <= cfg->reduce_scatterv_auto_ring_max_team) &&
+        !(cfg->reduce_avg_pre_op && args->op == UCC_OP_AVG)) {
+        return ucc_tl_ucp_reduce_scatterv_ring_init(coll_args, team, task_h);
+    }
+    return ucc_tl_ucp_reduce_scatterv_knomial_init(coll_args, team, task_h);
+}
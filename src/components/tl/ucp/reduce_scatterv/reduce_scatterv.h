@@ -10,6 +10,9 @@
 enum
 {
     UCC_TL_UCP_REDUCE_SCATTERV_ALG_RING,
+    UCC_TL_UCP_REDUCE_SCATTERV_ALG_KNOMIAL,
+    UCC_TL_UCP_REDUCE_SCATTERV_ALG_SRA_KNOMIAL,
+    UCC_TL_UCP_REDUCE_SCATTERV_ALG_AUTO,
     UCC_TL_UCP_REDUCE_SCATTERV_ALG_LAST
 };
 
@@ -17,7 +20,7 @@ extern ucc_base_coll_alg_info_t
     ucc_tl_ucp_reduce_scatterv_algs[UCC_TL_UCP_REDUCE_SCATTERV_ALG_LAST + 1];
 
 #define UCC_TL_UCP_REDUCE_SCATTERV_DEFAULT_ALG_SELECT_STR                      \
-    "reduce_scatterv:@ring"
+    "reduce_scatterv:@auto"
 
 static inline int ucc_tl_ucp_reduce_scatterv_alg_from_str(const char *str)
 {
@@ -34,4 +37,19 @@ ucc_status_t
 ucc_tl_ucp_reduce_scatterv_ring_init(ucc_base_coll_args_t *coll_args,
                                      ucc_base_team_t *     team,
                                      ucc_coll_task_t **    task_h);
+
+ucc_status_t
+ucc_tl_ucp_reduce_scatterv_knomial_init(ucc_base_coll_args_t *coll_args,
+                                        ucc_base_team_t      *team,
+                                        ucc_coll_task_t     **task_h);
+
+ucc_status_t
+ucc_tl_ucp_reduce_scatterv_sra_knomial_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
+ucc_status_t
+ucc_tl_ucp_reduce_scatterv_auto_init(ucc_base_coll_args_t *coll_args,
+                                     ucc_base_team_t      *team,
+                                     ucc_coll_task_t     **task_h);
 #endif
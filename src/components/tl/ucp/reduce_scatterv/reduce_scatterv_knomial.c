@@ -0,0 +1,251 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatterv.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/sra_knomial.h"
+#include "components/mc/ucc_mc.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "../reduce_scatter/reduce_scatter.h"
+
+/* Knomial reduce_scatterv is the knomial reduce_scatter driven by
+   KN_PATTERN_REDUCE_SCATTERV: at every iteration the current block is split
+   along rank boundaries, so the amount of data exchanged follows the counts
+   of the ranks and ranks with zero counts only take part in the
+   synchronization.
+
+   SRA knomial reduce_scatterv is intended for skewed counts. The whole vector
+   is reduced with knomial reduce-scatter over an even split (same as the 1st
+   step of SRA allreduce) so every rank reduces total / N elements regardless
+   of the counts. Then every rank fetches its block from the owners of the
+   even segments overlapping it. */
+
+static inline ucc_kn_radix_t
+ucc_tl_ucp_reduce_scatterv_kn_radix(ucc_tl_ucp_team_t *team, size_t count)
+{
+    return ucc_knomial_pattern_get_min_radix(
+        UCC_TL_UCP_TEAM_LIB(team)->cfg.reduce_scatterv_kn_radix,
+        UCC_TL_TEAM_SIZE(team), count);
+}
+
+ucc_status_t
+ucc_tl_ucp_reduce_scatterv_knomial_init(ucc_base_coll_args_t *coll_args,
+                                        ucc_base_team_t      *team,
+                                        ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    size_t             count;
+
+    count = ucc_coll_args_get_total_count(&coll_args->args,
+                                          coll_args->args.dst.info_v.counts,
+                                          UCC_TL_TEAM_SIZE(tl_team));
+    return ucc_tl_ucp_reduce_scatter_knomial_init_r(
+        coll_args, team, task_h,
+        ucc_tl_ucp_reduce_scatterv_kn_radix(tl_team, count));
+}
+
+static void
+ucc_tl_ucp_reduce_scatterv_sra_knomial_redist_progress(ucc_coll_task_t *ctask)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+    task->super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(ctask, "ucp_reduce_scatterv_sra_kn_done",
+                                     0);
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_scatterv_sra_knomial_redist_start(ucc_coll_task_t *ctask)
+{
+    ucc_tl_ucp_task_t *task     = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         size     = task->subset.map.ep_num;
+    ucc_rank_t         trank    = UCC_TL_TEAM_RANK(team);
+    ucc_kn_radix_t     radix    = task->reduce_scatterv_sra_kn.radix;
+    void              *scratch  = task->reduce_scatterv_sra_kn.scratch;
+    size_t             dt_size  = ucc_dt_size(args->dst.info_v.datatype);
+    ucc_memory_type_t  mem_type = args->dst.info_v.mem_type;
+    void              *dst      = args->dst.info_v.buffer;
+    size_t             total, my_offset, my_count, offset, count, lo, hi;
+    size_t             seg_count;
+    ptrdiff_t          seg_offset;
+    ucc_rank_t         i, peer;
+    ucc_status_t       status;
+
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    total     = ucc_coll_args_get_total_count(args, args->dst.info_v.counts,
+                                              size);
+    my_offset = ucc_buffer_vector_block_offset(args->dst.info_v.counts,
+                                               UCC_COLL_ARGS_COUNT64(args),
+                                               trank);
+    my_count  = ucc_coll_args_get_count(args, args->dst.info_v.counts, trank);
+    if (UCC_IS_INPLACE(*args)) {
+        dst = PTR_OFFSET(dst, my_offset * dt_size);
+    }
+
+    /* send parts of the reduced segment to the ranks whose blocks overlap it */
+    ucc_sra_kn_get_offset_and_seglen(total, 1, task->subset.myrank, size,
+                                     radix, &seg_offset, &seg_count);
+    offset = 0;
+    for (peer = 0; peer < size && seg_count > 0; peer++) {
+        count = ucc_coll_args_get_count(args, args->dst.info_v.counts, peer);
+        lo    = ucc_max(offset, (size_t)seg_offset);
+        hi    = ucc_min(offset + count, seg_offset + seg_count);
+        if (lo < hi && peer != trank) {
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(PTR_OFFSET(scratch, lo * dt_size),
+                                             (hi - lo) * dt_size, mem_type,
+                                             peer, team, task),
+                          task, out);
+        }
+        offset += count;
+    }
+
+    /* collect own block from the owners of the overlapping segments */
+    for (i = 0; i < size && my_count > 0; i++) {
+        ucc_sra_kn_get_offset_and_seglen(total, 1, i, size, radix, &seg_offset,
+                                         &seg_count);
+        lo = ucc_max(my_offset, (size_t)seg_offset);
+        hi = ucc_min(my_offset + my_count, seg_offset + seg_count);
+        if (lo >= hi) {
+            continue;
+        }
+        peer = ucc_ep_map_eval(task->subset.map, i);
+        if (peer == trank) {
+            status = ucc_mc_memcpy(PTR_OFFSET(dst, (lo - my_offset) * dt_size),
+                                   PTR_OFFSET(scratch, lo * dt_size),
+                                   (hi - lo) * dt_size, mem_type, mem_type);
+            if (ucc_unlikely(status != UCC_OK)) {
+                return status;
+            }
+        } else {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(PTR_OFFSET(dst, (lo - my_offset) *
+                                                                 dt_size),
+                                             (hi - lo) * dt_size, mem_type,
+                                             peer, team, task),
+                          task, out);
+        }
+    }
+
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+out:
+    return task->super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_scatterv_sra_knomial_start(ucc_coll_task_t *task)
+{
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(task, "ucp_reduce_scatterv_sra_kn_start",
+                                     0);
+    return ucc_schedule_start(task);
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_scatterv_sra_knomial_finalize(ucc_coll_task_t *task)
+{
+    ucc_tl_ucp_schedule_t *schedule =
+        ucc_derived_of(task, ucc_tl_ucp_schedule_t);
+    ucc_status_t status;
+
+    ucc_mc_free(schedule->scratch_mc_header);
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(&schedule->super.super);
+    return status;
+}
+
+ucc_status_t
+ucc_tl_ucp_reduce_scatterv_sra_knomial_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t     *tl_team  = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t       *args     = &coll_args->args;
+    ucc_datatype_t         dt       = args->dst.info_v.datatype;
+    ucc_memory_type_t      mem_type = args->dst.info_v.mem_type;
+    ucc_base_coll_args_t   rs_args  = *coll_args;
+    ucc_tl_ucp_schedule_t *tl_schedule;
+    ucc_schedule_t        *schedule;
+    ucc_coll_task_t       *rs_task, *task;
+    ucc_tl_ucp_task_t     *redist;
+    ucc_kn_radix_t         radix;
+    ucc_status_t           status;
+    size_t                 total;
+
+    /* scratch and the even split are sized by the total count at init, the
+       total of later fragments is not known */
+    if (coll_args->mask & UCC_BASE_CARGS_MAX_FRAG_COUNT) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    total = ucc_coll_args_get_total_count(args, args->dst.info_v.counts,
+                                          UCC_TL_TEAM_SIZE(tl_team));
+    radix = ucc_tl_ucp_reduce_scatterv_kn_radix(tl_team, total);
+
+    status = ucc_tl_ucp_get_schedule(tl_team, coll_args, &tl_schedule);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    schedule = &tl_schedule->super.super;
+    UCC_CHECK_GOTO(ucc_mc_alloc(&tl_schedule->scratch_mc_header,
+                                total * ucc_dt_size(dt), mem_type),
+                   out, status);
+
+    /* 1st step: knomial reduce-scatter of the whole vector into scratch,
+       the same as the 1st step of SRA allreduce */
+    rs_args.mask                 &= ~UCC_BASE_CARGS_MAX_FRAG_COUNT;
+    rs_args.args.coll_type        = UCC_COLL_TYPE_ALLREDUCE;
+    rs_args.args.flags           &= ~UCC_COLL_ARGS_FLAG_IN_PLACE;
+    rs_args.args.src.info.buffer  = UCC_IS_INPLACE(*args)
+                                        ? args->dst.info_v.buffer
+                                        : args->src.info.buffer;
+    rs_args.args.src.info.count    = total;
+    rs_args.args.src.info.datatype = dt;
+    rs_args.args.src.info.mem_type = mem_type;
+    rs_args.args.dst.info.buffer   = tl_schedule->scratch_mc_header->addr;
+    rs_args.args.dst.info.count    = total;
+    rs_args.args.dst.info.datatype = dt;
+    rs_args.args.dst.info.mem_type = mem_type;
+    UCC_CHECK_GOTO(ucc_tl_ucp_reduce_scatter_knomial_init_r(&rs_args, team,
+                                                            &rs_task, radix),
+                   out_free, status);
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, rs_task), out_free, status);
+    UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super, rs_task,
+                                          UCC_EVENT_SCHEDULE_STARTED),
+                   out_free, status);
+
+    /* 2nd step: redistribution of the reduced segments to the blocks */
+    redist = ucc_tl_ucp_init_task(coll_args, team);
+    redist->subset = ucc_derived_of(rs_task, ucc_tl_ucp_task_t)->subset;
+    redist->reduce_scatterv_sra_kn.scratch =
+        tl_schedule->scratch_mc_header->addr;
+    redist->reduce_scatterv_sra_kn.radix = radix;
+    redist->super.post     = ucc_tl_ucp_reduce_scatterv_sra_knomial_redist_start;
+    redist->super.progress =
+        ucc_tl_ucp_reduce_scatterv_sra_knomial_redist_progress;
+    task = &redist->super;
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, task), out_free, status);
+    UCC_CHECK_GOTO(ucc_task_subscribe_dep(rs_task, task, UCC_EVENT_COMPLETED),
+                   out_free, status);
+
+    schedule->super.flags   |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    schedule->super.post     = ucc_tl_ucp_reduce_scatterv_sra_knomial_start;
+    schedule->super.finalize = ucc_tl_ucp_reduce_scatterv_sra_knomial_finalize;
+    *task_h                  = &schedule->super;
+    return UCC_OK;
+
+out_free:
+    ucc_mc_free(tl_schedule->scratch_mc_header);
+out:
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
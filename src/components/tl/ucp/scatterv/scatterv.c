@@ -19,11 +19,14 @@ ucc_base_coll_alg_info_t
             {.id   = UCC_TL_UCP_SCATTERV_ALG_LINEAR,
              .name = "linear",
              .desc = "linear scatterv algorithm"},
+        [UCC_TL_UCP_SCATTERV_ALG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_SCATTERV_ALG_KNOMIAL,
+             .name = "knomial",
+             .desc = "scatterv over knomial tree with arbitrary radix and "
+                     "optional fragmentation"},
         [UCC_TL_UCP_SCATTERV_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
-ucc_status_t ucc_tl_ucp_scatterv_linear_init(ucc_tl_ucp_task_t *task);
-
 ucc_status_t ucc_tl_ucp_scatterv_init(ucc_tl_ucp_task_t *task)
 {
     ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
@@ -34,5 +37,5 @@ ucc_status_t ucc_tl_ucp_scatterv_init(ucc_tl_ucp_task_t *task)
         return UCC_ERR_NOT_SUPPORTED;
     }
 
-    return ucc_tl_ucp_scatterv_linear_init(task);
+    return ucc_tl_ucp_scatterv_linear_init_common(task);
 }
@@ -0,0 +1,248 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "scatterv.h"
+#include "gatherv/gatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "components/mc/ucc_mc.h"
+#include "utils/ucc_math.h"
+
+/* Mirror of knomial gatherv: subtree sizes are sent up the tree first, then
+   every rank receives data of its subtree from the parent fragment by
+   fragment and forwards children parts of every fragment as soon as it
+   arrives. */
+
+static void ucc_tl_ucp_scatterv_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task    = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         tsize   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root    = args->root;
+    ucc_rank_t         vrank   = VRANK(UCC_TL_TEAM_RANK(team), root, tsize);
+    uint32_t           n_frags = task->gatherv_kn.n_frags;
+    ucc_rank_t         n       = task->gatherv_kn.n_children;
+    uint64_t          *sizes   = task->gatherv_kn.sizes;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size, count;
+    ucc_rank_t         c, peer;
+    uint32_t           f;
+    ucc_status_t       status;
+    void              *blob, *src;
+
+    if (vrank == 0) {
+        mtype   = args->src.info_v.mem_type;
+        dt_size = ucc_dt_size(args->src.info_v.datatype);
+    } else {
+        mtype   = args->dst.info.mem_type;
+        dt_size = ucc_dt_size(args->dst.info.datatype);
+    }
+
+    if (task->gatherv_kn.phase == UCC_TL_UCP_GATHERV_KN_PHASE_SIZES) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        if (vrank != 0) {
+            status = ucc_tl_ucp_gatherv_kn_tree_sizes_done(task);
+            if (ucc_unlikely(status != UCC_OK)) {
+                task->super.status = status;
+                return;
+            }
+        }
+        task->gatherv_kn.phase = UCC_TL_UCP_GATHERV_KN_PHASE_POST;
+    }
+
+    /* leaf receives own data directly to dst */
+    blob = (vrank != 0 && n == 0) ? args->dst.info.buffer
+                                  : task->gatherv_kn.scratch;
+    while (task->gatherv_kn.frag < n_frags) {
+        f = task->gatherv_kn.frag;
+        if (task->gatherv_kn.phase == UCC_TL_UCP_GATHERV_KN_PHASE_POST) {
+            if (vrank != 0) {
+                peer = INV_VRANK(
+                    ucc_tl_ucp_gatherv_kn_parent(vrank, task->gatherv_kn.radix),
+                    root, tsize);
+                UCPCHECK_GOTO(
+                    ucc_tl_ucp_recv_nz(
+                        PTR_OFFSET(blob, ucc_tl_ucp_gatherv_kn_tree_offset(
+                                             task, f, n)),
+                        sizes[n * n_frags + f], mtype, peer, team, task),
+                    task, out);
+            }
+            task->gatherv_kn.phase = UCC_TL_UCP_GATHERV_KN_PHASE_WAIT;
+        }
+        if (UCC_INPROGRESS == ucc_tl_ucp_test_recv(task)) {
+            return;
+        }
+        for (c = 0; c < n; c++) {
+            peer = INV_VRANK(task->gatherv_kn.children[c], root, tsize);
+            if (task->gatherv_kn.direct[c]) {
+                src = PTR_OFFSET(args->src.info_v.buffer,
+                                 ucc_coll_args_get_displacement(
+                                     args, args->src.info_v.displacements,
+                                     peer) * dt_size);
+            } else {
+                src = PTR_OFFSET(blob,
+                                 ucc_tl_ucp_gatherv_kn_tree_offset(task, f, c));
+            }
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nz(src, sizes[c * n_frags + f],
+                                             mtype, peer, team, task),
+                          task, out);
+        }
+        if (vrank != 0 && n > 0) {
+            count  = args->dst.info.count;
+            status = ucc_mc_memcpy(
+                PTR_OFFSET(args->dst.info.buffer,
+                           ucc_tl_ucp_gatherv_kn_frag_offset(count, dt_size,
+                                                             n_frags, f)),
+                PTR_OFFSET(blob, ucc_tl_ucp_gatherv_kn_tree_offset(task, f, n)),
+                ucc_tl_ucp_gatherv_kn_frag_size(count, dt_size, n_frags, f),
+                mtype, mtype);
+            if (ucc_unlikely(status != UCC_OK)) {
+                task->super.status = status;
+                return;
+            }
+        }
+        task->gatherv_kn.frag++;
+        task->gatherv_kn.phase = UCC_TL_UCP_GATHERV_KN_PHASE_POST;
+    }
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatterv_kn_done", 0);
+}
+
+/* root packs data of children subtrees which are not contiguous in src or
+   are fragmented into scratch */
+static ucc_status_t ucc_tl_ucp_scatterv_knomial_pack(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         tsize   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root    = args->root;
+    uint32_t           n_frags = task->gatherv_kn.n_frags;
+    ucc_rank_t         n       = task->gatherv_kn.n_children;
+    ucc_memory_type_t  mtype   = args->src.info_v.mem_type;
+    size_t             dt_size = ucc_dt_size(args->src.info_v.datatype);
+    size_t             offset, count, len;
+    ucc_rank_t         c, i, rank, subtree;
+    uint32_t           f;
+    ucc_status_t       status;
+    void              *src;
+
+    for (f = 0; f < n_frags; f++) {
+        for (c = 0; c < n; c++) {
+            if (task->gatherv_kn.direct[c]) {
+                continue;
+            }
+            offset  = ucc_tl_ucp_gatherv_kn_tree_offset(task, f, c);
+            subtree = ucc_tl_ucp_gatherv_kn_subtree_size(
+                task->gatherv_kn.children[c], task->gatherv_kn.radix, tsize);
+            for (i = 0; i < subtree; i++) {
+                rank  = INV_VRANK(task->gatherv_kn.children[c] + i, root,
+                                  tsize);
+                count = ucc_coll_args_get_count(args, args->src.info_v.counts,
+                                                rank);
+                len   = ucc_tl_ucp_gatherv_kn_frag_size(count, dt_size,
+                                                        n_frags, f);
+                src   = PTR_OFFSET(args->src.info_v.buffer,
+                                   ucc_coll_args_get_displacement(
+                                       args, args->src.info_v.displacements,
+                                       rank) * dt_size +
+                                   ucc_tl_ucp_gatherv_kn_frag_offset(
+                                       count, dt_size, n_frags, f));
+                status = ucc_mc_memcpy(PTR_OFFSET(task->gatherv_kn.scratch,
+                                                  offset),
+                                       src, len, mtype, mtype);
+                if (ucc_unlikely(status != UCC_OK)) {
+                    return status;
+                }
+                offset += len;
+            }
+        }
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_scatterv_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    size_t             dt_size;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatterv_kn_start", 0);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    /* computes root sizes and scratch used by pack */
+    status = ucc_tl_ucp_gatherv_kn_tree_start(task);
+    if (ucc_unlikely(status != UCC_OK)) {
+        return status;
+    }
+    if (UCC_IS_ROOT(*args, trank)) {
+        if (!UCC_IS_INPLACE(*args)) {
+            dt_size = ucc_dt_size(args->src.info_v.datatype);
+            status  = ucc_mc_memcpy(
+                args->dst.info.buffer,
+                PTR_OFFSET(args->src.info_v.buffer,
+                           ucc_coll_args_get_displacement(
+                               args, args->src.info_v.displacements, trank) *
+                               dt_size),
+                ucc_coll_args_get_count(args, args->src.info_v.counts, trank) *
+                    dt_size,
+                args->dst.info.mem_type, args->src.info_v.mem_type);
+            if (ucc_unlikely(status != UCC_OK)) {
+                return status;
+            }
+        }
+        status = ucc_tl_ucp_scatterv_knomial_pack(task);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_knomial_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t       *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    ucc_rank_t               tsize   = UCC_TL_TEAM_SIZE(tl_team);
+    ucc_tl_ucp_task_t       *task;
+    ucc_kn_radix_t           radix;
+    ucc_status_t             status;
+
+    if (!ucc_coll_args_is_predefined_dt(&coll_args->args,
+                                        UCC_TL_TEAM_RANK(tl_team))) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    radix  = ucc_max(2, ucc_min(cfg->scatterv_kn_radix, tsize));
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_gatherv_kn_tree_init(
+        task, radix, ucc_max(cfg->scatterv_kn_num_frags, 1));
+    if (ucc_unlikely(status != UCC_OK)) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_scatterv_knomial_start;
+    task->super.progress = ucc_tl_ucp_scatterv_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_gatherv_kn_tree_finalize;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
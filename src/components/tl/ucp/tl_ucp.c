@@ -131,6 +131,17 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_sra_kn_pipeline),
      UCC_CONFIG_TYPE_PIPELINE_PARAMS},
 
+    {"ALLREDUCE_RING_FRAG_SIZE", "256k",
+     "Maximal fragment size of the ring allreduce algorithm. Reduction of a "
+     "fragment overlaps with transfers of the neighbouring ones",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_ring_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_RING_BIDIRECTIONAL", "y",
+     "Launch 2 inverted rings concurrently during Allreduce Ring algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_ring_bidirectional),
+     UCC_CONFIG_TYPE_BOOL},
+
     {"REDUCE_SCATTER_KN_RADIX", "4",
      "Radix of the knomial reduce-scatter algorithm",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_scatter_kn_radix),
@@ -140,6 +151,17 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, allgather_kn_radix),
      UCC_CONFIG_TYPE_UINT_RANGED},
 
+    {"ALLGATHERV_AUTO_SMALL_THRESH", "64k",
+     "Total message size up to which the auto allgatherv algorithm uses bruck",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allgatherv_auto_small_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLGATHERV_AUTO_IMBALANCE", "4",
+     "Ratio of the largest block times team size to the total message size\n"
+     "starting from which the auto allgatherv algorithm uses sparbit",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allgatherv_auto_imbalance),
+     UCC_CONFIG_TYPE_UINT},
+
     {"BCAST_KN_RADIX", "4", "Radix of the recursive-knomial bcast algorithm",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_kn_radix),
      UCC_CONFIG_TYPE_UINT},
@@ -149,6 +171,18 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_sag_kn_radix),
      UCC_CONFIG_TYPE_UINT_RANGED},
 
+    {"BCAST_CHAIN_PIPELINE", "auto",
+     "Pipelining settings for chain bcast algorithm, segment size is the\n"
+     "fragment size",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_chain_pipeline),
+     UCC_CONFIG_TYPE_PIPELINE_PARAMS},
+
+    {"BCAST_SAG_RING_PIPELINE", "auto",
+     "Pipelining settings for scatter + ring allgather bcast algorithm,\n"
+     "segment size is the fragment size",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_sag_ring_pipeline),
+     UCC_CONFIG_TYPE_PIPELINE_PARAMS},
+
     {"REDUCE_KN_RADIX", "4", "Radix of the knomial tree reduce algorithm",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_kn_radix),
      UCC_CONFIG_TYPE_UINT},
@@ -173,6 +207,17 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, gatherv_linear_num_posts),
      UCC_CONFIG_TYPE_UINT},
 
+    {"GATHERV_KN_RADIX", "4", "Radix of the knomial tree gatherv algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, gatherv_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"GATHERV_KN_NUM_FRAGS", "1",
+     "Number of fragments the data of every rank is split into in knomial\n"
+     "gatherv algorithm. Fragments are forwarded up the tree as soon as they\n"
+     "arrive, value greater than 1 pipelines large messages over tree levels",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, gatherv_kn_num_frags),
+     UCC_CONFIG_TYPE_UINT},
+
     {"SCATTER_KN_RADIX", "4", "Radix of the knomial scatter algorithm",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, scatter_kn_radix),
      UCC_CONFIG_TYPE_UINT},
@@ -188,6 +233,18 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, scatterv_linear_num_posts),
      UCC_CONFIG_TYPE_UINT},
 
+    {"SCATTERV_KN_RADIX", "4", "Radix of the knomial tree scatterv algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, scatterv_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"SCATTERV_KN_NUM_FRAGS", "1",
+     "Number of fragments the data of every rank is split into in knomial\n"
+     "scatterv algorithm. Fragments are forwarded down the tree as soon as\n"
+     "they arrive, value greater than 1 pipelines large messages over tree\n"
+     "levels",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, scatterv_kn_num_frags),
+     UCC_CONFIG_TYPE_UINT},
+
     {"REDUCE_AVG_PRE_OP", "1",
      "Reduce will perform division by team_size in early stages of the "
      "algorithm,\n"
@@ -206,6 +263,29 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_scatterv_ring_bidirectional),
      UCC_CONFIG_TYPE_BOOL},
 
+    {"REDUCE_SCATTERV_KN_RADIX", "4",
+     "Radix of the knomial and sra_knomial reduce-scatterv algorithms",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_scatterv_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"REDUCE_SCATTERV_AUTO_SMALL_THRESH", "64k",
+     "Total message size up to which the auto reduce-scatterv algorithm\n"
+     "uses knomial",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_scatterv_auto_small_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"REDUCE_SCATTERV_AUTO_IMBALANCE", "4",
+     "Ratio of the largest block times team size to the total message size\n"
+     "starting from which the auto reduce-scatterv algorithm uses sra_knomial",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_scatterv_auto_imbalance),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"REDUCE_SCATTERV_AUTO_RING_MAX_TEAM", "8",
+     "Max team size for which the auto reduce-scatterv algorithm uses ring\n"
+     "for large balanced messages, larger teams use knomial",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_scatterv_auto_ring_max_team),
+     UCC_CONFIG_TYPE_UINT},
+
     {"USE_TOPO", "try",
      "Allow usage of tl ucp topo",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, use_topo),
@@ -276,6 +356,19 @@ static ucs_config_field_t ucc_tl_ucp_context_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_context_config_t, memtype_copy_enable),
      UCC_CONFIG_TYPE_BOOL},
 
+    {"RCACHE", "y",
+     "Register buffers of one-sided collectives that are not mapped through "
+     "context mem_params using registration cache. If disabled, such "
+     "buffers are not supported by one-sided algorithms",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, rcache_enable),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"RKEY_CACHE_SIZE", "4096",
+     "Maximal number of unpacked remote keys of peer registrations kept by "
+     "the context. The cache is flushed when the limit is reached",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, rkey_cache_size),
+     UCC_CONFIG_TYPE_UINT},
+
     {NULL}};
 
 UCC_CLASS_DEFINE_NEW_FUNC(ucc_tl_ucp_lib_t, ucc_base_lib_t,
@@ -11,6 +11,7 @@
 #include "core/ucc_ee.h"
 #include "utils/ucc_mpool.h"
 #include "tl_ucp_ep_hash.h"
+#include "tl_ucp_rcache.h"
 #include "schedule/ucc_schedule_pipelined.h"
 #include <ucp/api/ucp.h>
 #include <ucs/memory/memory_type.h>
@@ -20,6 +21,9 @@
 #define UCC_TL_UCP_DEFAULT_SCORE 10
 #endif
 
+/* size of the elements of the context scratch mpool */
+#define UCC_TL_UCP_SCRATCH_MP_SIZE 4096
+
 #ifdef HAVE_PROFILING_TL_UCP
 #include "utils/profile/ucc_profile.h"
 #else
@@ -55,22 +59,36 @@ typedef struct ucc_tl_ucp_lib_config {
     ucc_mrange_uint_t        allreduce_sra_kn_radix;
     uint32_t                 reduce_scatter_kn_radix;
     ucc_mrange_uint_t        allgather_kn_radix;
+    size_t                   allgatherv_auto_small_thresh;
+    uint32_t                 allgatherv_auto_imbalance;
     uint32_t                 bcast_kn_radix;
     ucc_mrange_uint_t        bcast_sag_kn_radix;
+    ucc_pipeline_params_t    bcast_chain_pipeline;
+    ucc_pipeline_params_t    bcast_sag_ring_pipeline;
     uint32_t                 reduce_kn_radix;
     ucc_pipeline_params_t    reduce_srg_kn_pipeline;
     ucc_mrange_uint_t        reduce_srg_kn_radix;
     uint32_t                 gather_kn_radix;
     uint32_t                 gatherv_linear_num_posts;
+    uint32_t                 gatherv_kn_radix;
+    uint32_t                 gatherv_kn_num_frags;
     uint32_t                 scatter_kn_radix;
     ucc_on_off_auto_value_t  scatter_kn_enable_recv_zcopy;
     uint32_t                 scatterv_linear_num_posts;
+    uint32_t                 scatterv_kn_radix;
+    uint32_t                 scatterv_kn_num_frags;
     unsigned long            alltoall_pairwise_num_posts;
     unsigned long            alltoallv_pairwise_num_posts;
     ucc_pipeline_params_t    allreduce_sra_kn_pipeline;
+    size_t                   allreduce_ring_frag_size;
+    int                      allreduce_ring_bidirectional;
     int                      reduce_avg_pre_op;
     int                      reduce_scatter_ring_bidirectional;
     int                      reduce_scatterv_ring_bidirectional;
+    uint32_t                 reduce_scatterv_kn_radix;
+    size_t                   reduce_scatterv_auto_small_thresh;
+    uint32_t                 reduce_scatterv_auto_imbalance;
+    uint32_t                 reduce_scatterv_auto_ring_max_team;
     uint32_t                 alltoallv_hybrid_radix;
     size_t                   alltoallv_hybrid_buff_size;
     size_t                   alltoallv_hybrid_chunk_byte_limit;
@@ -99,6 +117,8 @@ typedef struct ucc_tl_ucp_context_config {
     uint32_t                     service_throttling_thresh;
     ucc_tl_ucp_local_copy_type_t local_copy_type;
     int                          memtype_copy_enable;
+    int                          rcache_enable;
+    uint32_t                     rkey_cache_size;
 } ucc_tl_ucp_context_config_t;
 
 typedef ucc_tl_ucp_lib_config_t ucc_tl_ucp_team_config_t;
@@ -198,11 +218,20 @@ typedef struct ucc_tl_ucp_context {
     } sendrecv_cbs;
     uint32_t                    service_worker_throttling_count;
     ucc_mpool_t                 req_mp;
+    /* host scratch of small message collectives */
+    ucc_mpool_t                 scratch_mp;
     ucc_tl_ucp_remote_info_t *  remote_info;
     ucp_rkey_h *                rkeys;
     uint64_t                    n_rinfo_segs;
     uint64_t                    ucp_memory_types;
     int                         topo_required;
+    /* registrations of buffers not mapped through mem_params */
+    ucc_rcache_t               *rcache;
+    uint64_t                    rcache_reg_id;
+    tl_ucp_rkey_cache_t        *rkey_cache;
+    ucc_spinlock_t              rkey_cache_lock;
+    /* tasks holding rkeys from rkey_cache */
+    uint32_t                    rkey_cache_users;
     struct {
         ucc_tl_ucp_copy_post_fn_t     post;
         ucc_tl_ucp_copy_test_fn_t     test;
@@ -6,6 +6,7 @@
 
 #include "tl_ucp.h"
 #include "tl_ucp_coll.h"
+#include "tl_ucp_sendrecv.h"
 #include "components/mc/ucc_mc.h"
 #include "core/ucc_team.h"
 #include "barrier/barrier.h"
@@ -39,8 +40,8 @@ const ucc_tl_ucp_default_alg_desc_t
             .str_get_fn = ucc_tl_ucp_alltoall_score_str_get
         },
         {
-            .select_str = UCC_TL_UCP_ALLREDUCE_DEFAULT_ALG_SELECT_STR,
-            .str_get_fn = NULL
+            .select_str = NULL,
+            .str_get_fn = ucc_tl_ucp_allreduce_score_str_get
         },
         {
             .select_str = UCC_TL_UCP_BCAST_DEFAULT_ALG_SELECT_STR,
@@ -61,6 +62,14 @@ const ucc_tl_ucp_default_alg_desc_t
         {
             .select_str = UCC_TL_UCP_ALLTOALLV_DEFAULT_ALG_SELECT_STR,
             .str_get_fn = NULL
+        },
+        {
+            .select_str = UCC_TL_UCP_GATHERV_DEFAULT_ALG_SELECT_STR,
+            .str_get_fn = NULL
+        },
+        {
+            .select_str = UCC_TL_UCP_SCATTERV_DEFAULT_ALG_SELECT_STR,
+            .str_get_fn = NULL
         }
 };
 
@@ -177,15 +186,274 @@ void ucc_tl_ucp_recv_completion_cb_st(void *request, ucs_status_t status,
     ucp_request_free(request);
 }
 
+static void ucc_tl_ucp_dyn_segs_finalize(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_context_t  *ctx  = TASK_CTX(task);
+    ucc_tl_ucp_dyn_segs_t *segs = task->dyn_segs;
+    int                    i;
+
+    for (i = 0; i < segs->n_segs; i++) {
+        if (segs->regions[i]) {
+            ucc_tl_ucp_mem_dereg(ctx, segs->regions[i]);
+        }
+    }
+    ucc_free(segs->keys);
+    ucc_free(segs->info);
+    ucc_free(segs);
+    task->dyn_segs = NULL;
+    ucc_tl_ucp_rkey_cache_release(ctx);
+}
+
+ucc_status_t ucc_tl_ucp_dyn_segs_init(ucc_tl_ucp_task_t *task, int n_segs,
+                                      void **bufs, size_t *lens,
+                                      ucc_memory_type_t *mem_types)
+{
+    ucc_tl_ucp_team_t         *team  = TASK_TEAM(task);
+    ucc_tl_ucp_context_t      *ctx   = UCC_TL_UCP_TEAM_CTX(team);
+    ucc_rank_t                 tsize = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t                 trank = UCC_TL_TEAM_RANK(team);
+    ucc_tl_ucp_dyn_segs_t     *segs;
+    ucc_tl_ucp_dyn_seg_info_t *info;
+    ucc_status_t               status;
+    size_t                     size;
+    int                        i;
+
+    ucc_assert(n_segs <= UCC_TL_UCP_DYN_SEGS_MAX);
+    if (!ctx->rcache) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    segs = ucc_calloc(1, sizeof(*segs), "tl_ucp_dyn_segs");
+    if (!segs) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for dyn segs",
+                 sizeof(*segs));
+        return UCC_ERR_NO_MEMORY;
+    }
+    /* single allocation for info, key offsets and rkeys arrays */
+    size = tsize * (n_segs * (sizeof(*segs->info) + sizeof(ucp_rkey_h)) +
+                    sizeof(size_t));
+    segs->info = ucc_calloc(1, size, "tl_ucp_dyn_segs_info");
+    if (!segs->info) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for dyn segs",
+                 size);
+        ucc_free(segs);
+        return UCC_ERR_NO_MEMORY;
+    }
+    segs->rkeys       = PTR_OFFSET(segs->info,
+                                   tsize * n_segs * sizeof(*segs->info));
+    segs->key_offsets = PTR_OFFSET(segs->rkeys,
+                                   tsize * n_segs * sizeof(ucp_rkey_h));
+    segs->n_segs      = n_segs;
+    segs->phase       = UCC_TL_UCP_DYN_SEGS_PHASE_INIT;
+    task->dyn_segs    = segs;
+    ucc_tl_ucp_rkey_cache_hold(ctx);
+
+    info = &segs->info[trank * n_segs];
+    for (i = 0; i < n_segs; i++) {
+        status = ucc_tl_ucp_mem_reg(ctx, bufs[i], lens[i], mem_types[i],
+                                    &segs->regions[i]);
+        if (ucc_unlikely(status != UCC_OK)) {
+            ucc_tl_ucp_dyn_segs_finalize(task);
+            return status;
+        }
+        info[i].base     = (uint64_t)bufs[i];
+        info[i].len      = lens[i];
+        info[i].reg_base = segs->regions[i]->super.super.start;
+        info[i].reg_id   = segs->regions[i]->id;
+        info[i].key_len  = segs->regions[i]->packed_key_len;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_dyn_segs_exchange_start(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t     *team   = TASK_TEAM(task);
+    ucc_rank_t             tsize  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t             trank  = UCC_TL_TEAM_RANK(team);
+    ucc_tl_ucp_dyn_segs_t *segs   = task->dyn_segs;
+    int                    n_segs = segs->n_segs;
+    size_t                 info_size = n_segs * sizeof(*segs->info);
+    ucc_rank_t             peer;
+    int                    i;
+
+    /* persistent collective: peers may have registered new buffers */
+    ucc_free(segs->keys);
+    segs->keys = NULL;
+    memset(segs->rkeys, 0, tsize * n_segs * sizeof(ucp_rkey_h));
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    for (peer = 0; peer < tsize; peer++) {
+        if (peer == trank) {
+            continue;
+        }
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(&segs->info[peer * n_segs], info_size,
+                                         UCC_MEMORY_TYPE_HOST, peer, team,
+                                         task),
+                      task, out);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(&segs->info[trank * n_segs],
+                                         info_size, UCC_MEMORY_TYPE_HOST, peer,
+                                         team, task),
+                      task, out);
+        /* tag matching is ordered, peer gets keys after the info */
+        for (i = 0; i < n_segs; i++) {
+            if (segs->regions[i]->packed_key_len == 0) {
+                continue;
+            }
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(segs->regions[i]->packed_key,
+                                             segs->regions[i]->packed_key_len,
+                                             UCC_MEMORY_TYPE_HOST, peer, team,
+                                             task),
+                          task, out);
+        }
+    }
+    segs->phase = UCC_TL_UCP_DYN_SEGS_PHASE_INFO;
+    return UCC_OK;
+out:
+    return task->super.status;
+}
+
+static ucc_status_t ucc_tl_ucp_dyn_segs_recv_keys(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t         *team   = TASK_TEAM(task);
+    ucc_rank_t                 tsize  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t                 trank  = UCC_TL_TEAM_RANK(team);
+    ucc_tl_ucp_dyn_segs_t     *segs   = task->dyn_segs;
+    int                        n_segs = segs->n_segs;
+    ucc_tl_ucp_dyn_seg_info_t *info;
+    size_t                     total, offset;
+    ucc_rank_t                 peer;
+    int                        i;
+
+    total = 0;
+    for (peer = 0; peer < tsize; peer++) {
+        segs->key_offsets[peer] = total;
+        for (i = 0; i < n_segs; i++) {
+            total += segs->info[peer * n_segs + i].key_len;
+        }
+    }
+    segs->keys = ucc_malloc(ucc_max(total, 1), "tl_ucp_dyn_segs_keys");
+    if (!segs->keys) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for rkeys",
+                 total);
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (peer = 0; peer < tsize; peer++) {
+        info   = &segs->info[peer * n_segs];
+        offset = segs->key_offsets[peer];
+        for (i = 0; i < n_segs; offset += info[i].key_len, i++) {
+            if (info[i].key_len == 0) {
+                continue;
+            }
+            if (peer == trank) {
+                memcpy(PTR_OFFSET(segs->keys, offset),
+                       segs->regions[i]->packed_key, info[i].key_len);
+                continue;
+            }
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(PTR_OFFSET(segs->keys, offset),
+                                             info[i].key_len,
+                                             UCC_MEMORY_TYPE_HOST, peer, team,
+                                             task),
+                          task, out);
+        }
+    }
+    return UCC_OK;
+out:
+    return task->super.status;
+}
+
+ucc_status_t ucc_tl_ucp_dyn_segs_exchange_test(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_dyn_segs_t *segs = task->dyn_segs;
+    ucc_status_t           status;
+
+    switch (segs->phase) {
+    case UCC_TL_UCP_DYN_SEGS_PHASE_INFO:
+        /* wait for recvs only: peers receive keys after they get our info */
+        status = ucc_tl_ucp_test_recv(task);
+        if (status != UCC_OK) {
+            return status;
+        }
+        status = ucc_tl_ucp_dyn_segs_recv_keys(task);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+        segs->phase = UCC_TL_UCP_DYN_SEGS_PHASE_KEYS;
+        /* fall through */
+    case UCC_TL_UCP_DYN_SEGS_PHASE_KEYS:
+        status = ucc_tl_ucp_test(task);
+        if (status != UCC_OK) {
+            return status;
+        }
+        /* tagged and onesided counters share the storage */
+        ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+        segs->phase = UCC_TL_UCP_DYN_SEGS_PHASE_READY;
+        /* fall through */
+    default:
+        return UCC_OK;
+    }
+}
+
+ucc_status_t ucc_tl_ucp_dyn_segs_resolve(ucc_tl_ucp_task_t *task, void *va,
+                                         ucc_rank_t peer, ucc_rank_t ctx_peer,
+                                         ucp_ep_h ep, uint64_t *rva,
+                                         ucp_rkey_h *rkey)
+{
+    ucc_tl_ucp_dyn_segs_t       *segs   = task->dyn_segs;
+    int                          n_segs = segs->n_segs;
+    ucc_rank_t                   trank  = UCC_TL_TEAM_RANK(TASK_TEAM(task));
+    ucc_tl_ucp_dyn_seg_info_t   *local  = &segs->info[trank * n_segs];
+    ucc_tl_ucp_dyn_seg_info_t   *info   = &segs->info[peer * n_segs];
+    size_t                       offset = segs->key_offsets[peer];
+    ucc_tl_ucp_rkey_cache_key_t  key;
+    ucc_status_t                 status;
+    int                          i;
+
+    ucc_assert(segs->phase == UCC_TL_UCP_DYN_SEGS_PHASE_READY);
+    for (i = 0; i < n_segs; offset += info[i].key_len, i++) {
+        if ((uint64_t)va < local[i].base ||
+            (uint64_t)va >= local[i].base + ucc_max(local[i].len, 1)) {
+            continue;
+        }
+        if (ucc_unlikely(!segs->rkeys[peer * n_segs + i])) {
+            key.rank = ctx_peer;
+            key.base = info[i].reg_base;
+            key.id   = info[i].reg_id;
+            status   = ucc_tl_ucp_rkey_cache_get(
+                TASK_CTX(task), ep, &key, PTR_OFFSET(segs->keys, offset),
+                &segs->rkeys[peer * n_segs + i]);
+            if (ucc_unlikely(status != UCC_OK)) {
+                return status;
+            }
+        }
+        *rkey = segs->rkeys[peer * n_segs + i];
+        *rva  = info[i].base + ((uint64_t)va - local[i].base);
+        return UCC_OK;
+    }
+    return UCC_ERR_NOT_FOUND;
+}
+
 ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task)
 {
     ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
 
     tl_trace(UCC_TASK_LIB(task), "finalizing task %p", task);
+    if (task->dyn_segs) {
+        ucc_tl_ucp_dyn_segs_finalize(task);
+    }
     ucc_tl_ucp_put_task(task);
     return UCC_OK;
 }
 
+ucc_status_t ucc_tl_ucp_coll_rebind(ucc_coll_task_t      *coll_task,
+                                    ucc_base_coll_args_t *coll_args)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_assert(!(task->flags & UCC_TL_UCP_TASK_FLAG_SUBSET));
+    memcpy(&coll_task->bargs, coll_args, sizeof(*coll_args));
+    ucc_tl_ucp_task_set_tag(task, &coll_args->args);
+    return UCC_OK;
+}
+
 ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_args_t *coll_args,
                                   ucc_base_team_t *team,
                                   ucc_coll_task_t **task_h)
@@ -248,6 +516,8 @@ ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_args_t *coll_args,
 static inline int alg_id_from_str(ucc_coll_type_t coll_type, const char *str)
 {
     switch (coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+        return ucc_tl_ucp_barrier_alg_from_str(str);
     case UCC_COLL_TYPE_ALLGATHER:
         return ucc_tl_ucp_allgather_alg_from_str(str);
     case UCC_COLL_TYPE_ALLGATHERV:
@@ -266,6 +536,10 @@ static inline int alg_id_from_str(ucc_coll_type_t coll_type, const char *str)
         return ucc_tl_ucp_reduce_scatter_alg_from_str(str);
     case UCC_COLL_TYPE_REDUCE_SCATTERV:
         return ucc_tl_ucp_reduce_scatterv_alg_from_str(str);
+    case UCC_COLL_TYPE_GATHERV:
+        return ucc_tl_ucp_gatherv_alg_from_str(str);
+    case UCC_COLL_TYPE_SCATTERV:
+        return ucc_tl_ucp_scatterv_alg_from_str(str);
     default:
         break;
     }
@@ -284,6 +558,22 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
     }
 
     switch (coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+        switch (alg_id) {
+        case UCC_TL_UCP_BARRIER_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_barrier_knomial_init;
+            break;
+        case UCC_TL_UCP_BARRIER_ALG_DISSEMINATION:
+            *init = ucc_tl_ucp_barrier_dissemination_init;
+            break;
+        case UCC_TL_UCP_BARRIER_ALG_TOURNAMENT:
+            *init = ucc_tl_ucp_barrier_tournament_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
     case UCC_COLL_TYPE_ALLGATHER:
         switch (alg_id) {
         case UCC_TL_UCP_ALLGATHER_ALG_KNOMIAL:
@@ -314,6 +604,18 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_ALLGATHERV_ALG_RING:
             *init = ucc_tl_ucp_allgatherv_ring_init;
             break;
+        case UCC_TL_UCP_ALLGATHERV_ALG_NEIGHBOR:
+            *init = ucc_tl_ucp_allgatherv_neighbor_init;
+            break;
+        case UCC_TL_UCP_ALLGATHERV_ALG_BRUCK:
+            *init = ucc_tl_ucp_allgatherv_bruck_init;
+            break;
+        case UCC_TL_UCP_ALLGATHERV_ALG_SPARBIT:
+            *init = ucc_tl_ucp_allgatherv_sparbit_init;
+            break;
+        case UCC_TL_UCP_ALLGATHERV_ALG_AUTO:
+            *init = ucc_tl_ucp_allgatherv_auto_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -333,6 +635,15 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_ALLREDUCE_ALG_SLIDING_WINDOW:
             *init = ucc_tl_ucp_allreduce_sliding_window_init;
             break;
+        case UCC_TL_UCP_ALLREDUCE_ALG_RING:
+            *init = ucc_tl_ucp_allreduce_ring_init;
+            break;
+        case UCC_TL_UCP_ALLREDUCE_ALG_RD:
+            *init = ucc_tl_ucp_allreduce_rd_init;
+            break;
+        case UCC_TL_UCP_ALLREDUCE_ALG_SWING:
+            *init = ucc_tl_ucp_allreduce_swing_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -349,6 +660,12 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_BCAST_ALG_DBT:
             *init = ucc_tl_ucp_bcast_dbt_init;
             break;
+        case UCC_TL_UCP_BCAST_ALG_CHAIN:
+            *init = ucc_tl_ucp_bcast_chain_init;
+            break;
+        case UCC_TL_UCP_BCAST_ALG_SAG_RING:
+            *init = ucc_tl_ucp_bcast_sag_ring_init;
+            break;
         default:
            status = UCC_ERR_INVALID_PARAM;
            break;
@@ -420,6 +737,41 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_REDUCE_SCATTERV_ALG_RING:
             *init = ucc_tl_ucp_reduce_scatterv_ring_init;
             break;
+        case UCC_TL_UCP_REDUCE_SCATTERV_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_reduce_scatterv_knomial_init;
+            break;
+        case UCC_TL_UCP_REDUCE_SCATTERV_ALG_SRA_KNOMIAL:
+            *init = ucc_tl_ucp_reduce_scatterv_sra_knomial_init;
+            break;
+        case UCC_TL_UCP_REDUCE_SCATTERV_ALG_AUTO:
+            *init = ucc_tl_ucp_reduce_scatterv_auto_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_GATHERV:
+        switch (alg_id) {
+        case UCC_TL_UCP_GATHERV_ALG_LINEAR:
+            *init = ucc_tl_ucp_gatherv_linear_init;
+            break;
+        case UCC_TL_UCP_GATHERV_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_gatherv_knomial_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_SCATTERV:
+        switch (alg_id) {
+        case UCC_TL_UCP_SCATTERV_ALG_LINEAR:
+            *init = ucc_tl_ucp_scatterv_linear_init;
+            break;
+        case UCC_TL_UCP_SCATTERV_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_scatterv_knomial_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
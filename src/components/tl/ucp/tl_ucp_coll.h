@@ -18,7 +18,7 @@
 
 #define UCC_UUNITS_AUTO_RADIX 4
 #define UCC_TL_UCP_TASK_PLUGIN_MAX_DATA 128
-#define UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR 9
+#define UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR 11
 
 ucc_status_t ucc_tl_ucp_team_default_score_str_alloc(ucc_tl_ucp_team_t *team,
     char *default_select_str[UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR]);
@@ -96,6 +96,38 @@ typedef struct ucc_tl_ucp_allreduce_sw_host_allgather
 typedef struct ucc_tl_ucp_dpu_offload_buf_info
     ucc_tl_ucp_dpu_offload_buf_info_t;
 
+#define UCC_TL_UCP_DYN_SEGS_MAX 2
+
+enum ucc_tl_ucp_dyn_segs_phase {
+    UCC_TL_UCP_DYN_SEGS_PHASE_INIT,
+    UCC_TL_UCP_DYN_SEGS_PHASE_INFO,
+    UCC_TL_UCP_DYN_SEGS_PHASE_KEYS,
+    UCC_TL_UCP_DYN_SEGS_PHASE_READY
+};
+
+/* Segment descriptor exchanged between ranks */
+typedef struct ucc_tl_ucp_dyn_seg_info {
+    uint64_t base;
+    uint64_t len;
+    uint64_t reg_base; /* start of registration covering the segment */
+    uint64_t reg_id;
+    uint64_t key_len;
+} ucc_tl_ucp_dyn_seg_info_t;
+
+/* Buffers of one-sided collective that are not mapped through context
+   mem_params. They are registered through tl/ucp rcache at init, segment
+   descriptors and packed rkeys are exchanged at post, remote rkeys are
+   taken from context rkey cache. */
+typedef struct ucc_tl_ucp_dyn_segs {
+    int                         n_segs;
+    int                         phase;
+    ucc_tl_ucp_rcache_region_t *regions[UCC_TL_UCP_DYN_SEGS_MAX];
+    ucc_tl_ucp_dyn_seg_info_t  *info;        /* [team_size][n_segs] */
+    size_t                     *key_offsets; /* [team_size] */
+    ucp_rkey_h                 *rkeys;       /* [team_size][n_segs] */
+    void                       *keys;        /* packed keys of all ranks */
+} ucc_tl_ucp_dyn_segs_t;
+
 typedef struct ucc_tl_ucp_task {
     ucc_coll_task_t super;
     uint32_t        flags;
@@ -116,9 +148,11 @@ typedef struct ucc_tl_ucp_task {
     };
     uint32_t        n_polls;
     ucc_subset_t    subset;
+    ucc_tl_ucp_dyn_segs_t *dyn_segs;
     union {
         struct {
             int                     phase;
+            int                     round;
             ucc_knomial_pattern_t   p;
         } barrier;
         struct {
@@ -129,6 +163,16 @@ typedef struct ucc_tl_ucp_task {
             ucc_ee_executor_task_t *etask;
             ucc_ee_executor_t      *executor;
         } allreduce_kn;
+        struct {
+            int                     phase;
+            int                     step;
+            int                     swing;
+            int                     inline_reduce;
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+            ucc_ee_executor_task_t *etask;
+            ucc_ee_executor_t      *executor;
+        } allreduce_rd;
         struct {
             ucc_tl_ucp_allreduce_sw_pipeline          *pipe;
             ucs_status_ptr_t                          *put_requests;
@@ -156,6 +200,19 @@ typedef struct ucc_tl_ucp_task {
             ucc_ee_executor_task_t *etask;
             ucc_ee_executor_t      *executor;
         } reduce_scatter_ring;
+        struct {
+            void                   *scratch;
+            ucc_kn_radix_t          radix;
+        } reduce_scatterv_sra_kn;
+        struct {
+            void                   *scratch;
+            size_t                  max_frag_count;
+            int                     n_frags;
+            uint32_t                frag;     /* next fragment to receive */
+            int                     reducing; /* reduction of frag - 1 */
+            ucc_ee_executor_task_t *etask;
+            ucc_ee_executor_t      *executor;
+        } allreduce_ring;
         struct {
             void                   *scratch;
             size_t                  max_block_count;
@@ -210,6 +267,11 @@ typedef struct ucc_tl_ucp_task {
             ucc_rank_t              dist;
             uint32_t                radix;
         } bcast_kn;
+        struct {
+            int                     phase;
+            ucc_rank_t              dist;
+            ucc_rank_t              step;
+        } bcast_sag_ring;
         struct {
             ucc_dbt_single_tree_t   t1;
             ucc_dbt_single_tree_t   t2;
@@ -245,6 +307,20 @@ typedef struct ucc_tl_ucp_task {
             void *                  scratch;
             ucc_mc_buffer_header_t *scratch_mc_header;
         } gather_kn;
+        struct {
+            /* used by both knomial gatherv and scatterv */
+            int                     phase;
+            ucc_kn_radix_t          radix;
+            uint32_t                n_frags;
+            uint32_t                frag;
+            ucc_rank_t              n_children;
+            ucc_rank_t             *children;
+            uint64_t               *sizes;
+            uint8_t                *direct;
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+            size_t                  scratch_size;
+        } gatherv_kn;
         struct {
             size_t                  merge_buf_size;
             ucc_mc_buffer_header_t *scratch_mc_header;
@@ -313,6 +389,7 @@ static inline ucc_tl_ucp_task_t *ucc_tl_ucp_get_task(ucc_tl_ucp_team_t *team)
     task->subset.map.type   = UCC_EP_MAP_FULL;
     task->subset.map.ep_num = UCC_TL_TEAM_SIZE(team);
     task->subset.myrank     = UCC_TL_TEAM_RANK(team);
+    task->dyn_segs          = NULL;
     ucc_tl_ucp_task_reset(task, UCC_OPERATION_INITIALIZED);
     return task;
 }
@@ -352,6 +429,52 @@ ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_args_t *coll_args,
 
 ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task);
 
+/* Rebind method for algorithms reading buffers from task args at post and
+   progress time only, see ucc_coll_rebind_fn_t */
+ucc_status_t ucc_tl_ucp_coll_rebind(ucc_coll_task_t      *coll_task,
+                                    ucc_base_coll_args_t *coll_args);
+
+/* Registers buffers of one-sided collective that are not part of context
+   mem_params, lens are in bytes. Returns UCC_ERR_NOT_SUPPORTED if rcache
+   is disabled. */
+ucc_status_t ucc_tl_ucp_dyn_segs_init(ucc_tl_ucp_task_t *task, int n_segs,
+                                      void **bufs, size_t *lens,
+                                      ucc_memory_type_t *mem_types);
+
+/* Starts exchange of segment info and rkeys with all team ranks, uses
+   task tag and tagged counters */
+ucc_status_t ucc_tl_ucp_dyn_segs_exchange_start(ucc_tl_ucp_task_t *task);
+
+/* Progresses exchange, on UCC_OK task counters are reset and one-sided
+   operations on dynamic segments can be posted */
+ucc_status_t ucc_tl_ucp_dyn_segs_exchange_test(ucc_tl_ucp_task_t *task);
+
+/* Resolves remote address and rkey of va, returns UCC_ERR_NOT_FOUND if va
+   does not belong to dynamic segments of the task */
+ucc_status_t ucc_tl_ucp_dyn_segs_resolve(ucc_tl_ucp_task_t *task, void *va,
+                                         ucc_rank_t peer, ucc_rank_t ctx_peer,
+                                         ucp_ep_h ep, uint64_t *rva,
+                                         ucp_rkey_h *rkey);
+
+static inline int ucc_tl_ucp_dyn_segs_ready(ucc_tl_ucp_task_t *task)
+{
+    return !task->dyn_segs ||
+           task->dyn_segs->phase == UCC_TL_UCP_DYN_SEGS_PHASE_READY;
+}
+
+static inline void ucc_tl_ucp_task_set_tag(ucc_tl_ucp_task_t *task,
+                                           ucc_coll_args_t   *args)
+{
+    ucc_tl_ucp_team_t *tl_team = TASK_TEAM(task);
+
+    if (args->mask & UCC_COLL_ARGS_FIELD_TAG) {
+        task->tagged.tag = args->tag;
+    } else {
+        tl_team->seq_num = (tl_team->seq_num + 1) % UCC_TL_UCP_MAX_COLL_TAG;
+        task->tagged.tag = tl_team->seq_num;
+    }
+}
+
 static inline ucc_tl_ucp_task_t *
 ucc_tl_ucp_init_task(ucc_base_coll_args_t *coll_args, ucc_base_team_t *team)
 {
@@ -374,12 +497,7 @@ ucc_tl_ucp_init_task(ucc_base_coll_args_t *coll_args, ucc_base_team_t *team)
                                   UCC_TL_TEAM_RANK(tl_team));
         ucc_assert(coll_args->args.coll_type == UCC_COLL_TYPE_BCAST);
     } else {
-        if (coll_args->args.mask & UCC_COLL_ARGS_FIELD_TAG) {
-            task->tagged.tag = coll_args->args.tag;
-        } else {
-            tl_team->seq_num = (tl_team->seq_num + 1) % UCC_TL_UCP_MAX_COLL_TAG;
-            task->tagged.tag = tl_team->seq_num;
-        }
+        ucc_tl_ucp_task_set_tag(task, &coll_args->args);
     }
 
     task->super.finalize       = ucc_tl_ucp_coll_finalize;
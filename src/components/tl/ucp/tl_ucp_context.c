@@ -270,6 +270,17 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
         goto err_thread_mode;
     }
 
+    ucc_status = ucc_mpool_init(
+        &self->scratch_mp, 0, UCC_TL_UCP_SCRATCH_MP_SIZE, 0,
+        UCC_CACHE_LINE_SIZE, 8, UINT_MAX, NULL, params->thread_mode,
+        "tl_ucp_scratch_mp");
+    if (UCC_OK != ucc_status) {
+        tl_error(self->super.super.lib,
+                 "failed to initialize tl_ucp_scratch mpool");
+        ucc_mpool_cleanup(&self->req_mp, 1);
+        goto err_thread_mode;
+    }
+
     CHECK(UCC_OK != ucc_context_progress_register(
                         params->context,
                         (ucc_context_progress_fn_t)ucp_worker_progress,
@@ -295,6 +306,10 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
           "failed to allocate memory for endpoint storage", err_thread_mode,
           UCC_ERR_NO_MESSAGE, self);
 
+    CHECK(UCC_OK != ucc_tl_ucp_rcache_create(self),
+          "failed to create registration cache", err_thread_mode,
+          UCC_ERR_NO_MEMORY, self);
+
     if (self->cfg.service_worker) {
         CHECK(UCC_OK != ucc_tl_ucp_context_service_init(
                             prefix, ucp_params, worker_params, params, self),
@@ -443,6 +458,7 @@ UCC_CLASS_CLEANUP_FUNC(ucc_tl_ucp_context_t)
     if (self->remote_info) {
         ucc_tl_ucp_rinfo_destroy(self);
     }
+    ucc_tl_ucp_rcache_destroy(self);
     ucc_context_progress_deregister(
         self->super.super.ucc_context,
         (ucc_context_progress_fn_t)ucp_worker_progress,
@@ -454,6 +470,7 @@ UCC_CLASS_CLEANUP_FUNC(ucc_tl_ucp_context_t)
             self);
     }
     ucc_mpool_cleanup(&self->req_mp, 1);
+    ucc_mpool_cleanup(&self->scratch_mp, 1);
     ucc_tl_ucp_eps_cleanup(&self->worker, self);
     if (self->cfg.service_worker != 0) {
         ucc_tl_ucp_eps_cleanup(&self->service_worker, self);
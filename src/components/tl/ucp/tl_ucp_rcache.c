@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_ucp.h"
+#include "tl_ucp_rcache.h"
+
+static ucs_status_t
+ucc_tl_ucp_rcache_mem_reg(void *context, ucc_rcache_t *rcache, //NOLINT
+                          void *arg, ucc_rcache_region_t *rregion,
+                          uint16_t flags) //NOLINT: flags is unused
+{
+    ucc_tl_ucp_context_t       *ctx    = (ucc_tl_ucp_context_t *)context;
+    ucc_tl_ucp_rcache_region_t *region =
+        ucc_derived_of(rregion, ucc_tl_ucp_rcache_region_t);
+    ucp_mem_map_params_t        mmap_params;
+    ucs_status_t                status;
+
+    mmap_params.field_mask  = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                              UCP_MEM_MAP_PARAM_FIELD_LENGTH  |
+                              UCP_MEM_MAP_PARAM_FIELD_MEMORY_TYPE;
+    mmap_params.address     = (void *)rregion->super.start;
+    mmap_params.length      = rregion->super.end - rregion->super.start;
+    mmap_params.memory_type = *(ucs_memory_type_t *)arg;
+
+    status = ucp_mem_map(ctx->worker.ucp_context, &mmap_params,
+                         &region->memh);
+    if (ucc_unlikely(status != UCS_OK)) {
+        tl_debug(ctx->super.super.lib, "ucp_mem_map failed for %p len %zd: %s",
+                 mmap_params.address, mmap_params.length,
+                 ucs_status_string(status));
+        return status;
+    }
+    status = ucp_rkey_pack(ctx->worker.ucp_context, region->memh,
+                           &region->packed_key, &region->packed_key_len);
+    if (ucc_unlikely(status != UCS_OK)) {
+        tl_debug(ctx->super.super.lib, "ucp_rkey_pack failed: %s",
+                 ucs_status_string(status));
+        ucp_mem_unmap(ctx->worker.ucp_context, region->memh);
+        return status;
+    }
+    region->id = ++ctx->rcache_reg_id;
+    return UCS_OK;
+}
+
+static void ucc_tl_ucp_rcache_mem_dereg(void *context,
+                                        ucc_rcache_t *rcache, //NOLINT
+                                        ucc_rcache_region_t *rregion)
+{
+    ucc_tl_ucp_context_t       *ctx    = (ucc_tl_ucp_context_t *)context;
+    ucc_tl_ucp_rcache_region_t *region =
+        ucc_derived_of(rregion, ucc_tl_ucp_rcache_region_t);
+
+    ucp_rkey_buffer_release(region->packed_key);
+    ucp_mem_unmap(ctx->worker.ucp_context, region->memh);
+}
+
+static void ucc_tl_ucp_rcache_dump_region(void *context, //NOLINT
+                                          ucc_rcache_t *rcache, //NOLINT
+                                          ucc_rcache_region_t *rregion,
+                                          char *buf, size_t max)
+{
+    ucc_tl_ucp_rcache_region_t *region =
+        ucc_derived_of(rregion, ucc_tl_ucp_rcache_region_t);
+
+    snprintf(buf, max, "memh:%p id:%lu", region->memh, region->id);
+}
+
+static ucc_rcache_ops_t ucc_tl_ucp_rcache_ops = {
+    .mem_reg     = ucc_tl_ucp_rcache_mem_reg,
+    .mem_dereg   = ucc_tl_ucp_rcache_mem_dereg,
+    .dump_region = ucc_tl_ucp_rcache_dump_region,
+#ifdef UCS_HAVE_RCACHE_MERGE_CB
+    .merge       = ucc_rcache_merge_cb_empty
+#endif
+};
+
+ucc_status_t ucc_tl_ucp_rcache_create(ucc_tl_ucp_context_t *ctx)
+{
+    ucc_rcache_params_t rcache_params;
+    ucc_status_t        status;
+
+    ctx->rcache           = NULL;
+    ctx->rcache_reg_id    = 0;
+    ctx->rkey_cache_users = 0;
+    ctx->rkey_cache       = kh_init(tl_ucp_rkey_cache);
+    if (!ctx->rkey_cache) {
+        tl_error(ctx->super.super.lib, "failed to allocate rkey cache");
+        return UCC_ERR_NO_MEMORY;
+    }
+    ucc_spinlock_init(&ctx->rkey_cache_lock, 0);
+    if (!ctx->cfg.rcache_enable) {
+        return UCC_OK;
+    }
+
+    ucc_rcache_set_default_params(&rcache_params);
+    rcache_params.region_struct_size = sizeof(ucc_tl_ucp_rcache_region_t);
+    rcache_params.context            = ctx;
+    rcache_params.ops                = &ucc_tl_ucp_rcache_ops;
+    rcache_params.ucm_events         = UCM_EVENT_VM_UNMAPPED |
+                                       UCM_EVENT_MEM_TYPE_FREE;
+    status = ucc_rcache_create(&rcache_params, "TL_UCP", &ctx->rcache);
+    if (status != UCC_OK) {
+        /* not fatal: only mem_params buffers are usable by one-sided algs */
+        tl_debug(ctx->super.super.lib, "failed to create rcache: %s",
+                 ucc_status_string(status));
+        ctx->rcache = NULL;
+    }
+    return UCC_OK;
+}
+
+static void ucc_tl_ucp_rkey_cache_flush(ucc_tl_ucp_context_t *ctx)
+{
+    ucp_rkey_h rkey;
+
+    kh_foreach_value(ctx->rkey_cache, rkey, {
+        ucp_rkey_destroy(rkey);
+    });
+    kh_clear(tl_ucp_rkey_cache, ctx->rkey_cache);
+}
+
+void ucc_tl_ucp_rcache_destroy(ucc_tl_ucp_context_t *ctx)
+{
+    if (ctx->rkey_cache) {
+        ucc_tl_ucp_rkey_cache_flush(ctx);
+        kh_destroy(tl_ucp_rkey_cache, ctx->rkey_cache);
+        ucc_spinlock_destroy(&ctx->rkey_cache_lock);
+        ctx->rkey_cache = NULL;
+    }
+    if (ctx->rcache) {
+        ucc_rcache_destroy(ctx->rcache);
+        ctx->rcache = NULL;
+    }
+}
+
+ucc_status_t ucc_tl_ucp_mem_reg(ucc_tl_ucp_context_t *ctx, void *addr,
+                                size_t length, ucc_memory_type_t mem_type,
+                                ucc_tl_ucp_rcache_region_t **region)
+{
+    ucs_memory_type_t    ucs_mt = ucc_memtype_to_ucs[mem_type];
+    ucc_rcache_region_t *rregion;
+    ucc_status_t         status;
+
+    if (!ctx->rcache) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_rcache_get(ctx->rcache, addr, ucc_max(length, 1), &ucs_mt,
+                            &rregion);
+    if (ucc_unlikely(status != UCC_OK)) {
+        tl_error(ctx->super.super.lib, "failed to register %p len %zd: %s",
+                 addr, length, ucc_status_string(status));
+        return status;
+    }
+    *region = ucc_derived_of(rregion, ucc_tl_ucp_rcache_region_t);
+    return UCC_OK;
+}
+
+void ucc_tl_ucp_mem_dereg(ucc_tl_ucp_context_t       *ctx,
+                          ucc_tl_ucp_rcache_region_t *region)
+{
+    ucc_rcache_region_put(ctx->rcache, &region->super);
+}
+
+ucc_status_t ucc_tl_ucp_rkey_cache_get(ucc_tl_ucp_context_t *ctx, ucp_ep_h ep,
+                                       ucc_tl_ucp_rkey_cache_key_t *key,
+                                       const void *packed_key,
+                                       ucp_rkey_h *rkey)
+{
+    ucs_status_t status;
+    khiter_t     k;
+    int          ret;
+
+    ucc_spin_lock(&ctx->rkey_cache_lock);
+    k = kh_get(tl_ucp_rkey_cache, ctx->rkey_cache, *key);
+    if (k != kh_end(ctx->rkey_cache)) {
+        *rkey = kh_value(ctx->rkey_cache, k);
+        ucc_spin_unlock(&ctx->rkey_cache_lock);
+        return UCC_OK;
+    }
+    status = ucp_ep_rkey_unpack(ep, packed_key, rkey);
+    if (ucc_unlikely(status != UCS_OK)) {
+        ucc_spin_unlock(&ctx->rkey_cache_lock);
+        return ucs_status_to_ucc_status(status);
+    }
+    k = kh_put(tl_ucp_rkey_cache, ctx->rkey_cache, *key, &ret);
+    kh_value(ctx->rkey_cache, k) = *rkey;
+    ucc_spin_unlock(&ctx->rkey_cache_lock);
+    return UCC_OK;
+}
+
+void ucc_tl_ucp_rkey_cache_hold(ucc_tl_ucp_context_t *ctx)
+{
+    ucc_spin_lock(&ctx->rkey_cache_lock);
+    ctx->rkey_cache_users++;
+    ucc_spin_unlock(&ctx->rkey_cache_lock);
+}
+
+void ucc_tl_ucp_rkey_cache_release(ucc_tl_ucp_context_t *ctx)
+{
+    ucc_spin_lock(&ctx->rkey_cache_lock);
+    /* rkeys of finished peer registrations are never looked up again, drop
+       everything once the limit is reached and nobody holds cached rkeys */
+    if (--ctx->rkey_cache_users == 0 &&
+        kh_size(ctx->rkey_cache) >= ctx->cfg.rkey_cache_size) {
+        ucc_tl_ucp_rkey_cache_flush(ctx);
+    }
+    ucc_spin_unlock(&ctx->rkey_cache_lock);
+}
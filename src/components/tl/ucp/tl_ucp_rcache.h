@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_TL_UCP_RCACHE_H_
+#define UCC_TL_UCP_RCACHE_H_
+#include "config.h"
+#include "utils/ucc_rcache.h"
+#include "utils/khash.h"
+#include <ucp/api/ucp.h>
+
+typedef struct ucc_tl_ucp_context ucc_tl_ucp_context_t;
+
+/* Local registration: memory handle and packed rkey of the region.
+   id is unique within the context and lets peers tell a new registration
+   of the same address range from the one they have already unpacked. */
+typedef struct ucc_tl_ucp_rcache_region {
+    ucc_rcache_region_t super;
+    ucp_mem_h           memh;
+    void               *packed_key;
+    size_t              packed_key_len;
+    uint64_t            id;
+} ucc_tl_ucp_rcache_region_t;
+
+/* Remote key cache: unpacked rkeys of peer registrations */
+typedef struct ucc_tl_ucp_rkey_cache_key {
+    uint64_t rank; /* ctx rank of the peer */
+    uint64_t base; /* start of the peer registration */
+    uint64_t id;   /* peer registration id */
+} ucc_tl_ucp_rkey_cache_key_t;
+
+static inline khint32_t
+tl_ucp_rkey_cache_hash_fn(ucc_tl_ucp_rkey_cache_key_t k)
+{
+    return kh_int64_hash_func(k.base ^ (k.rank << 48) ^ (k.id << 20));
+}
+
+#define tl_ucp_rkey_cache_equal_fn(_a, _b)                                     \
+    (((_a).rank == (_b).rank) && ((_a).base == (_b).base) &&                   \
+     ((_a).id == (_b).id))
+
+KHASH_INIT(tl_ucp_rkey_cache, ucc_tl_ucp_rkey_cache_key_t, ucp_rkey_h, 1,
+           tl_ucp_rkey_cache_hash_fn, tl_ucp_rkey_cache_equal_fn);
+
+#define tl_ucp_rkey_cache_t khash_t(tl_ucp_rkey_cache)
+
+ucc_status_t ucc_tl_ucp_rcache_create(ucc_tl_ucp_context_t *ctx);
+
+void ucc_tl_ucp_rcache_destroy(ucc_tl_ucp_context_t *ctx);
+
+/* Returns registration covering [addr, addr + length), the region is held
+   until ucc_tl_ucp_mem_dereg */
+ucc_status_t ucc_tl_ucp_mem_reg(ucc_tl_ucp_context_t *ctx, void *addr,
+                                size_t length, ucc_memory_type_t mem_type,
+                                ucc_tl_ucp_rcache_region_t **region);
+
+void ucc_tl_ucp_mem_dereg(ucc_tl_ucp_context_t       *ctx,
+                          ucc_tl_ucp_rcache_region_t *region);
+
+/* Returns rkey of peer registration, unpacks packed_key on first use.
+   Cached rkeys are owned by the context and stay valid while the caller
+   holds the cache. */
+ucc_status_t ucc_tl_ucp_rkey_cache_get(ucc_tl_ucp_context_t *ctx, ucp_ep_h ep,
+                                       ucc_tl_ucp_rkey_cache_key_t *key,
+                                       const void *packed_key,
+                                       ucp_rkey_h *rkey);
+
+void ucc_tl_ucp_rkey_cache_hold(ucc_tl_ucp_context_t *ctx);
+
+void ucc_tl_ucp_rkey_cache_release(ucc_tl_ucp_context_t *ctx);
+
+#endif
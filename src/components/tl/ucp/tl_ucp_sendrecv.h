@@ -344,9 +344,9 @@ static inline ucc_status_t ucc_tl_ucp_recv_nz(void *buffer, size_t msglen,
 }
 
 static inline ucc_status_t
-ucc_tl_ucp_resolve_p2p_by_va(ucc_tl_ucp_team_t *team, void *va, ucp_ep_h *ep,
-                             ucc_rank_t peer, uint64_t *rva, ucp_rkey_h *rkey,
-                             int *segment)
+ucc_tl_ucp_resolve_p2p_by_va(ucc_tl_ucp_team_t *team, ucc_tl_ucp_task_t *task,
+                             void *va, ucp_ep_h *ep, ucc_rank_t peer,
+                             uint64_t *rva, ucp_rkey_h *rkey, int *segment)
 {
     ucc_tl_ucp_context_t *ctx            = UCC_TL_UCP_TEAM_CTX(team);
     ptrdiff_t             key_offset     = 0;
@@ -357,11 +357,22 @@ ucc_tl_ucp_resolve_p2p_by_va(ucc_tl_ucp_team_t *team, void *va, ucp_ep_h *ep,
     void                 *keys;
     void                 *offset;
     ptrdiff_t             base_offset;
+    ucc_rank_t            ctx_peer;
+    ucc_status_t          status;
 
     *segment  = -1;
     core_rank = ucc_ep_map_eval(UCC_TL_TEAM_MAP(team), peer);
     ucc_assert(UCC_TL_CORE_TEAM(team) != NULL);
-    peer = ucc_get_ctx_rank(UCC_TL_CORE_TEAM(team), core_rank);
+    ctx_peer = ucc_get_ctx_rank(UCC_TL_CORE_TEAM(team), core_rank);
+
+    if (task && task->dyn_segs) {
+        status = ucc_tl_ucp_dyn_segs_resolve(task, va, peer, ctx_peer, *ep,
+                                             rva, rkey);
+        if (status != UCC_ERR_NOT_FOUND) {
+            return status;
+        }
+    }
+    peer = ctx_peer;
 
     offset = ucc_get_team_ep_addr(UCC_TL_CORE_CTX(team), UCC_TL_CORE_TEAM(team),
                                   core_rank, ucc_tl_ucp.super.super.id);
@@ -456,8 +467,9 @@ static inline ucc_status_t ucc_tl_ucp_put_nb(void *buffer, void *target,
         return status;
     }
 
-    status = ucc_tl_ucp_resolve_p2p_by_va(team, target, &ep, dest_group_rank,
-                                          &rva, &rkey, &segment);
+    status = ucc_tl_ucp_resolve_p2p_by_va(team, task, target, &ep,
+                                          dest_group_rank, &rva, &rkey,
+                                          &segment);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
@@ -499,8 +511,9 @@ static inline ucc_status_t ucc_tl_ucp_get_nb(void *buffer, void *target,
         return status;
     }
 
-    status = ucc_tl_ucp_resolve_p2p_by_va(team, target, &ep, dest_group_rank,
-                                          &rva, &rkey, &segment);
+    status = ucc_tl_ucp_resolve_p2p_by_va(team, task, target, &ep,
+                                          dest_group_rank, &rva, &rkey,
+                                          &segment);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
@@ -526,7 +539,8 @@ static inline ucc_status_t ucc_tl_ucp_get_nb(void *buffer, void *target,
 
 static inline ucc_status_t ucc_tl_ucp_atomic_inc(void *     target,
                                                  ucc_rank_t dest_group_rank,
-                                                 ucc_tl_ucp_team_t *team)
+                                                 ucc_tl_ucp_team_t *team,
+                                                 ucc_tl_ucp_task_t *task)
 {
     ucp_request_param_t req_param = {0};
     int                 segment   = 0;
@@ -542,8 +556,9 @@ static inline ucc_status_t ucc_tl_ucp_atomic_inc(void *     target,
         return status;
     }
 
-    status = ucc_tl_ucp_resolve_p2p_by_va(team, target, &ep, dest_group_rank,
-                                          &rva, &rkey, &segment);
+    status = ucc_tl_ucp_resolve_p2p_by_va(team, task, target, &ep,
+                                          dest_group_rank, &rva, &rkey,
+                                          &segment);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
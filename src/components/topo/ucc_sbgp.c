@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -13,8 +13,10 @@
 #include <limits.h>
 
 static char *ucc_sbgp_type_str[UCC_SBGP_LAST] = {
-    "numa", "socket",         "node",         "node_leaders",
-    "net",  "socket_leaders", "numa_leaders", "flat"};
+    "numa",         "socket", "node",         "node_leaders",
+    "net",          "socket_leaders",         "numa_leaders",
+    "flat",         "flat_host_ordered",      "rack",
+    "rack_leaders"};
 
 const char* ucc_sbgp_str(ucc_sbgp_type_t type)
 {
@@ -423,6 +425,68 @@ static inline ucc_status_t sbgp_create_full(ucc_topo_t *topo, ucc_sbgp_t *sbgp)
     return UCC_OK;
 }
 
+/* RACK: node leaders of the calling process rack.
+   RACK_LEADERS: first node leader of every rack.
+   Both are built over NODE_LEADERS sbgp, so a rack leader is rank 0 of
+   its RACK sbgp. */
+static ucc_status_t sbgp_create_rack(ucc_topo_t *topo, ucc_sbgp_t *sbgp)
+{
+    ucc_rank_t    myrank    = topo->set.myrank;
+    int           i_am_in   = 0;
+    ucc_rank_t    size      = 0;
+    ucc_sbgp_t   *nl_sbgp;
+    ucc_rank_t   *rack_ranks;
+    ucc_rack_id_t rack_id;
+    ucc_rank_t    i, j, r;
+
+    if (!topo->topo->rack_bound) {
+        return UCC_OK;
+    }
+    nl_sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_NODE_LEADERS);
+    if (nl_sbgp->status == UCC_SBGP_NOT_EXISTS) {
+        return UCC_OK;
+    }
+    rack_ranks = ucc_malloc(nl_sbgp->group_size * sizeof(ucc_rank_t),
+                            "rack_ranks");
+    if (!rack_ranks) {
+        ucc_error("failed to allocate %zd bytes for rack_ranks array",
+                  nl_sbgp->group_size * sizeof(ucc_rank_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < nl_sbgp->group_size; i++) {
+        r       = ucc_ep_map_eval(nl_sbgp->map, i);
+        rack_id = ucc_topo_rack_id(topo, r);
+        if (sbgp->type == UCC_SBGP_RACK) {
+            if (rack_id != ucc_topo_rack_id(topo, myrank)) {
+                continue;
+            }
+        } else {
+            for (j = 0; j < size; j++) {
+                if (ucc_topo_rack_id(topo, rack_ranks[j]) == rack_id) {
+                    break;
+                }
+            }
+            if (j < size) {
+                /* rack has a leader already */
+                continue;
+            }
+        }
+        if (r == myrank) {
+            i_am_in          = 1;
+            sbgp->group_rank = size;
+        }
+        rack_ranks[size++] = r;
+    }
+    if (size > 1) {
+        sbgp->group_size = size;
+        sbgp->rank_map   = rack_ranks;
+        sbgp->status     = i_am_in ? UCC_SBGP_ENABLED : UCC_SBGP_DISABLED;
+    } else {
+        ucc_free(rack_ranks);
+    }
+    return UCC_OK;
+}
+
 typedef struct proc_info_id {
     ucc_proc_info_t info;
     ucc_rank_t      id;
@@ -584,6 +648,10 @@ ucc_status_t ucc_sbgp_create(ucc_topo_t *topo, ucc_sbgp_type_t type)
         status = sbgp_create_node_leaders(
             topo, sbgp, topo->sbgps[UCC_SBGP_NODE].group_rank);
         break;
+    case UCC_SBGP_RACK:
+    case UCC_SBGP_RACK_LEADERS:
+        status = sbgp_create_rack(topo, sbgp);
+        break;
     case UCC_SBGP_SOCKET_LEADERS:
     case UCC_SBGP_NUMA_LEADERS:
         if (!sn_bound) {
@@ -36,6 +36,16 @@ typedef enum ucc_sbgp_type_t
     UCC_SBGP_FULL,               /* Group contains ALL the ranks of the team */
     UCC_SBGP_FULL_HOST_ORDERED,  /* Group contains ALL the ranks of the team ordered
                                     by host, socket, numa */
+    UCC_SBGP_RACK,               /* Group of node leaders (NODE_LEADERS ranks) on
+                                    the nodes of the same rack. Racks are
+                                    defined by UCC_TOPO_FILE, this group does
+                                    not exist if any process has no rack id.
+                                    This group is DISABLED but EXISTS for procs
+                                    which are not node leaders. */
+    UCC_SBGP_RACK_LEADERS,       /* Group of the first node leader of every
+                                    rack. This group EXISTS when team spans at
+                                    least 2 racks. This group is ENABLED for
+                                    rack leaders, DISABLED otherwise. */
     UCC_SBGP_LAST
 } ucc_sbgp_type_t;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -121,6 +121,7 @@ ucc_status_t ucc_context_topo_init(ucc_addr_storage_t * storage,
 
     topo->sock_bound = 1;
     topo->numa_bound = 1;
+    topo->rack_bound = 1;
     topo->n_procs    = storage->size;
     topo->procs      = (ucc_proc_info_t *)ucc_malloc(
         storage->size * sizeof(ucc_proc_info_t), "topo_procs");
@@ -140,6 +141,9 @@ ucc_status_t ucc_context_topo_init(ucc_addr_storage_t * storage,
         if (h->ctx_id.pi.numa_id == UCC_NUMA_ID_INVALID) {
             topo->numa_bound = 0;
         }
+        if (h->ctx_id.pi.rack_id == UCC_RACK_ID_INVALID) {
+            topo->rack_bound = 0;
+        }
     }
     status = ucc_context_topo_compute_layout(topo, storage->size);
     if (UCC_OK != status) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 #ifndef UCC_TOPO_H_
@@ -29,6 +29,8 @@ typedef struct ucc_context_topo {
                                         on a node */
     uint32_t         numa_bound;    /*< global flag, 1 if processes are bound
                                         to numa nodes */
+    uint32_t         rack_bound;    /*< global flag, 1 if all processes have
+                                        rack id from UCC_TOPO_FILE */
 } ucc_context_topo_t;
 
 typedef struct ucc_addr_storage ucc_addr_storage_t;
@@ -113,6 +115,14 @@ static inline int ucc_rank_on_local_node(ucc_rank_t team_rank, ucc_topo_t *topo)
     return procs[ctx_rank].host_hash == procs[my_ctx_rank].host_hash;
 }
 
+static inline ucc_rack_id_t ucc_topo_rack_id(ucc_topo_t *topo,
+                                             ucc_rank_t  team_rank)
+{
+    ucc_rank_t ctx_rank = ucc_ep_map_eval(topo->set.map, team_rank);
+
+    return topo->topo->procs[ctx_rank].rack_id;
+}
+
 /* Returns min ppn value across the nodes */
 static inline ucc_rank_t ucc_topo_min_ppn(ucc_topo_t *topo)
 {
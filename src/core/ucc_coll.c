@@ -18,6 +18,7 @@
 #include "schedule/ucc_schedule.h"
 #include "coll_score/ucc_coll_score.h"
 #include "ucc_ee.h"
+#include "ucc_service_coll.h"
 
 #define UCC_BUFFER_INFO_CHECK_MEM_TYPE(_info) do {                             \
     if ((_info).mem_type == UCC_MEMORY_TYPE_UNKNOWN) {                         \
@@ -177,6 +178,8 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_init,
     ucc_memory_type_t         coll_mem_type;
     ucc_ee_type_t             coll_ee_type;
     size_t                    coll_size;
+    ucc_coll_cache_key_t      cache_key;
+    int                       cacheable;
 
     if (ucc_unlikely(team->state != UCC_TEAM_ACTIVE)) {
         ucc_error("team %p is used before team create is completed", team);
@@ -242,6 +245,26 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_init,
         op_args.asymmetric_save_info.scratch = NULL;
     }
 
+    cacheable = ucc_coll_cache_enabled(&team->coll_cache) &&
+                !op_args.asymmetric_save_info.scratch &&
+                ucc_coll_cache_key_init(&op_args.args, &cache_key);
+    if (cacheable) {
+        task = ucc_coll_cache_get(&team->coll_cache, &cache_key);
+        if (task) {
+            status = task->rebind(task, &op_args);
+            if (ucc_unlikely(status != UCC_OK)) {
+                ucc_error("failed to rebind cached task: %s",
+                          ucc_status_string(status));
+                task->flags &= ~UCC_COLL_TASK_FLAG_CACHED;
+                ucc_collective_finalize_internal(task);
+                return status;
+            }
+            task->super.status = UCC_OPERATION_INITIALIZED;
+            task->flags       &= ~UCC_COLL_TASK_FLAG_CB;
+            goto task_ready;
+        }
+    }
+
     status = ucc_coll_init(team->score_map, &op_args, &task);
     if (UCC_ERR_NOT_SUPPORTED == status) {
         ucc_debug("failed to init collective: not supported");
@@ -252,6 +275,12 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_init,
     }
 
     task->flags |= UCC_COLL_TASK_FLAG_TOP_LEVEL;
+    if (cacheable && task->rebind &&
+        !(op_args.mask & UCC_BASE_CARGS_FALLBACK)) {
+        /* fallback init is skipped on cache hit, which may change TL state
+           differently on different ranks, such tasks are not cached */
+        task->flags |= UCC_COLL_TASK_FLAG_CACHED;
+    }
     if (task->flags & UCC_COLL_TASK_FLAG_EXECUTOR) {
         task->flags |= UCC_COLL_TASK_FLAG_EXECUTOR_STOP;
         coll_mem_type = ucc_coll_args_mem_type(&op_args.args, team->rank);
@@ -281,6 +310,7 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_init,
         }
     }
 
+task_ready:
     if (coll_args->mask & UCC_COLL_ARGS_FIELD_CB) {
         task->cb = coll_args->cb;
         task->flags |= UCC_COLL_TASK_FLAG_CB;
@@ -467,6 +497,12 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_finalize, (request),
             }
         }
     }
+
+    if ((task->flags & UCC_COLL_TASK_FLAG_CACHED) &&
+        (task->super.status == UCC_OK) && !task->ee &&
+        (UCC_OK == ucc_coll_cache_put(&task->bargs.team->coll_cache, task))) {
+        return UCC_OK;
+    }
     return ucc_collective_finalize_internal(task);
 }
 
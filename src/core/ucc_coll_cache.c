@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "ucc_coll_cache.h"
+#include "ucc_service_coll.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_log.h"
+#include "utils/ucc_coll_utils.h"
+
+#define UCC_COLL_CACHE_TYPES                                                   \
+    (UCC_COLL_TYPE_ALLGATHER | UCC_COLL_TYPE_ALLREDUCE |                       \
+     UCC_COLL_TYPE_ALLTOALL | UCC_COLL_TYPE_BARRIER | UCC_COLL_TYPE_BCAST |    \
+     UCC_COLL_TYPE_FANIN | UCC_COLL_TYPE_FANOUT | UCC_COLL_TYPE_GATHER |       \
+     UCC_COLL_TYPE_REDUCE | UCC_COLL_TYPE_REDUCE_SCATTER |                     \
+     UCC_COLL_TYPE_SCATTER)
+
+#define UCC_COLL_CACHE_ARGS_MASK                                               \
+    (UCC_COLL_ARGS_FIELD_FLAGS | UCC_COLL_ARGS_FIELD_TAG |                     \
+     UCC_COLL_ARGS_FIELD_CB)
+
+#define UCC_COLL_CACHE_NO_FLAGS                                                \
+    (UCC_COLL_ARGS_FLAG_PERSISTENT | UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)
+
+static inline void ucc_coll_cache_lock(ucc_coll_cache_t *cache)
+{
+    if (cache->thread_safe) {
+        ucc_spin_lock(&cache->lock);
+    }
+}
+
+static inline void ucc_coll_cache_unlock(ucc_coll_cache_t *cache)
+{
+    if (cache->thread_safe) {
+        ucc_spin_unlock(&cache->lock);
+    }
+}
+
+static inline uint64_t ucc_coll_cache_key_hash(const ucc_coll_cache_key_t *key)
+{
+    const uint64_t *w = (const uint64_t *)key;
+    uint64_t        h = 0xcbf29ce484222325ull;
+    size_t          i;
+
+    for (i = 0; i < sizeof(*key) / sizeof(uint64_t); i++) {
+        h = (h ^ w[i]) * 0x100000001b3ull;
+    }
+    return h ^ (h >> 29);
+}
+
+ucc_status_t ucc_coll_cache_init(ucc_coll_cache_t *cache, uint32_t capacity,
+                                 ucc_thread_mode_t tm)
+{
+    uint32_t i;
+
+    memset(cache, 0, sizeof(*cache));
+    ucc_list_head_init(&cache->lru);
+    ucc_list_head_init(&cache->free);
+    if (capacity == 0) {
+        return UCC_OK;
+    }
+
+    cache->n_buckets = ucc_round_up_power2(capacity);
+    cache->buckets   = ucc_malloc(cache->n_buckets * sizeof(ucc_list_link_t),
+                                  "coll_cache_buckets");
+    if (!cache->buckets) {
+        ucc_error("failed to allocate %zd bytes for coll cache buckets",
+                  cache->n_buckets * sizeof(ucc_list_link_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    cache->elems = ucc_calloc(capacity, sizeof(ucc_coll_cache_elem_t),
+                              "coll_cache_elems");
+    if (!cache->elems) {
+        ucc_error("failed to allocate %zd bytes for coll cache elems",
+                  capacity * sizeof(ucc_coll_cache_elem_t));
+        ucc_free(cache->buckets);
+        cache->buckets = NULL;
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < cache->n_buckets; i++) {
+        ucc_list_head_init(&cache->buckets[i]);
+    }
+    for (i = 0; i < capacity; i++) {
+        ucc_list_add_tail(&cache->free, &cache->elems[i].lru_elem);
+    }
+    cache->thread_safe = (tm == UCC_THREAD_MULTIPLE);
+    cache->capacity    = capacity;
+    ucc_spinlock_init(&cache->lock, 0);
+    return UCC_OK;
+}
+
+void ucc_coll_cache_cleanup(ucc_coll_cache_t *cache)
+{
+    ucc_coll_cache_elem_t *elem, *tmp;
+    ucc_status_t           status;
+
+    if (!ucc_coll_cache_enabled(cache)) {
+        return;
+    }
+    ucc_debug("coll cache %p: hits %lu misses %lu evictions %lu", cache,
+              cache->n_hits, cache->n_misses, cache->n_evictions);
+    ucc_list_for_each_safe(elem, tmp, &cache->lru, lru_elem) {
+        ucc_list_del(&elem->lru_elem);
+        elem->task->flags &= ~UCC_COLL_TASK_FLAG_CACHED;
+        status = ucc_collective_finalize_internal(elem->task);
+        if (ucc_unlikely(status != UCC_OK)) {
+            ucc_error("failed to finalize cached task %p: %s", elem->task,
+                      ucc_status_string(status));
+        }
+    }
+    ucc_spinlock_destroy(&cache->lock);
+    ucc_free(cache->elems);
+    ucc_free(cache->buckets);
+    cache->elems    = NULL;
+    cache->buckets  = NULL;
+    cache->capacity = 0;
+}
+
+int ucc_coll_cache_key_init(const ucc_coll_args_t *args,
+                            ucc_coll_cache_key_t *key)
+{
+    uint64_t flags = (args->mask & UCC_COLL_ARGS_FIELD_FLAGS) ? args->flags
+                                                              : 0;
+
+    if (!(args->coll_type & UCC_COLL_CACHE_TYPES) ||
+        (args->mask & ~UCC_COLL_CACHE_ARGS_MASK) ||
+        (flags & UCC_COLL_CACHE_NO_FLAGS)) {
+        return 0;
+    }
+
+    memset(key, 0, sizeof(*key));
+    key->coll_type = args->coll_type;
+    key->flags     = flags;
+    if (ucc_coll_args_is_rooted(args->coll_type)) {
+        key->root = args->root;
+    }
+    if (ucc_coll_args_is_reduction(args->coll_type)) {
+        key->op = args->op;
+    }
+    switch (args->coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+    case UCC_COLL_TYPE_FANIN:
+    case UCC_COLL_TYPE_FANOUT:
+        return 1;
+    case UCC_COLL_TYPE_BCAST:
+        break;
+    default:
+        key->dst_count = args->dst.info.count;
+        key->dst_dt    = args->dst.info.datatype;
+        key->dst_mt    = args->dst.info.mem_type;
+        if (UCC_IS_INPLACE(*args)) {
+            return 1;
+        }
+        break;
+    }
+    key->src_count = args->src.info.count;
+    key->src_dt    = args->src.info.datatype;
+    key->src_mt    = args->src.info.mem_type;
+    return 1;
+}
+
+ucc_coll_task_t *ucc_coll_cache_get(ucc_coll_cache_t *cache,
+                                    const ucc_coll_cache_key_t *key)
+{
+    uint64_t               hash = ucc_coll_cache_key_hash(key);
+    ucc_list_link_t       *bucket;
+    ucc_coll_cache_elem_t *elem;
+    ucc_coll_task_t       *task;
+
+    ucc_coll_cache_lock(cache);
+    bucket = &cache->buckets[hash & (cache->n_buckets - 1)];
+    ucc_list_for_each(elem, bucket, bucket_elem) {
+        if (elem->hash == hash && !memcmp(&elem->key, key, sizeof(*key))) {
+            ucc_list_del(&elem->bucket_elem);
+            ucc_list_del(&elem->lru_elem);
+            ucc_list_add_tail(&cache->free, &elem->lru_elem);
+            task = elem->task;
+            cache->n_hits++;
+            ucc_coll_cache_unlock(cache);
+            return task;
+        }
+    }
+    cache->n_misses++;
+    ucc_coll_cache_unlock(cache);
+    return NULL;
+}
+
+ucc_status_t ucc_coll_cache_put(ucc_coll_cache_t *cache,
+                                ucc_coll_task_t *task)
+{
+    ucc_coll_task_t       *evicted = NULL;
+    ucc_coll_cache_elem_t *elem;
+    ucc_coll_cache_key_t   key;
+    ucc_status_t           status;
+    uint64_t               hash;
+
+    if (!ucc_coll_cache_key_init(&task->bargs.args, &key)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    hash = ucc_coll_cache_key_hash(&key);
+
+    ucc_coll_cache_lock(cache);
+    if (!ucc_list_is_empty(&cache->free)) {
+        elem = ucc_list_extract_head(&cache->free, ucc_coll_cache_elem_t,
+                                     lru_elem);
+    } else {
+        elem = ucc_list_tail(&cache->lru, ucc_coll_cache_elem_t, lru_elem);
+        ucc_list_del(&elem->lru_elem);
+        ucc_list_del(&elem->bucket_elem);
+        evicted = elem->task;
+        cache->n_evictions++;
+    }
+    elem->hash = hash;
+    elem->key  = key;
+    elem->task = task;
+    ucc_list_insert_after(&cache->buckets[hash & (cache->n_buckets - 1)],
+                          &elem->bucket_elem);
+    ucc_list_insert_after(&cache->lru, &elem->lru_elem);
+    ucc_coll_cache_unlock(cache);
+
+    if (evicted) {
+        evicted->flags &= ~UCC_COLL_TASK_FLAG_CACHED;
+        status = ucc_collective_finalize_internal(evicted);
+        if (ucc_unlikely(status != UCC_OK)) {
+            ucc_error("failed to finalize evicted task %p: %s", evicted,
+                      ucc_status_string(status));
+        }
+    }
+    return UCC_OK;
+}
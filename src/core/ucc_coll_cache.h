@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_COLL_CACHE_H_
+#define UCC_COLL_CACHE_H_
+
+#include "ucc/api/ucc.h"
+#include "schedule/ucc_schedule.h"
+#include "utils/ucc_list.h"
+#include "utils/ucc_spinlock.h"
+
+/* Per team cache of completed non-persistent collective tasks.
+   Collective init with the same argument signature (everything except
+   buffer addresses and callback) takes the task from the cache and
+   rebinds it to the new buffers instead of doing algorithm selection,
+   task setup and executor init again.
+   Only top level tasks providing "rebind" method are cached. */
+
+typedef struct ucc_coll_cache_key {
+    uint64_t coll_type;
+    uint64_t flags;
+    uint64_t root;
+    uint64_t op;
+    uint64_t src_count;
+    uint64_t src_dt;
+    uint64_t src_mt;
+    uint64_t dst_count;
+    uint64_t dst_dt;
+    uint64_t dst_mt;
+} ucc_coll_cache_key_t;
+
+typedef struct ucc_coll_cache_elem {
+    ucc_list_link_t      bucket_elem;
+    ucc_list_link_t      lru_elem;
+    uint64_t             hash;
+    ucc_coll_cache_key_t key;
+    ucc_coll_task_t     *task;
+} ucc_coll_cache_elem_t;
+
+typedef struct ucc_coll_cache {
+    ucc_spinlock_t         lock;
+    int                    thread_safe;
+    uint32_t               capacity;
+    uint32_t               n_buckets;
+    ucc_list_link_t       *buckets;
+    /* cached tasks, most recently used first */
+    ucc_list_link_t        lru;
+    ucc_list_link_t        free;
+    ucc_coll_cache_elem_t *elems;
+    uint64_t               n_hits;
+    uint64_t               n_misses;
+    uint64_t               n_evictions;
+} ucc_coll_cache_t;
+
+/* Capacity 0 disables the cache */
+ucc_status_t ucc_coll_cache_init(ucc_coll_cache_t *cache, uint32_t capacity,
+                                 ucc_thread_mode_t tm);
+
+/* Finalizes all cached tasks and frees cache memory */
+void ucc_coll_cache_cleanup(ucc_coll_cache_t *cache);
+
+/* Returns 1 and fills the key if collective with given args can be cached.
+   Args mem types must be already resolved. */
+int ucc_coll_cache_key_init(const ucc_coll_args_t *args,
+                            ucc_coll_cache_key_t *key);
+
+/* Returns cached task matching the key or NULL. Returned task is removed
+   from the cache and has to be rebound to the new args by the caller. */
+ucc_coll_task_t *ucc_coll_cache_get(ucc_coll_cache_t *cache,
+                                    const ucc_coll_cache_key_t *key);
+
+/* Puts completed task into the cache evicting least recently used one
+   if the cache is full. Returns UCC_ERR_NOT_SUPPORTED if the task can not
+   be cached, caller has to finalize it then. */
+ucc_status_t ucc_coll_cache_put(ucc_coll_cache_t *cache,
+                                ucc_coll_task_t *task);
+
+static inline int ucc_coll_cache_enabled(const ucc_coll_cache_t *cache)
+{
+    return cache->capacity > 0;
+}
+
+#endif
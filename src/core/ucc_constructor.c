@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -13,6 +13,7 @@
 #include "utils/ucc_string.h"
 #include "utils/ucc_proc_info.h"
 #include "utils/profile/ucc_profile.h"
+#include "schedule/ucc_pipeline_model.h"
 #include "ucc/api/ucc_version.h"
 #include <dlfcn.h>
 #include <pthread.h>
@@ -174,6 +175,15 @@ ucc_status_t ucc_constructor(void)
         ucc_error("failed to initialize local proc info");
         goto exit_unlock_mutex;
     }
+    if (strlen(cfg->topo_file) > 0 &&
+        UCC_OK != ucc_proc_info_parse_topo_file(cfg->topo_file,
+                                                ucc_hostname(),
+                                                cfg->topo_file_level,
+                                                &ucc_local_proc.rack_id)) {
+        /* rack subgroups are not used if any host has no rack id */
+        ucc_warn("host %s has no rack id in topology file %s",
+                 ucc_hostname(), cfg->topo_file);
+    }
 #ifdef HAVE_PROFILING
     ucc_profile_init(cfg->profile_mode, cfg->profile_file,
                      cfg->profile_log_size);
@@ -202,6 +212,7 @@ __attribute__((destructor)) static void ucc_destructor(void)
 #ifdef HAVE_PROFILING
         ucc_profile_cleanup();
 #endif
+        ucc_pipeline_model_cleanup();
         ucc_config_parser_release_opts(&ucc_global_config,
                                        ucc_global_config_table);
         if (ucc_global_config.file_cfg) {
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -12,6 +12,7 @@
 #include "utils/ucc_log.h"
 #include "utils/ucc_list.h"
 #include "utils/ucc_string.h"
+#include "utils/ucc_atomic.h"
 #include "ucc_progress_queue.h"
 
 static uint32_t ucc_context_seq_num = 0;
@@ -23,10 +24,32 @@ static ucc_config_field_t ucc_context_config_table[] = {
      UCC_CONFIG_TYPE_UINT},
 
     {"LOCK_FREE_PROGRESS_Q", "0",
-     "Enable lock free progress queue optimization",
+     "Enable lock free progress queue optimization, same as "
+     "PROGRESS_Q=lock_free",
      ucc_offsetof(ucc_context_config_t, lock_free_progress_q),
      UCC_CONFIG_TYPE_UINT},
 
+    {"PROGRESS_Q", "locked",
+     "Progress queue used by contexts in UCC_THREAD_MULTIPLE mode.\n"
+     "locked        - single task queue protected by a spinlock\n"
+     "lock_free     - lock free task queue\n"
+     "work_stealing - per thread task deques, idle threads steal tasks "
+     "from busy ones",
+     ucc_offsetof(ucc_context_config_t, progress_q_type),
+     UCC_CONFIG_TYPE_ENUM(ucc_pq_type_names)},
+
+    {"PROGRESS_Q_BATCH", "8",
+     "Max number of tasks progressed by a single ucc_context_progress call "
+     "in UCC_THREAD_MULTIPLE mode",
+     ucc_offsetof(ucc_context_config_t, progress_q_batch),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"PROGRESS_Q_DEQUES", "16",
+     "Number of task deques of work stealing progress queue, threads beyond "
+     "that number share deques",
+     ucc_offsetof(ucc_context_config_t, progress_q_deques),
+     UCC_CONFIG_TYPE_UINT},
+
     {"ESTIMATED_NUM_PPN", "0",
      "An optimization hint of how many endpoints created on this context reside"
      " on the same node",
@@ -46,10 +69,21 @@ static ucc_config_field_t ucc_context_config_table[] = {
      ucc_offsetof(ucc_context_config_t, internal_oob), UCC_CONFIG_TYPE_UINT},
 
     {"THROTTLE_PROGRESS", "1000",
-     "Throttle UCC progress to every <n>th invocation",
+     "Max number of ucc_context_progress calls on idle context between "
+     "invocations of progress functions registered by components (e.g. UCP "
+     "worker progress). The interval grows exponentially while they make no "
+     "progress and drops to 0 once they do or collectives are posted. "
+     "0 - no throttling",
      ucc_offsetof(ucc_context_config_t, throttle_progress),
      UCC_CONFIG_TYPE_UINT},
 
+    {"COLL_INIT_CACHE_SIZE", "32",
+     "Max number of completed non-persistent collectives cached per team. "
+     "Collective init with the same arguments except buffer addresses "
+     "reuses the cached task. 0 - disable",
+     ucc_offsetof(ucc_context_config_t, coll_init_cache_size),
+     UCC_CONFIG_TYPE_UINT},
+
     {NULL}};
 UCC_CONFIG_REGISTER_TABLE(ucc_context_config_table, "UCC context", NULL,
                           ucc_context_config_t, &ucc_config_global_list);
@@ -607,6 +641,7 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
     ucc_tl_context_t          *tl_ctx;
     ucc_tl_lib_t              *tl_lib;
     ucc_context_t             *ctx;
+    ucc_pq_params_t            pq_params;
     ucc_status_t               status;
     uint64_t                   i, j, n_tl_ctx;
     int                        num_cls;
@@ -619,10 +654,11 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
         status = UCC_ERR_NO_MEMORY;
         goto error;
     }
-    ctx->throttle_progress = config->throttle_progress;
-    ctx->rank              = UCC_RANK_MAX;
-    ctx->lib               = lib;
-    ctx->ids.pool_size     = config->team_ids_pool_size;
+    ctx->throttle_progress    = config->throttle_progress;
+    ctx->coll_init_cache_size = config->coll_init_cache_size;
+    ctx->rank                 = UCC_RANK_MAX;
+    ctx->lib                  = lib;
+    ctx->ids.pool_size        = config->team_ids_pool_size;
     ucc_list_head_init(&ctx->progress_list);
     ucc_copy_context_params(&ctx->params, params);
     ucc_copy_context_params(&b_params.params, params);
@@ -707,8 +743,11 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
                         (params->mask & UCC_CONTEXT_PARAM_FIELD_TYPE))
                            ? UCC_THREAD_SINGLE
                            : lib->attr.thread_mode;
-    status           = ucc_progress_queue_init(&ctx->pq, ctx->thread_mode,
-                                               config->lock_free_progress_q);
+    pq_params.type     = config->lock_free_progress_q ?
+                         UCC_PQ_TYPE_LOCK_FREE : config->progress_q_type;
+    pq_params.batch    = config->progress_q_batch;
+    pq_params.n_deques = config->progress_q_deques;
+    status = ucc_progress_queue_init(&ctx->pq, ctx->thread_mode, &pq_params);
     if (UCC_OK != status) {
         ucc_error("failed to init progress queue for context %p", ctx);
         goto error_ctx_create;
@@ -877,13 +916,18 @@ static ucc_status_t ucc_context_free_attr(ucc_context_attr_t *context_attr)
 
 ucc_status_t ucc_context_destroy(ucc_context_t *context)
 {
-    ucc_cl_context_t *cl_ctx;
-    ucc_cl_lib_t     *cl_lib;
-    ucc_tl_context_t *tl_ctx;
-    ucc_tl_lib_t     *tl_lib;
-    int               i;
-    ucc_status_t      status;
+    ucc_context_progress_stats_t *stats = &context->progress_sched.stats;
+    ucc_cl_context_t             *cl_ctx;
+    ucc_cl_lib_t                 *cl_lib;
+    ucc_tl_context_t             *tl_ctx;
+    ucc_tl_lib_t                 *tl_lib;
+    int                           i;
+    ucc_status_t                  status;
 
+    ucc_debug("context %p progress: busy calls %lu tasks completed %lu "
+              "idle polls %lu empty polls %lu throttled %lu", context,
+              stats->n_busy_calls, stats->n_tasks_completed,
+              stats->n_idle_polls, stats->n_empty_polls, stats->n_throttled);
     if (UCC_OK != ucc_context_free_attr(&context->attr)) {
         ucc_error("failed to free context attributes");
     }
@@ -975,32 +1019,78 @@ ucc_status_t ucc_context_progress_deregister(ucc_context_t *ctx,
     return UCC_ERR_NOT_FOUND;
 }
 
-ucc_status_t ucc_context_progress(ucc_context_h context)
+void ucc_context_get_progress_stats(ucc_context_t *ctx,
+                                    ucc_context_progress_stats_t *stats)
 {
-    static int                    call_num = 0;
-    ucc_status_t                  status;
-    ucc_context_progress_entry_t *entry;
-    int                           is_empty;
+    *stats = ctx->progress_sched.stats;
+}
 
-    is_empty = ucc_progress_queue_is_empty(context->pq);
-    if (ucc_likely(is_empty)) {
-        call_num--;
-        if (ucc_likely(call_num >= 0)) {
-            return UCC_OK;
-        }
-        /* progress registered progress fns */
-        ucc_list_for_each(entry, &context->progress_list, list_elem) {
-            entry->fn(entry->arg);
+/* Several threads may progress the context in THREAD_MULTIPLE mode: the
+   countdown is decremented with CAS so it never goes below 0 */
+static inline int
+ucc_context_progress_throttled(ucc_context_progress_sched_t *sched)
+{
+    uint32_t countdown;
+
+    do {
+        countdown = sched->countdown;
+        if (countdown == 0) {
+            return 0;
         }
-        call_num = context->throttle_progress;
+    } while (!ucc_atomic_bool_cswap32(&sched->countdown, countdown,
+                                      countdown - 1));
+    return 1;
+}
+
+static inline void ucc_context_progress_idle(ucc_context_t *context)
+{
+    ucc_context_progress_sched_t *sched  = &context->progress_sched;
+    unsigned                      events = 0;
+    ucc_context_progress_entry_t *entry;
+
+    if (ucc_context_progress_throttled(sched)) {
+        sched->stats.n_throttled++;
+        return;
+    }
+    /* progress registered progress fns */
+    ucc_list_for_each(entry, &context->progress_list, list_elem) {
+        events += entry->fn(entry->arg);
+    }
+    sched->stats.n_idle_polls++;
+    if (events) {
+        sched->interval = 0;
+    } else {
+        sched->stats.n_empty_polls++;
+        sched->interval = ucc_min(ucc_max(sched->interval * 2, 1),
+                                  context->throttle_progress);
+    }
+    sched->countdown = sched->interval;
+}
+
+ucc_status_t ucc_context_progress(ucc_context_h context)
+{
+    ucc_context_progress_sched_t *sched = &context->progress_sched;
+    int                           n_completed;
+
+    if (ucc_likely(ucc_progress_queue_is_empty(context->pq))) {
+        ucc_context_progress_idle(context);
         return UCC_OK;
     }
+    /* registered fns are polled on the first idle call after the queue
+       drains, completions of new tasks may still be in flight */
+    sched->interval  = 0;
+    sched->countdown = 0;
 
     /* the fn below returns int - number of completed tasks.
        TODO : do we need to handle it ? Maybe return to user
        as int as well? */
-    status = (ucc_status_t)ucc_progress_queue(context->pq);
-    return (status >= 0 ? UCC_OK : status);
+    n_completed = ucc_progress_queue(context->pq);
+    if (ucc_unlikely(n_completed < 0)) {
+        return (ucc_status_t)n_completed;
+    }
+    sched->stats.n_busy_calls++;
+    sched->stats.n_tasks_completed += n_completed;
+    return UCC_OK;
 }
 
 static ucc_status_t ucc_context_pack_addr(ucc_context_t             *context,
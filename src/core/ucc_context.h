@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -49,6 +49,28 @@ typedef struct ucc_addr_storage {
     uint64_t   flags;
 } ucc_addr_storage_t;
 
+typedef struct ucc_context_progress_stats {
+    /* ucc_context_progress calls made with non empty progress queue */
+    uint64_t n_busy_calls;
+    /* tasks completed by those calls */
+    uint64_t n_tasks_completed;
+    /* idle calls that invoked registered progress fns */
+    uint64_t n_idle_polls;
+    /* idle polls where registered progress fns reported no events */
+    uint64_t n_empty_polls;
+    /* idle calls skipped by throttling */
+    uint64_t n_throttled;
+} ucc_context_progress_stats_t;
+
+/* Throttling of registered progress fns on idle context: interval between
+   invocations doubles on every empty poll up to throttle_progress and drops
+   to 0 once they report events or tasks show up in the progress queue */
+typedef struct ucc_context_progress_sched {
+    uint32_t                     interval;
+    volatile uint32_t            countdown;
+    ucc_context_progress_stats_t stats;
+} ucc_context_progress_sched_t;
+
 typedef struct ucc_context {
     ucc_lib_info_t          *lib;
     ucc_context_params_t     params;
@@ -77,7 +99,9 @@ typedef struct ucc_context {
     ucc_context_topo_t      *topo;
     uint64_t                 cl_flags;
     ucc_tl_team_t           *service_team;
-    int32_t                  throttle_progress;
+    uint32_t                 throttle_progress;
+    ucc_context_progress_sched_t progress_sched;
+    uint32_t                 coll_init_cache_size;
 } ucc_context_t;
 
 typedef struct ucc_context_config {
@@ -90,8 +114,12 @@ typedef struct ucc_context_config {
     uint32_t                  estimated_num_eps;
     uint32_t                  estimated_num_ppn;
     uint32_t                  lock_free_progress_q;
+    ucc_pq_type_t             progress_q_type;
+    uint32_t                  progress_q_batch;
+    uint32_t                  progress_q_deques;
     uint32_t                  internal_oob;
     uint32_t                  throttle_progress;
+    uint32_t                  coll_init_cache_size;
 } ucc_context_config_t;
 
 /* Internal function for context creation that takes explicit
@@ -116,6 +144,11 @@ ucc_status_t ucc_context_progress_register(ucc_context_t *ctx,
 ucc_status_t ucc_context_progress_deregister(ucc_context_t *ctx,
                                              ucc_context_progress_fn_t fn,
                                              void *progress_arg);
+
+/* Returns progress counters of the context. Counters are updated without
+   synchronization and are approximate in UCC_THREAD_MULTIPLE mode. */
+void ucc_context_get_progress_stats(ucc_context_t *ctx,
+                                    ucc_context_progress_stats_t *stats);
 /* Performs address exchange between the processes group defined by OOB.
    This function can be used either at context creation time
    (if ctx is global) or at team creation time.
@@ -25,7 +25,11 @@ size_t ucc_dt_predefined_sizes[UCC_DT_PREDEFINED_LAST] = {
     [UCC_DT_PREDEFINED_ID(UCC_DT_UINT128)]          = 16,
     [UCC_DT_PREDEFINED_ID(UCC_DT_FLOAT32_COMPLEX)]  = 8,
     [UCC_DT_PREDEFINED_ID(UCC_DT_FLOAT64_COMPLEX)]  = 16,
-    [UCC_DT_PREDEFINED_ID(UCC_DT_FLOAT128_COMPLEX)] = 32};
+    [UCC_DT_PREDEFINED_ID(UCC_DT_FLOAT128_COMPLEX)] = 32,
+    [UCC_DT_PREDEFINED_ID(UCC_DT_FLOAT32_INT32)]    = 8,
+    [UCC_DT_PREDEFINED_ID(UCC_DT_FLOAT64_INT32)]    = 16,
+    [UCC_DT_PREDEFINED_ID(UCC_DT_INT32_INT32)]      = 8,
+    [UCC_DT_PREDEFINED_ID(UCC_DT_INT64_INT32)]      = 16};
 
 ucc_status_t ucc_dt_create_generic(const ucc_generic_dt_ops_t *ops, void *context,
                                    ucc_datatype_t *datatype_p)
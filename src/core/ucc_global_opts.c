@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -20,7 +20,16 @@ ucc_global_config_t ucc_global_config = {
     .profile_mode     = 0,
     .profile_file     = "",
     .profile_log_size = 0,
-    .file_cfg         = 0};
+    .file_cfg         = 0,
+    .memtype_cache    = UCC_CONFIG_AUTO,
+    .pipeline_model   = 0};
+
+const char *ucc_topo_file_level_names[] = {
+    [UCC_TOPO_FILE_LEVEL_SWITCH] = "switch",
+    [UCC_TOPO_FILE_LEVEL_RACK]   = "rack",
+    [UCC_TOPO_FILE_LEVEL_POD]    = "pod",
+    [UCC_TOPO_FILE_LEVEL_LAST]   = NULL
+};
 
 ucc_config_field_t ucc_global_config_table[] = {
     {"LOG_LEVEL", "warn",
@@ -65,4 +74,44 @@ ucc_config_field_t ucc_global_config_table[] = {
      "empty string \"\" - disable use of config file",
      ucc_offsetof(ucc_global_config_t, cfg_filename), UCC_CONFIG_TYPE_STRING},
 
+    {"MEMTYPE_CACHE", "auto",
+     "Cache memory type and allocation range of user buffers whose memory "
+     "type is detected by UCC. Cached entries are invalidated on memory "
+     "unmap and free events.\n"
+     "auto - enabled if any non host memory component is available",
+     ucc_offsetof(ucc_global_config_t, memtype_cache),
+     UCC_CONFIG_TYPE_ON_OFF_AUTO},
+
+    {"PIPELINE_MODEL", "n",
+     "Select fragment size and pipeline depth of pipelined algorithms with "
+     "\"auto\" pipeline settings from a latency/bandwidth model calibrated "
+     "online from measured fragment completion times. Pipelines with static "
+     "settings feed the model too, so sweeping them calibrates it. Ranks of "
+     "a team use the model of rank 0 taken at team creation time, it "
+     "requires a service team.",
+     ucc_offsetof(ucc_global_config_t, pipeline_model),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"PIPELINE_MODEL_FILE", "",
+     "File the pipeline model measurements are loaded from and stored to at "
+     "exit, so that the model persists across runs.\n"
+     "empty string \"\" - model is not persisted",
+     ucc_offsetof(ucc_global_config_t, pipeline_model_file),
+     UCC_CONFIG_TYPE_STRING},
+
+    {"TOPO_FILE", "",
+     "Topology file mapping hostnames to the network switch, rack and pod "
+     "they are attached to. Each line is \"<hostname> <switch> [<rack> "
+     "[<pod>]]\", ids are arbitrary tokens. Hosts with the same id form a "
+     "rack subgroup used by hierarchical algorithms to aggregate inter-rack "
+     "traffic.\n"
+     "empty string \"\" - rack topology is not used",
+     ucc_offsetof(ucc_global_config_t, topo_file), UCC_CONFIG_TYPE_STRING},
+
+    {"TOPO_FILE_LEVEL", "switch",
+     "Column of UCC_TOPO_FILE defining the rack subgroups: switch, rack "
+     "or pod",
+     ucc_offsetof(ucc_global_config_t, topo_file_level),
+     UCC_CONFIG_TYPE_ENUM(ucc_topo_file_level_names)},
+
     {NULL}};
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -12,6 +12,7 @@
 
 #include "utils/ucc_parser.h"
 #include "utils/ucc_log.h"
+#include "utils/ucc_proc_info.h"
 
 typedef struct ucc_global_config {
     /* Log level above which log messages will be printed*/
@@ -37,10 +38,23 @@ typedef struct ucc_global_config {
     size_t                     profile_log_size;
     char                      *cfg_filename;
     ucc_file_config_t         *file_cfg;
+
+    /* Cache memory type of queried buffers */
+    ucc_on_off_auto_value_t    memtype_cache;
+
+    /* Select "auto" pipeline params with the online pipeline model */
+    int                        pipeline_model;
+    /* File to persist the pipeline model measurements */
+    char                      *pipeline_model_file;
+
+    /* Topology file mapping hosts to switch/rack/pod ids */
+    char                      *topo_file;
+    ucc_topo_file_level_t      topo_file_level;
 } ucc_global_config_t;
 
 extern ucc_global_config_t ucc_global_config;
 extern ucc_config_field_t  ucc_global_config_table[];
+extern const char         *ucc_topo_file_level_names[];
 
 ucc_status_t ucc_constructor(void);
 extern ucs_list_link_t ucc_config_global_list;
@@ -5,18 +5,43 @@
 
 #include "config.h"
 #include "ucc_progress_queue.h"
+#include <string.h>
+
+const char *ucc_pq_type_names[] = {
+    [UCC_PQ_TYPE_LOCKED]        = "locked",
+    [UCC_PQ_TYPE_LOCK_FREE]     = "lock_free",
+    [UCC_PQ_TYPE_WORK_STEALING] = "work_stealing",
+    [UCC_PQ_TYPE_LAST]          = NULL
+};
 
 ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq);
-ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq, uint32_t lock_free_progress_q);
+ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq,
+                            uint32_t lock_free_progress_q, uint32_t batch);
+ucc_status_t ucc_pq_ws_init(ucc_progress_queue_t **pq, uint32_t batch,
+                            uint32_t n_deques);
 
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
                                      ucc_thread_mode_t      tm,
-                                     uint32_t lock_free_progress_q)
+                                     const ucc_pq_params_t *params)
 {
     if (tm == UCC_THREAD_SINGLE) {
         return ucc_pq_st_init(pq);
     } else { // TODO also for UCC_THREAD_FUNNELED?
-        return ucc_pq_mt_init(pq, lock_free_progress_q);
+        if (params->type == UCC_PQ_TYPE_WORK_STEALING) {
+            return ucc_pq_ws_init(pq, params->batch, params->n_deques);
+        }
+        return ucc_pq_mt_init(pq, params->type == UCC_PQ_TYPE_LOCK_FREE,
+                              params->batch);
+    }
+}
+
+void ucc_progress_queue_get_stats(ucc_progress_queue_t *pq,
+                                  ucc_pq_stats_t *stats)
+{
+    if (pq->get_stats) {
+        pq->get_stats(pq, stats);
+    } else {
+        memset(stats, 0, sizeof(*stats));
     }
 }
 
@@ -10,18 +10,49 @@
 #include "ucc/api/ucc.h"
 #include "schedule/ucc_schedule.h"
 
+/* Progress queue implementations used in UCC_THREAD_MULTIPLE mode */
+typedef enum ucc_pq_type {
+    /* single task list protected by a spinlock */
+    UCC_PQ_TYPE_LOCKED,
+    /* ucc_lf_queue based */
+    UCC_PQ_TYPE_LOCK_FREE,
+    /* per thread task deques with work stealing, several tasks are
+       progressed per call */
+    UCC_PQ_TYPE_WORK_STEALING,
+    UCC_PQ_TYPE_LAST
+} ucc_pq_type_t;
+
+extern const char *ucc_pq_type_names[];
+
+typedef struct ucc_pq_params {
+    ucc_pq_type_t type;
+    /* max number of tasks progressed by a single call, multithreaded
+       queues only */
+    uint32_t      batch;
+    /* number of task deques, work stealing only */
+    uint32_t      n_deques;
+} ucc_pq_params_t;
+
+typedef struct ucc_pq_stats {
+    /* number of tasks taken from the deque of another thread */
+    uint64_t n_steals;
+    /* number of tasks put back to the queue after being progressed */
+    uint64_t n_reenqueues;
+} ucc_pq_stats_t;
+
 typedef struct ucc_progress_queue ucc_progress_queue_t;
 struct ucc_progress_queue {
     void (*enqueue)(ucc_progress_queue_t *pq, ucc_coll_task_t *task);
     void (*dequeue)(ucc_progress_queue_t *pq, ucc_coll_task_t **task);
     int  (*progress)(ucc_progress_queue_t *pq);
     int  (*is_empty)(ucc_progress_queue_t *pq);
+    void (*get_stats)(ucc_progress_queue_t *pq, ucc_pq_stats_t *stats);
     void (*finalize)(ucc_progress_queue_t *pq);
 };
 
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
                                      ucc_thread_mode_t tm,
-                                     uint32_t lock_free_progress_q);
+                                     const ucc_pq_params_t *params);
 
 static inline void ucc_progress_enqueue(ucc_progress_queue_t *pq,
                                         ucc_coll_task_t *task)
@@ -53,6 +84,11 @@ static inline int ucc_progress_queue_is_empty(ucc_progress_queue_t *pq)
     return pq->is_empty(pq);
 }
 
+/* Counters are only maintained by the work stealing queue, other
+   implementations report zeros */
+void ucc_progress_queue_get_stats(ucc_progress_queue_t *pq,
+                                  ucc_pq_stats_t *stats);
+
 void ucc_progress_queue_finalize(ucc_progress_queue_t *pq);
 
 #endif
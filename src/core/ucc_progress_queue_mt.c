@@ -16,11 +16,13 @@
 
 typedef struct ucc_pq_mt {
     ucc_progress_queue_t super;
+    uint32_t             batch;
     ucc_lf_queue_t       lf_queue;
 } ucc_pq_mt_t;
 
 typedef struct ucc_pq_mt_locked {
     ucc_progress_queue_t super;
+    uint32_t             batch;
     ucc_spinlock_t       queue_lock;
     ucc_list_link_t      queue;
 } ucc_pq_mt_locked_t;
@@ -65,15 +67,26 @@ static void ucc_pq_mt_dequeue(ucc_progress_queue_t *pq,
         elem ? ucc_container_of(elem, ucc_coll_task_t, lf_elem) : NULL;
 }
 
-static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
+/* Progresses up to batch tasks. Stops early when the queue is empty or the
+   first task put back by this call comes around again. */
+static int ucc_pq_mt_progress_batch(ucc_progress_queue_t *pq, uint32_t batch)
 {
     int              n_progressed =  0;
     double           timestamp    = -1;
+    ucc_coll_task_t *requeued     = NULL;
     ucc_coll_task_t *task;
     ucc_status_t     status;
+    uint32_t         i;
 
-    pq->dequeue(pq, &task);
-    if (task) {
+    for (i = 0; i < batch; i++) {
+        pq->dequeue(pq, &task);
+        if (!task) {
+            break;
+        }
+        if (task == requeued) {
+            pq->enqueue(pq, task);
+            break;
+        }
         if (task->progress) {
             task->progress(task);
         }
@@ -91,7 +104,10 @@ static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
             }
 
             pq->enqueue(pq, task);
-            return n_progressed;
+            if (!requeued) {
+                requeued = task;
+            }
+            continue;
         }
         n_progressed++;
         if (ucc_unlikely(0 > (status = ucc_task_complete(task)))) {
@@ -101,6 +117,20 @@ static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
     return n_progressed;
 }
 
+static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
+{
+    ucc_pq_mt_t *pq_mt = ucc_derived_of(pq, ucc_pq_mt_t);
+
+    return ucc_pq_mt_progress_batch(pq, pq_mt->batch);
+}
+
+static int ucc_pq_locked_mt_progress(ucc_progress_queue_t *pq)
+{
+    ucc_pq_mt_locked_t *pq_mt = ucc_derived_of(pq, ucc_pq_mt_locked_t);
+
+    return ucc_pq_mt_progress_batch(pq, pq_mt->batch);
+}
+
 static int ucc_pq_locked_mt_is_empty(ucc_progress_queue_t *pq)
 {
     ucc_pq_mt_locked_t *pq_mt = ucc_derived_of(pq, ucc_pq_mt_locked_t);
@@ -130,7 +160,7 @@ static void ucc_pq_mt_finalize(ucc_progress_queue_t *pq)
 }
 
 ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq,
-                            uint32_t lock_free_progress_q)
+                            uint32_t lock_free_progress_q, uint32_t batch)
 {
     if (lock_free_progress_q) {
         ucc_pq_mt_t *pq_mt = ucc_malloc(sizeof(*pq_mt), "pq_mt");
@@ -139,11 +169,13 @@ ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq,
             return UCC_ERR_NO_MEMORY;
         }
         ucc_lf_queue_init(&pq_mt->lf_queue);
+        pq_mt->batch            = ucc_max(batch, 1);
         pq_mt->super.enqueue    = ucc_pq_mt_enqueue;
         pq_mt->super.dequeue    = ucc_pq_mt_dequeue;
         pq_mt->super.progress   = ucc_pq_mt_progress;
         pq_mt->super.finalize   = ucc_pq_mt_finalize;
         pq_mt->super.is_empty   = ucc_pq_mt_is_empty;
+        pq_mt->super.get_stats  = NULL;
         *pq                     = &pq_mt->super;
     } else {
         ucc_pq_mt_locked_t *pq_mt = ucc_malloc(sizeof(*pq_mt), "pq_mt");
@@ -153,12 +185,14 @@ ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq,
         }
         ucc_spinlock_init(&pq_mt->queue_lock, 0);
         ucc_list_head_init(&pq_mt->queue);
-        pq_mt->super.enqueue  = ucc_pq_locked_mt_enqueue;
-        pq_mt->super.dequeue  = ucc_pq_locked_mt_dequeue;
-        pq_mt->super.progress = ucc_pq_mt_progress;
-        pq_mt->super.finalize = ucc_pq_locked_mt_finalize;
-        pq_mt->super.is_empty = ucc_pq_locked_mt_is_empty;
-        *pq                   = &pq_mt->super;
+        pq_mt->batch           = ucc_max(batch, 1);
+        pq_mt->super.enqueue   = ucc_pq_locked_mt_enqueue;
+        pq_mt->super.dequeue   = ucc_pq_locked_mt_dequeue;
+        pq_mt->super.progress  = ucc_pq_locked_mt_progress;
+        pq_mt->super.finalize  = ucc_pq_locked_mt_finalize;
+        pq_mt->super.is_empty  = ucc_pq_locked_mt_is_empty;
+        pq_mt->super.get_stats = NULL;
+        *pq                    = &pq_mt->super;
     }
     return UCC_OK;
 }
@@ -83,12 +83,13 @@ ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq)
         return UCC_ERR_NO_MEMORY;
     }
     ucc_list_head_init(&pq_st->list);
-    pq_st->super.enqueue  = ucc_pq_st_enqueue;
-    pq_st->super.dequeue  = NULL;
-    pq_st->super.progress = ucc_pq_st_progress;
-    pq_st->super.finalize = ucc_pq_st_finalize;
-    pq_st->super.is_empty = ucc_pq_st_is_empty;
+    pq_st->super.enqueue   = ucc_pq_st_enqueue;
+    pq_st->super.dequeue   = NULL;
+    pq_st->super.progress  = ucc_pq_st_progress;
+    pq_st->super.finalize  = ucc_pq_st_finalize;
+    pq_st->super.is_empty  = ucc_pq_st_is_empty;
+    pq_st->super.get_stats = NULL;
 
-    *pq                   = &pq_st->super;
+    *pq                    = &pq_st->super;
     return UCC_OK;
 }
@@ -0,0 +1,262 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "ucc_progress_queue.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_log.h"
+#include "utils/ucc_time.h"
+#include "utils/ucc_spinlock.h"
+#include "utils/ucc_list.h"
+#include "utils/ucc_atomic.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Upper limit for the number of tasks progressed by a single call */
+#define UCC_PQ_WS_MAX_BATCH 64
+
+/* Task deque of a group of threads. The owners take tasks from the head and
+   put in-progress tasks back to the tail, idle threads steal from the tail
+   of other deques. */
+typedef struct ucc_pq_ws_deque {
+    ucc_spinlock_t  lock;
+    ucc_list_link_t queue;
+    uint64_t        n_steals;
+    uint64_t        n_reenqueues;
+    /* keeps deques of different threads on different cache lines */
+    char            pad[UCC_CACHE_LINE_SIZE];
+} ucc_pq_ws_deque_t;
+
+typedef struct ucc_pq_ws {
+    ucc_progress_queue_t super;
+    uint32_t             batch;
+    uint32_t             n_deques;
+    /* number of tasks in the queue including the ones being progressed,
+       not exact, used for progress throttling only */
+    uint32_t             n_tasks;
+    ucc_pq_ws_deque_t   *deques;
+} ucc_pq_ws_t;
+
+static uint32_t          ucc_pq_ws_n_threads = 0;
+static __thread uint32_t ucc_pq_ws_thread_id = UINT32_MAX;
+
+static inline ucc_pq_ws_deque_t *ucc_pq_ws_thread_deque(ucc_pq_ws_t *pq_ws,
+                                                        uint32_t    *idx)
+{
+    if (ucc_unlikely(ucc_pq_ws_thread_id == UINT32_MAX)) {
+        ucc_pq_ws_thread_id = ucc_atomic_fadd32(&ucc_pq_ws_n_threads, 1);
+    }
+    *idx = ucc_pq_ws_thread_id % pq_ws->n_deques;
+    return &pq_ws->deques[*idx];
+}
+
+static void ucc_pq_ws_enqueue(ucc_progress_queue_t *pq, ucc_coll_task_t *task)
+{
+    ucc_pq_ws_t       *pq_ws = ucc_derived_of(pq, ucc_pq_ws_t);
+    ucc_pq_ws_deque_t *dq;
+    uint32_t           idx;
+
+    dq = ucc_pq_ws_thread_deque(pq_ws, &idx);
+    ucc_atomic_add32(&pq_ws->n_tasks, 1);
+    ucc_spin_lock(&dq->lock);
+    ucc_list_add_tail(&dq->queue, &task->list_elem);
+    ucc_spin_unlock(&dq->lock);
+}
+
+static void ucc_pq_ws_dequeue(ucc_progress_queue_t *pq,
+                              ucc_coll_task_t **popped_task)
+{
+    ucc_pq_ws_t       *pq_ws = ucc_derived_of(pq, ucc_pq_ws_t);
+    ucc_pq_ws_deque_t *dq;
+    uint32_t           idx;
+
+    dq           = ucc_pq_ws_thread_deque(pq_ws, &idx);
+    *popped_task = NULL;
+    ucc_spin_lock(&dq->lock);
+    if (!ucc_list_is_empty(&dq->queue)) {
+        *popped_task =
+            ucc_list_extract_head(&dq->queue, ucc_coll_task_t, list_elem);
+    }
+    ucc_spin_unlock(&dq->lock);
+    if (*popped_task) {
+        ucc_atomic_sub32(&pq_ws->n_tasks, 1);
+    }
+}
+
+/* Takes up to n_max tasks from the tail of other threads deques. Busy
+   deques are skipped rather than waited for. */
+static int ucc_pq_ws_steal(ucc_pq_ws_t *pq_ws, uint32_t self,
+                           ucc_coll_task_t **tasks, int n_max)
+{
+    int                n = 0;
+    ucc_pq_ws_deque_t *victim;
+    uint32_t           i;
+
+    for (i = 1; i < pq_ws->n_deques && n == 0; i++) {
+        victim = &pq_ws->deques[(self + i) % pq_ws->n_deques];
+        if (ucc_list_is_empty(&victim->queue) ||
+            !ucc_spin_try_lock(&victim->lock)) {
+            continue;
+        }
+        while ((n < n_max) && !ucc_list_is_empty(&victim->queue)) {
+            tasks[n] = ucc_list_tail(&victim->queue, ucc_coll_task_t,
+                                     list_elem);
+            ucc_list_del(&tasks[n]->list_elem);
+            n++;
+        }
+        victim->n_steals += n;
+        ucc_spin_unlock(&victim->lock);
+    }
+    return n;
+}
+
+static int ucc_pq_ws_progress(ucc_progress_queue_t *pq)
+{
+    ucc_pq_ws_t       *pq_ws        = ucc_derived_of(pq, ucc_pq_ws_t);
+    int                n_progressed = 0;
+    int                n_inprogress = 0;
+    int                n            = 0;
+    int                rc           = 0;
+    double             timestamp    = -1;
+    ucc_coll_task_t   *tasks[UCC_PQ_WS_MAX_BATCH];
+    ucc_coll_task_t   *task;
+    ucc_pq_ws_deque_t *dq;
+    ucc_status_t       status;
+    uint32_t           self;
+    int                i;
+
+    dq = ucc_pq_ws_thread_deque(pq_ws, &self);
+    if (!ucc_list_is_empty(&dq->queue)) {
+        ucc_spin_lock(&dq->lock);
+        while ((n < pq_ws->batch) && !ucc_list_is_empty(&dq->queue)) {
+            tasks[n++] = ucc_list_extract_head(&dq->queue, ucc_coll_task_t,
+                                               list_elem);
+        }
+        ucc_spin_unlock(&dq->lock);
+    }
+    if (n == 0) {
+        /* steal half of the batch so that the victim keeps some work */
+        n = ucc_pq_ws_steal(pq_ws, self, tasks,
+                            ucc_max(pq_ws->batch / 2, 1));
+        if (n == 0) {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        task = tasks[i];
+        if (task->progress) {
+            task->progress(task);
+        }
+        if (UCC_INPROGRESS == task->status) {
+            if (UCC_COLL_TIMEOUT_REQUIRED(task)) {
+                if (timestamp < 0) {
+                    timestamp = ucc_get_time();
+                }
+                if (ucc_unlikely(timestamp - task->start_time >
+                                 task->bargs.args.timeout)) {
+                    task->status = UCC_ERR_TIMED_OUT;
+                    ucc_atomic_sub32(&pq_ws->n_tasks, 1);
+                    ucc_task_complete(task);
+                    rc = UCC_ERR_TIMED_OUT;
+                    continue;
+                }
+            }
+            tasks[n_inprogress++] = task;
+            continue;
+        }
+        n_progressed++;
+        ucc_atomic_sub32(&pq_ws->n_tasks, 1);
+        status = ucc_task_complete(task);
+        if (ucc_unlikely(status < 0) && (rc == 0)) {
+            rc = status;
+        }
+    }
+
+    if (n_inprogress > 0) {
+        ucc_spin_lock(&dq->lock);
+        for (i = 0; i < n_inprogress; i++) {
+            ucc_list_add_tail(&dq->queue, &tasks[i]->list_elem);
+        }
+        dq->n_reenqueues += n_inprogress;
+        ucc_spin_unlock(&dq->lock);
+    }
+    return (rc < 0) ? rc : n_progressed;
+}
+
+static int ucc_pq_ws_is_empty(ucc_progress_queue_t *pq)
+{
+    ucc_pq_ws_t *pq_ws = ucc_derived_of(pq, ucc_pq_ws_t);
+
+    /* this function should not be very accurate for the purpose of progress throttling */
+    return pq_ws->n_tasks == 0;
+}
+
+static void ucc_pq_ws_get_stats(ucc_progress_queue_t *pq,
+                                ucc_pq_stats_t *stats)
+{
+    ucc_pq_ws_t *pq_ws = ucc_derived_of(pq, ucc_pq_ws_t);
+    uint32_t     i;
+
+    stats->n_steals     = 0;
+    stats->n_reenqueues = 0;
+    for (i = 0; i < pq_ws->n_deques; i++) {
+        stats->n_steals     += pq_ws->deques[i].n_steals;
+        stats->n_reenqueues += pq_ws->deques[i].n_reenqueues;
+    }
+}
+
+static void ucc_pq_ws_finalize(ucc_progress_queue_t *pq)
+{
+    ucc_pq_ws_t    *pq_ws = ucc_derived_of(pq, ucc_pq_ws_t);
+    ucc_pq_stats_t  stats;
+    uint32_t        i;
+
+    ucc_pq_ws_get_stats(pq, &stats);
+    ucc_debug("work stealing pq %p: steals %lu, reenqueues %lu", pq,
+              stats.n_steals, stats.n_reenqueues);
+    for (i = 0; i < pq_ws->n_deques; i++) {
+        ucc_spinlock_destroy(&pq_ws->deques[i].lock);
+    }
+    ucc_free(pq_ws->deques);
+    ucc_free(pq_ws);
+}
+
+ucc_status_t ucc_pq_ws_init(ucc_progress_queue_t **pq, uint32_t batch,
+                            uint32_t n_deques)
+{
+    ucc_pq_ws_t *pq_ws;
+    uint32_t     i;
+
+    pq_ws = ucc_malloc(sizeof(*pq_ws), "pq_ws");
+    if (!pq_ws) {
+        ucc_error("failed to allocate %zd bytes for pq_ws", sizeof(*pq_ws));
+        return UCC_ERR_NO_MEMORY;
+    }
+    pq_ws->n_deques = ucc_max(n_deques, 1);
+    pq_ws->batch    = ucc_min(ucc_max(batch, 1), UCC_PQ_WS_MAX_BATCH);
+    pq_ws->n_tasks  = 0;
+    pq_ws->deques   = ucc_calloc(pq_ws->n_deques, sizeof(*pq_ws->deques),
+                                 "pq_ws_deques");
+    if (!pq_ws->deques) {
+        ucc_error("failed to allocate %zd bytes for pq_ws deques",
+                  pq_ws->n_deques * sizeof(*pq_ws->deques));
+        ucc_free(pq_ws);
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < pq_ws->n_deques; i++) {
+        ucc_spinlock_init(&pq_ws->deques[i].lock, 0);
+        ucc_list_head_init(&pq_ws->deques[i].queue);
+    }
+    pq_ws->super.enqueue   = ucc_pq_ws_enqueue;
+    pq_ws->super.dequeue   = ucc_pq_ws_dequeue;
+    pq_ws->super.progress  = ucc_pq_ws_progress;
+    pq_ws->super.finalize  = ucc_pq_ws_finalize;
+    pq_ws->super.is_empty  = ucc_pq_ws_is_empty;
+    pq_ws->super.get_stats = ucc_pq_ws_get_stats;
+    *pq                    = &pq_ws->super;
+    return UCC_OK;
+}
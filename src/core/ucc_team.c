@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * Copyright (c) Meta Platforms, Inc. and affiliates. 2022.
  *
  * See file LICENSE for terms.
@@ -13,6 +13,7 @@
 #include "ucc_service_coll.h"
 
 static ucc_status_t ucc_team_alloc_id(ucc_team_t *team);
+static ucc_status_t ucc_team_sync_pipeline_model(ucc_team_t *team);
 static void ucc_team_release_id(ucc_team_t *team);
 
 void ucc_copy_team_params(ucc_team_params_t *dst, const ucc_team_params_t *src)
@@ -256,14 +257,10 @@ static ucc_status_t ucc_team_create_service_team(ucc_context_t *context,
     return status;
 }
 
-static ucc_status_t ucc_team_create_cls(ucc_context_t *context,
-                                        ucc_team_t *team)
+static void ucc_team_topo_init(ucc_context_t *context, ucc_team_t *team)
 {
-    ucc_cl_iface_t  *cl_iface;
-    ucc_base_team_t *b_team;
-    ucc_status_t     status;
-    ucc_subset_t     subset;
-    int              i;
+    ucc_subset_t subset;
+    ucc_status_t status;
 
     if (context->topo && !team->topo && team->size > 1) {
         /* Context->topo is not NULL if any of the enabled CLs
@@ -275,6 +272,17 @@ static ucc_status_t ucc_team_create_cls(ucc_context_t *context,
             ucc_warn("failed to init team topo");
         }
     }
+}
+
+static ucc_status_t ucc_team_create_cls(ucc_context_t *context,
+                                        ucc_team_t *team)
+{
+    ucc_cl_iface_t  *cl_iface;
+    ucc_base_team_t *b_team;
+    ucc_status_t     status;
+    int              i;
+
+    ucc_team_topo_init(context, team);
 
     if (team->last_team_create_posted >= 0) {
         cl_iface = UCC_CL_CTX_IFACE(context->cl_ctx[team->last_team_create_posted]);
@@ -446,13 +454,25 @@ ucc_status_t ucc_team_create_test_single(ucc_context_t *context,
             }
         }
         team->bp.id = team->id;
-        team->state = UCC_TEAM_CL_CREATE;
+        team->state = UCC_TEAM_PIPELINE_MODEL;
         if (team->service_team) {
             /* update service team id */
             UCC_TL_TEAM_IFACE(team->service_team)->scoll.update_id
                 (&team->service_team->super, team->id);
         }
         /* fall through */
+    case UCC_TEAM_PIPELINE_MODEL:
+        if (ucc_global_config.pipeline_model &&
+            (context->service_team || team->service_team)) {
+            /* without service team the ranks can not agree on the model,
+               pipelines keep static "auto" params */
+            status = ucc_team_sync_pipeline_model(team);
+            if (UCC_OK != status) {
+                goto out;
+            }
+        }
+        team->state = UCC_TEAM_CL_CREATE;
+        /* fall through */
     case UCC_TEAM_CL_CREATE:
         status = ucc_team_create_cls(context, team);
         break;
@@ -465,6 +485,12 @@ out:
         status = ucc_team_build_score_map(team);
     }
 
+    if (UCC_OK == status) {
+        status = ucc_coll_cache_init(&team->coll_cache,
+                                     context->coll_init_cache_size,
+                                     context->thread_mode);
+    }
+
     if (UCC_OK == status &&
         ucc_global_config.log_component.log_level >= UCC_LOG_LEVEL_INFO &&
         team->rank == 0) {
@@ -499,6 +525,8 @@ static ucc_status_t ucc_team_destroy_single(ucc_team_h team)
     int             i;
     ucc_status_t    status;
 
+    /* cached tasks hold CL/TL team resources */
+    ucc_coll_cache_cleanup(&team->coll_cache);
     if (team->service_team) {
         if (UCC_OK != (status = UCC_TL_CTX_IFACE(team->contexts[0]->service_ctx)
                        ->team.destroy(&team->service_team->super))) {
@@ -645,6 +673,46 @@ static ucc_status_t ucc_team_alloc_id(ucc_team_t *team)
     return UCC_OK;
 }
 
+static ucc_status_t ucc_team_sync_pipeline_model(ucc_team_t *team)
+{
+    ucc_context_t             *ctx = team->contexts[0];
+    ucc_pipeline_model_shape_t shape;
+    ucc_status_t               status;
+
+    if (!team->sreq) {
+        ucc_subset_t subset = {.map.type   = UCC_EP_MAP_FULL,
+                               .map.ep_num = team->size,
+                               .myrank     = team->rank};
+        /* fragmentation must be identical on all the ranks: everyone
+           uses the model of rank 0 */
+        if (team->rank == 0) {
+            /* 16 nodes x 1 ppn and 1 node x 16 ppn are different shapes */
+            ucc_team_topo_init(ctx, team);
+            shape.size   = team->size;
+            shape.nnodes = team->topo ? ucc_topo_nnodes(team->topo) : 0;
+            ucc_pipeline_model_snapshot(&shape, &team->pipeline_model);
+        }
+        status = ucc_service_bcast(team, &team->pipeline_model,
+                                   sizeof(team->pipeline_model), 0, subset,
+                                   &team->sreq);
+        if (status < 0) {
+            return status;
+        }
+    }
+    ucc_context_progress(ctx);
+    status = ucc_service_coll_test(team->sreq);
+    if (status < 0) {
+        ucc_error("service bcast test failure: %s",
+                  ucc_status_string(status));
+        return status;
+    } else if (status != UCC_OK) {
+        return status;
+    }
+    ucc_service_coll_finalize(team->sreq);
+    team->sreq = NULL;
+    return UCC_OK;
+}
+
 static void ucc_team_release_id(ucc_team_t *team)
 {
     ucc_context_t *ctx = team->contexts[0];
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -16,12 +16,15 @@
 #include "components/cl/ucc_cl.h"
 #include "components/tl/ucc_tl.h"
 #include "coll_score/ucc_coll_score.h"
+#include "ucc_coll_cache.h"
+#include "schedule/ucc_pipeline_model.h"
 
 typedef struct ucc_service_coll_req ucc_service_coll_req_t;
 typedef enum {
     UCC_TEAM_ADDR_EXCHANGE,
     UCC_TEAM_SERVICE_TEAM,
     UCC_TEAM_ALLOC_ID,
+    UCC_TEAM_PIPELINE_MODEL,
     UCC_TEAM_CL_CREATE,
     UCC_TEAM_ACTIVE,
 } ucc_team_state_t;
@@ -48,6 +51,9 @@ typedef struct ucc_team {
     ucc_topo_t             *topo;
     ucc_score_map_t        *score_map; /*< score map of CLs */
     uint32_t                seq_num;
+    ucc_coll_cache_t        coll_cache; /*< cache of completed tasks */
+    ucc_pipeline_model_t    pipeline_model; /*< pipeline model agreed by
+                                                all the team ranks */
 } ucc_team_t;
 
 /* If the bit is set then team_id is provided by the user */
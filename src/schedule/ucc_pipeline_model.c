@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "ucc_pipeline_model.h"
+#include "ucc_schedule.h"
+#include "ucc_schedule_pipelined.h"
+#include "core/ucc_global_opts.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_list.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_log.h"
+#include <pthread.h>
+#include <limits.h>
+#include <unistd.h>
+#include <stdio.h>
+
+/* fits need at least that many samples */
+#define UCC_PIPELINE_MODEL_MIN_SAMPLES 16
+/* sums are halved once that many samples are accumulated, so the model
+   follows the changes of the system */
+#define UCC_PIPELINE_MODEL_WINDOW      1024
+#define UCC_PIPELINE_MODEL_MAX_FRAGS   256
+#define UCC_PIPELINE_MODEL_MAX_DEPTH   16
+#define UCC_PIPELINE_MODEL_MIN_FRAG    4096
+#define UCC_PIPELINE_MODEL_FILE_HEADER "# ucc pipeline model v2"
+
+typedef struct ucc_pipeline_model_stats {
+    double n;
+    double sx;
+    double sy;
+    double sxx;
+    double sxy;
+} ucc_pipeline_model_stats_t;
+
+typedef struct ucc_pipeline_model_entry {
+    ucc_list_link_t            list_elem;
+    ucc_pipeline_model_shape_t shape;
+    struct {
+        ucc_pipeline_model_stats_t lat;
+        ucc_pipeline_model_stats_t period;
+    } slot[UCC_PIPELINE_MODEL_N_SLOTS];
+} ucc_pipeline_model_entry_t;
+
+static UCC_LIST_HEAD(ucc_pipeline_model_list);
+static pthread_mutex_t ucc_pipeline_model_lock = PTHREAD_MUTEX_INITIALIZER;
+static int             ucc_pipeline_model_loaded;
+/* slot -> key, slots are never released while the process runs */
+static ucc_pipeline_model_key_t ucc_pipeline_model_keys[UCC_PIPELINE_MODEL_N_SLOTS];
+static int                      ucc_pipeline_model_n_keys;
+
+static int ucc_pipeline_model_key_init(ucc_pipeline_model_key_t *key,
+                                       const char *name,
+                                       ucc_memory_type_t mem_type,
+                                       ucc_rank_t team_size)
+{
+    /* keys are compared with memcmp */
+    memset(key, 0, sizeof(*key));
+    if (strlen(name) >= UCC_PIPELINE_MODEL_NAME_LEN) {
+        return 0;
+    }
+    strcpy(key->name, name);
+    key->mem_type  = mem_type;
+    key->team_size = team_size;
+    return 1;
+}
+
+/* must be called with the lock held */
+static int ucc_pipeline_model_key_slot(const ucc_pipeline_model_key_t *key)
+{
+    int i;
+
+    for (i = 0; i < ucc_pipeline_model_n_keys; i++) {
+        if (0 == memcmp(&ucc_pipeline_model_keys[i], key, sizeof(*key))) {
+            return i;
+        }
+    }
+    if (ucc_pipeline_model_n_keys == UCC_PIPELINE_MODEL_N_SLOTS) {
+        ucc_debug("no free pipeline model slot for %s", key->name);
+        return -1;
+    }
+    ucc_pipeline_model_keys[ucc_pipeline_model_n_keys] = *key;
+    return ucc_pipeline_model_n_keys++;
+}
+
+int ucc_pipeline_model_slot(const char *name, ucc_memory_type_t mem_type,
+                            ucc_rank_t team_size)
+{
+    ucc_pipeline_model_key_t key;
+    int                      slot;
+
+    if (!ucc_pipeline_model_key_init(&key, name, mem_type, team_size)) {
+        return -1;
+    }
+    pthread_mutex_lock(&ucc_pipeline_model_lock);
+    slot = ucc_pipeline_model_key_slot(&key);
+    pthread_mutex_unlock(&ucc_pipeline_model_lock);
+    return slot;
+}
+
+static ucc_pipeline_model_entry_t *
+ucc_pipeline_model_find_entry(const ucc_pipeline_model_shape_t *shape,
+                              int create)
+{
+    ucc_pipeline_model_entry_t *entry;
+
+    ucc_list_for_each(entry, &ucc_pipeline_model_list, list_elem) {
+        if (entry->shape.size == shape->size &&
+            entry->shape.nnodes == shape->nnodes) {
+            return entry;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    entry = ucc_calloc(1, sizeof(*entry), "pipeline_model_entry");
+    if (!entry) {
+        ucc_error("failed to allocate %zd bytes for pipeline model entry",
+                  sizeof(*entry));
+        return NULL;
+    }
+    entry->shape = *shape;
+    ucc_list_add_tail(&ucc_pipeline_model_list, &entry->list_elem);
+    return entry;
+}
+
+static void ucc_pipeline_model_load(void)
+{
+    const char                 *filename = ucc_global_config.pipeline_model_file;
+    ucc_pipeline_model_entry_t *entry;
+    ucc_pipeline_model_stats_t  lat, period;
+    ucc_pipeline_model_shape_t  shape;
+    ucc_pipeline_model_key_t    key;
+    char                        line[512];
+    char                        name[UCC_PIPELINE_MODEL_NAME_LEN];
+    unsigned                    size, nnodes, team_size;
+    int                         mem_type, slot, n_lines;
+    FILE                       *f;
+
+    ucc_pipeline_model_loaded = 1;
+    if (!filename || strlen(filename) == 0) {
+        return;
+    }
+    f = fopen(filename, "r");
+    if (!f) {
+        ucc_debug("pipeline model file %s is not available", filename);
+        return;
+    }
+    n_lines = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        if (15 != sscanf(line, "%u %u %31s %d %u %lg %lg %lg %lg %lg "
+                         "%lg %lg %lg %lg %lg", &size, &nnodes, name,
+                         &mem_type, &team_size, &lat.n, &lat.sx, &lat.sy,
+                         &lat.sxx, &lat.sxy, &period.n, &period.sx,
+                         &period.sy, &period.sxx, &period.sxy) ||
+            mem_type < 0 || mem_type >= UCC_MEMORY_TYPE_LAST) {
+            ucc_warn("invalid line in pipeline model file %s: %s", filename,
+                     line);
+            continue;
+        }
+        ucc_pipeline_model_key_init(&key, name, (ucc_memory_type_t)mem_type,
+                                    (ucc_rank_t)team_size);
+        slot = ucc_pipeline_model_key_slot(&key);
+        if (slot < 0) {
+            continue;
+        }
+        shape.size   = (ucc_rank_t)size;
+        shape.nnodes = (ucc_rank_t)nnodes;
+        entry        = ucc_pipeline_model_find_entry(&shape, 1);
+        if (!entry) {
+            break;
+        }
+        entry->slot[slot].lat    = lat;
+        entry->slot[slot].period = period;
+        n_lines++;
+    }
+    fclose(f);
+    ucc_debug("loaded %d pipeline model entries from %s", n_lines, filename);
+}
+
+static void ucc_pipeline_model_save(void)
+{
+    const char                 *filename = ucc_global_config.pipeline_model_file;
+    ucc_pipeline_model_entry_t *entry;
+    ucc_pipeline_model_stats_t *lat, *period;
+    ucc_pipeline_model_key_t   *key;
+    char                        tmp_name[PATH_MAX];
+    int                         i;
+    FILE                       *f;
+
+    if (!filename || strlen(filename) == 0 ||
+        ucc_list_is_empty(&ucc_pipeline_model_list)) {
+        return;
+    }
+    /* several processes may store the model concurrently: write a private
+       file and atomically replace the target */
+    snprintf(tmp_name, sizeof(tmp_name), "%s.%d.tmp", filename, getpid());
+    f = fopen(tmp_name, "w");
+    if (!f) {
+        ucc_warn("failed to open pipeline model file %s", tmp_name);
+        return;
+    }
+    fprintf(f, "%s\n", UCC_PIPELINE_MODEL_FILE_HEADER);
+    ucc_list_for_each(entry, &ucc_pipeline_model_list, list_elem) {
+        for (i = 0; i < ucc_pipeline_model_n_keys; i++) {
+            key    = &ucc_pipeline_model_keys[i];
+            lat    = &entry->slot[i].lat;
+            period = &entry->slot[i].period;
+            if (lat->n == 0 && period->n == 0) {
+                continue;
+            }
+            fprintf(f, "%u %u %s %d %u %.17g %.17g %.17g %.17g %.17g "
+                    "%.17g %.17g %.17g %.17g %.17g\n",
+                    (unsigned)entry->shape.size,
+                    (unsigned)entry->shape.nnodes, key->name,
+                    (int)key->mem_type, (unsigned)key->team_size, lat->n,
+                    lat->sx, lat->sy, lat->sxx, lat->sxy, period->n,
+                    period->sx, period->sy, period->sxx, period->sxy);
+        }
+    }
+    if (0 != fclose(f) || 0 != rename(tmp_name, filename)) {
+        ucc_warn("failed to store pipeline model file %s", filename);
+        unlink(tmp_name);
+    }
+}
+
+static inline void ucc_pipeline_model_stats_add(ucc_pipeline_model_stats_t *s,
+                                                double x, double y)
+{
+    if (s->n >= UCC_PIPELINE_MODEL_WINDOW) {
+        s->n   *= 0.5;
+        s->sx  *= 0.5;
+        s->sy  *= 0.5;
+        s->sxx *= 0.5;
+        s->sxy *= 0.5;
+    }
+    s->n   += 1;
+    s->sx  += x;
+    s->sy  += y;
+    s->sxx += x * x;
+    s->sxy += x * y;
+}
+
+/* least squares fit of y = a + b * x, returns 0 if the samples do not
+   define the line */
+static int ucc_pipeline_model_stats_fit(const ucc_pipeline_model_stats_t *s,
+                                        double *a, double *b)
+{
+    double den;
+
+    if (s->n < UCC_PIPELINE_MODEL_MIN_SAMPLES) {
+        return 0;
+    }
+    den = s->n * s->sxx - s->sx * s->sx;
+    if (den <= 1e-9 * s->n * s->sxx) {
+        /* all the samples are of the same size */
+        return 0;
+    }
+    *b = (s->n * s->sxy - s->sx * s->sy) / den;
+    *a = (s->sy - *b * s->sx) / s->n;
+    *a = ucc_max(*a, 0);
+    *b = ucc_max(*b, 0);
+    return 1;
+}
+
+void ucc_pipeline_model_snapshot(const ucc_pipeline_model_shape_t *shape,
+                                 ucc_pipeline_model_t             *model)
+{
+    ucc_pipeline_model_entry_t *entry;
+    ucc_pipeline_model_fit_t   *fit;
+    int                         i;
+
+    memset(model, 0, sizeof(*model));
+    model->enabled = 1;
+    model->shape   = *shape;
+
+    pthread_mutex_lock(&ucc_pipeline_model_lock);
+    if (!ucc_pipeline_model_loaded) {
+        ucc_pipeline_model_load();
+    }
+    entry = ucc_pipeline_model_find_entry(shape, 0);
+    if (entry) {
+        for (i = 0; i < ucc_pipeline_model_n_keys; i++) {
+            fit = &model->fits[model->n_fits].fit;
+            if (ucc_pipeline_model_stats_fit(&entry->slot[i].lat,
+                                             &fit->lat_a, &fit->lat_b) &&
+                ucc_pipeline_model_stats_fit(&entry->slot[i].period,
+                                             &fit->period_a,
+                                             &fit->period_b) &&
+                fit->period_a > 0) {
+                model->fits[model->n_fits++].key = ucc_pipeline_model_keys[i];
+            } else {
+                memset(fit, 0, sizeof(*fit));
+            }
+        }
+    }
+    pthread_mutex_unlock(&ucc_pipeline_model_lock);
+}
+
+void ucc_pipeline_model_update(const ucc_pipeline_model_shape_t *shape,
+                               int slot, double frag_size, double latency,
+                               double period)
+{
+    ucc_pipeline_model_entry_t *entry;
+
+    ucc_assert(slot >= 0 && slot < ucc_pipeline_model_n_keys);
+    pthread_mutex_lock(&ucc_pipeline_model_lock);
+    if (!ucc_pipeline_model_loaded) {
+        ucc_pipeline_model_load();
+    }
+    entry = ucc_pipeline_model_find_entry(shape, 1);
+    if (entry) {
+        ucc_pipeline_model_stats_add(&entry->slot[slot].lat, frag_size,
+                                     latency);
+        if (period >= 0) {
+            ucc_pipeline_model_stats_add(&entry->slot[slot].period,
+                                         frag_size, period);
+        }
+    }
+    pthread_mutex_unlock(&ucc_pipeline_model_lock);
+}
+
+static inline double
+ucc_pipeline_model_time(const ucc_pipeline_model_fit_t *fit, double msgsize,
+                        unsigned n_frags)
+{
+    double frag = msgsize / n_frags;
+
+    return fit->lat_a + fit->lat_b * frag +
+           (n_frags - 1) * (fit->period_a + fit->period_b * frag);
+}
+
+ucc_status_t ucc_pipeline_model_params(const ucc_pipeline_model_t *model,
+                                       const char *name,
+                                       ucc_memory_type_t mem_type,
+                                       ucc_rank_t team_size, size_t msgsize,
+                                       ucc_pipeline_params_t *pp)
+{
+    const ucc_pipeline_model_fit_t *fit;
+    ucc_pipeline_model_key_t        key;
+    double                          frag, lat, period, t, t_next;
+    unsigned                        n_frags, max_frags, pdepth;
+    int                             i;
+
+    if (!model->enabled ||
+        !ucc_pipeline_model_key_init(&key, name, mem_type, team_size)) {
+        return UCC_ERR_NOT_FOUND;
+    }
+    /* the lookup does not involve the slots of this process, so the result
+       only depends on the snapshot which is the same on all the ranks */
+    fit = NULL;
+    for (i = 0; i < model->n_fits; i++) {
+        if (0 == memcmp(&model->fits[i].key, &key, sizeof(key))) {
+            fit = &model->fits[i].fit;
+            break;
+        }
+    }
+    if (!fit) {
+        return UCC_ERR_NOT_FOUND;
+    }
+
+    /* T(n) is convex, walk up to its minimum */
+    max_frags = ucc_min(msgsize / UCC_PIPELINE_MODEL_MIN_FRAG,
+                        UCC_PIPELINE_MODEL_MAX_FRAGS);
+    n_frags   = 1;
+    t         = ucc_pipeline_model_time(fit, msgsize, n_frags);
+    while (n_frags < max_frags) {
+        t_next = ucc_pipeline_model_time(fit, msgsize, n_frags + 1);
+        if (t_next >= t) {
+            break;
+        }
+        t = t_next;
+        n_frags++;
+    }
+
+    frag   = (double)msgsize / n_frags;
+    lat    = fit->lat_a + fit->lat_b * frag;
+    period = fit->period_a + fit->period_b * frag;
+    pdepth = (lat / period >= UCC_PIPELINE_MODEL_MAX_DEPTH)
+                 ? UCC_PIPELINE_MODEL_MAX_DEPTH
+                 : (unsigned)(lat / period);
+    if (pdepth * period < lat) {
+        pdepth++;
+    }
+    pdepth = ucc_max(1, ucc_min(pdepth, n_frags));
+
+    pp->threshold = (n_frags > 1) ? 0 : SIZE_MAX;
+    pp->n_frags   = n_frags;
+    pp->frag_size = ucc_div_round_up(ucc_max(msgsize, 1), n_frags);
+    pp->pdepth    = pdepth;
+    return UCC_OK;
+}
+
+void ucc_pipeline_model_cleanup(void)
+{
+    ucc_pipeline_model_entry_t *entry, *tmp;
+
+    pthread_mutex_lock(&ucc_pipeline_model_lock);
+    ucc_pipeline_model_save();
+    ucc_list_for_each_safe(entry, tmp, &ucc_pipeline_model_list, list_elem) {
+        ucc_list_del(&entry->list_elem);
+        ucc_free(entry);
+    }
+    ucc_pipeline_model_loaded = 0;
+    pthread_mutex_unlock(&ucc_pipeline_model_lock);
+}
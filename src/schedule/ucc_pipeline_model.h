@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_PIPELINE_MODEL_H_
+#define UCC_PIPELINE_MODEL_H_
+
+#include "config.h"
+#include "ucc/api/ucc.h"
+#include "utils/ucc_datastruct.h"
+
+/* Online model of pipelined schedules used by "auto" pipeline params.
+
+   Pipelined schedules with an attached model slot report, for every
+   fragment, its latency (post to completion) and the period since the
+   previous fragment of the same schedule completed. Both are fitted
+   linearly in the fragment size x:
+       L(x) = lat_a + lat_b * x,  P(x) = period_a + period_b * x.
+   A message of size M split into n fragments takes about
+       T(n) = L(M/n) + (n - 1) * P(M/n),
+   the fragment count minimizes T(n) and the pipeline depth is the number
+   of fragments in flight needed to sustain the period: ceil(L / P).
+
+   Measurements are accumulated per process and per team shape (number of
+   ranks and nodes of the core team), they outlive the teams and optionally
+   the process (UCC_PIPELINE_MODEL_FILE). Within a shape every algorithm
+   is keyed exactly by its name, memory type and the size of the team it
+   runs on. A team takes the fits of rank 0 at creation time, so all the
+   ranks of the team make identical fragmentation decisions. */
+
+#define UCC_PIPELINE_MODEL_N_SLOTS  32
+#define UCC_PIPELINE_MODEL_NAME_LEN 32
+
+typedef struct ucc_pipeline_model_shape {
+    ucc_rank_t size;
+    ucc_rank_t nnodes; /*< 0 if the team topology is unknown */
+} ucc_pipeline_model_shape_t;
+
+typedef struct ucc_pipeline_model_key {
+    char              name[UCC_PIPELINE_MODEL_NAME_LEN];
+    ucc_memory_type_t mem_type;
+    ucc_rank_t        team_size;
+} ucc_pipeline_model_key_t;
+
+typedef struct ucc_pipeline_model_fit {
+    double lat_a;
+    double lat_b;
+    double period_a;
+    double period_b;
+} ucc_pipeline_model_fit_t;
+
+/* Snapshot of the fits agreed by all the ranks of a team. Slots are
+   assigned per process, so the fits carry their keys. */
+typedef struct ucc_pipeline_model {
+    int                        enabled;
+    int                        n_fits;
+    ucc_pipeline_model_shape_t shape;
+    struct {
+        ucc_pipeline_model_key_t key;
+        ucc_pipeline_model_fit_t fit;
+    } fits[UCC_PIPELINE_MODEL_N_SLOTS];
+} ucc_pipeline_model_t;
+
+struct ucc_pipeline_params;
+
+/* Slot of the algorithm "name" running on a team of "team_size" ranks
+   with "mem_type" buffers. Returns -1 if all the slots are taken or the
+   name is too long. */
+int ucc_pipeline_model_slot(const char *name, ucc_memory_type_t mem_type,
+                            ucc_rank_t team_size);
+
+/* Fills "model" with the current fits for teams of the given shape */
+void ucc_pipeline_model_snapshot(const ucc_pipeline_model_shape_t *shape,
+                                 ucc_pipeline_model_t             *model);
+
+/* Reports a fragment of size "frag_size" completed "latency" seconds after
+   its post and "period" seconds after the previous fragment (negative if
+   it is the first one) */
+void ucc_pipeline_model_update(const ucc_pipeline_model_shape_t *shape,
+                               int slot, double frag_size, double latency,
+                               double period);
+
+/* Predicts pipeline params for a message of "msgsize" bytes from the fit
+   of the given key in "model". Returns UCC_ERR_NOT_FOUND and keeps "pp"
+   intact if the key is not calibrated. */
+ucc_status_t ucc_pipeline_model_params(const ucc_pipeline_model_t *model,
+                                       const char *name,
+                                       ucc_memory_type_t mem_type,
+                                       ucc_rank_t team_size, size_t msgsize,
+                                       struct ucc_pipeline_params *pp);
+
+/* Stores the measurements to UCC_PIPELINE_MODEL_FILE and releases them */
+void ucc_pipeline_model_cleanup(void);
+
+#endif
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 #include "ucc_schedule.h"
@@ -119,6 +119,7 @@ ucc_status_t ucc_coll_task_init(ucc_coll_task_t *task,
     task->post                 = ucc_dummy_post;
     task->finalize             = ucc_dummy_finalize;
     task->progress             = ucc_dummy_progress;
+    task->rebind               = NULL;
 
     // Prevent asymmetric memory copy-out of garbage address at task complete
     task->bargs.asymmetric_save_info.scratch = NULL;
@@ -202,7 +203,7 @@ ucc_schedule_completed_handler(ucc_coll_task_t *parent_task, //NOLINT
     ucc_schedule_t *self = ucc_container_of(task, ucc_schedule_t, super);
     uint32_t        n_completed_tasks;
 
-    n_completed_tasks = ucc_atomic_fadd32(&self->n_completed_tasks, 1);
+    n_completed_tasks = UCC_TASK_COUNTER_FADD(task, &self->n_completed_tasks);
 
     if (n_completed_tasks + 1 == self->n_tasks) {
         self->super.status = UCC_OK;
@@ -221,14 +222,47 @@ ucc_status_t ucc_schedule_init(ucc_schedule_t *schedule,
     schedule->super.flags |= UCC_COLL_TASK_FLAG_IS_SCHEDULE;
     schedule->ctx         = team->context->ucc_context;
     schedule->n_tasks     = 0;
+    schedule->tasks       = schedule->tasks_inline;
+    schedule->max_tasks   = UCC_SCHEDULE_MAX_TASKS;
     return status;
 }
 
+static ucc_status_t ucc_schedule_grow_tasks(ucc_schedule_t *schedule)
+{
+    uint32_t          max_tasks = schedule->max_tasks * 2;
+    ucc_coll_task_t **tasks;
+
+    if (schedule->tasks == schedule->tasks_inline) {
+        tasks = ucc_malloc(max_tasks * sizeof(*tasks), "schedule_tasks");
+        if (tasks) {
+            memcpy(tasks, schedule->tasks_inline,
+                   schedule->n_tasks * sizeof(*tasks));
+        }
+    } else {
+        tasks = ucc_realloc(schedule->tasks, max_tasks * sizeof(*tasks),
+                            "schedule_tasks");
+    }
+    if (ucc_unlikely(!tasks)) {
+        ucc_error("failed to allocate %zd bytes for schedule tasks",
+                  max_tasks * sizeof(*tasks));
+        return UCC_ERR_NO_MEMORY;
+    }
+    schedule->tasks     = tasks;
+    schedule->max_tasks = max_tasks;
+    return UCC_OK;
+}
+
 ucc_status_t ucc_schedule_add_task(ucc_schedule_t *schedule,
                                    ucc_coll_task_t *task)
 {
     ucc_status_t status;
 
+    if (ucc_unlikely(schedule->n_tasks == schedule->max_tasks)) {
+        status = ucc_schedule_grow_tasks(schedule);
+        if (ucc_unlikely(status != UCC_OK)) {
+            return status;
+        }
+    }
     status = ucc_event_manager_subscribe(task, UCC_EVENT_COMPLETED_SCHEDULE,
                                          &schedule->super,
                                          ucc_schedule_completed_handler);
@@ -273,5 +307,10 @@ ucc_status_t ucc_schedule_finalize(ucc_coll_task_t *task)
             }
         }
     }
+    if (schedule->tasks != schedule->tasks_inline) {
+        ucc_free(schedule->tasks);
+        schedule->tasks     = schedule->tasks_inline;
+        schedule->max_tasks = UCC_SCHEDULE_MAX_TASKS;
+    }
     return status_overall;
 }
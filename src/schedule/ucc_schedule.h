@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -49,6 +49,11 @@ typedef ucc_status_t (*ucc_coll_triggered_post_setup_fn_t)(ucc_coll_task_t *task
 typedef ucc_status_t (*ucc_coll_triggered_post_fn_t)(ucc_ee_h ee, ucc_ev_t *ev,
                                                      ucc_coll_task_t *task);
 
+/* Rebinds completed task to new coll args which differ from the ones task
+   was initialized with only by buffer addresses and callback */
+typedef ucc_status_t (*ucc_coll_rebind_fn_t)(ucc_coll_task_t *task,
+                                             ucc_base_coll_args_t *bargs);
+
 typedef struct ucc_em_listener {
     ucc_coll_task_t          *task;
     ucc_task_event_handler_p  handler;
@@ -75,7 +80,8 @@ enum {
     UCC_COLL_TASK_FLAG_IS_SCHEDULE           = UCC_BIT(5),
     /* if set task can be casted to scheulde */
     UCC_COLL_TASK_FLAG_IS_PIPELINED_SCHEDULE = UCC_BIT(6),
-
+    /* task is returned to team coll init cache on finalize */
+    UCC_COLL_TASK_FLAG_CACHED                = UCC_BIT(7),
 };
 
 typedef struct ucc_coll_task {
@@ -96,6 +102,7 @@ typedef struct ucc_coll_task {
     ucc_coll_triggered_post_fn_t       triggered_post;
     ucc_coll_progress_fn_t             progress;
     ucc_coll_finalize_fn_t             finalize;
+    ucc_coll_rebind_fn_t               rebind;
     ucc_coll_callback_t                cb;
     ucc_ee_h                           ee;
     ucc_ev_t                          *ev;
@@ -118,14 +125,19 @@ typedef struct ucc_coll_task {
 extern struct ucc_mpool_ops ucc_coll_task_mpool_ops;
 typedef struct ucc_context ucc_context_t;
 
+/* Number of tasks a schedule holds without extra allocation. The storage
+   grows on demand, see ucc_schedule_add_task */
 #define UCC_SCHEDULE_MAX_TASKS 8
 
 typedef struct ucc_schedule {
-    ucc_coll_task_t  super;
-    uint32_t         n_completed_tasks;
-    uint32_t         n_tasks;
-    ucc_context_t   *ctx;
-    ucc_coll_task_t *tasks[UCC_SCHEDULE_MAX_TASKS];
+    ucc_coll_task_t   super;
+    uint32_t          n_completed_tasks;
+    uint32_t          n_tasks;
+    ucc_context_t    *ctx;
+    /* points to tasks_inline or to allocated storage of max_tasks entries */
+    ucc_coll_task_t **tasks;
+    uint32_t          max_tasks;
+    ucc_coll_task_t  *tasks_inline[UCC_SCHEDULE_MAX_TASKS];
 } ucc_schedule_t;
 
 void ucc_coll_task_construct(ucc_coll_task_t *task);
@@ -256,4 +268,12 @@ static inline ucc_status_t ucc_task_subscribe_dep(ucc_coll_task_t *target,
     (((ucc_coll_task_t *)_task)->team->context->ucc_context)
 
 #define UCC_TASK_THREAD_MODE(_task) (UCC_TASK_CORE_CTX(_task)->thread_mode)
+
+/* Increments dependency/completion counter of the task and returns the old
+   value. Counters can only be updated concurrently with thread multiple
+   progress, otherwise atomic is not needed */
+#define UCC_TASK_COUNTER_FADD(_task, _counter)                                 \
+    ((UCC_TASK_THREAD_MODE(_task) == UCC_THREAD_MULTIPLE)                      \
+         ? ucc_atomic_fadd32((_counter), 1)                                    \
+         : (*(_counter))++)
 #endif
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -8,6 +8,8 @@
 #include "ucc_schedule_pipelined.h"
 #include "coll_score/ucc_coll_score.h"
 #include "core/ucc_context.h"
+#include "core/ucc_team.h"
+#include "utils/ucc_time.h"
 
 const char* ucc_pipeline_order_names[] = {
     [UCC_PIPELINE_PARALLEL]   = "parallel",
@@ -34,6 +36,9 @@ static ucc_status_t ucc_frag_start_handler(ucc_coll_task_t *parent,
         }
     }
 
+    if (schedule->model_slot >= 0) {
+        schedule->frag_post_time[schedule->next_frag_to_post] = ucc_get_time();
+    }
     schedule->next_frag_to_post = (schedule->next_frag_to_post + 1) %
                                   schedule->n_frags;
     ucc_trace_req("sched %p started frag %p frag_num %d next_to_post %d",
@@ -44,6 +49,29 @@ static ucc_status_t ucc_frag_start_handler(ucc_coll_task_t *parent,
     return task->post(task);
 }
 
+static void
+ucc_schedule_pipelined_model_update(ucc_schedule_pipelined_t *schedule,
+                                    ucc_schedule_t *frag)
+{
+    double now = ucc_get_time();
+    double period;
+    int    i;
+
+    for (i = 0; i < schedule->n_frags; i++) {
+        if (schedule->frags[i] == frag) {
+            break;
+        }
+    }
+    ucc_assert(i < schedule->n_frags);
+    period = (schedule->model_last_completion > 0)
+                 ? now - schedule->model_last_completion
+                 : -1;
+    schedule->model_last_completion = now;
+    ucc_pipeline_model_update(&schedule->model_shape, schedule->model_slot,
+                              schedule->model_frag_size,
+                              now - schedule->frag_post_time[i], period);
+}
+
 static ucc_status_t
 ucc_schedule_pipelined_completed_handler(ucc_coll_task_t *parent_task,
                                          ucc_coll_task_t *task)
@@ -57,6 +85,10 @@ ucc_schedule_pipelined_completed_handler(ucc_coll_task_t *parent_task,
         ucc_recursive_spin_lock(&schedule->lock);
     }
 
+    if (schedule->model_slot >= 0) {
+        ucc_schedule_pipelined_model_update(schedule, frag);
+    }
+
     schedule->super.n_completed_tasks += 1;
     schedule->n_frags_in_pipeline--;
     ucc_trace_req(
@@ -113,6 +145,15 @@ ucc_status_t ucc_schedule_pipelined_finalize(ucc_coll_task_t *task)
         ucc_recursive_spinlock_destroy(&schedule_p->lock);
     }
 
+    if (frags != schedule_p->frags_inline) {
+        ucc_free(frags);
+        schedule_p->frags = schedule_p->frags_inline;
+    }
+    if (schedule_p->frag_post_time != schedule_p->frag_post_time_inline) {
+        ucc_free(schedule_p->frag_post_time);
+        schedule_p->frag_post_time = schedule_p->frag_post_time_inline;
+    }
+    schedule_p->model_slot = -1;
     return UCC_OK;
 }
 
@@ -128,6 +169,7 @@ ucc_status_t ucc_schedule_pipelined_post(ucc_coll_task_t *task)
     schedule_p->n_frags_started          = 0;
     schedule_p->next_frag_to_post        = 0;
     schedule_p->n_frags_in_pipeline      = 0;
+    schedule_p->model_last_completion    = 0;
 
     for (i = 0; i < schedule_p->n_frags; i++) {
         frags[i]->n_completed_tasks  = 0;
@@ -159,12 +201,6 @@ ucc_status_t ucc_schedule_pipelined_init(ucc_base_coll_args_t *coll_args,
     ucc_status_t     status;
     ucc_schedule_t **frags;
 
-    if (ucc_unlikely(n_frags > UCC_SCHEDULE_PIPELINED_MAX_FRAGS)) {
-        ucc_error("n_frags %d exceeds max limit of %d",
-                  n_frags, UCC_SCHEDULE_PIPELINED_MAX_FRAGS);
-        return UCC_ERR_INVALID_PARAM;
-    }
-
     if (n_frags > 1) {
         /* determine dependency between frags */
         switch (order) {
@@ -191,6 +227,20 @@ ucc_status_t ucc_schedule_pipelined_init(ucc_base_coll_args_t *coll_args,
         return status;
     }
 
+    schedule->model_slot     = -1;
+    schedule->frag_post_time = schedule->frag_post_time_inline;
+    schedule->frags          = schedule->frags_inline;
+    if (n_frags > UCC_SCHEDULE_PIPELINED_MAX_FRAGS) {
+        schedule->frags = ucc_malloc(n_frags * sizeof(*schedule->frags),
+                                     "pipelined_frags");
+        if (ucc_unlikely(!schedule->frags)) {
+            ucc_error("failed to allocate %zd bytes for pipelined frags",
+                      n_frags * sizeof(*schedule->frags));
+            schedule->frags = schedule->frags_inline;
+            return UCC_ERR_NO_MEMORY;
+        }
+    }
+
     if (UCC_TASK_THREAD_MODE(&schedule->super.super) == UCC_THREAD_MULTIPLE) {
         ucc_recursive_spinlock_init(&schedule->lock, 0);
     }
@@ -247,16 +297,69 @@ err:
     for (i = i - 1; i >= 0; i--) {
         frags[i]->super.finalize(&frags[i]->super);
     }
+    if (frags != schedule->frags_inline) {
+        ucc_free(frags);
+        schedule->frags = schedule->frags_inline;
+    }
     return status;
 }
 
+int ucc_pipeline_params_model(ucc_base_team_t *team, const char *name,
+                              ucc_memory_type_t mem_type, size_t msgsize,
+                              int predict, ucc_pipeline_params_t *pp)
+{
+    ucc_team_t *core_team = team->params.team;
+    int         slot;
+
+    if (!core_team || !core_team->pipeline_model.enabled) {
+        return -1;
+    }
+    /* the slot only feeds measurements, it may be -1 on some ranks when
+       their registry is full while the prediction must be the same on all
+       the ranks */
+    slot = ucc_pipeline_model_slot(name, mem_type, team->params.size);
+    if (predict &&
+        UCC_OK == ucc_pipeline_model_params(&core_team->pipeline_model, name,
+                                            mem_type, team->params.size,
+                                            msgsize, pp)) {
+        ucc_debug("pipeline model %s msgsize %zd: n_frags %u, frag_size %zd, "
+                  "pdepth %u", name, msgsize, pp->n_frags, pp->frag_size,
+                  pp->pdepth);
+    }
+    return slot;
+}
+
+void ucc_schedule_pipelined_set_model(ucc_schedule_pipelined_t *schedule_p,
+                                      int slot, size_t msgsize)
+{
+    ucc_base_team_t *team = schedule_p->super.super.team;
+
+    if (slot < 0) {
+        return;
+    }
+    if (schedule_p->n_frags > UCC_SCHEDULE_PIPELINED_MAX_FRAGS) {
+        schedule_p->frag_post_time =
+            ucc_malloc(schedule_p->n_frags * sizeof(double), "frag_post_time");
+        if (ucc_unlikely(!schedule_p->frag_post_time)) {
+            /* measurements are best effort, run without them */
+            ucc_debug("failed to allocate %zd bytes for frag post time",
+                      schedule_p->n_frags * sizeof(double));
+            schedule_p->frag_post_time = schedule_p->frag_post_time_inline;
+            return;
+        }
+    }
+    schedule_p->model_slot      = slot;
+    schedule_p->model_shape     = team->params.team->pipeline_model.shape;
+    schedule_p->model_frag_size = (double)msgsize / schedule_p->super.n_tasks;
+}
+
 ucc_status_t ucc_dependency_handler(ucc_coll_task_t *parent,
                                     ucc_coll_task_t *task)
 {
     ucc_status_t status;
     uint32_t     n_deps_satisfied;
 
-    n_deps_satisfied = ucc_atomic_fadd32(&task->n_deps_satisfied, 1);
+    n_deps_satisfied = UCC_TASK_COUNTER_FADD(task, &task->n_deps_satisfied);
     ucc_assert(task->n_deps_satisfied > n_deps_satisfied);
 
     ucc_trace_req("task %p, n_deps %d, satisfied %d", task, task->n_deps,
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -8,8 +8,10 @@
 #define UCC_SCHEDULE_PIPELINED_H_
 
 #include "components/base/ucc_base_iface.h"
+#include "ucc_pipeline_model.h"
 
 #define UCC_SCHEDULE_FRAG_MAX_TASKS 8
+/* Pipeline depth supported without extra allocation */
 #define UCC_SCHEDULE_PIPELINED_MAX_FRAGS 4
 
 typedef struct ucc_schedule_pipelined ucc_schedule_pipelined_t;
@@ -70,8 +72,10 @@ static inline void ucc_pipeline_nfrags_pdepth(ucc_pipeline_params_t *p,
 extern const char* ucc_pipeline_order_names[];
 typedef struct ucc_schedule_pipelined {
     ucc_schedule_t               super;
-    /* Array of the frag schedules - 1 schedule per pipeline entry */
-    ucc_schedule_t *             frags[UCC_SCHEDULE_PIPELINED_MAX_FRAGS];
+    /* Array of the frag schedules - 1 schedule per pipeline entry, points
+       to frags_inline or to allocated storage for deeper pipelines */
+    ucc_schedule_t **            frags;
+    ucc_schedule_t *             frags_inline[UCC_SCHEDULE_PIPELINED_MAX_FRAGS];
     /* n_frags - is the depth of the pipeline, ie how many fragments can
        be outstanding at a time */
     int                          n_frags;
@@ -87,6 +91,16 @@ typedef struct ucc_schedule_pipelined {
     int                          next_frag_to_post;
     ucc_schedule_frag_setup_fn_t frag_setup;
     ucc_recursive_spinlock_t     lock;
+    /* pipeline model slot fed with the fragment timings, -1 if none */
+    int                          model_slot;
+    ucc_pipeline_model_shape_t   model_shape;
+    double                       model_frag_size;
+    double                       model_last_completion;
+    /* post timestamps of the frags, points to frag_post_time_inline or to
+       allocated storage for deeper pipelines */
+    double *                     frag_post_time;
+    double
+        frag_post_time_inline[UCC_SCHEDULE_PIPELINED_MAX_FRAGS];
 } ucc_schedule_pipelined_t;
 
 /* Creates a pipelined schedule for the algorithm defined by "frag_init".
@@ -103,5 +117,22 @@ ucc_status_t ucc_schedule_pipelined_init(
 
 ucc_status_t ucc_schedule_pipelined_post(ucc_coll_task_t *task);
 
+/* Returns the pipeline model slot of the algorithm "name" to be passed to
+   ucc_schedule_pipelined_set_model or -1 if the model is disabled or the
+   slots of the process are exhausted. If "predict" is set ("pp" are "auto"
+   params) and the team snapshot has a fit for the algorithm, "pp" is
+   overridden by the prediction of the model, independently of the slot.
+   Static params feed the model as well, so it can be calibrated by
+   sweeping them. */
+int ucc_pipeline_params_model(ucc_base_team_t *team, const char *name,
+                              ucc_memory_type_t mem_type, size_t msgsize,
+                              int predict, ucc_pipeline_params_t *pp);
+
+/* Reports the fragment timings of the schedule to the pipeline model
+   "slot" (no-op for negative slot). "msgsize" is the one used to select
+   the pipeline params. */
+void ucc_schedule_pipelined_set_model(ucc_schedule_pipelined_t *schedule_p,
+                                      int slot, size_t msgsize);
+
 ucc_status_t ucc_schedule_pipelined_finalize(ucc_coll_task_t *task);
 #endif
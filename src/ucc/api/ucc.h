@@ -218,7 +218,14 @@ typedef uint64_t ucc_datatype_t;
 #define UCC_DT_FLOAT32_COMPLEX  UCC_PREDEFINED_DT(15)
 #define UCC_DT_FLOAT64_COMPLEX  UCC_PREDEFINED_DT(16)
 #define UCC_DT_FLOAT128_COMPLEX UCC_PREDEFINED_DT(17)
-#define UCC_DT_PREDEFINED_LAST  18
+/* Value/index pairs used with @ref UCC_OP_MAXLOC and @ref UCC_OP_MINLOC.
+   Memory layout matches C structure {value; int32_t index;} including
+   trailing padding, e.g. UCC_DT_FLOAT64_INT32 element is 16 bytes. */
+#define UCC_DT_FLOAT32_INT32    UCC_PREDEFINED_DT(18)
+#define UCC_DT_FLOAT64_INT32    UCC_PREDEFINED_DT(19)
+#define UCC_DT_INT32_INT32      UCC_PREDEFINED_DT(20)
+#define UCC_DT_INT64_INT32      UCC_PREDEFINED_DT(21)
+#define UCC_DT_PREDEFINED_LAST  22
 
 /**
  * @ingroup UCC_DATATYPE
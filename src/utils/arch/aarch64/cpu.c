@@ -13,6 +13,15 @@
 
 #include "utils/arch/cpu.h"
 #include <stdio.h>
+#include <sys/auxv.h>
+
+#ifndef HWCAP_ASIMD
+#  define HWCAP_ASIMD (1ul << 1)
+#endif
+
+#ifndef HWCAP_SVE
+#  define HWCAP_SVE   (1ul << 22)
+#endif
 
 static void ucc_aarch64_cpuid_from_proc(ucc_aarch64_cpuid_t *cpuid)
 {
@@ -68,4 +77,19 @@ void ucc_aarch64_cpuid(ucc_aarch64_cpuid_t *cpuid)
     *cpuid = cached_cpuid;
 }
 
+uint64_t ucc_arch_get_cpu_flags()
+{
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    uint64_t      flags = 0;
+
+    if (hwcap & HWCAP_ASIMD) {
+        flags |= UCC_CPU_FLAG_NEON;
+    }
+    if (hwcap & HWCAP_SVE) {
+        flags |= UCC_CPU_FLAG_SVE;
+    }
+
+    return flags;
+}
+
 #endif
@@ -76,5 +76,10 @@ static inline ucc_cpu_model_t ucc_arch_get_cpu_model()
     return UCC_CPU_MODEL_ARM_AARCH64;
 }
 
+/**
+ * Get mask of available SIMD extensions, see @ref ucc_cpu_flag_t
+ */
+uint64_t ucc_arch_get_cpu_flags();
+
 
 #endif
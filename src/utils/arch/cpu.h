@@ -15,6 +15,7 @@
 #endif
 
 #include "utils/ucc_compiler_def.h"
+#include "ucc/api/ucc_def.h"
 #include <stddef.h>
 
 /* CPU models */
@@ -53,6 +54,16 @@ typedef enum ucc_cpu_vendor {
     UCC_CPU_VENDOR_LAST
 } ucc_cpu_vendor_t;
 
+/* CPU SIMD extensions which are both supported by the CPU and enabled by OS */
+typedef enum ucc_cpu_flag {
+    UCC_CPU_FLAG_AVX2     = UCC_BIT(0),
+    UCC_CPU_FLAG_F16C     = UCC_BIT(1),
+    UCC_CPU_FLAG_AVX512F  = UCC_BIT(2),
+    UCC_CPU_FLAG_AVX512BW = UCC_BIT(3),
+    UCC_CPU_FLAG_NEON     = UCC_BIT(4),
+    UCC_CPU_FLAG_SVE      = UCC_BIT(5)
+} ucc_cpu_flag_t;
+
 static inline ucc_cpu_vendor_t ucc_get_vendor_from_str(const char *v_name)
 {
     if (strcasecmp(v_name, "intel") == 0)
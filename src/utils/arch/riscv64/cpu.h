@@ -30,4 +30,9 @@ static inline ucc_cpu_vendor_t ucc_arch_get_cpu_vendor()
     return UCC_CPU_VENDOR_GENERIC_RISCV;
 }
 
+static inline uint64_t ucc_arch_get_cpu_flags()
+{
+    return 0;
+}
+
 #endif
@@ -26,6 +26,17 @@
 #define X86_CPUID_GET_CACHE_INFO  0x00000002u
 #define X86_CPUID_GET_LEAF4_INFO  0x00000004u
 
+/* Feature bits of CPUID leaf 1 (ecx) and leaf 7 (ebx) */
+#define X86_CPUID_ECX_F16C        UCC_BIT(29)
+#define X86_CPUID_ECX_OSXSAVE     UCC_BIT(27)
+#define X86_CPUID_EBX_AVX2        UCC_BIT(5)
+#define X86_CPUID_EBX_AVX512F     UCC_BIT(16)
+#define X86_CPUID_EBX_AVX512BW    UCC_BIT(30)
+
+/* XCR0 state components which have to be enabled by OS */
+#define X86_XCR0_YMM              0x06u /* SSE and AVX state */
+#define X86_XCR0_ZMM              0xe6u /* + opmask, ZMM_Hi256, Hi16_ZMM */
+
 typedef union ucc_x86_cpu_registers {
     struct {
         union {
@@ -70,6 +81,73 @@ static UCC_F_NOOPTIMIZE inline void ucc_x86_cpuid(uint32_t level,
                   : "0"(level));
 }
 
+static UCC_F_NOOPTIMIZE inline void ucc_x86_cpuid_count(uint32_t level,
+                                                        uint32_t subleaf,
+                                                        uint32_t *a,
+                                                        uint32_t *b,
+                                                        uint32_t *c,
+                                                        uint32_t *d)
+{
+    asm volatile ("cpuid\n\t"
+                  : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d)
+                  : "0"(level), "2"(subleaf));
+}
+
+static inline uint64_t ucc_x86_xgetbv()
+{
+    uint32_t lo, hi;
+
+    asm volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+uint64_t ucc_arch_get_cpu_flags()
+{
+    static uint64_t cached_flags = UINT64_MAX;
+    uint64_t        flags        = 0;
+    uint32_t        max_leaf, xcr0, _eax, ebx, ecx, _edx;
+
+    if (cached_flags != UINT64_MAX) {
+        return cached_flags;
+    }
+
+    ucc_x86_cpuid(X86_CPUID_GET_BASE_VALUE, &max_leaf, &ebx, &ecx, &_edx);
+    ucc_x86_cpuid(X86_CPUID_GET_MODEL, &_eax, &ebx, &ecx, &_edx);
+    if (!(ecx & X86_CPUID_ECX_OSXSAVE)) {
+        /* OS does not save extended registers state, AVX is unusable */
+        goto out;
+    }
+
+    xcr0 = (uint32_t)ucc_x86_xgetbv();
+    if ((xcr0 & X86_XCR0_YMM) != X86_XCR0_YMM) {
+        goto out;
+    }
+
+    if (ecx & X86_CPUID_ECX_F16C) {
+        flags |= UCC_CPU_FLAG_F16C;
+    }
+
+    if (max_leaf >= X86_CPUID_GET_EXTD_VALUE) {
+        ucc_x86_cpuid_count(X86_CPUID_GET_EXTD_VALUE, 0, &_eax, &ebx, &ecx,
+                            &_edx);
+        if (ebx & X86_CPUID_EBX_AVX2) {
+            flags |= UCC_CPU_FLAG_AVX2;
+        }
+        if ((xcr0 & X86_XCR0_ZMM) == X86_XCR0_ZMM) {
+            if (ebx & X86_CPUID_EBX_AVX512F) {
+                flags |= UCC_CPU_FLAG_AVX512F;
+            }
+            if (ebx & X86_CPUID_EBX_AVX512BW) {
+                flags |= UCC_CPU_FLAG_AVX512BW;
+            }
+        }
+    }
+
+out:
+    cached_flags = flags;
+    return flags;
+}
+
 ucc_cpu_vendor_t ucc_arch_get_cpu_vendor()
 {
     ucc_x86_cpu_registers reg = {}; /* Silence static checker */
@@ -26,4 +26,9 @@
 ucc_cpu_model_t  ucc_arch_get_cpu_model() UCC_F_NOOPTIMIZE;
 ucc_cpu_vendor_t ucc_arch_get_cpu_vendor();
 
+/**
+ * Get mask of available SIMD extensions, see @ref ucc_cpu_flag_t
+ */
+uint64_t         ucc_arch_get_cpu_flags();
+
 #endif
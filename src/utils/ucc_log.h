@@ -168,6 +168,14 @@ static inline const char* ucc_datatype_str(ucc_datatype_t dt)
         return "float64_complex";
     case UCC_DT_FLOAT128_COMPLEX:
         return "float128_complex";
+    case UCC_DT_FLOAT32_INT32:
+        return "float32_int32";
+    case UCC_DT_FLOAT64_INT32:
+        return "float64_int32";
+    case UCC_DT_INT32_INT32:
+        return "int32_int32";
+    case UCC_DT_INT64_INT32:
+        return "int64_int32";
     default:
         return "userdefined";
     }
@@ -102,6 +102,61 @@ static inline void float32tobfloat16(float float_val, void *bfloat16_ptr)
 #endif
 }
 
+typedef union {
+    float    f;
+    uint32_t u;
+} ucc_float32_bits_t;
+
+static inline float float16tofloat32(const void *float16_ptr)
+{
+    uint16_t           h    = *((const uint16_t *)float16_ptr);
+    uint32_t           sign = ((uint32_t)h & 0x8000) << 16;
+    uint32_t           exp  = (h >> 10) & 0x1f;
+    uint32_t           mant = h & 0x3ff;
+    ucc_float32_bits_t r;
+
+    if (exp == 0x1f) {
+        /* inf or NaN, NaN is made quiet */
+        r.u = sign | 0x7f800000 | (mant ? 0x400000 | (mant << 13) : 0);
+    } else if (exp == 0) {
+        /* zero or subnormal: mant * 2^-24 is exact in fp32 */
+        r.f = (float)mant * 5.9604644775390625e-8f;
+        r.u |= sign;
+    } else {
+        r.u = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+    return r.f;
+}
+
+/* Rounds to nearest even, same as hardware conversion instructions */
+static inline void float32tofloat16(float float_val, void *float16_ptr)
+{
+    ucc_float32_bits_t v, t;
+    uint16_t           sign;
+    uint32_t           x;
+
+    v.f  = float_val;
+    sign = (v.u >> 16) & 0x8000;
+    x    = v.u & 0x7fffffff;
+
+    if (x > 0x7f800000) {
+        *((uint16_t *)float16_ptr) = sign | 0x7e00 | ((x >> 13) & 0x3ff);
+    } else if (x >= 0x477ff000) {
+        /* rounds to infinity */
+        *((uint16_t *)float16_ptr) = sign | 0x7c00;
+    } else if (x >= 0x38800000) {
+        /* normal half: rebias exponent and round mantissa */
+        x += 0xfff + ((x >> 13) & 1) - 0x38000000;
+        *((uint16_t *)float16_ptr) = sign | (x >> 13);
+    } else {
+        /* subnormal half or zero: adding 0.5 aligns the mantissa so that
+           fp32 addition performs the rounding */
+        t.u = x;
+        t.f += 0.5f;
+        *((uint16_t *)float16_ptr) = sign | (t.u - 0x3f000000);
+    }
+}
+
 #define ucc_padding(_n, _alignment)                                            \
     ( ((_alignment) - (_n) % (_alignment)) % (_alignment) )
 
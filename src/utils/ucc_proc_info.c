@@ -1,5 +1,5 @@
 /**
-* Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+* Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 
 * See file LICENSE for terms.
 */
@@ -12,6 +12,7 @@
 #include <sched.h>
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 #include "config.h"
 #ifdef HAVE_UCS_GET_SYSTEM_ID
 #include <ucs/sys/uid.h>
@@ -297,6 +298,7 @@ ucc_status_t ucc_local_proc_info_init()
     ucc_local_proc.pid       = getpid();
     ucc_local_proc.socket_id = UCC_SOCKET_ID_INVALID;
     ucc_local_proc.numa_id   = UCC_NUMA_ID_INVALID;
+    ucc_local_proc.rack_id   = UCC_RACK_ID_INVALID;
 
     if (UCC_OK != ucc_get_bound_socket_id(&ucc_local_proc.socket_id)) {
         ucc_debug("failed to get bound socket id");
@@ -312,3 +314,55 @@ ucc_status_t ucc_local_proc_info_init()
 
     return UCC_OK;
 }
+
+#define UCC_TOPO_FILE_MAX_LINE 1024
+
+ucc_status_t ucc_proc_info_parse_topo_file(const char           *filename,
+                                           const char           *hostname,
+                                           ucc_topo_file_level_t level,
+                                           ucc_rack_id_t        *rack_id)
+{
+    ucc_status_t status = UCC_ERR_NOT_FOUND;
+    char         line[UCC_TOPO_FILE_MAX_LINE];
+    char        *saveptr, *host, *col, *dot;
+    FILE        *f;
+    int          i;
+
+    f = fopen(filename, "r");
+    if (!f) {
+        ucc_warn("failed to open topology file %s: %s", filename,
+                 strerror(errno));
+        return UCC_ERR_NO_RESOURCE;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        host = strtok_r(line, " \t\r\n", &saveptr);
+        if (!host || host[0] == '#') {
+            continue;
+        }
+        /* hostnames are compared without domain, as ucc_hostname() */
+        dot = strchr(host, '.');
+        if (dot) {
+            *dot = '\0';
+        }
+        if (strcmp(host, hostname)) {
+            continue;
+        }
+        col = NULL;
+        for (i = 0; i <= level; i++) {
+            col = strtok_r(NULL, " \t\r\n", &saveptr);
+            if (!col) {
+                break;
+            }
+        }
+        if (col) {
+            *rack_id = ucc_str_hash_djb2(col);
+            status   = UCC_OK;
+        } else {
+            ucc_warn("topology file %s: host %s has no column %d", filename,
+                     hostname, level + 1);
+        }
+        break;
+    }
+    fclose(f);
+    return status;
+}
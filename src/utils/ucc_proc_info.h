@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -13,18 +13,30 @@
 typedef uint64_t ucc_host_id_t;
 typedef uint8_t  ucc_socket_id_t;
 typedef uint8_t  ucc_numa_id_t;
+typedef uint64_t ucc_rack_id_t;
 
 #define UCC_SOCKET_ID_INVALID ((ucc_socket_id_t)-1)
 #define UCC_NUMA_ID_INVALID   ((ucc_numa_id_t)-1)
+#define UCC_RACK_ID_INVALID   ((ucc_rack_id_t)-1)
 
 #define UCC_MAX_SOCKET_ID (UCC_SOCKET_ID_INVALID - 1)
 #define UCC_MAX_NUMA_ID   (UCC_NUMA_ID_INVALID - 1)
 
+/* Column of the topology file used as the rack id of a host */
+typedef enum ucc_topo_file_level {
+    UCC_TOPO_FILE_LEVEL_SWITCH,
+    UCC_TOPO_FILE_LEVEL_RACK,
+    UCC_TOPO_FILE_LEVEL_POD,
+    UCC_TOPO_FILE_LEVEL_LAST
+} ucc_topo_file_level_t;
+
 typedef struct ucc_proc_info {
     ucc_host_id_t   host_hash;
     ucc_socket_id_t socket_id;
     ucc_numa_id_t   numa_id;
     ucc_host_id_t   host_id;
+    ucc_rack_id_t   rack_id; /*< group of hosts sharing a network level, from
+                                 UCC_TOPO_FILE */
     pid_t           pid;
 } ucc_proc_info_t;
 
@@ -36,6 +48,16 @@ extern ucc_proc_info_t ucc_local_proc;
 
 ucc_status_t ucc_local_proc_info_init();
 
+/* Looks up "hostname" in the topology file. Each line of the file is
+       <hostname> <switch> [<rack> [<pod>]]
+   empty lines and lines starting with '#' are skipped. The rack id is the
+   hash of the column selected by "level". Returns UCC_ERR_NOT_FOUND if the
+   host or its column is not in the file. */
+ucc_status_t ucc_proc_info_parse_topo_file(const char           *filename,
+                                           const char           *hostname,
+                                           ucc_topo_file_level_t level,
+                                           ucc_rack_id_t        *rack_id);
+
 uint64_t ucc_get_system_id();
 
 const char*  ucc_hostname();
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -7,9 +7,11 @@
 #include "common/test_ucc.h"
 #include "utils/ucc_math.h"
 
+#include <algorithm>
+
 using Param_0 = std::tuple<int, ucc_datatype_t, ucc_memory_type_t, int, gtest_ucc_inplace_t>;
 using Param_1 = std::tuple<ucc_datatype_t, ucc_memory_type_t, int, gtest_ucc_inplace_t>;
-using Param_2 = std::tuple<ucc_datatype_t, ucc_memory_type_t, int, gtest_ucc_inplace_t, std::string>;
+using Param_2 = std::tuple<ucc_datatype_t, ucc_memory_type_t, int, gtest_ucc_inplace_t, ucc_job_env_t>;
 
 class test_allgather : public UccCollArgs, public ucc::test
 {
@@ -263,12 +265,17 @@ UCC_TEST_P(test_allgather_alg, alg)
     const ucc_memory_type_t   mem_type = std::get<1>(GetParam());
     const int                 count    = std::get<2>(GetParam());
     const gtest_ucc_inplace_t inplace  = std::get<3>(GetParam());
+    const ucc_job_env_t       env      = std::get<4>(GetParam());
     int                       n_procs  = 5;
-    char                      tune[32];
+    int                       repeat   = 2;
+
+    if (mem_type != UCC_MEMORY_TYPE_HOST &&
+        std::find_if(env.begin(), env.end(), [](const ucc_env_var_t &v) {
+            return v.first == "UCC_CL_HIER_TUNE";
+        }) != env.end()) {
+        GTEST_SKIP();
+    }
 
-    sprintf(tune, "allgather:@%s:inf", std::get<4>(GetParam()).c_str());
-    ucc_job_env_t env     = {{"UCC_CL_BASIC_TUNE", "inf"},
-                             {"UCC_TL_UCP_TUNE", tune}};
     UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
     UccTeam_h     team    = job.create_team(n_procs);
     UccCollCtxVec ctxs;
@@ -276,14 +283,62 @@ UCC_TEST_P(test_allgather_alg, alg)
     set_inplace(inplace);
     SET_MEM_TYPE(mem_type);
 
-    data_init(n_procs, dtype, count, ctxs, false);
+    data_init(n_procs, dtype, count, ctxs, true);
     UccReq    req(team, ctxs);
-    req.start();
-    req.wait();
-    EXPECT_EQ(true, data_validate(ctxs));
+    for (auto i = 0; i < repeat; i++) {
+        req.start();
+        req.wait();
+        EXPECT_EQ(true, data_validate(ctxs));
+        reset(ctxs);
+    }
     data_fini(ctxs);
 }
 
+ucc_job_env_t allgather_knomial_env = {
+    {"name", "knomial"},
+    {"UCC_CL_BASIC_TUNE", "inf"},
+    {"UCC_TL_UCP_TUNE", "allgather:@knomial:inf"}};
+
+ucc_job_env_t allgather_ring_env = {
+    {"name", "ring"},
+    {"UCC_CL_BASIC_TUNE", "inf"},
+    {"UCC_TL_UCP_TUNE", "allgather:@ring:inf"}};
+
+ucc_job_env_t allgather_neighbor_env = {
+    {"name", "neighbor"},
+    {"UCC_CL_BASIC_TUNE", "inf"},
+    {"UCC_TL_UCP_TUNE", "allgather:@neighbor:inf"}};
+
+ucc_job_env_t allgather_bruck_env = {
+    {"name", "bruck"},
+    {"UCC_CL_BASIC_TUNE", "inf"},
+    {"UCC_TL_UCP_TUNE", "allgather:@bruck:inf"}};
+
+ucc_job_env_t allgather_sparbit_env = {
+    {"name", "sparbit"},
+    {"UCC_CL_BASIC_TUNE", "inf"},
+    {"UCC_TL_UCP_TUNE", "allgather:@sparbit:inf"}};
+
+ucc_job_env_t allgather_gab_env = {
+    {"name", "gab"},
+    {"UCC_CL_HIER_TUNE", "allgather:@gab:0-inf:inf"},
+    {"UCC_CLS", "all"}};
+
+/* 3K fragments split the message into fragments of different counts */
+ucc_job_env_t allgather_gab_pipelined_env = {
+    {"name", "gab_pipelined"},
+    {"UCC_CL_HIER_TUNE", "allgather:@gab:0-inf:inf"},
+    {"UCC_CL_HIER_ALLGATHER_GAB_PIPELINE", "thresh=0:fragsize=3K:pdepth=2"},
+    {"UCC_CLS", "all"}};
+
+/* knomial gatherv is reposted with counts of different fragments */
+ucc_job_env_t allgather_gab_pipelined_kn_env = {
+    {"name", "gab_pipelined_kn"},
+    {"UCC_CL_HIER_TUNE", "allgather:@gab:0-inf:inf"},
+    {"UCC_CL_HIER_ALLGATHER_GAB_PIPELINE", "thresh=0:fragsize=3K:pdepth=2"},
+    {"UCC_TL_UCP_TUNE", "gatherv:@knomial:inf"},
+    {"UCC_CLS", "all"}};
+
 INSTANTIATE_TEST_CASE_P(
     , test_allgather_alg,
     ::testing::Combine(
@@ -296,13 +351,17 @@ INSTANTIATE_TEST_CASE_P(
 #endif
         ::testing::Values(1,3,8192), // count
         ::testing::Values(TEST_INPLACE, TEST_NO_INPLACE),
-        ::testing::Values("knomial", "ring", "neighbor", "bruck", "sparbit")),
+        ::testing::Values(allgather_knomial_env, allgather_ring_env,
+                          allgather_neighbor_env, allgather_bruck_env,
+                          allgather_sparbit_env, allgather_gab_env,
+                          allgather_gab_pipelined_env,
+                          allgather_gab_pipelined_kn_env)),
         [](const testing::TestParamInfo<test_allgather_alg::ParamType>& info) {
             std::string name;
             name += ucc_datatype_str(std::get<0>(info.param));
             name += std::string("_") + std::string(ucc_mem_type_str(std::get<1>(info.param)));
             name += std::string("_count_")+std::to_string(std::get<2>(info.param));
             name += std::string("_inplace_")+std::to_string(std::get<3>(info.param));
-            name += std::string("_")+std::get<4>(info.param);
+            name += std::string("_")+std::get<4>(info.param)[0].second;
             return name;
         });
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -305,7 +305,9 @@ UCC_TEST_P(test_allgatherv_alg, alg)
     const int                 count    = std::get<2>(GetParam());
     const gtest_ucc_inplace_t inplace  = std::get<3>(GetParam());
     const bool                contig   = std::get<5>(GetParam());
-    int                       n_procs  = 5;
+    /* neighbor exchange falls back to ring on odd team size */
+    int                       n_procs  =
+        (std::get<4>(GetParam()) == "neighbor") ? 6 : 5;
     char                      tune[32];
 
     sprintf(tune, "allgatherv:@%s:inf", std::get<4>(GetParam()).c_str());
@@ -339,7 +341,8 @@ INSTANTIATE_TEST_CASE_P(
 #endif
         ::testing::Values(1,3,8192), // count
         ::testing::Values(TEST_INPLACE, TEST_NO_INPLACE),
-        ::testing::Values("knomial", "ring"),
+        ::testing::Values("knomial", "ring", "neighbor", "bruck", "sparbit",
+                          "auto"),
         ::testing::Bool()), // dst buf contig
         [](const testing::TestParamInfo<test_allgatherv_alg::ParamType>& info) {
             std::string name;
@@ -352,3 +355,36 @@ INSTANTIATE_TEST_CASE_P(
             return name;
         }
     );
+
+UCC_TEST_F(test_allgatherv, auto_branches)
+{
+    /* block counts are (n_procs - rank) * count, so the largest block times
+       team size is always within 2x of the total: imbalance 1 selects
+       sparbit, imbalance 4 selects neighbor on even and ring on odd teams */
+    for (auto imbalance : {"1", "4"}) {
+        ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "allgatherv:@auto:inf"},
+                             {"UCC_TL_UCP_ALLGATHERV_AUTO_SMALL_THRESH", "0"},
+                             {"UCC_TL_UCP_ALLGATHERV_AUTO_IMBALANCE",
+                              imbalance}};
+        for (auto n_procs : {5, 6}) {
+            UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+            UccTeam_h     team = job.create_team(n_procs);
+            UccCollCtxVec ctxs;
+
+            for (auto count : {1, 8192}) {
+                for (auto contig : {true, false}) {
+                    set_inplace(TEST_NO_INPLACE);
+                    set_contig(contig);
+                    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+                    data_init(n_procs, UCC_DT_INT32, count, ctxs, false);
+                    UccReq req(team, ctxs);
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, data_validate(ctxs));
+                    data_fini(ctxs);
+                }
+            }
+        }
+    }
+}
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -368,6 +368,88 @@ TYPED_TEST(test_allreduce_alg, dbt) {
     }
 }
 
+TYPED_TEST(test_allreduce_alg, rd_swing) {
+    int n_procs = 15;
+
+    for (auto alg : {"allreduce:@rd:inf", "allreduce:@swing:inf"}) {
+        ucc_job_env_t env  = {{"UCC_CL_BASIC_TUNE", "inf"},
+                              {"UCC_TL_UCP_TUNE", alg}};
+        UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+        int           repeat = 3;
+        UccCollCtxVec ctxs;
+
+        /* non power of 2 and power of 2 teams, counts up to and above the
+           4k scratch taken from the context mpool */
+        int scratch_max = 4096 / ucc_dt_size(TypeParam::dt);
+
+        for (auto team_size : {15, 8, 2}) {
+            UccTeam_h team = job.create_team(team_size);
+
+            for (auto count : {1, 8, 32, scratch_max, scratch_max + 1}) {
+                for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+                    this->set_inplace(inplace);
+                    this->data_init(team_size, TypeParam::dt, count, ctxs,
+                                    true);
+                    UccReq req(team, ctxs);
+
+                    for (auto i = 0; i < repeat; i++) {
+                        req.start();
+                        req.wait();
+                        EXPECT_EQ(true, this->data_validate(ctxs));
+                        this->reset(ctxs);
+                    }
+                    this->data_fini(ctxs);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(test_allreduce_alg, ring) {
+    int           n_procs = 15;
+    ucc_job_env_t env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "allreduce:@ring:inf"},
+                             {"UCC_TL_UCP_ALLREDUCE_RING_FRAG_SIZE", "4k"}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team   = job.create_team(n_procs);
+    int           repeat = 3;
+    UccCollCtxVec ctxs;
+    std::vector<ucc_memory_type_t> mt = {UCC_MEMORY_TYPE_HOST};
+
+    if (UCC_OK == ucc_mc_available(UCC_MEMORY_TYPE_CUDA)) {
+        mt.push_back(UCC_MEMORY_TYPE_CUDA);
+    }
+    if (UCC_OK == ucc_mc_available( UCC_MEMORY_TYPE_CUDA_MANAGED)) {
+        mt.push_back( UCC_MEMORY_TYPE_CUDA_MANAGED);
+    }
+
+    /* single ring, bidirectional with 1 fragment per block and with
+       multiple uneven fragments. The last count makes the block of the
+       first ring 1 element bigger than the 4k fragment and the block of the
+       second one exactly 4k, so the rings have different fragment counts */
+    int boundary = 2 * n_procs * (4096 / ucc_dt_size(TypeParam::dt)) + 1;
+
+    for (auto count : {20, 1000, 123567, boundary}) {
+        for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+            for (auto m : mt) {
+                SET_MEM_TYPE(m);
+                this->set_inplace(inplace);
+                this->data_init(n_procs, TypeParam::dt, count, ctxs, true);
+                UccReq req(team, ctxs);
+
+                for (auto i = 0; i < repeat; i++) {
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, this->data_validate(ctxs));
+                    this->reset(ctxs);
+                }
+                this->data_fini(ctxs);
+            }
+        }
+    }
+}
+
 TYPED_TEST(test_allreduce_alg, rab) {
     int           n_procs = 15;
     ucc_job_env_t env     = {{"UCC_CL_HIER_TUNE", "allreduce:@rab:0-inf:inf"},
@@ -402,6 +484,56 @@ TYPED_TEST(test_allreduce_alg, rab) {
     }
 }
 
+TYPED_TEST(test_allreduce_alg, rab_node_split) {
+    int           n_procs = 15;
+    ucc_job_env_t env     = {{"UCC_CL_HIER_TUNE", "allreduce:@rab:0-inf:inf"},
+                             {"UCC_CL_HIER_NODE_SPLIT", "socket"},
+                             {"UCC_CLS", "all"}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team   = job.create_team(n_procs);
+    UccCollCtxVec ctxs;
+
+    for (auto count : {8, 65536}) {
+        for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+            SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+            this->set_inplace(inplace);
+            this->data_init(n_procs, TypeParam::dt, count, ctxs, true);
+            UccReq req(team, ctxs);
+            req.start();
+            req.wait();
+            EXPECT_EQ(true, this->data_validate(ctxs));
+            this->data_fini(ctxs);
+        }
+    }
+}
+
+TYPED_TEST(test_allreduce_alg, rab_racks) {
+    ucc_job_env_t env = {{"UCC_CL_HIER_TUNE", "allreduce:@rab:0-inf:inf"},
+                         {"UCC_CLS", "all"}};
+    UccCollCtxVec ctxs;
+
+    /* {n_procs, n_nodes, n_racks}: 3 nodes in 2 racks leave a single node
+       rack */
+    for (auto &t : std::vector<std::array<int, 3>>{{16, 4, 2}, {15, 3, 2}}) {
+        int    n_procs = t[0];
+        UccJob job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env, t[1], t[2]);
+        UccTeam_h team = job.create_team(n_procs);
+
+        for (auto count : {8, 65536}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+                this->set_inplace(inplace);
+                this->data_init(n_procs, TypeParam::dt, count, ctxs, false);
+                UccReq req(team, ctxs);
+                req.start();
+                req.wait();
+                EXPECT_EQ(true, this->data_validate(ctxs));
+                this->data_fini(ctxs);
+            }
+        }
+    }
+}
+
 TYPED_TEST(test_allreduce_alg, rab_pipelined) {
     int           n_procs = 15;
     ucc_job_env_t env     = {{"UCC_CL_HIER_TUNE", "allreduce:@rab:0-inf:inf"},
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -332,3 +332,106 @@ INSTANTIATE_TEST_CASE_P(
 #endif
         ::testing::Values(/*TEST_INPLACE,*/ TEST_NO_INPLACE),
         ::testing::Values(1,3,8192))); // count
+
+UCC_TEST_F(test_alltoall, node_aggr)
+{
+    const int     n_procs = 15;
+    ucc_job_env_t env     = {{"UCC_CL_HIER_TUNE", "alltoall:@node_aggr:inf"},
+                             {"UCC_CLS", "all"}};
+
+    /* uneven nodes and a node per rank: no NODE sbgp */
+    for (auto n_nodes : {2, 4, n_procs}) {
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env, n_nodes);
+        UccTeam_h team = job.create_team(n_procs);
+
+        for (auto count : {1, 7}) {
+            UccCollCtxVec ctxs;
+
+            SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+            data_init(n_procs, UCC_DT_INT32, count, ctxs, true);
+            UccReq req(team, ctxs);
+            for (auto i = 0; i < 2; i++) {
+                req.start();
+                req.wait();
+                EXPECT_EQ(true, data_validate(ctxs));
+                reset(ctxs);
+            }
+            data_fini(ctxs);
+        }
+    }
+}
+
+class test_alltoall_dyn_segs : public ucc::test {
+  public:
+    static const int n_procs = 4;
+    ucc_job_env_t    env = {{"UCC_TL_UCP_TUNE", "alltoall:0-inf:@onesided"}};
+
+    /* One-sided alltoall on buffers that are not mapped through context
+       mem_params: flags field is set but MEM_MAPPED_BUFFERS is not */
+    void run(UccTeam_h team, size_t count, int round)
+    {
+        std::vector<std::vector<int32_t>> src(n_procs), dst(n_procs);
+        std::vector<long>                 work(n_procs, 0);
+        std::vector<ucc_coll_req_h>       reqs(n_procs);
+        ucc_coll_args_t                   args;
+        ucc_status_t                      st;
+        size_t                            i, j;
+
+        for (i = 0; i < n_procs; i++) {
+            src[i].resize(count * n_procs);
+            dst[i].assign(count * n_procs, -1);
+            for (j = 0; j < count * n_procs; j++) {
+                src[i][j] = (int32_t)(i * 1000 + j / count + round);
+            }
+            memset(&args, 0, sizeof(args));
+            args.mask                = UCC_COLL_ARGS_FIELD_FLAGS |
+                                       UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER;
+            args.flags               = 0;
+            args.coll_type           = UCC_COLL_TYPE_ALLTOALL;
+            args.src.info.buffer     = src[i].data();
+            args.src.info.count      = count * n_procs;
+            args.src.info.datatype   = UCC_DT_INT32;
+            args.src.info.mem_type   = UCC_MEMORY_TYPE_HOST;
+            args.dst.info.buffer     = dst[i].data();
+            args.dst.info.count      = count * n_procs;
+            args.dst.info.datatype   = UCC_DT_INT32;
+            args.dst.info.mem_type   = UCC_MEMORY_TYPE_HOST;
+            args.global_work_buffer  = &work[i];
+            EXPECT_EQ(UCC_OK, ucc_collective_init(&args, &reqs[i],
+                                                  team->procs[i].team));
+        }
+        for (auto r : reqs) {
+            EXPECT_EQ(UCC_OK, ucc_collective_post(r));
+        }
+        do {
+            team->progress();
+            st = UCC_OK;
+            for (auto r : reqs) {
+                if (ucc_collective_test(r) != UCC_OK) {
+                    st = UCC_INPROGRESS;
+                }
+            }
+        } while (st == UCC_INPROGRESS);
+
+        for (i = 0; i < n_procs; i++) {
+            for (j = 0; j < count * n_procs; j++) {
+                EXPECT_EQ((int32_t)((j / count) * 1000 + i + round),
+                          dst[i][j]);
+            }
+            EXPECT_EQ(0, work[i]);
+            EXPECT_EQ(UCC_OK, ucc_collective_finalize(reqs[i]));
+        }
+    }
+};
+
+UCC_TEST_F(test_alltoall_dyn_segs, unmapped_buffers)
+{
+    UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h team = job.create_team(n_procs);
+
+    /* repeated calls hit registration and rkey caches */
+    for (int round = 0; round < 3; round++) {
+        run(team, 16, round);
+    }
+    run(team, 1024, 3);
+}
@@ -294,6 +294,30 @@ UCC_TEST_P(test_alltoallv_alg, hybrid)
     data_fini(ctxs);
 }
 
+UCC_TEST_P(test_alltoallv_alg, node_aggr)
+{
+    int                  n_procs  = 15;
+    ucc_memory_type_t    mem_type = std::get<0>(GetParam());
+    gtest_ucc_inplace_t  inplace  = std::get<1>(GetParam());
+    const ucc_datatype_t dtype    = std::get<2>(GetParam());
+
+    ASSERT_NE(inplace, TEST_INPLACE);
+    ucc_job_env_t env     = {{"UCC_CL_HIER_TUNE", "alltoallv:@node_aggr:inf"},
+                             {"UCC_CLS", "all"}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team    = job.create_team(n_procs);
+    UccCollCtxVec ctxs;
+
+    SET_MEM_TYPE(mem_type);
+    data_init(n_procs, dtype, 16, ctxs, false);
+    UccReq req(team, ctxs);
+    req.start();
+    req.wait();
+
+    EXPECT_EQ(true, data_validate(ctxs));
+    data_fini(ctxs);
+}
+
 UCC_TEST_P(test_alltoallv_2, multiple)
 {
     ucc_memory_type_t           mem_type = std::get<0>(GetParam());
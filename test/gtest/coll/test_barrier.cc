@@ -1,10 +1,11 @@
 
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
 #include "common/test_ucc.h"
+#include <array>
 
 class test_barrier : public ucc::test
 {
@@ -41,3 +42,51 @@ UCC_TEST_F(test_barrier, multiple)
     UccReq::startall(reqs);
     UccReq::waitall(reqs);
 }
+
+class test_barrier_alg : public test_barrier,
+                         public ::testing::WithParamInterface<std::string>
+{};
+
+UCC_TEST_P(test_barrier_alg, multiple)
+{
+    int           n_procs = 15;
+    std::string   alg     = "barrier:@" + GetParam() + ":inf";
+    ucc_job_env_t env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", alg}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+
+    /* power of 2 and non power of 2 teams, repeated to check that
+       consecutive barriers do not mix up */
+    for (auto team_size : {15, 8, 5, 2}) {
+        UccTeam_h team = job.create_team(team_size);
+        UccReq    req(team, &coll);
+
+        for (int i = 0; i < 3; i++) {
+            req.start();
+            req.wait();
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_barrier_alg,
+                        ::testing::Values("knomial", "dissemination",
+                                          "tournament"));
+
+UCC_TEST_F(test_barrier, hier_racks)
+{
+    ucc_job_env_t env = {{"UCC_CL_HIER_TUNE", "barrier:inf"},
+                         {"UCC_CLS", "all"}};
+
+    /* {n_procs, n_nodes, n_racks}: 3 nodes in 2 racks leave a single node
+       rack */
+    for (auto &t : std::vector<std::array<int, 3>>{{16, 4, 2}, {15, 3, 2}}) {
+        UccJob    job(t[0], UccJob::UCC_JOB_CTX_GLOBAL, env, t[1], t[2]);
+        UccTeam_h team = job.create_team(t[0]);
+        UccReq    req(team, &coll);
+
+        for (int i = 0; i < 3; i++) {
+            req.start();
+            req.wait();
+        }
+    }
+}
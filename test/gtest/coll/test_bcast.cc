@@ -5,6 +5,7 @@
 
 #include "common/test_ucc.h"
 #include "utils/ucc_math.h"
+#include <array>
 
 using Param_0 = std::tuple<int, ucc_datatype_t, ucc_memory_type_t, int, int>;
 using Param_1 = std::tuple<ucc_datatype_t, ucc_memory_type_t, int, int>;
@@ -276,6 +277,23 @@ ucc_job_env_t two_step_env = {{"UCC_CL_HIER_TUNE", "bcast:@2step:0-inf:inf"},
                               {"UCC_CLS", "all"}};
 ucc_job_env_t dbt_env      = {{"UCC_TL_UCP_TUNE", "bcast:@dbt:0-inf:inf"},
                               {"UCC_CLS", "basic"}};
+ucc_job_env_t chain_env    = {{"UCC_TL_UCP_TUNE", "bcast:@chain:0-inf:inf"},
+                              {"UCC_TL_UCP_BCAST_CHAIN_PIPELINE",
+                               "thresh=0:fragsize=1K:nfrags=1:pdepth=2:parallel"},
+                              {"UCC_CLS", "basic"}};
+ucc_job_env_t chain_deep_env = {{"UCC_TL_UCP_TUNE", "bcast:@chain:0-inf:inf"},
+                                {"UCC_TL_UCP_BCAST_CHAIN_PIPELINE",
+                                 "thresh=0:fragsize=1K:nfrags=1:pdepth=16:parallel"},
+                                {"UCC_CLS", "basic"}};
+ucc_job_env_t sag_ring_env = {{"UCC_TL_UCP_TUNE", "bcast:@sag_ring:0-inf:inf"},
+                              {"UCC_TL_UCP_BCAST_SAG_RING_PIPELINE",
+                               "thresh=0:fragsize=4K:nfrags=1:pdepth=3:ordered"},
+                              {"UCC_CLS", "basic"}};
+ucc_job_env_t two_step_chain_env = {{"UCC_CL_HIER_TUNE", "bcast:@2step:0-inf:inf"},
+                                    {"UCC_TL_UCP_TUNE", "bcast:@chain:0-inf:inf"},
+                                    {"UCC_TL_UCP_BCAST_CHAIN_PIPELINE",
+                                     "thresh=0:fragsize=1K:nfrags=1:pdepth=2:parallel"},
+                                    {"UCC_CLS", "all"}};
 ucc_job_env_t cuda_env     = {{"UCC_TL_CUDA_TUNE", "bcast:cuda:@0:0-inf:inf"},
                               {"UCC_CLS", "basic"}};
 ucc_job_env_t host_mcast_env = {{"UCC_TLS", "ucp,mlx5"},
@@ -314,11 +332,42 @@ INSTANTIATE_TEST_CASE_P(
 #ifdef HAVE_CUDA
         ::testing::Values(UCC_MEMORY_TYPE_HOST, UCC_MEMORY_TYPE_CUDA,
                           UCC_MEMORY_TYPE_CUDA_MANAGED),
-        ::testing::Values(two_step_env, dbt_env, cuda_env, host_mcast_env, host_mcast_rel_env,
-                          cuda_mcast_env, cuda_mcast_rel_env), //env
+        ::testing::Values(two_step_env, dbt_env, chain_env, chain_deep_env,
+                          sag_ring_env,
+                          two_step_chain_env, cuda_env, host_mcast_env,
+                          host_mcast_rel_env, cuda_mcast_env,
+                          cuda_mcast_rel_env), //env
 #else
         ::testing::Values(UCC_MEMORY_TYPE_HOST),
-        ::testing::Values(two_step_env, dbt_env, host_mcast_env, host_mcast_rel_env), //env
+        ::testing::Values(two_step_env, dbt_env, chain_env, chain_deep_env,
+                          sag_ring_env,
+                          two_step_chain_env, host_mcast_env,
+                          host_mcast_rel_env), //env
 #endif
         ::testing::Values(8, 65536), // count
         ::testing::Values(15, 16))); // n_procs
+
+UCC_TEST_F(test_bcast, 2step_racks)
+{
+    UccCollCtxVec ctxs;
+
+    /* {n_procs, n_nodes, n_racks}: 3 nodes in 2 racks leave a single node
+       rack */
+    for (auto &t : std::vector<std::array<int, 3>>{{16, 4, 2}, {15, 3, 2}}) {
+        int       n_procs = t[0];
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, two_step_env, t[1],
+                      t[2]);
+        UccTeam_h team = job.create_team(n_procs);
+
+        for (int root = 0; root < n_procs; root++) {
+            this->set_root(root);
+            this->data_init(n_procs, UCC_DT_INT8, 65536, ctxs, false);
+            UccReq req(team, ctxs);
+
+            req.start();
+            req.wait();
+            EXPECT_EQ(true, this->data_validate(ctxs));
+            this->data_fini(ctxs);
+        }
+    }
+}
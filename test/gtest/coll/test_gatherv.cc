@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2023-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -10,6 +10,8 @@ using Param_0 = std::tuple<int, ucc_datatype_t, ucc_memory_type_t, int, int,
                            gtest_ucc_inplace_t>;
 using Param_1 = std::tuple<ucc_datatype_t, ucc_memory_type_t, int, int,
                            gtest_ucc_inplace_t>;
+using Param_2 = std::tuple<std::string, int, ucc_datatype_t, int, int,
+                           gtest_ucc_inplace_t>;
 
 class test_gatherv : public UccCollArgs, public ucc::test {
   private:
@@ -170,6 +172,19 @@ class test_gatherv : public UccCollArgs, public ucc::test {
     {
         root = _root;
     }
+    /* blocks of the ranks are placed in the reverse order */
+    void reverse_displacements(UccCollCtxVec ctxs)
+    {
+        ucc_coll_args_t *coll   = ctxs[root]->args;
+        int             *counts = (int *)coll->dst.info_v.counts;
+        int             *displs = (int *)coll->dst.info_v.displacements;
+        int              offset = 0;
+
+        for (int i = ctxs.size() - 1; i >= 0; i--) {
+            displs[i] = offset;
+            offset   += counts[i];
+        }
+    }
 };
 
 class test_gatherv_0 : public test_gatherv,
@@ -307,3 +322,88 @@ INSTANTIATE_TEST_CASE_P(
                        ::testing::Values(1, 3, 8192), // count
                        ::testing::Values(0, 1),       // root
                        ::testing::Values(TEST_INPLACE, TEST_NO_INPLACE)));
+
+UCC_TEST_F(test_gatherv, knomial_repost_displacements)
+{
+    /* radix 4 tree over 10 ranks: with contiguous displacements root
+       receives all the subtrees directly into user buffer and needs no
+       scratch, reversed ones make every subtree go through scratch */
+    int           n_procs = 10;
+    ucc_job_env_t env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "gatherv:@knomial:inf"}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team = job.create_team(n_procs);
+    UccCollCtxVec ctxs;
+
+    set_inplace(TEST_NO_INPLACE);
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    set_root(0);
+
+    data_init(n_procs, UCC_DT_INT32, 3, ctxs, true);
+    UccReq req(team, ctxs);
+    for (auto i = 0; i < 3; i++) {
+        if (i == 1) {
+            reverse_displacements(ctxs);
+        }
+        req.start();
+        req.wait();
+        EXPECT_EQ(true, data_validate(ctxs));
+        reset(ctxs);
+    }
+    data_fini(ctxs);
+}
+
+class test_gatherv_alg : public test_gatherv,
+                       public ::testing::WithParamInterface<Param_2> {
+};
+
+UCC_TEST_P(test_gatherv_alg, alg)
+{
+    const std::string         alg     = std::get<0>(GetParam());
+    const int                 n_frags = std::get<1>(GetParam());
+    const ucc_datatype_t      dtype   = std::get<2>(GetParam());
+    const int                 count   = std::get<3>(GetParam());
+    const int                 root    = std::get<4>(GetParam());
+    const gtest_ucc_inplace_t inplace = std::get<5>(GetParam());
+    /* radix 4 tree over 10 ranks has both leaves and intermediate ranks */
+    int                       n_procs = 10;
+    std::string               tune    = "gatherv:@" + alg + ":inf";
+    ucc_job_env_t             env     = {
+        {"UCC_CL_BASIC_TUNE", "inf"},
+        {"UCC_TL_UCP_TUNE", tune},
+        {"UCC_TL_UCP_GATHERV_KN_NUM_FRAGS", std::to_string(n_frags)}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team = job.create_team(n_procs);
+    UccCollCtxVec ctxs;
+
+    set_inplace(inplace);
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    set_root(root);
+
+    data_init(n_procs, dtype, count, ctxs, false);
+    UccReq req(team, ctxs);
+    req.start();
+    req.wait();
+    EXPECT_EQ(true, data_validate(ctxs));
+    data_fini(ctxs);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_gatherv_alg,
+    ::testing::Combine(::testing::Values("linear", "knomial"),
+                       ::testing::Values(1, 3),                 // n_frags
+                       ::testing::Values(UCC_DT_INT8, UCC_DT_FLOAT64),
+                       ::testing::Values(1, 3, 8192),           // count
+                       ::testing::Values(0, 7),                 // root
+                       ::testing::Values(TEST_INPLACE, TEST_NO_INPLACE)),
+    [](const testing::TestParamInfo<test_gatherv_alg::ParamType> &info) {
+        std::string name;
+        name += std::get<0>(info.param);
+        name += std::string("_frags_") + std::to_string(std::get<1>(info.param));
+        name += std::string("_") + ucc_datatype_str(std::get<2>(info.param));
+        name += std::string("_count_") + std::to_string(std::get<3>(info.param));
+        name += std::string("_root_") + std::to_string(std::get<4>(info.param));
+        name += std::string("_inplace_") +
+                std::to_string(std::get<5>(info.param));
+        return name;
+    });
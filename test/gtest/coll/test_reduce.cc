@@ -290,8 +290,13 @@ template <typename T> class test_reduce_srg : public test_reduce<T> {
 };
 
 #define TEST_DECLARE_WITH_ENV(_env, _n_procs, _persistent)                     \
+    TEST_DECLARE_WITH_ENV_TOPO(_env, _n_procs, _persistent, 2, 0)
+
+#define TEST_DECLARE_WITH_ENV_TOPO(_env, _n_procs, _persistent, _n_nodes,      \
+                                   _n_racks)                                   \
     {                                                                          \
-        UccJob        job(_n_procs, UccJob::UCC_JOB_CTX_GLOBAL, _env);         \
+        UccJob        job(_n_procs, UccJob::UCC_JOB_CTX_GLOBAL, _env,          \
+                          _n_nodes, _n_racks);                                 \
         UccTeam_h     team   = job.create_team(_n_procs);                      \
         int           repeat = _persistent ? 3 : 1;                            \
         UccCollCtxVec ctxs;                                                    \
@@ -352,6 +357,12 @@ TYPED_TEST(test_reduce_2step, 2step) {
     TEST_DECLARE_WITH_ENV(reduce_2step_env, 16, false);
 }
 
+TYPED_TEST(test_reduce_2step, 2step_racks) {
+    TEST_DECLARE_WITH_ENV_TOPO(reduce_2step_env, 16, false, 4, 2);
+    /* 3 nodes in 2 racks leave a single node rack */
+    TEST_DECLARE_WITH_ENV_TOPO(reduce_2step_env, 15, false, 3, 2);
+}
+
 TYPED_TEST(test_reduce_srg, srg) {
     TEST_DECLARE_WITH_ENV(reduce_srg_env, 15, false);
 }
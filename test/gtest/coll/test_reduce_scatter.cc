@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -374,10 +374,65 @@ ucc_job_env_t knomial = {{"name", "knomial"},
                          {"UCC_CL_BASIC_TUNE", "inf"},
                          {"UCC_TL_UCP_TUNE", "reduce_scatter:@knomial:inf"}};
 
+ucc_job_env_t rrs_env = {{"name", "rrs"},
+                         {"UCC_CL_HIER_TUNE", "reduce_scatter:@rrs:0-inf:inf"},
+                         {"UCC_CLS", "all"}};
+
+ucc_job_env_t rrs_pipelined_env = {
+    {"name", "rrs_pipelined"},
+    {"UCC_CL_HIER_TUNE", "reduce_scatter:@rrs:0-inf:inf"},
+    {"UCC_CL_HIER_REDUCE_SCATTER_RRS_PIPELINE",
+     "thresh=0:fragsize=64K:pdepth=2"},
+    {"UCC_CLS", "all"}};
+
+/* 9 nodes make the node leaders team large enough for knomial
+   reduce_scatterv, with small fragments the leaders of the last nodes have
+   no data in the first fragments and all the data in the last ones */
+UCC_TEST_F(test_reduce_scatter_alg, rrs_pipelined_many_nodes)
+{
+    test_reduce_scatter<TypeOpPair<UCC_DT_INT32, sum>> rs_test;
+    const int                                          n_nodes = 9;
+    const int                                          ppn     = 32;
+    int                                                n_procs =
+        n_nodes * ppn;
+    int                                                repeat  = 2;
+    UccCollCtxVec                                      ctxs;
+
+    for (auto tl_tune : {"reduce_scatterv:@knomial:inf",
+                         "reduce_scatterv:@auto:inf"}) {
+        ucc_job_env_t env = {
+            {"UCC_CL_HIER_TUNE", "reduce_scatter:@rrs:0-inf:inf"},
+            {"UCC_CL_HIER_REDUCE_SCATTER_RRS_PIPELINE",
+             "thresh=0:fragsize=4K:pdepth=2"},
+            {"UCC_TL_UCP_TUNE", tl_tune},
+            {"UCC_CLS", "all"}};
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env, n_nodes);
+        UccTeam_h team = job.create_team(n_procs);
+
+        for (auto count : {n_procs * 64, n_procs * 1024}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                rs_test.set_mem_type(UCC_MEMORY_TYPE_HOST);
+                rs_test.set_inplace(inplace);
+                rs_test.data_init(n_procs, UCC_DT_INT32, count, ctxs, true);
+                UccReq req(team, ctxs);
+
+                for (auto i = 0; i < repeat; i++) {
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, rs_test.data_validate(ctxs));
+                    rs_test.reset(ctxs);
+                }
+                rs_test.data_fini(ctxs);
+            }
+        }
+    }
+}
+
 INSTANTIATE_TEST_CASE_P(
     , test_reduce_scatter_alg,
         ::testing::Combine(
-            ::testing::Values(ring_unidir_env, ring_bidir_env, knomial)),
+            ::testing::Values(ring_unidir_env, ring_bidir_env, knomial,
+                              rrs_env, rrs_pipelined_env)),
     [](const testing::TestParamInfo<Param_0>& info) {
         const ucc_job_env_t env   = std::get<0>(info.param);
         return  env[0].second;});
@@ -39,14 +39,32 @@ class test_reduce_scatterv : public UccCollArgs, public testing::Test {
         return counts;
     }
 
+    /* every 3rd rank gets nothing and one rank gets most of the data, models
+       uneven shards */
+    std::vector<uint32_t> generate_skewed_counts(int nprocs, size_t total)
+    {
+        std::vector<uint32_t> counts(nprocs, 0);
+        size_t                rest = total;
+
+        for (int i = 0; i < nprocs; i++) {
+            if (i % 3 != 0) {
+                counts[i] = total / (4 * nprocs);
+                rest -= counts[i];
+            }
+        }
+        counts[nprocs / 2] += rest;
+        return counts;
+    }
+
     void data_init(int nprocs, ucc_datatype_t dt, size_t total_count,
-                   UccCollCtxVec &ctxs, bool persistent)
+                   UccCollCtxVec &ctxs, bool persistent, bool skewed = false)
 
     {
         size_t rcount = total_count;
 
         ctxs.resize(nprocs);
-        auto counts = generate_counts(nprocs, total_count);
+        auto counts = skewed ? generate_skewed_counts(nprocs, total_count)
+                             : generate_counts(nprocs, total_count);
 
         for (int r = 0; r < nprocs; r++) {
             if (TEST_INPLACE != inplace) {
@@ -412,3 +430,44 @@ UCC_TEST_P(test_reduce_scatterv_alg, ring)
 }
 INSTANTIATE_TEST_CASE_P(, test_reduce_scatterv_alg,
                         ::testing::Values("bidirectional", "unidirectional"));
+
+class test_reduce_scatterv_alg_kn
+    : public ucc::test,
+      public ::testing::WithParamInterface<std::string> {
+};
+
+UCC_TEST_P(test_reduce_scatterv_alg_kn, knomial)
+{
+    test_reduce_scatterv<TypeOpPair<UCC_DT_INT32, sum>> rsv_test;
+    int                                                 n_procs = 13;
+    std::string                                         alg     = GetParam();
+    ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                         {"UCC_TL_UCP_TUNE", "reduce_scatterv:@" + alg + ":inf"}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team   = job.create_team(n_procs);
+    int           repeat = 2;
+    UccCollCtxVec ctxs;
+
+    for (auto count : {12, 65536}) {
+        for (auto skewed : {false, true}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                rsv_test.set_mem_type(UCC_MEMORY_TYPE_HOST);
+                rsv_test.set_inplace(inplace);
+                rsv_test.data_init(n_procs, UCC_DT_INT32, count, ctxs, true,
+                                   skewed);
+                UccReq req(team, ctxs);
+
+                for (auto i = 0; i < repeat; i++) {
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, rsv_test.data_validate(ctxs));
+                    rsv_test.reset(ctxs);
+                }
+                rsv_test.data_fini(ctxs);
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_reduce_scatterv_alg_kn,
+                        ::testing::Values("knomial", "sra_knomial", "auto"));
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2023-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -282,3 +282,71 @@ INSTANTIATE_TEST_CASE_P(
                        ::testing::Values(1, 3, 8192), // count
                        ::testing::Values(0, 1),       // root
                        ::testing::Values(TEST_INPLACE, TEST_NO_INPLACE)));
+
+using Param_2 = std::tuple<ucc_job_env_t>;
+class test_scatter_alg : public test_scatter,
+                      public ::testing::WithParamInterface<Param_2> {
+};
+
+UCC_TEST_P(test_scatter_alg,)
+{
+    const ucc_job_env_t env     = std::get<0>(GetParam());
+    int                 n_procs = 8;
+    UccJob              job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h           team    = job.create_team(n_procs);
+    int                 repeat  = 2;
+    UccCollCtxVec       ctxs;
+
+    for (auto count : {1, 3, 8192, 65537}) {
+        for (auto root : {0, 1, 5}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                set_inplace(inplace);
+                SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+                set_root(root);
+                data_init(n_procs, UCC_DT_INT32, count, ctxs, true);
+                UccReq req(team, ctxs);
+
+                for (auto i = 0; i < repeat; i++) {
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, data_validate(ctxs));
+                    reset(ctxs);
+                }
+                data_fini(ctxs);
+            }
+        }
+    }
+}
+
+ucc_job_env_t scatter_knomial_env = {
+    {"name", "knomial"},
+    {"UCC_CL_BASIC_TUNE", "inf"},
+    {"UCC_TL_UCP_TUNE", "scatter:@knomial:inf"}};
+
+ucc_job_env_t scatter_2step_env = {
+    {"name", "2step"},
+    {"UCC_CL_HIER_TUNE", "scatter:@2step:0-inf:inf"},
+    {"UCC_CLS", "all"}};
+
+ucc_job_env_t scatter_2step_pipelined_env = {
+    {"name", "2step_pipelined"},
+    {"UCC_CL_HIER_TUNE", "scatter:@2step:0-inf:inf"},
+    {"UCC_CL_HIER_SCATTER_2STEP_PIPELINE", "thresh=0:fragsize=4K:pdepth=2"},
+    {"UCC_CLS", "all"}};
+
+/* knomial scatterv is reposted with counts of different fragments */
+ucc_job_env_t scatter_2step_pipelined_kn_env = {
+    {"name", "2step_pipelined_kn"},
+    {"UCC_CL_HIER_TUNE", "scatter:@2step:0-inf:inf"},
+    {"UCC_CL_HIER_SCATTER_2STEP_PIPELINE", "thresh=0:fragsize=4K:pdepth=2"},
+    {"UCC_TL_UCP_TUNE", "scatterv:@knomial:inf"},
+    {"UCC_CLS", "all"}};
+
+INSTANTIATE_TEST_CASE_P(
+    , test_scatter_alg,
+    ::testing::Values(scatter_knomial_env, scatter_2step_env,
+                      scatter_2step_pipelined_env,
+                      scatter_2step_pipelined_kn_env),
+    [](const testing::TestParamInfo<Param_2>& info) {
+        return std::get<0>(info.param)[0].second;
+    });
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+#include "test_score.h"
+
+class test_score_map : public test_score {
+  public:
+    static int         last_init;
+    ucc_base_lib_t     lib;
+    ucc_base_context_t ctx;
+    ucc_base_team_t    team;
+    ucc_coll_score_t  *score;
+    ucc_score_map_t   *map;
+
+    template <int id, ucc_status_t status>
+    static ucc_status_t init_fn(ucc_base_coll_args_t *, ucc_base_team_t *,
+                                ucc_coll_task_t **)
+    {
+        last_init = id;
+        return status;
+    }
+
+    test_score_map() : map(NULL)
+    {
+        memset(&lib, 0, sizeof(lib));
+        memset(&ctx, 0, sizeof(ctx));
+        memset(&team, 0, sizeof(team));
+        ctx.lib          = &lib;
+        team.context     = &ctx;
+        team.params.size = 4;
+        team.params.rank = 0;
+        EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score));
+    }
+    ~test_score_map()
+    {
+        if (map) {
+            ucc_coll_score_free_map(map);
+        } else {
+            ucc_coll_score_free(score);
+        }
+    }
+    void add_range(ucc_coll_score_t *s, ucc_coll_type_t ct, size_t start,
+                   size_t end, ucc_score_t sc, ucc_base_coll_init_fn_t init)
+    {
+        EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(s, ct, UCC_MEMORY_TYPE_HOST,
+                                                   start, end, sc, init,
+                                                   &team));
+    }
+    ucc_status_t init(ucc_coll_type_t ct, size_t msgsize)
+    {
+        ucc_base_coll_args_t bargs;
+        ucc_coll_task_t     *task;
+
+        memset(&bargs, 0, sizeof(bargs));
+        bargs.args.coll_type          = ct;
+        bargs.args.src.info.count     = msgsize;
+        bargs.args.src.info.datatype  = UCC_DT_INT8;
+        bargs.args.src.info.mem_type  = UCC_MEMORY_TYPE_HOST;
+        bargs.args.dst.info.count     = msgsize;
+        bargs.args.dst.info.datatype  = UCC_DT_INT8;
+        bargs.args.dst.info.mem_type  = UCC_MEMORY_TYPE_HOST;
+        last_init = -1;
+        return ucc_coll_init(map, &bargs, &task);
+    }
+};
+
+int test_score_map::last_init = -1;
+
+UCC_TEST_F(test_score_map, lookup)
+{
+    add_range(score, UCC_COLL_TYPE_ALLREDUCE, 0, 100, 10,
+              init_fn<1, UCC_OK>);
+    add_range(score, UCC_COLL_TYPE_ALLREDUCE, 100, 1000, 20,
+              init_fn<2, UCC_OK>);
+    add_range(score, UCC_COLL_TYPE_ALLREDUCE, 2000, UCC_MSG_MAX, 5,
+              init_fn<3, UCC_OK>);
+    add_range(score, UCC_COLL_TYPE_BCAST, 0, UCC_MSG_MAX, 5,
+              init_fn<4, UCC_OK>);
+    ASSERT_EQ(UCC_OK, ucc_coll_score_build_map(score, &map));
+
+    std::vector<std::pair<size_t, int>> check = {
+        {0, 1}, {99, 1}, {100, 2}, {999, 2}, {1000, 2},
+        {1001, -1}, {1999, -1}, {2000, 3}, {1 << 30, 3}};
+    for (auto &c : check) {
+        EXPECT_EQ((c.second < 0) ? UCC_ERR_NOT_SUPPORTED : UCC_OK,
+                  init(UCC_COLL_TYPE_ALLREDUCE, c.first));
+        EXPECT_EQ(c.second, last_init);
+    }
+    EXPECT_EQ(UCC_OK, init(UCC_COLL_TYPE_BCAST, 12345));
+    EXPECT_EQ(4, last_init);
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, init(UCC_COLL_TYPE_ALLGATHER, 8));
+}
+
+UCC_TEST_F(test_score_map, fallback)
+{
+    ucc_coll_score_t *score2, *merged;
+
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score2));
+    add_range(score, UCC_COLL_TYPE_ALLREDUCE, 0, UCC_MSG_MAX, 10,
+              init_fn<1, UCC_ERR_NOT_SUPPORTED>);
+    add_range(score2, UCC_COLL_TYPE_ALLREDUCE, 0, 4096, 5,
+              init_fn<2, UCC_OK>);
+    ASSERT_EQ(UCC_OK, ucc_coll_score_merge(score, score2, &merged, 1));
+    score = merged;
+    ASSERT_EQ(UCC_OK, ucc_coll_score_build_map(score, &map));
+
+    EXPECT_EQ(UCC_OK, init(UCC_COLL_TYPE_ALLREDUCE, 8));
+    EXPECT_EQ(2, last_init);
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, init(UCC_COLL_TYPE_ALLREDUCE, 8192));
+    EXPECT_EQ(1, last_init);
+}
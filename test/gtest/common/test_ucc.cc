@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 #include "test_ucc.h"
@@ -271,8 +271,10 @@ UccTeam::~UccTeam()
     destroy_team();
 }
 
-UccJob::UccJob(int _n_procs, ucc_job_ctx_mode_t _ctx_mode, ucc_job_env_t vars) :
-    ta(_n_procs), n_procs(_n_procs), ctx_mode(_ctx_mode)
+UccJob::UccJob(int _n_procs, ucc_job_ctx_mode_t _ctx_mode, ucc_job_env_t vars,
+               int _n_nodes, int _n_racks) :
+    ta(_n_procs), n_procs(_n_procs), n_nodes(_n_nodes), n_racks(_n_racks),
+    ctx_mode(_ctx_mode)
 
 {
     ucc_job_env_t env_bkp;
@@ -370,9 +372,9 @@ ucc_status_t thread_allgather_req_free(void *request)
     return UCC_OK;
 }
 
-void proc_context_create(UccProcess_h proc, int id, ThreadAllgather *ta, bool is_global)
+void proc_context_create(UccProcess_h proc, int id, ThreadAllgather *ta,
+                         bool is_global, int nnodes, int nracks)
 {
-    const int            nnodes   = 2;
     const int            nsockets = 2;
     const int            nnumas   = 3;
     ucc_status_t         status;
@@ -410,6 +412,14 @@ void proc_context_create(UccProcess_h proc, int id, ThreadAllgather *ta, bool is
         block = ucc_buffer_block_count(local_ppn, nnumas, 0);
         proc_info.numa_id = local_rank / block;
 
+        /* racks are made of consecutive nodes */
+        if (nracks > 0) {
+            block             = ucc_buffer_block_count(nnodes, nracks, 0);
+            proc_info.rack_id = node / block + 1;
+        } else {
+            proc_info.rack_id = UCC_RACK_ID_INVALID;
+        }
+
         proc_info.pid = id + 1;
     } else {
         proc_info = ucc_local_proc;
@@ -480,7 +490,8 @@ void UccJob::create_context()
                 std::thread(proc_context_create_mem_params, procs[i], i, &ta));
         } else {
             workers.push_back(std::thread(proc_context_create, procs[i], i, &ta,
-                                          ctx_mode == UCC_JOB_CTX_GLOBAL));
+                                          ctx_mode == UCC_JOB_CTX_GLOBAL,
+                                          n_nodes, n_racks));
         }
     }
     for (auto i = 0; i < procs.size(); i++) {
@@ -550,6 +561,7 @@ void UccJob::cleanup()
 {
     if (staticUccJob) {
         delete staticUccJob;
+        staticUccJob = NULL;
     }
 }
 
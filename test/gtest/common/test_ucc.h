@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -211,8 +211,13 @@ public:
     static UccJob* getStaticJob();
     static const std::vector<UccTeam_h> &getStaticTeams();
     int n_procs;
+    /* number of simulated nodes of UCC_JOB_CTX_GLOBAL job */
+    int n_nodes;
+    /* number of simulated racks the nodes are split into, 0 - no rack ids */
+    int n_racks;
     UccJob(int _n_procs = 2, ucc_job_ctx_mode_t _ctx_mode = UCC_JOB_CTX_GLOBAL,
-           ucc_job_env_t vars = ucc_job_env_t());
+           ucc_job_env_t vars = ucc_job_env_t(), int _n_nodes = 2,
+           int _n_racks = 0);
     ~UccJob();
     std::vector<UccProcess_h> procs;
     UccTeam_h create_team(int n_procs, bool use_team_ep_map = false,
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+extern "C" {
+#include <core/ucc_team.h>
+}
+#include "common/test_ucc.h"
+
+class test_coll_cache : public ucc::test {
+  public:
+    static const int n_procs = 4;
+    /* knomial allreduce from tl_ucp supports task rebind */
+    ucc_job_env_t env = {{"UCC_CLS", "basic"},
+                         {"UCC_CL_BASIC_TLS", "ucp"},
+                         {"UCC_TL_UCP_TUNE", "allreduce:@knomial:0-inf:inf"}};
+    std::vector<std::vector<float>> bufs;
+
+    static ucc_coll_cache_t *cache(UccTeam_h team, int rank)
+    {
+        return &team->procs[rank].team->coll_cache;
+    }
+
+    /* Runs allreduce on fresh buffers, returns requests of all ranks.
+       Requests are finalized, so returned handles are only good for
+       comparison */
+    std::vector<ucc_coll_req_h> run(UccTeam_h team, size_t count, int round)
+    {
+        std::vector<ucc_coll_req_h> reqs;
+        ucc_coll_req_h              req;
+        ucc_coll_args_t             args;
+        ucc_status_t                st;
+        size_t                      i, j;
+        float                       expected;
+
+        for (i = 0; i < n_procs; i++) {
+            bufs.emplace_back(count, (float)(i + round));
+            bufs.emplace_back(count, 0);
+            memset(&args, 0, sizeof(args));
+            args.coll_type            = UCC_COLL_TYPE_ALLREDUCE;
+            args.op                   = UCC_OP_SUM;
+            args.src.info.buffer      = bufs[bufs.size() - 2].data();
+            args.src.info.count       = count;
+            args.src.info.datatype    = UCC_DT_FLOAT32;
+            args.src.info.mem_type    = UCC_MEMORY_TYPE_HOST;
+            args.dst.info.buffer      = bufs[bufs.size() - 1].data();
+            args.dst.info.count       = count;
+            args.dst.info.datatype    = UCC_DT_FLOAT32;
+            args.dst.info.mem_type    = UCC_MEMORY_TYPE_HOST;
+            EXPECT_EQ(UCC_OK,
+                      ucc_collective_init(&args, &req, team->procs[i].team));
+            reqs.push_back(req);
+        }
+        for (auto r : reqs) {
+            EXPECT_EQ(UCC_OK, ucc_collective_post(r));
+        }
+        do {
+            team->progress();
+            st = UCC_OK;
+            for (auto r : reqs) {
+                if (ucc_collective_test(r) != UCC_OK) {
+                    st = UCC_INPROGRESS;
+                }
+            }
+        } while (st == UCC_INPROGRESS);
+
+        expected = n_procs * round + n_procs * (n_procs - 1) / 2;
+        for (i = 0; i < n_procs; i++) {
+            auto &dst = bufs[bufs.size() - 2 * (n_procs - i) + 1];
+            for (j = 0; j < count; j++) {
+                EXPECT_EQ(expected, dst[j]);
+            }
+            EXPECT_EQ(UCC_OK, ucc_collective_finalize(reqs[i]));
+        }
+        return reqs;
+    }
+};
+
+UCC_TEST_F(test_coll_cache, reuse)
+{
+    UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h team = job.create_team(n_procs);
+
+    auto reqs0 = run(team, 64, 0);
+    for (int round = 1; round < 4; round++) {
+        /* same args, new buffers: cached tasks are reused */
+        EXPECT_EQ(reqs0, run(team, 64, round));
+    }
+    for (int i = 0; i < n_procs; i++) {
+        EXPECT_EQ(3u, cache(team, i)->n_hits);
+        EXPECT_EQ(1u, cache(team, i)->n_misses);
+    }
+}
+
+UCC_TEST_F(test_coll_cache, key_mismatch)
+{
+    UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h team = job.create_team(n_procs);
+
+    auto reqs0 = run(team, 64, 0);
+    auto reqs1 = run(team, 128, 1);
+    for (int i = 0; i < n_procs; i++) {
+        EXPECT_NE(reqs0[i], reqs1[i]);
+    }
+    EXPECT_EQ(reqs0, run(team, 64, 2));
+    EXPECT_EQ(reqs1, run(team, 128, 3));
+}
+
+UCC_TEST_F(test_coll_cache, disabled)
+{
+    ucc_job_env_t env_nc = env;
+
+    env_nc.push_back({"UCC_COLL_INIT_CACHE_SIZE", "0"});
+    UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env_nc);
+    UccTeam_h team = job.create_team(n_procs);
+
+    for (int round = 0; round < 4; round++) {
+        /* tasks are finalized after every round, a request handle may be
+           recycled by the task mpool, so the cache itself is checked */
+        run(team, 64, round);
+        for (int i = 0; i < n_procs; i++) {
+            EXPECT_FALSE(ucc_coll_cache_enabled(cache(team, i)));
+            EXPECT_TRUE(ucc_list_is_empty(&cache(team, i)->lru));
+            EXPECT_EQ(0u, cache(team, i)->n_hits);
+            EXPECT_EQ(0u, cache(team, i)->n_misses);
+        }
+    }
+}
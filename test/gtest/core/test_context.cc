@@ -4,6 +4,9 @@
  */
 #include "test_context.h"
 #include "../common/test_ucc.h"
+extern "C" {
+#include "core/ucc_context.h"
+}
 #include <vector>
 #include <algorithm>
 #include <random>
@@ -84,6 +87,45 @@ UCC_TEST_F(test_context_get_attr, work_buffer_size)
     EXPECT_EQ(5, attr.global_work_buffer_size);
 }
 
+static unsigned test_progress_fn(void *arg)
+{
+    int *events = (int *)arg;
+
+    events[1]++;
+    return events[0];
+}
+
+UCC_TEST_F(test_context_get_attr, progress_throttle)
+{
+    const int                    n_calls = 10000;
+    int                          events[2] = {0, 0}; /* to return, n calls */
+    ucc_context_progress_stats_t s0, s1;
+
+    ucc_context_get_progress_stats(ctx_h, &s0);
+    EXPECT_EQ(UCC_OK, ucc_context_progress_register(ctx_h, test_progress_fn,
+                                                    events));
+    /* idle fn: backs off exponentially */
+    for (int i = 0; i < n_calls; i++) {
+        EXPECT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+    }
+    EXPECT_LT(events[1], n_calls / 10);
+    ucc_context_get_progress_stats(ctx_h, &s1);
+    EXPECT_EQ((uint64_t)n_calls, (s1.n_idle_polls - s0.n_idle_polls) +
+                                 (s1.n_throttled - s0.n_throttled));
+    EXPECT_EQ(s1.n_idle_polls - s0.n_idle_polls,
+              s1.n_empty_polls - s0.n_empty_polls);
+
+    /* busy fn: called on every progress once the current interval ends */
+    events[0] = 1;
+    events[1] = 0;
+    for (int i = 0; i < 2 * n_calls; i++) {
+        EXPECT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+    }
+    EXPECT_GT(events[1], n_calls);
+    EXPECT_EQ(UCC_OK, ucc_context_progress_deregister(ctx_h, test_progress_fn,
+                                                      events));
+}
+
 UCC_TEST_F(test_context, global)
 {
     /* Create and cleanup several Jobs (ucc contextss) with OOB */
@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+extern "C" {
+#include <components/ec/ucc_ec.h>
+}
+#include <common/test.h>
+#include <common/test_ucc.h>
+#include <algorithm>
+#include <vector>
+
+class test_ec_cpu : public ucc::test {
+  protected:
+    ucc_ee_executor_t *executor;
+
+    virtual void SetUp() override
+    {
+        ucc_ec_params_t ec_params = {
+            .thread_mode = UCC_THREAD_SINGLE,
+        };
+        ucc_ee_executor_params_t eparams;
+
+        ucc::test::SetUp();
+        /* EC config is parsed by the first ucc_ec_init only, release the
+           static job so that the settings below take effect */
+        UccJob::cleanup();
+        /* offload every task to worker threads, tasks are split into
+           small chunks to exercise completion of multi chunk tasks.
+           Workers are not bound, so they are started even if the process
+           is bound to a single core. */
+        setenv("UCC_EC_CPU_EXEC_NUM_WORKERS", "4", 1);
+        setenv("UCC_EC_CPU_EXEC_ASYNC_THRESH", "0", 1);
+        setenv("UCC_EC_CPU_EXEC_CHUNK_SIZE", "4K", 1);
+        setenv("UCC_EC_CPU_EXEC_BIND_WORKERS", "n", 1);
+        ucc_constructor();
+        ucc_ec_init(&ec_params);
+        eparams.mask    = UCC_EE_EXECUTOR_PARAM_FIELD_TYPE;
+        eparams.ee_type = UCC_EE_CPU_THREAD;
+        ASSERT_EQ(UCC_OK, ucc_ee_executor_init(&eparams, &executor));
+        ASSERT_EQ(UCC_OK, ucc_ee_executor_start(executor, NULL));
+    }
+
+    virtual void TearDown() override
+    {
+        ucc_ee_executor_stop(executor);
+        ucc_ee_executor_finalize(executor);
+        ucc_ec_finalize();
+        unsetenv("UCC_EC_CPU_EXEC_NUM_WORKERS");
+        unsetenv("UCC_EC_CPU_EXEC_ASYNC_THRESH");
+        unsetenv("UCC_EC_CPU_EXEC_CHUNK_SIZE");
+        unsetenv("UCC_EC_CPU_EXEC_BIND_WORKERS");
+        ucc::test::TearDown();
+    }
+
+    ucc_status_t run_task(ucc_ee_executor_task_args_t *eargs)
+    {
+        ucc_ee_executor_task_t *task;
+        ucc_status_t            status;
+
+        status = ucc_ee_executor_task_post(executor, eargs, &task);
+        if (UCC_OK != status) {
+            return status;
+        }
+        while (UCC_INPROGRESS == (status = ucc_ee_executor_task_test(task))) {
+            ;
+        }
+        ucc_ee_executor_task_finalize(task);
+        return status;
+    }
+};
+
+UCC_TEST_F(test_ec_cpu, copy)
+{
+    const size_t                size = 1024 * 1024 + 3;
+    std::vector<char>           src(size), dst(size, 0);
+    ucc_ee_executor_task_args_t eargs;
+
+    for (size_t i = 0; i < size; i++) {
+        src[i] = (char)i;
+    }
+    eargs.task_type = UCC_EE_EXECUTOR_TASK_COPY;
+    eargs.flags     = 0;
+    eargs.copy.src  = src.data();
+    eargs.copy.dst  = dst.data();
+    eargs.copy.len  = size;
+    ASSERT_EQ(UCC_OK, run_task(&eargs));
+    EXPECT_EQ(src, dst);
+}
+
+/* Offloaded task is still in progress right after the post: the posting
+   thread does not execute it, 16k chunks are processed by the workers */
+UCC_TEST_F(test_ec_cpu, offload)
+{
+    const size_t                size = 64 * 1024 * 1024;
+    std::vector<char>           src(size, 1), dst(size, 0);
+    ucc_ee_executor_task_args_t eargs;
+    ucc_ee_executor_task_t     *task;
+    ucc_status_t                status;
+
+    eargs.task_type = UCC_EE_EXECUTOR_TASK_COPY;
+    eargs.flags     = 0;
+    eargs.copy.src  = src.data();
+    eargs.copy.dst  = dst.data();
+    eargs.copy.len  = size;
+    ASSERT_EQ(UCC_OK, ucc_ee_executor_task_post(executor, &eargs, &task));
+    EXPECT_EQ(UCC_INPROGRESS, ucc_ee_executor_task_test(task));
+    while (UCC_INPROGRESS == (status = ucc_ee_executor_task_test(task))) {
+        ;
+    }
+    ucc_ee_executor_task_finalize(task);
+    ASSERT_EQ(UCC_OK, status);
+    EXPECT_EQ(src, dst);
+}
+
+UCC_TEST_F(test_ec_cpu, copy_multi)
+{
+    const size_t                num_vectors = 5;
+    const size_t                size        = 64 * 1024;
+    std::vector<char>           src(size * num_vectors);
+    std::vector<char>           dst(size * num_vectors, 0);
+    ucc_ee_executor_task_args_t eargs;
+
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = (char)(i * 7);
+    }
+    eargs.task_type              = UCC_EE_EXECUTOR_TASK_COPY_MULTI;
+    eargs.flags                  = 0;
+    eargs.copy_multi.num_vectors = num_vectors;
+    for (size_t i = 0; i < num_vectors; i++) {
+        /* reverse order of vectors */
+        eargs.copy_multi.src[i]    = &src[i * size];
+        eargs.copy_multi.dst[i]    = &dst[(num_vectors - i - 1) * size];
+        eargs.copy_multi.counts[i] = size;
+    }
+    ASSERT_EQ(UCC_OK, run_task(&eargs));
+    for (size_t i = 0; i < num_vectors; i++) {
+        EXPECT_EQ(0, memcmp(&src[i * size], &dst[(num_vectors - i - 1) * size],
+                            size));
+    }
+}
+
+UCC_TEST_F(test_ec_cpu, reduce)
+{
+    const size_t                count  = 100000;
+    const int                   n_srcs = 3;
+    std::vector<float>          src[n_srcs], dst(count, 0);
+    ucc_ee_executor_task_args_t eargs;
+
+    eargs.task_type     = UCC_EE_EXECUTOR_TASK_REDUCE;
+    eargs.flags         = 0;
+    eargs.reduce.count  = count;
+    eargs.reduce.dt     = UCC_DT_FLOAT32;
+    eargs.reduce.op     = UCC_OP_SUM;
+    eargs.reduce.n_srcs = n_srcs;
+    eargs.reduce.dst    = dst.data();
+    for (int j = 0; j < n_srcs; j++) {
+        src[j].resize(count);
+        for (size_t i = 0; i < count; i++) {
+            src[j][i] = (float)(i % 1000 + j);
+        }
+        eargs.reduce.srcs[j] = src[j].data();
+    }
+    ASSERT_EQ(UCC_OK, run_task(&eargs));
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_FLOAT_EQ((float)(3 * (i % 1000) + 3), dst[i]);
+    }
+}
+
+UCC_TEST_F(test_ec_cpu, reduce_strided_alpha)
+{
+    const size_t                count  = 100001;
+    const int                   n_src2 = 4;
+    const double                alpha  = 0.5;
+    std::vector<double>         src1(count), src2(count * n_src2);
+    std::vector<double>         dst(count, 0);
+    ucc_ee_executor_task_args_t eargs;
+
+    for (size_t i = 0; i < count; i++) {
+        src1[i] = (double)i;
+        for (int j = 0; j < n_src2; j++) {
+            src2[i + j * count] = (double)(i + j);
+        }
+    }
+    eargs.task_type             = UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED;
+    eargs.flags                 = UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA;
+    eargs.reduce_strided.count  = count;
+    eargs.reduce_strided.dt     = UCC_DT_FLOAT64;
+    eargs.reduce_strided.op     = UCC_OP_SUM;
+    eargs.reduce_strided.n_src2 = n_src2;
+    eargs.reduce_strided.dst    = dst.data();
+    eargs.reduce_strided.src1   = src1.data();
+    eargs.reduce_strided.src2   = src2.data();
+    eargs.reduce_strided.stride = count * sizeof(double);
+    eargs.reduce_strided.alpha  = alpha;
+    ASSERT_EQ(UCC_OK, run_task(&eargs));
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_DOUBLE_EQ((5.0 * i + 6) * alpha, dst[i]);
+    }
+}
+
+UCC_TEST_F(test_ec_cpu, reduce_not_supported)
+{
+    const size_t                count = 64 * 1024;
+    std::vector<float>          src1(count), src2(count), dst(count);
+    ucc_ee_executor_task_args_t eargs;
+
+    eargs.task_type      = UCC_EE_EXECUTOR_TASK_REDUCE;
+    eargs.flags          = 0;
+    eargs.reduce.count   = count;
+    eargs.reduce.dt      = UCC_DT_FLOAT32;
+    eargs.reduce.op      = UCC_OP_BAND;
+    eargs.reduce.n_srcs  = 2;
+    eargs.reduce.dst     = dst.data();
+    eargs.reduce.srcs[0] = src1.data();
+    eargs.reduce.srcs[1] = src2.data();
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, run_task(&eargs));
+}
+
+/* Counts which are not multiple of SIMD width check vector kernels along
+   with scalar remainder processing */
+class test_ec_cpu_simd : public test_ec_cpu,
+                         public ::testing::WithParamInterface<size_t> {
+  public:
+    template <typename T, typename OP>
+    void check_reduce(ucc_datatype_t dt, ucc_reduction_op_t op, OP do_op)
+    {
+        const size_t                count  = GetParam();
+        const int                   n_srcs = 5;
+        std::vector<T>              src[n_srcs], dst(count);
+        ucc_ee_executor_task_args_t eargs;
+        T                           res;
+
+        eargs.task_type     = UCC_EE_EXECUTOR_TASK_REDUCE;
+        eargs.flags         = 0;
+        eargs.reduce.count  = count;
+        eargs.reduce.dt     = dt;
+        eargs.reduce.op     = op;
+        eargs.reduce.n_srcs = n_srcs;
+        eargs.reduce.dst    = dst.data();
+        for (int j = 0; j < n_srcs; j++) {
+            src[j].resize(count);
+            for (size_t i = 0; i < count; i++) {
+                src[j][i] = (T)((i * 7 + j * 13) % 127);
+            }
+            eargs.reduce.srcs[j] = src[j].data();
+        }
+        ASSERT_EQ(UCC_OK, run_task(&eargs));
+        for (size_t i = 0; i < count; i++) {
+            res = src[0][i];
+            for (int j = 1; j < n_srcs; j++) {
+                res = do_op(res, src[j][i]);
+            }
+            ASSERT_EQ(res, dst[i]);
+        }
+    }
+};
+
+UCC_TEST_P(test_ec_cpu_simd, reduce)
+{
+    check_reduce<float>(UCC_DT_FLOAT32, UCC_OP_SUM,
+                        [](float a, float b) { return a + b; });
+    check_reduce<double>(UCC_DT_FLOAT64, UCC_OP_MAX,
+                         [](double a, double b) { return a > b ? a : b; });
+    check_reduce<int8_t>(UCC_DT_INT8, UCC_OP_MIN,
+                         [](int8_t a, int8_t b) { return a < b ? a : b; });
+    check_reduce<int16_t>(UCC_DT_INT16, UCC_OP_PROD,
+                          [](int16_t a, int16_t b) {
+                              return (int16_t)(a * b);
+                          });
+    check_reduce<uint32_t>(UCC_DT_UINT32, UCC_OP_MAX,
+                           [](uint32_t a, uint32_t b) {
+                               return a > b ? a : b;
+                           });
+    check_reduce<uint64_t>(UCC_DT_UINT64, UCC_OP_BXOR,
+                           [](uint64_t a, uint64_t b) { return a ^ b; });
+}
+
+UCC_TEST_P(test_ec_cpu_simd, reduce_bfloat16_alpha)
+{
+    const size_t                count  = GetParam();
+    const int                   n_srcs = 3;
+    const double                alpha  = 0.25;
+    std::vector<uint16_t>       src[n_srcs], dst(count);
+    ucc_ee_executor_task_args_t eargs;
+    uint16_t                    res;
+    float                       sum;
+
+    eargs.task_type     = UCC_EE_EXECUTOR_TASK_REDUCE;
+    eargs.flags         = UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA;
+    eargs.reduce.count  = count;
+    eargs.reduce.dt     = UCC_DT_BFLOAT16;
+    eargs.reduce.op     = UCC_OP_AVG;
+    eargs.reduce.n_srcs = n_srcs;
+    eargs.reduce.dst    = dst.data();
+    eargs.reduce.alpha  = alpha;
+    for (int j = 0; j < n_srcs; j++) {
+        src[j].resize(count);
+        for (size_t i = 0; i < count; i++) {
+            float32tobfloat16((float)(i % 61 + j), &src[j][i]);
+        }
+        eargs.reduce.srcs[j] = src[j].data();
+    }
+    ASSERT_EQ(UCC_OK, run_task(&eargs));
+    for (size_t i = 0; i < count; i++) {
+        sum = 0;
+        for (int j = 0; j < n_srcs; j++) {
+            sum += bfloat16tofloat32(&src[j][i]);
+        }
+        float32tobfloat16(sum * (float)alpha, &res);
+        ASSERT_EQ(res, dst[i]);
+    }
+}
+
+UCC_TEST_P(test_ec_cpu_simd, reduce_float16)
+{
+    const size_t                count  = GetParam();
+    const int                   n_srcs = 4;
+    std::vector<uint16_t>       src[n_srcs], dst(count);
+    ucc_ee_executor_task_args_t eargs;
+    uint16_t                    res;
+    float                       acc;
+
+    eargs.task_type     = UCC_EE_EXECUTOR_TASK_REDUCE;
+    eargs.reduce.count  = count;
+    eargs.reduce.dt     = UCC_DT_FLOAT16;
+    eargs.reduce.n_srcs = n_srcs;
+    eargs.reduce.dst    = dst.data();
+    eargs.reduce.alpha  = 0.25;
+    for (int j = 0; j < n_srcs; j++) {
+        src[j].resize(count);
+        for (size_t i = 0; i < count; i++) {
+            float32tofloat16((float)((i * 7 + j * 13) % 127) * 0.37f - 20.0f,
+                             &src[j][i]);
+        }
+        eargs.reduce.srcs[j] = src[j].data();
+    }
+    /* accumulation is done in fp32 with a single rounding to float16,
+       so results are bit exact with the fp32 reference */
+    for (auto op : {UCC_OP_SUM, UCC_OP_PROD, UCC_OP_MAX, UCC_OP_AVG}) {
+        eargs.reduce.op = op;
+        eargs.flags     = (op == UCC_OP_AVG) ?
+                          UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA : 0;
+        ASSERT_EQ(UCC_OK, run_task(&eargs));
+        for (size_t i = 0; i < count; i++) {
+            acc = float16tofloat32(&src[0][i]);
+            for (int j = 1; j < n_srcs; j++) {
+                float v = float16tofloat32(&src[j][i]);
+                acc     = (op == UCC_OP_PROD) ? acc * v :
+                          (op == UCC_OP_MAX)  ? std::max(acc, v) : acc + v;
+            }
+            if (op == UCC_OP_AVG) {
+                acc *= (float)eargs.reduce.alpha;
+            }
+            float32tofloat16(acc, &res);
+            ASSERT_EQ(res, dst[i]);
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_ec_cpu_simd,
+                        ::testing::Values(1, 7, 64, 1037, 65537));
+
+UCC_TEST_F(test_ec_cpu, reduce_maxloc_minloc)
+{
+    struct float_int {
+        float   val;
+        int32_t idx;
+    };
+    const size_t                count  = 10001;
+    const int                   n_srcs = 5;
+    std::vector<float_int>      src[n_srcs], dst(count);
+    ucc_ee_executor_task_args_t eargs;
+    float_int                   res;
+
+    eargs.task_type     = UCC_EE_EXECUTOR_TASK_REDUCE;
+    eargs.flags         = 0;
+    eargs.reduce.count  = count;
+    eargs.reduce.dt     = UCC_DT_FLOAT32_INT32;
+    eargs.reduce.n_srcs = n_srcs;
+    eargs.reduce.dst    = dst.data();
+    for (int j = 0; j < n_srcs; j++) {
+        src[j].resize(count);
+        for (size_t i = 0; i < count; i++) {
+            /* few distinct values produce ties resolved by index */
+            src[j][i].val = (float)((i + j) % 3);
+            src[j][i].idx = n_srcs - j;
+        }
+        eargs.reduce.srcs[j] = src[j].data();
+    }
+    for (auto op : {UCC_OP_MAXLOC, UCC_OP_MINLOC}) {
+        eargs.reduce.op = op;
+        ASSERT_EQ(UCC_OK, run_task(&eargs));
+        for (size_t i = 0; i < count; i++) {
+            res = src[0][i];
+            for (int j = 1; j < n_srcs; j++) {
+                if (((op == UCC_OP_MAXLOC) ? (src[j][i].val > res.val)
+                                           : (src[j][i].val < res.val)) ||
+                    ((src[j][i].val == res.val) && (src[j][i].idx < res.idx))) {
+                    res = src[j][i];
+                }
+            }
+            ASSERT_EQ(res.val, dst[i].val);
+            ASSERT_EQ(res.idx, dst[i].idx);
+        }
+    }
+
+    eargs.reduce.op = UCC_OP_SUM;
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, run_task(&eargs));
+}
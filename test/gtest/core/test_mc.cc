@@ -1,11 +1,14 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
 extern "C" {
 #include <components/mc/ucc_mc.h>
+#include <core/ucc_global_opts.h>
+#include <utils/ucc_sys.h>
 #include <pthread.h>
+#include <sys/mman.h>
 }
 #include <common/test.h>
 #include <vector>
@@ -14,8 +17,9 @@ void *mt_ucc_mc_cpu_allocs(void *args)
 {
     // Final size will be:
     // size * (quantifier^(num_of_allocs/2))
-    // and should be larger than mpool buffer size which is 1MB by default,
-    // to assure testing both fast and slow ucc_mc_alloc path.
+    // and spans several mpool size classes. Concurrent threads exhaust
+    // UCC_MC_CPU_MPOOL_MAX_ELEMS of a size class, this assures testing both
+    // fast and slow ucc_mc_alloc path.
     // if num_of_allocs is changed, change quantifier accordingly.
     size_t                                size          = 4;
     int                                   quantifier    = 2;
@@ -65,7 +69,7 @@ UCC_TEST_F(test_mc, init_is_required)
 
 UCC_TEST_F(test_mc, can_alloc_and_free_host_mem)
 {
-    // mpool will be used only if size is smaller than UCC_MC_CPU_ELEM_SIZE, which by default set to 1MB and is configurable at runtime.
+    // mpool will be used only if size is smaller than UCC_MC_CPU_MPOOL_ELEM_SIZE, which by default set to 32MB and is configurable at runtime.
     size_t                  size = 4096;
     ucc_mc_buffer_header_t *h;
     void *ptr = NULL;
@@ -82,10 +86,126 @@ UCC_TEST_F(test_mc, can_alloc_and_free_host_mem)
     ucc_mc_finalize();
 }
 
+static ucc_mc_pool_stats_t host_pool_stats()
+{
+    ucc_mc_attr_t attr;
+
+    attr.field_mask = UCC_MC_ATTR_FIELD_POOL_STATS;
+    EXPECT_EQ(UCC_OK, ucc_mc_get_attr(&attr, UCC_MEMORY_TYPE_HOST));
+    return attr.pool_stats;
+}
+
+UCC_TEST_F(test_mc, host_mem_pool_size_classes)
+{
+    std::vector<ucc_mc_buffer_header_t *> headers;
+    ucc_mc_pool_stats_t                   s0, s1, s2;
+    size_t                                size;
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ucc_mc_params_t mc_params = {
+        .thread_mode = UCC_THREAD_SINGLE,
+    };
+    ASSERT_EQ(UCC_OK, ucc_mc_init(&mc_params));
+    s0 = host_pool_stats();
+    for (int round = 0; round < 2; round++) {
+        // buffers of all size classes are outstanding at the same time
+        for (size = 1; size <= 16 * 1024 * 1024; size = size * 2 + 1) {
+            headers.push_back(NULL);
+            ASSERT_EQ(UCC_OK, ucc_mc_alloc(&headers.back(), size,
+                                           UCC_MEMORY_TYPE_HOST));
+            EXPECT_EQ((uintptr_t)0, (uintptr_t)headers.back()->addr % 64);
+            memset(headers.back()->addr, 0, size);
+        }
+        for (auto h : headers) {
+            EXPECT_EQ(1, h->from_pool);
+            EXPECT_EQ(UCC_OK, ucc_mc_free(h));
+        }
+        headers.clear();
+        if (round == 0) {
+            s1 = host_pool_stats();
+        }
+    }
+    s2 = host_pool_stats();
+    // second round is served from cached buffers only
+    EXPECT_EQ(s0.n_misses, s2.n_misses);
+    EXPECT_EQ(s1.bytes_held, s2.bytes_held);
+    EXPECT_EQ(2 * (s1.n_hits - s0.n_hits), s2.n_hits - s0.n_hits);
+    EXPECT_LT(s0.bytes_held, s1.bytes_held);
+    ucc_mc_finalize();
+}
+
+UCC_TEST_F(test_mc, host_mem_pool_max_elems)
+{
+    // default UCC_MC_CPU_MPOOL_MAX_ELEMS is 8
+    const int                             n_bufs = 20;
+    std::vector<ucc_mc_buffer_header_t *> headers(n_bufs);
+    ucc_mc_pool_stats_t                   s0, s1;
+    int                                   from_pool = 0;
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ucc_mc_params_t mc_params = {
+        .thread_mode = UCC_THREAD_SINGLE,
+    };
+    ASSERT_EQ(UCC_OK, ucc_mc_init(&mc_params));
+    s0 = host_pool_stats();
+    for (int i = 0; i < n_bufs; i++) {
+        ASSERT_EQ(UCC_OK, ucc_mc_alloc(&headers[i], 3 * 1024 * 1024,
+                                       UCC_MEMORY_TYPE_HOST));
+        from_pool += headers[i]->from_pool;
+    }
+    for (int i = 0; i < n_bufs; i++) {
+        EXPECT_EQ(UCC_OK, ucc_mc_free(headers[i]));
+    }
+    s1 = host_pool_stats();
+    EXPECT_EQ(8, from_pool);
+    EXPECT_EQ((uint64_t)(n_bufs - from_pool), s1.n_misses - s0.n_misses);
+    ucc_mc_finalize();
+}
+
+UCC_TEST_F(test_mc, host_mem_pool_max_total)
+{
+    // defaults: UCC_MC_CPU_MPOOL_MAX_CACHED is 64MB per size class,
+    // UCC_MC_CPU_MPOOL_MAX_TOTAL is 128MB, i.e. 4 elements of 16MB class and
+    // 2 elements of 32MB class fill the pool
+    const size_t                          max_total = 128 * 1024 * 1024;
+    const size_t                          sizes[]   = {9 * 1024 * 1024,
+                                                       17 * 1024 * 1024,
+                                                       3 * 1024 * 1024};
+    std::vector<ucc_mc_buffer_header_t *> headers;
+    ucc_mc_pool_stats_t                   s0, s1;
+    int                                   from_pool[3] = {0, 0, 0};
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ucc_mc_params_t mc_params = {
+        .thread_mode = UCC_THREAD_SINGLE,
+    };
+    ASSERT_EQ(UCC_OK, ucc_mc_init(&mc_params));
+    s0 = host_pool_stats();
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 8; j++) {
+            headers.push_back(NULL);
+            ASSERT_EQ(UCC_OK, ucc_mc_alloc(&headers.back(), sizes[i],
+                                           UCC_MEMORY_TYPE_HOST));
+            from_pool[i] += headers.back()->from_pool;
+        }
+    }
+    s1 = host_pool_stats();
+    for (auto h : headers) {
+        EXPECT_EQ(UCC_OK, ucc_mc_free(h));
+    }
+    EXPECT_EQ(4, from_pool[0]);
+    EXPECT_EQ(2, from_pool[1]);
+    /* pool is full, smaller size class can't grow either */
+    EXPECT_EQ(0, from_pool[2]);
+    EXPECT_LE(s1.bytes_held, max_total);
+    EXPECT_EQ((uint64_t)(3 * 8 - 6), s1.n_misses - s0.n_misses);
+    ucc_mc_finalize();
+}
+
 // Disabled because can't reinit mc with different thread mode
 UCC_TEST_F(test_mc, DISABLED_can_alloc_and_free_host_mem_mt)
 {
-    // mpool will be used only if size is smaller than UCC_MC_CPU_ELEM_SIZE, which by default set to 1MB and is configurable at runtime.
+    // mpool will be used only if size is smaller than UCC_MC_CPU_MPOOL_ELEM_SIZE, which by default set to 32MB and is configurable at runtime.
     int                    num_of_threads = 10;
     std::vector<pthread_t> threads;
     threads.resize(num_of_threads);
@@ -127,3 +247,64 @@ UCC_TEST_F(test_mc, init_twice)
 
     ucc_lib_config_release(cfg);
 }
+
+UCC_TEST_F(test_mc, mem_attr_cache_invalidate)
+{
+    size_t                  page_size = ucc_get_page_size();
+    size_t                  len       = 2 * page_size;
+    ucc_on_off_auto_value_t mt_cache;
+    ucc_mem_attr_t          attr;
+    uint64_t                n_lookups, n_misses;
+    void                   *ptr, *ptr2;
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    mt_cache                        = ucc_global_config.memtype_cache;
+    ucc_global_config.memtype_cache = UCC_CONFIG_ON;
+    ucc_mc_params_t mc_params = {
+        .thread_mode = UCC_THREAD_SINGLE,
+    };
+    ASSERT_EQ(UCC_OK, ucc_mc_init(&mc_params));
+    ucc_global_config.memtype_cache = mt_cache;
+    if (UCC_OK != ucc_mc_get_mem_attr_cache_stats(&n_lookups, &n_misses)) {
+        ucc_mc_finalize();
+        UCC_TEST_SKIP_R("memory type cache is not available");
+    }
+
+    ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+               -1, 0);
+    ASSERT_NE(MAP_FAILED, ptr);
+
+    attr.field_mask = UCC_MEM_ATTR_FIELD_MEM_TYPE;
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr(ptr, &attr));
+    EXPECT_EQ(UCC_MEMORY_TYPE_HOST, attr.mem_type);
+    /* same page is served from the cache, next page is a new entry */
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr(PTR_OFFSET(ptr, 64), &attr));
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr(PTR_OFFSET(ptr, page_size), &attr));
+    EXPECT_EQ(UCC_MEMORY_TYPE_HOST, attr.mem_type);
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr_cache_stats(&n_lookups, &n_misses));
+    EXPECT_EQ(3ul, n_lookups);
+    EXPECT_EQ(2ul, n_misses);
+
+    /* remap the same address range: cached entries must be dropped */
+    ASSERT_EQ(0, munmap(ptr, len));
+    ptr2 = mmap(ptr, len, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    ASSERT_EQ(ptr, ptr2);
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr(ptr, &attr));
+    EXPECT_EQ(UCC_MEMORY_TYPE_HOST, attr.mem_type);
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr(PTR_OFFSET(ptr, page_size), &attr));
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr_cache_stats(&n_lookups, &n_misses));
+    EXPECT_EQ(5ul, n_lookups);
+    EXPECT_EQ(4ul, n_misses);
+
+    /* host buffers report the queried pointer and length as is */
+    attr.field_mask   = UCC_MEM_ATTR_FIELD_BASE_ADDRESS |
+                        UCC_MEM_ATTR_FIELD_ALLOC_LENGTH;
+    attr.alloc_length = 128;
+    EXPECT_EQ(UCC_OK, ucc_mc_get_mem_attr(PTR_OFFSET(ptr, 64), &attr));
+    EXPECT_EQ(PTR_OFFSET(ptr, 64), attr.base_address);
+    EXPECT_EQ(128ul, attr.alloc_length);
+
+    munmap(ptr, len);
+    ucc_mc_finalize();
+}
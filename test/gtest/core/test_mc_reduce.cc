@@ -324,6 +324,8 @@ class test_mc_reduce : public testing::Test {
             }
             if (T::dt == UCC_DT_BFLOAT16) {
                 float32tobfloat16(bfloat16tofloat32(&res)*(float)alpha, &res);
+            } else if (T::dt == UCC_DT_FLOAT16) {
+                float32tofloat16(float16tofloat32(&res)*(float)alpha, &res);
             } else {
                 res *= (typename T::type)alpha;
             }
@@ -362,6 +364,7 @@ using TypeOpPairsFloat = ::testing::Types<ARITHMETIC_OP_PAIRS(FLOAT32),
                                           ARITHMETIC_OP_PAIRS(FLOAT64),
                                           ARITHMETIC_OP_PAIRS(FLOAT128),
                                           ARITHMETIC_OP_PAIRS(BFLOAT16),
+                                          ARITHMETIC_OP_PAIRS(FLOAT16),
                                           TypeOpPair<UCC_DT_FLOAT32_COMPLEX, sum>,
                                           TypeOpPair<UCC_DT_FLOAT32_COMPLEX, prod>,
                                           TypeOpPair<UCC_DT_FLOAT64_COMPLEX, sum>,
@@ -370,7 +373,8 @@ using TypeOpPairsFloat = ::testing::Types<ARITHMETIC_OP_PAIRS(FLOAT32),
                                           TypeOpPair<UCC_DT_FLOAT128_COMPLEX, prod>,
                                           TypeOpPair<UCC_DT_FLOAT32, avg>,
                                           TypeOpPair<UCC_DT_FLOAT64, avg>,
-                                          TypeOpPair<UCC_DT_BFLOAT16, avg>>;
+                                          TypeOpPair<UCC_DT_BFLOAT16, avg>,
+                                          TypeOpPair<UCC_DT_FLOAT16, avg>>;
 
 using TypeOpPairsFloatCuda = ::testing::Types<
     ARITHMETIC_OP_PAIRS(FLOAT32), ARITHMETIC_OP_PAIRS(FLOAT64),
@@ -8,6 +8,7 @@ extern "C" {
 #include <utils/ucc_math.h>
 }
 #include <common/test.h>
+#include <cmath>
 
 template<ucc_datatype_t, template <typename P> class op>
 struct TypeOpPair;
@@ -74,6 +75,77 @@ struct TypeOpPair<UCC_DT_BFLOAT16, op> {
     }
 };
 
+template <template <typename P> class op>
+struct TypeOpPair<UCC_DT_FLOAT16, op> {
+    using type                            = uint16_t;
+    const static ucc_datatype_t     dt    = UCC_DT_FLOAT16;
+    const static ucc_reduction_op_t redop = op<float>::redop;
+    static void                     assert_equal(type arg1, type arg2)
+    {
+        // CPU accumulates all vectors in fp32 and rounds once while
+        // reference rounds to float16 after every op, allow few ulps
+        float a = float16tofloat32(&arg1);
+        float b = float16tofloat32(&arg2);
+        ASSERT_NEAR(a, b, std::fabs(a) * 2e-2 + 6e-8);
+    }
+    static type do_op(type arg1, type arg2)
+    {
+        op<float>  _op;
+        uint16_t   res;
+        float32tofloat16(
+            _op(float16tofloat32(&arg1), float16tofloat32(&arg2)), &res);
+        return res;
+    }
+};
+
+/* Value/index pair matching UCC_DT_<VALUE>_INT32 layout. Constructor from
+   int is used by collective tests to initialize buffers, index is made
+   different from value so that result index is checked independently */
+template <typename V> struct loc_pair {
+    V       val;
+    int32_t idx;
+    loc_pair() = default;
+    loc_pair(int v) : val((V)v), idx((v * 5) % 7) {}
+    bool operator==(const loc_pair &p) const
+    {
+        return (val == p.val) && (idx == p.idx);
+    }
+    /* never used: AVG is not defined for pair types */
+    loc_pair operator/(const loc_pair &) const
+    {
+        return *this;
+    }
+};
+
+template <typename V>
+std::ostream &operator<<(std::ostream &os, const loc_pair<V> &p)
+{
+    return os << "{" << p.val << ", " << p.idx << "}";
+}
+
+DECLARE_TYPE_OP_PAIR(loc_pair<float>, FLOAT32_INT32, ASSERT_EQ);
+DECLARE_TYPE_OP_PAIR(loc_pair<double>, FLOAT64_INT32, ASSERT_EQ);
+DECLARE_TYPE_OP_PAIR(loc_pair<int32_t>, INT32_INT32, ASSERT_EQ);
+DECLARE_TYPE_OP_PAIR(loc_pair<int64_t>, INT64_INT32, ASSERT_EQ);
+
+/* Ties on value resolve to the lowest index */
+#define DECLARE_LOC_OP(_op, _UCC_OP, _CMP)                                     \
+    template <typename T> class _op {                                          \
+      public:                                                                  \
+        const static ucc_reduction_op_t redop = UCC_OP_##_UCC_OP;              \
+        T operator()(T arg1, T arg2)                                           \
+        {                                                                      \
+            if ((arg2.val _CMP arg1.val) ||                                    \
+                ((arg2.val == arg1.val) && (arg2.idx < arg1.idx))) {           \
+                return arg2;                                                   \
+            }                                                                  \
+            return arg1;                                                       \
+        }                                                                      \
+    };
+
+DECLARE_LOC_OP(maxloc, MAXLOC, >);
+DECLARE_LOC_OP(minloc, MINLOC, <);
+
 #define DECLARE_OP_(_op, _UCC_OP, _OP)                          \
     template<typename T>                                        \
     class _op {                                                 \
@@ -127,7 +199,12 @@ using CollReduceTypeOpsHost = ::testing::Types<
     TypeOpPair<UCC_DT_UINT32, bor>, TypeOpPair<UCC_DT_UINT64, land>,
     TypeOpPair<UCC_DT_UINT8, lxor>, TypeOpPair<UCC_DT_INT8, lor>,
     ARITHMETIC_OP_PAIRS(FLOAT128), TypeOpPair<UCC_DT_FLOAT128_COMPLEX, sum>,
-    TypeOpPair<UCC_DT_FLOAT128_COMPLEX, prod>>;
+    TypeOpPair<UCC_DT_FLOAT128_COMPLEX, prod>, TypeOpPair<UCC_DT_FLOAT16, sum>,
+    TypeOpPair<UCC_DT_FLOAT16, min>, TypeOpPair<UCC_DT_FLOAT16, max>,
+    TypeOpPair<UCC_DT_FLOAT32_INT32, maxloc>,
+    TypeOpPair<UCC_DT_FLOAT64_INT32, minloc>,
+    TypeOpPair<UCC_DT_INT32_INT32, minloc>,
+    TypeOpPair<UCC_DT_INT64_INT32, maxloc>>;
 
 using CollReduceTypeOpsAvg = ::testing::Types<
     TypeOpPair<UCC_DT_FLOAT32, avg>, TypeOpPair<UCC_DT_FLOAT64, avg>,
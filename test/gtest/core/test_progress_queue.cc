@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+extern "C" {
+#include "core/ucc_progress_queue.h"
+#include "utils/ucc_atomic.h"
+#include "utils/ucc_time.h"
+#include <pthread.h>
+}
+#include <common/test.h>
+#include <vector>
+
+/* Task that completes after a given number of progress calls */
+typedef struct pq_test_task {
+    ucc_coll_task_t super;
+    int             n_calls;
+} pq_test_task_t;
+
+/* queue type, number of threads, all tasks are posted by thread 0 */
+typedef std::tuple<ucc_pq_type_t, int, bool> pq_test_params_t;
+
+class test_progress_queue
+    : public ucc::test,
+      public ::testing::WithParamInterface<pq_test_params_t> {
+  public:
+    ucc_progress_queue_t       *pq;
+    std::vector<pq_test_task_t> tasks;
+    uint32_t                    n_completed;
+    uint32_t                    n_errors;
+    int                         n_threads;
+    bool                        imbalanced;
+
+    static const int n_tasks = 512;
+    static const int n_calls = 64;
+
+    struct thread_arg {
+        test_progress_queue *test;
+        int                  id;
+    };
+
+    static void task_progress(ucc_coll_task_t *task)
+    {
+        pq_test_task_t *t = ucc_derived_of(task, pq_test_task_t);
+
+        if (--t->n_calls == 0) {
+            task->status = UCC_OK;
+        }
+    }
+
+    static void task_cb(void *data, ucc_status_t status)
+    {
+        test_progress_queue *test = (test_progress_queue *)data;
+
+        if (status != UCC_OK) {
+            ucc_atomic_add32(&test->n_errors, 1);
+        }
+        ucc_atomic_add32(&test->n_completed, 1);
+    }
+
+    static void *thread_run(void *arg)
+    {
+        thread_arg          *ta   = (thread_arg *)arg;
+        test_progress_queue *test = ta->test;
+        int                  i;
+
+        for (i = 0; i < n_tasks; i++) {
+            if (test->imbalanced ? (ta->id != 0)
+                                 : (i % test->n_threads != ta->id)) {
+                continue;
+            }
+            ucc_progress_enqueue(test->pq, &test->tasks[i].super);
+        }
+        while (test->n_completed < (uint32_t)n_tasks) {
+            if (ucc_progress_queue(test->pq) < 0) {
+                ucc_atomic_add32(&test->n_errors, 1);
+            }
+        }
+        return NULL;
+    }
+
+    void SetUp() override
+    {
+        ucc_pq_params_t params;
+
+        params.type     = std::get<0>(GetParam());
+        params.batch    = 8;
+        params.n_deques = 16;
+        n_threads       = std::get<1>(GetParam());
+        imbalanced      = std::get<2>(GetParam());
+        n_completed     = 0;
+        n_errors        = 0;
+        ASSERT_EQ(UCC_OK, ucc_progress_queue_init(&pq, UCC_THREAD_MULTIPLE,
+                                                  &params));
+        tasks.resize(n_tasks);
+        for (auto &t : tasks) {
+            ucc_coll_task_construct(&t.super);
+            ASSERT_EQ(UCC_OK, ucc_coll_task_init(&t.super, NULL, NULL));
+            t.n_calls          = n_calls;
+            t.super.progress   = task_progress;
+            t.super.status     = UCC_INPROGRESS;
+            t.super.flags     |= UCC_COLL_TASK_FLAG_CB;
+            t.super.cb.cb      = task_cb;
+            t.super.cb.data    = this;
+        }
+    }
+
+    void TearDown() override
+    {
+        for (auto &t : tasks) {
+            ucc_coll_task_destruct(&t.super);
+        }
+        ucc_progress_queue_finalize(pq);
+    }
+};
+
+UCC_TEST_P(test_progress_queue, mt_progress)
+{
+    std::vector<pthread_t>  threads(n_threads);
+    std::vector<thread_arg> args(n_threads);
+    ucc_pq_stats_t          stats;
+    double                  start;
+
+    start = ucc_get_time();
+    for (int i = 0; i < n_threads; i++) {
+        args[i].test = this;
+        args[i].id   = i;
+        ASSERT_EQ(0, pthread_create(&threads[i], NULL, thread_run, &args[i]));
+    }
+    for (int i = 0; i < n_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    RecordProperty("time_us", (int)((ucc_get_time() - start) * 1e6));
+
+    EXPECT_EQ((uint32_t)n_tasks, n_completed);
+    EXPECT_EQ((uint32_t)0, n_errors);
+    for (auto &t : tasks) {
+        EXPECT_EQ(0, t.n_calls);
+    }
+    ucc_progress_queue_get_stats(pq, &stats);
+    RecordProperty("steals", (int)stats.n_steals);
+    if (std::get<0>(GetParam()) == UCC_PQ_TYPE_WORK_STEALING) {
+        /* every task is put back to the queue n_calls - 1 times */
+        EXPECT_EQ((uint64_t)n_tasks * (n_calls - 1), stats.n_reenqueues);
+    } else {
+        EXPECT_EQ((uint64_t)0, stats.n_reenqueues);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_progress_queue,
+    ::testing::Combine(::testing::Values(UCC_PQ_TYPE_LOCKED,
+                                         UCC_PQ_TYPE_LOCK_FREE,
+                                         UCC_PQ_TYPE_WORK_STEALING),
+                       ::testing::Values(1, 4, 8),
+                       ::testing::Bool()));
@@ -1,11 +1,13 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
 #include <common/test.h>
 extern "C" {
+#include "core/ucc_context.h"
 #include "schedule/ucc_schedule.h"
+#include "schedule/ucc_schedule_pipelined.h"
 }
 
 class test_coll_task : public ucc_coll_task_t {
@@ -38,8 +40,15 @@ public:
         ts->rst.push_back(rst_t((test_coll_task*)parent, 2));
         return UCC_OK;
     }
+    static int n_finalized;
+    static ucc_status_t finalize_task(ucc_coll_task_t *task) {
+        n_finalized++;
+        return UCC_OK;
+    }
 };
 
+int test_schedule::n_finalized = 0;
+
 /* Tasks subscribes on 2 tasks to EVENT_COMPLETED with the same
    handler */
 UCC_TEST_F(test_schedule, single_handler)
@@ -109,3 +118,186 @@ UCC_TEST_F(test_schedule, multiple)
                   (std::get<1>(rst[i]) == ((i % 2) + 1)));
     }
 }
+
+/* Schedule with more tasks than the inline storage: the 9th task copies
+   the inline array to the heap, the 17th reallocates it. Finalize releases
+   the heap storage and the schedule is initialized and posted again */
+UCC_TEST_F(test_schedule, grow_tasks)
+{
+    const int          n_tasks  = 2 * UCC_SCHEDULE_MAX_TASKS + 4;
+    ucc_context_t      core_ctx = {};
+    ucc_base_context_t ctx      = {};
+    ucc_base_team_t    team     = {};
+    ucc_schedule_t     schedule;
+
+    core_ctx.thread_mode = UCC_THREAD_SINGLE;
+    ctx.ucc_context      = &core_ctx;
+    team.context         = &ctx;
+    ucc_coll_task_construct(&schedule.super);
+    for (int round = 0; round < 2; round++) {
+        std::vector<test_coll_task> tasks(n_tasks);
+
+        ASSERT_EQ(UCC_OK, ucc_schedule_init(&schedule, NULL, &team));
+        for (int i = 0; i < n_tasks; i++) {
+            tasks[i].finalize = test_schedule::finalize_task;
+            ASSERT_EQ(UCC_OK, ucc_schedule_add_task(&schedule, &tasks[i]));
+            ASSERT_EQ(UCC_OK, ucc_event_manager_subscribe(
+                                  &schedule.super, UCC_EVENT_SCHEDULE_STARTED,
+                                  &tasks[i], ucc_task_start_handler));
+            if (i < UCC_SCHEDULE_MAX_TASKS) {
+                EXPECT_EQ(schedule.tasks_inline, schedule.tasks);
+            } else if (i < 2 * UCC_SCHEDULE_MAX_TASKS) {
+                EXPECT_NE(schedule.tasks_inline, schedule.tasks);
+                EXPECT_EQ(2u * UCC_SCHEDULE_MAX_TASKS, schedule.max_tasks);
+            } else {
+                EXPECT_EQ(4u * UCC_SCHEDULE_MAX_TASKS, schedule.max_tasks);
+            }
+        }
+        /* tasks added before the copy and the realloc are kept in order */
+        for (int i = 0; i < n_tasks; i++) {
+            EXPECT_EQ(&tasks[i], schedule.tasks[i]);
+        }
+
+        /* every task completes on post, the schedule completes with them */
+        EXPECT_EQ(UCC_OK, ucc_schedule_start(&schedule.super));
+        EXPECT_EQ((uint32_t)n_tasks, schedule.n_completed_tasks);
+        EXPECT_EQ(UCC_OK, schedule.super.super.status);
+
+        n_finalized = 0;
+        EXPECT_EQ(UCC_OK, ucc_schedule_finalize(&schedule.super));
+        EXPECT_EQ(n_tasks, n_finalized);
+        EXPECT_EQ(schedule.tasks_inline, schedule.tasks);
+        EXPECT_EQ((uint32_t)UCC_SCHEDULE_MAX_TASKS, schedule.max_tasks);
+    }
+    ucc_coll_task_destruct(&schedule.super);
+}
+
+class test_pipeline_model : public ucc::test {
+public:
+    /* team size no other test uses, the model is process wide */
+    static const ucc_rank_t team_size = 12345;
+    ucc_pipeline_model_shape_t shape = {team_size, 15};
+    /* fragment latency of 8 hops and period of 1 hop of 10us + 1GB/s */
+    void calibrate(int slot)
+    {
+        for (int i = 0; i < 64; i++) {
+            double x = (double)(64 * 1024) * (1 + i % 16);
+
+            ucc_pipeline_model_update(&shape, slot, x, 8 * (1e-5 + x * 1e-9),
+                                      (i == 0) ? -1 : 1e-5 + x * 1e-9);
+        }
+    }
+};
+
+UCC_TEST_F(test_pipeline_model, not_calibrated)
+{
+    ucc_pipeline_model_t  model;
+    ucc_pipeline_params_t pp = {};
+    ucc_pipeline_model_shape_t other = {team_size + 1, 15};
+
+    ucc_pipeline_model_snapshot(&other, &model);
+    EXPECT_EQ(1, model.enabled);
+    EXPECT_EQ(UCC_ERR_NOT_FOUND,
+              ucc_pipeline_model_params(&model, "test_not_calibrated",
+                                        UCC_MEMORY_TYPE_HOST, team_size,
+                                        1 << 20, &pp));
+}
+
+UCC_TEST_F(test_pipeline_model, select)
+{
+    ucc_pipeline_model_t  model;
+    ucc_pipeline_params_t pp = {};
+    size_t msgsize           = 64 * 1024 * 1024;
+    int    n_frags, pdepth;
+    int slot = ucc_pipeline_model_slot("test_select", UCC_MEMORY_TYPE_HOST,
+                                       team_size);
+
+    calibrate(slot);
+    ucc_pipeline_model_snapshot(&shape, &model);
+
+    /* large message: deep pipeline of many fragments */
+    ASSERT_EQ(UCC_OK, ucc_pipeline_model_params(&model, "test_select",
+                                                UCC_MEMORY_TYPE_HOST,
+                                                team_size, msgsize, &pp));
+    ucc_pipeline_nfrags_pdepth(&pp, msgsize, &n_frags, &pdepth);
+    EXPECT_GT(n_frags, 16);
+    EXPECT_GT(pdepth, 4);
+    EXPECT_LE(pdepth, n_frags);
+    EXPECT_GE(pp.frag_size * n_frags, msgsize);
+
+    /* small message: no pipelining */
+    ASSERT_EQ(UCC_OK, ucc_pipeline_model_params(&model, "test_select",
+                                                UCC_MEMORY_TYPE_HOST,
+                                                team_size, 4096, &pp));
+    ucc_pipeline_nfrags_pdepth(&pp, 4096, &n_frags, &pdepth);
+    EXPECT_EQ(1, n_frags);
+    EXPECT_EQ(1, pdepth);
+}
+
+UCC_TEST_F(test_pipeline_model, exact_keys)
+{
+    ucc_pipeline_model_t       model;
+    ucc_pipeline_params_t      pp   = {};
+    ucc_pipeline_model_shape_t flat = {team_size, 1};
+    int slot = ucc_pipeline_model_slot("test_exact_keys",
+                                       UCC_MEMORY_TYPE_HOST, team_size);
+
+    EXPECT_EQ(slot, ucc_pipeline_model_slot("test_exact_keys",
+                                            UCC_MEMORY_TYPE_HOST, team_size));
+    /* names with the same byte sum, other memory type and team size */
+    EXPECT_NE(slot, ucc_pipeline_model_slot("test_exact_yeks",
+                                            UCC_MEMORY_TYPE_HOST, team_size));
+    EXPECT_NE(slot, ucc_pipeline_model_slot("test_exact_keys",
+                                            UCC_MEMORY_TYPE_CUDA, team_size));
+    EXPECT_NE(slot, ucc_pipeline_model_slot("test_exact_keys",
+                                            UCC_MEMORY_TYPE_HOST,
+                                            team_size - 32));
+
+    calibrate(slot);
+    ucc_pipeline_model_snapshot(&shape, &model);
+    EXPECT_EQ(UCC_OK, ucc_pipeline_model_params(&model, "test_exact_keys",
+                                                UCC_MEMORY_TYPE_HOST,
+                                                team_size, 1 << 20, &pp));
+    EXPECT_EQ(UCC_ERR_NOT_FOUND,
+              ucc_pipeline_model_params(&model, "test_exact_yeks",
+                                        UCC_MEMORY_TYPE_HOST, team_size,
+                                        1 << 20, &pp));
+
+    /* same team size on a single node is another shape */
+    ucc_pipeline_model_snapshot(&flat, &model);
+    EXPECT_EQ(UCC_ERR_NOT_FOUND,
+              ucc_pipeline_model_params(&model, "test_exact_keys",
+                                        UCC_MEMORY_TYPE_HOST, team_size,
+                                        1 << 20, &pp));
+}
+
+/* A rank whose slot registry is full still predicts from the fits of the
+   team snapshot taken from rank 0 */
+UCC_TEST_F(test_pipeline_model, no_local_slot)
+{
+    ucc_pipeline_model_t  model;
+    ucc_pipeline_params_t pp = {}, pp_remote = {};
+    int slot = ucc_pipeline_model_slot("test_no_local_slot",
+                                       UCC_MEMORY_TYPE_HOST, team_size);
+    int i;
+
+    calibrate(slot);
+    ucc_pipeline_model_snapshot(&shape, &model);
+    ASSERT_EQ(UCC_OK, ucc_pipeline_model_params(&model, "test_no_local_slot",
+                                                UCC_MEMORY_TYPE_HOST,
+                                                team_size, 1 << 24, &pp));
+
+    /* fit received from rank 0 under a key never registered locally */
+    for (i = 0; i < model.n_fits; i++) {
+        if (0 == strcmp(model.fits[i].key.name, "test_no_local_slot")) {
+            strcpy(model.fits[i].key.name, "test_remote_only");
+        }
+    }
+    ASSERT_EQ(UCC_OK, ucc_pipeline_model_params(&model, "test_remote_only",
+                                                UCC_MEMORY_TYPE_HOST,
+                                                team_size, 1 << 24,
+                                                &pp_remote));
+    EXPECT_EQ(pp.n_frags, pp_remote.n_frags);
+    EXPECT_EQ(pp.pdepth, pp_remote.pdepth);
+    EXPECT_EQ(pp.frag_size, pp_remote.frag_size);
+}
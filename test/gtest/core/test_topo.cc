@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 extern "C" {
@@ -12,6 +12,8 @@ extern "C" {
 #include <vector>
 #include <algorithm>
 #include <random>
+#include <fstream>
+#include <unistd.h>
 
 class addr_storage {
   public:
@@ -720,3 +722,169 @@ UCC_TEST_F(test_topo, node_leaders)
     EXPECT_EQ(1, per_node_leaders[0]); // Node 0 leader
     EXPECT_EQ(3, per_node_leaders[1]); // Node 1 leader
 }
+
+#define SET_RACK(_s, _i, _rack) _s.h[_i].ctx_id.pi.rack_id = _rack;
+
+UCC_TEST_F(test_topo, racks)
+{
+    const ucc_rank_t ctx_size = 12;
+    addr_storage     s(ctx_size);
+    ucc_sbgp_t *     sbgp;
+    ucc_subset_t     set;
+    ucc_rank_t       i;
+
+    /* simulates world proc array: 6 nodes, 2 ranks per node.
+       Nodes 0, 1, 2 are in rack 1, nodes 3, 4 in rack 2, node 5 in rack 3 */
+    for (i = 0; i < ctx_size; i++) {
+        SET_PI(s, i, 0x100 + i / 2, 0, i);
+        SET_RACK(s, i, (i < 6) ? 1 : ((i < 10) ? 2 : 3));
+    }
+
+    set.map.ep_num = ctx_size;
+    set.map.type   = UCC_EP_MAP_FULL;
+    set.myrank     = 2; // leader of node 1 in rack 1
+
+    EXPECT_EQ(UCC_OK, ucc_context_topo_init(&s.storage, &ctx_topo));
+    EXPECT_EQ(1, ctx_topo->rack_bound);
+    EXPECT_EQ(UCC_OK, ucc_topo_init(set, ctx_topo, &topo));
+
+    /* RACK subgroup - node leaders of rack 1: ranks 0, 2, 4 */
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK);
+    EXPECT_EQ(UCC_SBGP_ENABLED, sbgp->status);
+    EXPECT_EQ(1, sbgp->group_rank);
+    EXPECT_EQ(true, check_sbgp(sbgp, {0, 2, 4}));
+
+    /* RACK_LEADERS subgroup - ranks 0, 6, 10. Rank 2 does not participate */
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK_LEADERS);
+    EXPECT_EQ(UCC_SBGP_DISABLED, sbgp->status);
+    EXPECT_EQ(true, check_sbgp(sbgp, {0, 6, 10}));
+
+    /* RANK 6 perspective: leader of rack 2 */
+    ucc_topo_cleanup(topo);
+    set.myrank = 6;
+    EXPECT_EQ(UCC_OK, ucc_topo_init(set, ctx_topo, &topo));
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK);
+    EXPECT_EQ(UCC_SBGP_ENABLED, sbgp->status);
+    EXPECT_EQ(0, sbgp->group_rank);
+    EXPECT_EQ(true, check_sbgp(sbgp, {6, 8}));
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK_LEADERS);
+    EXPECT_EQ(UCC_SBGP_ENABLED, sbgp->status);
+    EXPECT_EQ(1, sbgp->group_rank);
+
+    /* RANK 10 perspective: single node rack 3 */
+    ucc_topo_cleanup(topo);
+    set.myrank = 10;
+    EXPECT_EQ(UCC_OK, ucc_topo_init(set, ctx_topo, &topo));
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK);
+    EXPECT_EQ(UCC_SBGP_NOT_EXISTS, sbgp->status);
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK_LEADERS);
+    EXPECT_EQ(UCC_SBGP_ENABLED, sbgp->status);
+    EXPECT_EQ(2, sbgp->group_rank);
+
+    /* RANK 7 perspective: not a node leader */
+    ucc_topo_cleanup(topo);
+    set.myrank = 7;
+    EXPECT_EQ(UCC_OK, ucc_topo_init(set, ctx_topo, &topo));
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK);
+    EXPECT_EQ(UCC_SBGP_DISABLED, sbgp->status);
+    EXPECT_EQ(true, check_sbgp(sbgp, {6, 8}));
+    sbgp = ucc_topo_get_sbgp(topo, UCC_SBGP_RACK_LEADERS);
+    EXPECT_EQ(UCC_SBGP_DISABLED, sbgp->status);
+}
+
+UCC_TEST_F(test_topo, racks_not_defined)
+{
+    const ucc_rank_t ctx_size = 8;
+    addr_storage     s(ctx_size);
+    ucc_subset_t     set;
+    ucc_rank_t       i;
+
+    /* 4 nodes, one of them is not in the topology file */
+    for (i = 0; i < ctx_size; i++) {
+        SET_PI(s, i, 0x100 + i / 2, 0, i);
+        SET_RACK(s, i, (i < 6) ? i / 4 : UCC_RACK_ID_INVALID);
+    }
+
+    set.map.ep_num = ctx_size;
+    set.map.type   = UCC_EP_MAP_FULL;
+    set.myrank     = 0;
+
+    EXPECT_EQ(UCC_OK, ucc_context_topo_init(&s.storage, &ctx_topo));
+    EXPECT_EQ(0, ctx_topo->rack_bound);
+    EXPECT_EQ(UCC_OK, ucc_topo_init(set, ctx_topo, &topo));
+    EXPECT_EQ(UCC_SBGP_NOT_EXISTS,
+              ucc_topo_get_sbgp(topo, UCC_SBGP_RACK)->status);
+    EXPECT_EQ(UCC_SBGP_NOT_EXISTS,
+              ucc_topo_get_sbgp(topo, UCC_SBGP_RACK_LEADERS)->status);
+}
+
+class test_topo_file : public ucc::test {
+  public:
+    std::string filename;
+    test_topo_file()
+    {
+        char name[] = "/tmp/ucc_topo_file_XXXXXX";
+        int  fd     = mkstemp(name);
+
+        EXPECT_NE(-1, fd);
+        close(fd);
+        filename = name;
+    }
+    ~test_topo_file()
+    {
+        unlink(filename.c_str());
+    }
+    void write(const std::string &content)
+    {
+        std::ofstream f(filename);
+        f << content;
+    }
+};
+
+UCC_TEST_F(test_topo_file, parse)
+{
+    ucc_rack_id_t sw1, sw2, rack, pod, id;
+
+    write("# host switch rack pod\n"
+          "\n"
+          "node01.cluster leaf1 rack1 pod1\n"
+          "node02 leaf1 rack1 pod1\n"
+          "node03\tleaf2  rack1 pod1\n"
+          "node04 leaf3\n");
+
+    EXPECT_EQ(UCC_OK, ucc_proc_info_parse_topo_file(
+                          filename.c_str(), "node01",
+                          UCC_TOPO_FILE_LEVEL_SWITCH, &sw1));
+    EXPECT_EQ(UCC_OK, ucc_proc_info_parse_topo_file(
+                          filename.c_str(), "node02",
+                          UCC_TOPO_FILE_LEVEL_SWITCH, &id));
+    EXPECT_EQ(sw1, id);
+    EXPECT_EQ(UCC_OK, ucc_proc_info_parse_topo_file(
+                          filename.c_str(), "node03",
+                          UCC_TOPO_FILE_LEVEL_SWITCH, &sw2));
+    EXPECT_NE(sw1, sw2);
+
+    /* same rack and pod for different switches */
+    EXPECT_EQ(UCC_OK, ucc_proc_info_parse_topo_file(
+                          filename.c_str(), "node01",
+                          UCC_TOPO_FILE_LEVEL_RACK, &rack));
+    EXPECT_EQ(UCC_OK, ucc_proc_info_parse_topo_file(
+                          filename.c_str(), "node03",
+                          UCC_TOPO_FILE_LEVEL_RACK, &id));
+    EXPECT_EQ(rack, id);
+    EXPECT_EQ(UCC_OK, ucc_proc_info_parse_topo_file(
+                          filename.c_str(), "node02",
+                          UCC_TOPO_FILE_LEVEL_POD, &pod));
+    EXPECT_EQ(UCC_OK, ucc_proc_info_parse_topo_file(
+                          filename.c_str(), "node03",
+                          UCC_TOPO_FILE_LEVEL_POD, &id));
+    EXPECT_EQ(pod, id);
+
+    /* missing column and missing host */
+    EXPECT_EQ(UCC_ERR_NOT_FOUND, ucc_proc_info_parse_topo_file(
+                                     filename.c_str(), "node04",
+                                     UCC_TOPO_FILE_LEVEL_RACK, &id));
+    EXPECT_EQ(UCC_ERR_NOT_FOUND, ucc_proc_info_parse_topo_file(
+                                     filename.c_str(), "node05",
+                                     UCC_TOPO_FILE_LEVEL_SWITCH, &id));
+}
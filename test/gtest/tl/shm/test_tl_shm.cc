@@ -0,0 +1,368 @@
+/**
+ * Copyright (c) 2024-2025, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+class test_tl_shm : public ucc::test {
+  public:
+    static const int n_procs = 8;
+    /* tl_shm has higher score than tl_ucp for the sizes used below */
+    ucc_job_env_t env = {{"UCC_CLS", "basic"},
+                         {"UCC_CL_BASIC_TLS", "shm,ucp"}};
+
+    void run(UccTeam_h team, std::vector<ucc_coll_args_t> &args)
+    {
+        std::vector<ucc_coll_req_h> reqs;
+        ucc_coll_req_h              req;
+        ucc_status_t                st;
+        size_t                      i;
+
+        for (i = 0; i < args.size(); i++) {
+            ASSERT_EQ(UCC_OK,
+                      ucc_collective_init(&args[i], &req, team->procs[i].team));
+            reqs.push_back(req);
+        }
+        for (auto r : reqs) {
+            EXPECT_EQ(UCC_OK, ucc_collective_post(r));
+        }
+        do {
+            team->progress();
+            st = UCC_OK;
+            for (auto r : reqs) {
+                if (ucc_collective_test(r) != UCC_OK) {
+                    st = UCC_INPROGRESS;
+                }
+            }
+        } while (st == UCC_INPROGRESS);
+        for (auto r : reqs) {
+            EXPECT_EQ(UCC_OK, ucc_collective_finalize(r));
+        }
+    }
+
+    ucc_coll_args_t make_args(ucc_coll_type_t coll, int root, int *src,
+                              int *dst, size_t count)
+    {
+        ucc_coll_args_t args;
+
+        memset(&args, 0, sizeof(args));
+        args.coll_type         = coll;
+        args.root              = root;
+        args.op                = UCC_OP_SUM;
+        args.src.info.buffer   = src;
+        args.src.info.count    = count;
+        args.src.info.datatype = UCC_DT_INT32;
+        args.src.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        args.dst.info.buffer   = dst;
+        args.dst.info.count    = count;
+        args.dst.info.datatype = UCC_DT_INT32;
+        args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        return args;
+    }
+
+    /* Sequence of collectives with changing roots: slots of every rank are
+       rewritten many times with different trees */
+    void run_mixed(ucc_job_env_t &job_env)
+    {
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, job_env);
+        UccTeam_h team = job.create_team(n_procs);
+        size_t    counts[] = {1, 7, 256};
+        int       round    = 0;
+
+        for (auto count : counts) {
+            for (int root = 0; root < n_procs; root++, round++) {
+                std::vector<std::vector<int>> src(n_procs), dst(n_procs);
+                std::vector<ucc_coll_args_t>  args;
+                int                           expected;
+
+                /* bcast */
+                for (int i = 0; i < n_procs; i++) {
+                    src[i].assign(count, (i == root) ? round : -1);
+                    args.push_back(make_args(UCC_COLL_TYPE_BCAST, root,
+                                             src[i].data(), NULL, count));
+                }
+                run(team, args);
+                for (int i = 0; i < n_procs; i++) {
+                    for (size_t j = 0; j < count; j++) {
+                        EXPECT_EQ(round, src[i][j]);
+                    }
+                }
+
+                /* reduce */
+                args.clear();
+                for (int i = 0; i < n_procs; i++) {
+                    src[i].assign(count, i + round);
+                    dst[i].assign(count, -1);
+                    args.push_back(make_args(UCC_COLL_TYPE_REDUCE, root,
+                                             src[i].data(), dst[i].data(),
+                                             count));
+                }
+                run(team, args);
+                expected = n_procs * round + n_procs * (n_procs - 1) / 2;
+                for (size_t j = 0; j < count; j++) {
+                    EXPECT_EQ(expected, dst[root][j]);
+                }
+
+                /* allreduce */
+                args.clear();
+                for (int i = 0; i < n_procs; i++) {
+                    src[i].assign(count, i * round);
+                    dst[i].assign(count, -1);
+                    args.push_back(make_args(UCC_COLL_TYPE_ALLREDUCE, 0,
+                                             src[i].data(), dst[i].data(),
+                                             count));
+                }
+                run(team, args);
+                expected = round * n_procs * (n_procs - 1) / 2;
+                for (int i = 0; i < n_procs; i++) {
+                    for (size_t j = 0; j < count; j++) {
+                        EXPECT_EQ(expected, dst[i][j]);
+                    }
+                }
+
+                /* barrier */
+                args.clear();
+                for (int i = 0; i < n_procs; i++) {
+                    args.push_back(make_args(UCC_COLL_TYPE_BARRIER, 0, NULL,
+                                             NULL, 0));
+                }
+                run(team, args);
+            }
+        }
+    }
+};
+
+UCC_TEST_F(test_tl_shm, mixed)
+{
+    run_mixed(env);
+}
+
+UCC_TEST_F(test_tl_shm, mixed_radix2)
+{
+    ucc_job_env_t env_r2 = env;
+
+    env_r2.push_back({"UCC_TL_SHM_RADIX", "2"});
+    run_mixed(env_r2);
+}
+
+/* A rank failing to attach to the segment makes tl_shm team creation fail
+   on all ranks instead of hanging, the team falls back to tl_ucp */
+UCC_TEST_F(test_tl_shm, attach_failure)
+{
+    ucc_job_env_t env_fail = env;
+
+    env_fail.push_back({"UCC_TL_SHM_DEBUG_ATTACH_FAIL_RANK", "3"});
+    run_mixed(env_fail);
+}
+
+UCC_TEST_F(test_tl_shm, allreduce_inplace_outstanding)
+{
+    UccJob                         job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h                      team    = job.create_team(n_procs);
+    const int                      n_colls = 4;
+    const size_t                   count   = 64;
+    std::vector<std::vector<int>>  bufs;
+    std::vector<ucc_coll_req_h>    reqs;
+    ucc_coll_args_t                args;
+    ucc_coll_req_h                 req;
+    ucc_status_t                   st;
+
+    /* several collectives are posted before any of them is progressed */
+    for (int c = 0; c < n_colls; c++) {
+        for (int i = 0; i < n_procs; i++) {
+            bufs.emplace_back(count, i + c);
+            args = make_args(UCC_COLL_TYPE_ALLREDUCE, 0, NULL,
+                             bufs.back().data(), count);
+            args.mask |= UCC_COLL_ARGS_FIELD_FLAGS;
+            args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+            ASSERT_EQ(UCC_OK,
+                      ucc_collective_init(&args, &req, team->procs[i].team));
+            EXPECT_EQ(UCC_OK, ucc_collective_post(req));
+            reqs.push_back(req);
+        }
+    }
+    do {
+        team->progress();
+        st = UCC_OK;
+        for (auto r : reqs) {
+            if (ucc_collective_test(r) != UCC_OK) {
+                st = UCC_INPROGRESS;
+            }
+        }
+    } while (st == UCC_INPROGRESS);
+
+    for (int c = 0; c < n_colls; c++) {
+        for (int i = 0; i < n_procs; i++) {
+            for (size_t j = 0; j < count; j++) {
+                EXPECT_EQ(n_procs * c + n_procs * (n_procs - 1) / 2,
+                          bufs[c * n_procs + i][j]);
+            }
+        }
+    }
+    for (auto r : reqs) {
+        EXPECT_EQ(UCC_OK, ucc_collective_finalize(r));
+    }
+}
+
+/* Threads of the gtest process may always access each other's memory, so
+   single-copy collectives are enabled for any message size */
+class test_tl_shm_cma : public test_tl_shm {
+  public:
+    ucc_job_env_t cma_env = {{"UCC_CLS", "basic"},
+                             {"UCC_CL_BASIC_TLS", "shm,ucp"},
+                             {"UCC_TL_SHM_CMA", "y"},
+                             {"UCC_TL_SHM_CMA_THRESH", "0"}};
+};
+
+UCC_TEST_F(test_tl_shm_cma, rooted)
+{
+    UccJob       job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, cma_env);
+    UccTeam_h    team  = job.create_team(n_procs);
+    const size_t count = 4096;
+
+    for (int root = 0; root < n_procs; root++) {
+        std::vector<std::vector<int>> src(n_procs), dst(n_procs);
+        std::vector<ucc_coll_args_t>  args;
+
+        /* bcast */
+        for (int i = 0; i < n_procs; i++) {
+            src[i].assign(count, (i == root) ? root + 1 : -1);
+            args.push_back(make_args(UCC_COLL_TYPE_BCAST, root,
+                                     src[i].data(), NULL, count));
+        }
+        run(team, args);
+        for (int i = 0; i < n_procs; i++) {
+            EXPECT_EQ(root + 1, src[i][0]);
+            EXPECT_EQ(root + 1, src[i][count - 1]);
+        }
+
+        /* gather */
+        args.clear();
+        for (int i = 0; i < n_procs; i++) {
+            src[i].assign(count, i);
+            dst[i].assign(count * n_procs, -1);
+            args.push_back(make_args(UCC_COLL_TYPE_GATHER, root,
+                                     src[i].data(), dst[i].data(), count));
+            args.back().dst.info.count = count * n_procs;
+        }
+        run(team, args);
+        for (int i = 0; i < n_procs; i++) {
+            EXPECT_EQ(i, dst[root][count * i]);
+            EXPECT_EQ(i, dst[root][count * (i + 1) - 1]);
+        }
+
+        /* scatter */
+        args.clear();
+        for (int i = 0; i < n_procs; i++) {
+            src[i].resize(count * n_procs);
+            for (size_t j = 0; j < count * n_procs; j++) {
+                src[i][j] = (i == root) ? (int)(j / count) : -1;
+            }
+            dst[i].assign(count, -1);
+            args.push_back(make_args(UCC_COLL_TYPE_SCATTER, root,
+                                     src[i].data(), dst[i].data(), count));
+            args.back().src.info.count = count * n_procs;
+        }
+        run(team, args);
+        for (int i = 0; i < n_procs; i++) {
+            EXPECT_EQ(i, dst[i][0]);
+            EXPECT_EQ(i, dst[i][count - 1]);
+        }
+    }
+}
+
+UCC_TEST_F(test_tl_shm_cma, allgather_alltoall)
+{
+    UccJob                        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL,
+                                      cma_env);
+    UccTeam_h                     team  = job.create_team(n_procs);
+    const size_t                  count = 1024;
+    std::vector<std::vector<int>> src(n_procs), dst(n_procs);
+    std::vector<ucc_coll_args_t>  args;
+
+    for (int i = 0; i < n_procs; i++) {
+        src[i].assign(count, i);
+        dst[i].assign(count * n_procs, -1);
+        args.push_back(make_args(UCC_COLL_TYPE_ALLGATHER, 0, src[i].data(),
+                                 dst[i].data(), count));
+        args.back().dst.info.count = count * n_procs;
+    }
+    run(team, args);
+    for (int i = 0; i < n_procs; i++) {
+        for (int p = 0; p < n_procs; p++) {
+            EXPECT_EQ(p, dst[i][count * p]);
+            EXPECT_EQ(p, dst[i][count * (p + 1) - 1]);
+        }
+    }
+
+    args.clear();
+    for (int i = 0; i < n_procs; i++) {
+        src[i].resize(count * n_procs);
+        for (int p = 0; p < n_procs; p++) {
+            std::fill(src[i].begin() + count * p,
+                      src[i].begin() + count * (p + 1), i * n_procs + p);
+        }
+        dst[i].assign(count * n_procs, -1);
+        args.push_back(make_args(UCC_COLL_TYPE_ALLTOALL, 0, src[i].data(),
+                                 dst[i].data(), count * n_procs));
+    }
+    run(team, args);
+    for (int i = 0; i < n_procs; i++) {
+        for (int p = 0; p < n_procs; p++) {
+            EXPECT_EQ(p * n_procs + i, dst[i][count * p]);
+            EXPECT_EQ(p * n_procs + i, dst[i][count * (p + 1) - 1]);
+        }
+    }
+}
+
+UCC_TEST_F(test_tl_shm_cma, alltoallv)
+{
+    UccJob                             job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL,
+                                           cma_env);
+    UccTeam_h                          team = job.create_team(n_procs);
+    std::vector<std::vector<int>>      src(n_procs), dst(n_procs);
+    std::vector<std::vector<uint32_t>> scounts(n_procs), sdispls(n_procs),
+                                       rcounts(n_procs), rdispls(n_procs);
+    std::vector<ucc_coll_args_t>       args;
+    ucc_coll_args_t                    a;
+
+    /* rank i sends i + p + 1 elements to rank p */
+    for (int i = 0; i < n_procs; i++) {
+        uint32_t soff = 0, roff = 0;
+
+        for (int p = 0; p < n_procs; p++) {
+            scounts[i].push_back(i + p + 1);
+            sdispls[i].push_back(soff);
+            rcounts[i].push_back(p + i + 1);
+            rdispls[i].push_back(roff);
+            for (int k = 0; k < i + p + 1; k++) {
+                src[i].push_back(i * n_procs + p);
+            }
+            soff += i + p + 1;
+            roff += p + i + 1;
+        }
+        dst[i].assign(roff, -1);
+        memset(&a, 0, sizeof(a));
+        a.coll_type                   = UCC_COLL_TYPE_ALLTOALLV;
+        a.src.info_v.buffer           = src[i].data();
+        a.src.info_v.counts           = (ucc_count_t *)scounts[i].data();
+        a.src.info_v.displacements    = (ucc_aint_t *)sdispls[i].data();
+        a.src.info_v.datatype         = UCC_DT_INT32;
+        a.src.info_v.mem_type         = UCC_MEMORY_TYPE_HOST;
+        a.dst.info_v.buffer           = dst[i].data();
+        a.dst.info_v.counts           = (ucc_count_t *)rcounts[i].data();
+        a.dst.info_v.displacements    = (ucc_aint_t *)rdispls[i].data();
+        a.dst.info_v.datatype         = UCC_DT_INT32;
+        a.dst.info_v.mem_type         = UCC_MEMORY_TYPE_HOST;
+        args.push_back(a);
+    }
+    run(team, args);
+    for (int i = 0; i < n_procs; i++) {
+        for (int p = 0; p < n_procs; p++) {
+            for (uint32_t k = 0; k < rcounts[i][p]; k++) {
+                EXPECT_EQ(p * n_procs + i, dst[i][rdispls[i][p] + k]);
+            }
+        }
+    }
+}
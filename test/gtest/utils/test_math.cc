@@ -41,3 +41,49 @@ UCC_TEST_P(test_bfloats16_cast, start_with_bfloat16)
 
 INSTANTIATE_TEST_CASE_P(, test_bfloats16_cast,
                         ::testing::Values(31000, 400, 17, 13569, 0));
+
+using float16Params = std::pair<float, uint16_t>;
+class test_float16_cast
+    : public ucc::test,
+      public ::testing::WithParamInterface<float16Params> {
+};
+
+UCC_TEST_P(test_float16_cast, from_float)
+{
+    float    f = GetParam().first;
+    uint16_t res;
+
+    float32tofloat16(f, &res);
+    EXPECT_EQ(GetParam().second, res);
+}
+
+class test_float16_round_trip : public ucc::test {
+};
+
+UCC_TEST_F(test_float16_round_trip, all_finite)
+{
+    uint16_t h, res;
+
+    /* every finite float16 value is exactly representable in fp32 */
+    for (uint32_t i = 0; i < 0x10000; i++) {
+        h = (uint16_t)i;
+        if ((h & 0x7c00) == 0x7c00) {
+            continue;
+        }
+        float32tofloat16(float16tofloat32(&h), &res);
+        ASSERT_EQ(h, res);
+    }
+}
+
+/* normal, ties to even, subnormal, overflow to infinity */
+INSTANTIATE_TEST_CASE_P(
+    , test_float16_cast,
+    ::testing::Values(float16Params(1.0f, 0x3c00),
+                      float16Params(-2.5f, 0xc100),
+                      float16Params(65504.0f, 0x7bff),
+                      float16Params(1.0f + 1.0f / 2048, 0x3c00),
+                      float16Params(1.0f + 3.0f / 2048, 0x3c02),
+                      float16Params(5.9604644775390625e-8f, 0x0001),
+                      float16Params(2.0e-8f, 0x0000),
+                      float16Params(65520.0f, 0x7c00),
+                      float16Params(-1.0e10f, 0xfc00)));
@@ -89,6 +89,35 @@ ucc_pt_benchmark::ucc_pt_benchmark(ucc_pt_benchmark_config cfg,
     }
 }
 
+/* Memory type of user buffers is detected by UCC on each collective init */
+static void ucc_pt_coll_args_unknown_mem_type(ucc_coll_args_t &args)
+{
+    switch (args.coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+    case UCC_COLL_TYPE_FANIN:
+    case UCC_COLL_TYPE_FANOUT:
+        return;
+    case UCC_COLL_TYPE_ALLTOALLV:
+        args.src.info_v.mem_type = UCC_MEMORY_TYPE_UNKNOWN;
+        args.dst.info_v.mem_type = UCC_MEMORY_TYPE_UNKNOWN;
+        return;
+    case UCC_COLL_TYPE_SCATTERV:
+        args.src.info_v.mem_type = UCC_MEMORY_TYPE_UNKNOWN;
+        args.dst.info.mem_type   = UCC_MEMORY_TYPE_UNKNOWN;
+        return;
+    case UCC_COLL_TYPE_ALLGATHERV:
+    case UCC_COLL_TYPE_GATHERV:
+    case UCC_COLL_TYPE_REDUCE_SCATTERV:
+        args.src.info.mem_type   = UCC_MEMORY_TYPE_UNKNOWN;
+        args.dst.info_v.mem_type = UCC_MEMORY_TYPE_UNKNOWN;
+        return;
+    default:
+        args.src.info.mem_type = UCC_MEMORY_TYPE_UNKNOWN;
+        args.dst.info.mem_type = UCC_MEMORY_TYPE_UNKNOWN;
+        return;
+    }
+}
+
 ucc_status_t ucc_pt_benchmark::run_bench() noexcept
 {
     size_t min_count = coll->has_range() ? config.min_count : 1;
@@ -109,6 +138,9 @@ ucc_status_t ucc_pt_benchmark::run_bench() noexcept
         args.coll_args.root = config.root;
         UCCCHECK_GOTO(coll->init_args(cnt, args), exit_err, st);
         if ((uint64_t)config.op_type < (uint64_t)UCC_COLL_TYPE_LAST) {
+            if (!config.memtype_cache.empty()) {
+                ucc_pt_coll_args_unknown_mem_type(args.coll_args);
+            }
             UCCCHECK_GOTO(run_single_coll_test(args.coll_args, warmup, iter, time),
                           free_coll, st);
         } else {
@@ -153,6 +185,10 @@ ucc_status_t ucc_pt_benchmark::run_single_coll_test(ucc_coll_args_t args,
     ucc_ee_h ee;
     ucc_ev_t comp_ev, *post_ev;
 
+    if (config.init_only) {
+        return run_single_coll_init_test(args, nwarmup, niter, time);
+    }
+
     UCCCHECK_GOTO(comm->barrier(), exit_err, st);
     time = 0;
 
@@ -226,6 +262,42 @@ exit_err:
     return st;
 }
 
+/* Measures ucc_collective_init only: algorithm selection and task
+   allocation. Requests are finalized without being posted. */
+ucc_status_t ucc_pt_benchmark::run_single_coll_init_test(ucc_coll_args_t args,
+                                                         int nwarmup,
+                                                         int niter,
+                                                         double &time)
+                                                         noexcept
+{
+    ucc_team_h     team = comm->get_team();
+    ucc_status_t   st   = UCC_OK;
+    ucc_coll_req_h req;
+
+    UCCCHECK_GOTO(comm->barrier(), exit_err, st);
+    time      = 0;
+    args.root = config.root % comm->get_size();
+    for (int i = 0; i < nwarmup + niter; i++) {
+        double s = get_time_us();
+
+        UCCCHECK_GOTO(ucc_collective_init(&args, &req, team), exit_err, st);
+        double f = get_time_us();
+        ucc_collective_finalize(req);
+        if (i >= nwarmup) {
+            time += f - s;
+        }
+        args.root = (args.root + config.root_shift) % comm->get_size();
+    }
+    UCCCHECK_GOTO(comm->barrier(), exit_err, st);
+
+    if (niter != 0) {
+        time /= niter;
+    }
+    return UCC_OK;
+exit_err:
+    return st;
+}
+
 ucc_status_t
 ucc_pt_benchmark::run_single_executor_test(ucc_ee_executor_task_args_t args,
                                            int nwarmup, int niter,
@@ -302,6 +374,20 @@ void ucc_pt_benchmark::print_header()
                         ucc_reduction_op_str(config.op):
                         "N/A")
                   << std::endl;
+        if (!config.reduce_isa.empty()) {
+            std::cout << std::left << std::setw(24)
+                      << "Reduce kernels: " << config.reduce_isa
+                      << std::endl;
+        }
+        if (config.init_only) {
+            std::cout << std::left << std::setw(24)
+                      << "Mode: " << "init latency" << std::endl;
+        }
+        if (!config.memtype_cache.empty()) {
+            std::cout << std::left << std::setw(24)
+                      << "Memory type cache: " << config.memtype_cache
+                      << std::endl;
+        }
         std::cout << std::left << std::setw(24)
                   << "Inplace: "
                   << (coll->has_inplace() ?
@@ -369,7 +455,7 @@ void ucc_pt_benchmark::print_time(size_t count, ucc_pt_test_args_t args,
                   << std::setw(12) << time_max;
 
         if (config.full_print) {
-            if (!coll->has_bw()) {
+            if (!coll->has_bw() || config.init_only) {
                 std::cout << std::setw(12) << "N/A"
                           << std::setw(12) << "N/A"
                           << std::setw(12) << "N/A";
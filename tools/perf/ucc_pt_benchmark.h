@@ -25,6 +25,9 @@ public:
     ucc_status_t run_single_coll_test(ucc_coll_args_t args,
                                       int nwarmup, int niter,
                                       double &time) noexcept;
+    ucc_status_t run_single_coll_init_test(ucc_coll_args_t args,
+                                           int nwarmup, int niter,
+                                           double &time) noexcept;
     ucc_status_t run_single_executor_test(ucc_ee_executor_task_args_t args,
                                           int nwarmup, int niter,
                                           double &time) noexcept;
@@ -20,6 +20,7 @@ ucc_pt_config::ucc_pt_config() {
     bench.inplace        = false;
     bench.persistent     = false;
     bench.triggered      = false;
+    bench.init_only      = false;
     bench.n_iter_small   = 1000;
     bench.n_warmup_small = 100;
     bench.n_iter_large   = 200;
@@ -30,12 +31,15 @@ ucc_pt_config::ucc_pt_config() {
     bench.root           = 0;
     bench.root_shift     = 0;
     bench.mult_factor    = 2;
+    bench.reduce_isa     = "";
+    bench.memtype_cache  = "";
     comm.mt              = bench.mt;
 }
 
 const std::map<std::string, ucc_reduction_op_t> ucc_pt_reduction_op_map = {
     {"sum", UCC_OP_SUM}, {"prod", UCC_OP_PROD}, {"min", UCC_OP_MIN},
-    {"max", UCC_OP_MAX}, {"avg", UCC_OP_AVG},
+    {"max", UCC_OP_MAX}, {"avg", UCC_OP_AVG}, {"maxloc", UCC_OP_MAXLOC},
+    {"minloc", UCC_OP_MINLOC},
 };
 
 const std::map<std::string, ucc_pt_op_type_t> ucc_pt_op_map = {
@@ -84,6 +88,10 @@ const std::map<std::string, ucc_datatype_t> ucc_pt_datatype_map = {
     {"uint128", UCC_DT_UINT128},
     {"float128", UCC_DT_FLOAT64},
     {"float128_complex", UCC_DT_FLOAT128_COMPLEX},
+    {"float32_int32", UCC_DT_FLOAT32_INT32},
+    {"float64_int32", UCC_DT_FLOAT64_INT32},
+    {"int32_int32", UCC_DT_INT32_INT32},
+    {"int64_int32", UCC_DT_INT64_INT32},
 };
 
 ucc_status_t ucc_pt_config::process_args(int argc, char *argv[])
@@ -91,7 +99,7 @@ ucc_status_t ucc_pt_config::process_args(int argc, char *argv[])
     int c;
     ucc_status_t st;
 
-    while ((c = getopt(argc, argv, "c:b:e:d:f:m:n:w:o:N:r:S:iphFT")) != -1) {
+    while ((c = getopt(argc, argv, "c:b:e:d:f:m:n:w:o:N:r:S:K:M:iphFTI")) != -1) {
         switch (c) {
             case 'c':
                 if (ucc_pt_op_map.count(optarg) == 0) {
@@ -160,6 +168,18 @@ ucc_status_t ucc_pt_config::process_args(int argc, char *argv[])
             case 'N':
                 std::stringstream(optarg) >> bench.n_bufs;
                 break;
+            case 'K':
+                /* cpu executor reads its configuration on first use, has
+                   to be set before ucc is initialized */
+                setenv("UCC_EC_CPU_REDUCE_ISA", optarg, 1);
+                bench.reduce_isa = optarg;
+                bench.full_print = true;
+                break;
+            case 'M':
+                /* global config is read on ucc init */
+                setenv("UCC_MEMTYPE_CACHE", optarg, 1);
+                bench.memtype_cache = optarg;
+                break;
             case 'i':
                 bench.inplace = true;
                 break;
@@ -172,6 +192,9 @@ ucc_status_t ucc_pt_config::process_args(int argc, char *argv[])
             case 'F':
                 bench.full_print = true;
                 break;
+            case 'I':
+                bench.init_only = true;
+                break;
             case 'h':
             default:
                 print_help();
@@ -197,8 +220,13 @@ void ucc_pt_config::print_help()
     std::cout << "  -w <number>: number of warmup iterations"<<std::endl;
     std::cout << "  -f <number>: multiplication factor between sizes. Default : 2."<<std::endl;
     std::cout << "  -N <number>: number of buffers"<<std::endl;
+    std::cout << "  -K <isa>: cpu reduction kernels: auto, scalar, avx2, avx512, neon, sve."
+              << " Enables full print"<<std::endl;
     std::cout << "  -T: triggered collective"<<std::endl;
     std::cout << "  -F: enable full print"<<std::endl;
+    std::cout << "  -I: measure collective init latency only"<<std::endl;
+    std::cout << "  -M <on|off|auto>: let ucc detect buffers memory type,"
+              << " memory type cache mode"<<std::endl;
     std::cout << "  -S: <number>: root shift for rooted collectives"<<std::endl;
     std::cout << "  -h: show this help message"<<std::endl;
     std::cout << std::endl;
@@ -81,6 +81,7 @@ struct ucc_pt_benchmark_config {
     bool               inplace;
     bool               persistent;
     bool               triggered;
+    bool               init_only;
     size_t             large_thresh;
     int                n_iter_small;
     int                n_warmup_small;
@@ -91,6 +92,8 @@ struct ucc_pt_benchmark_config {
     int                root;
     int                root_shift;
     int                mult_factor;
+    std::string        reduce_isa;
+    std::string        memtype_cache;
 };
 
 struct ucc_pt_config {